@@ -14,6 +14,17 @@ option(${PROJECT_NAME}_USE_ALT_NAMES "Use alternative names for the project, suc
 
 option(${PROJECT_NAME}_WARNINGS_AS_ERRORS "Treat compiler warnings as errors." OFF)
 
+# The AVX2 code paths are always built and picked at runtime; this lets the compiler use
+# AVX2, BMI2 and FMA everywhere, and the binaries then require a processor that has them.
+option(${PROJECT_NAME}_ENABLE_AVX2 "Compile all code for processors with AVX2, BMI2 and FMA." OFF)
+if(${PROJECT_NAME}_ENABLE_AVX2)
+    if(MSVC)
+        add_compile_options(/arch:AVX2)
+    else()
+        add_compile_options(-mavx2 -mbmi2 -mfma)
+    endif()
+endif()
+
 #
 # Package managers
 #
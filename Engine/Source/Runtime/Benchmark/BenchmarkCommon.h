@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace Voxium::Benchmark
+{
+    // Keeps the optimizer from discarding a value computed only for timing.
+    template<typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER)
+        static const void* volatile sink;
+        sink = &value;
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    // Runs func once and returns the elapsed wall time in seconds.
+    template<typename Func>
+    double Measure(Func&& func)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    inline void Report(const char* name, double seconds, double operations, const char* unit = "op")
+    {
+        std::printf("%-48s %10.3f ms %12.2f M%s/s %10.2f ns/%s\n", name, seconds * 1e3, operations / seconds / 1e6, unit, seconds * 1e9 / operations, unit);
+    }
+} // namespace Voxium::Benchmark
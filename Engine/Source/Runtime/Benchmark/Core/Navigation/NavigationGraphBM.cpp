@@ -0,0 +1,116 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Navigation/PathScheduler.h"
+#include "Terrain/TerrainGenerator.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int WORLD_CHUNKS = 8;
+    constexpr int WORLD_LAYERS = 6;
+    constexpr int QUERIES      = 200;
+    constexpr int EDITS        = 100;
+
+    // The highest walkable cell of every column that has one.
+    std::vector<Int3> GroundCells(const WalkableSurface& surface)
+    {
+        std::vector<Int3>      cells;
+        const ChunkedVoxelMap& map = surface.Map();
+        for (int z = 0; z < map.SizeZ(); ++z)
+            for (int x = 0; x < map.SizeX(); ++x)
+                for (int y = map.SizeY() - 1; y > 0; --y)
+                    if (surface.IsWalkable(Int3(x, y, z)))
+                    {
+                        cells.push_back(Int3(x, y, z));
+                        break;
+                    }
+        return cells;
+    }
+} // namespace
+
+int main()
+{
+    const int       size = WORLD_CHUNKS * CHUNK_SIZE;
+    ChunkedVoxelMap map(255, size, WORLD_LAYERS * CHUNK_SIZE, size);
+    ThreadPool      pool;
+    TerrainGenerator().GenerateRegion(map, Int3(0, 0, 0), Int3(WORLD_CHUNKS - 1, WORLD_LAYERS - 1, WORLD_CHUNKS - 1), pool);
+
+    NavigationGraph graph(map);
+    Report("Build graph, one thread", Measure([&] { graph.Rebuild(); }), WORLD_CHUNKS * WORLD_LAYERS * WORLD_CHUNKS, "chunk");
+    Report("Build graph on the pool", Measure([&] { graph.Rebuild(pool); }), WORLD_CHUNKS * WORLD_LAYERS * WORLD_CHUNKS, "chunk");
+    std::printf("    %zu clusters, %zu entrances, %u threads\n", graph.ClusterCount(), graph.EntranceCount(), pool.ThreadCount());
+
+    const std::vector<Int3>            cells = GroundCells(graph.Surface());
+    std::mt19937                       rng(3);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(cells.size()) - 1);
+    std::vector<std::pair<Int3, Int3>> queries;
+    for (int i = 0; i < QUERIES; ++i)
+        queries.emplace_back(cells[pick(rng)], cells[pick(rng)]);
+
+    // Flat searches over one grid of the whole map, as a pathfinder without the hierarchy would run.
+    NavigationGrid grid;
+    grid.Build(graph.Surface(), Int3(0, 0, 0), Int3(size - 1, map.SizeY() - 1, size - 1));
+    GridPathfinder pathfinder;
+    for (const GridSearch search : {GridSearch::AStar, GridSearch::JumpPoint})
+    {
+        GridPath path;
+        uint64_t expanded = 0;
+        int      found    = 0;
+        double   cost     = 0.0;
+        Report(search == GridSearch::AStar ? "A* over the whole map" : "Jump point search over the whole map", Measure([&] {
+                   for (const auto& [start, goal] : queries)
+                   {
+                       found += pathfinder.FindPath(grid, start, goal, search, path);
+                       expanded += path.Expanded;
+                       cost += path.Cost;
+                   }
+               }),
+               QUERIES, "query");
+        std::printf("    %d found, %.0f nodes expanded per query, total cost %.0f\n", found, static_cast<double>(expanded) / QUERIES, cost);
+    }
+
+    // The hierarchy with each search refining the steps inside chunks.
+    NavigationGraph jumpGraph(map, {}, GridSearch::JumpPoint);
+    jumpGraph.Rebuild(pool);
+    for (const NavigationGraph* searched : {&graph, &jumpGraph})
+    {
+        NavigationPath path;
+        uint64_t       expanded = 0;
+        int            found    = 0;
+        double         cost     = 0.0;
+        Report(searched == &graph ? "Hierarchical search, A* refinement" : "Hierarchical search, jump point refinement", Measure([&] {
+                   for (const auto& [start, goal] : queries)
+                   {
+                       found += searched->FindPath(start, goal, path);
+                       expanded += path.Expanded;
+                       cost += path.Cost;
+                   }
+               }),
+               QUERIES, "query");
+        std::printf("    %d found, %.0f nodes expanded per query, total cost %.0f\n", found, static_cast<double>(expanded) / QUERIES, cost);
+    }
+
+    PathScheduler scheduler(graph, pool, PathSchedulerSettings {UINT32_MAX, UINT32_MAX});
+    for (const auto& [start, goal] : queries)
+        scheduler.Request(start, goal);
+    Report("Hierarchical search, scheduled on the pool", Measure([&] { scheduler.Tick(); }), QUERIES, "query");
+
+    // Single voxels dug and placed across the surface, then one update.
+    for (int i = 0; i < EDITS; ++i)
+    {
+        const Int3 cell = cells[pick(rng)];
+        const Int3 edit = i % 2 == 0 ? cell - Int3(0, 1, 0) : cell;
+        map.SetBlock(edit.X, edit.Y, edit.Z, i % 2 == 0 ? AIR_KIND : 1);
+        graph.OnBlockChanged(edit.X, edit.Y, edit.Z);
+    }
+    const std::size_t pending = graph.PendingCount();
+    std::size_t       rebuilt = 0;
+    Report("Update after scattered edits", Measure([&] { rebuilt = graph.Update(pool); }), EDITS, "edit");
+    std::printf("    %zu chunks touched, %zu rebuilt\n", pending, rebuilt);
+    return 0;
+}
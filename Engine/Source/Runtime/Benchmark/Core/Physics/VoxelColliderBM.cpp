@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Physics/VoxelCollider.h"
+#include "Test/TestTerrain.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr int       WORLD_SIZE   = 256;
+    constexpr int       WORLD_HEIGHT = 96;
+    constexpr int       ENTITIES     = 1 << 14;
+    constexpr int       TICKS        = 16;
+    constexpr int       CROWD_SIZE   = 48;
+    constexpr BlockKind STONE        = 1;
+
+    constexpr RollingGround GROUND {48, 6.0, 9.0, 5.0, 7.0};
+
+    struct NaiveResult
+    {
+        Vector3F Min      = Vector3F(0.0f);
+        bool     Grounded = false;
+    };
+
+    // The sweep as it is done today: every voxel the box passes on each axis, and the layer under
+    // its feet, read through GetBlock(). No stepping up.
+    NaiveResult NaiveMove(const ChunkedVoxelMap& map, Vector3F min, Vector3F max, const Vector3F& displacement)
+    {
+        float* const mins[3]   = {&min.X, &min.Y, &min.Z};
+        float* const maxs[3]   = {&max.X, &max.Y, &max.Z};
+        const float  wanted[3] = {displacement.X, displacement.Y, displacement.Z};
+        for (const int axis : {1, 0, 2})
+        {
+            float move = wanted[axis];
+            if (move == 0.0f)
+                continue;
+            int low[3];
+            int high[3];
+            for (int a = 0; a < 3; ++a)
+            {
+                low[a]  = static_cast<int>(std::floor(*mins[a] + 1e-4f));
+                high[a] = static_cast<int>(std::ceil(*maxs[a] - 1e-4f));
+            }
+            if (move > 0.0f)
+            {
+                low[axis]  = static_cast<int>(std::ceil(*maxs[axis] - 1e-4f));
+                high[axis] = static_cast<int>(std::ceil(*maxs[axis] + move));
+            }
+            else
+            {
+                high[axis] = static_cast<int>(std::floor(*mins[axis] + 1e-4f));
+                low[axis]  = static_cast<int>(std::floor(*mins[axis] + move));
+            }
+            for (int y = low[1]; y < high[1]; ++y)
+                for (int z = low[2]; z < high[2]; ++z)
+                    for (int x = low[0]; x < high[0]; ++x)
+                    {
+                        if (map.OutOfBounds(x, y, z) || map.GetBlock(x, y, z) == AIR_KIND)
+                            continue;
+                        const int cell = axis == 0 ? x : axis == 1 ? y : z;
+                        if (move > 0.0f)
+                            move = std::min(move, std::max(cell - *maxs[axis], 0.0f));
+                        else
+                            move = std::max(move, std::min(cell + 1 - *mins[axis], 0.0f));
+                    }
+            *mins[axis] += move;
+            *maxs[axis] += move;
+        }
+
+        NaiveResult result;
+        result.Min  = min;
+        const int y = static_cast<int>(std::floor(min.Y - 0.01f));
+        for (int z = static_cast<int>(std::floor(min.Z + 1e-4f)); z < static_cast<int>(std::ceil(max.Z - 1e-4f)); ++z)
+            for (int x = static_cast<int>(std::floor(min.X + 1e-4f)); x < static_cast<int>(std::ceil(max.X - 1e-4f)); ++x)
+                result.Grounded |= !map.OutOfBounds(x, y, z) && map.GetBlock(x, y, z) != AIR_KIND;
+        return result;
+    }
+} // namespace
+
+int main()
+{
+    ChunkedVoxelMap map(255, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    for (int z = 0; z < WORLD_SIZE; ++z)
+        for (int x = 0; x < WORLD_SIZE; ++x)
+            map.FillBlocks(Int3(x, 0, z), Int3(1, GROUND.Height(x, z), 1), STONE);
+    VoxelCollider collider(map);
+    ThreadPool    pool;
+
+    const double moves = static_cast<double>(ENTITIES) * TICKS;
+    for (const int spread : {WORLD_SIZE - 4, CROWD_SIZE})
+    {
+        // Walking and falling over the hills, in the order the server stores the entities.
+        std::mt19937                          rng(5);
+        std::uniform_real_distribution<float> position(1.0f, 1.0f + static_cast<float>(spread));
+        std::uniform_real_distribution<float> velocity(-0.3f, 0.3f);
+        std::vector<EntityMotion>             motions(ENTITIES);
+        for (EntityMotion& motion : motions)
+        {
+            motion.Min          = Vector3F(position(rng), 0.0f, position(rng));
+            motion.Min.Y        = static_cast<float>(GROUND.Height(static_cast<int>(motion.Min.X), static_cast<int>(motion.Min.Z))) + 0.5f;
+            motion.Max          = motion.Min + Vector3F(0.6f, 1.8f, 0.6f);
+            motion.Displacement = Vector3F(velocity(rng), -0.4f, velocity(rng));
+        }
+        std::vector<MoveResult> results(ENTITIES);
+        std::printf("%d entities over %d x %d voxels\n", ENTITIES, spread, spread);
+
+        float sink = 0.0f;
+        Report("Naive per-voxel GetBlock sweep", Measure([&] {
+                   for (int tick = 0; tick < TICKS; ++tick)
+                       for (const EntityMotion& motion : motions)
+                       {
+                           const NaiveResult result = NaiveMove(map, motion.Min, motion.Max, motion.Displacement);
+                           sink += result.Min.Y + static_cast<float>(result.Grounded);
+                       }
+               }),
+               moves, "move");
+        Report("VoxelCollider::Move one by one", Measure([&] {
+                   for (int tick = 0; tick < TICKS; ++tick)
+                       for (std::size_t i = 0; i < motions.size(); ++i)
+                           results[i] = collider.Move(motions[i]);
+               }),
+               moves, "move");
+        Report("VoxelCollider::MoveBatch on the pool", Measure([&] {
+                   for (int tick = 0; tick < TICKS; ++tick)
+                       collider.MoveBatch(motions, results, pool);
+               }),
+               moves, "move");
+        DoNotOptimize(sink);
+
+        const auto grounded = std::count_if(results.begin(), results.end(), [](const MoveResult& result) { return result.Grounded; });
+        std::printf("    %td grounded, %u threads\n", grounded, pool.ThreadCount());
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Terrain/TerrainGenerator.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int SAMPLES       = 1 << 20;
+    constexpr int WORLD_CHUNKS  = 16;
+    constexpr int WORLD_LAYERS  = 8;
+    constexpr int SERIAL_CHUNKS = 256;
+} // namespace
+
+int main()
+{
+    std::mt19937                          rng(5);
+    std::uniform_real_distribution<float> coordinate(-4096.0f, 4096.0f);
+    std::vector<float>                    x(SAMPLES), y(SAMPLES), z(SAMPLES), out(SAMPLES);
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        x[i] = coordinate(rng);
+        y[i] = coordinate(rng);
+        z[i] = coordinate(rng);
+    }
+
+    const GradientNoise   noise(1);
+    const FractalSettings fbm {FractalType::Fbm, 5, 1.0f / 256.0f, 2.0f, 0.5f};
+    float                 sum = 0.0f;
+    Report("2D noise, one sample at a time", Measure([&] {
+               for (int i = 0; i < SAMPLES; ++i)
+                   sum += noise.Sample(x[i], y[i]);
+           }),
+           SAMPLES, "sample");
+    Report("2D noise, batched", Measure([&] { noise.Sample(x, y, out); }), SAMPLES, "sample");
+    Report("3D noise, one sample at a time", Measure([&] {
+               for (int i = 0; i < SAMPLES; ++i)
+                   sum += noise.Sample(x[i], y[i], z[i]);
+           }),
+           SAMPLES, "sample");
+    Report("3D noise, batched", Measure([&] { noise.Sample(x, y, z, out); }), SAMPLES, "sample");
+    Report("5-octave 3D fbm, one sample at a time", Measure([&] {
+               for (int i = 0; i < SAMPLES; ++i)
+                   sum += noise.Fractal(fbm, x[i], y[i], z[i]);
+           }),
+           SAMPLES, "sample");
+    Report("5-octave 3D fbm, batched", Measure([&] { noise.Fractal(fbm, x, y, z, out); }), SAMPLES, "sample");
+    DoNotOptimize(sum);
+    DoNotOptimize(out);
+
+    // What the density pass would cost with 3D noise at every voxel.
+    const TerrainGenerator generator;
+    const TerrainSettings& settings = generator.Settings();
+    Report("Overhang and cave noise at every voxel", Measure([&] {
+               for (int i = 0; i < CHUNK_VOLUME; ++i)
+               {
+                   const float px = static_cast<float>(i & CHUNK_MASK);
+                   const float py = static_cast<float>(64 + (i >> (2 * CHUNK_SHIFT)));
+                   const float pz = static_cast<float>(i >> CHUNK_SHIFT & CHUNK_MASK);
+                   sum += noise.Fractal(settings.Overhangs, px, py, pz) + noise.Fractal(settings.Caves, px, py, pz);
+               }
+           }),
+           1.0, "chunk");
+    DoNotOptimize(sum);
+
+    // Surface chunks only: the layers around the base height, where both passes run.
+    VoxelChunk chunk;
+    Report("Generate surface chunk", Measure([&] {
+               for (int i = 0; i < SERIAL_CHUNKS; ++i)
+                   generator.Generate(Int3(i % 16, 2, i / 16), chunk);
+           }),
+           SERIAL_CHUNKS, "chunk");
+
+    // Whole columns, bottom to top, as a streamer loads them; capacity 0 recomputes the 2D fields per chunk.
+    for (const std::size_t capacity : {std::size_t {0}, std::size_t {1024}})
+    {
+        TerrainSettings columnSettings     = settings;
+        columnSettings.ColumnCacheCapacity = capacity;
+        const TerrainGenerator columns(columnSettings);
+        Report(capacity == 0 ? "Generate columns, no field cache" : "Generate columns, cached fields", Measure([&] {
+                   for (int i = 0; i < SERIAL_CHUNKS; ++i)
+                       columns.Generate(Int3(i / WORLD_LAYERS % 16, i % WORLD_LAYERS, i / WORLD_LAYERS / 16), chunk);
+               }),
+               SERIAL_CHUNKS, "chunk");
+        std::printf("    field cache hit rate %.2f\n", columns.CacheStats().HitRate());
+    }
+
+    ChunkedVoxelMap map(255, WORLD_CHUNKS * CHUNK_SIZE, WORLD_LAYERS * CHUNK_SIZE, WORLD_CHUNKS * CHUNK_SIZE);
+    ThreadPool      pool;
+    std::size_t     stored = 0;
+    const double    seconds =
+        Measure([&] { stored = generator.GenerateRegion(map, Int3(0, 0, 0), Int3(WORLD_CHUNKS - 1, WORLD_LAYERS - 1, WORLD_CHUNKS - 1), pool); });
+    Report("Generate region on the pool", seconds, WORLD_CHUNKS * WORLD_LAYERS * WORLD_CHUNKS, "chunk");
+    std::printf("    %u threads, %zu of %d chunks stored\n", pool.ThreadCount(), stored, WORLD_CHUNKS * WORLD_LAYERS * WORLD_CHUNKS);
+    return 0;
+}
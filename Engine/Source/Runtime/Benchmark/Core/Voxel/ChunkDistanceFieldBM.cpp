@@ -0,0 +1,124 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Test/TestTerrain.h"
+#include "Voxel/ChunkDistanceField.h"
+#include "Voxel/VoxelRaycaster.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr int       WORLD_SIZE   = 128;
+    constexpr int       WORLD_HEIGHT = 96;
+    constexpr int       EDITS        = 256;
+    constexpr int       QUERIES      = 1 << 18;
+    constexpr int       RAYS         = 1 << 16;
+    constexpr int       RADIUS       = 3;
+    constexpr BlockKind STONE        = 1;
+
+    // Whether any solid voxel lies within the radius, the way clearance checks scan today.
+    bool ScanForSolid(const ChunkedVoxelMap& map, int x, int y, int z)
+    {
+        for (int dy = -RADIUS; dy <= RADIUS; ++dy)
+            for (int dz = -RADIUS; dz <= RADIUS; ++dz)
+                for (int dx = -RADIUS; dx <= RADIUS; ++dx)
+                    if (dx * dx + dy * dy + dz * dz <= RADIUS * RADIUS && !map.OutOfBounds(x + dx, y + dy, z + dz) &&
+                        map.GetBlock(x + dx, y + dy, z + dz) != AIR_KIND)
+                        return true;
+        return false;
+    }
+} // namespace
+
+int main()
+{
+    ChunkedVoxelMap map(255, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    RollingGround {48, 10.0, 13.0, 8.0, 11.0}.Fill(map, STONE);
+    ThreadPool pool;
+
+    const double       chunkCount = static_cast<double>((WORLD_SIZE / CHUNK_SIZE) * (WORLD_SIZE / CHUNK_SIZE) * (WORLD_HEIGHT / CHUNK_SIZE));
+    ChunkDistanceField field(map);
+    Report("Distance field rebuild, one thread", Measure([&] { field.Rebuild(); }), chunkCount, "chunk");
+    Report("Distance field rebuild on the pool", Measure([&] { field.Rebuild(pool); }), chunkCount, "chunk");
+    std::printf("    %zu chunks stored, %.1f MB, %u threads\n", field.ChunkCount(), field.MemoryUsage() / 1048576.0, pool.ThreadCount());
+
+    // Scattered digging and building on the surface, then one update, waited for or dispatched.
+    std::mt19937                       rng(11);
+    std::uniform_int_distribution<int> column(0, WORLD_SIZE - 1);
+    std::uniform_int_distribution<int> height(36, 60);
+    auto                               edit = [&] {
+        for (int i = 0; i < EDITS; ++i)
+        {
+            const int x = column(rng);
+            const int y = height(rng);
+            const int z = column(rng);
+            map.SetBlock(x, y, z, i % 2 == 0 ? AIR_KIND : STONE);
+            field.OnBlockChanged(x, y, z);
+        }
+    };
+    edit();
+    const std::size_t pending = field.PendingCount();
+    Report("Distance field update after scattered edits", Measure([&] { field.Update(pool); }), EDITS, "edit");
+    std::printf("    %zu chunks recomputed\n", pending);
+    edit();
+    Report("Distance field dispatch, calling thread", Measure([&] { field.Dispatch(pool); }), EDITS, "edit");
+    Report("Distance field jobs until published", Measure([&] {
+               pool.WaitIdle();
+               field.Publish();
+           }),
+           EDITS, "edit");
+
+    // Clearance around random points near the surface: a neighbourhood scan against one lookup.
+    std::vector<Int3> points;
+    for (int i = 0; i < QUERIES; ++i)
+        points.push_back(Int3(column(rng), height(rng), column(rng)));
+    int blocked = 0;
+    Report("Clearance by neighbourhood scan", Measure([&] {
+               for (const Int3& point : points)
+                   blocked += ScanForSolid(map, point.X, point.Y, point.Z);
+           }),
+           QUERIES, "query");
+    int lookedUp = 0;
+    Report("Clearance by distance lookup", Measure([&] {
+               for (const Int3& point : points)
+                   lookedUp += field.Distance(point.X, point.Y, point.Z) <= RADIUS;
+           }),
+           QUERIES, "query");
+    std::printf("    %d and %d points blocked\n", blocked, lookedUp);
+
+    // Rays from above the terrain down at it: voxel traversal alone, and after sphere tracing.
+    VoxelRaycaster raycaster(map);
+    raycaster.Rebuild();
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<VoxelRay>                 rays;
+    for (int i = 0; i < RAYS; ++i)
+        rays.push_back(VoxelRay {Vector3F(column(rng) + 0.5f, 90.0f, column(rng) + 0.5f), Vector3F(unit(rng), -1.0f, unit(rng)), 200.0f});
+    std::vector<VoxelRayHit> hits(rays.size());
+    Report("Raycast", Measure([&] {
+               for (std::size_t i = 0; i < rays.size(); ++i)
+                   hits[i] = raycaster.Raycast(rays[i]);
+           }),
+           RAYS, "ray");
+    std::vector<float> traced(rays.size());
+    Report("Sphere trace", Measure([&] {
+               for (std::size_t i = 0; i < rays.size(); ++i)
+                   traced[i] = field.SphereTrace(rays[i].Origin, rays[i].Direction, rays[i].MaxDistance);
+           }),
+           RAYS, "ray");
+    double hitDistance = 0.0;
+    double skipped     = 0.0;
+    int    hitCount    = 0;
+    for (std::size_t i = 0; i < rays.size(); ++i)
+        if (hits[i].Hit)
+        {
+            hitDistance += hits[i].Distance;
+            skipped += traced[i];
+            ++hitCount;
+        }
+    std::printf("    %d hits, %.1f voxels away on average, %.1f of them sphere traced\n", hitCount, hitDistance / hitCount, skipped / hitCount);
+    return 0;
+}
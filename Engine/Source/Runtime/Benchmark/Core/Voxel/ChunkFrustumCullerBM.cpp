@@ -0,0 +1,78 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Math/MathUtility.h"
+#include "Voxel/ChunkFrustumCuller.h"
+#include "Voxel/VoxelChunk.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    // 128 x 8 x 128 chunks: a view radius of 64 chunks, fully resident.
+    constexpr int CHUNKS_ACROSS = 128;
+    constexpr int CHUNK_LAYERS  = 8;
+    constexpr int VIEWS         = 16;
+
+    struct Box
+    {
+        Vector3F Min;
+        Vector3F Max;
+    };
+} // namespace
+
+int main()
+{
+    ChunkFrustumCuller culler;
+    std::vector<Box>   boxes;
+    for (int cy = 0; cy < CHUNK_LAYERS; ++cy)
+        for (int cz = 0; cz < CHUNKS_ACROSS; ++cz)
+            for (int cx = 0; cx < CHUNKS_ACROSS; ++cx)
+            {
+                const uint32_t id = static_cast<uint32_t>(boxes.size());
+                culler.SetChunk(id, Int3(cx, cy, cz));
+                const Vector3F min(static_cast<float>(cx * CHUNK_SIZE), static_cast<float>(cy * CHUNK_SIZE), static_cast<float>(cz * CHUNK_SIZE));
+                boxes.push_back({min, min + Vector3F(static_cast<float>(CHUNK_SIZE))});
+            }
+    std::printf("    %zu chunks\n", boxes.size());
+
+    // The camera in the middle of the world, turning around once over the views.
+    const float          centre = CHUNKS_ACROSS * CHUNK_SIZE / 2.0f;
+    const Vector3F       eye(centre, 140.0f, centre);
+    const Matrix4F       projection = Matrix4F::CreatePerspectiveFieldOfView(VOXIUM_FLOAT_PI / 3.0f, 16.0f / 9.0f, 0.1f, 4096.0f);
+    std::vector<Frustum> frustums;
+    for (int view = 0; view < VIEWS; ++view)
+    {
+        const float angle = 2.0f * VOXIUM_FLOAT_PI * view / VIEWS;
+        frustums.emplace_back(Matrix4F::CreateLookAt(eye, eye + Vector3F(std::cos(angle), -0.2f, std::sin(angle)), Vector3F(0.0f, 1.0f, 0.0f)) * projection);
+    }
+
+    std::vector<uint32_t> visible;
+    visible.reserve(boxes.size());
+    std::size_t seen = 0;
+    Report("Scalar Frustum::Intersects per chunk", Measure([&] {
+               for (const Frustum& frustum : frustums)
+               {
+                   visible.clear();
+                   for (uint32_t id = 0; id < boxes.size(); ++id)
+                       if (frustum.Intersects(boxes[id].Min, boxes[id].Max))
+                           visible.push_back(id);
+                   seen += visible.size();
+               }
+           }),
+           static_cast<double>(boxes.size()) * VIEWS, "chunk");
+    DoNotOptimize(visible);
+
+    Report("ChunkFrustumCuller::Cull", Measure([&] {
+               for (const Frustum& frustum : frustums)
+                   culler.Cull(frustum, visible);
+           }),
+           static_cast<double>(boxes.size()) * VIEWS, "chunk");
+    DoNotOptimize(visible);
+    std::printf("    %zu of %zu chunks visible in the last view\n", visible.size(), boxes.size());
+    DoNotOptimize(seen);
+    return 0;
+}
@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Math/Morton.h"
+#include "Voxel/VoxelChunk.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int CHUNKS     = 256;
+    constexpr int CODES      = 1 << 20;
+    constexpr int HALF_SIZE  = CHUNK_SIZE / 2;
+    constexpr int FAR_AWAY   = 255;
+    constexpr int LIGHT_FULL = 15;
+
+    // Morton kernels look the code of each coordinate up instead of spreading its bits.
+    struct AxisCodes
+    {
+        int X[CHUNK_SIZE], Y[CHUNK_SIZE], Z[CHUNK_SIZE];
+
+        constexpr AxisCodes() : X {}, Y {}, Z {}
+        {
+            for (int i = 0; i < CHUNK_SIZE; ++i)
+            {
+                X[i] = ChunkMortonIndex(i, 0, 0);
+                Y[i] = ChunkMortonIndex(0, i, 0);
+                Z[i] = ChunkMortonIndex(0, 0, i);
+            }
+        }
+    };
+
+    constexpr AxisCodes AXIS_CODES;
+
+    template<ChunkLayout LAYOUT>
+    constexpr int At(int x, int y, int z)
+    {
+        if constexpr (LAYOUT == ChunkLayout::Morton)
+            return AXIS_CODES.X[x] | AXIS_CODES.Y[y] | AXIS_CODES.Z[z];
+        else
+            return ChunkIndex(x, y, z);
+    }
+
+    // Hills with caves: about half of the voxels solid, with air pockets everywhere.
+    VoxelChunk MakeChunk(int seed)
+    {
+        VoxelChunk chunk;
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                {
+                    const double height = 16.0 + 8.0 * std::sin((x + seed * 7) / 9.0) * std::cos((z + seed * 3) / 11.0);
+                    const double cave   = std::sin(x / 5.0 + seed) * std::sin(y / 4.0) * std::sin(z / 6.0 - seed);
+                    if (y < height && cave < 0.3)
+                        chunk.Set(x, y, z, static_cast<BlockKind>(1 + (x + y + z + seed) % 3));
+                }
+        return chunk;
+    }
+
+    // Ambient occlusion: for every solid voxel with air above, the solid voxels among the eight
+    // around the one above, as the four top face corners sample them.
+    template<ChunkLayout LAYOUT>
+    uint64_t AmbientOcclusion(const BlockKind* kinds)
+    {
+        uint64_t occlusion = 0;
+        for (int y = 0; y < CHUNK_SIZE - 1; ++y)
+            for (int z = 1; z < CHUNK_SIZE - 1; ++z)
+                for (int x = 1; x < CHUNK_SIZE - 1; ++x)
+                {
+                    if (kinds[At<LAYOUT>(x, y, z)] == AIR_KIND || kinds[At<LAYOUT>(x, y + 1, z)] != AIR_KIND)
+                        continue;
+                    for (int dz = -1; dz <= 1; ++dz)
+                        for (int dx = -1; dx <= 1; ++dx)
+                            occlusion += kinds[At<LAYOUT>(x + dx, y + 1, z + dz)] != AIR_KIND;
+                }
+        return occlusion;
+    }
+
+    // Block light flood fill from the middle of the chunk through air, six neighbours per voxel.
+    template<ChunkLayout LAYOUT>
+    int FloodLight(const BlockKind* kinds, uint8_t* levels, std::vector<uint32_t>& queue)
+    {
+        std::fill(levels, levels + CHUNK_VOLUME, 0);
+        queue.clear();
+        const int centre = HALF_SIZE;
+        levels[At<LAYOUT>(centre, centre, centre)] = LIGHT_FULL;
+        queue.push_back(ChunkIndex(centre, centre, centre));
+        for (std::size_t head = 0; head < queue.size(); ++head)
+        {
+            const int x     = static_cast<int>(queue[head] & CHUNK_MASK);
+            const int z     = static_cast<int>(queue[head] >> CHUNK_SHIFT & CHUNK_MASK);
+            const int y     = static_cast<int>(queue[head] >> (2 * CHUNK_SHIFT));
+            const int level = levels[At<LAYOUT>(x, y, z)] - 1;
+            if (level <= 0)
+                continue;
+            for (int face = 0; face < BLOCK_FACE_COUNT; ++face)
+            {
+                const Int3 next = Int3(x, y, z) + FaceNormal(static_cast<BlockFace>(face));
+                if ((next.X | next.Y | next.Z) & ~CHUNK_MASK)
+                    continue;
+                const int index = At<LAYOUT>(next.X, next.Y, next.Z);
+                if (levels[index] >= level || kinds[index] != AIR_KIND)
+                    continue;
+                levels[index] = static_cast<uint8_t>(level);
+                queue.push_back(static_cast<uint32_t>(ChunkIndex(next.X, next.Y, next.Z)));
+            }
+        }
+        return static_cast<int>(queue.size());
+    }
+
+    // Halves the chunk: each cell of the 16^3 result keeps the highest kind of its 2^3 voxels.
+    template<ChunkLayout LAYOUT>
+    void Downsample(const BlockKind* kinds, BlockKind* half)
+    {
+        for (int y = 0; y < HALF_SIZE; ++y)
+            for (int z = 0; z < HALF_SIZE; ++z)
+                for (int x = 0; x < HALF_SIZE; ++x)
+                {
+                    BlockKind kind = AIR_KIND;
+                    if constexpr (LAYOUT == ChunkLayout::Morton)
+                    {
+                        const BlockKind* cells = kinds + 8 * At<LAYOUT>(x, y, z);
+                        for (int c = 0; c < 8; ++c)
+                            kind = std::max(kind, cells[c]);
+                    }
+                    else
+                    {
+                        for (int c = 0; c < 8; ++c)
+                            kind = std::max(kind, kinds[ChunkIndex(2 * x + (c & 1), 2 * y + (c >> 2), 2 * z + (c >> 1 & 1))]);
+                    }
+                    half[x | z << 4 | y << 8] = kind;
+                }
+    }
+
+    // City block distance to the nearest solid voxel, in a forward and a backward raster pass.
+    template<ChunkLayout LAYOUT>
+    int DistanceField(const BlockKind* kinds, uint8_t* distances)
+    {
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                {
+                    const int index   = At<LAYOUT>(x, y, z);
+                    int       nearest = kinds[index] != AIR_KIND ? 0 : FAR_AWAY;
+                    if (x > 0)
+                        nearest = std::min(nearest, distances[At<LAYOUT>(x - 1, y, z)] + 1);
+                    if (y > 0)
+                        nearest = std::min(nearest, distances[At<LAYOUT>(x, y - 1, z)] + 1);
+                    if (z > 0)
+                        nearest = std::min(nearest, distances[At<LAYOUT>(x, y, z - 1)] + 1);
+                    distances[index] = static_cast<uint8_t>(nearest);
+                }
+        int total = 0;
+        for (int y = CHUNK_SIZE - 1; y >= 0; --y)
+            for (int z = CHUNK_SIZE - 1; z >= 0; --z)
+                for (int x = CHUNK_SIZE - 1; x >= 0; --x)
+                {
+                    const int index   = At<LAYOUT>(x, y, z);
+                    int       nearest = distances[index];
+                    if (x < CHUNK_MASK)
+                        nearest = std::min(nearest, distances[At<LAYOUT>(x + 1, y, z)] + 1);
+                    if (y < CHUNK_MASK)
+                        nearest = std::min(nearest, distances[At<LAYOUT>(x, y + 1, z)] + 1);
+                    if (z < CHUNK_MASK)
+                        nearest = std::min(nearest, distances[At<LAYOUT>(x, y, z + 1)] + 1);
+                    distances[index] = static_cast<uint8_t>(nearest);
+                    total += nearest;
+                }
+        return total;
+    }
+
+    template<ChunkLayout LAYOUT>
+    void RunKernels(const char* name, const std::vector<VoxelChunk>& chunks)
+    {
+        std::vector<BlockKind> kinds(static_cast<std::size_t>(CHUNKS) * CHUNK_VOLUME);
+        std::vector<uint8_t>   bytes(static_cast<std::size_t>(CHUNKS) * CHUNK_VOLUME);
+        std::vector<BlockKind> half(static_cast<std::size_t>(CHUNKS) * CHUNK_VOLUME / 8);
+        std::vector<uint32_t>  queue;
+        char                   label[64];
+
+        std::snprintf(label, sizeof(label), "Unpack, %s", name);
+        Report(label, Measure([&] {
+                   for (int c = 0; c < CHUNKS; ++c)
+                       chunks[c].Unpack(std::span<BlockKind, CHUNK_VOLUME>(kinds.data() + static_cast<std::size_t>(c) * CHUNK_VOLUME, CHUNK_VOLUME), LAYOUT);
+               }),
+               CHUNKS, "chunk");
+
+        uint64_t occlusion = 0;
+        std::snprintf(label, sizeof(label), "Ambient occlusion, %s", name);
+        Report(label, Measure([&] {
+                   for (int c = 0; c < CHUNKS; ++c)
+                       occlusion += AmbientOcclusion<LAYOUT>(kinds.data() + static_cast<std::size_t>(c) * CHUNK_VOLUME);
+               }),
+               CHUNKS, "chunk");
+
+        int lit = 0;
+        std::snprintf(label, sizeof(label), "Light flood fill, %s", name);
+        Report(label, Measure([&] {
+                   for (int c = 0; c < CHUNKS; ++c)
+                       lit += FloodLight<LAYOUT>(kinds.data() + static_cast<std::size_t>(c) * CHUNK_VOLUME,
+                                                 bytes.data() + static_cast<std::size_t>(c) * CHUNK_VOLUME, queue);
+               }),
+               CHUNKS, "chunk");
+
+        std::snprintf(label, sizeof(label), "Downsample 2x, %s", name);
+        Report(label, Measure([&] {
+                   for (int c = 0; c < CHUNKS; ++c)
+                       Downsample<LAYOUT>(kinds.data() + static_cast<std::size_t>(c) * CHUNK_VOLUME,
+                                          half.data() + static_cast<std::size_t>(c) * CHUNK_VOLUME / 8);
+               }),
+               CHUNKS, "chunk");
+
+        int distance = 0;
+        std::snprintf(label, sizeof(label), "Distance field, %s", name);
+        Report(label, Measure([&] {
+                   for (int c = 0; c < CHUNKS; ++c)
+                       distance += DistanceField<LAYOUT>(kinds.data() + static_cast<std::size_t>(c) * CHUNK_VOLUME,
+                                                         bytes.data() + static_cast<std::size_t>(c) * CHUNK_VOLUME);
+               }),
+               CHUNKS, "chunk");
+
+        std::printf("    occlusion %llu, lit %d, distance %d\n", static_cast<unsigned long long>(occlusion), lit, distance);
+        DoNotOptimize(half);
+    }
+} // namespace
+
+int main()
+{
+    std::mt19937          random(19);
+    std::vector<uint64_t> codes(CODES);
+    std::vector<Int3>     positions;
+    positions.reserve(CODES);
+    for (int i = 0; i < CODES; ++i)
+        positions.emplace_back(static_cast<int>(random() & MORTON_AXIS_MASK), static_cast<int>(random() & MORTON_AXIS_MASK),
+                               static_cast<int>(random() & MORTON_AXIS_MASK));
+
+    Report("MortonEncode, magic numbers", Measure([&] {
+               for (int i = 0; i < CODES; ++i)
+                   codes[i] = MortonEncode(positions[i]);
+           }),
+           CODES);
+    Report("MortonEncodeFast", Measure([&] {
+               for (int i = 0; i < CODES; ++i)
+                   codes[i] = MortonEncodeFast(positions[i]);
+           }),
+           CODES);
+    Report("MortonDecode, magic numbers", Measure([&] {
+               for (int i = 0; i < CODES; ++i)
+                   positions[i] = MortonDecode(codes[i]);
+           }),
+           CODES);
+    Report("MortonDecodeFast", Measure([&] {
+               for (int i = 0; i < CODES; ++i)
+                   positions[i] = MortonDecodeFast(codes[i]);
+           }),
+           CODES);
+    DoNotOptimize(positions);
+
+    std::vector<VoxelChunk> chunks;
+    for (int c = 0; c < CHUNKS; ++c)
+        chunks.push_back(MakeChunk(c));
+
+    RunKernels<ChunkLayout::Linear>("linear", chunks);
+    RunKernels<ChunkLayout::Morton>("Morton", chunks);
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <random>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Test/TestTerrain.h"
+#include "Voxel/ChunkLightEngine.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr int       WORLD_SIZE   = 128;
+    constexpr int       WORLD_HEIGHT = 96;
+    constexpr int       EDITS        = 2048;
+    constexpr BlockKind STONE        = 1;
+    constexpr BlockKind TORCH        = 2;
+
+    void AddAllChunks(ChunkLightEngine& engine)
+    {
+        for (int cy = 0; cy * CHUNK_SIZE < WORLD_HEIGHT; ++cy)
+            for (int cz = 0; cz * CHUNK_SIZE < WORLD_SIZE; ++cz)
+                for (int cx = 0; cx * CHUNK_SIZE < WORLD_SIZE; ++cx)
+                    engine.AddChunk(Int3(cx, cy, cz));
+    }
+} // namespace
+
+int main()
+{
+    ChunkedVoxelMap map(255, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    RollingGround {48, 10.0, 13.0, 8.0, 11.0}.Fill(map, STONE);
+    ThreadPool pool;
+
+    // Lighting everything from scratch, as a relight on every edit would.
+    const double chunkCount = static_cast<double>((WORLD_SIZE / CHUNK_SIZE) * (WORLD_SIZE / CHUNK_SIZE) * (WORLD_HEIGHT / CHUNK_SIZE));
+    Report("Full relight", Measure([&] {
+               ChunkLightEngine engine(map, pool);
+               engine.SetEmission(TORCH, 14);
+               AddAllChunks(engine);
+               engine.Propagate();
+           }),
+           chunkCount, "chunk");
+
+    ChunkLightEngine engine(map, pool);
+    engine.SetEmission(TORCH, 14);
+    AddAllChunks(engine);
+    engine.Propagate();
+
+    // A player digging into the hillside just below the surface, relit after every block.
+    std::mt19937                       rng(5);
+    std::uniform_int_distribution<int> coordinate(8, WORLD_SIZE - 9), depth(1, 6);
+    Report("Incremental dig", Measure([&] {
+               for (int i = 0; i < EDITS; ++i)
+               {
+                   const int       x   = coordinate(rng);
+                   const int       z   = coordinate(rng);
+                   const int       y   = 38 - depth(rng);
+                   const BlockKind old = map.GetBlock(x, y, z);
+                   map.SetBlock(x, y, z, AIR_KIND);
+                   engine.OnBlockChanged(x, y, z, old);
+                   engine.Propagate();
+                   map.SetBlock(x, y, z, old);
+                   engine.OnBlockChanged(x, y, z, AIR_KIND);
+                   engine.Propagate();
+               }
+           }),
+           2.0 * EDITS, "edit");
+
+    // Torches placed and taken away again in the open.
+    Report("Incremental torch", Measure([&] {
+               for (int i = 0; i < EDITS; ++i)
+               {
+                   const int x = coordinate(rng);
+                   const int z = coordinate(rng);
+                   map.SetBlock(x, 70, z, TORCH);
+                   engine.OnBlockChanged(x, 70, z, AIR_KIND);
+                   engine.Propagate();
+                   map.SetBlock(x, 70, z, AIR_KIND);
+                   engine.OnBlockChanged(x, 70, z, TORCH);
+                   engine.Propagate();
+               }
+           }),
+           2.0 * EDITS, "edit");
+    DoNotOptimize(engine.TakeChangedChunks());
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Test/TestTerrain.h"
+#include "Voxel/ChunkMeshPipeline.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr int WORLD_X = 512;
+    constexpr int WORLD_Y = 128;
+    constexpr int WORLD_Z = 512;
+    constexpr int BLASTS  = 10;
+    constexpr int RADIUS  = 36;
+    constexpr int GROUND  = 64;
+
+    // Rolling terrain: stone below dirt below grass.
+    void BuildTerrain(ChunkedVoxelMap& map)
+    {
+        std::vector<BlockKind> column(WORLD_Y);
+        const RollingGround    ground {GROUND, 6.0, 17.0, 5.0, 23.0};
+        for (int z = 0; z < WORLD_Z; ++z)
+            for (int x = 0; x < WORLD_X; ++x)
+            {
+                const int height = ground.Height(x, z);
+                for (int y = 0; y < WORLD_Y; ++y)
+                    column[y] = y > height ? AIR_KIND : y == height ? 3 : y > height - 4 ? 2 : 1;
+                map.AddBlockBox(Int3(x, 0, z), Int3(1, WORLD_Y, 1), column);
+            }
+    }
+
+    // Air sphere writes around center.
+    std::vector<VoxelWrite> Crater(const Int3& center)
+    {
+        std::vector<VoxelWrite> writes;
+        for (int y = -RADIUS; y <= RADIUS; ++y)
+            for (int z = -RADIUS; z <= RADIUS; ++z)
+                for (int x = -RADIUS; x <= RADIUS; ++x)
+                    if (x * x + y * y + z * z <= RADIUS * RADIUS)
+                        writes.push_back({Int3(center.X + x, center.Y + y, center.Z + z), AIR_KIND});
+        return writes;
+    }
+} // namespace
+
+int main()
+{
+    ChunkedVoxelMap map(255, WORLD_X, WORLD_Y, WORLD_Z);
+    BuildTerrain(map);
+
+    ThreadPool        pool;
+    ChunkMeshPipeline pipeline(map, pool);
+
+    double editBest     = 0.0;
+    double dispatchBest = 0.0;
+    double totalBest    = 0.0;
+    int    chunks       = 0;
+    for (int blast = 0; blast < BLASTS; ++blast)
+    {
+        const Int3                    center(96 + blast * 32, GROUND, 256);
+        const std::vector<VoxelWrite> writes = Crater(center);
+        const Int3                    origin(center.X - RADIUS, center.Y - RADIUS, center.Z - RADIUS);
+        const Int3                    size(2 * RADIUS + 1, 2 * RADIUS + 1, 2 * RADIUS + 1);
+
+        // Main thread: the edit, dirty marking and job dispatch. Meshing runs on the pool.
+        std::size_t started  = 0;
+        const auto  edit     = Measure([&] { map.AddBlocks(writes); });
+        const auto  dispatch = Measure([&] {
+            pipeline.MarkBoxDirty(origin, size);
+            started = pipeline.Dispatch();
+        });
+        const auto total = Measure([&] {
+            std::size_t received = 0;
+            while (received < started)
+            {
+                if (std::optional<ChunkMeshResult> result = pipeline.PopResult())
+                {
+                    DoNotOptimize(result->Mesh.VertexCount);
+                    ++received;
+                }
+                else if (pipeline.JobsInFlight() == 0)
+                {
+                    break;
+                }
+            }
+        });
+
+        editBest     = blast == 0 ? edit : std::min(editBest, edit);
+        dispatchBest = blast == 0 ? dispatch : std::min(dispatchBest, dispatch);
+        totalBest    = blast == 0 ? dispatch + total : std::min(totalBest, dispatch + total);
+        chunks       = static_cast<int>(started);
+    }
+
+    std::printf("Explosion of radius %d touching %d chunks, %u worker threads (best of %d)\n", RADIUS, chunks, pool.ThreadCount(), BLASTS);
+    Report("Main thread: edit", editBest, chunks, "chunk");
+    Report("Main thread: mark dirty + dispatch", dispatchBest, chunks, "chunk");
+    Report("Dispatch until last mesh popped", totalBest, chunks, "chunk");
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Math/MathUtility.h"
+#include "Voxel/ChunkOcclusionCuller.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    // 64 x 8 x 64 chunks of rock under a surface layer, with a tunnel one chunk wide and high
+    // running along X through the middle.
+    constexpr int CHUNKS_ACROSS = 64;
+    constexpr int CHUNK_LAYERS  = 8;
+    constexpr int SURFACE_LAYER = 6;
+    constexpr int TUNNEL_LAYER  = 2;
+    constexpr int VIEWS         = 16;
+
+    bool IsRock(const Int3& chunkPos)
+    {
+        return chunkPos.Y < SURFACE_LAYER && !(chunkPos.Y == TUNNEL_LAYER && chunkPos.Z == CHUNKS_ACROSS / 2);
+    }
+} // namespace
+
+int main()
+{
+    ChunkFrustumCuller boxes;
+    std::vector<Int3>  chunks;
+    for (int cy = 0; cy < CHUNK_LAYERS; ++cy)
+        for (int cz = 0; cz < CHUNKS_ACROSS; ++cz)
+            for (int cx = 0; cx < CHUNKS_ACROSS; ++cx)
+            {
+                boxes.SetChunk(static_cast<uint32_t>(chunks.size()), Int3(cx, cy, cz));
+                chunks.emplace_back(cx, cy, cz);
+            }
+    std::printf("    %zu chunks\n", chunks.size());
+
+    // Walking down the tunnel, looking a little to the sides.
+    const Matrix4F        projection = Matrix4F::CreatePerspectiveFieldOfView(VOXIUM_FLOAT_PI / 3.0f, 16.0f / 9.0f, 0.1f, 4096.0f);
+    std::vector<Matrix4F> viewProjections;
+    std::vector<Vector3F> eyes;
+    for (int view = 0; view < VIEWS; ++view)
+    {
+        const Vector3F eye((8.0f + view * 2.0f) * CHUNK_SIZE, (TUNNEL_LAYER + 0.5f) * CHUNK_SIZE, (CHUNKS_ACROSS / 2 + 0.5f) * CHUNK_SIZE);
+        const float    angle = 0.6f * std::sin(view * 0.7f);
+        eyes.push_back(eye);
+        viewProjections.push_back(Matrix4F::CreateLookAt(eye, eye + Vector3F(std::cos(angle), 0.1f, std::sin(angle)), Vector3F(0.0f, 1.0f, 0.0f)) *
+                                  projection);
+    }
+
+    std::vector<uint32_t> visible;
+    std::size_t           inFrustum = 0;
+    Report("ChunkFrustumCuller::Cull", Measure([&] {
+               inFrustum = 0;
+               for (const Matrix4F& viewProjection : viewProjections)
+               {
+                   boxes.Cull(viewProjection, visible);
+                   inFrustum += visible.size();
+               }
+           }),
+           VIEWS, "view");
+
+    // Occluders are the rock chunks within eight chunks of the eye, as a streamer would keep them.
+    ChunkOcclusionCuller culler;
+    std::size_t          drawn = 0, remaining = 0;
+    Report("Frustum cull, draw occluders, build pyramid and filter", Measure([&] {
+               drawn     = 0;
+               remaining = 0;
+               for (int view = 0; view < VIEWS; ++view)
+               {
+                   boxes.Cull(viewProjections[view], visible);
+                   culler.Begin(viewProjections[view], eyes[view]);
+                   const Int3 eyeChunk = ChunkOf(static_cast<int>(eyes[view].X), static_cast<int>(eyes[view].Y), static_cast<int>(eyes[view].Z));
+                   for (uint32_t id : visible)
+                   {
+                       const Int3& chunkPos = chunks[id];
+                       if (IsRock(chunkPos) && std::abs(chunkPos.X - eyeChunk.X) <= 8 && std::abs(chunkPos.Y - eyeChunk.Y) <= 8 &&
+                           std::abs(chunkPos.Z - eyeChunk.Z) <= 8)
+                           culler.AddChunkOccluder(chunkPos);
+                   }
+                   culler.Finish();
+                   drawn += culler.OccludersDrawn();
+                   culler.Filter(visible, boxes);
+                   remaining += visible.size();
+               }
+           }),
+           VIEWS, "view");
+    std::printf("    %.0f chunks in the frustum per view, %.0f after occlusion (%.1f%% culled), %.0f occluders drawn\n",
+                static_cast<double>(inFrustum) / VIEWS, static_cast<double>(remaining) / VIEWS, 100.0 * (1.0 - static_cast<double>(remaining) / inFrustum),
+                static_cast<double>(drawn) / VIEWS);
+    DoNotOptimize(visible);
+    return 0;
+}
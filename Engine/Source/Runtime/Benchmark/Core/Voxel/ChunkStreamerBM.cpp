@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Test/TestTerrain.h"
+#include "Voxel/ChunkStreamer.h"
+#include "Voxel/RegionFile.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr int   WORLD_COLUMNS = 512;
+    constexpr int   WORLD_HEIGHT  = 4 * CHUNK_SIZE;
+    constexpr int   VIEW_RADIUS   = 64;
+    constexpr int   FRAMES        = 240;
+    constexpr float SPEED         = 16.0f; // voxels per frame, about 1000 per second at 60 Hz
+
+    constexpr auto FRAME_TIME = std::chrono::microseconds(16667);
+
+    // Stored chunks are decoded from real region records, so loads cost what they cost on disk:
+    // stone with ore speckles below, a rolling surface above, nothing stored further up.
+    struct StoredRecords
+    {
+        StoredRecords()
+        {
+            std::mt19937                       rng(5);
+            std::uniform_int_distribution<int> ore(0, 63);
+            const RollingGround                ground {12, 6.0, 9.0, 5.0, 11.0};
+            for (int variant = 0; variant < VARIANTS; ++variant)
+            {
+                VoxelChunk stone(1);
+                VoxelChunk surface;
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; ++x)
+                    {
+                        const int height = ground.Height(x + variant * 7, z);
+                        for (int y = 0; y < CHUNK_SIZE; ++y)
+                        {
+                            if (ore(rng) == 0)
+                                stone.Set(x, y, z, static_cast<BlockKind>(4 + ore(rng) % 4));
+                            surface.Set(x, y, z, y > height ? AIR_KIND : y == height ? 3 : y > height - 4 ? 2 : 1);
+                        }
+                    }
+                RegionFile::EncodeRecord(stone, Records[0][variant]);
+                RegionFile::EncodeRecord(surface, Records[1][variant]);
+            }
+        }
+
+        bool Load(const Int3& chunkPos, VoxelChunk& chunk) const
+        {
+            if (chunkPos.Y > 1)
+                return false;
+            chunk = RegionFile::DecodeRecord(Records[chunkPos.Y][(chunkPos.X * 7 + chunkPos.Z * 13) & (VARIANTS - 1)]);
+            return true;
+        }
+
+        static constexpr int VARIANTS = 8;
+
+        std::vector<uint8_t> Records[2][VARIANTS];
+    };
+
+    double Percentile(std::vector<double> values, double fraction)
+    {
+        std::sort(values.begin(), values.end());
+        return values[static_cast<std::size_t>(fraction * (values.size() - 1))];
+    }
+} // namespace
+
+int main()
+{
+    const StoredRecords records;
+    ChunkedVoxelMap     map(255, WORLD_COLUMNS * CHUNK_SIZE, WORLD_HEIGHT, WORLD_COLUMNS * CHUNK_SIZE);
+    ThreadPool          pool;
+    auto                loader = [&](const Int3& chunkPos, VoxelChunk& chunk) { return records.Load(chunkPos, chunk); };
+
+    {
+        // What a synchronous loader does on the main thread each time the camera crosses a column:
+        // every chunk of the entering ring, here a ring of 2 * 64 + 1 columns.
+        VoxelChunk chunk;
+        Report("Synchronous ring load (one crossing)", Measure([&] {
+                   for (int x = 0; x <= 2 * VIEW_RADIUS; ++x)
+                       for (int y = 0; y < WORLD_HEIGHT / CHUNK_SIZE; ++y)
+                       {
+                           records.Load(Int3(x, y, 0), chunk);
+                           DoNotOptimize(chunk);
+                       }
+               }),
+               (2 * VIEW_RADIUS + 1) * WORLD_HEIGHT / CHUNK_SIZE, "chunk");
+    }
+
+    ChunkStreamerSettings settings;
+    settings.ViewRadius       = VIEW_RADIUS;
+    settings.MaxLoadsInFlight = 256;
+    settings.PublishBudget    = 128;
+    ChunkStreamer streamer(map, pool, loader, settings);
+
+    Vector3F       position(WORLD_COLUMNS * CHUNK_SIZE * 0.25f, 80.0f, WORLD_COLUMNS * CHUNK_SIZE * 0.5f);
+    const Vector3F forward(1.0f, 0.0f, 0.0f);
+
+    // Initial fill: frames are paced at 60 Hz so the workers get the time between updates.
+    std::vector<double> updates;
+    int                 fillFrames = 0;
+    auto                frame      = std::chrono::steady_clock::now();
+    const double        fill       = Measure([&] {
+        do
+        {
+            updates.push_back(Measure([&] { streamer.Update(position, forward); }));
+            ++fillFrames;
+            frame += FRAME_TIME;
+            std::this_thread::sleep_until(frame);
+        } while (streamer.PendingCount() > 0 || streamer.LoadsInFlight() > 0);
+    });
+    std::printf("Initial fill: %zu chunks resident, %d frames (%.2f s); Update p50 %.3f ms, max %.3f ms\n", streamer.ResidentCount(), fillFrames, fill,
+                Percentile(updates, 0.5) * 1e3, Percentile(updates, 1.0) * 1e3);
+
+    updates.clear();
+    std::size_t published = 0;
+    std::size_t backlog   = 0;
+    frame                 = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAMES; ++i)
+    {
+        position = position + forward * SPEED;
+        updates.push_back(Measure([&] { streamer.Update(position, forward); }));
+        published += streamer.Published().size();
+        backlog = std::max(backlog, streamer.PendingCount());
+        frame += FRAME_TIME;
+        std::this_thread::sleep_until(frame);
+    }
+    std::printf("Flying %.0f voxels/frame: Update p50 %.3f ms, p99 %.3f ms, max %.3f ms; %.1f chunks published/frame, backlog peak %zu\n", SPEED,
+                Percentile(updates, 0.5) * 1e3, Percentile(updates, 0.99) * 1e3, Percentile(updates, 1.0) * 1e3, static_cast<double>(published) / FRAMES,
+                backlog);
+    std::printf("    %zu chunks in the map, %.1f MB\n", map.ChunkCount(), map.MemoryUsage() / 1048576.0);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Math/MathUtility.h"
+#include "Math/Matrix4F.h"
+#include "Voxel/ChunkVisibilityGraph.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int WORLD_SIZE   = 1024;
+    constexpr int WORLD_HEIGHT = 256;
+    constexpr int VIEWS        = 16;
+} // namespace
+
+int main()
+{
+    // Hills over rock up to y = 160, with winding tunnels carved out of the rock.
+    ChunkedVoxelMap map(255, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    for (int z = 0; z < WORLD_SIZE; ++z)
+        for (int x = 0; x < WORLD_SIZE; ++x)
+        {
+            const int height = 160 + static_cast<int>(16.0 * std::sin(x / 61.0) * std::cos(z / 47.0));
+            map.FillBlocks(Int3(x, 0, z), Int3(1, height, 1), 1);
+        }
+    for (int tunnel = 0; tunnel < 24; ++tunnel)
+        for (int x = 0; x < WORLD_SIZE; x += 2)
+        {
+            const int y = 30 + tunnel * 5 + static_cast<int>(8.0 * std::sin(x / 37.0 + tunnel));
+            const int z = 20 + tunnel * 41 + static_cast<int>(24.0 * std::cos(x / 53.0 + tunnel * 2));
+            map.FillBlocks(Int3(x, y, z), Int3(3, 4, 4), AIR_KIND);
+        }
+    std::printf("    %zu chunks\n", map.ChunkCount());
+
+    ChunkVisibilityGraph graph;
+    Report("ComputeConnectivity", Measure([&] {
+               map.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk&) { graph.Update(map, chunkPos); });
+           }),
+           static_cast<double>(map.ChunkCount()), "chunk");
+
+    // Walking through a tunnel, looking along it.
+    const Matrix4F        projection = Matrix4F::CreatePerspectiveFieldOfView(VOXIUM_FLOAT_PI / 3.0f, 16.0f / 9.0f, 0.1f, 4096.0f);
+    std::vector<Vector3F> eyes;
+    std::vector<Frustum>  frustums;
+    for (int view = 0; view < VIEWS; ++view)
+    {
+        const int      x = 200 + view * 40, tunnel = 12;
+        const Vector3F eye(static_cast<float>(x + 1), 32.0f + tunnel * 5 + static_cast<float>(8.0 * std::sin(x / 37.0 + tunnel)),
+                           22.0f + tunnel * 41 + static_cast<float>(24.0 * std::cos(x / 53.0 + tunnel * 2)));
+        eyes.push_back(eye);
+        frustums.emplace_back(Matrix4F::CreateLookAt(eye, eye + Vector3F(1.0f, 0.0f, 0.0f), Vector3F(0.0f, 1.0f, 0.0f)) * projection);
+    }
+
+    std::vector<Int3> visible;
+    std::size_t       reached = 0;
+    Report("Traverse, 16 chunks deep", Measure([&] {
+               reached = 0;
+               for (int view = 0; view < VIEWS; ++view)
+               {
+                   graph.Traverse(eyes[view], frustums[view], 16, visible);
+                   reached += visible.size();
+               }
+           }),
+           VIEWS, "view");
+
+    std::size_t inFrustum = 0;
+    for (int view = 0; view < VIEWS; ++view)
+        map.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk&) {
+            const Int3     camera = ChunkOf(static_cast<int>(eyes[view].X), static_cast<int>(eyes[view].Y), static_cast<int>(eyes[view].Z));
+            const Vector3F min(ChunkBoundsMin(chunkPos));
+            inFrustum += std::abs(chunkPos.X - camera.X) <= 16 && std::abs(chunkPos.Y - camera.Y) <= 16 && std::abs(chunkPos.Z - camera.Z) <= 16 &&
+                         frustums[view].Intersects(min, min + Vector3F(static_cast<float>(CHUNK_SIZE)));
+        });
+    std::printf("    %.0f chunks in the frustum per view, %.0f reached (%.1f%% culled)\n", static_cast<double>(inFrustum) / VIEWS,
+                static_cast<double>(reached) / VIEWS, 100.0 * (1.0 - static_cast<double>(reached) / inFrustum));
+    DoNotOptimize(visible);
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int SIZE_X = 512;
+    constexpr int SIZE_Y = 128;
+    constexpr int SIZE_Z = 512;
+
+    // Layered terrain with a handful of kinds per chunk, close to what generated worlds look like.
+    BlockKind TerrainKind(int x, int y, int z)
+    {
+        const int height = 64 + ((x * 7 + z * 13) % 17);
+        if (y > height)
+            return AIR_KIND;
+        if (y == height)
+            return 3;
+        if (y > height - 4)
+            return 2;
+        return ((x ^ y ^ z) & 63) == 0 ? 4 : 1;
+    }
+} // namespace
+
+int main()
+{
+    ChunkedVoxelMap map(255, SIZE_X, SIZE_Y, SIZE_Z);
+    const double    voxels = static_cast<double>(SIZE_X) * SIZE_Y * SIZE_Z;
+
+    double seconds = Measure([&] {
+        for (int y = 0; y < SIZE_Y; ++y)
+            for (int z = 0; z < SIZE_Z; ++z)
+                for (int x = 0; x < SIZE_X; ++x)
+                    map.SetBlock(x, y, z, TerrainKind(x, y, z));
+    });
+    Report("SetBlock sequential", seconds, voxels);
+
+    uint64_t sum = 0;
+    seconds      = Measure([&] {
+        for (int y = 0; y < SIZE_Y; ++y)
+            for (int z = 0; z < SIZE_Z; ++z)
+                for (int x = 0; x < SIZE_X; ++x)
+                    sum += map.GetBlock(x, y, z);
+    });
+    DoNotOptimize(sum);
+    Report("GetBlock sequential", seconds, voxels);
+
+    const VoxelChunk* chunk = map.GetChunk(Int3(0, 1, 0));
+    seconds                 = Measure([&] {
+        for (int repeat = 0; repeat < 256; ++repeat)
+            for (int i = 0; i < CHUNK_VOLUME; ++i)
+                sum += chunk->Get(i);
+    });
+    DoNotOptimize(sum);
+    Report("VoxelChunk::Get in-chunk", seconds, 256.0 * CHUNK_VOLUME);
+
+    std::mt19937                       rng(42);
+    std::uniform_int_distribution<int> dx(0, SIZE_X - 1), dy(0, SIZE_Y - 1), dz(0, SIZE_Z - 1);
+    std::vector<int>                   coords(3 * 4'000'000);
+    for (std::size_t i = 0; i < coords.size(); i += 3)
+    {
+        coords[i]     = dx(rng);
+        coords[i + 1] = dy(rng);
+        coords[i + 2] = dz(rng);
+    }
+    seconds = Measure([&] {
+        for (std::size_t i = 0; i < coords.size(); i += 3)
+            sum += map.GetBlock(coords[i], coords[i + 1], coords[i + 2]);
+    });
+    DoNotOptimize(sum);
+    Report("GetBlock random", seconds, coords.size() / 3.0);
+
+    seconds = Measure([&] {
+        for (std::size_t i = 0; i < coords.size(); i += 3)
+            map.SetBlock(coords[i], coords[i + 1], coords[i + 2], static_cast<BlockKind>(1 + (i & 3)));
+    });
+    Report("SetBlock random", seconds, coords.size() / 3.0);
+
+    // Importing a dense 10M voxel scene: per-voxel virtual calls versus one batched box write.
+    const Int3             sceneSize(256, 160, 256);
+    std::vector<BlockKind> scene(static_cast<std::size_t>(sceneSize.X) * sceneSize.Y * sceneSize.Z);
+    for (std::size_t i = 0; i < scene.size(); ++i)
+        scene[i] = static_cast<BlockKind>(1 + (i / 4096) % 6);
+
+    ChunkedVoxelMap imported(255, 256, 256, 256);
+    IVoxelMap&      importedBase = imported;
+    seconds                      = Measure([&] {
+        std::size_t i = 0;
+        for (int y = 0; y < sceneSize.Y; ++y)
+            for (int z = 0; z < sceneSize.Z; ++z)
+                for (int x = 0; x < sceneSize.X; ++x, ++i)
+                    if (!importedBase.OutOfBounds(x, y, z))
+                        importedBase.AddBlockFromMagicVoxel(x, y, z, scene[i]);
+    });
+    Report("Import per-voxel AddBlockFromMagicVoxel", seconds, static_cast<double>(scene.size()));
+
+    ChunkedVoxelMap batched(255, 256, 256, 256);
+    IVoxelMap&      batchedBase = batched;
+    seconds                     = Measure([&] { batchedBase.AddBlockBox(Int3(0, 0, 0), sceneSize, scene); });
+    Report("Import AddBlockBox", seconds, static_cast<double>(scene.size()));
+
+    seconds = Measure([&] { batchedBase.FillBlocks(Int3(3, 5, 7), Int3(200, 100, 200), 9); });
+    Report("FillBlocks 200x100x200", seconds, 200.0 * 100.0 * 200.0);
+
+    // Snapshots for jobs: copy-on-write copies of every chunk, then the first write to each,
+    // which clones the chunk the snapshot still shares.
+    std::vector<Int3> chunkPositions;
+    map.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk&) { chunkPositions.push_back(chunkPos); });
+    std::vector<std::shared_ptr<const VoxelChunk>> snapshots;
+    snapshots.reserve(chunkPositions.size());
+    seconds = Measure([&] {
+        for (const Int3& chunkPos : chunkPositions)
+            snapshots.push_back(map.Snapshot(chunkPos));
+    });
+    Report("Snapshot chunk", seconds, static_cast<double>(chunkPositions.size()), "chunk");
+
+    seconds = Measure([&] {
+        for (const Int3& chunkPos : chunkPositions)
+        {
+            VoxelChunk* chunk = map.GetChunk(chunkPos);
+            chunk->Set(1, 2, 3, chunk->Get(1, 2, 3));
+        }
+    });
+    Report("First write after a snapshot", seconds, static_cast<double>(chunkPositions.size()), "chunk");
+    snapshots.clear();
+
+    map.Compact();
+    const double flatBytes = voxels * sizeof(BlockKind);
+    std::printf("chunks: %zu, palette bytes: %.1f MB, flat 16-bit bytes: %.1f MB, ratio: %.2fx\n",
+                map.ChunkCount(),
+                map.MemoryUsage() / 1048576.0,
+                flatBytes / 1048576.0,
+                flatBytes / static_cast<double>(map.MemoryUsage()));
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Voxel/ColumnHeightmap.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int WORLD_SIZE   = 2048;
+    constexpr int WORLD_HEIGHT = 256;
+    constexpr int EDITS        = 100000;
+    constexpr int QUERIES      = 100000;
+} // namespace
+
+int main()
+{
+    ChunkedVoxelMap map(255, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    for (int z = 0; z < WORLD_SIZE; ++z)
+        for (int x = 0; x < WORLD_SIZE; ++x)
+        {
+            const int height = 60 + static_cast<int>(18.0 * std::sin(x / 71.0) * std::cos(z / 53.0) + 6.0 * std::sin((x + 2 * z) / 17.0));
+            map.FillBlocks(Int3(x, 0, z), Int3(1, height - 1, 1), 1);
+            map.SetBlock(x, height - 1, z, 2);
+        }
+    std::printf("    %zu chunks\n", map.ChunkCount());
+
+    ColumnHeightmap heightmap(map);
+    Report("Rebuild", Measure([&] { heightmap.Rebuild(); }), static_cast<double>(WORLD_SIZE) * WORLD_SIZE, "column");
+    std::printf("    %.1f MB\n", heightmap.MemoryUsage() / 1048576.0);
+
+    std::mt19937                       rng(17);
+    std::uniform_int_distribution<int> position(0, WORLD_SIZE - 1);
+    std::vector<Int3>                  columns;
+    for (int i = 0; i < EDITS; ++i)
+        columns.emplace_back(position(rng), 0, position(rng));
+
+    // Building on top of the surface and digging the top block away again.
+    Report("Place and remove the top block", Measure([&] {
+               for (const Int3& column : columns)
+               {
+                   const int top = heightmap.Height(HeightmapType::NonAir, column.X, column.Z) + 1;
+                   map.SetBlock(column.X, top, column.Z, 3);
+                   heightmap.OnBlockChanged(column.X, top, column.Z);
+                   map.SetBlock(column.X, top, column.Z, AIR_KIND);
+                   heightmap.OnBlockChanged(column.X, top, column.Z);
+               }
+           }),
+           2.0 * EDITS, "edit");
+
+    int sum = 0;
+    Report("Height query", Measure([&] {
+               for (int i = 0; i < QUERIES; ++i)
+                   sum += heightmap.Height(HeightmapType::Opaque, columns[i].X, columns[i].Z);
+           }),
+           QUERIES, "query");
+    Report("Scan down with GetBlock", Measure([&] {
+               for (int i = 0; i < QUERIES; ++i)
+                   for (int y = WORLD_HEIGHT - 1; y >= 0; --y)
+                       if (map.GetBlock(columns[i].X, y, columns[i].Z) != AIR_KIND)
+                       {
+                           sum += y;
+                           break;
+                       }
+           }),
+           QUERIES, "query");
+    DoNotOptimize(sum);
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Voxel/ChunkedVoxelMap.h"
+#include "Voxel/ConcurrentChunkMap.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int READERS = 8;
+    constexpr int LOOKUPS = 1 << 20;
+
+    // A 64 x 8 x 64 chunk world, looked up at random positions of a slightly larger box, so
+    // about a third of the lookups miss, as they do at the edge of the loaded area.
+    constexpr int WORLD_X = 64;
+    constexpr int WORLD_Y = 8;
+    constexpr int WORLD_Z = 64;
+
+    struct Workload
+    {
+        Workload() : Chunks(static_cast<std::size_t>(WORLD_X) * WORLD_Y * WORLD_Z)
+        {
+            for (int z = 0; z < WORLD_Z; ++z)
+                for (int y = 0; y < WORLD_Y; ++y)
+                    for (int x = 0; x < WORLD_X; ++x)
+                        Keys.emplace_back(x - WORLD_X / 2, y, z - WORLD_Z / 2);
+
+            std::mt19937                       rng(11);
+            std::uniform_int_distribution<int> px(-WORLD_X / 2 - 4, WORLD_X / 2 + 3);
+            std::uniform_int_distribution<int> py(-1, WORLD_Y);
+            std::uniform_int_distribution<int> pz(-WORLD_Z / 2 - 4, WORLD_Z / 2 + 3);
+            for (int t = 0; t < READERS; ++t)
+            {
+                Lookups.emplace_back();
+                for (int i = 0; i < LOOKUPS; ++i)
+                    Lookups.back().emplace_back(px(rng), py(rng), pz(rng));
+            }
+        }
+
+        std::vector<Int3>              Keys;
+        std::vector<VoxelChunk>        Chunks;
+        std::vector<std::vector<Int3>> Lookups;
+    };
+
+    // Runs find over every reader's lookups on its own thread, optionally with a writer erasing
+    // and reinserting chunks the whole time, and reports the aggregate lookup rate.
+    template<typename Find, typename Churn>
+    void Run(const char* name, const Workload& work, int readers, Find&& find, Churn&& churn)
+    {
+        std::atomic<bool>        stop {false};
+        std::atomic<std::size_t> found {0};
+        std::thread              writer;
+        if constexpr (!std::is_same_v<std::decay_t<Churn>, std::nullptr_t>)
+        {
+            writer = std::thread([&] {
+                for (std::size_t i = 0; !stop.load(std::memory_order_relaxed); i = (i + 1) % work.Keys.size())
+                    churn(i);
+            });
+        }
+
+        const double seconds = Measure([&] {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < readers; ++t)
+            {
+                threads.emplace_back([&, t] {
+                    std::size_t hits = 0;
+                    for (const Int3& key : work.Lookups[t])
+                        hits += find(key) != nullptr;
+                    found.fetch_add(hits, std::memory_order_relaxed);
+                });
+            }
+            for (std::thread& thread : threads)
+                thread.join();
+        });
+
+        stop = true;
+        if (writer.joinable())
+            writer.join();
+        DoNotOptimize(found.load());
+        Report(name, seconds, static_cast<double>(readers) * LOOKUPS, "lookup");
+    }
+} // namespace
+
+int main()
+{
+    Workload work;
+
+    std::unordered_map<Int3, VoxelChunk*, Int3Hasher> unordered;
+    std::shared_mutex                                  unorderedMutex;
+    ConcurrentChunkMap<VoxelChunk>                     concurrent;
+    for (std::size_t i = 0; i < work.Keys.size(); ++i)
+    {
+        unordered.emplace(work.Keys[i], &work.Chunks[i]);
+        concurrent.Insert(work.Keys[i], &work.Chunks[i]);
+    }
+
+    auto findUnordered = [&](const Int3& key) -> VoxelChunk* {
+        auto it = unordered.find(key);
+        return it != unordered.end() ? it->second : nullptr;
+    };
+    auto findLocked = [&](const Int3& key) {
+        std::shared_lock<std::shared_mutex> lock(unorderedMutex);
+        return findUnordered(key);
+    };
+    auto findConcurrent = [&](const Int3& key) { return concurrent.Find(key); };
+
+    auto churnLocked = [&](std::size_t i) {
+        std::unique_lock<std::shared_mutex> lock(unorderedMutex);
+        unordered.erase(work.Keys[i]);
+        unordered.emplace(work.Keys[i], &work.Chunks[i]);
+    };
+    auto churnConcurrent = [&](std::size_t i) {
+        concurrent.Erase(work.Keys[i]);
+        concurrent.Insert(work.Keys[i], &work.Chunks[i]);
+    };
+
+    Run("unordered_map, 1 reader", work, 1, findUnordered, nullptr);
+    Run("ConcurrentChunkMap, 1 reader", work, 1, findConcurrent, nullptr);
+
+    // Without a lock unordered_map is only safe while nothing writes; it is the upper bound.
+    Run("unordered_map, 8 readers, no writer, no lock", work, READERS, findUnordered, nullptr);
+    Run("unordered_map + shared_mutex, 8 readers", work, READERS, findLocked, nullptr);
+    Run("ConcurrentChunkMap, 8 readers", work, READERS, findConcurrent, nullptr);
+
+    Run("unordered_map + shared_mutex, 8 readers + writer", work, READERS, findLocked, churnLocked);
+    Run("ConcurrentChunkMap, 8 readers + writer", work, READERS, findConcurrent, churnConcurrent);
+
+    std::printf("    %zu chunks; ConcurrentChunkMap capacity %zu, %.1f KB retired\n",
+                work.Keys.size(),
+                concurrent.Capacity(),
+                concurrent.RetiredBytes() / 1024.0);
+    return 0;
+}
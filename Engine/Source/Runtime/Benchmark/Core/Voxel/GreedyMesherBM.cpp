@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Test/TestTerrain.h"
+#include "Voxel/GreedyMesher.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr int REPEAT  = 200;
+    constexpr int BATCHES = 10;
+
+    // Surface chunk: grass over dirt over stone with some ore, cut by a height field.
+    template<typename HeightFunc>
+    VoxelChunk TerrainChunk(HeightFunc heightAt)
+    {
+        VoxelChunk chunk;
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                {
+                    const int height = heightAt(x, z);
+                    BlockKind kind   = AIR_KIND;
+                    if (y == height)
+                        kind = 3;
+                    else if (y < height && y > height - 4)
+                        kind = 2;
+                    else if (y <= height - 4)
+                        kind = ((x ^ y ^ z) & 31) == 0 ? 4 : 1;
+                    chunk.Set(x, y, z, kind);
+                }
+        return chunk;
+    }
+
+    // Worst case: every other voxel solid, no face can be merged or culled.
+    VoxelChunk CheckerChunk()
+    {
+        VoxelChunk chunk;
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    chunk.Set(x, y, z, ((x ^ y ^ z) & 1) ? 1 : AIR_KIND);
+        return chunk;
+    }
+
+    // Scattered noise with many kinds, like a cave wall full of ores.
+    VoxelChunk NoiseChunk()
+    {
+        std::mt19937                       rng(42);
+        std::uniform_int_distribution<int> kind(0, 15);
+        VoxelChunk                         chunk;
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+            chunk.Set(i, static_cast<BlockKind>(kind(rng) < 6 ? AIR_KIND : kind(rng)));
+        return chunk;
+    }
+
+    void Run(const char* name, const VoxelChunk& chunk, const ChunkNeighbourhood& around)
+    {
+        GreedyMesher       mesher;
+        ChunkMesh          mesh;
+        ChunkNeighbourhood neighbourhood                      = around;
+        neighbourhood.Chunks[ChunkNeighbourhood::CENTER_SLOT] = &chunk;
+
+        mesher.Mesh(neighbourhood, mesh); // Warm the scratch buffers.
+
+        // Best of several batches, so a descheduled batch does not skew the per-chunk time.
+        double best = 0.0;
+        for (int batch = 0; batch < BATCHES; ++batch)
+        {
+            const double seconds = Measure([&] {
+                for (int i = 0; i < REPEAT; ++i)
+                {
+                    mesher.Mesh(neighbourhood, mesh);
+                    DoNotOptimize(mesh.VertexCount);
+                }
+            });
+            best = batch == 0 ? seconds : std::min(best, seconds);
+        }
+        Report(name, best, REPEAT, "chunk");
+        std::printf("    %u quads, %.1f us/chunk\n", mesh.QuadCount, best * 1e6 / REPEAT);
+    }
+} // namespace
+
+int main()
+{
+    // Rolling hills are the common case; the rough field changes height every column.
+    const VoxelChunk terrain = TerrainChunk([](int x, int z) { return RollingGround {16, 5.0, 7.0, 4.0, 9.0}.Height(x, z); });
+    const VoxelChunk rough   = TerrainChunk([](int x, int z) { return 12 + ((x * 7 + z * 13) % 9) + (x / 8); });
+    const VoxelChunk checker = CheckerChunk();
+    const VoxelChunk noise   = NoiseChunk();
+    const VoxelChunk stone(1);
+
+    // Sky light fading with depth and one torch, roughly what light propagation leaves behind.
+    ChunkLight light;
+    for (int y = 0; y < CHUNK_SIZE; ++y)
+        for (int z = 0; z < CHUNK_SIZE; ++z)
+            for (int x = 0; x < CHUNK_SIZE; ++x)
+            {
+                const int torch = 14 - std::abs(x - 16) - std::abs(y - 20) - std::abs(z - 16);
+                light.Set(ChunkIndex(x, y, z), static_cast<uint8_t>(std::clamp(y - 8, 0, 15)), static_cast<uint8_t>(std::max(torch, 0)));
+            }
+
+    ChunkNeighbourhood open {};
+    ChunkNeighbourhood buried {};
+    buried.Chunks.fill(&stone);
+    ChunkNeighbourhood surface {};
+    surface.Chunks.fill(&terrain);
+    ChunkNeighbourhood lit = surface;
+    lit.Lights.fill(&light);
+
+    Run("Mesh terrain chunk, terrain neighbours", terrain, surface);
+    Run("Mesh terrain chunk, terrain neighbours, lit", terrain, lit);
+    Run("Mesh terrain chunk, no neighbours", terrain, open);
+    Run("Mesh rough terrain chunk, terrain neighbours", rough, surface);
+    Run("Mesh noise chunk (16 kinds)", noise, open);
+    Run("Mesh checkerboard chunk", checker, open);
+    Run("Mesh stone chunk, buried", stone, buried);
+    return 0;
+}
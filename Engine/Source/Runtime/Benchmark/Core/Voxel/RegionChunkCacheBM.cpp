@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+#include "Allocator/Allocator.h"
+#include "Benchmark/BenchmarkCommon.h"
+#include "Test/TestTerrain.h"
+#include "Voxel/RegionChunkCache.h"
+#include "Voxel/RegionStore.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr int WORLD_X = 1024;
+    constexpr int WORLD_Y = 128;
+    constexpr int WORLD_Z = 1024;
+    constexpr int RADIUS  = 6;
+
+    // Rolling terrain with ore speckles, the same world RegionFileBM saves.
+    void BuildTerrain(ChunkedVoxelMap& map)
+    {
+        std::mt19937                       rng(3);
+        std::uniform_int_distribution<int> ore(0, 63);
+        std::vector<BlockKind>             column(WORLD_Y);
+        const RollingGround                ground {64, 10.0, 29.0, 8.0, 37.0};
+        for (int z = 0; z < WORLD_Z; ++z)
+            for (int x = 0; x < WORLD_X; ++x)
+            {
+                const int height = ground.Height(x, z);
+                for (int y = 0; y < WORLD_Y; ++y)
+                    column[y] = y > height ? AIR_KIND : y == height ? 3 : y > height - 4 ? 2 : ore(rng) == 0 ? 4 + ore(rng) % 4 : 1;
+                map.AddBlockBox(Int3(x, 0, z), Int3(1, WORLD_Y, 1), column);
+            }
+    }
+
+    // A viewer walking diagonally across the world, touching every chunk column within RADIUS each step.
+    std::size_t Walk(RegionChunkCache& cache)
+    {
+        std::size_t lookups = 0;
+        for (int step = RADIUS; step < WORLD_X / CHUNK_SIZE - RADIUS; ++step)
+            for (int dz = -RADIUS; dz <= RADIUS; ++dz)
+                for (int dx = -RADIUS; dx <= RADIUS; ++dx)
+                    for (int y = 0; y < WORLD_Y / CHUNK_SIZE; ++y)
+                    {
+                        DoNotOptimize(cache.GetChunk(Int3(step + dx, y, step + dz)));
+                        ++lookups;
+                    }
+        return lookups;
+    }
+} // namespace
+
+int main()
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "RegionChunkCacheBM";
+    std::filesystem::remove_all(directory);
+
+    std::size_t worldBytes = 0;
+    {
+        ChunkedVoxelMap map(255, WORLD_X, WORLD_Y, WORLD_Z);
+        BuildTerrain(map);
+        worldBytes = map.MemoryUsage();
+        RegionStore(directory).SaveMap(map);
+    }
+
+    {
+        ChunkedVoxelMap loaded(255, WORLD_X, WORLD_Y, WORLD_Z);
+        RegionStore     store(directory);
+        Report("Eager load of every chunk", Measure([&] { store.LoadMap(loaded); }), 1);
+    }
+    Report("Mapped open and first chunk", Measure([&] {
+               RegionChunkCache cache(directory, worldBytes / 4);
+               DoNotOptimize(cache.GetChunk(Int3(16, 1, 16)));
+           }),
+           1);
+
+    // A quarter of the world holds the walk's view with room to spare; a 64th is smaller than the view and thrashes.
+    for (const std::size_t capacity : {worldBytes / 4, worldBytes / 64})
+    {
+        RegionChunkCache cache(directory, capacity);
+        std::size_t      lookups = 0;
+        const double     seconds = Measure([&] { lookups = Walk(cache); });
+        char             name[64];
+        std::snprintf(name, sizeof(name), "Walk, %.1f MB cache", capacity / 1048576.0);
+        Report(name, seconds, static_cast<double>(lookups), "lookup");
+
+        const RegionChunkCacheStats stats = cache.Stats();
+        std::printf("    %.1f%% hits, %zu chunks resident (%.1f MB), %.0f ms decompressing\n", stats.HitRate() * 100.0, stats.ResidentChunks,
+                    stats.ResidentBytes / 1048576.0, stats.DecompressSeconds * 1e3);
+    }
+
+    std::printf("%s\n", MemoryString().c_str());
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Test/TestTerrain.h"
+#include "Voxel/RegionStore.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr int WORLD_X = 1024;
+    constexpr int WORLD_Y = 128;
+    constexpr int WORLD_Z = 1024;
+    constexpr int READS   = 2000;
+
+    // Rolling terrain with ore speckles, so chunks are a mix of uniform, few-kind and noisy.
+    void BuildTerrain(ChunkedVoxelMap& map)
+    {
+        std::mt19937                       rng(3);
+        std::uniform_int_distribution<int> ore(0, 63);
+        std::vector<BlockKind>             column(WORLD_Y);
+        const RollingGround                ground {64, 10.0, 29.0, 8.0, 37.0};
+        for (int z = 0; z < WORLD_Z; ++z)
+            for (int x = 0; x < WORLD_X; ++x)
+            {
+                const int height = ground.Height(x, z);
+                for (int y = 0; y < WORLD_Y; ++y)
+                    column[y] = y > height ? AIR_KIND : y == height ? 3 : y > height - 4 ? 2 : ore(rng) == 0 ? 4 + ore(rng) % 4 : 1;
+                map.AddBlockBox(Int3(x, 0, z), Int3(1, WORLD_Y, 1), column);
+            }
+    }
+
+    std::size_t DirectoryBytes(const std::filesystem::path& directory)
+    {
+        std::size_t bytes = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+            bytes += entry.file_size();
+        return bytes;
+    }
+} // namespace
+
+int main()
+{
+    ChunkedVoxelMap map(255, WORLD_X, WORLD_Y, WORLD_Z);
+    BuildTerrain(map);
+    const double chunks = static_cast<double>(map.ChunkCount());
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "RegionFileBM";
+    std::filesystem::remove_all(directory);
+
+    {
+        RegionStore store(directory);
+        Report("Save map, one thread", Measure([&] { store.SaveMap(map); }), chunks, "chunk");
+    }
+    {
+        ThreadPool  pool;
+        RegionStore store(directory);
+        Report("Save map again, thread pool", Measure([&] { store.SaveMap(map, &pool); }), chunks, "chunk");
+    }
+
+    std::printf("    %.0f chunks, %.1f MB in memory, %.1f MB on disk\n", chunks, map.MemoryUsage() / 1048576.0, DirectoryBytes(directory) / 1048576.0);
+
+    {
+        ChunkedVoxelMap loaded(255, WORLD_X, WORLD_Y, WORLD_Z);
+        RegionStore     store(directory);
+        Report("Load map", Measure([&] { store.LoadMap(loaded); }), chunks, "chunk");
+    }
+
+    {
+        // Random single-chunk reads, the access pattern of streaming.
+        RegionStore                        store(directory);
+        std::mt19937                       rng(7);
+        std::uniform_int_distribution<int> cx(0, WORLD_X / CHUNK_SIZE - 1);
+        std::uniform_int_distribution<int> cy(0, WORLD_Y / CHUNK_SIZE - 1);
+        std::uniform_int_distribution<int> cz(0, WORLD_Z / CHUNK_SIZE - 1);
+        VoxelChunk                         chunk;
+        Report("Random chunk reads", Measure([&] {
+                   for (int i = 0; i < READS; ++i)
+                   {
+                       store.LoadChunk(Int3(cx(rng), cy(rng), cz(rng)), chunk);
+                       DoNotOptimize(chunk);
+                   }
+               }),
+               READS, "chunk");
+    }
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
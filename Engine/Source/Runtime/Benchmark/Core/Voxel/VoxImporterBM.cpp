@@ -0,0 +1,145 @@
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkedVoxelMap.h"
+#include "Voxel/VoxImporter.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int MODEL_SIZE  = 126;
+    constexpr int MODEL_COUNT = 48;
+
+    void PutInt(std::vector<uint8_t>& out, int32_t v)
+    {
+        for (int i = 0; i < 4; ++i)
+            out.push_back(static_cast<uint8_t>(static_cast<uint32_t>(v) >> (8 * i)));
+    }
+
+    void PutString(std::vector<uint8_t>& out, const std::string& s)
+    {
+        PutInt(out, static_cast<int32_t>(s.size()));
+        out.insert(out.end(), s.begin(), s.end());
+    }
+
+    void PutChunk(std::vector<uint8_t>& out, const char* id, const std::vector<uint8_t>& content)
+    {
+        out.insert(out.end(), id, id + 4);
+        PutInt(out, static_cast<int32_t>(content.size()));
+        PutInt(out, 0);
+        out.insert(out.end(), content.begin(), content.end());
+    }
+
+    // Multi-model scene: MODEL_COUNT half-filled models laid out on a grid through the scene graph.
+    std::vector<uint8_t> BuildScene(std::size_t& voxelCount)
+    {
+        std::vector<uint8_t> children;
+        for (int m = 0; m < MODEL_COUNT; ++m)
+        {
+            std::vector<uint8_t> size, xyzi, voxels;
+            PutInt(size, MODEL_SIZE);
+            PutInt(size, MODEL_SIZE);
+            PutInt(size, MODEL_SIZE);
+            int count = 0;
+            for (int z = 0; z < MODEL_SIZE / 2; ++z)
+                for (int y = 0; y < MODEL_SIZE; ++y)
+                    for (int x = 0; x < MODEL_SIZE; ++x)
+                    {
+                        voxels.insert(voxels.end(),
+                                      {static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z), static_cast<uint8_t>(1 + (m + z / 8) % 8)});
+                        ++count;
+                    }
+            PutInt(xyzi, count);
+            xyzi.insert(xyzi.end(), voxels.begin(), voxels.end());
+            PutChunk(children, "SIZE", size);
+            PutChunk(children, "XYZI", xyzi);
+            voxelCount += count;
+        }
+
+        std::vector<uint8_t> root, group;
+        PutInt(root, 0);
+        PutInt(root, 0);
+        PutInt(root, 1);
+        PutInt(root, -1);
+        PutInt(root, 0);
+        PutInt(root, 1);
+        PutInt(root, 0);
+        PutChunk(children, "nTRN", root);
+
+        PutInt(group, 1);
+        PutInt(group, 0);
+        PutInt(group, MODEL_COUNT);
+        for (int m = 0; m < MODEL_COUNT; ++m)
+            PutInt(group, 2 + 2 * m);
+        PutChunk(children, "nGRP", group);
+
+        for (int m = 0; m < MODEL_COUNT; ++m)
+        {
+            std::vector<uint8_t> transform, shape;
+            PutInt(transform, 2 + 2 * m);
+            PutInt(transform, 0);
+            PutInt(transform, 3 + 2 * m);
+            PutInt(transform, -1);
+            PutInt(transform, 0);
+            PutInt(transform, 1);
+            PutInt(transform, 1);
+            PutString(transform, "_t");
+            PutString(transform, std::to_string((m % 8) * MODEL_SIZE) + " " + std::to_string((m / 8) * MODEL_SIZE) + " 0");
+            PutChunk(children, "nTRN", transform);
+
+            PutInt(shape, 3 + 2 * m);
+            PutInt(shape, 0);
+            PutInt(shape, 1);
+            PutInt(shape, m);
+            PutInt(shape, 0);
+            PutChunk(children, "nSHP", shape);
+        }
+
+        std::vector<uint8_t> file {'V', 'O', 'X', ' '};
+        PutInt(file, 150);
+        file.insert(file.end(), {'M', 'A', 'I', 'N'});
+        PutInt(file, 0);
+        PutInt(file, static_cast<int32_t>(children.size()));
+        file.insert(file.end(), children.begin(), children.end());
+        return file;
+    }
+} // namespace
+
+int main()
+{
+    std::size_t                 voxelCount = 0;
+    const std::vector<uint8_t>  bytes      = BuildScene(voxelCount);
+    const std::filesystem::path path       = std::filesystem::temp_directory_path() / "VoxImporterBM.vox";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+    std::printf("scene: %.1f MB, %zu voxels\n", bytes.size() / 1048576.0, voxelCount);
+
+    {
+        ChunkedVoxelMap map(255, 8 * MODEL_SIZE, MODEL_SIZE, 6 * MODEL_SIZE);
+        double          seconds = Measure([&] { VoxImporter::Import(path, map); });
+        Report("Import single thread", seconds, static_cast<double>(voxelCount), "voxel");
+    }
+
+    ThreadPool pool;
+    {
+        ChunkedVoxelMap  map(255, 8 * MODEL_SIZE, MODEL_SIZE, 6 * MODEL_SIZE);
+        VoxImportOptions options;
+        options.Pool   = &pool;
+        double seconds = Measure([&] { VoxImporter::Import(path, map, options); });
+        std::printf("workers: %u\n", pool.ThreadCount());
+        Report("Import thread pool", seconds, static_cast<double>(voxelCount), "voxel");
+    }
+
+    std::filesystem::remove(path);
+    return 0;
+}
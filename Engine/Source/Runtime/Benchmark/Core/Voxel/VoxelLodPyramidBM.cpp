@@ -0,0 +1,91 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Voxel/VoxelLodPyramid.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int WORLD_SIZE   = 2048;
+    constexpr int WORLD_HEIGHT = 128;
+    constexpr int RING_RADIUS  = 4;
+
+    struct MeshTotals
+    {
+        uint64_t Vertices = 0;
+        uint64_t Nodes    = 0;
+    };
+} // namespace
+
+int main()
+{
+    // Rolling hills with grass over dirt over stone, 64 chunks across: a view radius of 32 chunks
+    // from the middle at full resolution.
+    ChunkedVoxelMap map(255, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    for (int z = 0; z < WORLD_SIZE; ++z)
+        for (int x = 0; x < WORLD_SIZE; ++x)
+        {
+            const int height = 60 + static_cast<int>(18.0 * std::sin(x / 71.0) * std::cos(z / 53.0) + 6.0 * std::sin((x + 2 * z) / 17.0) +
+                                                      2.0 * std::cos((3 * x - z) / 5.0));
+            map.FillBlocks(Int3(x, 0, z), Int3(1, height - 4, 1), 1);
+            map.FillBlocks(Int3(x, height - 4, z), Int3(1, 3, 1), 2);
+            map.SetBlock(x, height - 1, z, 3);
+        }
+    std::printf("    %zu chunks, %.1f MB\n", map.ChunkCount(), map.MemoryUsage() / 1048576.0);
+
+    VoxelLodPyramid pyramid(map);
+    Report("Build pyramid", Measure([&] { pyramid.Rebuild(); }), static_cast<double>(map.ChunkCount()), "chunk");
+    std::printf("    %zu nodes above level 0, %.1f MB\n", pyramid.NodeCount(), pyramid.MemoryUsage() / 1048576.0);
+
+    map.FillBlocks(Int3(1000, 50, 1000), Int3(3, 3, 3), AIR_KIND);
+    Report("Update after an edit", Measure([&] {
+               pyramid.MarkChunkDirty(ChunkOf(1000, 50, 1000));
+               pyramid.Update();
+           }),
+           1, "edit");
+
+    GreedyMesher mesher;
+    ChunkMesh    mesh;
+    MeshTotals   full;
+    Report("Mesh every chunk at full resolution", Measure([&] {
+               full = {};
+               map.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk&) {
+                   mesher.Mesh(pyramid.Neighbourhood(0, chunkPos), mesh);
+                   full.Vertices += mesh.VertexCount;
+                   ++full.Nodes;
+               });
+           }),
+           static_cast<double>(map.ChunkCount()), "chunk");
+    std::printf("    %llu chunks, %.1f M vertices\n", static_cast<unsigned long long>(full.Nodes), full.Vertices / 1e6);
+
+    const Vector3F       camera(WORLD_SIZE / 2.0f, 80.0f, WORLD_SIZE / 2.0f);
+    std::vector<LodNode> nodes;
+    Report("Select clipmap nodes", Measure([&] { pyramid.SelectNodes(camera, RING_RADIUS, nodes); }), 1, "camera");
+
+    std::vector<MeshTotals> rings(pyramid.Levels() + 1);
+    Report("Mesh clipmap nodes", Measure([&] {
+               rings.assign(rings.size(), MeshTotals {});
+               for (const LodNode& node : nodes)
+               {
+                   mesher.Mesh(pyramid.Neighbourhood(node.Level, node.NodePos), mesh);
+                   rings[node.Level].Vertices += mesh.VertexCount;
+                   ++rings[node.Level].Nodes;
+               }
+           }),
+           static_cast<double>(nodes.size()), "node");
+
+    uint64_t total = 0;
+    for (int level = 0; level < static_cast<int>(rings.size()); ++level)
+    {
+        std::printf("    level %d: %4llu nodes, %.2f M vertices\n", level, static_cast<unsigned long long>(rings[level].Nodes), rings[level].Vertices / 1e6);
+        total += rings[level].Vertices;
+    }
+    std::printf("    clipmap: %.2f M vertices, %.1fx fewer than full resolution\n", total / 1e6, static_cast<double>(full.Vertices) / total);
+    DoNotOptimize(mesh);
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Benchmark/BenchmarkCommon.h"
+#include "Voxel/VoxelRaycaster.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Benchmark;
+
+namespace
+{
+    constexpr int WORLD_SIZE   = 512;
+    constexpr int WORLD_HEIGHT = 128;
+    constexpr int PAIRS        = 1 << 16;
+
+    // One voxel at a time through GetBlock, as a caller without the raycaster would do it.
+    bool PlainLineOfSight(const ChunkedVoxelMap& map, const Vector3F& from, const Vector3F& to)
+    {
+        const Vector3F delta    = to - from;
+        const float    length   = std::sqrt(Vector3F::DotProduct(delta, delta));
+        const float    o[3]     = {from.X, from.Y, from.Z};
+        const float    d[3]     = {delta.X / length, delta.Y / length, delta.Z / length};
+        const int      target[3] = {static_cast<int>(std::floor(to.X)), static_cast<int>(std::floor(to.Y)), static_cast<int>(std::floor(to.Z))};
+
+        int   cell[3], step[3];
+        float next[3], span[3];
+        for (int a = 0; a < 3; ++a)
+        {
+            cell[a] = static_cast<int>(std::floor(o[a]));
+            step[a] = d[a] < 0.0f ? -1 : 1;
+            span[a] = d[a] == 0.0f ? INFINITY : std::abs(1.0f / d[a]);
+            next[a] = d[a] == 0.0f ? INFINITY : ((d[a] > 0.0f ? cell[a] + 1 : cell[a]) - o[a]) / d[a];
+        }
+        for (float t = 0.0f; t <= length;)
+        {
+            if (cell[0] == target[0] && cell[1] == target[1] && cell[2] == target[2])
+                return true;
+            if (!map.OutOfBounds(cell[0], cell[1], cell[2]) && map.GetBlock(cell[0], cell[1], cell[2]) != AIR_KIND)
+                return false;
+            const int axis = next[0] < next[1] ? (next[0] < next[2] ? 0 : 2) : (next[1] < next[2] ? 1 : 2);
+            t              = next[axis];
+            cell[axis] += step[axis];
+            next[axis] += span[axis];
+        }
+        return true;
+    }
+} // namespace
+
+int main()
+{
+    // Hilly terrain with scattered trees: mostly open air above the ground, solid below.
+    ChunkedVoxelMap map(255, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    std::mt19937    rng(9);
+    for (int z = 0; z < WORLD_SIZE; ++z)
+        for (int x = 0; x < WORLD_SIZE; ++x)
+        {
+            const int height = 40 + static_cast<int>(10.0 * std::sin(x / 23.0) + 8.0 * std::cos(z / 17.0) + 3.0 * std::sin((x + z) / 5.0));
+            map.FillBlocks(Int3(x, 0, z), Int3(1, height, 1), 1);
+            if (rng() % 400 == 0)
+                map.FillBlocks(Int3(x, height, z), Int3(1, 6, 1), 2);
+        }
+
+    VoxelRaycaster raycaster(map);
+    Report("Rebuild chunk grid", Measure([&] { raycaster.Rebuild(); }), static_cast<double>(map.ChunkCount()), "chunk");
+    std::printf("    %zu chunks, %.1f KB of chunk grid\n", map.ChunkCount(), raycaster.MemoryUsage() / 1024.0);
+
+    // AI line-of-sight checks: agents standing above the terrain, looking at targets up to 64 voxels away.
+    std::uniform_real_distribution<float> coordinate(64.0f, WORLD_SIZE - 64.0f), height(52.0f, 70.0f), offset(-64.0f, 64.0f);
+    std::vector<Vector3F>                 from, to;
+    for (int i = 0; i < PAIRS; ++i)
+    {
+        from.emplace_back(coordinate(rng), height(rng), coordinate(rng));
+        to.push_back(from.back() + Vector3F(offset(rng), offset(rng) * 0.25f, offset(rng)));
+    }
+    std::vector<uint8_t> visible(PAIRS);
+
+    int seen = 0;
+    Report("Plain DDA through GetBlock", Measure([&] {
+               for (int i = 0; i < PAIRS; ++i)
+                   visible[i] = PlainLineOfSight(map, from[i], to[i]);
+           }),
+           PAIRS, "ray");
+    for (uint8_t v : visible)
+        seen += v;
+
+    Report("VoxelRaycaster::LineOfSight", Measure([&] {
+               for (int i = 0; i < PAIRS; ++i)
+                   visible[i] = raycaster.LineOfSight(from[i], to[i]);
+           }),
+           PAIRS, "ray");
+    Report("VoxelRaycaster::LineOfSightBatch", Measure([&] { raycaster.LineOfSightBatch(from, to, visible); }), PAIRS, "ray");
+    DoNotOptimize(visible);
+    std::printf("    %.1f%% of the pairs can see each other\n", 100.0 * seen / PAIRS);
+
+    // Long camera-style picking rays from above, which cross mostly empty chunks.
+    std::vector<VoxelRay> rays;
+    for (int i = 0; i < PAIRS; ++i)
+        rays.push_back(VoxelRay {Vector3F(coordinate(rng), 120.0f, coordinate(rng)), Vector3F(offset(rng), -64.0f, offset(rng)), 512.0f});
+    std::vector<VoxelRayHit> hits(PAIRS);
+    Report("VoxelRaycaster::Raycast, picking", Measure([&] {
+               for (int i = 0; i < PAIRS; ++i)
+                   hits[i] = raycaster.Raycast(rays[i]);
+           }),
+           PAIRS, "ray");
+    Report("VoxelRaycaster::RaycastBatch, picking", Measure([&] { raycaster.RaycastBatch(rays, hits); }), PAIRS, "ray");
+    DoNotOptimize(hits);
+    return 0;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
@@ -7,8 +9,11 @@
 #include <sstream>
 #include <string>
 #include <cassert>
+#include <new>
 #include <type_traits>
 
+#include "CoreMacros.h"
+
 namespace Voxium::Core {
 
     inline std::size_t gUnsafeMemory{0};
@@ -24,17 +29,27 @@ namespace Voxium::Core {
     inline std::size_t gTextureMinimapMemory{0};
     inline std::size_t gTextureSkyboxMemory{0};
     inline std::size_t gTextureRenderMemory{0};
+    inline std::size_t gChunkCacheMemory{0};
+
+    // Chunk cache traffic is counted on every lookup, so these stay off the allocator mutex.
+    inline std::atomic<std::uint64_t> gChunkCacheHits{0};
+    inline std::atomic<std::uint64_t> gChunkCacheMisses{0};
+    inline std::atomic<std::uint64_t> gChunkCacheDecompressNanoseconds{0};
 
     inline std::mutex gAllocatorMutex;
 
     inline double FormatMemory(std::size_t bytes) {
-        return std::round((bytes / 1024.0 / 1024.0) * 10.0) / 10.0;
+        return std::round((static_cast<double>(bytes) / 1024.0 / 1024.0) * 10.0) / 10.0;
     }
 
     inline std::string MemoryString() {
         std::lock_guard<std::mutex> lock(gAllocatorMutex);
         std::ostringstream oss;
-        oss << "Unsafe: " << FormatMemory(gUnsafeMemory) << " MB\n";
+        const std::uint64_t hits = gChunkCacheHits.load(std::memory_order_relaxed);
+        const std::uint64_t lookups = hits + gChunkCacheMisses.load(std::memory_order_relaxed);
+        const double hitRate = lookups == 0 ? 0.0 : std::round(1000.0 * static_cast<double>(hits) / static_cast<double>(lookups)) / 10.0;
+        const double decompressMs = std::round(static_cast<double>(gChunkCacheDecompressNanoseconds.load(std::memory_order_relaxed)) / 1e5) / 10.0;
+        oss << "Unsafe: " << FormatMemory(gUnsafeMemory) << " MB\n"
             << "Buffer: " << FormatMemory(gBufferMemory) << " MB\n"
             << "Instance: " << FormatMemory(gInstanceMemory) << " MB\n"
             << "Indirect: " << FormatMemory(gIndirectMemory) << " MB\n"
@@ -46,7 +61,8 @@ namespace Voxium::Core {
             << "TextureSVG: " << FormatMemory(gTextureSVGMemory) << " MB\n"
             << "TextureMinimap: " << FormatMemory(gTextureMinimapMemory) << " MB\n"
             << "TextureSkybox: " << FormatMemory(gTextureSkyboxMemory) << " MB\n"
-            << "TextureRender: " << FormatMemory(gTextureRenderMemory) << " MB";
+            << "TextureRender: " << FormatMemory(gTextureRenderMemory) << " MB\n"
+            << "ChunkCache: " << FormatMemory(gChunkCacheMemory) << " MB, " << hitRate << "% hits, " << decompressMs << " ms decompressing";
         return oss.str();
     }
 
@@ -71,15 +87,34 @@ namespace Voxium::Core {
         gUnsafeMemory -= bytes;
     }
 
+    inline void IncrementChunkCacheMemory(std::size_t bytes) {
+        std::lock_guard<std::mutex> lock(gAllocatorMutex);
+        gChunkCacheMemory += bytes;
+    }
+
+    inline void DecrementChunkCacheMemory(std::size_t bytes) {
+        std::lock_guard<std::mutex> lock(gAllocatorMutex);
+        assert(gChunkCacheMemory >= bytes);
+        gChunkCacheMemory -= bytes;
+    }
+
+    inline void RecordChunkCacheLookup(bool hit) {
+        (hit ? gChunkCacheHits : gChunkCacheMisses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void RecordChunkCacheDecompress(std::uint64_t nanoseconds) {
+        gChunkCacheDecompressNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    }
+
     inline void* Alloc(std::size_t byteCount) {
-        DEBUG_CALL(IncrementUnsafeMemory(byteCount));
+        DEBUG_CALL(IncrementUnsafeMemory, byteCount);
         void* ptr = std::malloc(byteCount);
         if (!ptr) throw std::bad_alloc();
         return ptr;
     }
 
     inline void* AllocZeroed(std::size_t byteCount) {
-        DEBUG_CALL(IncrementUnsafeMemory(byteCount));
+        DEBUG_CALL(IncrementUnsafeMemory, byteCount);
         void* ptr = std::calloc(1, byteCount);
         if (!ptr) throw std::bad_alloc();
         return ptr;
@@ -89,7 +124,7 @@ namespace Voxium::Core {
     inline T* AllocSmart(int amount) {
         static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
         std::size_t byteCount = static_cast<std::size_t>(amount) * sizeof(T);
-        DEBUG_CALL(IncrementUnsafeMemory(byteCount));
+        DEBUG_CALL(IncrementUnsafeMemory, byteCount);
         void* ptr = std::malloc(byteCount);
         if (!ptr) throw std::bad_alloc();
         return reinterpret_cast<T*>(ptr);
@@ -99,7 +134,7 @@ namespace Voxium::Core {
     inline T* AllocSmart(int amount, int& byteCount) {
         static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
         byteCount = amount * static_cast<int>(sizeof(T));
-        DEBUG_CALL(IncrementUnsafeMemory(byteCount));
+        DEBUG_CALL(IncrementUnsafeMemory, byteCount);
         void* ptr = std::malloc(byteCount);
         if (!ptr) throw std::bad_alloc();
         return reinterpret_cast<T*>(ptr);
@@ -109,7 +144,7 @@ namespace Voxium::Core {
     inline T* AllocZeroedSmart(int amount) {
         static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
         std::size_t byteCount = static_cast<std::size_t>(amount) * sizeof(T);
-        DEBUG_CALL(IncrementUnsafeMemory(byteCount));
+        DEBUG_CALL(IncrementUnsafeMemory, byteCount);
         void* ptr = std::calloc(1, byteCount);
         if (!ptr) throw std::bad_alloc();
         return reinterpret_cast<T*>(ptr);
@@ -119,7 +154,7 @@ namespace Voxium::Core {
     inline T* AllocZeroedSmart(int amount, int& byteCount) {
         static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
         byteCount = amount * static_cast<int>(sizeof(T));
-        DEBUG_CALL(IncrementUnsafeMemory(byteCount));
+        DEBUG_CALL(IncrementUnsafeMemory, byteCount);
         void* ptr = std::calloc(1, byteCount);
         if (!ptr) throw std::bad_alloc();
         return reinterpret_cast<T*>(ptr);
@@ -128,8 +163,8 @@ namespace Voxium::Core {
     template<typename T>
     inline T* Realloc(T* data, std::size_t byteCount, std::size_t oldLength) {
         if (oldLength > 0)
-            DEBUG_CALL(DecrementUnsafeMemory(oldLength));
-        DEBUG_CALL(IncrementUnsafeMemory(byteCount));
+            DEBUG_CALL(DecrementUnsafeMemory, oldLength);
+        DEBUG_CALL(IncrementUnsafeMemory, byteCount);
         if (data == nullptr) {
             void* ptr = std::malloc(byteCount);
             if (!ptr) throw std::bad_alloc();
@@ -142,8 +177,8 @@ namespace Voxium::Core {
 
     inline void* Realloc(void* data, std::size_t byteCount, std::size_t oldLength) {
         if (oldLength > 0)
-            DEBUG_CALL(DecrementUnsafeMemory(oldLength));
-        DEBUG_CALL(IncrementUnsafeMemory(byteCount));
+            DEBUG_CALL(DecrementUnsafeMemory, oldLength);
+        DEBUG_CALL(IncrementUnsafeMemory, byteCount);
         if (data == nullptr) {
             void* ptr = std::malloc(byteCount);
             if (!ptr) throw std::bad_alloc();
@@ -158,7 +193,7 @@ namespace Voxium::Core {
     inline void FreeSmart(T* data, int amount) {
         if (data != nullptr) {
             int byteCount = amount * static_cast<int>(sizeof(T));
-            DEBUG_CALL(DecrementUnsafeMemory(byteCount));
+            DEBUG_CALL(DecrementUnsafeMemory, byteCount);
             std::free(data);
         } else {
             assert(amount == 0);
@@ -169,8 +204,8 @@ namespace Voxium::Core {
     template<typename T>
     inline void Free2(T* data, int bytes) {
         if (data != nullptr) {
-            DEBUG_CALL(DecrementUnsafeMemory(bytes);
-  )          std::free(data);
+            DEBUG_CALL(DecrementUnsafeMemory, bytes);
+            std::free(data);
         } else {
             assert(bytes == 0);
         }
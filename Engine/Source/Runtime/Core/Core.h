@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Math/Frustum.h"
 #include "Math/Gravity.h"
 #include "Math/Int2.h"
 #include "Math/Int3.h"
@@ -8,6 +9,7 @@
 #include "Math/Matrix3F.h"
 #include "Math/Matrix4.h"
 #include "Math/Matrix4F.h"
+#include "Math/Morton.h"
 #include "Math/MovingAverage.h"
 #include "Math/Rectangle.h"
 #include "Math/RingBuffer.h"
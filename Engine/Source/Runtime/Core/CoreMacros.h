@@ -19,3 +19,27 @@
 #else
 #define DEBUG_CALL(fn, ...) ((void)0)
 #endif
+
+// Instruction sets the compiler may assume. SSE2 is part of every x86-64 target.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOXIUM_SSE2 1
+#endif
+
+#if defined(__BMI2__)
+#define VOXIUM_BMI2 1
+#endif
+
+// AVX2 code paths are compiled into every x86-64 build. Their functions are marked
+// VOXIUM_AVX2_TARGET, which lets them use AVX2, BMI2 and FMA while the rest of the file
+// keeps the baseline, and run only when CpuHasAvx2() (System/CpuFeatures.h) is true.
+#if defined(__x86_64__) || defined(_M_X64)
+#define VOXIUM_AVX2 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VOXIUM_AVX2_TARGET
+#else
+#define VOXIUM_AVX2_TARGET __attribute__((target("avx2,bmi2,fma")))
+#endif
+#endif
+
+// Alignment that keeps data written by different threads on separate cache lines.
+#define VOXIUM_CACHE_LINE 64
@@ -0,0 +1,127 @@
+#include "IO/MappedFile.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32) || defined(_WIN64)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Voxium::Core
+{
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot open file: " + path.string());
+        handle_ = reinterpret_cast<intptr_t>(file);
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            Close();
+            throw std::runtime_error("Cannot query file size: " + path.string());
+        }
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ == 0)
+            return;
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            Close();
+            throw std::runtime_error("Cannot map file: " + path.string());
+        }
+        mapping_ = reinterpret_cast<intptr_t>(mapping);
+
+        data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (data_ == nullptr)
+        {
+            Close();
+            throw std::runtime_error("Cannot map file: " + path.string());
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Cannot open file: " + path.string());
+        handle_ = fd;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            Close();
+            throw std::runtime_error("Cannot query file size: " + path.string());
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ == 0)
+            return;
+
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            Close();
+            throw std::runtime_error("Cannot map file: " + path.string());
+        }
+        data_ = static_cast<const uint8_t*>(data);
+#endif
+    }
+
+    MappedFile::~MappedFile() { Close(); }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            handle_ = std::exchange(other.handle_, INVALID_HANDLE);
+#if defined(_WIN32) || defined(_WIN64)
+            mapping_ = std::exchange(other.mapping_, 0);
+#endif
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    void MappedFile::Close()
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        if (data_ != nullptr)
+            UnmapViewOfFile(data_);
+        if (mapping_ != 0)
+            CloseHandle(reinterpret_cast<HANDLE>(mapping_));
+        if (handle_ != INVALID_HANDLE)
+            CloseHandle(reinterpret_cast<HANDLE>(handle_));
+        mapping_ = 0;
+#else
+        if (data_ != nullptr)
+            ::munmap(const_cast<uint8_t*>(data_), size_);
+        if (handle_ != INVALID_HANDLE)
+            ::close(static_cast<int>(handle_));
+#endif
+        handle_ = INVALID_HANDLE;
+        data_   = nullptr;
+        size_   = 0;
+    }
+
+    void MappedFile::AdviseSequential() const
+    {
+#if !defined(_WIN32) && !defined(_WIN64)
+        if (data_ != nullptr)
+            ::madvise(const_cast<uint8_t*>(data_), size_, MADV_SEQUENTIAL);
+#endif
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "CoreMacros.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // MappedFile: read-only memory mapping of a whole file. Pages are faulted in on
+    // first access, so opening a large file costs the same as opening a small one.
+    //--------------------------------------------------------------------------------
+    class CORE_API MappedFile
+    {
+    public:
+        MappedFile() = default;
+
+        // Throws std::runtime_error if the file cannot be opened or mapped.
+        explicit MappedFile(const std::filesystem::path& path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        void Close();
+
+        // Hints the OS that the mapping will be read front to back.
+        void AdviseSequential() const;
+
+        bool IsOpen() const { return handle_ != INVALID_HANDLE; }
+
+        const uint8_t* Data() const { return data_; }
+
+        std::size_t Size() const { return size_; }
+
+        std::span<const uint8_t> Bytes() const { return {data_, size_}; }
+
+    private:
+        // File descriptor on POSIX, file HANDLE on Windows.
+        static constexpr intptr_t INVALID_HANDLE = -1;
+
+        intptr_t handle_ = INVALID_HANDLE;
+#if defined(_WIN32) || defined(_WIN64)
+        intptr_t mapping_ = 0;
+#endif
+        const uint8_t* data_ = nullptr;
+        std::size_t    size_ = 0;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,295 @@
+#include "Navigation/GridPathfinder.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr float DIAGONAL_COST = 1.41421356f;
+
+        constexpr int DIRECTIONS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+        constexpr int Sign(int value) { return (value > 0) - (value < 0); }
+
+        bool IsFree(const NavigationGrid& grid, int x, int y, int z)
+        {
+            const Int3 cell(x, y, z);
+            return grid.Contains(cell) && grid.IsWalkable(cell);
+        }
+    } // namespace
+
+    void GridPathfinder::Reset(const NavigationGrid& grid)
+    {
+        if (nodes_.size() < static_cast<std::size_t>(grid.CellCount()))
+            nodes_.resize(static_cast<std::size_t>(grid.CellCount()), Node {0.0f, -1, 0, false});
+        if (++generation_ == 0)
+        {
+            for (Node& node : nodes_)
+                node.Generation = 0;
+            generation_ = 1;
+        }
+        open_.clear();
+    }
+
+    GridPathfinder::Node& GridPathfinder::Visit(int index)
+    {
+        Node& node = nodes_[static_cast<std::size_t>(index)];
+        if (node.Generation != generation_)
+            node = Node {NO_PATH, -1, generation_, false};
+        return node;
+    }
+
+    void GridPathfinder::Push(int index, float g, float f)
+    {
+        open_.push_back(OpenEntry {f, g, index});
+        std::push_heap(open_.begin(), open_.end(), [](const OpenEntry& a, const OpenEntry& b) { return a.F > b.F || (a.F == b.F && a.G < b.G); });
+    }
+
+    GridPathfinder::OpenEntry GridPathfinder::Pop()
+    {
+        std::pop_heap(open_.begin(), open_.end(), [](const OpenEntry& a, const OpenEntry& b) { return a.F > b.F || (a.F == b.F && a.G < b.G); });
+        const OpenEntry entry = open_.back();
+        open_.pop_back();
+        return entry;
+    }
+
+    bool GridPathfinder::FindPath(const NavigationGrid& grid, const Int3& start, const Int3& goal, GridSearch search, GridPath& path, uint32_t maxExpanded)
+    {
+        path.Cells.clear();
+        path.Cost     = 0.0f;
+        path.Expanded = 0;
+        if (!IsFree(grid, start.X, start.Y, start.Z) || !IsFree(grid, goal.X, goal.Y, goal.Z))
+            return false;
+
+        Reset(grid);
+        const NavigationSettings& settings  = grid.Settings();
+        const int                 goalIndex = grid.Index(goal);
+        const int                 first     = grid.Index(start);
+
+        Visit(first).G = 0.0f;
+        Push(first, 0.0f, settings.EstimateCost(start, goal));
+
+        NavigationGrid::Moves moves;
+        while (!open_.empty())
+        {
+            const OpenEntry entry = Pop();
+            Node&           node  = nodes_[static_cast<std::size_t>(entry.Index)];
+            if (node.Closed || entry.G > node.G)
+                continue;
+            node.Closed = true;
+
+            if (entry.Index == goalIndex)
+            {
+                // Parents are jump points; fill in the straight and diagonal runs between them.
+                for (int index = goalIndex; index >= 0; index = nodes_[static_cast<std::size_t>(index)].Parent)
+                    path.Cells.push_back(grid.CellAt(index));
+                std::reverse(path.Cells.begin(), path.Cells.end());
+                std::vector<Int3> jumps;
+                jumps.swap(path.Cells);
+                path.Cells.push_back(jumps.front());
+                for (std::size_t i = 1; i < jumps.size(); ++i)
+                {
+                    const int dx = Sign(jumps[i].X - jumps[i - 1].X);
+                    const int dz = Sign(jumps[i].Z - jumps[i - 1].Z);
+                    for (Int3 cell = jumps[i - 1]; !(cell == jumps[i]);)
+                    {
+                        cell = cell.Y == jumps[i].Y ? Int3(cell.X + dx, cell.Y, cell.Z + dz) : jumps[i];
+                        path.Cells.push_back(cell);
+                    }
+                }
+                path.Cost = entry.G;
+                return true;
+            }
+            if (path.Expanded++ == maxExpanded)
+                return false;
+
+            const Int3 cell = grid.CellAt(entry.Index);
+            if (search == GridSearch::JumpPoint)
+            {
+                JumpSuccessors(grid, cell, node.Parent >= 0 ? grid.CellAt(node.Parent) : cell, goal);
+            }
+            else
+            {
+                successors_.clear();
+                const std::size_t count = grid.MovesFrom(cell, moves);
+                for (std::size_t i = 0; i < count; ++i)
+                    if (grid.Contains(moves[i].Cell))
+                        successors_.push_back(moves[i]);
+            }
+
+            for (const NavigationMove& move : successors_)
+            {
+                const int   index = grid.Index(move.Cell);
+                Node&       next  = Visit(index);
+                const float g     = entry.G + move.Cost;
+                if (next.Closed || g >= next.G)
+                    continue;
+                next.G      = g;
+                next.Parent = entry.Index;
+                Push(index, g, g + settings.EstimateCost(move.Cell, goal));
+            }
+        }
+        return false;
+    }
+
+    uint32_t GridPathfinder::Costs(const NavigationGrid& grid, const Int3& source, bool reverse, std::span<const Int3> targets, std::span<float> costs)
+    {
+        std::fill(costs.begin(), costs.end(), NO_PATH);
+        if (!IsFree(grid, source.X, source.Y, source.Z))
+            return 0;
+
+        std::size_t remaining = 0;
+        for (const Int3& target : targets)
+            remaining += IsFree(grid, target.X, target.Y, target.Z);
+
+        Reset(grid);
+        const int first = grid.Index(source);
+
+        Visit(first).G = 0.0f;
+        Push(first, 0.0f, 0.0f);
+
+        uint32_t              expanded = 0;
+        NavigationGrid::Moves moves;
+        while (!open_.empty() && remaining > 0)
+        {
+            const OpenEntry entry = Pop();
+            Node&           node  = nodes_[static_cast<std::size_t>(entry.Index)];
+            if (node.Closed || entry.G > node.G)
+                continue;
+            node.Closed = true;
+            ++expanded;
+
+            const Int3 cell = grid.CellAt(entry.Index);
+            for (std::size_t i = 0; i < targets.size(); ++i)
+                if (targets[i] == cell)
+                {
+                    costs[i] = entry.G;
+                    --remaining;
+                }
+
+            const std::size_t count = reverse ? grid.MovesInto(cell, moves) : grid.MovesFrom(cell, moves);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (!grid.Contains(moves[i].Cell))
+                    continue;
+                const int   index = grid.Index(moves[i].Cell);
+                Node&       next  = Visit(index);
+                const float g     = entry.G + moves[i].Cost;
+                if (next.Closed || g >= next.G)
+                    continue;
+                next.G      = g;
+                next.Parent = entry.Index;
+                Push(index, g, g);
+            }
+        }
+        return expanded;
+    }
+
+    void GridPathfinder::JumpSuccessors(const NavigationGrid& grid, const Int3& cell, const Int3& parent, const Int3& goal)
+    {
+        successors_.clear();
+        const int x = cell.X;
+        const int y = cell.Y;
+        const int z = cell.Z;
+
+        // Only the directions no equally cheap path avoiding this cell covers: straight on, and
+        // around obstacles beside the cell behind. Starts and cells entered by a climb or drop look
+        // everywhere.
+        int directions[8][2];
+        int count = 0;
+        if (parent == cell || parent.Y != y)
+        {
+            for (const auto& direction : DIRECTIONS)
+            {
+                directions[count][0]   = direction[0];
+                directions[count++][1] = direction[1];
+            }
+        }
+        else
+        {
+            const int dx = Sign(x - parent.X);
+            const int dz = Sign(z - parent.Z);
+            auto      add = [&](int ddx, int ddz) {
+                directions[count][0]   = ddx;
+                directions[count++][1] = ddz;
+            };
+            if (dx != 0 && dz != 0)
+            {
+                add(dx, 0);
+                add(0, dz);
+                add(dx, dz);
+            }
+            else if (dx != 0)
+            {
+                add(dx, 0);
+                for (const int side : {1, -1})
+                    if (IsFree(grid, x, y, z + side) && !IsFree(grid, x - dx, y, z + side))
+                    {
+                        add(0, side);
+                        add(dx, side);
+                    }
+            }
+            else
+            {
+                add(0, dz);
+                for (const int side : {1, -1})
+                    if (IsFree(grid, x + side, y, z) && !IsFree(grid, x + side, y, z - dz))
+                    {
+                        add(side, 0);
+                        add(side, dz);
+                    }
+            }
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            Int3 found(0, 0, 0);
+            if (!Jump(grid, cell, directions[i][0], directions[i][1], goal, found))
+                continue;
+            const float step = directions[i][0] != 0 && directions[i][1] != 0 ? DIAGONAL_COST : 1.0f;
+            successors_.push_back(NavigationMove {found, step * static_cast<float>(std::max(std::abs(found.X - x), std::abs(found.Z - z)))});
+        }
+
+        NavigationGrid::Moves moves;
+        const std::size_t     moveCount = grid.MovesFrom(cell, moves);
+        for (std::size_t i = 0; i < moveCount; ++i)
+            if (moves[i].Cell.Y != y && grid.Contains(moves[i].Cell))
+                successors_.push_back(moves[i]);
+    }
+
+    bool GridPathfinder::Jump(const NavigationGrid& grid, Int3 cell, int dx, int dz, const Int3& goal, Int3& found) const
+    {
+        const int y = cell.Y;
+        while (true)
+        {
+            const int x = cell.X + dx;
+            const int z = cell.Z + dz;
+            if (!IsFree(grid, x, y, z) || (dx != 0 && dz != 0 && (!IsFree(grid, x, y, cell.Z) || !IsFree(grid, cell.X, y, z))))
+                return false;
+            cell = Int3(x, y, z);
+
+            bool jumpPoint = cell == goal || grid.ChangesLevel(cell);
+            if (!jumpPoint && dx != 0 && dz != 0)
+            {
+                Int3 ignored(0, 0, 0);
+                jumpPoint = Jump(grid, cell, dx, 0, goal, ignored) || Jump(grid, cell, 0, dz, goal, ignored);
+            }
+            else if (!jumpPoint && dx != 0)
+            {
+                jumpPoint = (IsFree(grid, x, y, z + 1) && !IsFree(grid, x - dx, y, z + 1)) || (IsFree(grid, x, y, z - 1) && !IsFree(grid, x - dx, y, z - 1));
+            }
+            else if (!jumpPoint)
+            {
+                jumpPoint = (IsFree(grid, x + 1, y, z) && !IsFree(grid, x + 1, y, z - dz)) || (IsFree(grid, x - 1, y, z) && !IsFree(grid, x - 1, y, z - dz));
+            }
+            if (jumpPoint)
+            {
+                found = cell;
+                return true;
+            }
+        }
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Navigation/NavigationGrid.h"
+
+namespace Voxium::Core
+{
+    enum class GridSearch : uint8_t
+    {
+        AStar,
+        JumpPoint // fewer expansions on open flat ground, but slower than A* where the ground often changes level
+    };
+
+    struct GridPath
+    {
+        std::vector<Int3> Cells; // start to goal, every cell on the way
+        float             Cost     = 0.0f;
+        uint32_t          Expanded = 0;
+    };
+
+    //--------------------------------------------------------------------------------
+    // GridPathfinder: cheapest paths between walkable cells of a NavigationGrid's box,
+    // by A* or by jump point search. Jump point search prunes the cells of flat ground
+    // that some other equally cheap path also reaches, and jumps in straight and diagonal
+    // lines from one forced turn to the next, so open ground costs a few expansions
+    // rather than one per cell; cells where the ground climbs or drops stop every jump
+    // and are expanded in full, so both searches find the same cost. Node state is kept
+    // between searches and reset by generation, so reuse one pathfinder per thread.
+    //--------------------------------------------------------------------------------
+    class CORE_API GridPathfinder
+    {
+    public:
+        static constexpr float NO_PATH = std::numeric_limits<float>::infinity();
+
+        // Fills path and returns true if the goal is reachable without expanding more than
+        // maxExpanded cells. Both ends must be walkable cells of the box.
+        bool FindPath(const NavigationGrid& grid, const Int3& start, const Int3& goal, GridSearch search, GridPath& path,
+                      uint32_t maxExpanded = UINT32_MAX);
+
+        // Cheapest cost from source to every target of the box, or from every target to source
+        // when reverse, NO_PATH where there is none; searches until all targets are settled.
+        // Returns the cells expanded.
+        uint32_t Costs(const NavigationGrid& grid, const Int3& source, bool reverse, std::span<const Int3> targets, std::span<float> costs);
+
+    private:
+        struct Node
+        {
+            float    G;
+            int32_t  Parent;
+            uint32_t Generation;
+            bool     Closed;
+        };
+
+        struct OpenEntry
+        {
+            float   F;
+            float   G;
+            int32_t Index;
+        };
+
+        // Starts a search over the grid's box: every node becomes unvisited.
+        void Reset(const NavigationGrid& grid);
+
+        Node& Visit(int index);
+
+        void Push(int index, float g, float f);
+
+        OpenEntry Pop();
+
+        // Cells reached from a jump point of jump point search, appended to successors_.
+        void JumpSuccessors(const NavigationGrid& grid, const Int3& cell, const Int3& parent, const Int3& goal);
+
+        // Walks from cell in the flat direction (dx, dz) to the next jump point, if any.
+        bool Jump(const NavigationGrid& grid, Int3 cell, int dx, int dz, const Int3& goal, Int3& found) const;
+
+        std::vector<Node>           nodes_;
+        std::vector<OpenEntry>      open_;
+        std::vector<NavigationMove> successors_;
+        uint32_t                    generation_ = 0;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,470 @@
+#include "Navigation/NavigationGraph.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        // Runs of more touching cells than this get an entrance at both ends instead of one in the middle.
+        constexpr std::size_t LONG_ENTRANCE = 12;
+
+        // Cell order of a chunk, y slowest, like ChunkIndex().
+        bool CellBefore(const Int3& a, const Int3& b)
+        {
+            if (a.Y != b.Y)
+                return a.Y < b.Y;
+            if (a.Z != b.Z)
+                return a.Z < b.Z;
+            return a.X < b.X;
+        }
+
+        bool Touching(const Int3& a, const Int3& b) { return std::abs(a.X - b.X) <= 1 && std::abs(a.Y - b.Y) <= 1 && std::abs(a.Z - b.Z) <= 1; }
+
+        Int3 ChunkOfCell(const Int3& cell) { return ChunkOf(cell.X, cell.Y, cell.Z); }
+
+        Int3 ChunkMax(const Int3& chunkPos) { return ChunkBoundsMin(chunkPos) + Int3(CHUNK_MASK, CHUNK_MASK, CHUNK_MASK); }
+
+        struct SearchState
+        {
+            Int3  Cell;
+            int   Cluster; // index into the query's clusters
+            int   Entrance;
+            float G;
+            int   Parent;
+            bool  Closed;
+        };
+
+        struct OpenEntry
+        {
+            float F;
+            int   State;
+        };
+
+        // Per-thread buffers, so queries and builds on pool threads reuse their grids and searches.
+        struct Scratch
+        {
+            NavigationGrid                            Grid;
+            Int3                                      GridChunk = Int3::Invalid;
+            GridPathfinder                            Pathfinder;
+            GridPath                                  Segment;
+            std::vector<float>                        StartCosts;
+            std::vector<float>                        GoalCosts;
+            std::vector<Int3>                         Targets;
+            std::vector<SearchState>                  States;
+            std::vector<OpenEntry>                    Open;
+            std::unordered_map<Int3, int, Int3Hasher> StateOf;
+
+            void BuildGrid(const WalkableSurface& surface, const Int3& chunkPos)
+            {
+                Grid.Build(surface, ChunkBoundsMin(chunkPos), ChunkMax(chunkPos));
+                GridChunk = chunkPos;
+            }
+        };
+
+        Scratch& LocalScratch()
+        {
+            thread_local Scratch scratch;
+            return scratch;
+        }
+
+        void ForEach(ThreadPool* pool, std::size_t count, const std::function<void(std::size_t)>& func)
+        {
+            if (pool != nullptr && count > 1)
+                pool->ParallelFor(count, func);
+            else
+                for (std::size_t i = 0; i < count; ++i)
+                    func(i);
+        }
+    } // namespace
+
+    NavigationGraph::NavigationGraph(const ChunkedVoxelMap& map, const NavigationSettings& settings, GridSearch refineSearch) :
+        surface_(map, settings), refineSearch_(refineSearch)
+    {
+    }
+
+    void NavigationGraph::Rebuild() { RebuildAll(nullptr); }
+
+    void NavigationGraph::Rebuild(ThreadPool& pool) { RebuildAll(&pool); }
+
+    void NavigationGraph::RebuildAll(ThreadPool* pool)
+    {
+        surface_.Rebuild();
+        transitions_.clear();
+        clusters_.clear();
+        dirty_.clear();
+        surface_.ForEachCandidateChunk([&](const Int3& chunkPos) { dirty_.insert(chunkPos); });
+        Refresh(pool);
+    }
+
+    void NavigationGraph::OnBlockChanged(int x, int y, int z)
+    {
+        // A cell depends on the voxels from AgentHeight above it (room to climb) down to MaxDrop + 1
+        // below it (ground to drop onto), in its own and the neighbouring columns.
+        surface_.OnBlockChanged(x, y, z);
+        const NavigationSettings& settings = surface_.Settings();
+        MarkDirty(Int3(x - 1, y - settings.AgentHeight, z - 1), Int3(x + 1, y + settings.MaxDrop + 1, z + 1));
+    }
+
+    void NavigationGraph::OnChunkChanged(const Int3& chunkPos)
+    {
+        surface_.OnChunkChanged(chunkPos);
+        const NavigationSettings& settings = surface_.Settings();
+        MarkDirty(ChunkBoundsMin(chunkPos) - Int3(1, settings.AgentHeight, 1), ChunkMax(chunkPos) + Int3(1, settings.MaxDrop + 1, 1));
+    }
+
+    void NavigationGraph::MarkDirty(const Int3& min, const Int3& max)
+    {
+        const ChunkedVoxelMap& map   = surface_.Map();
+        const Int3             first = ChunkOf(std::max(min.X, 0), std::max(min.Y, 0), std::max(min.Z, 0));
+        const Int3             last  = ChunkOf(std::min(max.X, map.SizeX() - 1), std::min(max.Y, map.SizeY() - 1), std::min(max.Z, map.SizeZ() - 1));
+        for (int cy = first.Y; cy <= last.Y; ++cy)
+            for (int cz = first.Z; cz <= last.Z; ++cz)
+                for (int cx = first.X; cx <= last.X; ++cx)
+                    dirty_.insert(Int3(cx, cy, cz));
+    }
+
+    std::size_t NavigationGraph::Update() { return Refresh(nullptr); }
+
+    std::size_t NavigationGraph::Update(ThreadPool& pool) { return Refresh(&pool); }
+
+    std::size_t NavigationGraph::Refresh(ThreadPool* pool)
+    {
+        if (dirty_.empty())
+            return 0;
+        std::vector<Int3> dirty(dirty_.begin(), dirty_.end());
+        std::sort(dirty.begin(), dirty.end(), CellBefore);
+        dirty_.clear();
+
+        // Entrance moves out of the touched chunks.
+        std::vector<std::vector<Transition>> transitions(dirty.size());
+        ForEach(pool, dirty.size(), [&](std::size_t i) { FindTransitions(dirty[i], transitions[i]); });
+        for (std::size_t i = 0; i < dirty.size(); ++i)
+        {
+            if (transitions[i].empty())
+                transitions_.erase(dirty[i]);
+            else
+                transitions_[dirty[i]] = std::move(transitions[i]);
+        }
+
+        // Entrances of a chunk are the cells its transitions leave from and the ones its neighbours'
+        // transitions enter, so those of the neighbours may have changed too.
+        std::unordered_set<Int3, Int3Hasher> touched(dirty.begin(), dirty.end());
+        std::vector<Int3>                    affected;
+        for (const Int3& chunkPos : dirty)
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dz = -1; dz <= 1; ++dz)
+                    for (int dx = -1; dx <= 1; ++dx)
+                        affected.push_back(chunkPos + Int3(dx, dy, dz));
+        std::sort(affected.begin(), affected.end(), CellBefore);
+        affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+
+        std::vector<Int3>              rebuilt;
+        std::vector<std::vector<Int3>> entrances;
+        for (const Int3& chunkPos : affected)
+        {
+            std::vector<Int3> cells;
+            if (const auto own = transitions_.find(chunkPos); own != transitions_.end())
+                for (const Transition& transition : own->second)
+                    cells.push_back(transition.From);
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dz = -1; dz <= 1; ++dz)
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        const auto neighbour = transitions_.find(chunkPos + Int3(dx, dy, dz));
+                        if ((dx | dy | dz) == 0 || neighbour == transitions_.end())
+                            continue;
+                        for (const Transition& transition : neighbour->second)
+                            if (ChunkOfCell(transition.To) == chunkPos)
+                                cells.push_back(transition.To);
+                    }
+            std::sort(cells.begin(), cells.end(), CellBefore);
+            cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+            const auto cluster = clusters_.find(chunkPos);
+            if (cells.empty())
+            {
+                if (cluster != clusters_.end())
+                    clusters_.erase(cluster);
+                continue;
+            }
+            if (!touched.contains(chunkPos) && cluster != clusters_.end() && cluster->second.Entrances == cells)
+                continue;
+            rebuilt.push_back(chunkPos);
+            entrances.push_back(std::move(cells));
+        }
+
+        // Costs between the entrances, the expensive part.
+        std::vector<Cluster> clusters(rebuilt.size());
+        ForEach(pool, rebuilt.size(), [&](std::size_t i) { BuildCluster(rebuilt[i], std::move(entrances[i]), clusters[i]); });
+        for (std::size_t i = 0; i < rebuilt.size(); ++i)
+            clusters_[rebuilt[i]] = std::move(clusters[i]);
+        return rebuilt.size();
+    }
+
+    void NavigationGraph::FindTransitions(const Int3& chunkPos, std::vector<Transition>& transitions) const
+    {
+        transitions.clear();
+        WalkableSurface::ColumnMasks walkable;
+        if (surface_.ExtractWalkable(chunkPos, walkable) == 0)
+            return;
+
+        Scratch& scratch = LocalScratch();
+        scratch.BuildGrid(surface_, chunkPos);
+
+        // Inside the chunk only cells near its top and bottom can climb or drop out of it.
+        const int               drop     = surface_.Settings().MaxDrop;
+        const uint32_t          vertical = ((1u << drop) - 1) | 1u << CHUNK_MASK;
+        const Int3              origin   = ChunkBoundsMin(chunkPos);
+        std::vector<Transition> moves;
+        NavigationGrid::Moves   cellMoves;
+        for (int column = 0; column < CHUNK_AREA; ++column)
+        {
+            const int  x    = column & CHUNK_MASK;
+            const int  z    = column >> CHUNK_SHIFT;
+            const bool side = x == 0 || z == 0 || x == CHUNK_MASK || z == CHUNK_MASK;
+            for (uint32_t bits = walkable[static_cast<std::size_t>(column)] & (side ? ~0u : vertical); bits != 0; bits &= bits - 1)
+            {
+                const Int3        cell  = origin + Int3(x, std::countr_zero(bits), z);
+                const std::size_t count = scratch.Grid.MovesFrom(cell, cellMoves);
+                for (std::size_t i = 0; i < count; ++i)
+                    if (!scratch.Grid.Contains(cellMoves[i].Cell))
+                        moves.push_back(Transition {cell, cellMoves[i].Cell, cellMoves[i].Cost});
+            }
+        }
+
+        // Runs of touching cells entering the same chunk share their entrances.
+        auto target = [](const Transition& transition) { return ChunkOfCell(transition.To); };
+        std::sort(moves.begin(), moves.end(), [&](const Transition& a, const Transition& b) {
+            const Int3 chunkA = target(a);
+            const Int3 chunkB = target(b);
+            return !(chunkA == chunkB) ? CellBefore(chunkA, chunkB) : CellBefore(a.From, b.From);
+        });
+
+        std::vector<int> run(moves.size());
+        for (std::size_t begin = 0; begin < moves.size();)
+        {
+            std::size_t end = begin + 1;
+            while (end < moves.size() && target(moves[end]) == target(moves[begin]))
+                ++end;
+
+            // Labels the runs by flooding over touching cells.
+            std::fill(run.begin() + static_cast<std::ptrdiff_t>(begin), run.begin() + static_cast<std::ptrdiff_t>(end), -1);
+            std::vector<std::size_t> stack;
+            for (std::size_t seed = begin; seed < end; ++seed)
+            {
+                if (run[seed] >= 0)
+                    continue;
+                std::vector<std::size_t> members;
+                run[seed] = static_cast<int>(seed);
+                stack.push_back(seed);
+                while (!stack.empty())
+                {
+                    const std::size_t current = stack.back();
+                    stack.pop_back();
+                    members.push_back(current);
+                    for (std::size_t other = begin; other < end; ++other)
+                        if (run[other] < 0 && Touching(moves[current].From, moves[other].From))
+                        {
+                            run[other] = static_cast<int>(seed);
+                            stack.push_back(other);
+                        }
+                }
+                std::sort(members.begin(), members.end());
+                if (members.size() > LONG_ENTRANCE)
+                {
+                    transitions.push_back(moves[members.front()]);
+                    transitions.push_back(moves[members.back()]);
+                }
+                else
+                {
+                    transitions.push_back(moves[members[members.size() / 2]]);
+                }
+            }
+            begin = end;
+        }
+    }
+
+    void NavigationGraph::BuildCluster(const Int3& chunkPos, std::vector<Int3> entrances, Cluster& cluster) const
+    {
+        Scratch& scratch = LocalScratch();
+        scratch.BuildGrid(surface_, chunkPos);
+
+        const std::size_t count = entrances.size();
+        cluster.Entrances       = std::move(entrances);
+        cluster.Costs.assign(count * count, GridPathfinder::NO_PATH);
+        for (std::size_t i = 0; i < count; ++i)
+            scratch.Pathfinder.Costs(scratch.Grid, cluster.Entrances[i], false, cluster.Entrances,
+                                     std::span<float>(cluster.Costs).subspan(i * count, count));
+
+        cluster.Exits.clear();
+        if (const auto own = transitions_.find(chunkPos); own != transitions_.end())
+            for (const Transition& transition : own->second)
+            {
+                const auto entrance = std::lower_bound(cluster.Entrances.begin(), cluster.Entrances.end(), transition.From, CellBefore);
+                cluster.Exits.push_back(Exit {static_cast<int>(entrance - cluster.Entrances.begin()), transition.To, transition.Cost});
+            }
+    }
+
+    const NavigationGraph::Cluster* NavigationGraph::FindCluster(const Int3& chunkPos) const
+    {
+        const auto it = clusters_.find(chunkPos);
+        return it != clusters_.end() ? &it->second : nullptr;
+    }
+
+    std::size_t NavigationGraph::EntranceCount() const
+    {
+        std::size_t count = 0;
+        for (const auto& [chunkPos, cluster] : clusters_)
+            count += cluster.Entrances.size();
+        return count;
+    }
+
+    bool NavigationGraph::FindPath(const Int3& start, const Int3& goal, NavigationPath& path, uint32_t maxExpanded) const
+    {
+        path.Cells.clear();
+        path.Cost     = 0.0f;
+        path.Expanded = 0;
+        if (!surface_.IsWalkable(start) || !surface_.IsWalkable(goal))
+            return false;
+
+        Scratch&                  scratch      = LocalScratch();
+        const NavigationSettings& settings     = surface_.Settings();
+        const Int3                startChunk   = ChunkOfCell(start);
+        const Int3                goalChunk    = ChunkOfCell(goal);
+        const bool                sameChunk    = startChunk == goalChunk;
+        const Cluster*            startCluster = FindCluster(startChunk);
+        const Cluster*            goalCluster  = FindCluster(goalChunk);
+
+        // Costs from the start to the entrances of its chunk, and to the goal if it is in the same one.
+        scratch.Targets.clear();
+        if (startCluster != nullptr)
+            scratch.Targets = startCluster->Entrances;
+        if (sameChunk)
+            scratch.Targets.push_back(goal);
+        scratch.StartCosts.resize(scratch.Targets.size());
+        scratch.BuildGrid(surface_, startChunk);
+        path.Expanded += scratch.Pathfinder.Costs(scratch.Grid, start, false, scratch.Targets, scratch.StartCosts);
+        float best = sameChunk ? scratch.StartCosts.back() : GridPathfinder::NO_PATH;
+
+        // And from the entrances of the goal's chunk to the goal.
+        scratch.GoalCosts.clear();
+        if (goalCluster != nullptr)
+        {
+            scratch.GoalCosts.resize(goalCluster->Entrances.size());
+            scratch.BuildGrid(surface_, goalChunk);
+            path.Expanded += scratch.Pathfinder.Costs(scratch.Grid, goal, true, goalCluster->Entrances, scratch.GoalCosts);
+        }
+
+        // A* over the entrances, until nothing left open can beat the best way to the goal found so far.
+        std::vector<SearchState>&                  states  = scratch.States;
+        std::vector<OpenEntry>&                    open    = scratch.Open;
+        std::unordered_map<Int3, int, Int3Hasher>& stateOf = scratch.StateOf;
+        std::vector<const Cluster*>                clusters;
+        states.clear();
+        open.clear();
+        stateOf.clear();
+        auto later = [](const OpenEntry& a, const OpenEntry& b) { return a.F > b.F; };
+        auto relax = [&](const Int3& cell, const Cluster* cluster, int entrance, float g, int parent) {
+            auto [it, inserted] = stateOf.try_emplace(cell, static_cast<int>(states.size()));
+            if (inserted)
+            {
+                const auto known = std::find(clusters.begin(), clusters.end(), cluster);
+                const int  index = static_cast<int>(known - clusters.begin());
+                if (known == clusters.end())
+                    clusters.push_back(cluster);
+                states.push_back(SearchState {cell, index, entrance, GridPathfinder::NO_PATH, -1, false});
+            }
+            SearchState& state = states[static_cast<std::size_t>(it->second)];
+            if (state.Closed || g >= state.G)
+                return;
+            state.G      = g;
+            state.Parent = parent;
+            open.push_back(OpenEntry {g + settings.EstimateCost(cell, goal), it->second});
+            std::push_heap(open.begin(), open.end(), later);
+        };
+
+        if (startCluster != nullptr)
+            for (std::size_t i = 0; i < startCluster->Entrances.size(); ++i)
+                if (scratch.StartCosts[i] != GridPathfinder::NO_PATH)
+                    relax(startCluster->Entrances[i], startCluster, static_cast<int>(i), scratch.StartCosts[i], -1);
+
+        int last = -1; // the state before the goal, -1 when going straight to it
+        while (!open.empty())
+        {
+            std::pop_heap(open.begin(), open.end(), later);
+            const OpenEntry entry = open.back();
+            open.pop_back();
+            if (entry.F >= best)
+                break;
+            SearchState& state = states[static_cast<std::size_t>(entry.State)];
+            if (state.Closed)
+                continue;
+            state.Closed = true;
+            if (path.Expanded++ >= maxExpanded)
+                return false;
+
+            const Cluster*    cluster  = clusters[static_cast<std::size_t>(state.Cluster)];
+            const int         entrance = state.Entrance;
+            const float       g        = state.G;
+            const std::size_t count    = cluster->Entrances.size();
+            if (cluster == goalCluster && g + scratch.GoalCosts[static_cast<std::size_t>(entrance)] < best)
+            {
+                best = g + scratch.GoalCosts[static_cast<std::size_t>(entrance)];
+                last = entry.State;
+            }
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                const float cost = cluster->Costs[static_cast<std::size_t>(entrance) * count + j];
+                if (cost != GridPathfinder::NO_PATH && static_cast<int>(j) != entrance)
+                    relax(cluster->Entrances[j], cluster, static_cast<int>(j), g + cost, entry.State);
+            }
+            for (const Exit& exit : cluster->Exits)
+            {
+                if (exit.Entrance != entrance)
+                    continue;
+                const Cluster* next = FindCluster(ChunkOfCell(exit.To));
+                if (next == nullptr)
+                    continue;
+                const auto found = std::lower_bound(next->Entrances.begin(), next->Entrances.end(), exit.To, CellBefore);
+                if (found != next->Entrances.end() && *found == exit.To)
+                    relax(exit.To, next, static_cast<int>(found - next->Entrances.begin()), g + exit.Cost, entry.State);
+            }
+        }
+        if (best == GridPathfinder::NO_PATH)
+            return false;
+
+        // Entrances on the way, then every step between them: a transition between chunks, or a
+        // jump point search inside one.
+        std::vector<Int3> waypoints;
+        waypoints.push_back(goal);
+        for (int index = last; index >= 0; index = states[static_cast<std::size_t>(index)].Parent)
+            waypoints.push_back(states[static_cast<std::size_t>(index)].Cell);
+        waypoints.push_back(start);
+        std::reverse(waypoints.begin(), waypoints.end());
+
+        path.Cells.push_back(start);
+        for (std::size_t i = 1; i < waypoints.size(); ++i)
+        {
+            const Int3& from  = waypoints[i - 1];
+            const Int3& to    = waypoints[i];
+            const Int3  chunk = ChunkOfCell(from);
+            if (!(chunk == ChunkOfCell(to)))
+            {
+                path.Cells.push_back(to);
+                continue;
+            }
+            if (!(scratch.GridChunk == chunk))
+                scratch.BuildGrid(surface_, chunk);
+            if (!scratch.Pathfinder.FindPath(scratch.Grid, from, to, refineSearch_, scratch.Segment))
+                return false;
+            path.Expanded += scratch.Segment.Expanded;
+            path.Cells.insert(path.Cells.end(), scratch.Segment.Cells.begin() + 1, scratch.Segment.Cells.end());
+        }
+        path.Cost = best;
+        return true;
+    }
+
+} // namespace Voxium::Core
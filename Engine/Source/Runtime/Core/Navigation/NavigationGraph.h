@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Navigation/GridPathfinder.h"
+#include "Navigation/WalkableSurface.h"
+#include "Thread/ThreadPool.h"
+
+namespace Voxium::Core
+{
+    struct NavigationPath
+    {
+        std::vector<Int3> Cells; // start to goal, every cell on the way
+        float             Cost     = 0.0f;
+        uint32_t          Expanded = 0; // entrances and cells expanded
+    };
+
+    //--------------------------------------------------------------------------------
+    // NavigationGraph: hierarchical pathfinding (HPA*) over a WalkableSurface, with a
+    // cluster per chunk. The moves out of a chunk are grouped by the chunk they enter
+    // into runs of touching cells; every run gets an entrance at its middle, or at both
+    // ends when it is long, and each chunk keeps the cost between every pair of its
+    // entrances. FindPath() links the start and the goal to the entrances of their
+    // chunks, runs A* over the entrances alone, and refines each step inside a chunk
+    // with the grid search given at construction, so a query expands a few entrances per
+    // chunk crossed instead of every cell. Paths are close to the cheapest, not always
+    // the cheapest. Refining with A* is the default; jump point search only pays off on
+    // mostly flat ground, since every change of level stops its jumps.
+    //
+    // Edits are reported with OnBlockChanged() or OnChunkChanged() on the graph, never
+    // on Surface() directly, followed by Update() before the next queries. Edits mark
+    // the chunks whose moves they can change; Update() finds the entrances of those
+    // again and recomputes the costs of the chunks whose entrances changed, and nothing
+    // else. FindPath() may run on several threads at once, but not during edits or
+    // Update(), which belong to the thread that edits the map.
+    //--------------------------------------------------------------------------------
+    class CORE_API NavigationGraph
+    {
+    public:
+        explicit NavigationGraph(const ChunkedVoxelMap& map, const NavigationSettings& settings = {}, GridSearch refineSearch = GridSearch::AStar);
+
+        NavigationGraph(const NavigationGraph&)            = delete;
+        NavigationGraph& operator=(const NavigationGraph&) = delete;
+
+        // For SetKindBlocking(); Rebuild() after changing kinds that are already in the map.
+        WalkableSurface& Surface() { return surface_; }
+
+        const WalkableSurface& Surface() const { return surface_; }
+
+        // Scans the whole map and builds every chunk.
+        void Rebuild();
+
+        void Rebuild(ThreadPool& pool);
+
+        // Updates the surface and marks the chunks holding cells that can stand on, climb past or
+        // drop onto the voxel. Throws std::out_of_range outside the map.
+        void OnBlockChanged(int x, int y, int z);
+
+        // Rescans the chunk's surface and marks it and the neighbours its moves reach, after it was
+        // streamed in, generated, filled or unloaded.
+        void OnChunkChanged(const Int3& chunkPos);
+
+        // Rebuilds the chunks touched since the last call and returns how many costs were recomputed.
+        std::size_t Update();
+
+        std::size_t Update(ThreadPool& pool);
+
+        // Chunks waiting for Update().
+        std::size_t PendingCount() const { return dirty_.size(); }
+
+        // Fills path and returns true if the goal can be reached from the start, both walkable
+        // cells, without expanding more than maxExpanded entrances and cells.
+        bool FindPath(const Int3& start, const Int3& goal, NavigationPath& path, uint32_t maxExpanded = UINT32_MAX) const;
+
+        std::size_t ClusterCount() const { return clusters_.size(); }
+
+        std::size_t EntranceCount() const;
+
+    private:
+        // A move from a cell of a chunk into another chunk.
+        struct Transition
+        {
+            Int3  From;
+            Int3  To;
+            float Cost;
+        };
+
+        struct Exit
+        {
+            int   Entrance; // the entrance it starts from
+            Int3  To;
+            float Cost;
+        };
+
+        struct Cluster
+        {
+            std::vector<Int3>  Entrances; // cells of the chunk
+            std::vector<float> Costs;     // from entrance i to entrance j at i * count + j, NO_PATH where none
+            std::vector<Exit>  Exits;
+        };
+
+        // Marks the chunks holding cells whose moves depend on voxels of the box.
+        void MarkDirty(const Int3& min, const Int3& max);
+
+        void RebuildAll(ThreadPool* pool);
+
+        std::size_t Refresh(ThreadPool* pool);
+
+        // The entrance moves out of a chunk.
+        void FindTransitions(const Int3& chunkPos, std::vector<Transition>& transitions) const;
+
+        void BuildCluster(const Int3& chunkPos, std::vector<Int3> entrances, Cluster& cluster) const;
+
+        const Cluster* FindCluster(const Int3& chunkPos) const;
+
+        WalkableSurface                                               surface_;
+        GridSearch                                                    refineSearch_;
+        std::unordered_map<Int3, std::vector<Transition>, Int3Hasher> transitions_; // entrance moves out of each chunk
+        std::unordered_map<Int3, Cluster, Int3Hasher>                 clusters_;
+        std::unordered_set<Int3, Int3Hasher>                          dirty_;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,171 @@
+#include "Navigation/NavigationGrid.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr float DIAGONAL_COST = 1.41421356f;
+
+        constexpr int SIDES[4][2]     = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        constexpr int DIAGONALS[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+        // ORs 32 bits of a chunk column into a column's words, offset bits above its base.
+        void OrBits(uint64_t* words, int offset, uint32_t bits)
+        {
+            if (offset < 0)
+            {
+                if (offset <= -CHUNK_SIZE)
+                    return;
+                bits >>= -offset;
+                offset = 0;
+            }
+            const int shift = offset & 63;
+            words[offset >> 6] |= static_cast<uint64_t>(bits) << shift;
+            if (shift > 64 - CHUNK_SIZE)
+                words[(offset >> 6) + 1] |= static_cast<uint64_t>(bits) >> (64 - shift);
+        }
+    } // namespace
+
+    void NavigationGrid::Build(const WalkableSurface& surface, const Int3& min, const Int3& max)
+    {
+        settings_  = surface.Settings();
+        min_       = min;
+        max_       = max;
+        sizeX_     = max.X - min.X + 1;
+        sizeY_     = max.Y - min.Y + 1;
+        sizeZ_     = max.Z - min.Z + 1;
+        columnsX_  = sizeX_ + 2;
+        mapHeight_ = surface.Map().SizeY();
+        roomMask_  = ((1ull << settings_.AgentHeight) - 1) << 1;
+
+        // Drops and the cells that drop into the box reach MaxDrop + 1 below it; climbs and room
+        // for the agent reach MaxDrop + AgentHeight above it. One spare word lets Bits() read two.
+        const int topY  = max.Y + settings_.MaxDrop + settings_.AgentHeight;
+        baseY_          = min.Y - settings_.MaxDrop - 2;
+        wordsPerColumn_ = (topY - baseY_ + 64) / 64 + 1;
+        words_.assign(static_cast<std::size_t>(columnsX_ * (sizeZ_ + 2) * wordsPerColumn_), 0);
+
+        // Below the map blocks, and so does everything beside it.
+        const ChunkedVoxelMap& map = surface.Map();
+        for (int z = min.Z - 1; z <= max.Z + 1; ++z)
+            for (int x = min.X - 1; x <= max.X + 1; ++x)
+            {
+                uint64_t* words = &words_[static_cast<std::size_t>(((z - min.Z + 1) * columnsX_ + x - min.X + 1) * wordsPerColumn_)];
+                if (x < 0 || z < 0 || x >= map.SizeX() || z >= map.SizeZ())
+                    std::fill(words, words + wordsPerColumn_, ~0ull);
+                else
+                    for (int y = baseY_; y < std::min(0, topY + 1); ++y)
+                        words[(y - baseY_) >> 6] |= 1ull << ((y - baseY_) & 63);
+            }
+
+        const Int3 firstChunk = ChunkOf(min.X - 1, std::max(baseY_, 0), min.Z - 1);
+        const Int3 lastChunk  = ChunkOf(max.X + 1, std::max(topY, 0), max.Z + 1);
+        for (int cy = firstChunk.Y; cy <= lastChunk.Y; ++cy)
+            for (int cz = firstChunk.Z; cz <= lastChunk.Z; ++cz)
+                for (int cx = firstChunk.X; cx <= lastChunk.X; ++cx)
+                {
+                    const WalkableSurface::ColumnMasks* masks = surface.Masks(Int3(cx, cy, cz));
+                    if (masks == nullptr)
+                        continue;
+                    const int offset = (cy << CHUNK_SHIFT) - baseY_;
+                    const int fromX  = std::max(cx << CHUNK_SHIFT, min.X - 1);
+                    const int toX    = std::min((cx << CHUNK_SHIFT) + CHUNK_MASK, max.X + 1);
+                    const int fromZ  = std::max(cz << CHUNK_SHIFT, min.Z - 1);
+                    const int toZ    = std::min((cz << CHUNK_SHIFT) + CHUNK_MASK, max.Z + 1);
+                    for (int z = fromZ; z <= toZ; ++z)
+                        for (int x = fromX; x <= toX; ++x)
+                            OrBits(&words_[static_cast<std::size_t>(((z - min.Z + 1) * columnsX_ + x - min.X + 1) * wordsPerColumn_)], offset,
+                                   (*masks)[static_cast<std::size_t>((x & CHUNK_MASK) | (z & CHUNK_MASK) << CHUNK_SHIFT)]);
+                }
+    }
+
+    bool NavigationGrid::SideMove(const Int3& cell, int dx, int dz, NavigationMove& move) const
+    {
+        const int      x      = cell.X + dx;
+        const int      z      = cell.Z + dz;
+        const int      drop   = settings_.MaxDrop;
+        const uint64_t room   = (1ull << settings_.AgentHeight) - 1;
+        const uint64_t bits   = Bits(x, cell.Y - drop - 1, z); // bit drop + 1 is the voxel at the cell's height
+        const uint64_t body   = bits >> (drop + 1);
+        const bool     ground = (bits >> drop & 1) != 0;
+
+        if ((body & room) == 0)
+        {
+            if (ground)
+            {
+                move = {Int3(x, cell.Y, z), 1.0f};
+                return true;
+            }
+            // Falls to the first blocking voxel below, unless it is too deep.
+            const uint64_t below = bits & ((1ull << drop) - 1);
+            if (below == 0)
+                return false;
+            const int highest = 63 - std::countl_zero(below);
+            move              = {Int3(x, cell.Y - drop + highest, z), 1.0f + settings_.DropCost * static_cast<float>(drop - highest)};
+            return true;
+        }
+
+        // Climbs a single voxel, if there is room above both columns.
+        if ((body & 1) == 0 || (body >> 1 & room) != 0 || (Bits(cell.X, cell.Y + settings_.AgentHeight, cell.Z) & 1) != 0 || cell.Y + 1 >= mapHeight_)
+            return false;
+        move = {Int3(x, cell.Y + 1, z), 1.0f + settings_.ClimbCost};
+        return true;
+    }
+
+    std::size_t NavigationGrid::MovesFrom(const Int3& cell, Moves& moves) const
+    {
+        std::size_t count = 0;
+        for (const auto& side : SIDES)
+            count += SideMove(cell, side[0], side[1], moves[count]);
+        for (const auto& diagonal : DIAGONALS)
+        {
+            const int x = cell.X + diagonal[0];
+            const int z = cell.Z + diagonal[1];
+            if (IsWalkable(x, cell.Y, z) && IsWalkable(x, cell.Y, cell.Z) && IsWalkable(cell.X, cell.Y, z))
+                moves[count++] = {Int3(x, cell.Y, z), DIAGONAL_COST};
+        }
+        return count;
+    }
+
+    std::size_t NavigationGrid::MovesInto(const Int3& cell, Moves& moves) const
+    {
+        // Drops need the cell's column free from the cell to the room above the cell dropped from.
+        const int      height = settings_.AgentHeight;
+        const int      y      = cell.Y;
+        const uint64_t column = Bits(cell.X, y, cell.Z);
+        std::size_t    count  = 0;
+        for (const auto& side : SIDES)
+        {
+            const int x = cell.X - side[0];
+            const int z = cell.Z - side[1];
+            if (IsWalkable(x, y, z))
+                moves[count++] = {Int3(x, y, z), 1.0f};
+            else if (IsWalkable(x, y - 1, z) && (Bits(x, y - 1 + height, z) & 1) == 0)
+                moves[count++] = {Int3(x, y - 1, z), 1.0f + settings_.ClimbCost};
+            for (int drop = 1; drop <= settings_.MaxDrop && (column >> (drop + height - 1) & 1) == 0; ++drop)
+                if (IsWalkable(x, y + drop, z))
+                    moves[count++] = {Int3(x, y + drop, z), 1.0f + settings_.DropCost * static_cast<float>(drop)};
+        }
+        for (const auto& diagonal : DIAGONALS)
+        {
+            const int x = cell.X - diagonal[0];
+            const int z = cell.Z - diagonal[1];
+            if (IsWalkable(x, y, z) && IsWalkable(cell.X, y, z) && IsWalkable(x, y, cell.Z))
+                moves[count++] = {Int3(x, y, z), DIAGONAL_COST};
+        }
+        return count;
+    }
+
+    bool NavigationGrid::ChangesLevel(const Int3& cell) const
+    {
+        NavigationMove move;
+        for (const auto& side : SIDES)
+            if (SideMove(cell, side[0], side[1], move) && move.Cell.Y != cell.Y && Contains(move.Cell))
+                return true;
+        return false;
+    }
+
+} // namespace Voxium::Core
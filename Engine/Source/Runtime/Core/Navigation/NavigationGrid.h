@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Navigation/WalkableSurface.h"
+
+namespace Voxium::Core
+{
+    struct NavigationMove
+    {
+        Int3  Cell = Int3(0, 0, 0); // where the move ends, or starts for MovesInto()
+        float Cost = 0.0f;
+    };
+
+    //--------------------------------------------------------------------------------
+    // NavigationGrid: the blocking voxels around a box of cells, copied out of a
+    // WalkableSurface into one run of 64-bit words per column, so searches through the
+    // box test walkability and generate moves without touching chunk tables. From a
+    // walkable cell an agent moves to the four side columns, flat, one voxel up or
+    // dropping onto the first blocking voxel below, and diagonally on flat ground when
+    // both side cells are walkable too, so it never cuts a corner. Moves reach one
+    // column past the box; searches keep to the box.
+    //--------------------------------------------------------------------------------
+    class CORE_API NavigationGrid
+    {
+    public:
+        // Enough for the moves into a cell; there are at most 8 out of one.
+        static constexpr int MAX_MOVES = 40;
+
+        using Moves = std::array<NavigationMove, MAX_MOVES>;
+
+        // Copies the voxels the cells in [min, max] and their moves depend on. Reuses its
+        // buffers, so a grid kept around makes rebuilding cheap.
+        void Build(const WalkableSurface& surface, const Int3& min, const Int3& max);
+
+        const Int3& Min() const { return min_; }
+        const Int3& Max() const { return max_; }
+
+        const NavigationSettings& Settings() const { return settings_; }
+
+        bool Contains(const Int3& cell) const
+        {
+            return cell.X >= min_.X && cell.Y >= min_.Y && cell.Z >= min_.Z && cell.X <= max_.X && cell.Y <= max_.Y && cell.Z <= max_.Z;
+        }
+
+        // Dense index of a cell in the box, x fastest, then z.
+        int Index(const Int3& cell) const { return ((cell.Y - min_.Y) * sizeZ_ + cell.Z - min_.Z) * sizeX_ + cell.X - min_.X; }
+
+        Int3 CellAt(int index) const
+        {
+            return Int3(min_.X + index % sizeX_, min_.Y + index / (sizeX_ * sizeZ_), min_.Z + index / sizeX_ % sizeZ_);
+        }
+
+        int CellCount() const { return sizeX_ * sizeY_ * sizeZ_; }
+
+        // Valid for cells of the box and the columns around it.
+        bool IsWalkable(int x, int y, int z) const
+        {
+            const uint64_t bits = Bits(x, y - 1, z);
+            return (bits & 1) != 0 && (bits & roomMask_) == 0 && y < mapHeight_;
+        }
+
+        bool IsWalkable(const Int3& cell) const { return IsWalkable(cell.X, cell.Y, cell.Z); }
+
+        // Moves out of a walkable cell, including the ones leaving the box; returns how many.
+        std::size_t MovesFrom(const Int3& cell, Moves& moves) const;
+
+        // Moves into a walkable cell, with the cells they start from; returns how many.
+        std::size_t MovesInto(const Int3& cell, Moves& moves) const;
+
+        // True when one of the side moves out of a walkable cell that stay in the box climbs or drops.
+        bool ChangesLevel(const Int3& cell) const;
+
+    private:
+        // Blocking voxels of a column from y upward, for y in the copied range.
+        uint64_t Bits(int x, int y, int z) const
+        {
+            const int       offset = y - baseY_;
+            const uint64_t* words  = &words_[static_cast<std::size_t>(((z - min_.Z + 1) * columnsX_ + x - min_.X + 1) * wordsPerColumn_ + (offset >> 6))];
+            const int       shift  = offset & 63;
+            return shift == 0 ? words[0] : words[0] >> shift | words[1] << (64 - shift);
+        }
+
+        // The side move out of a walkable cell into the next column, if any.
+        bool SideMove(const Int3& cell, int dx, int dz, NavigationMove& move) const;
+
+        NavigationSettings    settings_;
+        Int3                  min_            = Int3(0, 0, 0);
+        Int3                  max_            = Int3(-1, -1, -1);
+        int                   sizeX_          = 0;
+        int                   sizeY_          = 0;
+        int                   sizeZ_          = 0;
+        int                   columnsX_       = 0; // box plus one column on either side
+        int                   baseY_          = 0;
+        int                   wordsPerColumn_ = 0;
+        int                   mapHeight_      = 0;
+        uint64_t              roomMask_       = 0; // bits 1..AgentHeight
+        std::vector<uint64_t> words_;
+    };
+
+} // namespace Voxium::Core
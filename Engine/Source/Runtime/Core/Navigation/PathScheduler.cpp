@@ -0,0 +1,61 @@
+#include "Navigation/PathScheduler.h"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace Voxium::Core
+{
+    PathScheduler::PathScheduler(NavigationGraph& graph, ThreadPool& pool, const PathSchedulerSettings& settings)
+        : graph_(graph), pool_(pool), settings_(settings)
+    {
+        if (settings.TickBudget == 0 || settings.MaxExpandedPerQuery == 0)
+            throw std::invalid_argument("PathScheduler: budgets must be positive");
+    }
+
+    uint64_t PathScheduler::Request(const Int3& start, const Int3& goal)
+    {
+        pending_.push_back(Query {nextId_, start, goal});
+        return nextId_++;
+    }
+
+    void PathScheduler::Tick()
+    {
+        completed_.clear();
+        lastExpanded_ = 0;
+        graph_.Update(pool_);
+        if (pending_.empty())
+            return;
+
+        // ParallelFor hands out queries in order, and once the budget is spent every later one
+        // sees it spent too, so the queries answered are always the oldest ones.
+        std::vector<PathResult> results(pending_.size());
+        std::vector<uint8_t>    answered(pending_.size(), 0);
+        std::atomic<int64_t>    budget(settings_.TickBudget);
+        pool_.ParallelFor(pending_.size(), [&](std::size_t i) {
+            if (budget.load() <= 0)
+                return;
+            const Query& query  = pending_[i];
+            PathResult&  result = results[i];
+            result.Id           = query.Id;
+            result.Found        = graph_.FindPath(query.Start, query.Goal, result.Path, settings_.MaxExpandedPerQuery);
+            budget.fetch_sub(result.Path.Expanded);
+            answered[i] = 1;
+        });
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < pending_.size(); ++i)
+        {
+            if (answered[i] != 0)
+            {
+                lastExpanded_ += results[i].Path.Expanded;
+                completed_.push_back(std::move(results[i]));
+            }
+            else
+            {
+                pending_[kept++] = pending_[i];
+            }
+        }
+        pending_.erase(pending_.begin() + static_cast<std::ptrdiff_t>(kept), pending_.end());
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Navigation/NavigationGraph.h"
+#include "Thread/ThreadPool.h"
+
+namespace Voxium::Core
+{
+    struct PathSchedulerSettings
+    {
+        // Entrances and cells expanded per Tick, summed over every query. Queries already
+        // running finish, so a tick overshoots by at most one query per thread.
+        uint32_t TickBudget = 200000;
+
+        // A query expanding more than this fails, so one query never holds up the rest for long.
+        uint32_t MaxExpandedPerQuery = 50000;
+    };
+
+    struct PathResult
+    {
+        uint64_t       Id    = 0;
+        bool           Found = false;
+        NavigationPath Path;
+    };
+
+    //--------------------------------------------------------------------------------
+    // PathScheduler: answers path requests of many agents against a NavigationGraph,
+    // oldest first, a bounded amount of search per frame. Tick() brings the graph up to
+    // date with the edits of the frame, then runs queued queries on the pool until the
+    // frame's budget of expanded nodes is spent; the rest wait for the next Tick. Request
+    // and Tick belong to the thread that edits the map.
+    //--------------------------------------------------------------------------------
+    class CORE_API PathScheduler
+    {
+    public:
+        PathScheduler(NavigationGraph& graph, ThreadPool& pool, const PathSchedulerSettings& settings = {});
+
+        PathScheduler(const PathScheduler&)            = delete;
+        PathScheduler& operator=(const PathScheduler&) = delete;
+
+        // Queues a query and returns its id, which starts at 1 and counts up.
+        uint64_t Request(const Int3& start, const Int3& goal);
+
+        // Once per frame, after the edits of the frame.
+        void Tick();
+
+        // Queries answered by the last Tick, in request order.
+        const std::vector<PathResult>& Completed() const { return completed_; }
+
+        // Queries waiting for a Tick.
+        std::size_t PendingCount() const { return pending_.size(); }
+
+        // Nodes expanded by the last Tick.
+        uint64_t LastExpanded() const { return lastExpanded_; }
+
+        const PathSchedulerSettings& Settings() const { return settings_; }
+
+    private:
+        struct Query
+        {
+            uint64_t Id;
+            Int3     Start;
+            Int3     Goal;
+        };
+
+        NavigationGraph&        graph_;
+        ThreadPool&             pool_;
+        PathSchedulerSettings   settings_;
+        std::vector<Query>      pending_;
+        std::vector<PathResult> completed_;
+        uint64_t                nextId_       = 1;
+        uint64_t                lastExpanded_ = 0;
+    };
+
+} // namespace Voxium::Core
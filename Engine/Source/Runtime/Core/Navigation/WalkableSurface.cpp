@@ -0,0 +1,178 @@
+#include "Navigation/WalkableSurface.h"
+
+#include <bit>
+#include <stdexcept>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr int MAX_AGENT_HEIGHT = 8;
+        constexpr int MAX_DROP         = 8;
+
+        constexpr std::size_t ColumnIndex(int x, int z) { return static_cast<std::size_t>((x & CHUNK_MASK) | (z & CHUNK_MASK) << CHUNK_SHIFT); }
+    } // namespace
+
+    WalkableSurface::WalkableSurface(const ChunkedVoxelMap& map, const NavigationSettings& settings) :
+        map_(map), settings_(settings), blocking_(static_cast<std::size_t>(map.MAX_KIND) + 1, 1)
+    {
+        if (settings.AgentHeight < 1 || settings.AgentHeight > MAX_AGENT_HEIGHT)
+            throw std::invalid_argument("Agent height must be between 1 and 8 voxels");
+        if (settings.MaxDrop < 0 || settings.MaxDrop > MAX_DROP)
+            throw std::invalid_argument("Drop must be between 0 and 8 voxels");
+        if (settings.ClimbCost < 0.0f || settings.DropCost < 0.0f)
+            throw std::invalid_argument("Move costs cannot be negative");
+        blocking_[AIR_KIND] = 0;
+    }
+
+    void WalkableSurface::SetKindBlocking(BlockKind kind, bool blocking)
+    {
+        if (kind == AIR_KIND)
+            throw std::invalid_argument("Air never blocks");
+        if (kind >= blocking_.size())
+            throw std::out_of_range("Block kind above the map's MAX_KIND");
+        blocking_[kind] = blocking;
+    }
+
+    void WalkableSurface::Rebuild()
+    {
+        masks_.clear();
+        map_.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk&) { OnChunkChanged(chunkPos); });
+    }
+
+    void WalkableSurface::OnBlockChanged(int x, int y, int z)
+    {
+        if (map_.OutOfBounds(x, y, z))
+            throw std::out_of_range("Block position outside the map");
+
+        const Int3     chunkPos = ChunkOf(x, y, z);
+        const uint32_t bit      = 1u << (y & CHUNK_MASK);
+        auto           it       = masks_.find(chunkPos);
+        if (blocking_[map_.GetBlock(x, y, z)] != 0)
+        {
+            if (it == masks_.end())
+                it = masks_.emplace(chunkPos, std::make_unique<ColumnMasks>()).first;
+            (*it->second)[ColumnIndex(x, z)] |= bit;
+        }
+        else if (it != masks_.end())
+        {
+            ColumnMasks& masks = *it->second;
+            masks[ColumnIndex(x, z)] &= ~bit;
+            if (masks[ColumnIndex(x, z)] == 0 && std::all_of(masks.begin(), masks.end(), [](uint32_t column) { return column == 0; }))
+                masks_.erase(it);
+        }
+    }
+
+    void WalkableSurface::OnChunkChanged(const Int3& chunkPos)
+    {
+        const VoxelChunk* chunk = map_.GetChunk(chunkPos);
+        if (chunk == nullptr || chunk->IsEmpty())
+        {
+            masks_.erase(chunkPos);
+            return;
+        }
+
+        auto masks = std::make_unique<ColumnMasks>();
+        if (chunk->IsUniform())
+        {
+            if (blocking_[chunk->Get(0)] == 0)
+            {
+                masks_.erase(chunkPos);
+                return;
+            }
+            masks->fill(~0u);
+        }
+        else
+        {
+            // Blocking per palette entry, then one pass over the indices of the bricks that hold anything.
+            const std::vector<BlockKind>& palette = chunk->Palette();
+            std::vector<uint8_t>          blocks(palette.size());
+            for (std::size_t i = 0; i < palette.size(); ++i)
+                blocks[i] = blocking_[palette[i]];
+
+            const uint64_t occupied = chunk->OccupiedBricks();
+            for (int y = 0; y < CHUNK_SIZE; ++y)
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                    for (int x = 0; x < CHUNK_SIZE; x += VoxelChunk::BRICK_SIZE)
+                    {
+                        if ((occupied >> VoxelChunk::BrickIndex(x, y, z) & 1) == 0)
+                            continue;
+                        for (int i = 0; i < VoxelChunk::BRICK_SIZE; ++i)
+                            (*masks)[ColumnIndex(x + i, z)] |= static_cast<uint32_t>(blocks[chunk->PaletteIndex(ChunkIndex(x + i, y, z))]) << y;
+                    }
+            if (std::all_of(masks->begin(), masks->end(), [](uint32_t column) { return column == 0; }))
+            {
+                masks_.erase(chunkPos);
+                return;
+            }
+        }
+        masks_[chunkPos] = std::move(masks);
+    }
+
+    const WalkableSurface::ColumnMasks* WalkableSurface::Masks(const Int3& chunkPos) const
+    {
+        const auto it = masks_.find(chunkPos);
+        return it != masks_.end() ? it->second.get() : nullptr;
+    }
+
+    bool WalkableSurface::IsBlocked(int x, int y, int z) const
+    {
+        if (y < 0 || x < 0 || z < 0 || x >= map_.SizeX() || z >= map_.SizeZ())
+            return true;
+        const ColumnMasks* masks = Masks(ChunkOf(x, y, z));
+        return masks != nullptr && ((*masks)[ColumnIndex(x, z)] >> (y & CHUNK_MASK) & 1) != 0;
+    }
+
+    bool WalkableSurface::IsWalkable(const Int3& cell) const
+    {
+        if (cell.X < 0 || cell.Z < 0 || cell.X >= map_.SizeX() || cell.Z >= map_.SizeZ() || cell.Y < 0 || cell.Y >= map_.SizeY())
+            return false;
+        if (!IsBlocked(cell.X, cell.Y - 1, cell.Z))
+            return false;
+        for (int h = 0; h < settings_.AgentHeight; ++h)
+            if (IsBlocked(cell.X, cell.Y + h, cell.Z))
+                return false;
+        return true;
+    }
+
+    int WalkableSurface::ExtractWalkable(const Int3& chunkPos, ColumnMasks& walkable) const
+    {
+        walkable.fill(0);
+        const int baseY = chunkPos.Y << CHUNK_SHIFT;
+        if (baseY < 0 || baseY >= map_.SizeY())
+            return 0;
+
+        const ColumnMasks* masks = Masks(chunkPos);
+        const ColumnMasks* below = chunkPos.Y > 0 ? Masks(Int3(chunkPos.X, chunkPos.Y - 1, chunkPos.Z)) : nullptr;
+        const ColumnMasks* above = Masks(Int3(chunkPos.X, chunkPos.Y + 1, chunkPos.Z));
+        if (masks == nullptr && below == nullptr && chunkPos.Y > 0)
+            return 0;
+
+        // Cells above the top of the map are not walkable.
+        const int      height = std::min(map_.SizeY() - baseY, CHUNK_SIZE);
+        const uint64_t inMap  = height == CHUNK_SIZE ? 0xFFFFFFFFull : (1ull << height) - 1;
+        const int      baseX  = chunkPos.X << CHUNK_SHIFT;
+        const int      baseZ  = chunkPos.Z << CHUNK_SHIFT;
+        const int      sizeX  = std::min(map_.SizeX() - baseX, CHUNK_SIZE);
+        const int      sizeZ  = std::min(map_.SizeZ() - baseZ, CHUNK_SIZE);
+
+        int count = 0;
+        for (int z = 0; z < sizeZ; ++z)
+            for (int x = 0; x < sizeX; ++x)
+            {
+                // Bit i is the voxel at local y = i - 1: the top of the chunk below, this chunk, then the bottom of the one above.
+                const std::size_t column = ColumnIndex(x, z);
+                const uint64_t    ground = chunkPos.Y == 0 ? 1u : below != nullptr ? (*below)[column] >> CHUNK_MASK : 0u;
+                const uint64_t    blocked = ground | static_cast<uint64_t>(masks != nullptr ? (*masks)[column] : 0u) << 1 |
+                                         static_cast<uint64_t>(above != nullptr ? (*above)[column] : 0u) << 33;
+
+                uint64_t room = ~0ull;
+                for (int h = 1; h <= settings_.AgentHeight; ++h)
+                    room &= ~(blocked >> h);
+                walkable[column] = static_cast<uint32_t>(blocked & room & inMap);
+                count += std::popcount(walkable[column]);
+            }
+        return count;
+    }
+
+} // namespace Voxium::Core
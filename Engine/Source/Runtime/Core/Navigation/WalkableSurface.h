@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Core
+{
+    // How an agent walks: it stands on a blocking voxel, needs AgentHeight voxels of room above
+    // it, climbs one voxel per step and drops at most MaxDrop voxels per step.
+    struct NavigationSettings
+    {
+        int AgentHeight = 2;
+        int MaxDrop     = 3;
+
+        // Added to a move, on top of its horizontal length of 1 or sqrt(2), per voxel climbed or dropped.
+        float ClimbCost = 0.5f;
+        float DropCost  = 0.25f;
+
+        // Lower bound of the cost between two cells: the octile distance plus the climb.
+        float EstimateCost(const Int3& from, const Int3& to) const
+        {
+            const int dx = std::abs(to.X - from.X);
+            const int dz = std::abs(to.Z - from.Z);
+            return static_cast<float>(std::max(dx, dz)) + 0.41421356f * static_cast<float>(std::min(dx, dz)) +
+                   ClimbCost * static_cast<float>(std::max(to.Y - from.Y, 0));
+        }
+    };
+
+    //--------------------------------------------------------------------------------
+    // WalkableSurface: which voxels of a ChunkedVoxelMap block an agent, as one 32-bit
+    // mask per (x, z) column of every chunk, bit y set for blocking voxels, kept up to date
+    // with the edits. A cell is walkable when its voxel and the AgentHeight - 1 above it
+    // are free and the voxel below blocks; ExtractWalkable() finds every walkable cell of a
+    // chunk with a few shifts per column.
+    //
+    // Below the map counts as blocking, so the bottom layer is a floor; beside the map
+    // nothing is walkable. Edits are reported with OnBlockChanged() or OnChunkChanged(),
+    // through NavigationGraph when the surface belongs to one. Every non-air kind blocks
+    // until SetKindBlocking() says otherwise; call Rebuild() after changing kinds that
+    // are already in the map. Everything belongs to the thread that edits the map.
+    //--------------------------------------------------------------------------------
+    class CORE_API WalkableSurface
+    {
+    public:
+        // Bit y of column x | z << CHUNK_SHIFT of a chunk.
+        using ColumnMasks = std::array<uint32_t, CHUNK_AREA>;
+
+        // Throws std::invalid_argument for agents taller than 8 voxels, drops outside [0, 8] and
+        // negative costs.
+        explicit WalkableSurface(const ChunkedVoxelMap& map, const NavigationSettings& settings = {});
+
+        // Throws std::invalid_argument for AIR_KIND and std::out_of_range above the map's MAX_KIND.
+        void SetKindBlocking(BlockKind kind, bool blocking);
+
+        bool IsBlocking(BlockKind kind) const { return blocking_[kind] != 0; }
+
+        // Scans the whole map.
+        void Rebuild();
+
+        // Sets or clears the voxel's bit from its new kind. Throws std::out_of_range outside the map.
+        void OnBlockChanged(int x, int y, int z);
+
+        // Recomputes the masks of the chunk from its palette, or drops them when nothing in it
+        // blocks; cheaper than OnBlockChanged() per voxel once a chunk is filled or replaced.
+        void OnChunkChanged(const Int3& chunkPos);
+
+        // Blocking voxels of a chunk, or nullptr if it has none.
+        const ColumnMasks* Masks(const Int3& chunkPos) const;
+
+        bool IsBlocked(int x, int y, int z) const;
+
+        bool IsWalkable(const Int3& cell) const;
+
+        // Fills walkable with the walkable cells of the chunk, in the layout of ColumnMasks, and
+        // returns how many there are.
+        int ExtractWalkable(const Int3& chunkPos, ColumnMasks& walkable) const;
+
+        // Calls func(chunkPos) once for every chunk that may hold walkable cells: the chunks with
+        // blocking voxels, the ones right above them and the bottom layer, which stands on the floor.
+        template<typename Func>
+        void ForEachCandidateChunk(Func&& func) const
+        {
+            for (const auto& [chunkPos, masks] : masks_)
+            {
+                func(chunkPos);
+                const Int3 above(chunkPos.X, chunkPos.Y + 1, chunkPos.Z);
+                if (above.Y << CHUNK_SHIFT < map_.SizeY() && !masks_.contains(above))
+                    func(above);
+            }
+            for (int cz = 0; cz << CHUNK_SHIFT < map_.SizeZ(); ++cz)
+                for (int cx = 0; cx << CHUNK_SHIFT < map_.SizeX(); ++cx)
+                    if (!masks_.contains(Int3(cx, 0, cz)))
+                        func(Int3(cx, 0, cz));
+        }
+
+        const ChunkedVoxelMap& Map() const { return map_; }
+
+        const NavigationSettings& Settings() const { return settings_; }
+
+        std::size_t ChunkCount() const { return masks_.size(); }
+
+    private:
+        const ChunkedVoxelMap&                                             map_;
+        NavigationSettings                                                 settings_;
+        std::vector<uint8_t>                                               blocking_;
+        std::unordered_map<Int3, std::unique_ptr<ColumnMasks>, Int3Hasher> masks_;
+    };
+
+} // namespace Voxium::Core
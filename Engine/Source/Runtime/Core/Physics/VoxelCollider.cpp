@@ -0,0 +1,336 @@
+#include "Physics/VoxelCollider.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        // Faces closer than this count as touching rather than overlapping, so a box resting on a
+        // voxel slides along it despite rounding.
+        constexpr float EPSILON = 1e-4f;
+
+        constexpr int BRICK_MASK = VoxelChunk::BRICK_SIZE - 1;
+
+        // Entities per pool task in MoveBatch().
+        constexpr std::size_t GROUP_SIZE = 256;
+
+        struct Box
+        {
+            float Min[3];
+            float Max[3];
+
+            void Translate(int axis, float distance)
+            {
+                Min[axis] += distance;
+                Max[axis] += distance;
+            }
+        };
+
+        Box MakeBox(const Vector3F& min, const Vector3F& max) { return Box {{min.X, min.Y, min.Z}, {max.X, max.Y, max.Z}}; }
+
+        bool OverlapsOn(const Box& box, int axis, int cell)
+        {
+            const float low = static_cast<float>(cell);
+            return box.Max[axis] > low + EPSILON && box.Min[axis] < low + 1 - EPSILON;
+        }
+
+        // Shortens a move along the axis so the box stops against the first solid voxel in its way.
+        // Voxels the box already overlaps do not stop it, so boxes stuck inside can get out.
+        float Clip(const Box& box, int axis, float move, const std::vector<Int3>& solids)
+        {
+            if (move == 0.0f)
+                return 0.0f;
+            const int u = (axis + 1) % 3;
+            const int v = (axis + 2) % 3;
+            for (const Int3& solid : solids)
+            {
+                const int cell[3] = {solid.X, solid.Y, solid.Z};
+                if (!OverlapsOn(box, u, cell[u]) || !OverlapsOn(box, v, cell[v]))
+                    continue;
+                const float low = static_cast<float>(cell[axis]);
+                if (move > 0.0f && box.Max[axis] <= low + EPSILON)
+                    move = std::min(move, std::max(low - box.Max[axis], 0.0f));
+                else if (move < 0.0f && box.Min[axis] >= low + 1 - EPSILON)
+                    move = std::max(move, std::min(low + 1 - box.Min[axis], 0.0f));
+            }
+            return move;
+        }
+
+        // Moves the box along y, x and z in turn and returns the axes that were cut short.
+        uint8_t Sweep(Box& box, const float (&wanted)[3], const std::vector<Int3>& solids)
+        {
+            uint8_t blocked = 0;
+            for (const int axis : {1, 0, 2})
+            {
+                const float move = Clip(box, axis, wanted[axis], solids);
+                if (move != wanted[axis])
+                    blocked |= static_cast<uint8_t>(1 << axis);
+                box.Translate(axis, move);
+            }
+            return blocked;
+        }
+
+        bool IsOnGround(const Box& box, float probe, const std::vector<Int3>& solids)
+        {
+            return std::any_of(solids.begin(), solids.end(), [&](const Int3& solid) {
+                const float y = static_cast<float>(solid.Y);
+                return OverlapsOn(box, 0, solid.X) && OverlapsOn(box, 2, solid.Z) && y < box.Min[1] && y + 1 >= box.Min[1] - probe;
+            });
+        }
+
+        Int3 FloorCell(const float (&point)[3])
+        {
+            return Int3(static_cast<int>(std::floor(point[0])), static_cast<int>(std::floor(point[1])), static_cast<int>(std::floor(point[2])));
+        }
+
+        Int3 CeilCell(const float (&point)[3])
+        {
+            return Int3(static_cast<int>(std::ceil(point[0])), static_cast<int>(std::ceil(point[1])), static_cast<int>(std::ceil(point[2])));
+        }
+
+        float HorizontalDistanceSquared(const Box& from, const Box& to)
+        {
+            const float dx = to.Min[0] - from.Min[0];
+            const float dz = to.Min[2] - from.Min[2];
+            return dx * dx + dz * dz;
+        }
+
+    } // namespace
+
+    // Chunk pointers are kept across calls in a direct-mapped table. An entry is only used while
+    // the map's chunk table is at the version it was read at, and no two maps share a version.
+    struct VoxelCollider::ThreadScratch
+    {
+        struct CachedChunk
+        {
+            uint64_t          Version = 0;
+            uint64_t          Key     = 0;
+            const VoxelChunk* Chunk   = nullptr;
+        };
+
+        static constexpr int CACHE_SIZE = 256;
+
+        std::vector<Int3>                   Solids;
+        std::array<CachedChunk, CACHE_SIZE> Chunks;
+    };
+
+    VoxelCollider::ThreadScratch& VoxelCollider::LocalScratch()
+    {
+        thread_local ThreadScratch scratch;
+        return scratch;
+    }
+
+    VoxelCollider::VoxelCollider(const ChunkedVoxelMap& map, const CollisionSettings& settings)
+        : map_(map), settings_(settings), solid_(static_cast<std::size_t>(map.MAX_KIND) + 1, 1)
+    {
+        if (settings.StepHeight < 0.0f || settings.GroundProbe < 0.0f)
+            throw std::invalid_argument("VoxelCollider: step height and ground probe must not be negative");
+        solid_[AIR_KIND] = 0;
+    }
+
+    void VoxelCollider::SetKindSolid(BlockKind kind, bool solid)
+    {
+        if (kind == AIR_KIND)
+            throw std::invalid_argument("VoxelCollider::SetKindSolid: air is never solid");
+        if (kind > map_.MAX_KIND)
+            throw std::out_of_range("VoxelCollider::SetKindSolid: kind above the map's MAX_KIND");
+        solid_[kind] = solid ? 1 : 0;
+        nonSolidKinds_ = static_cast<int>(std::count(solid_.begin() + 1, solid_.end(), 0));
+    }
+
+    const VoxelChunk* VoxelCollider::FindChunk(int cx, int cy, int cz, ThreadScratch& scratch) const
+    {
+        // Gathered regions are clipped to the map, so chunk coordinates are small and not negative.
+        const uint64_t key     = static_cast<uint64_t>(cx) | static_cast<uint64_t>(cy) << 21 | static_cast<uint64_t>(cz) << 42;
+        const uint64_t version = map_.ChunkTableVersion();
+        auto&          entry   = scratch.Chunks[static_cast<std::size_t>(cx ^ cz << 4 ^ cy << 3) % ThreadScratch::CACHE_SIZE];
+        if (entry.Version != version || entry.Key != key)
+            entry = {version, key, map_.GetChunk(Int3(cx, cy, cz))};
+        return entry.Chunk;
+    }
+
+    void VoxelCollider::GatherSolids(const Int3& min, const Int3& max, ThreadScratch& scratch) const
+    {
+        std::vector<Int3>& solids = scratch.Solids;
+        // Int3 is packed, so its fields are copied before std::max() binds references to them.
+        const int lowX  = std::max(int {min.X}, 0);
+        const int lowY  = std::max(int {min.Y}, 0);
+        const int lowZ  = std::max(int {min.Z}, 0);
+        const int highX = std::min(int {max.X}, map_.SizeX());
+        const int highY = std::min(int {max.Y}, map_.SizeY());
+        const int highZ = std::min(int {max.Z}, map_.SizeZ());
+        if (lowX >= highX || lowY >= highY || lowZ >= highZ)
+            return;
+
+        // Full bricks hold no air, so they are solid without decoding unless some kind is not.
+        const bool fullIsSolid = nonSolidKinds_ == 0;
+        for (int cy = lowY >> CHUNK_SHIFT; cy <= (highY - 1) >> CHUNK_SHIFT; ++cy)
+            for (int cz = lowZ >> CHUNK_SHIFT; cz <= (highZ - 1) >> CHUNK_SHIFT; ++cz)
+                for (int cx = lowX >> CHUNK_SHIFT; cx <= (highX - 1) >> CHUNK_SHIFT; ++cx)
+                {
+                    const VoxelChunk* chunk = FindChunk(cx, cy, cz, scratch);
+                    if (chunk == nullptr || chunk->IsEmpty())
+                        continue;
+                    const Int3 origin(cx << CHUNK_SHIFT, cy << CHUNK_SHIFT, cz << CHUNK_SHIFT);
+                    const int  fromX = std::max(lowX - origin.X, 0);
+                    const int  fromY = std::max(lowY - origin.Y, 0);
+                    const int  fromZ = std::max(lowZ - origin.Z, 0);
+                    const int  toX   = std::min(highX - origin.X, CHUNK_SIZE);
+                    const int  toY   = std::min(highY - origin.Y, CHUNK_SIZE);
+                    const int  toZ   = std::min(highZ - origin.Z, CHUNK_SIZE);
+
+                    // With up to 16 palette entries, their solidity fits a mask and the 8 voxels of a brick
+                    // row share one index word, so mixed bricks are decoded a row at a time.
+                    const std::vector<BlockKind>& palette   = chunk->Palette();
+                    const uint64_t                occupied  = chunk->OccupiedBricks();
+                    const uint64_t                full      = fullIsSolid ? chunk->FullBricks() : 0;
+                    const int                     bits      = chunk->BitsPerIndex();
+                    const uint64_t*               words     = chunk->PackedIndices().data();
+                    const uint64_t                indexMask = (1ull << bits) - 1;
+                    const bool                    byRow     = palette.size() <= 16;
+                    uint32_t                      solidMask = 0;
+                    for (std::size_t i = 0; byRow && i < palette.size(); ++i)
+                        solidMask |= static_cast<uint32_t>(solid_[palette[i]]) << i;
+
+                    for (int y = fromY; y < toY; ++y)
+                        for (int z = fromZ; z < toZ; ++z)
+                            for (int bx = fromX & ~BRICK_MASK; bx < toX; bx += VoxelChunk::BRICK_SIZE)
+                            {
+                                const int brick = VoxelChunk::BrickIndex(bx, y, z);
+                                if ((occupied >> brick & 1) == 0)
+                                    continue;
+                                const uint32_t span = (0xFFu << std::max(fromX - bx, 0)) & (0xFFu >> std::max(bx + VoxelChunk::BRICK_SIZE - toX, 0));
+                                uint32_t       hits = span;
+                                if ((full >> brick & 1) == 0)
+                                {
+                                    hits = 0;
+                                    if (byRow)
+                                    {
+                                        const int      rowBit = ChunkIndex(bx, y, z) * bits;
+                                        const uint64_t row    = bits == 0 ? 0 : words[rowBit >> 6] >> (rowBit & 63);
+                                        if (bits == 1)
+                                            hits = static_cast<uint32_t>(((solidMask & 2) != 0 ? row : 0) | ((solidMask & 1) != 0 ? ~row : 0));
+                                        else
+                                            for (int x = 0; x < VoxelChunk::BRICK_SIZE; ++x)
+                                                hits |= (solidMask >> (row >> (x * bits) & indexMask) & 1) << x;
+                                    }
+                                    else
+                                    {
+                                        for (int x = 0; x < VoxelChunk::BRICK_SIZE; ++x)
+                                            hits |= static_cast<uint32_t>(solid_[palette[chunk->PaletteIndex(ChunkIndex(bx + x, y, z))]]) << x;
+                                    }
+                                    hits &= span;
+                                }
+                                for (; hits != 0; hits &= hits - 1)
+                                    solids.push_back(origin + Int3(bx + std::countr_zero(hits), y, z));
+                            }
+                }
+    }
+
+    MoveResult VoxelCollider::Move(const EntityMotion& motion) const { return Move(motion, LocalScratch()); }
+
+    MoveResult VoxelCollider::Move(const EntityMotion& motion, ThreadScratch& scratch) const
+    {
+        const Box   start     = MakeBox(motion.Min, motion.Max);
+        const float wanted[3] = {motion.Displacement.X, motion.Displacement.Y, motion.Displacement.Z};
+
+        // Every voxel the move or the ground probe can touch, gathered once.
+        float low[3];
+        float high[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            low[axis]  = std::min(start.Min[axis], start.Min[axis] + wanted[axis]);
+            high[axis] = std::max(start.Max[axis], start.Max[axis] + wanted[axis]);
+        }
+        low[1] -= settings_.GroundProbe;
+        const std::vector<Int3>& solids = scratch.Solids;
+        scratch.Solids.clear();
+        GatherSolids(FloorCell(low), CeilCell(high), scratch);
+
+        Box        box = start;
+        MoveResult result;
+        result.Blocked = Sweep(box, wanted, solids);
+
+        // Stopped sideways on the ground: lift, move across, settle, and keep it if it went farther.
+        const bool onGround = motion.Grounded || (wanted[1] < 0.0f && (result.Blocked & 2) != 0);
+        if (settings_.StepHeight > 0.0f && onGround && (result.Blocked & 5) != 0)
+        {
+            // Steps are rare, so the layer above the region is only read for them.
+            const float stepHigh[3] = {high[0], high[1] + settings_.StepHeight, high[2]};
+            const Int3  regionLow   = FloorCell(low);
+            GatherSolids(Int3(regionLow.X, CeilCell(high).Y, regionLow.Z), CeilCell(stepHigh), scratch);
+
+            Box         lifted = start;
+            const float rise   = Clip(lifted, 1, settings_.StepHeight, solids);
+            lifted.Translate(1, rise);
+            uint8_t blocked = 0;
+            for (const int axis : {0, 2})
+            {
+                const float move = Clip(lifted, axis, wanted[axis], solids);
+                if (move != wanted[axis])
+                    blocked |= static_cast<uint8_t>(1 << axis);
+                lifted.Translate(axis, move);
+            }
+            const float settle = std::min(wanted[1], 0.0f) - rise;
+            const float drop   = Clip(lifted, 1, settle, solids);
+            if (drop != settle)
+                blocked |= 2;
+            lifted.Translate(1, drop);
+            if (HorizontalDistanceSquared(start, lifted) > HorizontalDistanceSquared(start, box) + EPSILON)
+            {
+                box            = lifted;
+                result.Blocked = blocked;
+                result.Stepped = lifted.Min[1] > start.Min[1] + EPSILON;
+            }
+        }
+
+        result.Min      = Vector3F(box.Min[0], box.Min[1], box.Min[2]);
+        result.Max      = Vector3F(box.Max[0], box.Max[1], box.Max[2]);
+        result.Moved    = result.Min - motion.Min;
+        result.Grounded = IsOnGround(box, settings_.GroundProbe, solids);
+        return result;
+    }
+
+    void VoxelCollider::MoveBatch(std::span<const EntityMotion> motions, std::span<MoveResult> results, ThreadPool& pool) const
+    {
+        if (motions.size() != results.size())
+            throw std::invalid_argument("MoveBatch needs one result per motion");
+
+        // Entities are usually stored near their neighbours, and each thread keeps the chunks it
+        // looked up, so consecutive groups are enough.
+        const std::size_t groups = (motions.size() + GROUP_SIZE - 1) / GROUP_SIZE;
+        pool.ParallelFor(groups, [&](std::size_t group) {
+            ThreadScratch&    scratch = LocalScratch();
+            const std::size_t end     = std::min(motions.size(), (group + 1) * GROUP_SIZE);
+            for (std::size_t i = group * GROUP_SIZE; i < end; ++i)
+                results[i] = Move(motions[i], scratch);
+        });
+    }
+
+    bool VoxelCollider::IsGrounded(const Vector3F& min, const Vector3F& max) const
+    {
+        const Box      box      = MakeBox(min, max);
+        const float    below[3] = {min.X, min.Y - settings_.GroundProbe, min.Z};
+        const float    above[3] = {max.X, min.Y, max.Z};
+        ThreadScratch& scratch  = LocalScratch();
+        scratch.Solids.clear();
+        GatherSolids(FloorCell(below), CeilCell(above), scratch);
+        return IsOnGround(box, settings_.GroundProbe, scratch.Solids);
+    }
+
+    bool VoxelCollider::Overlaps(const Vector3F& min, const Vector3F& max) const
+    {
+        const Box      box     = MakeBox(min, max);
+        ThreadScratch& scratch = LocalScratch();
+        scratch.Solids.clear();
+        GatherSolids(FloorCell(box.Min), CeilCell(box.Max), scratch);
+        return std::any_of(scratch.Solids.begin(), scratch.Solids.end(),
+                           [&](const Int3& solid) { return OverlapsOn(box, 0, solid.X) && OverlapsOn(box, 1, solid.Y) && OverlapsOn(box, 2, solid.Z); });
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Math/Vector3F.h"
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Core
+{
+    struct CollisionSettings
+    {
+        // Ledges up to this high are climbed while walking on the ground, in voxels.
+        float StepHeight = 0.6f;
+
+        // How far below its feet a box still counts as standing on something.
+        float GroundProbe = 0.01f;
+    };
+
+    // An axis-aligned box in voxel units and the displacement it tries to make this tick.
+    // Vector3F is packed, so the motion and result structs are aligned explicitly; their
+    // floats stay aligned in arrays.
+    struct alignas(4) EntityMotion
+    {
+        Vector3F Min          = Vector3F(0.0f);
+        Vector3F Max          = Vector3F(0.0f);
+        Vector3F Displacement = Vector3F(0.0f);
+        bool     Grounded     = false; // standing on something before the move, which allows stepping up
+    };
+
+    struct alignas(4) MoveResult
+    {
+        Vector3F Min      = Vector3F(0.0f);
+        Vector3F Max      = Vector3F(0.0f);
+        Vector3F Moved    = Vector3F(0.0f); // displacement actually made
+        bool     Grounded = false;          // standing on something after the move
+        bool     Stepped  = false;          // climbed a ledge
+        uint8_t  Blocked  = 0;              // bit 0, 1, 2 when x, y, z was cut short
+    };
+
+    static_assert(sizeof(EntityMotion) % 4 == 0 && sizeof(MoveResult) % 4 == 0);
+
+    //--------------------------------------------------------------------------------
+    // VoxelCollider: moves axis-aligned boxes through the solid voxels of a
+    // ChunkedVoxelMap. A move gathers the solid voxels of the box swept by the whole
+    // displacement once, straight from the chunks: empty chunks and empty 8^3 bricks are
+    // skipped and full bricks are taken without decoding, so there is no per-voxel map
+    // lookup. The displacement is then clipped against them one axis at a time, y first,
+    // then x and z. A box that starts on the ground and is stopped sideways tries again
+    // lifted by StepHeight, reading the voxels above only then, and keeps whichever attempt
+    // got farther.
+    //
+    // Each thread keeps the chunks it looked up until the map creates or removes one, so
+    // entities near the last ones skip the map's table. MoveBatch() moves groups of
+    // consecutive entities on the pool. Space outside the map is empty. Queries are const
+    // and may run on any number of threads, but not while the map changes.
+    //--------------------------------------------------------------------------------
+    class CORE_API VoxelCollider
+    {
+    public:
+        // Throws std::invalid_argument for negative heights or probes.
+        explicit VoxelCollider(const ChunkedVoxelMap& map, const CollisionSettings& settings = {});
+
+        // Every non-air kind is solid until this says otherwise. Throws std::invalid_argument for
+        // AIR_KIND and std::out_of_range above the map's MAX_KIND.
+        void SetKindSolid(BlockKind kind, bool solid);
+
+        // False for kinds above the map's MAX_KIND, which no voxel can hold.
+        bool IsSolid(BlockKind kind) const { return kind < solid_.size() && solid_[kind] != 0; }
+
+        MoveResult Move(const EntityMotion& motion) const;
+
+        // Throws std::invalid_argument unless results.size() equals motions.size().
+        void MoveBatch(std::span<const EntityMotion> motions, std::span<MoveResult> results, ThreadPool& pool) const;
+
+        // Whether a solid voxel lies within GroundProbe below the box.
+        bool IsGrounded(const Vector3F& min, const Vector3F& max) const;
+
+        // Whether the box overlaps a solid voxel.
+        bool Overlaps(const Vector3F& min, const Vector3F& max) const;
+
+        const CollisionSettings& Settings() const { return settings_; }
+
+    private:
+        // Per thread: the solid voxels gathered for the current query and the chunks looked up so far.
+        struct ThreadScratch;
+
+        static ThreadScratch& LocalScratch();
+
+        const VoxelChunk* FindChunk(int cx, int cy, int cz, ThreadScratch& scratch) const;
+
+        // Appends the solid voxels overlapping the box of voxel coordinates [min, max) to the scratch.
+        void GatherSolids(const Int3& min, const Int3& max, ThreadScratch& scratch) const;
+
+        MoveResult Move(const EntityMotion& motion, ThreadScratch& scratch) const;
+
+        const ChunkedVoxelMap& map_;
+        CollisionSettings      settings_;
+        std::vector<uint8_t>   solid_;
+        int                    nonSolidKinds_ = 0; // full bricks are solid without decoding while this is 0
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,60 @@
+#include "Math/Frustum.h"
+
+#include <cmath>
+
+#include "Math/Matrix4F.h"
+#include "Math/Vector3F.h"
+
+namespace Voxium::Core
+{
+
+    namespace
+    {
+        // Plane a * x + b * y + c * z + d >= 0, scaled to a unit normal.
+        Vector4F NormalizedPlane(float a, float b, float c, float d)
+        {
+            const float length = std::sqrt(a * a + b * b + c * c);
+            return Vector4F(a / length, b / length, c / length, d / length);
+        }
+    } // namespace
+
+    // Clip coordinates are (x, y, z, 1) * M, so each one is the dot product of the point with a
+    // matrix column; -w <= x is then column 4 + column 1 >= 0, and so on (Gribb and Hartmann).
+    Frustum::Frustum(const Matrix4F& m) :
+        Planes {NormalizedPlane(m.M14 + m.M11, m.M24 + m.M21, m.M34 + m.M31, m.M44 + m.M41),
+                NormalizedPlane(m.M14 - m.M11, m.M24 - m.M21, m.M34 - m.M31, m.M44 - m.M41),
+                NormalizedPlane(m.M14 + m.M12, m.M24 + m.M22, m.M34 + m.M32, m.M44 + m.M42),
+                NormalizedPlane(m.M14 - m.M12, m.M24 - m.M22, m.M34 - m.M32, m.M44 - m.M42),
+                NormalizedPlane(m.M14 + m.M13, m.M24 + m.M23, m.M34 + m.M33, m.M44 + m.M43),
+                NormalizedPlane(m.M14 - m.M13, m.M24 - m.M23, m.M34 - m.M33, m.M44 - m.M43)}
+    {}
+
+    float Frustum::Distance(int plane, const Vector3F& point) const
+    {
+        const Vector4F& p = Planes[static_cast<std::size_t>(plane)];
+        return p.X * point.X + p.Y * point.Y + p.Z * point.Z + p.W;
+    }
+
+    bool Frustum::Contains(const Vector3F& point) const
+    {
+        for (int plane = 0; plane < PLANE_COUNT; ++plane)
+            if (Distance(plane, point) < 0.0f)
+                return false;
+        return true;
+    }
+
+    bool Frustum::Intersects(const Vector3F& min, const Vector3F& max) const
+    {
+        // The corner farthest along the normal is outside only when the whole box is.
+        for (const Vector4F& p : Planes)
+        {
+            const float x = p.X >= 0.0f ? max.X : min.X;
+            const float y = p.Y >= 0.0f ? max.Y : min.Y;
+            const float z = p.Z >= 0.0f ? max.Z : min.Z;
+            if (p.X * x + p.Y * y + p.Z * z + p.W < 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+} // namespace Voxium::Core
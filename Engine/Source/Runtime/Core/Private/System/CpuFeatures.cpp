@@ -0,0 +1,47 @@
+#include "System/CpuFeatures.h"
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        bool DetectAvx2()
+        {
+#if defined(__AVX2__) && defined(__BMI2__) && defined(__FMA__)
+            return true;
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+
+            // FMA, and the OS saving the YMM registers on a context switch.
+            __cpuid(info, 1);
+            const bool fma     = (info[2] & (1 << 12)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            if (!fma || !osxsave || (_xgetbv(0) & 6) != 6)
+                return false;
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0 && (info[1] & (1 << 8)) != 0;
+#elif defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+            // Also checks that the OS saves the YMM registers.
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("fma");
+#else
+            return false;
+#endif
+        }
+    } // namespace
+
+    bool CpuHasAvx2()
+    {
+        static const bool supported = DetectAvx2();
+        return supported;
+    }
+
+} // namespace Voxium::Core
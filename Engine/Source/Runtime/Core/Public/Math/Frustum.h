@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+
+#include "CoreMacros.h"
+
+#include "Math/Vector4F.h"
+
+namespace Voxium::Core
+{
+
+    struct Vector3F;
+    struct Matrix4F;
+
+    //--------------------------------------------------------------------------------
+    // Frustum: the six planes of a view-projection matrix, for row vectors transformed
+    // as v * M with clip depth in [-w, w], as CreateLookAt() * CreatePerspectiveFieldOfView()
+    // builds it. Each plane is (normal, d) with a unit normal pointing inwards, so a point
+    // p lies inside the plane when dot(normal, p) + d >= 0.
+    //--------------------------------------------------------------------------------
+    struct CORE_API Frustum
+    {
+        enum PlaneIndex : int
+        {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+        };
+
+        static constexpr int PLANE_COUNT = 6;
+
+        std::array<Vector4F, PLANE_COUNT> Planes;
+
+        explicit Frustum(const Matrix4F& viewProjection);
+
+        // Signed distance in world units, positive inside.
+        float Distance(int plane, const Vector3F& point) const;
+
+        bool Contains(const Vector3F& point) const;
+
+        // False only when the box lies entirely outside one of the planes. Conservative: a box
+        // just outside a corner of the frustum can still pass.
+        bool Intersects(const Vector3F& min, const Vector3F& max) const;
+    };
+
+} // namespace Voxium::Core
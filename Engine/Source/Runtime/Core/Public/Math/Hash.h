@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <limits>
 
 namespace Voxium::Core
 {
@@ -18,6 +20,18 @@ namespace Voxium::Core
         }
     }
 
+    // Murmur3 64-bit finalizer: every input bit affects every output bit, so the low bits of the
+    // result are safe to use as a power-of-two table index even for clustered keys.
+    constexpr uint64_t MixBits(uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
     template<typename T>
     inline void HashCombine(std::size_t& seed, const T& value)
     {
@@ -28,7 +42,7 @@ namespace Voxium::Core
     void HashCombine(std::size_t& seed, const T& v, Args... rest)
     {
         HashCombine(seed, v);
-        if constexpr (sizeof...(Args) > 1)
+        if constexpr (sizeof...(Args) > 0)
         {
             HashCombine(seed, rest...);
         }
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+
+#if VOXIUM_BMI2
+#include <immintrin.h>
+#endif
+
+namespace Voxium::Core
+{
+    // Morton (Z-order) codes interleave the bits of three coordinates, x in bit 0, y in bit 1 and
+    // z in bit 2, so every aligned 2^n cube of cells is a contiguous range of codes. Each axis
+    // keeps its low 21 bits: coordinates are taken modulo 2^21 and decode to non-negative values.
+    constexpr int      MORTON_AXIS_BITS = 21;
+    constexpr uint32_t MORTON_AXIS_MASK = (1u << MORTON_AXIS_BITS) - 1;
+    constexpr uint64_t MORTON_X_MASK    = 0x1249249249249249ULL;
+    constexpr uint64_t MORTON_Y_MASK    = MORTON_X_MASK << 1;
+    constexpr uint64_t MORTON_Z_MASK    = MORTON_X_MASK << 2;
+
+    // Moves the low 21 bits of value to every third bit.
+    constexpr uint64_t MortonSpread(uint32_t value)
+    {
+        uint64_t bits = value & MORTON_AXIS_MASK;
+        bits          = (bits | bits << 32) & 0x001F00000000FFFFULL;
+        bits          = (bits | bits << 16) & 0x001F0000FF0000FFULL;
+        bits          = (bits | bits << 8) & 0x100F00F00F00F00FULL;
+        bits          = (bits | bits << 4) & 0x10C30C30C30C30C3ULL;
+        bits          = (bits | bits << 2) & MORTON_X_MASK;
+        return bits;
+    }
+
+    // Inverse of MortonSpread(): gathers every third bit, starting at bit 0.
+    constexpr uint32_t MortonCompact(uint64_t bits)
+    {
+        bits &= MORTON_X_MASK;
+        bits = (bits ^ bits >> 2) & 0x10C30C30C30C30C3ULL;
+        bits = (bits ^ bits >> 4) & 0x100F00F00F00F00FULL;
+        bits = (bits ^ bits >> 8) & 0x001F0000FF0000FFULL;
+        bits = (bits ^ bits >> 16) & 0x001F00000000FFFFULL;
+        bits = (bits ^ bits >> 32) & MORTON_AXIS_MASK;
+        return static_cast<uint32_t>(bits);
+    }
+
+    constexpr uint64_t MortonEncode(int x, int y, int z)
+    {
+        return MortonSpread(static_cast<uint32_t>(x)) | MortonSpread(static_cast<uint32_t>(y)) << 1 | MortonSpread(static_cast<uint32_t>(z)) << 2;
+    }
+
+    constexpr uint64_t MortonEncode(const Int3& position) { return MortonEncode(position.X, position.Y, position.Z); }
+
+    constexpr Int3 MortonDecode(uint64_t code)
+    {
+        return Int3(static_cast<int>(MortonCompact(code)), static_cast<int>(MortonCompact(code >> 1)), static_cast<int>(MortonCompact(code >> 2)));
+    }
+
+    // Same results as MortonEncode() and MortonDecode(), with one pdep or pext per axis where the
+    // target has BMI2. Prefer the constexpr versions on CPUs that microcode these instructions
+    // (AMD before Zen 3).
+    inline uint64_t MortonEncodeFast(int x, int y, int z)
+    {
+#if VOXIUM_BMI2
+        return _pdep_u64(static_cast<uint32_t>(x), MORTON_X_MASK) | _pdep_u64(static_cast<uint32_t>(y), MORTON_Y_MASK) |
+               _pdep_u64(static_cast<uint32_t>(z), MORTON_Z_MASK);
+#else
+        return MortonEncode(x, y, z);
+#endif
+    }
+
+    inline uint64_t MortonEncodeFast(const Int3& position) { return MortonEncodeFast(position.X, position.Y, position.Z); }
+
+    inline Int3 MortonDecodeFast(uint64_t code)
+    {
+#if VOXIUM_BMI2
+        return Int3(static_cast<int>(_pext_u64(code, MORTON_X_MASK)), static_cast<int>(_pext_u64(code, MORTON_Y_MASK)),
+                    static_cast<int>(_pext_u64(code, MORTON_Z_MASK)));
+#else
+        return MortonDecode(code);
+#endif
+    }
+
+    // Adds two codes axis by axis, modulo 2^21 like the coordinates, without decoding them:
+    // MortonAdd(code, MortonEncode(-1, 0, 0)) is the cell before code along x.
+    constexpr uint64_t MortonAdd(uint64_t a, uint64_t b)
+    {
+        const uint64_t x = ((a | ~MORTON_X_MASK) + (b & MORTON_X_MASK)) & MORTON_X_MASK;
+        const uint64_t y = ((a | ~MORTON_Y_MASK) + (b & MORTON_Y_MASK)) & MORTON_Y_MASK;
+        const uint64_t z = ((a | ~MORTON_Z_MASK) + (b & MORTON_Z_MASK)) & MORTON_Z_MASK;
+        return x | y | z;
+    }
+
+} // namespace Voxium::Core
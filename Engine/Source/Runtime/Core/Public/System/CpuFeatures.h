@@ -0,0 +1,13 @@
+#pragma once
+
+#include "CoreMacros.h"
+
+namespace Voxium::Core
+{
+
+    // Whether the processor and the OS support AVX2, BMI2 and FMA, so that VOXIUM_AVX2_TARGET
+    // functions may run. Detected on the first call; always true when the whole build assumes
+    // those instruction sets.
+    CORE_API bool CpuHasAvx2();
+
+} // namespace Voxium::Core
@@ -0,0 +1,105 @@
+#include "Terrain/ColumnFieldCache.h"
+
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace Voxium::Core
+{
+    ColumnFieldCache::ColumnFieldCache(ComputeFunc compute, std::size_t capacityColumns) : compute_(std::move(compute)), capacity_(capacityColumns)
+    {
+        if (!compute_)
+            throw std::invalid_argument("Column field cache needs a compute function");
+    }
+
+    std::shared_ptr<const ColumnFields> ColumnFieldCache::Get(int columnX, int columnZ)
+    {
+        const Int3                                                       column(columnX, 0, columnZ);
+        std::optional<std::promise<std::shared_ptr<const ColumnFields>>> promise;
+        FieldsFuture                                                     cached;
+        uint64_t                                                         ticket = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto                        it = entries_.find(column);
+            if (it != entries_.end())
+            {
+                lru_.splice(lru_.begin(), lru_, it->second);
+                ++stats_.Hits;
+                cached = it->second->Fields;
+            }
+            else
+            {
+                ++stats_.Misses;
+                ticket = nextTicket_++;
+                promise.emplace();
+                lru_.push_front(Entry {column, promise->get_future().share(), ticket});
+                entries_.emplace(column, lru_.begin());
+                ++stats_.ResidentColumns;
+                EvictTo(capacity_);
+            }
+        }
+        // Waits, outside the lock, if another thread is still computing the column.
+        if (cached.valid())
+            return cached.get();
+
+        std::shared_ptr<ColumnFields> fields;
+        try
+        {
+            fields = std::make_shared<ColumnFields>();
+            compute_(columnX, columnZ, *fields);
+        }
+        catch (...)
+        {
+            promise->set_exception(std::current_exception());
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto                        it = entries_.find(column);
+            if (it != entries_.end() && it->second->Ticket == ticket)
+            {
+                lru_.erase(it->second);
+                entries_.erase(it);
+                --stats_.ResidentColumns;
+            }
+            throw;
+        }
+        promise->set_value(fields);
+        return fields;
+    }
+
+    void ColumnFieldCache::SetCapacity(std::size_t capacityColumns)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacityColumns;
+        EvictTo(capacity_);
+    }
+
+    std::size_t ColumnFieldCache::Capacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+    void ColumnFieldCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        EvictTo(0);
+    }
+
+    ColumnFieldCacheStats ColumnFieldCache::Stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    void ColumnFieldCache::EvictTo(std::size_t columns)
+    {
+        while (stats_.ResidentColumns > columns && !lru_.empty())
+        {
+            const Entry& entry = lru_.back();
+            --stats_.ResidentColumns;
+            ++stats_.Evictions;
+            entries_.erase(entry.Column);
+            lru_.pop_back();
+        }
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Core
+{
+    enum class Biome : uint8_t
+    {
+        Ocean,
+        Beach,
+        Plains,
+        Desert,
+        Snow,
+    };
+
+    constexpr int BIOME_COUNT = 5;
+
+    // The 2D fields shared by every chunk of a chunk column, per (x, z) voxel column, x fastest.
+    struct ColumnFields
+    {
+        std::array<float, CHUNK_AREA> Height;
+        std::array<float, CHUNK_AREA> Temperature;
+        std::array<Biome, CHUNK_AREA> Biomes;
+    };
+
+    struct ColumnFieldCacheStats
+    {
+        uint64_t    Hits            = 0;
+        uint64_t    Misses          = 0;
+        uint64_t    Evictions       = 0;
+        std::size_t ResidentColumns = 0;
+
+        double HitRate() const { return Hits + Misses == 0 ? 0.0 : static_cast<double>(Hits) / static_cast<double>(Hits + Misses); }
+    };
+
+    //--------------------------------------------------------------------------------
+    // ColumnFieldCache: least-recently-used cache of the ColumnFields of chunk columns,
+    // bounded by a column count, so the chunks of one column, and neighbours blending
+    // across its edges, evaluate its 2D noise once. Thread-safe; fields are computed
+    // outside the lock. A column being computed is not computed again: lookups of it
+    // wait for the first one and count as hits, which keeps a streamer loading a whole
+    // column on several threads at one miss.
+    //--------------------------------------------------------------------------------
+    class CORE_API ColumnFieldCache
+    {
+    public:
+        // Fills the fields of a chunk column. Runs on the threads calling Get(), so it must be
+        // thread-safe.
+        using ComputeFunc = std::function<void(int columnX, int columnZ, ColumnFields& fields)>;
+
+        // A capacity of 0 caches nothing beyond the columns being computed.
+        ColumnFieldCache(ComputeFunc compute, std::size_t capacityColumns);
+
+        ColumnFieldCache(const ColumnFieldCache&)            = delete;
+        ColumnFieldCache& operator=(const ColumnFieldCache&) = delete;
+
+        // Fields of the chunk column, valid for as long as they are held, even after eviction.
+        // Exceptions from the compute function reach every lookup waiting for it, and nothing is
+        // cached, so the next lookup computes again.
+        std::shared_ptr<const ColumnFields> Get(int columnX, int columnZ);
+
+        // Evicts down to the new capacity right away.
+        void SetCapacity(std::size_t capacityColumns);
+
+        std::size_t Capacity() const;
+
+        void Clear();
+
+        ColumnFieldCacheStats Stats() const;
+
+    private:
+        using FieldsFuture = std::shared_future<std::shared_ptr<const ColumnFields>>;
+
+        struct Entry
+        {
+            Int3         Column; // (x, 0, z)
+            FieldsFuture Fields;
+            uint64_t     Ticket;
+        };
+
+        // Caller holds mutex_.
+        void EvictTo(std::size_t columns);
+
+        const ComputeFunc compute_;
+
+        mutable std::mutex mutex_;
+        std::size_t        capacity_;
+        uint64_t           nextTicket_ = 0;
+
+        // Most recently used first.
+        std::list<Entry>                                                 lru_;
+        std::unordered_map<Int3, std::list<Entry>::iterator, Int3Hasher> entries_;
+
+        ColumnFieldCacheStats stats_;
+    };
+
+} // namespace Voxium::Core
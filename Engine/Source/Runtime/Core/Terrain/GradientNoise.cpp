@@ -0,0 +1,437 @@
+#include "Terrain/GradientNoise.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+#include "Math/Hash.h"
+#include "System/CpuFeatures.h"
+
+#if VOXIUM_AVX2
+#include <immintrin.h>
+#endif
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        // Lattice coordinates are multiplied by these before hashing, so neighbouring points
+        // differ in many bits.
+        constexpr uint32_t PRIME_X         = 0x8da6b343u;
+        constexpr uint32_t PRIME_Y         = 0xd8163841u;
+        constexpr uint32_t PRIME_Z         = 0xcb1ab31fu;
+        constexpr uint32_t HASH_MULTIPLIER = 0x27d4eb2du;
+        constexpr uint32_t OCTAVE_SEED     = 0x9e3779b9u;
+
+        // Largest value of each dimension's sum of gradient dot products, mapped to 1: sqrt(N / 4)
+        // times the gradient length, sqrt(5) in 2D and sqrt(2) in 3D.
+        constexpr float SCALE_2D = 0.6324555f;
+        constexpr float SCALE_3D = 0.8164966f;
+
+        // Crests of ridged octaves count this much against the octaves above them.
+        constexpr float RIDGE_WEIGHT = 2.0f;
+
+        uint32_t Hash(uint32_t seed, uint32_t x, uint32_t y, uint32_t z)
+        {
+            const uint32_t hash = (seed ^ x ^ y ^ z) * HASH_MULTIPLIER;
+            return hash ^ hash >> 15;
+        }
+
+        // The gradient bits are random, so branches on them would mispredict half the time; these
+        // select and negate with bit operations, like the AVX2 code.
+        float Select(bool condition, float whenTrue, float whenFalse)
+        {
+            const uint32_t mask = 0u - static_cast<uint32_t>(condition);
+            return std::bit_cast<float>((std::bit_cast<uint32_t>(whenTrue) & mask) | (std::bit_cast<uint32_t>(whenFalse) & ~mask));
+        }
+
+        float Flip(float value, bool negate) { return std::bit_cast<float>(std::bit_cast<uint32_t>(value) ^ static_cast<uint32_t>(negate) << 31); }
+
+        // One of the eight directions (+-1, +-2) and (+-2, +-1).
+        float Gradient(uint32_t hash, float x, float y)
+        {
+            const bool  swap = (hash & 4) != 0;
+            const float u    = Select(swap, y, x);
+            const float v    = Select(swap, x, y);
+            return Flip(u, hash & 1) + 2.0f * Flip(v, hash & 2);
+        }
+
+        // One of the twelve cube edge directions, four of them twice, as in improved Perlin noise.
+        float Gradient(uint32_t hash, float x, float y, float z)
+        {
+            const uint32_t h = hash & 15;
+            const float    u = Select(h < 8, x, y);
+            const float    v = Select(h < 4, y, Select((h & 13) == 12, x, z));
+            return Flip(u, h & 1) + Flip(v, h & 2);
+        }
+
+        float Fade(float t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+
+        float Lerp(float a, float b, float t) { return a + t * (b - a); }
+
+        float Perlin(uint32_t seed, float x, float y)
+        {
+            const float    floorX = std::floor(x);
+            const float    floorY = std::floor(y);
+            const float    fx     = x - floorX;
+            const float    fy     = y - floorY;
+            const uint32_t x0     = static_cast<uint32_t>(static_cast<int32_t>(floorX)) * PRIME_X;
+            const uint32_t y0     = static_cast<uint32_t>(static_cast<int32_t>(floorY)) * PRIME_Y;
+            const uint32_t x1     = x0 + PRIME_X;
+            const uint32_t y1     = y0 + PRIME_Y;
+
+            const float n00 = Gradient(Hash(seed, x0, y0, 0), fx, fy);
+            const float n10 = Gradient(Hash(seed, x1, y0, 0), fx - 1.0f, fy);
+            const float n01 = Gradient(Hash(seed, x0, y1, 0), fx, fy - 1.0f);
+            const float n11 = Gradient(Hash(seed, x1, y1, 0), fx - 1.0f, fy - 1.0f);
+            const float u   = Fade(fx);
+            return SCALE_2D * Lerp(Lerp(n00, n10, u), Lerp(n01, n11, u), Fade(fy));
+        }
+
+        float Perlin(uint32_t seed, float x, float y, float z)
+        {
+            const float    floorX = std::floor(x);
+            const float    floorY = std::floor(y);
+            const float    floorZ = std::floor(z);
+            const float    fx     = x - floorX;
+            const float    fy     = y - floorY;
+            const float    fz     = z - floorZ;
+            const uint32_t x0     = static_cast<uint32_t>(static_cast<int32_t>(floorX)) * PRIME_X;
+            const uint32_t y0     = static_cast<uint32_t>(static_cast<int32_t>(floorY)) * PRIME_Y;
+            const uint32_t z0     = static_cast<uint32_t>(static_cast<int32_t>(floorZ)) * PRIME_Z;
+            const uint32_t x1     = x0 + PRIME_X;
+            const uint32_t y1     = y0 + PRIME_Y;
+            const uint32_t z1     = z0 + PRIME_Z;
+
+            const float u   = Fade(fx);
+            const float n00 = Lerp(Gradient(Hash(seed, x0, y0, z0), fx, fy, fz), Gradient(Hash(seed, x1, y0, z0), fx - 1.0f, fy, fz), u);
+            const float n10 = Lerp(Gradient(Hash(seed, x0, y1, z0), fx, fy - 1.0f, fz), Gradient(Hash(seed, x1, y1, z0), fx - 1.0f, fy - 1.0f, fz), u);
+            const float n01 = Lerp(Gradient(Hash(seed, x0, y0, z1), fx, fy, fz - 1.0f), Gradient(Hash(seed, x1, y0, z1), fx - 1.0f, fy, fz - 1.0f), u);
+            const float n11 = Lerp(Gradient(Hash(seed, x0, y1, z1), fx, fy - 1.0f, fz - 1.0f),
+                                   Gradient(Hash(seed, x1, y1, z1), fx - 1.0f, fy - 1.0f, fz - 1.0f), u);
+            const float v   = Fade(fy);
+            return SCALE_3D * Lerp(Lerp(n00, n10, v), Lerp(n01, n11, v), Fade(fz));
+        }
+
+        // Amplitude of the first octave such that the amplitudes sum to 1.
+        float FirstAmplitude(const FractalSettings& settings)
+        {
+            if (settings.Octaves < 1)
+                throw std::invalid_argument("Fractal noise needs at least one octave");
+            float sum       = 0.0f;
+            float amplitude = 1.0f;
+            for (int octave = 0; octave < settings.Octaves; ++octave, amplitude *= settings.Gain)
+                sum += amplitude;
+            return 1.0f / sum;
+        }
+
+        // Evaluates the octaves of one sample; sample(seed, frequency) returns the noise of an octave.
+        template<typename SampleFn>
+        float Octaves(const FractalSettings& settings, uint32_t seed, SampleFn sample)
+        {
+            float sum       = 0.0f;
+            float amplitude = FirstAmplitude(settings);
+            float frequency = settings.Frequency;
+            float weight    = 1.0f;
+            for (int octave = 0; octave < settings.Octaves; ++octave)
+            {
+                const float noise = sample(seed + static_cast<uint32_t>(octave) * OCTAVE_SEED, frequency);
+                if (settings.Type == FractalType::Ridged)
+                {
+                    float ridge = 1.0f - std::fabs(noise);
+                    ridge       = ridge * ridge * weight;
+                    weight      = std::clamp(ridge * RIDGE_WEIGHT, 0.0f, 1.0f);
+                    sum += ridge * amplitude;
+                }
+                else
+                {
+                    sum += noise * amplitude;
+                }
+                amplitude *= settings.Gain;
+                frequency *= settings.Lacunarity;
+            }
+            return sum;
+        }
+
+        void CheckSizes(std::size_t out, std::size_t x, std::size_t y, std::size_t z)
+        {
+            if (x != out || y != out || z != out)
+                throw std::invalid_argument("Noise coordinate and output arrays differ in size");
+        }
+
+#if VOXIUM_AVX2
+        struct Lattice8
+        {
+            __m256i Hash0; // lattice coordinate below the sample times the axis prime
+            __m256  Fraction;
+        };
+
+        VOXIUM_AVX2_TARGET Lattice8 Split8(__m256 value, uint32_t prime)
+        {
+            const __m256 floor = _mm256_floor_ps(value);
+            return {_mm256_mullo_epi32(_mm256_cvttps_epi32(floor), _mm256_set1_epi32(static_cast<int>(prime))), _mm256_sub_ps(value, floor)};
+        }
+
+        VOXIUM_AVX2_TARGET __m256i Hash8(__m256i seed, __m256i x, __m256i y, __m256i z)
+        {
+            const __m256i hash = _mm256_mullo_epi32(_mm256_xor_si256(_mm256_xor_si256(seed, x), _mm256_xor_si256(y, z)),
+                                                    _mm256_set1_epi32(static_cast<int>(HASH_MULTIPLIER)));
+            return _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 15));
+        }
+
+        // Negates the lanes whose hash has the bit set, by moving it into the sign bit.
+        template<int BIT>
+        VOXIUM_AVX2_TARGET __m256 Flip8(__m256 value, __m256i hash)
+        {
+            const __m256i sign = _mm256_slli_epi32(_mm256_and_si256(hash, _mm256_set1_epi32(1 << BIT)), 31 - BIT);
+            return _mm256_xor_ps(value, _mm256_castsi256_ps(sign));
+        }
+
+        VOXIUM_AVX2_TARGET __m256 Select8(__m256i mask, __m256 whenSet, __m256 whenClear)
+        {
+            return _mm256_blendv_ps(whenClear, whenSet, _mm256_castsi256_ps(mask));
+        }
+
+        VOXIUM_AVX2_TARGET __m256 Gradient8(__m256i hash, __m256 x, __m256 y)
+        {
+            const __m256i swap = _mm256_cmpeq_epi32(_mm256_and_si256(hash, _mm256_set1_epi32(4)), _mm256_set1_epi32(4));
+            const __m256  u    = Select8(swap, y, x);
+            const __m256  v    = Select8(swap, x, y);
+            return _mm256_add_ps(Flip8<0>(u, hash), _mm256_mul_ps(_mm256_set1_ps(2.0f), Flip8<1>(v, hash)));
+        }
+
+        VOXIUM_AVX2_TARGET __m256 Gradient8(__m256i hash, __m256 x, __m256 y, __m256 z)
+        {
+            const __m256i h      = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+            const __m256i below8 = _mm256_cmpgt_epi32(_mm256_set1_epi32(8), h);
+            const __m256i below4 = _mm256_cmpgt_epi32(_mm256_set1_epi32(4), h);
+            const __m256i edge12 = _mm256_cmpeq_epi32(_mm256_and_si256(h, _mm256_set1_epi32(13)), _mm256_set1_epi32(12));
+            const __m256  u      = Select8(below8, x, y);
+            const __m256  v      = Select8(below4, y, Select8(edge12, x, z));
+            return _mm256_add_ps(Flip8<0>(u, h), Flip8<1>(v, h));
+        }
+
+        VOXIUM_AVX2_TARGET __m256 Fade8(__m256 t)
+        {
+            const __m256 inner = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))),
+                                               _mm256_set1_ps(10.0f));
+            return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+        }
+
+        VOXIUM_AVX2_TARGET __m256 Lerp8(__m256 a, __m256 b, __m256 t) { return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a))); }
+
+        VOXIUM_AVX2_TARGET __m256 Perlin8(__m256i seed, __m256 x, __m256 y)
+        {
+            const Lattice8 lx   = Split8(x, PRIME_X);
+            const Lattice8 ly   = Split8(y, PRIME_Y);
+            const __m256i  x1   = _mm256_add_epi32(lx.Hash0, _mm256_set1_epi32(static_cast<int>(PRIME_X)));
+            const __m256i  y1   = _mm256_add_epi32(ly.Hash0, _mm256_set1_epi32(static_cast<int>(PRIME_Y)));
+            const __m256i  zero = _mm256_setzero_si256();
+            const __m256   one  = _mm256_set1_ps(1.0f);
+            const __m256   fx1  = _mm256_sub_ps(lx.Fraction, one);
+            const __m256   fy1  = _mm256_sub_ps(ly.Fraction, one);
+
+            const __m256 n00 = Gradient8(Hash8(seed, lx.Hash0, ly.Hash0, zero), lx.Fraction, ly.Fraction);
+            const __m256 n10 = Gradient8(Hash8(seed, x1, ly.Hash0, zero), fx1, ly.Fraction);
+            const __m256 n01 = Gradient8(Hash8(seed, lx.Hash0, y1, zero), lx.Fraction, fy1);
+            const __m256 n11 = Gradient8(Hash8(seed, x1, y1, zero), fx1, fy1);
+            const __m256 u   = Fade8(lx.Fraction);
+            return _mm256_mul_ps(_mm256_set1_ps(SCALE_2D), Lerp8(Lerp8(n00, n10, u), Lerp8(n01, n11, u), Fade8(ly.Fraction)));
+        }
+
+        VOXIUM_AVX2_TARGET __m256 Perlin8(__m256i seed, __m256 x, __m256 y, __m256 z)
+        {
+            const Lattice8 lx  = Split8(x, PRIME_X);
+            const Lattice8 ly  = Split8(y, PRIME_Y);
+            const Lattice8 lz  = Split8(z, PRIME_Z);
+            const __m256i  x1  = _mm256_add_epi32(lx.Hash0, _mm256_set1_epi32(static_cast<int>(PRIME_X)));
+            const __m256i  y1  = _mm256_add_epi32(ly.Hash0, _mm256_set1_epi32(static_cast<int>(PRIME_Y)));
+            const __m256i  z1  = _mm256_add_epi32(lz.Hash0, _mm256_set1_epi32(static_cast<int>(PRIME_Z)));
+            const __m256   one = _mm256_set1_ps(1.0f);
+            const __m256   fx0 = lx.Fraction;
+            const __m256   fy0 = ly.Fraction;
+            const __m256   fz0 = lz.Fraction;
+            const __m256   fx1 = _mm256_sub_ps(fx0, one);
+            const __m256   fy1 = _mm256_sub_ps(fy0, one);
+            const __m256   fz1 = _mm256_sub_ps(fz0, one);
+
+            const __m256 u   = Fade8(fx0);
+            const __m256 n00 = Lerp8(Gradient8(Hash8(seed, lx.Hash0, ly.Hash0, lz.Hash0), fx0, fy0, fz0),
+                                     Gradient8(Hash8(seed, x1, ly.Hash0, lz.Hash0), fx1, fy0, fz0),
+                                     u);
+            const __m256 n10 = Lerp8(Gradient8(Hash8(seed, lx.Hash0, y1, lz.Hash0), fx0, fy1, fz0), Gradient8(Hash8(seed, x1, y1, lz.Hash0), fx1, fy1, fz0), u);
+            const __m256 n01 = Lerp8(Gradient8(Hash8(seed, lx.Hash0, ly.Hash0, z1), fx0, fy0, fz1), Gradient8(Hash8(seed, x1, ly.Hash0, z1), fx1, fy0, fz1), u);
+            const __m256 n11 = Lerp8(Gradient8(Hash8(seed, lx.Hash0, y1, z1), fx0, fy1, fz1), Gradient8(Hash8(seed, x1, y1, z1), fx1, fy1, fz1), u);
+            const __m256 v   = Fade8(fy0);
+            return _mm256_mul_ps(_mm256_set1_ps(SCALE_3D), Lerp8(Lerp8(n00, n10, v), Lerp8(n01, n11, v), Fade8(fz0)));
+        }
+
+        // Octaves() for eight samples; sample(seed, frequency) returns the noise of an octave.
+        template<typename SampleFn>
+        VOXIUM_AVX2_TARGET __m256 Octaves8(const FractalSettings& settings, float firstAmplitude, uint32_t seed, SampleFn sample)
+        {
+            const __m256 one       = _mm256_set1_ps(1.0f);
+            const __m256 signMask  = _mm256_set1_ps(-0.0f);
+            __m256       sum       = _mm256_setzero_ps();
+            __m256       weight    = one;
+            float        amplitude = firstAmplitude;
+            float        frequency = settings.Frequency;
+            for (int octave = 0; octave < settings.Octaves; ++octave)
+            {
+                const __m256i octaveSeed = _mm256_set1_epi32(static_cast<int>(seed + static_cast<uint32_t>(octave) * OCTAVE_SEED));
+                const __m256  noise      = sample(octaveSeed, _mm256_set1_ps(frequency));
+                if (settings.Type == FractalType::Ridged)
+                {
+                    __m256 ridge = _mm256_sub_ps(one, _mm256_andnot_ps(signMask, noise));
+                    ridge        = _mm256_mul_ps(_mm256_mul_ps(ridge, ridge), weight);
+                    weight       = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(ridge, _mm256_set1_ps(RIDGE_WEIGHT)), _mm256_setzero_ps()), one);
+                    sum          = _mm256_add_ps(sum, _mm256_mul_ps(ridge, _mm256_set1_ps(amplitude)));
+                }
+                else
+                {
+                    sum = _mm256_add_ps(sum, _mm256_mul_ps(noise, _mm256_set1_ps(amplitude)));
+                }
+                amplitude *= settings.Gain;
+                frequency *= settings.Lacunarity;
+            }
+            return sum;
+        }
+
+        // Runs kernel(x, y, z) over groups of eight samples; the last group is padded, so every
+        // sample goes through the same code. z is null for 2D noise.
+        template<typename Kernel>
+        VOXIUM_AVX2_TARGET void ForEachGroup(const float* x, const float* y, const float* z, float* out, std::size_t count, Kernel kernel)
+        {
+            std::size_t i = 0;
+            for (; i + GradientNoise::BATCH <= count; i += GradientNoise::BATCH)
+            {
+                const __m256 zi = z != nullptr ? _mm256_loadu_ps(z + i) : _mm256_setzero_ps();
+                _mm256_storeu_ps(out + i, kernel(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), zi));
+            }
+            if (i == count)
+                return;
+
+            alignas(32) float tailX[GradientNoise::BATCH] = {};
+            alignas(32) float tailY[GradientNoise::BATCH] = {};
+            alignas(32) float tailZ[GradientNoise::BATCH] = {};
+            alignas(32) float tailOut[GradientNoise::BATCH];
+            const std::size_t rest = count - i;
+            std::copy_n(x + i, rest, tailX);
+            std::copy_n(y + i, rest, tailY);
+            if (z != nullptr)
+                std::copy_n(z + i, rest, tailZ);
+            _mm256_store_ps(tailOut, kernel(_mm256_load_ps(tailX), _mm256_load_ps(tailY), _mm256_load_ps(tailZ)));
+            std::copy_n(tailOut, rest, out + i);
+        }
+
+        // The span overloads, eight samples at a time.
+        VOXIUM_AVX2_TARGET void SampleGroups(uint32_t seed, const float* x, const float* y, float* out, std::size_t count)
+        {
+            const __m256i seed8 = _mm256_set1_epi32(static_cast<int>(seed));
+            ForEachGroup(x, y, nullptr, out, count, [&](__m256 px, __m256 py, __m256) VOXIUM_AVX2_TARGET { return Perlin8(seed8, px, py); });
+        }
+
+        VOXIUM_AVX2_TARGET void SampleGroups(uint32_t seed, const float* x, const float* y, const float* z, float* out, std::size_t count)
+        {
+            const __m256i seed8 = _mm256_set1_epi32(static_cast<int>(seed));
+            ForEachGroup(x, y, z, out, count, [&](__m256 px, __m256 py, __m256 pz) VOXIUM_AVX2_TARGET { return Perlin8(seed8, px, py, pz); });
+        }
+
+        VOXIUM_AVX2_TARGET void FractalGroups(const FractalSettings& settings, uint32_t seed, const float* x, const float* y, float* out, std::size_t count)
+        {
+            const float firstAmplitude = FirstAmplitude(settings);
+            ForEachGroup(x, y, nullptr, out, count, [&](__m256 px, __m256 py, __m256) VOXIUM_AVX2_TARGET {
+                return Octaves8(settings, firstAmplitude, seed, [&](__m256i octaveSeed, __m256 frequency) VOXIUM_AVX2_TARGET {
+                    return Perlin8(octaveSeed, _mm256_mul_ps(px, frequency), _mm256_mul_ps(py, frequency));
+                });
+            });
+        }
+
+        VOXIUM_AVX2_TARGET void FractalGroups(const FractalSettings& settings, uint32_t seed, const float* x, const float* y, const float* z, float* out,
+                                              std::size_t count)
+        {
+            const float firstAmplitude = FirstAmplitude(settings);
+            ForEachGroup(x, y, z, out, count, [&](__m256 px, __m256 py, __m256 pz) VOXIUM_AVX2_TARGET {
+                return Octaves8(settings, firstAmplitude, seed, [&](__m256i octaveSeed, __m256 frequency) VOXIUM_AVX2_TARGET {
+                    return Perlin8(octaveSeed, _mm256_mul_ps(px, frequency), _mm256_mul_ps(py, frequency), _mm256_mul_ps(pz, frequency));
+                });
+            });
+        }
+#endif
+    } // namespace
+
+    GradientNoise::GradientNoise(uint64_t seed) : seed_(static_cast<uint32_t>(MixBits(seed))) {}
+
+    float GradientNoise::Sample(float x, float y) const { return Perlin(seed_, x, y); }
+
+    float GradientNoise::Sample(float x, float y, float z) const { return Perlin(seed_, x, y, z); }
+
+    float GradientNoise::Fractal(const FractalSettings& settings, float x, float y) const
+    {
+        return Octaves(settings, seed_, [&](uint32_t seed, float frequency) { return Perlin(seed, x * frequency, y * frequency); });
+    }
+
+    float GradientNoise::Fractal(const FractalSettings& settings, float x, float y, float z) const
+    {
+        return Octaves(settings, seed_, [&](uint32_t seed, float frequency) { return Perlin(seed, x * frequency, y * frequency, z * frequency); });
+    }
+
+    void GradientNoise::Sample(std::span<const float> x, std::span<const float> y, std::span<float> out) const
+    {
+        CheckSizes(out.size(), x.size(), y.size(), out.size());
+#if VOXIUM_AVX2
+        if (CpuHasAvx2())
+        {
+            SampleGroups(seed_, x.data(), y.data(), out.data(), out.size());
+            return;
+        }
+#endif
+        for (std::size_t i = 0; i < out.size(); ++i)
+            out[i] = Perlin(seed_, x[i], y[i]);
+    }
+
+    void GradientNoise::Sample(std::span<const float> x, std::span<const float> y, std::span<const float> z, std::span<float> out) const
+    {
+        CheckSizes(out.size(), x.size(), y.size(), z.size());
+#if VOXIUM_AVX2
+        if (CpuHasAvx2())
+        {
+            SampleGroups(seed_, x.data(), y.data(), z.data(), out.data(), out.size());
+            return;
+        }
+#endif
+        for (std::size_t i = 0; i < out.size(); ++i)
+            out[i] = Perlin(seed_, x[i], y[i], z[i]);
+    }
+
+    void GradientNoise::Fractal(const FractalSettings& settings, std::span<const float> x, std::span<const float> y, std::span<float> out) const
+    {
+        CheckSizes(out.size(), x.size(), y.size(), out.size());
+#if VOXIUM_AVX2
+        if (CpuHasAvx2())
+        {
+            FractalGroups(settings, seed_, x.data(), y.data(), out.data(), out.size());
+            return;
+        }
+#endif
+        for (std::size_t i = 0; i < out.size(); ++i)
+            out[i] = Fractal(settings, x[i], y[i]);
+    }
+
+    void GradientNoise::Fractal(const FractalSettings& settings, std::span<const float> x, std::span<const float> y, std::span<const float> z,
+                                std::span<float> out) const
+    {
+        CheckSizes(out.size(), x.size(), y.size(), z.size());
+#if VOXIUM_AVX2
+        if (CpuHasAvx2())
+        {
+            FractalGroups(settings, seed_, x.data(), y.data(), z.data(), out.data(), out.size());
+            return;
+        }
+#endif
+        for (std::size_t i = 0; i < out.size(); ++i)
+            out[i] = Fractal(settings, x[i], y[i], z[i]);
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "CoreMacros.h"
+
+namespace Voxium::Core
+{
+    enum class FractalType : uint8_t
+    {
+        // Sum of octaves, each at double the frequency and half the amplitude of the last.
+        Fbm,
+        // Octaves folded at zero into sharp crests, each weighted by the crest below it, as in
+        // mountain ranges; in [0, 1] instead of [-1, 1].
+        Ridged,
+    };
+
+    struct FractalSettings
+    {
+        FractalType Type       = FractalType::Fbm;
+        int         Octaves    = 4;
+        float       Frequency  = 1.0f / 256.0f; // of the first octave, per voxel
+        float       Lacunarity = 2.0f;
+        float       Gain       = 0.5f;
+    };
+
+    //--------------------------------------------------------------------------------
+    // GradientNoise: seeded Perlin gradient noise in two and three dimensions, and its
+    // fractal sums. The gradient of a lattice point comes from an integer hash of its
+    // coordinates and the seed instead of a permutation table, so eight samples at a
+    // time run in AVX2 registers without gathers; the span overloads evaluate whole
+    // arrays that way on processors with AVX2 and fall back to the scalar code on
+    // others. Values are within [-1, 1].
+    //
+    // The span overloads also evaluate partial groups of eight, so a sample does not
+    // depend on where it sits in the array. The single-sample overloads may differ from
+    // them in the last bits where the compiler fuses multiplies and adds; generators
+    // should use one or the other for a given field. Everything is const and thread-safe.
+    //--------------------------------------------------------------------------------
+    class CORE_API GradientNoise
+    {
+    public:
+        // Samples handled per AVX2 step.
+        static constexpr int BATCH = 8;
+
+        explicit GradientNoise(uint64_t seed = 0);
+
+        uint32_t Seed() const { return seed_; }
+
+        float Sample(float x, float y) const;
+
+        float Sample(float x, float y, float z) const;
+
+        float Fractal(const FractalSettings& settings, float x, float y) const;
+
+        float Fractal(const FractalSettings& settings, float x, float y, float z) const;
+
+        // out[i] = Sample(x[i], y[i]). Throws std::invalid_argument if the sizes differ.
+        void Sample(std::span<const float> x, std::span<const float> y, std::span<float> out) const;
+
+        void Sample(std::span<const float> x, std::span<const float> y, std::span<const float> z, std::span<float> out) const;
+
+        // out[i] = Fractal(settings, x[i], y[i]), with the octave loop kept in registers.
+        void Fractal(const FractalSettings& settings, std::span<const float> x, std::span<const float> y, std::span<float> out) const;
+
+        void Fractal(const FractalSettings& settings, std::span<const float> x, std::span<const float> y, std::span<const float> z,
+                     std::span<float> out) const;
+
+    private:
+        uint32_t seed_;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,319 @@
+#include "Terrain/TerrainGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "Math/Hash.h"
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        // Samples of the 3D fields along each axis of a chunk, both faces included.
+        constexpr int LATTICE_SIZE   = CHUNK_SIZE / TerrainGenerator::DENSITY_STEP + 1;
+        constexpr int LATTICE_VOLUME = LATTICE_SIZE * LATTICE_SIZE * LATTICE_SIZE;
+
+        // Mountains fade in over the first quarter of the positive continent noise.
+        constexpr float MOUNTAIN_FADE = 4.0f;
+
+        // Chunks generated per round of GenerateRegion(), bounding the chunks held outside the map.
+        constexpr std::size_t REGION_BATCH = 256;
+
+        enum NoiseLayer : uint64_t
+        {
+            CONTINENT_LAYER,
+            MOUNTAIN_LAYER,
+            WARP_X_LAYER,
+            WARP_Z_LAYER,
+            OVERHANG_LAYER,
+            CAVE_LAYER,
+            TEMPERATURE_LAYER,
+        };
+
+        uint64_t LayerSeed(uint64_t seed, NoiseLayer layer) { return MixBits(seed) + layer; }
+
+        // Lattice samples are x fastest, then z, then y, like the voxels of a chunk.
+        constexpr std::size_t LatticeIndex(int x, int y, int z) { return static_cast<std::size_t>(x + (z + y * LATTICE_SIZE) * LATTICE_SIZE); }
+
+        // Rows of width samples, x fastest.
+        constexpr std::size_t RowIndex(int x, int z, int width) { return static_cast<std::size_t>(x + z * width); }
+
+        // Trilinear interpolation of a lattice field over the voxels of layer y, which may be CHUNK_SIZE.
+        void InterpolateLayer(const std::array<float, LATTICE_VOLUME>& lattice, int y, std::array<float, CHUNK_AREA>& layer)
+        {
+            constexpr float STEP_SCALE = 1.0f / TerrainGenerator::DENSITY_STEP;
+
+            const int   below = std::min(y / TerrainGenerator::DENSITY_STEP, LATTICE_SIZE - 2);
+            const float ty    = static_cast<float>(y - below * TerrainGenerator::DENSITY_STEP) * STEP_SCALE;
+
+            std::array<float, LATTICE_SIZE * LATTICE_SIZE> plane;
+            for (int z = 0; z < LATTICE_SIZE; ++z)
+                for (int x = 0; x < LATTICE_SIZE; ++x)
+                {
+                    const float low                     = lattice[LatticeIndex(x, below, z)];
+                    plane[RowIndex(x, z, LATTICE_SIZE)] = low + ty * (lattice[LatticeIndex(x, below + 1, z)] - low);
+                }
+
+            std::array<float, LATTICE_SIZE * CHUNK_SIZE> rows;
+            for (int z = 0; z < LATTICE_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                {
+                    const int   cell                 = x / TerrainGenerator::DENSITY_STEP;
+                    const float tx                   = static_cast<float>(x - cell * TerrainGenerator::DENSITY_STEP) * STEP_SCALE;
+                    const float low                  = plane[RowIndex(cell, z, LATTICE_SIZE)];
+                    rows[RowIndex(x, z, CHUNK_SIZE)] = low + tx * (plane[RowIndex(cell + 1, z, LATTICE_SIZE)] - low);
+                }
+
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                const int   cell = z / TerrainGenerator::DENSITY_STEP;
+                const float tz   = static_cast<float>(z - cell * TerrainGenerator::DENSITY_STEP) * STEP_SCALE;
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                {
+                    const float low                   = rows[RowIndex(x, cell, CHUNK_SIZE)];
+                    layer[RowIndex(x, z, CHUNK_SIZE)] = low + tz * (rows[RowIndex(x, cell + 1, CHUNK_SIZE)] - low);
+                }
+            }
+        }
+    } // namespace
+
+    TerrainGenerator::TerrainGenerator(const TerrainSettings& settings) :
+        settings_(settings), continents_(LayerSeed(settings.Seed, CONTINENT_LAYER)), mountains_(LayerSeed(settings.Seed, MOUNTAIN_LAYER)),
+        warpX_(LayerSeed(settings.Seed, WARP_X_LAYER)), warpZ_(LayerSeed(settings.Seed, WARP_Z_LAYER)),
+        overhangs_(LayerSeed(settings.Seed, OVERHANG_LAYER)), caves_(LayerSeed(settings.Seed, CAVE_LAYER)),
+        temperature_(LayerSeed(settings.Seed, TEMPERATURE_LAYER)),
+        columns_([this](int columnX, int columnZ, ColumnFields& fields) { ComputeColumn(columnX, columnZ, fields); }, settings.ColumnCacheCapacity)
+    {
+        if (settings.WarpDistance < 0.0f || settings.OverhangDepth < 0.0f || settings.CaveWidth < 0.0f || settings.CaveRoof < 0.0f ||
+            settings.SoilDepth < 0)
+            throw std::invalid_argument("Terrain distances and depths must not be negative");
+
+        topKinds_  = {settings.Sand, settings.Sand, settings.Grass, settings.Sand, settings.Snow};
+        soilKinds_ = {settings.Sand, settings.Sand, settings.Dirt, settings.Sand, settings.Dirt};
+    }
+
+    void TerrainGenerator::ComputeColumn(int columnX, int columnZ, ColumnFields& fields) const
+    {
+        std::array<float, CHUNK_AREA> x;
+        std::array<float, CHUNK_AREA> z;
+        for (int i = 0; i < CHUNK_AREA; ++i)
+        {
+            x[static_cast<std::size_t>(i)] = static_cast<float>((columnX << CHUNK_SHIFT) + (i & CHUNK_MASK));
+            z[static_cast<std::size_t>(i)] = static_cast<float>((columnZ << CHUNK_SHIFT) + (i >> CHUNK_SHIFT));
+        }
+
+        // Heights, read at the warped position.
+        std::array<float, CHUNK_AREA> warpX;
+        std::array<float, CHUNK_AREA> warpZ;
+        std::array<float, CHUNK_AREA> mountains;
+        warpX_.Fractal(settings_.Warp, x, z, warpX);
+        warpZ_.Fractal(settings_.Warp, x, z, warpZ);
+        for (std::size_t i = 0; i < CHUNK_AREA; ++i)
+        {
+            warpX[i] = x[i] + settings_.WarpDistance * warpX[i];
+            warpZ[i] = z[i] + settings_.WarpDistance * warpZ[i];
+        }
+        std::array<float, CHUNK_AREA>& heights = fields.Height;
+        continents_.Fractal(settings_.Continents, warpX, warpZ, heights);
+        mountains_.Fractal(settings_.Mountains, warpX, warpZ, mountains);
+        for (std::size_t i = 0; i < CHUNK_AREA; ++i)
+        {
+            const float inland = std::clamp(heights[i] * MOUNTAIN_FADE, 0.0f, 1.0f);
+            heights[i]         = settings_.BaseHeight + settings_.ContinentHeight * heights[i] + settings_.MountainHeight * inland * mountains[i];
+        }
+
+        // Temperature and biome.
+        temperature_.Fractal(settings_.Temperature, x, z, fields.Temperature);
+        const float seaLevel = static_cast<float>(settings_.SeaLevel);
+        const float beach    = static_cast<float>(settings_.SeaLevel + settings_.BeachHeight);
+        for (std::size_t i = 0; i < CHUNK_AREA; ++i)
+        {
+            const float height      = heights[i];
+            const float temperature = fields.Temperature[i] - settings_.TemperatureLapse * std::max(0.0f, height - seaLevel);
+            fields.Temperature[i]   = temperature;
+            if (height <= seaLevel)
+                fields.Biomes[i] = Biome::Ocean;
+            else if (height <= beach)
+                fields.Biomes[i] = Biome::Beach;
+            else if (temperature >= settings_.DesertTemperature)
+                fields.Biomes[i] = Biome::Desert;
+            else if (temperature <= settings_.SnowTemperature)
+                fields.Biomes[i] = Biome::Snow;
+            else
+                fields.Biomes[i] = Biome::Plains;
+        }
+    }
+
+    float TerrainGenerator::SurfaceHeight(int x, int z) const
+    {
+        return Fields(x >> CHUNK_SHIFT, z >> CHUNK_SHIFT)->Height[(x & CHUNK_MASK) | (z & CHUNK_MASK) << CHUNK_SHIFT];
+    }
+
+    void TerrainGenerator::Generate(const Int3& chunkPos, VoxelChunk& chunk) const
+    {
+        const int   originX   = chunkPos.X << CHUNK_SHIFT;
+        const int   originY   = chunkPos.Y << CHUNK_SHIFT;
+        const int   originZ   = chunkPos.Z << CHUNK_SHIFT;
+        const int   top       = originY + CHUNK_MASK;
+        const float bottomY   = static_cast<float>(originY);
+        const float topY      = static_cast<float>(top);
+        const float soilDepth = static_cast<float>(settings_.SoilDepth);
+
+        // Heightmap pass, shared by the chunk column.
+        const std::shared_ptr<const ColumnFields> fields  = Fields(chunkPos.X, chunkPos.Z);
+        const std::array<float, CHUNK_AREA>&      heights = fields->Height;
+
+        const auto [lowest, highest] = std::minmax_element(heights.begin(), heights.end());
+        const float overhang         = settings_.OverhangDepth;
+        const bool  caves            = settings_.CaveWidth > 0.0f && bottomY <= *highest - settings_.CaveRoof;
+        if (bottomY >= *highest + overhang && originY > settings_.SeaLevel)
+        {
+            chunk = VoxelChunk(AIR_KIND);
+            return;
+        }
+        if (!caves && topY < *lowest - overhang - soilDepth)
+        {
+            chunk = VoxelChunk(settings_.Stone);
+            return;
+        }
+
+        // Density pass: the 3D fields on the lattice, only where they can matter.
+        std::array<float, LATTICE_VOLUME> overhangLattice;
+        std::array<float, LATTICE_VOLUME> caveLattice;
+        const bool                        overhangs = overhang > 0.0f && bottomY <= *highest + overhang && topY + 1.0f >= *lowest - overhang;
+        if (overhangs || caves)
+        {
+            std::array<float, LATTICE_VOLUME> latticeX;
+            std::array<float, LATTICE_VOLUME> latticeY;
+            std::array<float, LATTICE_VOLUME> latticeZ;
+            for (int y = 0; y < LATTICE_SIZE; ++y)
+                for (int z = 0; z < LATTICE_SIZE; ++z)
+                    for (int x = 0; x < LATTICE_SIZE; ++x)
+                    {
+                        const std::size_t index = LatticeIndex(x, y, z);
+                        latticeX[index] = static_cast<float>(originX + x * DENSITY_STEP);
+                        latticeY[index] = static_cast<float>(originY + y * DENSITY_STEP);
+                        latticeZ[index] = static_cast<float>(originZ + z * DENSITY_STEP);
+                    }
+            if (overhangs)
+                overhangs_.Fractal(settings_.Overhangs, latticeX, latticeY, latticeZ, overhangLattice);
+            if (caves)
+                caves_.Fractal(settings_.Caves, latticeX, latticeY, latticeZ, caveLattice);
+        }
+
+        // Layers from the one above the chunk down; depth counts the solid voxels since the last
+        // air of each column, which picks grass, soil or stone.
+        std::vector<BlockKind>        kinds(CHUNK_VOLUME);
+        std::array<int, CHUNK_AREA>   depth;
+        std::array<float, CHUNK_AREA> overhangLayer;
+        std::array<float, CHUNK_AREA> caveLayer;
+        for (int ly = CHUNK_SIZE; ly >= 0; --ly)
+        {
+            const int   y      = originY + ly;
+            const float layerY = static_cast<float>(y);
+            BlockKind*  row    = ly < CHUNK_SIZE ? kinds.data() + ly * CHUNK_AREA : nullptr;
+
+            // Layers above every surface, or deep below every one without caves, are a single kind.
+            if (layerY > *highest + overhang)
+            {
+                if (row != nullptr)
+                    std::fill_n(row, CHUNK_AREA, y <= settings_.SeaLevel ? settings_.Water : AIR_KIND);
+                depth.fill(0);
+                continue;
+            }
+            if (!caves && layerY < *lowest - overhang - soilDepth)
+            {
+                std::fill_n(row, CHUNK_AREA, settings_.Stone);
+                continue;
+            }
+
+            if (overhangs)
+                InterpolateLayer(overhangLattice, ly, overhangLayer);
+            if (caves)
+                InterpolateLayer(caveLattice, ly, caveLayer);
+            for (std::size_t i = 0; i < CHUNK_AREA; ++i)
+            {
+                const float height  = heights[i];
+                float       density = height - layerY;
+                if (overhangs)
+                    density += overhang * overhangLayer[i];
+                bool solid = density > 0.0f;
+                if (solid && caves && layerY <= height - settings_.CaveRoof)
+                    solid = std::fabs(caveLayer[i]) >= settings_.CaveWidth;
+
+                if (row == nullptr)
+                {
+                    // Columns buried above the chunk start as deep as the surface is above them.
+                    depth[i] = solid ? std::max(1, static_cast<int>(height) - y + 1) : 0;
+                    continue;
+                }
+
+                if (!solid)
+                {
+                    depth[i] = 0;
+                    row[i]   = y <= settings_.SeaLevel && layerY > height - settings_.CaveRoof ? settings_.Water : AIR_KIND;
+                    continue;
+                }
+
+                const int below = ++depth[i];
+                if (layerY < height - overhang - soilDepth || below > settings_.SoilDepth)
+                    row[i] = settings_.Stone;
+                else
+                    row[i] = (below == 1 ? topKinds_ : soilKinds_)[static_cast<int>(fields->Biomes[i])];
+            }
+        }
+
+        chunk = VoxelChunk::FromKinds(std::span<const BlockKind, CHUNK_VOLUME>(kinds.data(), CHUNK_VOLUME));
+    }
+
+    std::size_t TerrainGenerator::GenerateRegion(ChunkedVoxelMap& map, const Int3& minChunk, const Int3& maxChunk, ThreadPool& pool) const
+    {
+        const int minX = std::max(minChunk.X, 0);
+        const int minY = std::max(minChunk.Y, 0);
+        const int minZ = std::max(minChunk.Z, 0);
+        const int maxX = std::min(maxChunk.X, ((map.SizeX() + CHUNK_MASK) >> CHUNK_SHIFT) - 1);
+        const int maxY = std::min(maxChunk.Y, ((map.SizeY() + CHUNK_MASK) >> CHUNK_SHIFT) - 1);
+        const int maxZ = std::min(maxChunk.Z, ((map.SizeZ() + CHUNK_MASK) >> CHUNK_SHIFT) - 1);
+        if (minX > maxX || minY > maxY || minZ > maxZ)
+            return 0;
+
+        std::vector<Int3> positions;
+        for (int y = minY; y <= maxY; ++y)
+            for (int z = minZ; z <= maxZ; ++z)
+                for (int x = minX; x <= maxX; ++x)
+                    positions.emplace_back(x, y, z);
+
+        std::size_t             stored = 0;
+        std::vector<VoxelChunk> chunks(std::min(REGION_BATCH, positions.size()));
+        for (std::size_t first = 0; first < positions.size(); first += REGION_BATCH)
+        {
+            const std::size_t count = std::min(REGION_BATCH, positions.size() - first);
+            pool.ParallelFor(count, [&](std::size_t i) { Generate(positions[first + i], chunks[i]); });
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (chunks[i].IsEmpty())
+                {
+                    map.RemoveChunk(positions[first + i]);
+                    continue;
+                }
+                map.GetOrCreateChunk(positions[first + i]) = std::move(chunks[i]);
+                ++stored;
+            }
+        }
+        return stored;
+    }
+
+    ChunkLoader TerrainGenerator::Loader(ChunkLoader stored) const
+    {
+        return [this, stored = std::move(stored)](const Int3& chunkPos, VoxelChunk& chunk) {
+            if (stored && stored(chunkPos, chunk))
+                return true;
+            Generate(chunkPos, chunk);
+            return !chunk.IsEmpty();
+        };
+    }
+
+} // namespace Voxium::Core
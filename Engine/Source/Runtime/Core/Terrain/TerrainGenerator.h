@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Terrain/ColumnFieldCache.h"
+#include "Terrain/GradientNoise.h"
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkStreamer.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Core
+{
+    struct TerrainSettings
+    {
+        uint64_t Seed = 0;
+
+        // Surface height, in voxels, where the continent noise is zero.
+        float BaseHeight = 64.0f;
+
+        // Low plains and seas: the continent noise moves the surface this far up and down.
+        FractalSettings Continents {FractalType::Fbm, 5, 1.0f / 512.0f, 2.0f, 0.5f};
+        float           ContinentHeight = 40.0f;
+
+        // Ridged mountains rise up to this high above the surface, only where the continent noise
+        // is above zero.
+        FractalSettings Mountains {FractalType::Ridged, 5, 1.0f / 384.0f, 2.0f, 0.5f};
+        float           MountainHeight = 96.0f;
+
+        // Both height fields are read at a position moved by up to this many voxels along a pair
+        // of noise fields, which bends coasts and ridges out of their lattice directions.
+        FractalSettings Warp {FractalType::Fbm, 3, 1.0f / 256.0f, 2.0f, 0.5f};
+        float           WarpDistance = 48.0f;
+
+        // 3D noise added to the height difference: overhangs and arches within this many voxels of
+        // the surface.
+        FractalSettings Overhangs {FractalType::Fbm, 3, 1.0f / 48.0f, 2.0f, 0.5f};
+        float           OverhangDepth = 8.0f;
+
+        // Caves are carved where the absolute cave noise is below CaveWidth, from CaveRoof voxels
+        // under the surface down. A width of 0 disables them.
+        FractalSettings Caves {FractalType::Fbm, 2, 1.0f / 64.0f, 2.0f, 0.5f};
+        float           CaveWidth = 0.015f;
+        float           CaveRoof  = 6.0f;
+
+        // Air at or below this height that is above the surface is water.
+        int SeaLevel = 60;
+
+        // Voxels within this many of the surface are soil, under the biome's top kind.
+        int SoilDepth = 4;
+
+        // Biomes: columns under the sea are ocean, up to BeachHeight above it beach, and the rest
+        // desert, plains or snow by temperature. The temperature noise drops by TemperatureLapse
+        // per voxel of height above the sea.
+        int             BeachHeight = 2;
+        FractalSettings Temperature {FractalType::Fbm, 3, 1.0f / 1024.0f, 2.0f, 0.5f};
+        float           TemperatureLapse  = 1.0f / 160.0f;
+        float           DesertTemperature = 0.25f;
+        float           SnowTemperature   = -0.25f;
+
+        // Chunk columns whose 2D fields stay cached; the chunks of a column share them.
+        std::size_t ColumnCacheCapacity = 1024;
+
+        BlockKind Stone = 1;
+        BlockKind Dirt  = 2;
+        BlockKind Grass = 3;
+        BlockKind Sand  = 4;
+        BlockKind Water = 5;
+        BlockKind Snow  = 6;
+    };
+
+    //--------------------------------------------------------------------------------
+    // TerrainGenerator: fills chunks from layered gradient noise in two passes. The
+    // heightmap pass evaluates the domain-warped continent and ridged mountain noise
+    // and the temperature for the 32 x 32 columns of a chunk column, eight columns at a
+    // time, and keeps them in a ColumnFieldCache for the other chunks of the column; the
+    // density pass adds 3D overhang noise to the height difference and carves caves. Chunks entirely
+    // above the highest surface and the sea, or entirely below the lowest overhang with
+    // caves disabled, skip the 3D pass. The 3D fields are sampled every DENSITY_STEP
+    // voxels and interpolated, since they vary slowly compared with a voxel.
+    //
+    // Every noise layer gets its own seed, derived from the world seed, and a chunk
+    // depends only on the seed and its position: the same world comes out whatever the
+    // order or thread of generation. Generate() is const and thread-safe, so the
+    // generator can serve as the loader of a ChunkStreamer or run over a region on a
+    // thread pool.
+    //--------------------------------------------------------------------------------
+    class CORE_API TerrainGenerator
+    {
+    public:
+        // Spacing, in voxels, of the samples of the 3D fields.
+        static constexpr int DENSITY_STEP = 4;
+
+        explicit TerrainGenerator(const TerrainSettings& settings = {});
+
+        TerrainGenerator(const TerrainGenerator&)            = delete;
+        TerrainGenerator& operator=(const TerrainGenerator&) = delete;
+
+        // Replaces chunk with the generated chunk at chunkPos.
+        void Generate(const Int3& chunkPos, VoxelChunk& chunk) const;
+
+        // 2D fields of a chunk column, through the cache.
+        std::shared_ptr<const ColumnFields> Fields(int columnX, int columnZ) const { return columns_.Get(columnX, columnZ); }
+
+        // Surface height of the column at world (x, z), before overhangs and caves.
+        float SurfaceHeight(int x, int z) const;
+
+        ColumnFieldCacheStats CacheStats() const { return columns_.Stats(); }
+
+        // Generates the chunks of the inclusive chunk box on the pool, clipped to the map, and moves
+        // the ones that are not all air into the map, replacing what is there. Returns the number
+        // of chunks stored.
+        std::size_t GenerateRegion(ChunkedVoxelMap& map, const Int3& minChunk, const Int3& maxChunk, ThreadPool& pool) const;
+
+        // Streamer loader that generates every chunk the stored loader does not have, so stored
+        // edits win and new land appears at the edge of what was saved. The generator must outlive
+        // the streamer.
+        ChunkLoader Loader(ChunkLoader stored = {}) const;
+
+        const TerrainSettings& Settings() const { return settings_; }
+
+    private:
+        void ComputeColumn(int columnX, int columnZ, ColumnFields& fields) const;
+
+        TerrainSettings                    settings_;
+        std::array<BlockKind, BIOME_COUNT> topKinds_;  // per Biome
+        std::array<BlockKind, BIOME_COUNT> soilKinds_; // per Biome
+        GradientNoise                      continents_;
+        GradientNoise                      mountains_;
+        GradientNoise                      warpX_;
+        GradientNoise                      warpZ_;
+        GradientNoise                      overhangs_;
+        GradientNoise                      caves_;
+        GradientNoise                      temperature_;
+        mutable ColumnFieldCache           columns_;
+    };
+
+} // namespace Voxium::Core
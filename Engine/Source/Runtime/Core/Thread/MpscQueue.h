@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+#include "CoreMacros.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // MpscQueue: unbounded lock-free FIFO for many producers and one consumer.
+    // Push() is wait-free apart from the node allocation: it swaps the head and links
+    // the previous node. A consumer can briefly see the queue as empty while a push
+    // is between those two steps; the item shows up on a later TryPop().
+    //--------------------------------------------------------------------------------
+    template<typename T>
+    class MpscQueue
+    {
+    public:
+        MpscQueue() : head_(new Node()), tail_(head_.load(std::memory_order_relaxed)) {}
+
+        ~MpscQueue()
+        {
+            while (tail_ != nullptr)
+            {
+                Node* next = tail_->Next.load(std::memory_order_relaxed);
+                delete tail_;
+                tail_ = next;
+            }
+        }
+
+        MpscQueue(const MpscQueue&)            = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Safe to call from any number of threads.
+        void Push(T item)
+        {
+            Node* node = new Node();
+            node->Item.emplace(std::move(item));
+            Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+            previous->Next.store(node, std::memory_order_release);
+        }
+
+        // Only one thread may pop at a time.
+        std::optional<T> TryPop()
+        {
+            Node* next = tail_->Next.load(std::memory_order_acquire);
+            if (next == nullptr)
+                return std::nullopt;
+
+            // next becomes the new stub; its item moves out and the old stub is freed.
+            std::optional<T> item = std::move(next->Item);
+            next->Item.reset();
+            delete tail_;
+            tail_ = next;
+            return item;
+        }
+
+        // Consumer-side check; may miss a push that is still in progress.
+        bool Empty() const { return tail_->Next.load(std::memory_order_acquire) == nullptr; }
+
+    private:
+        struct Node
+        {
+            std::atomic<Node*> Next {nullptr};
+            std::optional<T>   Item;
+        };
+
+        // Producers swap head_; the consumer owns tail_, the stub whose successor is the front.
+        alignas(VOXIUM_CACHE_LINE) std::atomic<Node*> head_;
+        alignas(VOXIUM_CACHE_LINE) Node* tail_;
+    };
+
+} // namespace Voxium::Core
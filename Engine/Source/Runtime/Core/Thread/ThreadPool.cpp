@@ -0,0 +1,139 @@
+#include "Thread/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace Voxium::Core
+{
+    ThreadPool::ThreadPool(unsigned threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers_.reserve(threadCount);
+        for (unsigned i = 0; i < threadCount; ++i)
+        {
+            workers_.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        taskAvailable_.notify_all();
+        for (std::thread& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        taskAvailable_.notify_one();
+    }
+
+    void ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& func)
+    {
+        if (count == 0)
+            return;
+
+        // Shared with the helper tasks, which may still be queued after the loop finished
+        // (the calling thread can drain every iteration on its own). Such late helpers find
+        // no work left and never touch func.
+        struct SharedState
+        {
+            const std::function<void(std::size_t)>* func;
+            std::size_t                              count;
+            std::atomic<std::size_t>                 next {0};
+            std::atomic<std::size_t>                 completed {0};
+            std::atomic<bool>                        failed {false};
+            std::exception_ptr                       error;
+            std::mutex                               mutex;
+            std::condition_variable                  done;
+        };
+        auto state   = std::make_shared<SharedState>();
+        state->func  = &func;
+        state->count = count;
+
+        auto drain = [](SharedState& s) {
+            for (std::size_t i = s.next.fetch_add(1); i < s.count; i = s.next.fetch_add(1))
+            {
+                if (!s.failed)
+                {
+                    try
+                    {
+                        (*s.func)(i);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard lock(s.mutex);
+                        if (!s.error)
+                            s.error = std::current_exception();
+                        s.failed = true;
+                    }
+                }
+                if (s.completed.fetch_add(1) + 1 == s.count)
+                {
+                    std::lock_guard lock(s.mutex);
+                    s.done.notify_all();
+                }
+            }
+        };
+
+        const std::size_t helpers = std::min<std::size_t>(workers_.size(), count - 1);
+        for (std::size_t h = 0; h < helpers; ++h)
+        {
+            Submit([state, drain] { drain(*state); });
+        }
+
+        drain(*state);
+
+        std::unique_lock lock(state->mutex);
+        state->done.wait(lock, [&state] { return state->completed == state->count; });
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+
+    void ThreadPool::WaitIdle()
+    {
+        std::unique_lock lock(mutex_);
+        idle_.wait(lock, [this] { return tasks_.empty() && running_ == 0; });
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                taskAvailable_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty())
+                    return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+                ++running_;
+            }
+
+            task();
+
+            {
+                std::lock_guard lock(mutex_);
+                --running_;
+                if (tasks_.empty() && running_ == 0)
+                    idle_.notify_all();
+            }
+        }
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CoreMacros.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // ThreadPool: fixed set of worker threads draining a FIFO task queue.
+    // Tasks submitted with Submit() must not throw; ParallelFor() forwards the first
+    // exception thrown by its body to the caller.
+    //--------------------------------------------------------------------------------
+    class CORE_API ThreadPool
+    {
+    public:
+        // A thread count of 0 uses std::thread::hardware_concurrency().
+        explicit ThreadPool(unsigned threadCount = 0);
+
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void Submit(std::function<void()> task);
+
+        // Runs func(i) for every i in [0, count) on the workers and the calling thread,
+        // and returns once all iterations finished.
+        void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& func);
+
+        // Blocks until the queue is empty and no task is running.
+        void WaitIdle();
+
+        unsigned ThreadCount() const { return static_cast<unsigned>(workers_.size()); }
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread>          workers_;
+        std::deque<std::function<void()>> tasks_;
+        std::mutex                        mutex_;
+        std::condition_variable           taskAvailable_;
+        std::condition_variable           idle_;
+        std::size_t                       running_  = 0;
+        bool                              stopping_ = false;
+    };
+
+} // namespace Voxium::Core
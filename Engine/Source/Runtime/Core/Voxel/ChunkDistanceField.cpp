@@ -0,0 +1,451 @@
+#include "Voxel/ChunkDistanceField.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Thread/MpscQueue.h"
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr int MARGIN = ChunkDistanceField::MAX_DISTANCE;
+        constexpr int PADDED = CHUNK_SIZE + 2 * MARGIN;
+        constexpr int ROW    = PADDED;
+        constexpr int LAYER  = PADDED * PADDED;
+
+        // Squared distance of voxels with nothing solid on their line; beyond any real one in the box.
+        constexpr int FAR = 1 << 20;
+
+        constexpr int MAX_SQUARED = ChunkDistanceField::MAX_DISTANCE * ChunkDistanceField::MAX_DISTANCE;
+
+        // Steps for the squared distances within MAX_DISTANCE, rounded down.
+        const std::array<uint8_t, MAX_SQUARED> STEPS = [] {
+            std::array<uint8_t, MAX_SQUARED> steps {};
+            for (std::size_t squared = 0; squared < MAX_SQUARED; ++squared)
+                steps[squared] = static_cast<uint8_t>(std::sqrt(static_cast<float>(squared)) * ChunkDistanceField::STEPS_PER_VOXEL);
+            return steps;
+        }();
+
+        // Half the diagonal of a voxel: how far a point can be from its voxel's centre.
+        constexpr float HALF_DIAGONAL = 0.8660254f;
+
+        // Squared distances over the chunk and its margin, x fastest, then z, then y, and the
+        // lower envelope of one line.
+        struct Scratch
+        {
+            std::vector<int32_t>          Field = std::vector<int32_t>(PADDED * LAYER);
+            int32_t                       Sites[PADDED];
+            int32_t                       Values[PADDED];
+            float                         Bounds[PADDED];
+            ChunkDistanceField::Distances Result;
+        };
+
+        constexpr std::size_t NeighbourSlot(int dx, int dy, int dz) { return static_cast<std::size_t>((dx + 1) + (dz + 1) * 3 + (dy + 1) * 9); }
+
+        Scratch& LocalScratch()
+        {
+            thread_local Scratch scratch;
+            return scratch;
+        }
+
+        // Replaces f(q) along a line by min over p of (q - p)^2 + f(p): the squared distance to the
+        // nearest solid voxel, given that of the voxels of the line along the earlier axes. Only
+        // parabolas of finite f enter the envelope. Returns false, leaving the line, when it has none.
+        bool TransformLine(int32_t* line, int stride, Scratch& scratch)
+        {
+            int32_t* sites  = scratch.Sites;
+            int32_t* values = scratch.Values;
+            float*   bounds = scratch.Bounds;
+            int      top    = -1;
+            for (int q = 0; q < PADDED; ++q)
+            {
+                const int32_t value = line[q * stride];
+                if (value >= FAR)
+                    continue;
+                float start = -std::numeric_limits<float>::infinity();
+                while (top >= 0)
+                {
+                    const int p = sites[top];
+                    start       = static_cast<float>(value + q * q - values[top] - p * p) / static_cast<float>(2 * (q - p));
+                    if (start > bounds[top])
+                        break;
+                    --top;
+                    start = -std::numeric_limits<float>::infinity();
+                }
+                ++top;
+                sites[top]  = q;
+                values[top] = value;
+                bounds[top] = start;
+            }
+            if (top < 0)
+                return false;
+
+            int current = 0;
+            for (int q = 0; q < PADDED; ++q)
+            {
+                while (current < top && bounds[current + 1] <= static_cast<float>(q))
+                    ++current;
+                const int offset = q - sites[current];
+                line[q * stride] = std::min(offset * offset + values[current], FAR);
+            }
+            return true;
+        }
+
+        void ForEach(ThreadPool* pool, std::size_t count, const std::function<void(std::size_t)>& func)
+        {
+            if (pool != nullptr && count > 1)
+                pool->ParallelFor(count, func);
+            else
+                for (std::size_t i = 0; i < count; ++i)
+                    func(i);
+        }
+    } // namespace
+
+    struct ChunkDistanceField::Shared
+    {
+        struct Finished
+        {
+            Int3                             ChunkPos;
+            uint64_t                         Dispatch;
+            FieldKind                        Kind;
+            std::shared_ptr<const Distances> Field; // Mixed fields only
+        };
+
+        MpscQueue<Finished>      Results;
+        std::atomic<std::size_t> InFlight {0};
+    };
+
+    ChunkDistanceField::ChunkDistanceField(const ChunkedVoxelMap& map) : map_(map), shared_(std::make_shared<Shared>())
+    {
+        auto solid = std::make_shared<Distances>();
+        solid->fill(0);
+        solid_ = std::move(solid);
+    }
+
+    ChunkDistanceField::~ChunkDistanceField() = default;
+
+    void ChunkDistanceField::Rebuild() { RebuildAll(nullptr); }
+
+    void ChunkDistanceField::Rebuild(ThreadPool& pool) { RebuildAll(&pool); }
+
+    void ChunkDistanceField::RebuildAll(ThreadPool* pool)
+    {
+        fields_.clear();
+        dirty_.clear();
+        jobs_.clear();
+        map_.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk& chunk) {
+            if (!chunk.IsEmpty())
+                MarkDirty(ChunkBoundsMin(chunkPos), ChunkBoundsMin(chunkPos) + Int3(CHUNK_MASK, CHUNK_MASK, CHUNK_MASK));
+        });
+        Refresh(pool);
+    }
+
+    void ChunkDistanceField::OnBlockChanged(int x, int y, int z)
+    {
+        if (map_.OutOfBounds(x, y, z))
+            throw std::out_of_range("ChunkDistanceField::OnBlockChanged: voxel outside the map");
+        MarkDirty(Int3(x, y, z), Int3(x, y, z));
+    }
+
+    void ChunkDistanceField::OnBoxChanged(const Int3& origin, const Int3& size)
+    {
+        if (size.X > 0 && size.Y > 0 && size.Z > 0)
+            MarkDirty(origin, origin + size - Int3(1, 1, 1));
+    }
+
+    void ChunkDistanceField::OnChunkChanged(const Int3& chunkPos)
+    {
+        MarkDirty(ChunkBoundsMin(chunkPos), ChunkBoundsMin(chunkPos) + Int3(CHUNK_MASK, CHUNK_MASK, CHUNK_MASK));
+    }
+
+    void ChunkDistanceField::MarkDirty(const Int3& min, const Int3& max)
+    {
+        const Int3 first = ChunkOf(std::max(min.X - MARGIN, 0), std::max(min.Y - MARGIN, 0), std::max(min.Z - MARGIN, 0));
+        const Int3 last  = ChunkOf(std::min(max.X + MARGIN, map_.SizeX() - 1), std::min(max.Y + MARGIN, map_.SizeY() - 1),
+                                   std::min(max.Z + MARGIN, map_.SizeZ() - 1));
+        for (int cy = first.Y; cy <= last.Y; ++cy)
+            for (int cz = first.Z; cz <= last.Z; ++cz)
+                for (int cx = first.X; cx <= last.X; ++cx)
+                    dirty_.insert(Int3(cx, cy, cz));
+    }
+
+    std::size_t ChunkDistanceField::Update() { return Refresh(nullptr); }
+
+    std::size_t ChunkDistanceField::Update(ThreadPool& pool) { return Refresh(&pool); }
+
+    std::size_t ChunkDistanceField::Refresh(ThreadPool* pool)
+    {
+        const std::vector<Int3> dirty(dirty_.begin(), dirty_.end());
+        dirty_.clear();
+
+        // Only fields with something in them are copied out of the workers' scratch.
+        std::vector<FieldKind>                        kinds(dirty.size());
+        std::vector<std::shared_ptr<const Distances>> fields(dirty.size());
+        ForEach(pool, dirty.size(), [&](std::size_t i) {
+            Scratch& scratch = LocalScratch();
+            kinds[i]         = Compute(NeighbourhoodOf(dirty[i]), scratch.Result);
+            if (kinds[i] == FieldKind::Mixed)
+                fields[i] = std::make_shared<const Distances>(scratch.Result);
+        });
+        for (std::size_t i = 0; i < dirty.size(); ++i)
+        {
+            jobs_.erase(dirty[i]);
+            Install(dirty[i], kinds[i], std::move(fields[i]));
+        }
+        return dirty.size();
+    }
+
+    std::size_t ChunkDistanceField::Dispatch(ThreadPool& pool)
+    {
+        if (dirty_.empty())
+            return 0;
+
+        // Jobs read copy-on-write snapshots, so the map can be edited again right away; each chunk
+        // is snapshotted once however many marked neighbourhoods include it.
+        const uint64_t                                                          dispatch = ++dispatches_;
+        std::unordered_map<Int3, std::shared_ptr<const VoxelChunk>, Int3Hasher> snapshots;
+        auto snapshotOf = [&](const Int3& chunkPos) -> const std::shared_ptr<const VoxelChunk>& {
+            auto [it, inserted] = snapshots.try_emplace(chunkPos);
+            if (inserted)
+                it->second = map_.Snapshot(chunkPos);
+            return it->second;
+        };
+
+        for (const Int3& chunkPos : dirty_)
+        {
+            std::array<std::shared_ptr<const VoxelChunk>, std::tuple_size_v<Neighbourhood>> chunks;
+            for (int dy = -1; dy <= 1; ++dy)
+                for (int dz = -1; dz <= 1; ++dz)
+                    for (int dx = -1; dx <= 1; ++dx)
+                        chunks[NeighbourSlot(dx, dy, dz)] = snapshotOf(chunkPos + Int3(dx, dy, dz));
+
+            jobs_[chunkPos] = dispatch;
+            shared_->InFlight.fetch_add(1, std::memory_order_relaxed);
+            pool.Submit([shared = shared_, chunkPos, dispatch, chunks = std::move(chunks)] {
+                Neighbourhood neighbourhood;
+                for (std::size_t slot = 0; slot < chunks.size(); ++slot)
+                    neighbourhood[slot] = chunks[slot].get();
+
+                Scratch&        scratch = LocalScratch();
+                const FieldKind kind    = Compute(neighbourhood, scratch.Result);
+                shared->Results.Push({chunkPos, dispatch, kind, kind == FieldKind::Mixed ? std::make_shared<const Distances>(scratch.Result) : nullptr});
+                shared->InFlight.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        const std::size_t started = dirty_.size();
+        dirty_.clear();
+        return started;
+    }
+
+    std::size_t ChunkDistanceField::Publish()
+    {
+        std::size_t published = 0;
+        while (std::optional<Shared::Finished> finished = shared_->Results.TryPop())
+        {
+            const auto job = jobs_.find(finished->ChunkPos);
+            if (job == jobs_.end() || job->second != finished->Dispatch)
+                continue;
+            jobs_.erase(job);
+            Install(finished->ChunkPos, finished->Kind, std::move(finished->Field));
+            ++published;
+        }
+        return published;
+    }
+
+    std::size_t ChunkDistanceField::JobsInFlight() const { return shared_->InFlight.load(std::memory_order_acquire); }
+
+    ChunkDistanceField::Neighbourhood ChunkDistanceField::NeighbourhoodOf(const Int3& chunkPos) const
+    {
+        Neighbourhood chunks;
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dz = -1; dz <= 1; ++dz)
+                for (int dx = -1; dx <= 1; ++dx)
+                    chunks[NeighbourSlot(dx, dy, dz)] = map_.GetChunk(chunkPos + Int3(dx, dy, dz));
+        return chunks;
+    }
+
+    void ChunkDistanceField::Install(const Int3& chunkPos, FieldKind kind, std::shared_ptr<const Distances> field)
+    {
+        if (kind == FieldKind::Empty)
+            fields_.erase(chunkPos);
+        else
+            fields_[chunkPos] = kind == FieldKind::Solid ? solid_ : std::move(field);
+    }
+
+    ChunkDistanceField::FieldKind ChunkDistanceField::Compute(const Neighbourhood& chunks, Distances& distances)
+    {
+        const VoxelChunk* centre = chunks[NeighbourSlot(0, 0, 0)];
+        if (centre != nullptr && centre->IsFull())
+            return FieldKind::Solid;
+
+        // Solid voxels of the chunk and of the neighbours' sides within the margin; bricks without
+        // any are skipped eight voxels at a time.
+        Scratch&              scratch = LocalScratch();
+        std::vector<int32_t>& field   = scratch.Field;
+        std::fill(field.begin(), field.end(), FAR);
+        bool              any = false;
+        std::vector<bool> solid;
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dz = -1; dz <= 1; ++dz)
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    const VoxelChunk* chunk = chunks[NeighbourSlot(dx, dy, dz)];
+                    if (chunk == nullptr || chunk->IsEmpty())
+                        continue;
+                    const std::vector<BlockKind>& palette = chunk->Palette();
+                    solid.assign(palette.size(), false);
+                    for (std::size_t i = 0; i < palette.size(); ++i)
+                        solid[i] = palette[i] != AIR_KIND;
+
+                    const uint64_t occupied = chunk->OccupiedBricks();
+                    const uint64_t full     = chunk->FullBricks();
+                    auto           begin    = [](int d) { return d < 0 ? CHUNK_SIZE - MARGIN : 0; };
+                    auto           end      = [](int d) { return d > 0 ? MARGIN : CHUNK_SIZE; };
+                    for (int y = begin(dy); y < end(dy); ++y)
+                        for (int z = begin(dz); z < end(dz); ++z)
+                        {
+                            int32_t* row =
+                                field.data() + (y + dy * CHUNK_SIZE + MARGIN) * LAYER + (z + dz * CHUNK_SIZE + MARGIN) * ROW + dx * CHUNK_SIZE + MARGIN;
+                            for (int x = begin(dx); x < end(dx); ++x)
+                            {
+                                const int brick = VoxelChunk::BrickIndex(x, y, z);
+                                if ((occupied >> brick & 1) == 0)
+                                {
+                                    x |= VoxelChunk::BRICK_SIZE - 1;
+                                    continue;
+                                }
+                                if ((full >> brick & 1) != 0 || solid[chunk->PaletteIndex(ChunkIndex(x, y, z))])
+                                {
+                                    row[x] = 0;
+                                    any    = true;
+                                }
+                            }
+                        }
+                }
+        if (!any)
+            return FieldKind::Empty;
+
+        // Along x everywhere, along z for the columns over the chunk, along y for the chunk itself.
+        for (int y = 0; y < PADDED; ++y)
+            for (int z = 0; z < PADDED; ++z)
+                TransformLine(field.data() + y * LAYER + z * ROW, 1, scratch);
+        for (int y = 0; y < PADDED; ++y)
+            for (int x = MARGIN; x < MARGIN + CHUNK_SIZE; ++x)
+                TransformLine(field.data() + y * LAYER + x, ROW, scratch);
+        bool reached = false;
+        for (int z = MARGIN; z < MARGIN + CHUNK_SIZE; ++z)
+            for (int x = MARGIN; x < MARGIN + CHUNK_SIZE; ++x)
+            {
+                int32_t* column = field.data() + z * ROW + x;
+                if (!TransformLine(column, LAYER, scratch))
+                {
+                    for (int y = 0; y < CHUNK_SIZE; ++y)
+                        distances[static_cast<std::size_t>(ChunkIndex(x - MARGIN, y, z - MARGIN))] = MAX_DISTANCE * STEPS_PER_VOXEL;
+                    continue;
+                }
+                for (int y = 0; y < CHUNK_SIZE; ++y)
+                {
+                    const int32_t squared = column[(y + MARGIN) * LAYER];
+                    reached |= squared < MAX_SQUARED;
+                    distances[static_cast<std::size_t>(ChunkIndex(x - MARGIN, y, z - MARGIN))] =
+                        squared < MAX_SQUARED ? STEPS[static_cast<std::size_t>(squared)] : MAX_DISTANCE * STEPS_PER_VOXEL;
+                }
+            }
+        return reached ? FieldKind::Mixed : FieldKind::Empty;
+    }
+
+    const ChunkDistanceField::Distances* ChunkDistanceField::Get(const Int3& chunkPos) const
+    {
+        const auto it = fields_.find(chunkPos);
+        return it != fields_.end() ? it->second.get() : nullptr;
+    }
+
+    float ChunkDistanceField::Distance(int x, int y, int z) const
+    {
+        if (map_.OutOfBounds(x, y, z))
+            return static_cast<float>(MAX_DISTANCE);
+        const Distances* distances = Get(ChunkOf(x, y, z));
+        if (distances == nullptr)
+            return static_cast<float>(MAX_DISTANCE);
+        return static_cast<float>((*distances)[static_cast<std::size_t>(ChunkIndex(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK))]) / STEPS_PER_VOXEL;
+    }
+
+    float ChunkDistanceField::Clearance(const Vector3F& point) const
+    {
+        // Outside the map only the distance to it is known; inside, the nearest solid centre is at
+        // least the voxel's distance minus how far the point is from its voxel's centre.
+        const float size[3]  = {static_cast<float>(map_.SizeX()), static_cast<float>(map_.SizeY()), static_cast<float>(map_.SizeZ())};
+        const float coord[3] = {point.X, point.Y, point.Z};
+        float       outside  = 0.0f;
+        int         voxel[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float gap = std::max(-coord[axis], coord[axis] - size[axis]);
+            if (gap > 0.0f)
+                outside += gap * gap;
+            voxel[axis] = std::clamp(static_cast<int>(std::floor(coord[axis])), 0, static_cast<int>(size[axis]) - 1);
+        }
+        if (outside > 0.0f)
+            return std::sqrt(outside);
+
+        const Vector3F offset = point - Vector3F(static_cast<float>(voxel[0]) + 0.5f, static_cast<float>(voxel[1]) + 0.5f, static_cast<float>(voxel[2]) + 0.5f);
+        return std::max(Distance(voxel[0], voxel[1], voxel[2]) - offset.Magnitude() - HALF_DIAGONAL, 0.0f);
+    }
+
+    float ChunkDistanceField::SphereTrace(const Vector3F& origin, const Vector3F& direction, float maxDistance) const
+    {
+        const float length = direction.Magnitude();
+        if (length == 0.0f || maxDistance <= 0.0f)
+            return std::max(maxDistance, 0.0f);
+        const Vector3F unit = direction / length;
+
+        // The ray crosses the map box once at most, and nothing outside it is solid.
+        const float origins[3] = {origin.X, origin.Y, origin.Z};
+        const float steps[3]   = {unit.X, unit.Y, unit.Z};
+        const float size[3]    = {static_cast<float>(map_.SizeX()), static_cast<float>(map_.SizeY()), static_cast<float>(map_.SizeZ())};
+        float       enter      = 0.0f;
+        float       exit       = maxDistance;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if (steps[axis] == 0.0f)
+            {
+                if (origins[axis] < 0.0f || origins[axis] > size[axis])
+                    return maxDistance;
+                continue;
+            }
+            const float low  = -origins[axis] / steps[axis];
+            const float high = (size[axis] - origins[axis]) / steps[axis];
+            enter            = std::max(enter, std::min(low, high));
+            exit             = std::min(exit, std::max(low, high));
+        }
+        if (enter >= exit)
+            return maxDistance;
+
+        for (float travelled = enter; travelled < exit;)
+        {
+            const float clearance = Clearance(origin + unit * travelled);
+            if (clearance < 0.5f)
+                return travelled;
+            travelled += clearance;
+        }
+        return maxDistance;
+    }
+
+    std::size_t ChunkDistanceField::MemoryUsage() const
+    {
+        std::size_t bytes = sizeof(Distances);
+        for (const auto& [chunkPos, distances] : fields_)
+            bytes += sizeof(chunkPos) + sizeof(distances) + (distances != solid_ ? sizeof(Distances) : 0);
+        return bytes;
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Math/Vector3F.h"
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // ChunkDistanceField: for every voxel of a ChunkedVoxelMap, the Euclidean distance
+    // from its centre to the centre of the nearest non-air voxel, up to MAX_DISTANCE, in
+    // 1/16 voxel steps. Each chunk is computed with the separable exact transform of
+    // Felzenszwalb and Huttenlocher: three passes of 1D lower envelopes of parabolas along
+    // x, z and y over the chunk plus MAX_DISTANCE voxels of its neighbours, skipping the
+    // lines that hold no solid voxel. Chunks with nothing solid within reach store nothing
+    // and full chunks share one field of zeros.
+    //
+    // Edits mark the chunks within MAX_DISTANCE of them. Update() recomputes the marked
+    // chunks and waits for them; Dispatch() instead starts a pool job per marked chunk on
+    // copy-on-write snapshots of it and its neighbours and returns at once, and Publish()
+    // installs the fields that have finished. Until then queries see the previous field
+    // of the chunk. A ChunkMeshPipeline given the field forwards its edits and dirty marks
+    // and calls Publish() and Dispatch() in its own Dispatch(); without one, the code that
+    // edits the map reports the changes and schedules the updates. Space outside the map
+    // counts as empty. Queries are const and may run on any number of threads, but not
+    // during edits, Update() or Publish(), which belong to the thread that edits the map.
+    //--------------------------------------------------------------------------------
+    class CORE_API ChunkDistanceField
+    {
+    public:
+        static constexpr int MAX_DISTANCE    = 8;
+        static constexpr int STEPS_PER_VOXEL = 16;
+
+        // In STEPS_PER_VOXEL, rounded down, at ChunkIndex(); MAX_DISTANCE * STEPS_PER_VOXEL at most.
+        using Distances = std::array<uint8_t, CHUNK_VOLUME>;
+
+        explicit ChunkDistanceField(const ChunkedVoxelMap& map);
+
+        ~ChunkDistanceField();
+
+        ChunkDistanceField(const ChunkDistanceField&)            = delete;
+        ChunkDistanceField& operator=(const ChunkDistanceField&) = delete;
+
+        // Computes every chunk of the map from scratch.
+        void Rebuild();
+
+        void Rebuild(ThreadPool& pool);
+
+        // Marks the chunks within MAX_DISTANCE of the voxel. Throws std::out_of_range outside the map.
+        void OnBlockChanged(int x, int y, int z);
+
+        // Marks the chunks within MAX_DISTANCE of the box, which may reach past the map.
+        void OnBoxChanged(const Int3& origin, const Int3& size);
+
+        // Marks the chunk and the chunks within MAX_DISTANCE of it, e.g. when it was streamed in,
+        // generated or unloaded.
+        void OnChunkChanged(const Int3& chunkPos);
+
+        // Recomputes the chunks marked since the last call and returns how many. Jobs still running
+        // for those chunks are dropped when they finish.
+        std::size_t Update();
+
+        std::size_t Update(ThreadPool& pool);
+
+        // Starts a job for every chunk marked since the last call and returns how many were started.
+        std::size_t Dispatch(ThreadPool& pool);
+
+        // Installs the fields of the finished jobs and returns how many. A job is dropped when a later
+        // one for its chunk was started, or the chunk was recomputed by Update() or Rebuild().
+        std::size_t Publish();
+
+        // Chunks waiting for Update() or Dispatch().
+        std::size_t PendingCount() const { return dirty_.size(); }
+
+        // Jobs started by Dispatch() whose field is not queued for Publish() yet.
+        std::size_t JobsInFlight() const;
+
+        // Field of a chunk, or nullptr when none of its voxels is within MAX_DISTANCE of a solid one.
+        const Distances* Get(const Int3& chunkPos) const;
+
+        // In voxels: 0 for solid voxels, MAX_DISTANCE when nothing solid is nearer.
+        float Distance(int x, int y, int z) const;
+
+        // Radius of a ball around the point that holds no solid voxel, at least; 0 inside solid ones.
+        float Clearance(const Vector3F& point) const;
+
+        // Marches along the ray by Clearance() and returns how far it certainly travels through
+        // empty space: maxDistance, or where the clearance drops below half a voxel. The first hit
+        // lies beyond, so a voxel traversal can start from there.
+        float SphereTrace(const Vector3F& origin, const Vector3F& direction, float maxDistance) const;
+
+        // Chunks with a field, full ones included.
+        std::size_t ChunkCount() const { return fields_.size(); }
+
+        std::size_t MemoryUsage() const;
+
+    private:
+        enum class FieldKind : uint8_t
+        {
+            Empty, // nothing solid within MAX_DISTANCE
+            Solid, // every voxel solid
+            Mixed,
+        };
+
+        // A chunk and its 26 neighbours, x fastest, then z, then y; nullptr where there is none.
+        using Neighbourhood = std::array<const VoxelChunk*, 27>;
+
+        // State shared with the jobs, which may still run after the field is gone.
+        struct Shared;
+
+        // Fills distances for the centre chunk unless it is Empty or Solid.
+        static FieldKind Compute(const Neighbourhood& chunks, Distances& distances);
+
+        Neighbourhood NeighbourhoodOf(const Int3& chunkPos) const;
+
+        void Install(const Int3& chunkPos, FieldKind kind, std::shared_ptr<const Distances> field);
+
+        // Marks the chunks with voxels within MAX_DISTANCE of the box.
+        void MarkDirty(const Int3& min, const Int3& max);
+
+        void RebuildAll(ThreadPool* pool);
+
+        std::size_t Refresh(ThreadPool* pool);
+
+        const ChunkedVoxelMap&                                                 map_;
+        std::shared_ptr<const Distances>                                       solid_; // shared by every full chunk
+        std::unordered_map<Int3, std::shared_ptr<const Distances>, Int3Hasher> fields_;
+        std::unordered_set<Int3, Int3Hasher>                                   dirty_;
+        std::unordered_map<Int3, uint64_t, Int3Hasher>                         jobs_; // latest dispatch of each chunk with a job
+        uint64_t                                                               dispatches_ = 0;
+        std::shared_ptr<Shared>                                                shared_;
+    };
+
+} // namespace Voxium::Core
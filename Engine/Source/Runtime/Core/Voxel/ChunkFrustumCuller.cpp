@@ -0,0 +1,213 @@
+#include "Voxel/ChunkFrustumCuller.h"
+
+#include <bit>
+#include <stdexcept>
+
+#include "System/CpuFeatures.h"
+#include "Voxel/VoxelChunk.h"
+
+#if VOXIUM_AVX2 || VOXIUM_SSE2
+#include <immintrin.h>
+#endif
+
+namespace Voxium::Core
+{
+    namespace
+    {
+#if VOXIUM_AVX2
+        // For each 8-bit lane mask, the lanes whose bit is set, packed to the front: a permutation
+        // that compresses the ids of one group into a contiguous store.
+        struct CompressTable
+        {
+            alignas(32) uint32_t Lanes[256][8];
+
+            CompressTable()
+            {
+                for (int mask = 0; mask < 256; ++mask)
+                {
+                    int count = 0;
+                    for (int lane = 0; lane < 8; ++lane)
+                        if (mask >> lane & 1)
+                            Lanes[mask][count++] = static_cast<uint32_t>(lane);
+                    while (count < 8)
+                        Lanes[mask][count++] = 0;
+                }
+            }
+        };
+
+        const CompressTable COMPRESS_TABLE;
+
+        // Tests the boxes from first on eight at a time, each plane against the columns xs[p], ys[p]
+        // and zs[p], and appends the ids of those inside at out. Returns where the untested rest
+        // starts.
+        VOXIUM_AVX2_TARGET std::size_t CullGroups8(const Frustum& frustum, const float* const* xs, const float* const* ys, const float* const* zs,
+                                                   const uint32_t* ids, std::size_t first, std::size_t count, uint32_t*& out)
+        {
+            __m256 nx[Frustum::PLANE_COUNT], ny[Frustum::PLANE_COUNT], nz[Frustum::PLANE_COUNT], nd[Frustum::PLANE_COUNT];
+            for (std::size_t p = 0; p < Frustum::PLANE_COUNT; ++p)
+            {
+                nx[p] = _mm256_set1_ps(frustum.Planes[p].X);
+                ny[p] = _mm256_set1_ps(frustum.Planes[p].Y);
+                nz[p] = _mm256_set1_ps(frustum.Planes[p].Z);
+                nd[p] = _mm256_set1_ps(frustum.Planes[p].W);
+            }
+            for (; first + 8 <= count; first += 8)
+            {
+                __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for (std::size_t p = 0; p < Frustum::PLANE_COUNT; ++p)
+                {
+                    __m256 distance = _mm256_add_ps(nd[p], _mm256_mul_ps(nx[p], _mm256_loadu_ps(xs[p] + first)));
+                    distance        = _mm256_add_ps(distance, _mm256_mul_ps(ny[p], _mm256_loadu_ps(ys[p] + first)));
+                    distance        = _mm256_add_ps(distance, _mm256_mul_ps(nz[p], _mm256_loadu_ps(zs[p] + first)));
+                    inside          = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+                }
+                const uint32_t mask  = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+                const __m256i  lanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(COMPRESS_TABLE.Lanes[mask]));
+                const __m256i  group = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + first));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(group, lanes));
+                out += std::popcount(mask);
+            }
+            return first;
+        }
+#endif
+
+#if VOXIUM_SSE2
+        // CullGroups8() four at a time.
+        std::size_t CullGroups4(const Frustum& frustum, const float* const* xs, const float* const* ys, const float* const* zs, const uint32_t* ids,
+                                std::size_t first, std::size_t count, uint32_t*& out)
+        {
+            __m128 nx[Frustum::PLANE_COUNT], ny[Frustum::PLANE_COUNT], nz[Frustum::PLANE_COUNT], nd[Frustum::PLANE_COUNT];
+            for (std::size_t p = 0; p < Frustum::PLANE_COUNT; ++p)
+            {
+                nx[p] = _mm_set1_ps(frustum.Planes[p].X);
+                ny[p] = _mm_set1_ps(frustum.Planes[p].Y);
+                nz[p] = _mm_set1_ps(frustum.Planes[p].Z);
+                nd[p] = _mm_set1_ps(frustum.Planes[p].W);
+            }
+            for (; first + 4 <= count; first += 4)
+            {
+                __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                for (std::size_t p = 0; p < Frustum::PLANE_COUNT; ++p)
+                {
+                    __m128 distance = _mm_add_ps(nd[p], _mm_mul_ps(nx[p], _mm_loadu_ps(xs[p] + first)));
+                    distance        = _mm_add_ps(distance, _mm_mul_ps(ny[p], _mm_loadu_ps(ys[p] + first)));
+                    distance        = _mm_add_ps(distance, _mm_mul_ps(nz[p], _mm_loadu_ps(zs[p] + first)));
+                    inside          = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+                }
+                for (uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(inside)); mask != 0; mask &= mask - 1)
+                    *out++ = ids[first + static_cast<std::size_t>(std::countr_zero(mask))];
+            }
+            return first;
+        }
+#endif
+    } // namespace
+
+    void ChunkFrustumCuller::Set(uint32_t id, const Vector3F& min, const Vector3F& max)
+    {
+        if (id >= slots_.size())
+            slots_.resize(static_cast<std::size_t>(id) + 1, NO_SLOT);
+
+        uint32_t& slot = slots_[id];
+        if (slot == NO_SLOT)
+        {
+            slot = static_cast<uint32_t>(ids_.size());
+            ids_.push_back(id);
+            for (auto& column : columns_)
+                column.push_back(0.0f);
+        }
+
+        columns_[MIN_X][slot] = min.X;
+        columns_[MIN_Y][slot] = min.Y;
+        columns_[MIN_Z][slot] = min.Z;
+        columns_[MAX_X][slot] = max.X;
+        columns_[MAX_Y][slot] = max.Y;
+        columns_[MAX_Z][slot] = max.Z;
+    }
+
+    void ChunkFrustumCuller::SetChunk(uint32_t id, const Int3& chunkPos)
+    {
+        const Vector3F min(ChunkBoundsMin(chunkPos));
+        Set(id, min, min + Vector3F(static_cast<float>(CHUNK_SIZE)));
+    }
+
+    bool ChunkFrustumCuller::Remove(uint32_t id)
+    {
+        if (!Contains(id))
+            return false;
+
+        const uint32_t slot = slots_[id];
+        const uint32_t last = static_cast<uint32_t>(ids_.size() - 1);
+        if (slot != last)
+        {
+            for (auto& column : columns_)
+                column[slot] = column[last];
+            ids_[slot]         = ids_[last];
+            slots_[ids_[slot]] = slot;
+        }
+        slots_[id] = NO_SLOT;
+        ids_.pop_back();
+        for (auto& column : columns_)
+            column.pop_back();
+        return true;
+    }
+
+    void ChunkFrustumCuller::Bounds(uint32_t id, Vector3F& min, Vector3F& max) const
+    {
+        if (!Contains(id))
+            throw std::out_of_range("No bounds for this id");
+
+        const uint32_t slot = slots_[id];
+        min                 = Vector3F(columns_[MIN_X][slot], columns_[MIN_Y][slot], columns_[MIN_Z][slot]);
+        max                 = Vector3F(columns_[MAX_X][slot], columns_[MAX_Y][slot], columns_[MAX_Z][slot]);
+    }
+
+    void ChunkFrustumCuller::Clear()
+    {
+        for (auto& column : columns_)
+            column.clear();
+        ids_.clear();
+        slots_.clear();
+    }
+
+    void ChunkFrustumCuller::Cull(const Frustum& frustum, std::vector<uint32_t>& visible) const
+    {
+        // AVX2 groups store eight ids at a time, so leave room past the last one.
+        const std::size_t count = ids_.size();
+        visible.resize(count + 8);
+        uint32_t* out = visible.data();
+
+        // Per plane, the columns holding the box corner farthest along its normal.
+        const float* xs[Frustum::PLANE_COUNT];
+        const float* ys[Frustum::PLANE_COUNT];
+        const float* zs[Frustum::PLANE_COUNT];
+        for (std::size_t p = 0; p < Frustum::PLANE_COUNT; ++p)
+        {
+            const Vector4F& plane = frustum.Planes[p];
+            xs[p]                 = columns_[plane.X >= 0.0f ? MAX_X : MIN_X].data();
+            ys[p]                 = columns_[plane.Y >= 0.0f ? MAX_Y : MIN_Y].data();
+            zs[p]                 = columns_[plane.Z >= 0.0f ? MAX_Z : MIN_Z].data();
+        }
+
+        std::size_t first = 0;
+#if VOXIUM_AVX2
+        if (CpuHasAvx2())
+            first = CullGroups8(frustum, xs, ys, zs, ids_.data(), first, count, out);
+#endif
+#if VOXIUM_SSE2
+        first = CullGroups4(frustum, xs, ys, zs, ids_.data(), first, count, out);
+#endif
+        for (; first < count; ++first)
+        {
+            bool inside = true;
+            for (std::size_t p = 0; p < Frustum::PLANE_COUNT && inside; ++p)
+            {
+                const Vector4F& plane = frustum.Planes[p];
+                inside                = plane.X * xs[p][first] + plane.Y * ys[p][first] + plane.Z * zs[p][first] + plane.W >= 0.0f;
+            }
+            if (inside)
+                *out++ = ids_[first];
+        }
+        visible.resize(static_cast<std::size_t>(out - visible.data()));
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Frustum.h"
+#include "Math/Int3.h"
+#include "Math/Matrix4F.h"
+#include "Math/Vector3F.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // ChunkFrustumCuller: the culling stage between the resident chunks and the draw
+    // stage. Bounding boxes are kept as structure-of-arrays min and max columns, and
+    // Cull() tests them against the six frustum planes eight at a time on processors with
+    // AVX2 (four with SSE2 elsewhere), each plane against the box corner farthest along
+    // its normal. The ids of the boxes that pass come out as one compact list, in slot
+    // order.
+    //
+    // Ids are small dense integers chosen by the caller, such as the index of a chunk's
+    // draw record. Removing a box moves the last one into its slot, so the columns
+    // never have holes. Cull() is const and may run while nothing is being set.
+    //--------------------------------------------------------------------------------
+    class CORE_API ChunkFrustumCuller
+    {
+    public:
+        // Adds the box of an id, or replaces it.
+        void Set(uint32_t id, const Vector3F& min, const Vector3F& max);
+
+        // The whole 32^3 box of a chunk, in voxels.
+        void SetChunk(uint32_t id, const Int3& chunkPos);
+
+        // Returns false if the id has no box.
+        bool Remove(uint32_t id);
+
+        bool Contains(uint32_t id) const { return id < slots_.size() && slots_[id] != NO_SLOT; }
+
+        // Box of an id; throws std::out_of_range if it has none.
+        void Bounds(uint32_t id, Vector3F& min, Vector3F& max) const;
+
+        void Clear();
+
+        std::size_t Size() const { return ids_.size(); }
+
+        // Replaces visible with the ids of the boxes that intersect the frustum.
+        void Cull(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+        void Cull(const Matrix4F& viewProjection, std::vector<uint32_t>& visible) const { Cull(Frustum(viewProjection), visible); }
+
+    private:
+        enum Column : int
+        {
+            MIN_X,
+            MIN_Y,
+            MIN_Z,
+            MAX_X,
+            MAX_Y,
+            MAX_Z,
+            COLUMN_COUNT,
+        };
+
+        static constexpr uint32_t NO_SLOT = ~0u;
+
+        std::array<std::vector<float>, COLUMN_COUNT> columns_;
+        std::vector<uint32_t>                        ids_;   // per slot
+        std::vector<uint32_t>                        slots_; // per id
+    };
+
+} // namespace Voxium::Core
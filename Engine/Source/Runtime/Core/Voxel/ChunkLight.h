@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "Voxel/VoxelChunk.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // ChunkLight: 4-bit sky and block light per voxel of a chunk, one byte each
+    // (sky in the high nibble), laid out in ChunkIndex order like VoxelChunk.
+    //--------------------------------------------------------------------------------
+    class ChunkLight
+    {
+    public:
+        static constexpr uint8_t MAX_LEVEL = 15;
+
+        // Light assumed where no ChunkLight is available: open sky, no block light.
+        static constexpr uint8_t DEFAULT_PACKED = MAX_LEVEL << 4;
+
+        explicit ChunkLight(uint8_t sky = MAX_LEVEL, uint8_t block = 0) { levels_.fill(Pack(sky, block)); }
+
+        static constexpr uint8_t Pack(uint8_t sky, uint8_t block) { return static_cast<uint8_t>(sky << 4 | block); }
+
+        uint8_t Sky(int index) const { return levels_[static_cast<std::size_t>(index)] >> 4; }
+
+        uint8_t Block(int index) const { return levels_[static_cast<std::size_t>(index)] & MAX_LEVEL; }
+
+        uint8_t Packed(int index) const { return levels_[static_cast<std::size_t>(index)]; }
+
+        void SetSky(int index, uint8_t level)
+        {
+            uint8_t& packed = levels_[static_cast<std::size_t>(index)];
+            packed          = static_cast<uint8_t>(level << 4 | (packed & MAX_LEVEL));
+        }
+
+        void SetBlock(int index, uint8_t level)
+        {
+            uint8_t& packed = levels_[static_cast<std::size_t>(index)];
+            packed          = static_cast<uint8_t>((packed & 0xF0) | level);
+        }
+
+        void Set(int index, uint8_t sky, uint8_t block) { levels_[static_cast<std::size_t>(index)] = Pack(sky, block); }
+
+        const uint8_t* Data() const { return levels_.data(); }
+
+    private:
+        std::array<uint8_t, CHUNK_VOLUME> levels_;
+    };
+
+} // namespace Voxium::Core
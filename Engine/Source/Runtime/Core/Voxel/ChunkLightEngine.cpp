@@ -0,0 +1,501 @@
+#include "Voxel/ChunkLightEngine.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr int     SKY           = 0;
+        constexpr int     BLOCK         = 1;
+        constexpr int     CHANNEL_COUNT = 2;
+        constexpr uint8_t MAX_LEVEL     = ChunkLight::MAX_LEVEL;
+
+        // Directions in BlockFace order: axis = direction / 2, positive when even.
+        constexpr int DIRECTION_COUNT                = BLOCK_FACE_COUNT;
+        constexpr int DIRECTIONS[DIRECTION_COUNT][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+        constexpr int UP                             = static_cast<int>(BlockFace::PositiveY);
+        constexpr int DOWN                           = static_cast<int>(BlockFace::NegativeY);
+        constexpr int LOCAL_AXIS_SHIFT[3]            = {0, 2 * CHUNK_SHIFT, CHUNK_SHIFT}; // of x, y, z in ChunkIndex
+
+        // Queues larger than this give their memory back once drained; a full chunk fill needs up to 128 KiB.
+        constexpr std::size_t RETAINED_QUEUE = 4096;
+
+        constexpr int NO_SIDE = -1;
+
+        // Queue node: voxel index (15 bits) and light level (4 bits). Removal nodes note whether
+        // the removed light travelled down. Add nodes note whether they only re-spread a level the
+        // voxel already holds rather than offering it a new one, and for sky light offered by an
+        // untracked chunk, the side it lies on, so the offer lapses if the chunk is added first.
+        constexpr uint32_t Node(int index, int level, bool down = false, bool respread = false, int side = NO_SIDE)
+        {
+            return static_cast<uint32_t>(index) | static_cast<uint32_t>(level) << 15 | static_cast<uint32_t>(down) << 19 |
+                   static_cast<uint32_t>(respread) << 20 | static_cast<uint32_t>(side + 1) << 21;
+        }
+
+        constexpr int  NodeIndex(uint32_t node) { return static_cast<int>(node & (CHUNK_VOLUME - 1)); }
+        constexpr int  NodeLevel(uint32_t node) { return static_cast<int>(node >> 15 & MAX_LEVEL); }
+        constexpr bool NodeDown(uint32_t node) { return (node >> 19 & 1) != 0; }
+        constexpr bool NodeRespread(uint32_t node) { return (node >> 20 & 1) != 0; }
+        constexpr int  NodeSide(uint32_t node) { return static_cast<int>(node >> 21 & 7) - 1; }
+
+        int Level(const ChunkLight& light, int channel, int index) { return channel == SKY ? light.Sky(index) : light.Block(index); }
+
+        void SetLevel(ChunkLight& light, int channel, int index, int level)
+        {
+            if (channel == SKY)
+                light.SetSky(index, static_cast<uint8_t>(level));
+            else
+                light.SetBlock(index, static_cast<uint8_t>(level));
+        }
+
+        // Level a voxel passes to its neighbour along a direction.
+        int Passed(int channel, int level, int direction) { return channel == SKY && direction == DOWN && level == MAX_LEVEL ? MAX_LEVEL : level - 1; }
+
+        // Sky light entering a voxel from open sky on its side in the given direction.
+        int OpenSky(int direction) { return direction == UP ? MAX_LEVEL : MAX_LEVEL - 1; }
+
+        Int3 Neighbour(const Int3& chunkPos, int direction)
+        {
+            return Int3(chunkPos.X + DIRECTIONS[direction][0], chunkPos.Y + DIRECTIONS[direction][1], chunkPos.Z + DIRECTIONS[direction][2]);
+        }
+
+        // Neighbour of a voxel along a direction: returns false when it lies in the same chunk
+        // and fills in the neighbour chunk otherwise. The index is set either way.
+        bool Step(const Int3& chunkPos, int index, int direction, Int3& otherChunk, int& otherIndex)
+        {
+            const int axis  = direction / 2;
+            const int delta = DIRECTIONS[direction][axis];
+            const int local = (index >> LOCAL_AXIS_SHIFT[axis] & CHUNK_MASK) + delta;
+            otherIndex      = (index & ~(CHUNK_MASK << LOCAL_AXIS_SHIFT[axis])) | (local & CHUNK_MASK) << LOCAL_AXIS_SHIFT[axis];
+            if (local >= 0 && local < CHUNK_SIZE)
+                return false;
+            otherChunk = Neighbour(chunkPos, direction);
+            return true;
+        }
+
+        Int3 WorldOf(const Int3& chunkPos, int index)
+        {
+            return Int3((chunkPos.X << CHUNK_SHIFT) | (index & CHUNK_MASK), (chunkPos.Y << CHUNK_SHIFT) | index >> (2 * CHUNK_SHIFT),
+                        (chunkPos.Z << CHUNK_SHIFT) | (index >> CHUNK_SHIFT & CHUNK_MASK));
+        }
+
+        // Calls func(index) for the CHUNK_AREA voxels of the chunk face in a direction.
+        template<typename Func>
+        void ForEachFaceVoxel(int direction, Func&& func)
+        {
+            const int axis = direction / 2;
+            const int edge = direction % 2 == 0 ? CHUNK_MASK : 0;
+            for (int a = 0; a < CHUNK_SIZE; ++a)
+                for (int b = 0; b < CHUNK_SIZE; ++b)
+                {
+                    int local[3];
+                    local[axis]           = edge;
+                    local[(axis + 1) % 3] = a;
+                    local[(axis + 2) % 3] = b;
+                    func(ChunkIndex(local[0], local[1], local[2]));
+                }
+        }
+
+        void Release(std::vector<uint32_t>& queue)
+        {
+            queue.clear();
+            if (queue.capacity() > RETAINED_QUEUE)
+                std::vector<uint32_t>().swap(queue);
+        }
+    } // namespace
+
+    struct ChunkLightEngine::LightChunk
+    {
+        explicit LightChunk(const Int3& chunkPos) : Position(chunkPos), Light(0, 0) {}
+
+        Int3                  Position;
+        ChunkLight            Light;
+        std::vector<uint32_t> Remove[CHANNEL_COUNT];
+        std::vector<uint32_t> Add[CHANNEL_COUNT];
+        bool                  Pending = false;
+        bool                  Changed = false;
+    };
+
+    ChunkLightEngine::ChunkLightEngine(const ChunkedVoxelMap& map, ThreadPool& pool) :
+        map_(map), pool_(pool), emission_(static_cast<std::size_t>(map.MAX_KIND) + 1, 0)
+    {
+    }
+
+    ChunkLightEngine::~ChunkLightEngine() = default;
+
+    void ChunkLightEngine::SetEmission(BlockKind kind, uint8_t level)
+    {
+        if (kind >= emission_.size())
+            throw std::out_of_range("Block kind above the map's MAX_KIND");
+        if (level > MAX_LEVEL)
+            throw std::out_of_range("Light level above 15");
+        emission_[kind] = level;
+    }
+
+    void ChunkLightEngine::AddChunk(const Int3& chunkPos)
+    {
+        if (HasChunk(chunkPos) || map_.OutOfBounds(chunkPos.X << CHUNK_SHIFT, chunkPos.Y << CHUNK_SHIFT, chunkPos.Z << CHUNK_SHIFT))
+            return;
+
+        LightChunk& chunk = *chunks_.emplace(chunkPos, std::make_unique<LightChunk>(chunkPos)).first->second;
+        if (!chunk.Changed)
+        {
+            chunk.Changed = true;
+            changed_.push_back(chunkPos);
+        }
+
+        if (const VoxelChunk* voxels = map_.GetChunk(chunkPos))
+        {
+            bool emits = false;
+            for (BlockKind kind : voxels->Palette())
+                emits |= Emission(kind) > 0;
+            for (int index = 0; emits && index < CHUNK_VOLUME; ++index)
+            {
+                if (const uint8_t level = Emission(voxels->Get(index)))
+                    Enqueue(chunk, BLOCK, false, Node(index, level));
+            }
+        }
+
+        // Sky enters from open sky around the chunk; tracked neighbours re-spread into it, and
+        // first recheck the light they drew from this chunk while it counted as open sky.
+        for (int direction = 0; direction < DIRECTION_COUNT; ++direction)
+        {
+            const Int3        otherPos = Neighbour(chunkPos, direction);
+            LightChunk* const other = Find(otherPos);
+            ForEachFaceVoxel(direction, [&](int index) {
+                Int3 unused = otherPos;
+                int  otherIndex;
+                Step(chunkPos, index, direction, unused, otherIndex);
+                const Int3 world = WorldOf(otherPos, otherIndex);
+                if (map_.OutOfBounds(world.X, world.Y, world.Z))
+                {
+                    if (direction == UP)
+                        Enqueue(chunk, SKY, false, Node(index, MAX_LEVEL));
+                    return;
+                }
+                if (other == nullptr)
+                {
+                    Enqueue(chunk, SKY, false, Node(index, OpenSky(direction), false, false, direction));
+                    return;
+                }
+                Enqueue(*other, SKY, true, Node(otherIndex, MAX_LEVEL, direction == DOWN));
+                if (const uint8_t level = other->Light.Block(otherIndex))
+                    Enqueue(*other, BLOCK, false, Node(otherIndex, level, false, true));
+            });
+        }
+    }
+
+    void ChunkLightEngine::RemoveChunk(const Int3& chunkPos)
+    {
+        auto it = chunks_.find(chunkPos);
+        if (it == chunks_.end())
+            return;
+
+        // Queued work may still have to carry removals across the border, so it runs first. Then the
+        // neighbours lose the block light that came through this chunk and see open sky instead.
+        if (it->second->Pending)
+        {
+            Propagate();
+            it = chunks_.find(chunkPos);
+        }
+        const LightChunk& chunk = *it->second;
+        for (int direction = 0; direction < DIRECTION_COUNT; ++direction)
+        {
+            const Int3  otherPos = Neighbour(chunkPos, direction);
+            LightChunk* other = Find(otherPos);
+            if (other == nullptr)
+                continue;
+            ForEachFaceVoxel(direction, [&](int index) {
+                Int3 unused = otherPos;
+                int  otherIndex;
+                Step(chunkPos, index, direction, unused, otherIndex);
+                if (const uint8_t level = chunk.Light.Block(index))
+                    Enqueue(*other, BLOCK, true, Node(otherIndex, level));
+                Enqueue(*other, SKY, false, Node(otherIndex, OpenSky(direction ^ 1), false, false, direction ^ 1));
+            });
+        }
+        chunks_.erase(it);
+    }
+
+    void ChunkLightEngine::OnBlockChanged(int x, int y, int z, BlockKind oldKind)
+    {
+        if (map_.OutOfBounds(x, y, z))
+            return;
+        LightChunk* chunk = Find(ChunkOf(x, y, z));
+        if (chunk == nullptr)
+            return;
+
+        const BlockKind newKind     = map_.GetBlock(x, y, z);
+        const bool      transparent = newKind == AIR_KIND;
+        const bool      opacityFlip = transparent != (oldKind == AIR_KIND);
+        if (!opacityFlip && Emission(oldKind) == Emission(newKind))
+            return;
+
+        const int index = ChunkIndex(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK);
+        if (opacityFlip)
+            Relight(*chunk, index, SKY, transparent, 0);
+        Relight(*chunk, index, BLOCK, transparent, Emission(newKind));
+    }
+
+    std::size_t ChunkLightEngine::Propagate()
+    {
+        std::size_t                          waves = 0;
+        std::vector<LightChunk*>             work;
+        std::vector<std::vector<BorderNode>> borders;
+        std::vector<uint8_t>                 modified;
+        while (!pending_.empty())
+        {
+            work.clear();
+            for (const Int3& chunkPos : pending_)
+            {
+                LightChunk* chunk = Find(chunkPos);
+                if (chunk != nullptr && chunk->Pending)
+                {
+                    chunk->Pending = false;
+                    work.push_back(chunk);
+                }
+            }
+            pending_.clear();
+
+            borders.resize(work.size());
+            modified.assign(work.size(), 0);
+            pool_.ParallelFor(work.size(), [&](std::size_t i) { modified[i] = Process(*work[i], borders[i]); });
+
+            // Between waves nothing runs, so the border nodes can go straight into the neighbours' queues.
+            for (std::size_t i = 0; i < work.size(); ++i)
+            {
+                if (modified[i] && !work[i]->Changed)
+                {
+                    work[i]->Changed = true;
+                    changed_.push_back(work[i]->Position);
+                }
+                for (const BorderNode& node : borders[i])
+                {
+                    if (LightChunk* target = Find(node.ChunkPos))
+                        Enqueue(*target, node.Channel, node.Removal, node.Node);
+                }
+                borders[i].clear();
+            }
+            ++waves;
+        }
+        return waves;
+    }
+
+    const ChunkLight* ChunkLightEngine::GetLight(const Int3& chunkPos) const
+    {
+        const LightChunk* chunk = Find(chunkPos);
+        return chunk != nullptr ? &chunk->Light : nullptr;
+    }
+
+    uint8_t ChunkLightEngine::SkyLight(int x, int y, int z) const
+    {
+        const LightChunk* chunk = Find(ChunkOf(x, y, z));
+        return chunk != nullptr ? chunk->Light.Sky(ChunkIndex(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK)) : ChunkLight::DEFAULT_PACKED >> 4;
+    }
+
+    uint8_t ChunkLightEngine::BlockLight(int x, int y, int z) const
+    {
+        const LightChunk* chunk = Find(ChunkOf(x, y, z));
+        return chunk != nullptr ? chunk->Light.Block(ChunkIndex(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK)) : ChunkLight::DEFAULT_PACKED & MAX_LEVEL;
+    }
+
+    std::vector<Int3> ChunkLightEngine::TakeChangedChunks()
+    {
+        for (const Int3& chunkPos : changed_)
+        {
+            if (LightChunk* chunk = Find(chunkPos))
+                chunk->Changed = false;
+        }
+        return std::exchange(changed_, {});
+    }
+
+    ChunkLightEngine::LightChunk* ChunkLightEngine::Find(const Int3& chunkPos)
+    {
+        auto it = chunks_.find(chunkPos);
+        return it != chunks_.end() ? it->second.get() : nullptr;
+    }
+
+    const ChunkLightEngine::LightChunk* ChunkLightEngine::Find(const Int3& chunkPos) const
+    {
+        auto it = chunks_.find(chunkPos);
+        return it != chunks_.end() ? it->second.get() : nullptr;
+    }
+
+    void ChunkLightEngine::Enqueue(LightChunk& chunk, int channel, bool removal, uint32_t node)
+    {
+        (removal ? chunk.Remove : chunk.Add)[channel].push_back(node);
+        if (!chunk.Pending)
+        {
+            chunk.Pending = true;
+            pending_.push_back(chunk.Position);
+        }
+    }
+
+    bool ChunkLightEngine::Process(LightChunk& chunk, std::vector<BorderNode>& border) const
+    {
+        // Chunks of air read like missing ones, without decoding; light never enters a solid chunk
+        // unless one of its kinds emits.
+        const VoxelChunk* voxels  = map_.GetChunk(chunk.Position);
+        bool              changed = false;
+        if (voxels != nullptr && voxels->IsEmpty())
+            voxels = nullptr;
+        bool sealed = voxels != nullptr && voxels->IsFull();
+        if (sealed)
+            for (BlockKind kind : voxels->Palette())
+                sealed &= Emission(kind) == 0;
+        auto kindAt = [&](int index) { return voxels != nullptr ? voxels->Get(index) : AIR_KIND; };
+
+        // Calls local(index, direction) for neighbours in this chunk and remote(chunkPos, index,
+        // direction) for those in the chunks around it, skipping voxels outside the map.
+        auto forEachNeighbour = [&](int index, auto&& local, auto&& remote) {
+            for (int direction = 0; direction < DIRECTION_COUNT; ++direction)
+            {
+                Int3 otherPos = chunk.Position;
+                int  otherIndex;
+                if (!Step(chunk.Position, index, direction, otherPos, otherIndex))
+                {
+                    local(otherIndex, direction);
+                    continue;
+                }
+                const Int3 world = WorldOf(otherPos, otherIndex);
+                if (!map_.OutOfBounds(world.X, world.Y, world.Z))
+                    remote(otherPos, otherIndex, direction);
+            }
+        };
+
+        for (int channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            std::vector<uint32_t>& removals = chunk.Remove[channel];
+            std::vector<uint32_t>& adds     = chunk.Add[channel];
+
+            // A removal node rechecks a voxel whose neighbour lost the given level: light below it
+            // (or full sky light straight below full sky light) came from there and goes too;
+            // anything else, and every emitter, has its own source and is re-spread instead.
+            for (std::size_t head = 0; head < removals.size(); ++head)
+            {
+                const uint32_t node   = removals[head];
+                const int      index  = NodeIndex(node);
+                const int      source = NodeLevel(node);
+                const int      level  = Level(chunk.Light, channel, index);
+                if (level == 0)
+                    continue;
+
+                const bool emitter   = channel == BLOCK && Emission(kindAt(index)) > 0;
+                const bool dependent = level < source || (channel == SKY && NodeDown(node) && source == MAX_LEVEL && level == MAX_LEVEL);
+                if (emitter || !dependent)
+                {
+                    adds.push_back(Node(index, level, false, true));
+                    continue;
+                }
+
+                SetLevel(chunk.Light, channel, index, 0);
+                changed = true;
+                forEachNeighbour(
+                    index, [&](int other, int direction) { removals.push_back(Node(other, level, direction == DOWN)); },
+                    [&](const Int3& otherPos, int other, int direction) {
+                        border.push_back({otherPos, Node(other, level, direction == DOWN), static_cast<uint8_t>(channel), true});
+                    });
+            }
+            Release(removals);
+
+            // An add node either offers a voxel a level, taken when it is brighter and the voxel
+            // transparent or emitting that much, or re-spreads the level a voxel still holds.
+            for (std::size_t head = 0; head < adds.size(); ++head)
+            {
+                const uint32_t node    = adds[head];
+                const int      index   = NodeIndex(node);
+                const int      level   = NodeLevel(node);
+                const int      current = Level(chunk.Light, channel, index);
+                if (sealed && !NodeRespread(node))
+                    continue;
+                if (NodeRespread(node))
+                {
+                    if (level != current)
+                        continue;
+                }
+                else
+                {
+                    if (level <= current)
+                        continue;
+                    if (const int side = NodeSide(node); side != NO_SIDE && Find(Neighbour(chunk.Position, side)) != nullptr)
+                        continue;
+                    const BlockKind kind = kindAt(index);
+                    if (kind != AIR_KIND && !(channel == BLOCK && Emission(kind) >= level))
+                        continue;
+                    SetLevel(chunk.Light, channel, index, level);
+                    changed = true;
+                }
+
+                forEachNeighbour(
+                    index,
+                    [&](int other, int direction) {
+                        const int passed = Passed(channel, level, direction);
+                        if (passed > Level(chunk.Light, channel, other) && kindAt(other) == AIR_KIND)
+                        {
+                            SetLevel(chunk.Light, channel, other, passed);
+                            changed = true;
+                            adds.push_back(Node(other, passed, false, true));
+                        }
+                    },
+                    [&](const Int3& otherPos, int other, int direction) {
+                        const int passed = Passed(channel, level, direction);
+                        if (passed > 0)
+                            border.push_back({otherPos, Node(other, passed), static_cast<uint8_t>(channel), false});
+                    });
+            }
+            Release(adds);
+        }
+        return changed;
+    }
+
+    void ChunkLightEngine::Relight(LightChunk& chunk, int index, int channel, bool transparent, uint8_t emission)
+    {
+        const Int3 world = WorldOf(chunk.Position, index);
+        const int  level = Level(chunk.Light, channel, index);
+        if (level > 0)
+        {
+            SetLevel(chunk.Light, channel, index, 0);
+            if (!chunk.Changed)
+            {
+                chunk.Changed = true;
+                changed_.push_back(chunk.Position);
+            }
+        }
+        if (emission > 0)
+            Enqueue(chunk, channel, false, Node(index, emission));
+
+        for (int direction = 0; direction < DIRECTION_COUNT; ++direction)
+        {
+            const int x = world.X + DIRECTIONS[direction][0];
+            const int y = world.Y + DIRECTIONS[direction][1];
+            const int z = world.Z + DIRECTIONS[direction][2];
+            if (map_.OutOfBounds(x, y, z))
+            {
+                if (transparent && channel == SKY && direction == UP)
+                    Enqueue(chunk, SKY, false, Node(index, MAX_LEVEL));
+                continue;
+            }
+
+            LightChunk* other = Find(ChunkOf(x, y, z));
+            if (other == nullptr)
+            {
+                if (transparent && channel == SKY)
+                    Enqueue(chunk, SKY, false, Node(index, OpenSky(direction), false, false, direction));
+                continue;
+            }
+
+            // Light the voxel passed on is rechecked; light around it flows back in if it can.
+            const int otherIndex = ChunkIndex(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK);
+            if (level > 0)
+                Enqueue(*other, channel, true, Node(otherIndex, level, direction == DOWN));
+            if (transparent)
+            {
+                if (const int otherLevel = Level(other->Light, channel, otherIndex))
+                    Enqueue(*other, channel, false, Node(otherIndex, otherLevel, false, true));
+            }
+        }
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkLight.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // ChunkLightEngine: sky and block light for the chunks of a ChunkedVoxelMap, kept
+    // current by incremental flood fill. Every tracked chunk holds a ChunkLight plus a
+    // remove and an add queue per channel. An edit clears the light of the changed voxel,
+    // queues removal checks for its neighbours and re-spreads whatever still reaches it,
+    // so only voxels whose light depended on the edit are visited.
+    //
+    // Propagate() drains the queues in waves. Each chunk with queued work runs on the pool
+    // and writes only its own light: removals first, then additions; nodes that cross its
+    // border are handed to the neighbour's queues for the next wave.
+    //
+    // Non-air blocks are opaque, light loses one level per step, and full sky light travels
+    // straight down without loss. Chunks the engine does not track count as open air under
+    // the sky, as the mesher assumes for missing light; beyond the map bounds there is only
+    // the sky above. Everything belongs to the thread that edits the map, and the map must
+    // not change during Propagate().
+    //--------------------------------------------------------------------------------
+    class CORE_API ChunkLightEngine
+    {
+    public:
+        ChunkLightEngine(const ChunkedVoxelMap& map, ThreadPool& pool);
+
+        ~ChunkLightEngine();
+
+        ChunkLightEngine(const ChunkLightEngine&)            = delete;
+        ChunkLightEngine& operator=(const ChunkLightEngine&) = delete;
+
+        // Block light a kind emits; nothing by default. Applies to chunks added and blocks changed
+        // afterwards. Throws std::out_of_range for kinds above the map's MAX_KIND or levels above 15.
+        void SetEmission(BlockKind kind, uint8_t level);
+
+        uint8_t Emission(BlockKind kind) const { return kind < emission_.size() ? emission_[kind] : 0; }
+
+        // Starts lighting a chunk, e.g. once it is loaded; the next Propagate() fills it in and
+        // updates its neighbours. Chunks outside the map and chunks already tracked are ignored.
+        void AddChunk(const Int3& chunkPos);
+
+        // Stops tracking a chunk; its neighbours fall back to treating it as open sky.
+        void RemoveChunk(const Int3& chunkPos);
+
+        bool HasChunk(const Int3& chunkPos) const { return chunks_.find(chunkPos) != chunks_.end(); }
+
+        std::size_t ChunkCount() const { return chunks_.size(); }
+
+        // Call after changing a voxel of the map; oldKind is the kind it held before.
+        void OnBlockChanged(int x, int y, int z, BlockKind oldKind);
+
+        // Runs waves until no work is queued and returns how many ran.
+        std::size_t Propagate();
+
+        bool HasPendingWork() const { return !pending_.empty(); }
+
+        // Light of a tracked chunk, or nullptr.
+        const ChunkLight* GetLight(const Int3& chunkPos) const;
+
+        // Voxels of untracked chunks read as ChunkLight::DEFAULT_PACKED.
+        uint8_t SkyLight(int x, int y, int z) const;
+
+        uint8_t BlockLight(int x, int y, int z) const;
+
+        // Chunks whose light changed since the last call, each once.
+        std::vector<Int3> TakeChangedChunks();
+
+    private:
+        struct LightChunk;
+
+        // Work a chunk hands to a neighbour: a queue node for one of the neighbour's voxels.
+        struct BorderNode
+        {
+            Int3     ChunkPos;
+            uint32_t Node;
+            uint8_t  Channel;
+            bool     Removal;
+        };
+
+        LightChunk* Find(const Int3& chunkPos);
+
+        const LightChunk* Find(const Int3& chunkPos) const;
+
+        void Enqueue(LightChunk& chunk, int channel, bool removal, uint32_t node);
+
+        // Runs a chunk's queues to completion; returns whether any level changed.
+        bool Process(LightChunk& chunk, std::vector<BorderNode>& border) const;
+
+        // Queues what changing the voxel at index means for its channel: its light is
+        // cleared and rechecked around it, and refilled from its neighbours when transparent.
+        void Relight(LightChunk& chunk, int index, int channel, bool transparent, uint8_t emission);
+
+        const ChunkedVoxelMap&                                              map_;
+        ThreadPool&                                                         pool_;
+        std::vector<uint8_t>                                                emission_;
+        std::unordered_map<Int3, std::unique_ptr<LightChunk>, Int3Hasher> chunks_;
+        std::vector<Int3>                                                   pending_;
+        std::vector<Int3>                                                   changed_;
+    };
+
+} // namespace Voxium::Core
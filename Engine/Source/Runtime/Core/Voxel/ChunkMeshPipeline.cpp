@@ -0,0 +1,212 @@
+#include "Voxel/ChunkMeshPipeline.h"
+
+#include <utility>
+
+#include "Thread/MpscQueue.h"
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr int NEIGHBOURHOOD_RADIUS = 1;
+    } // namespace
+
+    struct ChunkMeshPipeline::Shared
+    {
+        // Results travel with their chunk's counter so PopResult() never touches chunks_.
+        struct Finished
+        {
+            ChunkMeshResult                    Result;
+            std::shared_ptr<GenerationCounter> Current;
+        };
+
+        MpscQueue<Finished>      Results;
+        std::atomic<std::size_t> InFlight {0};
+        std::atomic<uint64_t>    Discarded {0};
+    };
+
+    ChunkMeshPipeline::ChunkMeshPipeline(ChunkedVoxelMap& map, ThreadPool& pool, const ChunkLightEngine* light, ChunkDistanceField* distanceField) :
+        map_(map), pool_(pool), light_(light), distanceField_(distanceField), shared_(std::make_shared<Shared>())
+    {
+    }
+
+    ChunkMeshPipeline::~ChunkMeshPipeline() = default;
+
+    void ChunkMeshPipeline::SetBlock(int x, int y, int z, BlockKind kind)
+    {
+        map_.SetBlock(x, y, z, kind);
+        MarkBlockDirty(x, y, z);
+    }
+
+    void ChunkMeshPipeline::FillBlocks(const Int3& origin, const Int3& size, BlockKind kind)
+    {
+        map_.FillBlocks(origin, size, kind);
+        MarkBoxDirty(origin, size);
+    }
+
+    void ChunkMeshPipeline::MarkBlockDirty(int x, int y, int z) { MarkBoxDirty(Int3(x, y, z), Int3(1, 1, 1)); }
+
+    void ChunkMeshPipeline::MarkBoxDirty(const Int3& origin, const Int3& size)
+    {
+        if (size.X <= 0 || size.Y <= 0 || size.Z <= 0)
+            return;
+        if (distanceField_ != nullptr)
+            distanceField_->OnBoxChanged(origin, size);
+
+        // A mesh reads its chunk plus one voxel around it (face culling and AO), so the box
+        // grown by one voxel covers every chunk whose mesh can change.
+        const Int3 first = ChunkOf(origin.X - 1, origin.Y - 1, origin.Z - 1);
+        const Int3 last  = ChunkOf(origin.X + size.X, origin.Y + size.Y, origin.Z + size.Z);
+        for (int cy = first.Y; cy <= last.Y; ++cy)
+            for (int cz = first.Z; cz <= last.Z; ++cz)
+                for (int cx = first.X; cx <= last.X; ++cx)
+                    MarkMeshDirty(Int3(cx, cy, cz));
+    }
+
+    void ChunkMeshPipeline::MarkChunkDirty(const Int3& chunkPos)
+    {
+        if (distanceField_ != nullptr && ChunkInMap(chunkPos))
+            distanceField_->OnChunkChanged(chunkPos);
+        MarkMeshDirty(chunkPos);
+    }
+
+    void ChunkMeshPipeline::MarkMeshDirty(const Int3& chunkPos)
+    {
+        if (!ChunkInMap(chunkPos))
+            return;
+
+        ChunkEntry& entry = chunks_[chunkPos];
+        if (entry.Generation == nullptr)
+            entry.Generation = std::make_shared<GenerationCounter>(0);
+        if (entry.Dirty)
+            return;
+
+        // The first edit since the last dispatch invalidates any job still building the old mesh;
+        // later edits before the next dispatch are covered by the same new generation.
+        entry.Generation->fetch_add(1, std::memory_order_release);
+        entry.Dirty = true;
+        dirty_.push_back(chunkPos);
+    }
+
+    void ChunkMeshPipeline::MarkLightDirty(const Int3& chunkPos)
+    {
+        MarkMeshDirty(chunkPos);
+        for (int face = 0; face < BLOCK_FACE_COUNT; ++face)
+        {
+            const Int3 normal = FaceNormal(static_cast<BlockFace>(face));
+            MarkMeshDirty(Int3(chunkPos.X + normal.X, chunkPos.Y + normal.Y, chunkPos.Z + normal.Z));
+        }
+    }
+
+    std::size_t ChunkMeshPipeline::Dispatch()
+    {
+        if (distanceField_ != nullptr)
+        {
+            distanceField_->Publish();
+            distanceField_->Dispatch(pool_);
+        }
+        if (dirty_.empty())
+            return 0;
+
+        // Jobs read immutable copies, so the map can be edited and relit again right away. Chunks
+        // are copy-on-write snapshots; each light is copied once no matter how many dirty
+        // neighbourhoods include it.
+        struct Snapshot
+        {
+            std::shared_ptr<const VoxelChunk> Chunk;
+            std::shared_ptr<const ChunkLight> Light;
+        };
+        std::unordered_map<Int3, Snapshot, Int3Hasher> snapshots;
+        snapshots.reserve(dirty_.size() * 4);
+        auto snapshotOf = [&](const Int3& chunkPos) -> const Snapshot& {
+            auto [it, inserted] = snapshots.try_emplace(chunkPos);
+            if (inserted)
+            {
+                it->second.Chunk = map_.Snapshot(chunkPos);
+                if (const ChunkLight* light = light_ != nullptr ? light_->GetLight(chunkPos) : nullptr)
+                    it->second.Light = std::make_shared<const ChunkLight>(*light);
+            }
+            return it->second;
+        };
+
+        for (const Int3& chunkPos : dirty_)
+        {
+            ChunkEntry& entry = chunks_.at(chunkPos);
+            entry.Dirty       = false;
+
+            ChunkMeshResult result {chunkPos, entry.Generation->load(std::memory_order_relaxed), {}};
+            if (snapshotOf(chunkPos).Chunk == nullptr)
+            {
+                // Nothing left to mesh; the empty result tells the renderer to drop the chunk. The
+                // entry goes too, so unloaded chunks and empty neighbours leave nothing behind: jobs
+                // still running and the queued result keep the old counter, and a later edit starts
+                // a new one.
+                shared_->Results.Push({std::move(result), std::move(entry.Generation)});
+                chunks_.erase(chunkPos);
+                continue;
+            }
+
+            std::array<Snapshot, ChunkNeighbourhood::SLOT_COUNT> chunks;
+            for (int dy = -NEIGHBOURHOOD_RADIUS; dy <= NEIGHBOURHOOD_RADIUS; ++dy)
+                for (int dz = -NEIGHBOURHOOD_RADIUS; dz <= NEIGHBOURHOOD_RADIUS; ++dz)
+                    for (int dx = -NEIGHBOURHOOD_RADIUS; dx <= NEIGHBOURHOOD_RADIUS; ++dx)
+                        chunks[ChunkNeighbourhood::Slot(dx, dy, dz)] = snapshotOf(Int3(chunkPos.X + dx, chunkPos.Y + dy, chunkPos.Z + dz));
+
+            shared_->InFlight.fetch_add(1, std::memory_order_relaxed);
+            pool_.Submit([shared = shared_, current = entry.Generation, chunks = std::move(chunks), result = std::move(result)]() mutable {
+                // Meshing is skipped outright when the chunk was edited again before the job ran.
+                if (current->load(std::memory_order_acquire) == result.Generation)
+                {
+                    thread_local GreedyMesher mesher;
+
+                    ChunkNeighbourhood neighbourhood;
+                    for (std::size_t slot = 0; slot < ChunkNeighbourhood::SLOT_COUNT; ++slot)
+                    {
+                        neighbourhood.Chunks[slot] = chunks[slot].Chunk.get();
+                        neighbourhood.Lights[slot] = chunks[slot].Light.get();
+                    }
+                    mesher.Mesh(neighbourhood, result.Mesh);
+                    result.Connectivity = ChunkVisibilityGraph::ComputeConnectivity(*neighbourhood.Chunks[ChunkNeighbourhood::Slot(0, 0, 0)]);
+                }
+
+                if (current->load(std::memory_order_acquire) == result.Generation)
+                    shared->Results.Push({std::move(result), std::move(current)});
+                else
+                    shared->Discarded.fetch_add(1, std::memory_order_relaxed);
+                shared->InFlight.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        const std::size_t started = dirty_.size();
+        dirty_.clear();
+        return started;
+    }
+
+    std::optional<ChunkMeshResult> ChunkMeshPipeline::PopResult()
+    {
+        while (std::optional<Shared::Finished> finished = shared_->Results.TryPop())
+        {
+            if (finished->Current->load(std::memory_order_acquire) == finished->Result.Generation)
+                return std::move(finished->Result);
+            shared_->Discarded.fetch_add(1, std::memory_order_relaxed);
+        }
+        return std::nullopt;
+    }
+
+    uint64_t ChunkMeshPipeline::Generation(const Int3& chunkPos) const
+    {
+        auto it = chunks_.find(chunkPos);
+        return it != chunks_.end() ? it->second.Generation->load(std::memory_order_relaxed) : 0;
+    }
+
+    std::size_t ChunkMeshPipeline::JobsInFlight() const { return shared_->InFlight.load(std::memory_order_acquire); }
+
+    uint64_t ChunkMeshPipeline::DiscardedCount() const { return shared_->Discarded.load(std::memory_order_relaxed); }
+
+    bool ChunkMeshPipeline::ChunkInMap(const Int3& chunkPos) const
+    {
+        // A chunk overlaps the map exactly when its first voxel lies inside it.
+        return !map_.OutOfBounds(chunkPos.X << CHUNK_SHIFT, chunkPos.Y << CHUNK_SHIFT, chunkPos.Z << CHUNK_SHIFT);
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkDistanceField.h"
+#include "Voxel/ChunkLightEngine.h"
+#include "Voxel/ChunkVisibilityGraph.h"
+#include "Voxel/ChunkedVoxelMap.h"
+#include "Voxel/GreedyMesher.h"
+
+namespace Voxium::Core
+{
+    // A finished mesh on its way to the render thread. Generation is the chunk generation the
+    // mesh was built from; an empty mesh means the chunk has nothing left to draw. Connectivity
+    // is for ChunkVisibilityGraph::Set().
+    struct ChunkMeshResult
+    {
+        Int3              ChunkPos;
+        uint64_t          Generation;
+        ChunkMesh         Mesh;
+        ChunkConnectivity Connectivity = ALL_FACES_CONNECTED;
+    };
+
+    //--------------------------------------------------------------------------------
+    // ChunkMeshPipeline: remeshes edited chunks of a ChunkedVoxelMap on a thread pool.
+    // Every edit bumps the generation of each chunk whose mesh it can change: the chunk
+    // itself and, for voxels on a border, the neighbours whose faces or corner AO read
+    // that voxel. Dispatch() snapshots the chunks the dirty meshes read and starts one
+    // job per dirty chunk; a result whose chunk was edited again in the meantime is
+    // dropped, by the worker when it notices before meshing and by PopResult() otherwise.
+    // With a ChunkLightEngine the light of every chunk read is snapshotted with it, and
+    // MarkLightDirty() remeshes the chunks whose faces can show a light change. With a
+    // ChunkDistanceField, edits and chunk marks are forwarded to it, and Dispatch()
+    // publishes the fields finished since the last call and starts jobs for the marked
+    // ones without waiting for them.
+    // Everything except PopResult() belongs to the thread that edits the map; PopResult()
+    // may run on one other thread, typically the render thread.
+    //--------------------------------------------------------------------------------
+    class CORE_API ChunkMeshPipeline
+    {
+    public:
+        ChunkMeshPipeline(ChunkedVoxelMap& map, ThreadPool& pool, const ChunkLightEngine* light = nullptr, ChunkDistanceField* distanceField = nullptr);
+
+        ~ChunkMeshPipeline();
+
+        ChunkMeshPipeline(const ChunkMeshPipeline&)            = delete;
+        ChunkMeshPipeline& operator=(const ChunkMeshPipeline&) = delete;
+
+        // Edit the map and mark the affected chunks dirty. SetBlock throws std::out_of_range
+        // like ChunkedVoxelMap::SetBlock.
+        void SetBlock(int x, int y, int z, BlockKind kind);
+
+        void FillBlocks(const Int3& origin, const Int3& size, BlockKind kind);
+
+        // For edits made on the map directly.
+        void MarkBlockDirty(int x, int y, int z);
+
+        void MarkBoxDirty(const Int3& origin, const Int3& size);
+
+        // For chunks replaced as a whole, e.g. streamed in, generated or unloaded.
+        void MarkChunkDirty(const Int3& chunkPos);
+
+        // For chunks reported by ChunkLightEngine::TakeChangedChunks(): faces read the light of the
+        // voxel in front of them, so the chunk and its six face neighbours are marked. Light does
+        // not move the distance field.
+        void MarkLightDirty(const Int3& chunkPos);
+
+        // Starts a meshing job for every dirty chunk and returns how many were started.
+        std::size_t Dispatch();
+
+        // Next finished mesh that is still current, or nullopt when none is ready.
+        std::optional<ChunkMeshResult> PopResult();
+
+        // Generation of the chunk's latest edit; 0 for chunks never marked dirty or last dispatched
+        // without voxels, whose generations start over.
+        uint64_t Generation(const Int3& chunkPos) const;
+
+        std::size_t DirtyCount() const { return dirty_.size(); }
+
+        // Jobs started by Dispatch() whose result is not queued or dropped yet.
+        std::size_t JobsInFlight() const;
+
+        // Results dropped because their chunk was edited again while they were built.
+        uint64_t DiscardedCount() const;
+
+    private:
+        using GenerationCounter = std::atomic<uint64_t>;
+
+        struct ChunkEntry
+        {
+            std::shared_ptr<GenerationCounter> Generation;
+            bool                               Dirty = false;
+        };
+
+        // State shared with the jobs, which may still run after the pipeline is gone.
+        struct Shared;
+
+        // Marks the chunk's mesh only.
+        void MarkMeshDirty(const Int3& chunkPos);
+
+        bool ChunkInMap(const Int3& chunkPos) const;
+
+        ChunkedVoxelMap&                                  map_;
+        ThreadPool&                                       pool_;
+        const ChunkLightEngine*                           light_;
+        ChunkDistanceField*                               distanceField_;
+        std::shared_ptr<Shared>                           shared_;
+        std::unordered_map<Int3, ChunkEntry, Int3Hasher> chunks_;
+        std::vector<Int3>                                 dirty_;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,367 @@
+#include "Voxel/ChunkOcclusionCuller.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        // Box corners are numbered x | y << 1 | z << 2 (bit set for the max side); faces list
+        // their corners in cyclic order: -X, +X, -Y, +Y, -Z, +Z.
+        constexpr int FACE_CORNERS[6][4] = {{0, 2, 6, 4}, {1, 3, 7, 5}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 5, 7, 6}};
+
+        float AxisDistance(float point, float min, float max) { return std::max({min - point, point - max, 0.0f}); }
+
+        // Offset of texel (x, y) in a row-major buffer width texels wide.
+        std::size_t TexelIndex(int x, int y, int width) { return static_cast<std::size_t>(y * width + x); }
+    } // namespace
+
+    ChunkOcclusionCuller::ChunkOcclusionCuller(int width, int height, int maxOccluders) :
+        width_(width), height_(height), maxOccluders_(maxOccluders), eye_(0.0f)
+    {
+        if (width <= 0 || height <= 0 || width % TILE_SIZE != 0 || height % TILE_SIZE != 0)
+            throw std::invalid_argument("Occlusion buffer size must be a positive multiple of the tile size");
+        if (maxOccluders <= 0)
+            throw std::invalid_argument("Occluder budget must be positive");
+
+        for (int w = width, h = height;; w = (w + 1) / 2, h = (h + 1) / 2)
+        {
+            levels_.emplace_back(static_cast<std::size_t>(w * h), 0.0f);
+            levelWidths_.push_back(w);
+            levelHeights_.push_back(h);
+            if (w == 1 && h == 1)
+                break;
+        }
+        tileFarthest_.assign(static_cast<std::size_t>((width / TILE_SIZE) * (height / TILE_SIZE)), 0.0f);
+    }
+
+    bool ChunkOcclusionCuller::IsOpaque(const VoxelChunk& chunk)
+    {
+        const std::vector<BlockKind>& palette = chunk.Palette();
+        return std::find(palette.begin(), palette.end(), AIR_KIND) == palette.end();
+    }
+
+    void ChunkOcclusionCuller::Begin(const Matrix4F& viewProjection, const Vector3F& eye)
+    {
+        viewProjection_ = viewProjection;
+        eye_            = eye;
+        occluders_.clear();
+        drawn_ = 0;
+        for (auto& level : levels_)
+            std::fill(level.begin(), level.end(), 0.0f);
+        std::fill(tileFarthest_.begin(), tileFarthest_.end(), 0.0f);
+    }
+
+    void ChunkOcclusionCuller::AddOccluder(const Vector3F& min, const Vector3F& max)
+    {
+        const float dx = AxisDistance(eye_.X, min.X, max.X);
+        const float dy = AxisDistance(eye_.Y, min.Y, max.Y);
+        const float dz = AxisDistance(eye_.Z, min.Z, max.Z);
+        occluders_.push_back({min, max, dx * dx + dy * dy + dz * dz});
+    }
+
+    void ChunkOcclusionCuller::AddChunkOccluder(const Int3& chunkPos)
+    {
+        const Vector3F min(ChunkBoundsMin(chunkPos));
+        AddOccluder(min, min + Vector3F(static_cast<float>(CHUNK_SIZE)));
+    }
+
+    void ChunkOcclusionCuller::Finish()
+    {
+        // Near occluders cover the most screen and hide the most, so the budget goes to them.
+        auto last = occluders_.end();
+        if (occluders_.size() > static_cast<std::size_t>(maxOccluders_))
+        {
+            last = occluders_.begin() + maxOccluders_;
+            std::nth_element(occluders_.begin(), last, occluders_.end(), [](const Occluder& a, const Occluder& b) { return a.Distance < b.Distance; });
+        }
+
+        // Front to back, so the tiles behind near occluders reject most of the later triangles.
+        std::sort(occluders_.begin(), last, [](const Occluder& a, const Occluder& b) { return a.Distance < b.Distance; });
+        for (auto it = occluders_.begin(); it != last; ++it)
+            DrawBox(it->Min, it->Max);
+        drawn_ = static_cast<std::size_t>(last - occluders_.begin());
+        BuildPyramid();
+    }
+
+    bool ChunkOcclusionCuller::IsVisible(const Vector3F& min, const Vector3F& max) const
+    {
+        ClipVertex corners[8];
+        TransformBox(min, max, corners);
+        PixelRect rect;
+        if (!ProjectBox(corners, rect))
+            return true;
+        if (rect.X0 > rect.X1 || rect.Y0 > rect.Y1)
+            return true;
+
+        // The level where the pixels fit in 4x4 texels: fewer would often land a small box on a
+        // texel border and test the screen around it too.
+        std::size_t level = 0;
+        while ((rect.X1 >> level) - (rect.X0 >> level) > 3 || (rect.Y1 >> level) - (rect.Y0 >> level) > 3)
+            ++level;
+        const std::vector<float>& texels = levels_[level];
+        const int                 stride = levelWidths_[level];
+        for (int y = rect.Y0 >> level; y <= rect.Y1 >> level; ++y)
+            for (int x = rect.X0 >> level; x <= rect.X1 >> level; ++x)
+                if (rect.Nearest >= texels[TexelIndex(x, y, stride)])
+                    return true;
+        return false;
+    }
+
+    bool ChunkOcclusionCuller::IsChunkVisible(const Int3& chunkPos) const
+    {
+        const Vector3F min(ChunkBoundsMin(chunkPos));
+        return IsVisible(min, min + Vector3F(static_cast<float>(CHUNK_SIZE)));
+    }
+
+    void ChunkOcclusionCuller::Filter(std::vector<uint32_t>& visible, const ChunkFrustumCuller& boxes) const
+    {
+        Vector3F min(0.0f), max(0.0f);
+        std::erase_if(visible, [&](uint32_t id) {
+            boxes.Bounds(id, min, max);
+            return !IsVisible(min, max);
+        });
+    }
+
+    void ChunkOcclusionCuller::TransformBox(const Vector3F& min, const Vector3F& max, ClipVertex (&corners)[8]) const
+    {
+        // One corner in full, the others by adding the transformed edges.
+        const Matrix4F&  m = viewProjection_;
+        const ClipVertex origin {min.X * m.M11 + min.Y * m.M21 + min.Z * m.M31 + m.M41, min.X * m.M12 + min.Y * m.M22 + min.Z * m.M32 + m.M42,
+                                 min.X * m.M13 + min.Y * m.M23 + min.Z * m.M33 + m.M43, min.X * m.M14 + min.Y * m.M24 + min.Z * m.M34 + m.M44};
+        const Vector3F   size = max - min;
+        const ClipVertex edges[3] = {{size.X * m.M11, size.X * m.M12, size.X * m.M13, size.X * m.M14},
+                                     {size.Y * m.M21, size.Y * m.M22, size.Y * m.M23, size.Y * m.M24},
+                                     {size.Z * m.M31, size.Z * m.M32, size.Z * m.M33, size.Z * m.M34}};
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            ClipVertex v = origin;
+            for (int axis = 0; axis < 3; ++axis)
+                if (corner & (1 << axis))
+                {
+                    v.X += edges[axis].X;
+                    v.Y += edges[axis].Y;
+                    v.Z += edges[axis].Z;
+                    v.W += edges[axis].W;
+                }
+            corners[corner] = v;
+        }
+    }
+
+    bool ChunkOcclusionCuller::ProjectBox(const ClipVertex (&corners)[8], PixelRect& rect) const
+    {
+        float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+        rect.Nearest = 0.0f;
+        for (const ClipVertex& corner : corners)
+        {
+            if (!(corner.Z + corner.W >= 0.0f && corner.W > 0.0f))
+                return false;
+            const ScreenVertex s = Project(corner);
+            minX                 = std::min(minX, s.X);
+            maxX                 = std::max(maxX, s.X);
+            minY                 = std::min(minY, s.Y);
+            maxY                 = std::max(maxY, s.Y);
+            rect.Nearest         = std::max(rect.Nearest, s.InverseW);
+        }
+        rect.X0 = std::max(0, static_cast<int>(std::floor(minX)));
+        rect.X1 = std::min(width_ - 1, static_cast<int>(std::floor(maxX)));
+        rect.Y0 = std::max(0, static_cast<int>(std::floor(minY)));
+        rect.Y1 = std::min(height_ - 1, static_cast<int>(std::floor(maxY)));
+        return true;
+    }
+
+    ChunkOcclusionCuller::ScreenVertex ChunkOcclusionCuller::Project(const ClipVertex& v) const
+    {
+        const float inverseW = 1.0f / v.W;
+        return {(v.X * inverseW * 0.5f + 0.5f) * static_cast<float>(width_), (0.5f - v.Y * inverseW * 0.5f) * static_cast<float>(height_), inverseW};
+    }
+
+    void ChunkOcclusionCuller::DrawBox(const Vector3F& min, const Vector3F& max)
+    {
+        ClipVertex corners[8];
+        TransformBox(min, max, corners);
+        if (IsHiddenByTiles(corners))
+            return;
+
+        // Only the faces turned towards the eye; they are nearer than the others everywhere.
+        const bool facing[6] = {eye_.X < min.X, eye_.X > max.X, eye_.Y < min.Y, eye_.Y > max.Y, eye_.Z < min.Z, eye_.Z > max.Z};
+        for (int face = 0; face < 6; ++face)
+        {
+            if (!facing[face])
+                continue;
+            const ClipVertex quad[4] = {corners[FACE_CORNERS[face][0]], corners[FACE_CORNERS[face][1]], corners[FACE_CORNERS[face][2]],
+                                        corners[FACE_CORNERS[face][3]]};
+            DrawFace(quad);
+        }
+    }
+
+    bool ChunkOcclusionCuller::IsHiddenByTiles(const ClipVertex (&corners)[8]) const
+    {
+        // Occluders come front to back, and most of the later ones lie behind tiles already full.
+        PixelRect rect;
+        if (!ProjectBox(corners, rect))
+            return false;
+        const int tilesX = width_ / TILE_SIZE;
+        for (int y = rect.Y0 / TILE_SIZE; y <= rect.Y1 / TILE_SIZE; ++y)
+            for (int x = rect.X0 / TILE_SIZE; x <= rect.X1 / TILE_SIZE; ++x)
+                if (rect.Nearest > tileFarthest_[TexelIndex(x, y, tilesX)])
+                    return false;
+        return true;
+    }
+
+    void ChunkOcclusionCuller::DrawFace(const ClipVertex (&corners)[4])
+    {
+        // Sutherland-Hodgman against the near plane z + w >= 0; a quad keeps at most five corners.
+        ClipVertex polygon[5];
+        int        count = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const ClipVertex& a  = corners[i];
+            const ClipVertex& b  = corners[(i + 1) % 4];
+            const float       da = a.Z + a.W;
+            const float       db = b.Z + b.W;
+            if (da >= 0.0f)
+                polygon[count++] = a;
+            if ((da >= 0.0f) != (db >= 0.0f))
+            {
+                const float t    = da / (da - db);
+                polygon[count++] = {a.X + (b.X - a.X) * t, a.Y + (b.Y - a.Y) * t, a.Z + (b.Z - a.Z) * t, a.W + (b.W - a.W) * t};
+            }
+        }
+        if (count < 3)
+            return;
+
+        ScreenVertex screen[5];
+        for (int i = 0; i < count; ++i)
+        {
+            if (!(polygon[i].W > 0.0f))
+                return;
+            screen[i] = Project(polygon[i]);
+        }
+        for (int i = 1; i + 1 < count; ++i)
+            DrawTriangle(screen[0], screen[i], screen[i + 1]);
+    }
+
+    void ChunkOcclusionCuller::DrawTriangle(ScreenVertex a, ScreenVertex b, ScreenVertex c)
+    {
+        float area = (b.X - a.X) * (c.Y - a.Y) - (b.Y - a.Y) * (c.X - a.X);
+        if (area < 0.0f)
+        {
+            std::swap(b, c);
+            area = -area;
+        }
+        if (!(area > 1e-6f))
+            return;
+
+        // Pixels whose centre lies in the bounding box.
+        const int x0 = std::max(0, static_cast<int>(std::ceil(std::min({a.X, b.X, c.X}) - 0.5f)));
+        const int x1 = std::min(width_ - 1, static_cast<int>(std::floor(std::max({a.X, b.X, c.X}) - 0.5f)));
+        const int y0 = std::max(0, static_cast<int>(std::ceil(std::min({a.Y, b.Y, c.Y}) - 0.5f)));
+        const int y1 = std::min(height_ - 1, static_cast<int>(std::floor(std::max({a.Y, b.Y, c.Y}) - 0.5f)));
+        if (x0 > x1 || y0 > y1)
+            return;
+
+        // Edge functions E(x, y) = A x + B y + C, non-negative inside; the edge opposite a vertex
+        // weights that vertex, which makes the inverse depth a plane over the screen too.
+        const ScreenVertex* from[3] = {&b, &c, &a};
+        const ScreenVertex* to[3]   = {&c, &a, &b};
+        float               edgeA[3], edgeB[3], edgeC[3];
+        for (int e = 0; e < 3; ++e)
+        {
+            edgeA[e] = from[e]->Y - to[e]->Y;
+            edgeB[e] = to[e]->X - from[e]->X;
+            edgeC[e] = -(edgeA[e] * from[e]->X + edgeB[e] * from[e]->Y);
+        }
+        const float depthA = (edgeA[0] * a.InverseW + edgeA[1] * b.InverseW + edgeA[2] * c.InverseW) / area;
+        const float depthB = (edgeB[0] * a.InverseW + edgeB[1] * b.InverseW + edgeB[2] * c.InverseW) / area;
+        const float depthC = (edgeC[0] * a.InverseW + edgeC[1] * b.InverseW + edgeC[2] * c.InverseW) / area;
+
+        std::vector<float>& depth = levels_[0];
+        for (int tileY = y0 / TILE_SIZE; tileY <= y1 / TILE_SIZE; ++tileY)
+            for (int tileX = x0 / TILE_SIZE; tileX <= x1 / TILE_SIZE; ++tileX)
+            {
+                // Edge ranges over the pixel centres of the tile reject it or fill it whole.
+                const float left    = static_cast<float>(tileX * TILE_SIZE) + 0.5f;
+                const float right   = left + TILE_SIZE - 1;
+                const float top     = static_cast<float>(tileY * TILE_SIZE) + 0.5f;
+                const float bottom  = top + TILE_SIZE - 1;
+                bool        outside = false;
+                bool        full    = true;
+                for (int e = 0; e < 3; ++e)
+                {
+                    const float highest = edgeA[e] * (edgeA[e] > 0.0f ? right : left) + edgeB[e] * (edgeB[e] > 0.0f ? bottom : top) + edgeC[e];
+                    const float lowest  = edgeA[e] * (edgeA[e] > 0.0f ? left : right) + edgeB[e] * (edgeB[e] > 0.0f ? top : bottom) + edgeC[e];
+                    outside |= highest < 0.0f;
+                    full &= lowest >= 0.0f;
+                }
+                if (outside)
+                    continue;
+
+                // Nothing to do where the triangle is nowhere nearer than the farthest pixel of the tile.
+                float&      farthest = tileFarthest_[TexelIndex(tileX, tileY, width_ / TILE_SIZE)];
+                const float nearest  = depthA * (depthA > 0.0f ? right : left) + depthB * (depthB > 0.0f ? bottom : top) + depthC;
+                if (nearest <= farthest)
+                    continue;
+
+                if (full)
+                {
+                    farthest = std::max(farthest, depthA * (depthA > 0.0f ? left : right) + depthB * (depthB > 0.0f ? top : bottom) + depthC);
+                    for (int y = 0; y < TILE_SIZE; ++y)
+                    {
+                        float*      row      = depth.data() + TexelIndex(tileX * TILE_SIZE, tileY * TILE_SIZE + y, width_);
+                        const float rowDepth = depthA * left + depthB * (top + static_cast<float>(y)) + depthC;
+                        for (int x = 0; x < TILE_SIZE; ++x)
+                            row[x] = std::max(row[x], rowDepth + depthA * static_cast<float>(x));
+                    }
+                    continue;
+                }
+
+                for (int y = std::max(y0, tileY * TILE_SIZE); y <= std::min(y1, tileY * TILE_SIZE + TILE_SIZE - 1); ++y)
+                    for (int x = std::max(x0, tileX * TILE_SIZE); x <= std::min(x1, tileX * TILE_SIZE + TILE_SIZE - 1); ++x)
+                    {
+                        const float px = static_cast<float>(x) + 0.5f;
+                        const float py = static_cast<float>(y) + 0.5f;
+                        if (edgeA[0] * px + edgeB[0] * py + edgeC[0] < 0.0f || edgeA[1] * px + edgeB[1] * py + edgeC[1] < 0.0f ||
+                            edgeA[2] * px + edgeB[2] * py + edgeC[2] < 0.0f)
+                            continue;
+                        float& texel = depth[TexelIndex(x, y, width_)];
+                        texel        = std::max(texel, depthA * px + depthB * py + depthC);
+                    }
+
+                // Two triangles of a face each cover part of the tiles along its diagonal.
+                float tileMin = INFINITY;
+                for (int y = 0; y < TILE_SIZE; ++y)
+                {
+                    const float* row = depth.data() + TexelIndex(tileX * TILE_SIZE, tileY * TILE_SIZE + y, width_);
+                    for (int x = 0; x < TILE_SIZE; ++x)
+                        tileMin = std::min(tileMin, row[x]);
+                }
+                farthest = tileMin;
+            }
+    }
+
+    void ChunkOcclusionCuller::BuildPyramid()
+    {
+        // Each texel keeps the farthest depth under it, so testing against it stays conservative.
+        for (std::size_t level = 1; level < levels_.size(); ++level)
+        {
+            const std::vector<float>& fine       = levels_[level - 1];
+            std::vector<float>&       coarse     = levels_[level];
+            const int                 fineWidth  = levelWidths_[level - 1];
+            const int                 fineHeight = levelHeights_[level - 1];
+            for (int y = 0; y < levelHeights_[level]; ++y)
+                for (int x = 0; x < levelWidths_[level]; ++x)
+                {
+                    const int x1 = std::min(2 * x + 1, fineWidth - 1);
+                    const int y1 = std::min(2 * y + 1, fineHeight - 1);
+                    coarse[TexelIndex(x, y, levelWidths_[level])] =
+                        std::min({fine[TexelIndex(2 * x, 2 * y, fineWidth)], fine[TexelIndex(x1, 2 * y, fineWidth)], fine[TexelIndex(2 * x, y1, fineWidth)],
+                                  fine[TexelIndex(x1, y1, fineWidth)]});
+                }
+        }
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Math/Matrix4F.h"
+#include "Math/Vector3F.h"
+#include "Voxel/ChunkFrustumCuller.h"
+#include "Voxel/VoxelChunk.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // ChunkOcclusionCuller: hierarchical-Z occlusion on the CPU. Each frame the nearest
+    // occluder boxes are drawn by a small tiled software rasterizer into a low-resolution
+    // buffer of inverse view depth (1 / w, larger is nearer), and a pyramid of 2x2 minima
+    // is built over it. A box is then occluded when, at the pyramid level where its screen
+    // rectangle spans at most 4x4 texels, its nearest corner lies behind all of them.
+    //
+    // Occluders must be completely opaque; a chunk with no air in its palette (IsOpaque())
+    // is one. Triangles are rasterized with 8x8 tiles that are rejected or filled whole
+    // when no edge crosses them, and sample pixel centres, so an occluder can reach half a
+    // pixel further than its true outline. Occluders go front to back, and a tile keeps the
+    // farthest depth in it so that later triangles, or whole boxes, behind it are skipped.
+    // Boxes crossing the near plane count as visible.
+    // Matrices follow the conventions of Frustum. Queries are const and may run on any
+    // number of threads between Finish() and the next Begin().
+    //--------------------------------------------------------------------------------
+    class CORE_API ChunkOcclusionCuller
+    {
+    public:
+        static constexpr int TILE_SIZE = 8;
+
+        // Throws std::invalid_argument unless width and height are positive multiples of TILE_SIZE
+        // and maxOccluders is positive.
+        explicit ChunkOcclusionCuller(int width = 256, int height = 128, int maxOccluders = 512);
+
+        // True when the chunk has no air at all, so its whole box hides what lies behind it.
+        static bool IsOpaque(const VoxelChunk& chunk);
+
+        // Starts a frame: forgets the occluders and clears the depth buffer. The eye is in world
+        // space, and decides which faces of an occluder face the camera.
+        void Begin(const Matrix4F& viewProjection, const Vector3F& eye);
+
+        void AddOccluder(const Vector3F& min, const Vector3F& max);
+
+        void AddChunkOccluder(const Int3& chunkPos);
+
+        // Draws the occluders nearest to the eye, up to the budget, and builds the pyramid.
+        void Finish();
+
+        bool IsVisible(const Vector3F& min, const Vector3F& max) const;
+
+        bool IsChunkVisible(const Int3& chunkPos) const;
+
+        // Removes the occluded ids from the output of ChunkFrustumCuller::Cull(), keeping the order.
+        void Filter(std::vector<uint32_t>& visible, const ChunkFrustumCuller& boxes) const;
+
+        int Width() const { return width_; }
+
+        int Height() const { return height_; }
+
+        // Inverse depth drawn at a pixel, 0 where no occluder covers it.
+        float InverseDepth(int x, int y) const { return levels_[0][static_cast<std::size_t>(y * width_ + x)]; }
+
+        std::size_t OccludersDrawn() const { return drawn_; }
+
+    private:
+        struct ClipVertex
+        {
+            float X, Y, Z, W;
+        };
+
+        struct ScreenVertex
+        {
+            float X, Y, InverseW;
+        };
+
+        // Pixels under a box on screen, clamped to the buffer and possibly empty, and the inverse
+        // depth of its nearest corner.
+        struct PixelRect
+        {
+            int   X0, Y0, X1, Y1;
+            float Nearest;
+        };
+
+        struct Occluder
+        {
+            Vector3F Min;
+            Vector3F Max;
+            float    Distance;
+        };
+
+        void TransformBox(const Vector3F& min, const Vector3F& max, ClipVertex (&corners)[8]) const;
+
+        // False when a corner lies behind the near plane, where the box has no rectangle.
+        bool ProjectBox(const ClipVertex (&corners)[8], PixelRect& rect) const;
+
+        ScreenVertex Project(const ClipVertex& v) const;
+
+        void DrawBox(const Vector3F& min, const Vector3F& max);
+
+        // True when every tile under the box already holds something nearer than all of it.
+        bool IsHiddenByTiles(const ClipVertex (&corners)[8]) const;
+
+        // Clips a face against the near plane and draws what is left.
+        void DrawFace(const ClipVertex (&corners)[4]);
+
+        void DrawTriangle(ScreenVertex a, ScreenVertex b, ScreenVertex c);
+
+        void BuildPyramid();
+
+        int                             width_;
+        int                             height_;
+        int                             maxOccluders_;
+        Matrix4F                        viewProjection_;
+        Vector3F                        eye_;
+        std::vector<Occluder>           occluders_;
+        std::vector<std::vector<float>> levels_; // level 0 is the buffer, then 2x2 minima
+        std::vector<int>                levelWidths_;
+        std::vector<int>                levelHeights_;
+        std::vector<float>              tileFarthest_; // a lower bound of the inverse depth in each tile
+        std::size_t                     drawn_ = 0;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,342 @@
+#include "Voxel/ChunkStreamer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+#include "Thread/MpscQueue.h"
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        // Queued loads are reordered once the view direction turns by about 10 degrees: the squared
+        // distance between the unit forward vectors, 2 - 2 cos(angle).
+        constexpr float RESCORE_TURN = 0.03f;
+
+        int FloorToChunk(float voxel) { return static_cast<int>(std::floor(voxel / static_cast<float>(CHUNK_SIZE))); }
+    } // namespace
+
+    struct ChunkStreamer::Shared
+    {
+        struct Loaded
+        {
+            Int3       ChunkPos;
+            uint32_t   Ticket;
+            VoxelChunk Chunk;
+            bool       Found  = false;
+            bool       Failed = false;
+        };
+
+        explicit Shared(ChunkLoader loader) : Loader(std::move(loader)) {}
+
+        ChunkLoader       Loader;
+        MpscQueue<Loaded> Results;
+
+        // Guards Cancelled and Running, so no job starts loading once the streamer is being destroyed.
+        std::mutex              Mutex;
+        std::condition_variable Idle;
+        bool                    Cancelled = false;
+        std::size_t             Running   = 0;
+    };
+
+    ChunkStreamer::ChunkStreamer(ChunkedVoxelMap& map, ThreadPool& pool, ChunkLoader loader, const ChunkStreamerSettings& settings)
+        : map_(map), pool_(pool), settings_(settings), shared_(std::make_shared<Shared>(std::move(loader)))
+    {
+    }
+
+    ChunkStreamer::~ChunkStreamer()
+    {
+        std::unique_lock<std::mutex> lock(shared_->Mutex);
+        shared_->Cancelled = true;
+        shared_->Idle.wait(lock, [&] { return shared_->Running == 0; });
+    }
+
+    ChunkLoader ChunkStreamer::CacheLoader(RegionChunkCache& cache)
+    {
+        return [&cache](const Int3& chunkPos, VoxelChunk& chunk) {
+            const std::shared_ptr<const VoxelChunk> cached = cache.GetChunk(chunkPos);
+            if (cached == nullptr)
+                return false;
+            chunk = *cached;
+            return true;
+        };
+    }
+
+    void ChunkStreamer::Update(const Vector3F& position, const Vector3F& forward)
+    {
+        published_.clear();
+        unloaded_.clear();
+
+        position_               = position;
+        const float forwardSize = std::sqrt(Vector3F::DotProduct(forward, forward));
+        forward_                = forwardSize > 0.0f ? forward / forwardSize : Vector3F(0.0f);
+        const Vector3F turn     = forward_ - scoredForward_;
+        if (Vector3F::DotProduct(turn, turn) > RESCORE_TURN)
+            rescore_ = true;
+
+        const Int3 column(FloorToChunk(position.X), 0, FloorToChunk(position.Z));
+        if (!started_ || !(column == cameraColumn_))
+            ScanColumns(column);
+
+        Publish();
+        Unload();
+        StartLoads();
+    }
+
+    bool ChunkStreamer::IsResident(const Int3& chunkPos) const
+    {
+        auto it = chunks_.find(chunkPos);
+        return it != chunks_.end() && it->second.State == ChunkState::Resident;
+    }
+
+    void ChunkStreamer::MarkModified(const Int3& chunkPos)
+    {
+        auto it = chunks_.find(chunkPos);
+        if (it != chunks_.end() && it->second.State == ChunkState::Resident)
+            it->second.Modified = true;
+    }
+
+    std::size_t ChunkStreamer::SaveModified()
+    {
+        if (saver_ == nullptr)
+            return 0;
+
+        std::size_t saved = 0;
+        for (auto& [chunkPos, entry] : chunks_)
+        {
+            if (!entry.Modified)
+                continue;
+            Save(chunkPos);
+            entry.Modified = false;
+            ++saved;
+        }
+        return saved;
+    }
+
+    void ChunkStreamer::ScanColumns(const Int3& column)
+    {
+        const Int3 previous = cameraColumn_;
+        const bool moved    = started_;
+        cameraColumn_       = column;
+        started_            = true;
+        rescore_            = true;
+
+        const int viewRadius = settings_.ViewRadius;
+        const int keepRadius = settings_.ViewRadius + settings_.UnloadMargin;
+        const int layers     = (map_.SizeY() + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+        auto      within     = [](const Int3& centre, int x, int z, int radius) {
+            const int dx = x - centre.X;
+            const int dz = z - centre.Z;
+            return dx * dx + dz * dz <= radius * radius;
+        };
+
+        // Columns entering the view radius. Chunks already known (still resident from an earlier
+        // visit, or queued) keep their state.
+        for (int z = column.Z - viewRadius; z <= column.Z + viewRadius; ++z)
+            for (int x = column.X - viewRadius; x <= column.X + viewRadius; ++x)
+            {
+                if (!within(column, x, z, viewRadius) || (moved && within(previous, x, z, viewRadius)))
+                    continue;
+                for (int y = 0; y < layers; ++y)
+                {
+                    const Int3 chunkPos(x, y, z);
+                    if (map_.OutOfBounds(x << CHUNK_SHIFT, y << CHUNK_SHIFT, z << CHUNK_SHIFT))
+                        continue;
+                    auto [it, inserted] = chunks_.try_emplace(chunkPos, ChunkEntry {ChunkState::Pending, nextTicket_});
+                    if (!inserted)
+                        continue;
+                    pending_.push_back({chunkPos, nextTicket_++, 0.0f});
+                }
+            }
+
+        if (!moved)
+        {
+            // Every chunk within the margin gets an entry eventually; growing the table while flying would stall a frame.
+            chunks_.reserve(static_cast<std::size_t>(4 * (keepRadius + 1) * (keepRadius + 1) * layers));
+            return;
+        }
+
+        // Columns leaving the margin. Loaded chunks are unloaded under the budget; queued and
+        // running loads are forgotten, and their results dropped when they arrive.
+        const std::size_t queued = unloadQueue_.size();
+        for (int z = previous.Z - keepRadius; z <= previous.Z + keepRadius; ++z)
+            for (int x = previous.X - keepRadius; x <= previous.X + keepRadius; ++x)
+            {
+                if (!within(previous, x, z, keepRadius) || within(column, x, z, keepRadius))
+                    continue;
+                for (int y = 0; y < layers; ++y)
+                {
+                    auto it = chunks_.find(Int3(x, y, z));
+                    if (it == chunks_.end())
+                        continue;
+                    if (it->second.State == ChunkState::Resident)
+                        unloadQueue_.push_back(it->first);
+                    else
+                        chunks_.erase(it);
+                }
+            }
+
+        // Farthest chunks at the back, where Unload() takes them from.
+        if (unloadQueue_.size() != queued)
+        {
+            auto distance = [&](const Int3& chunkPos) {
+                const int dx = chunkPos.X - column.X;
+                const int dz = chunkPos.Z - column.Z;
+                return dx * dx + dz * dz;
+            };
+            std::sort(unloadQueue_.begin(), unloadQueue_.end(), [&](const Int3& a, const Int3& b) { return distance(a) < distance(b); });
+        }
+    }
+
+    void ChunkStreamer::Publish()
+    {
+        int published = 0;
+        while (published < settings_.PublishBudget)
+        {
+            std::optional<Shared::Loaded> loaded = shared_->Results.TryPop();
+            if (!loaded)
+                break;
+            --inFlight_;
+
+            // The chunk left the range while loading, possibly coming back with a newer load.
+            auto it = chunks_.find(loaded->ChunkPos);
+            if (it == chunks_.end() || it->second.Ticket != loaded->Ticket || it->second.State != ChunkState::Loading)
+                continue;
+
+            it->second.State = ChunkState::Resident;
+            ++resident_;
+            if (loaded->Failed)
+                ++failed_;
+            if (!loaded->Found)
+                continue;
+
+            map_.GetOrCreateChunk(loaded->ChunkPos) = std::move(loaded->Chunk);
+            published_.push_back(loaded->ChunkPos);
+            ++published;
+        }
+    }
+
+    void ChunkStreamer::Unload()
+    {
+        const int keepRadius = settings_.ViewRadius + settings_.UnloadMargin;
+        int       unloaded   = 0;
+        while (unloaded < settings_.UnloadBudget && !unloadQueue_.empty())
+        {
+            const Int3 chunkPos = unloadQueue_.back();
+            unloadQueue_.pop_back();
+
+            // Skips chunks the camera came back to before their turn, and duplicates of unloaded ones.
+            auto it = chunks_.find(chunkPos);
+            if (it == chunks_.end() || it->second.State != ChunkState::Resident || InRange(chunkPos, keepRadius))
+                continue;
+
+            // Saved before anything changes, so a saver that throws leaves the chunk resident and modified.
+            if (it->second.Modified && saver_ != nullptr)
+                Save(chunkPos);
+
+            chunks_.erase(it);
+            --resident_;
+            if (map_.RemoveChunk(chunkPos))
+                unloaded_.push_back(chunkPos);
+            ++unloaded;
+        }
+    }
+
+    void ChunkStreamer::Save(const Int3& chunkPos)
+    {
+        saver_(chunkPos, map_.Snapshot(chunkPos));
+        ++saved_;
+    }
+
+    void ChunkStreamer::StartLoads()
+    {
+        const auto        limit = static_cast<std::size_t>(std::max(settings_.MaxLoadsInFlight, 0));
+        const std::size_t slots = limit > inFlight_ ? limit - inFlight_ : 0;
+        if (slots == 0 || pending_.empty())
+            return;
+
+        auto isCurrent = [&](const Request& request) {
+            auto it = chunks_.find(request.ChunkPos);
+            return it != chunks_.end() && it->second.Ticket == request.Ticket && it->second.State == ChunkState::Pending;
+        };
+
+        // Scores only change when the camera crosses a chunk column or turns, so the queue is
+        // rescored then and merely partitioned otherwise. Requests past the margin were forgotten
+        // by ScanColumns and go without a table lookup; the rare stale request still in range is
+        // skipped when it comes up.
+        if (rescore_)
+        {
+            const int keepRadius = settings_.ViewRadius + settings_.UnloadMargin;
+            std::erase_if(pending_, [&](const Request& request) { return !InRange(request.ChunkPos, keepRadius); });
+            for (Request& request : pending_)
+                request.Score = Score(request.ChunkPos);
+            scoredForward_ = forward_;
+            rescore_       = false;
+        }
+
+        // The best requests go to the back.
+        const std::size_t count = std::min(slots, pending_.size());
+        const auto        first = pending_.end() - static_cast<std::ptrdiff_t>(count);
+        if (count < pending_.size())
+            std::nth_element(pending_.begin(), first, pending_.end(), [](const Request& a, const Request& b) { return a.Score > b.Score; });
+
+        for (auto request = first; request != pending_.end(); ++request)
+        {
+            if (!isCurrent(*request))
+                continue;
+            chunks_.at(request->ChunkPos).State = ChunkState::Loading;
+            ++inFlight_;
+
+            pool_.Submit([shared = shared_, chunkPos = request->ChunkPos, ticket = request->Ticket] {
+                Shared::Loaded loaded {chunkPos, ticket, VoxelChunk()};
+                {
+                    std::lock_guard<std::mutex> lock(shared->Mutex);
+                    if (shared->Cancelled)
+                        return;
+                    ++shared->Running;
+                }
+
+                try
+                {
+                    loaded.Found = shared->Loader(chunkPos, loaded.Chunk);
+                }
+                catch (...)
+                {
+                    loaded.Failed = true;
+                }
+                shared->Results.Push(std::move(loaded));
+
+                std::lock_guard<std::mutex> lock(shared->Mutex);
+                if (--shared->Running == 0)
+                    shared->Idle.notify_all();
+            });
+        }
+        pending_.erase(first, pending_.end());
+    }
+
+    float ChunkStreamer::Score(const Int3& chunkPos) const
+    {
+        constexpr float HALF_CHUNK = CHUNK_SIZE * 0.5f;
+        const Vector3F  centre     = Vector3F(ChunkBoundsMin(chunkPos)) + Vector3F(HALF_CHUNK);
+        const Vector3F  offset     = centre - position_;
+        const float     distance   = std::sqrt(Vector3F::DotProduct(offset, offset));
+        if (distance < HALF_CHUNK)
+            return 0.0f;
+
+        // Cosine of the angle off the view direction: 1 straight ahead, -1 straight behind.
+        const float cosine = Vector3F::DotProduct(offset, forward_) / distance;
+        return distance * (1.0f + settings_.BehindWeight * (1.0f - cosine));
+    }
+
+    bool ChunkStreamer::InRange(const Int3& chunkPos, int radius) const
+    {
+        const int dx = chunkPos.X - cameraColumn_.X;
+        const int dz = chunkPos.Z - cameraColumn_.Z;
+        return dx * dx + dz * dz <= radius * radius;
+    }
+
+} // namespace Voxium::Core
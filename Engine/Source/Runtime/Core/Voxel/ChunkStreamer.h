@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Math/Vector3F.h"
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkedVoxelMap.h"
+#include "Voxel/RegionChunkCache.h"
+
+namespace Voxium::Core
+{
+    // Fills chunk with the stored chunk and returns true, or returns false if there is none.
+    // Runs on pool threads, so it must be thread-safe; exceptions count as failed loads.
+    using ChunkLoader = std::function<bool(const Int3& chunkPos, VoxelChunk& chunk)>;
+
+    // Stores a modified chunk before it leaves the map; chunk is a copy-on-write snapshot, or nullptr
+    // when the edits left nothing but air. Runs on the thread that owns the map, and the loader must
+    // see the chunk once it returns.
+    using ChunkSaver = std::function<void(const Int3& chunkPos, std::shared_ptr<const VoxelChunk> chunk)>;
+
+    struct ChunkStreamerSettings
+    {
+        // Horizontal distance in chunks, measured between column centres; every chunk layer of the map is kept.
+        int ViewRadius = 16;
+
+        // Chunks stay resident this many chunks past the view radius, so moving back and forth does not reload them.
+        int UnloadMargin = 2;
+
+        // Loads handed to the pool at once. Bounds throughput to this many chunks per frame, but kept
+        // well below the backlog so the order follows the camera.
+        int MaxLoadsInFlight = 128;
+
+        // Finished chunks moved into the map per Update.
+        int PublishBudget = 64;
+
+        // Chunks removed from the map per Update. Should exceed what leaves the margin per frame.
+        int UnloadBudget = 256;
+
+        // How far chunks behind the camera are deferred: their distance counts up to (1 + 2 * weight) times.
+        float BehindWeight = 0.5f;
+    };
+
+    //--------------------------------------------------------------------------------
+    // ChunkStreamer: keeps the chunks within a view radius of the camera resident in a
+    // ChunkedVoxelMap. Missing chunks are queued by distance, with chunks in front of the
+    // camera first, and loaded on a thread pool a few at a time; Update() publishes a
+    // bounded number of finished chunks per frame and unloads chunks that fell out of
+    // range, farthest first. Moving one chunk only scans the columns entering or leaving
+    // the radius. Chunks passed to MarkModified() after an edit go to the saver, if
+    // any, before they unload.
+    // Everything belongs to the thread that owns the map.
+    //--------------------------------------------------------------------------------
+    class CORE_API ChunkStreamer
+    {
+    public:
+        ChunkStreamer(ChunkedVoxelMap& map, ThreadPool& pool, ChunkLoader loader, const ChunkStreamerSettings& settings = {});
+
+        // Waits for loads that already started; queued loads are skipped.
+        ~ChunkStreamer();
+
+        ChunkStreamer(const ChunkStreamer&)            = delete;
+        ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+        // Loader over a chunk cache, which is already thread-safe. The cache must outlive the streamer.
+        static ChunkLoader CacheLoader(RegionChunkCache& cache);
+
+        // Without a saver, edits of unloaded chunks are lost.
+        void SetSaver(ChunkSaver saver) { saver_ = std::move(saver); }
+
+        // Once per frame. The position is in voxels; forward need not be normalised, and a zero
+        // forward orders by distance alone.
+        void Update(const Vector3F& position, const Vector3F& forward);
+
+        // Chunks moved into the map by the last Update, for remeshing. Chunks that were never
+        // stored become resident without appearing here.
+        const std::vector<Int3>& Published() const { return published_; }
+
+        // Chunks removed from the map by the last Update.
+        const std::vector<Int3>& Unloaded() const { return unloaded_; }
+
+        bool IsResident(const Int3& chunkPos) const;
+
+        // For chunks edited while resident; others are ignored, since a load still running would
+        // replace them anyway.
+        void MarkModified(const Int3& chunkPos);
+
+        // Saves every modified resident chunk, e.g. before the map is destroyed, and returns how many.
+        std::size_t SaveModified();
+
+        // Chunks in range that are loaded, including ones that were never stored.
+        std::size_t ResidentCount() const { return resident_; }
+
+        // Chunks waiting for a free load slot.
+        std::size_t PendingCount() const { return pending_.size(); }
+
+        // Loads started and not yet published or dropped.
+        std::size_t LoadsInFlight() const { return inFlight_; }
+
+        // Loads whose loader threw; those chunks count as resident and empty.
+        uint64_t FailedCount() const { return failed_; }
+
+        // Chunks handed to the saver.
+        uint64_t SavedCount() const { return saved_; }
+
+        const ChunkStreamerSettings& Settings() const { return settings_; }
+
+    private:
+        enum class ChunkState : uint8_t
+        {
+            Pending,
+            Loading,
+            Resident,
+        };
+
+        struct ChunkEntry
+        {
+            ChunkState State;
+            uint32_t   Ticket;
+            bool       Modified = false;
+        };
+
+        struct Request
+        {
+            Int3     ChunkPos;
+            uint32_t Ticket;
+            float    Score;
+        };
+
+        // State shared with the load jobs, which may still be queued after the streamer is gone.
+        struct Shared;
+
+        // Queues the chunks of columns entering the view radius and the unloads of columns leaving the margin.
+        void ScanColumns(const Int3& column);
+
+        void Publish();
+
+        void Unload();
+
+        void Save(const Int3& chunkPos);
+
+        void StartLoads();
+
+        float Score(const Int3& chunkPos) const;
+
+        bool InRange(const Int3& chunkPos, int radius) const;
+
+        ChunkedVoxelMap&        map_;
+        ThreadPool&             pool_;
+        ChunkStreamerSettings   settings_;
+        ChunkSaver              saver_;
+        std::shared_ptr<Shared> shared_;
+
+        std::unordered_map<Int3, ChunkEntry, Int3Hasher> chunks_;
+        std::vector<Request>                              pending_;
+        std::vector<Int3>                                 unloadQueue_;
+        std::vector<Int3>                                 published_;
+        std::vector<Int3>                                 unloaded_;
+
+        // Camera state of the last Update; forward_ is normalised or zero.
+        Vector3F    position_      = Vector3F(0.0f);
+        Vector3F    forward_       = Vector3F(0.0f);
+        Vector3F    scoredForward_ = Vector3F(0.0f);
+        Int3        cameraColumn_  = Int3(0, 0, 0);
+        bool        started_       = false;
+        bool        rescore_       = false;
+        uint32_t    nextTicket_    = 0;
+        std::size_t resident_      = 0;
+        std::size_t inFlight_      = 0;
+        uint64_t    failed_        = 0;
+        uint64_t    saved_         = 0;
+    };
+
+} // namespace Voxium::Core
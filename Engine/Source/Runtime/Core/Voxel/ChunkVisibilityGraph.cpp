@@ -0,0 +1,172 @@
+#include "Voxel/ChunkVisibilityGraph.h"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include "Voxel/GreedyMesher.h"
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr std::size_t ROW_COUNT = CHUNK_AREA; // rows of 32 voxels along X, numbered z | y << 5
+
+        // Faces are listed in +/- pairs, so the opposite face only differs in the lowest bit.
+        constexpr int Opposite(int face) { return face ^ 1; }
+
+        // Air cells of the run of bits in a row that contain the seed bits.
+        uint32_t GrowInRow(uint32_t seed, uint32_t open)
+        {
+            uint32_t grown = seed;
+            for (;;)
+            {
+                const uint32_t next = grown | ((grown << 1) & open) | ((grown >> 1) & open);
+                if (next == grown)
+                    return grown;
+                grown = next;
+            }
+        }
+    } // namespace
+
+    ChunkConnectivity ChunkVisibilityGraph::ComputeConnectivity(const VoxelChunk& chunk)
+    {
+        if (chunk.IsEmpty())
+            return ALL_FACES_CONNECTED;
+        if (chunk.IsFull())
+            return 0;
+
+        std::array<uint32_t, ROW_COUNT> open;
+        GreedyMesher::DecodeSolidRows(chunk, open);
+        for (uint32_t& row : open)
+            row = ~row;
+
+        // One flood fill per air region, a row of 32 voxels at a time: grow the run inside the row,
+        // then hand the new cells to the four rows next to it.
+        ChunkConnectivity               connectivity = 0;
+        std::array<uint32_t, ROW_COUNT> reached {};
+        std::vector<std::size_t>        pending;
+        for (std::size_t start = 0; start < ROW_COUNT && connectivity != ALL_FACES_CONNECTED; ++start)
+        {
+            while (open[start] != 0 && connectivity != ALL_FACES_CONNECTED)
+            {
+                uint32_t faces = 0;
+                reached[start] = open[start] & (0u - open[start]);
+                pending.assign(1, start);
+                while (!pending.empty())
+                {
+                    const std::size_t row = pending.back();
+                    pending.pop_back();
+                    const uint32_t region = GrowInRow(reached[row], open[row]);
+                    reached[row]          = 0;
+                    if (region == 0)
+                        continue;
+                    open[row] &= ~region;
+
+                    const std::size_t z = row & CHUNK_MASK;
+                    const std::size_t y = row >> CHUNK_SHIFT;
+                    faces |= (region >> (CHUNK_SIZE - 1)) << static_cast<int>(BlockFace::PositiveX);
+                    faces |= (region & 1) << static_cast<int>(BlockFace::NegativeX);
+                    faces |= static_cast<uint32_t>(y == CHUNK_SIZE - 1) << static_cast<int>(BlockFace::PositiveY);
+                    faces |= static_cast<uint32_t>(y == 0) << static_cast<int>(BlockFace::NegativeY);
+                    faces |= static_cast<uint32_t>(z == CHUNK_SIZE - 1) << static_cast<int>(BlockFace::PositiveZ);
+                    faces |= static_cast<uint32_t>(z == 0) << static_cast<int>(BlockFace::NegativeZ);
+
+                    // ROW_COUNT stands for no row past the chunk's border.
+                    const std::size_t neighbours[4] = {z > 0 ? row - 1 : ROW_COUNT, z < CHUNK_SIZE - 1 ? row + 1 : ROW_COUNT,
+                                                       y > 0 ? row - CHUNK_SIZE : ROW_COUNT, y < CHUNK_SIZE - 1 ? row + CHUNK_SIZE : ROW_COUNT};
+                    for (std::size_t next : neighbours)
+                    {
+                        if (next == ROW_COUNT)
+                            continue;
+                        const uint32_t seed = region & open[next] & ~reached[next];
+                        if (seed == 0)
+                            continue;
+                        if (reached[next] == 0)
+                            pending.push_back(next);
+                        reached[next] |= seed;
+                    }
+                }
+
+                for (int a = 0; a < BLOCK_FACE_COUNT; ++a)
+                    for (int b = a + 1; b < BLOCK_FACE_COUNT; ++b)
+                        if ((faces >> a & 1) && (faces >> b & 1))
+                            connectivity |= static_cast<ChunkConnectivity>(1u << FacePairBit(static_cast<BlockFace>(a), static_cast<BlockFace>(b)));
+            }
+        }
+        return connectivity;
+    }
+
+    void ChunkVisibilityGraph::Set(const Int3& chunkPos, ChunkConnectivity connectivity)
+    {
+        connectivity_.insert_or_assign(chunkPos, static_cast<ChunkConnectivity>(connectivity & ALL_FACES_CONNECTED));
+    }
+
+    void ChunkVisibilityGraph::Update(const ChunkedVoxelMap& map, const Int3& chunkPos)
+    {
+        if (const VoxelChunk* chunk = map.GetChunk(chunkPos))
+            Set(chunkPos, ComputeConnectivity(*chunk));
+        else
+            Remove(chunkPos);
+    }
+
+    bool ChunkVisibilityGraph::Remove(const Int3& chunkPos) { return connectivity_.erase(chunkPos) != 0; }
+
+    ChunkConnectivity ChunkVisibilityGraph::Connectivity(const Int3& chunkPos) const
+    {
+        auto it = connectivity_.find(chunkPos);
+        return it != connectivity_.end() ? it->second : ALL_FACES_CONNECTED;
+    }
+
+    void ChunkVisibilityGraph::Traverse(const Vector3F& eye, const Frustum& frustum, int maxDistance, std::vector<Int3>& visible)
+    {
+        if (maxDistance < 0)
+            throw std::invalid_argument("Traversal distance must not be negative");
+
+        visible.clear();
+        const Int3 camera(static_cast<int>(std::floor(eye.X)) >> CHUNK_SHIFT, static_cast<int>(std::floor(eye.Y)) >> CHUNK_SHIFT,
+                          static_cast<int>(std::floor(eye.Z)) >> CHUNK_SHIFT);
+        const auto side = static_cast<std::size_t>(2 * maxDistance + 1);
+        visited_.assign(side * side * side, 0);
+        auto visitedAt = [&](const Int3& chunkPos) -> uint8_t& {
+            // Chunks within maxDistance of the camera, so the offsets from the corner of the cube are never negative.
+            const Int3 offset = chunkPos - camera + Int3(maxDistance, maxDistance, maxDistance);
+            return visited_[(static_cast<std::size_t>(offset.Y) * side + static_cast<std::size_t>(offset.Z)) * side + static_cast<std::size_t>(offset.X)];
+        };
+
+        // Breadth first, so each chunk is entered by one of its shortest paths from the camera.
+        queue_.clear();
+        queue_.push_back({camera, -1, 0});
+        visitedAt(camera) = 1;
+        for (std::size_t head = 0; head < queue_.size(); ++head)
+        {
+            const Step step = queue_[head];
+            auto       it   = connectivity_.find(step.ChunkPos);
+            if (it != connectivity_.end())
+                visible.push_back(step.ChunkPos);
+            const ChunkConnectivity connectivity = it != connectivity_.end() ? it->second : ALL_FACES_CONNECTED;
+
+            for (int face = 0; face < BLOCK_FACE_COUNT; ++face)
+            {
+                if (step.Directions >> Opposite(face) & 1)
+                    continue;
+                if (step.EnteredBy >= 0 && !FacesConnected(connectivity, static_cast<BlockFace>(step.EnteredBy), static_cast<BlockFace>(face)))
+                    continue;
+
+                const Int3 next = step.ChunkPos + FaceNormal(static_cast<BlockFace>(face));
+                if (std::abs(next.X - camera.X) > maxDistance || std::abs(next.Y - camera.Y) > maxDistance || std::abs(next.Z - camera.Z) > maxDistance)
+                    continue;
+                uint8_t& seen = visitedAt(next);
+                if (seen != 0)
+                    continue;
+
+                const Vector3F min(ChunkBoundsMin(next));
+                if (!frustum.Intersects(min, min + Vector3F(static_cast<float>(CHUNK_SIZE))))
+                    continue;
+                seen = 1;
+                queue_.push_back({next, static_cast<int8_t>(Opposite(face)), static_cast<uint8_t>(step.Directions | 1 << face)});
+            }
+        }
+    }
+
+} // namespace Voxium::Core
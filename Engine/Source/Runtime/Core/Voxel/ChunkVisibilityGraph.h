@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Frustum.h"
+#include "Math/Int3.h"
+#include "Math/Vector3F.h"
+#include "Voxel/ChunkedVoxelMap.h"
+#include "Voxel/VoxelChunk.h"
+
+namespace Voxium::Core
+{
+    // One bit per unordered pair of different chunk faces, set when air connects the two faces
+    // through the chunk: 15 bits.
+    using ChunkConnectivity = uint16_t;
+
+    constexpr ChunkConnectivity ALL_FACES_CONNECTED = 0x7FFF;
+
+    constexpr int FacePairBit(BlockFace a, BlockFace b)
+    {
+        int low  = static_cast<int>(a);
+        int high = static_cast<int>(b);
+        if (low > high)
+        {
+            const int swap = low;
+            low            = high;
+            high           = swap;
+        }
+        // Pairs (0, 1..5) take bits 0-4, (1, 2..5) bits 5-8 and so on.
+        return low * (2 * BLOCK_FACE_COUNT - low - 1) / 2 + high - low - 1;
+    }
+
+    constexpr bool FacesConnected(ChunkConnectivity connectivity, BlockFace a, BlockFace b)
+    {
+        return a == b || ((connectivity >> FacePairBit(a, b)) & 1) != 0;
+    }
+
+    //--------------------------------------------------------------------------------
+    // ChunkVisibilityGraph: cave culling through chunk face connectivity. Each chunk keeps
+    // which pairs of its faces are joined by air inside it, computed by ComputeConnectivity()
+    // when the chunk is meshed. Traverse() walks from the camera chunk to its neighbours, only
+    // leaving a chunk through a face connected to the one it was entered by, never turning
+    // back against a direction already taken, and only into chunks the frustum intersects.
+    // Chunks the graph has no entry for are air and connect everything; the walk ends at the
+    // given distance from the camera chunk.
+    //--------------------------------------------------------------------------------
+    class CORE_API ChunkVisibilityGraph
+    {
+    public:
+        // Flood fills the air of the chunk face to face; anything but air blocks sight.
+        static ChunkConnectivity ComputeConnectivity(const VoxelChunk& chunk);
+
+        void Set(const Int3& chunkPos, ChunkConnectivity connectivity);
+
+        // Computes the connectivity of the chunk in the map, or drops the entry when there is none.
+        void Update(const ChunkedVoxelMap& map, const Int3& chunkPos);
+
+        bool Remove(const Int3& chunkPos);
+
+        void Clear() { connectivity_.clear(); }
+
+        ChunkConnectivity Connectivity(const Int3& chunkPos) const;
+
+        bool Contains(const Int3& chunkPos) const { return connectivity_.contains(chunkPos); }
+
+        std::size_t Size() const { return connectivity_.size(); }
+
+        // Fills visible with the chunks the graph has an entry for that are reachable from the chunk
+        // holding the eye, in the order reached, the camera chunk first. Throws std::invalid_argument
+        // for a negative maxDistance, in chunks.
+        void Traverse(const Vector3F& eye, const Frustum& frustum, int maxDistance, std::vector<Int3>& visible);
+
+    private:
+        struct Step
+        {
+            Int3    ChunkPos;
+            int8_t  EnteredBy; // face of this chunk the walk came through, -1 for the camera chunk
+            uint8_t Directions;
+        };
+
+        std::unordered_map<Int3, ChunkConnectivity, Int3Hasher> connectivity_;
+        std::vector<uint8_t>                                    visited_; // a cube around the camera chunk
+        std::vector<Step>                                       queue_;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,291 @@
+#include "Voxel/ChunkedVoxelMap.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <stdexcept>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        // Process-wide, so a version never names the chunk table of two maps.
+        std::atomic<uint64_t> nextTableVersion {1};
+
+        uint64_t NewTableVersion() { return nextTableVersion.fetch_add(1, std::memory_order_relaxed); }
+    } // namespace
+
+    ChunkedVoxelMap::ChunkedVoxelMap(int maxKind, int sizeX, int sizeY, int sizeZ) :
+        IVoxelMap(maxKind), tableVersion_(NewTableVersion()), sizeX_(sizeX), sizeY_(sizeY), sizeZ_(sizeZ)
+    {
+        if (maxKind < 0 || maxKind > 0xFFFF)
+        {
+            throw std::invalid_argument("maxKind must fit in a BlockKind");
+        }
+        if (sizeX <= 0 || sizeY <= 0 || sizeZ <= 0)
+        {
+            throw std::invalid_argument("Map size must be greater than 0");
+        }
+    }
+
+    template<typename Func>
+    void ChunkedVoxelMap::ForEachChunkInBox(const Int3& origin, const Int3& size, Func&& func)
+    {
+        // Int3 is packed, so its fields are copied before std::max() binds references to them.
+        const int minX = std::max(int {origin.X}, 0);
+        const int minY = std::max(int {origin.Y}, 0);
+        const int minZ = std::max(int {origin.Z}, 0);
+        const int maxX = std::min(origin.X + size.X, sizeX_);
+        const int maxY = std::min(origin.Y + size.Y, sizeY_);
+        const int maxZ = std::min(origin.Z + size.Z, sizeZ_);
+        if (minX >= maxX || minY >= maxY || minZ >= maxZ)
+            return;
+
+        for (int cy = minY >> CHUNK_SHIFT; cy <= (maxY - 1) >> CHUNK_SHIFT; ++cy)
+        {
+            for (int cz = minZ >> CHUNK_SHIFT; cz <= (maxZ - 1) >> CHUNK_SHIFT; ++cz)
+            {
+                for (int cx = minX >> CHUNK_SHIFT; cx <= (maxX - 1) >> CHUNK_SHIFT; ++cx)
+                {
+                    const Int3 lo(std::max(minX - (cx << CHUNK_SHIFT), 0), std::max(minY - (cy << CHUNK_SHIFT), 0), std::max(minZ - (cz << CHUNK_SHIFT), 0));
+                    const Int3 hi(std::min(maxX - (cx << CHUNK_SHIFT), CHUNK_SIZE),
+                                  std::min(maxY - (cy << CHUNK_SHIFT), CHUNK_SIZE),
+                                  std::min(maxZ - (cz << CHUNK_SHIFT), CHUNK_SIZE));
+                    func(Int3(cx, cy, cz), lo, hi);
+                }
+            }
+        }
+    }
+
+    bool ChunkedVoxelMap::BlockKindExists(int index) const { return index >= 0 && index <= MAX_KIND; }
+
+    bool ChunkedVoxelMap::OutOfBounds(int x, int y, int z) const
+    {
+        // Unsigned compare folds the negative check into the upper bound check.
+        return static_cast<unsigned>(x) >= static_cast<unsigned>(sizeX_) || static_cast<unsigned>(y) >= static_cast<unsigned>(sizeY_) ||
+               static_cast<unsigned>(z) >= static_cast<unsigned>(sizeZ_);
+    }
+
+    void ChunkedVoxelMap::AddBlockFromMagicVoxel(int x, int y, int z, int index) { SetBlock(x, y, z, static_cast<BlockKind>(index)); }
+
+    void ChunkedVoxelMap::AddBlocks(std::span<const VoxelWrite> writes)
+    {
+        // Scattered writes tend to come in spatially coherent order, so keep the last chunk around.
+        VoxelChunk* chunk    = nullptr;
+        Int3        chunkPos = Int3::Invalid;
+        for (const VoxelWrite& write : writes)
+        {
+            const Int3& p = write.Position;
+            if (OutOfBounds(p.X, p.Y, p.Z))
+                continue;
+
+            const Int3 pos = ChunkOf(p.X, p.Y, p.Z);
+            if (chunk == nullptr || !(pos == chunkPos))
+            {
+                chunkPos = pos;
+                if (concurrentWrites_)
+                {
+                    // Other threads read the chunk table, so it must not change.
+                    chunk = GetChunk(pos);
+                    assert(chunk != nullptr && "concurrent write outside the prepared chunks");
+                }
+                else
+                {
+                    chunk = write.Kind == AIR_KIND ? GetChunk(pos) : &GetOrCreateChunk(pos);
+                }
+                if (chunk == nullptr)
+                    continue;
+            }
+            chunk->Set(p.X & CHUNK_MASK, p.Y & CHUNK_MASK, p.Z & CHUNK_MASK, write.Kind);
+        }
+    }
+
+    void ChunkedVoxelMap::AddBlockBox(const Int3& origin, const Int3& size, std::span<const BlockKind> kinds)
+    {
+        auto extent = [](int length) { return static_cast<std::size_t>(std::max(length, 0)); };
+        if (kinds.size() < extent(size.X) * extent(size.Y) * extent(size.Z))
+        {
+            throw std::invalid_argument("Not enough kinds for the box size");
+        }
+
+        const std::size_t strideZ = extent(size.X);
+        const std::size_t strideY = strideZ * extent(size.Z);
+
+        ForEachChunkInBox(origin, size, [&](const Int3& chunkPos, const Int3& lo, const Int3& hi) {
+            const int         baseX     = (chunkPos.X << CHUNK_SHIFT) - origin.X;
+            const int         baseY     = (chunkPos.Y << CHUNK_SHIFT) - origin.Y;
+            const int         baseZ     = (chunkPos.Z << CHUNK_SHIFT) - origin.Z;
+            const std::size_t runLength = static_cast<std::size_t>(hi.X - lo.X);
+
+            // The voxels copied lie inside the box, so none of their offsets from its origin is negative.
+            auto sourceRun = [&](int y, int z) {
+                const std::size_t row = static_cast<std::size_t>(baseY + y) * strideY + static_cast<std::size_t>(baseZ + z) * strideZ;
+                return kinds.subspan(row + static_cast<std::size_t>(baseX + lo.X), runLength);
+            };
+
+            VoxelChunk* chunk = GetChunk(chunkPos);
+            if (chunk == nullptr)
+            {
+                // Only materialize the chunk if the source actually has something solid for it.
+                bool anySolid = false;
+                for (int y = lo.Y; y < hi.Y && !anySolid; ++y)
+                    for (int z = lo.Z; z < hi.Z && !anySolid; ++z)
+                    {
+                        auto run = sourceRun(y, z);
+                        anySolid = std::any_of(run.begin(), run.end(), [](BlockKind k) { return k != AIR_KIND; });
+                    }
+                if (!anySolid)
+                    return;
+                chunk = &GetOrCreateChunk(chunkPos);
+            }
+
+            for (int y = lo.Y; y < hi.Y; ++y)
+                for (int z = lo.Z; z < hi.Z; ++z)
+                    chunk->SetRun(ChunkIndex(lo.X, y, z), sourceRun(y, z));
+        });
+    }
+
+    void ChunkedVoxelMap::FillBlocks(const Int3& origin, const Int3& size, BlockKind kind)
+    {
+        ForEachChunkInBox(origin, size, [&](const Int3& chunkPos, const Int3& lo, const Int3& hi) {
+            const bool whole = lo.X == 0 && lo.Y == 0 && lo.Z == 0 && hi.X == CHUNK_SIZE && hi.Y == CHUNK_SIZE && hi.Z == CHUNK_SIZE;
+            if (kind == AIR_KIND)
+            {
+                if (whole)
+                {
+                    RemoveChunk(chunkPos);
+                }
+                else if (VoxelChunk* chunk = GetChunk(chunkPos))
+                {
+                    chunk->FillBox(lo.X, lo.Y, lo.Z, hi.X, hi.Y, hi.Z, kind);
+                }
+                return;
+            }
+            GetOrCreateChunk(chunkPos).FillBox(lo.X, lo.Y, lo.Z, hi.X, hi.Y, hi.Z, kind);
+        });
+    }
+
+    bool ChunkedVoxelMap::PrepareConcurrentChunkWrites(std::span<const Int3> chunkPositions)
+    {
+        for (const Int3& chunkPos : chunkPositions)
+        {
+            const int x = chunkPos.X << CHUNK_SHIFT;
+            const int y = chunkPos.Y << CHUNK_SHIFT;
+            const int z = chunkPos.Z << CHUNK_SHIFT;
+            if (x + CHUNK_SIZE <= 0 || y + CHUNK_SIZE <= 0 || z + CHUNK_SIZE <= 0 || x >= sizeX_ || y >= sizeY_ || z >= sizeZ_)
+                continue;
+            if (GetChunk(chunkPos) == nullptr)
+            {
+                GetOrCreateChunk(chunkPos);
+                preparedChunks_.push_back(chunkPos);
+            }
+        }
+        concurrentWrites_ = true;
+        return true;
+    }
+
+    void ChunkedVoxelMap::FinishConcurrentChunkWrites()
+    {
+        for (const Int3& chunkPos : preparedChunks_)
+        {
+            const VoxelChunk* chunk = GetChunk(chunkPos);
+            if (chunk != nullptr && chunk->IsEmpty())
+                RemoveChunk(chunkPos);
+        }
+        preparedChunks_.clear();
+        concurrentWrites_ = false;
+    }
+
+    BlockKind ChunkedVoxelMap::GetBlock(int x, int y, int z) const
+    {
+        const VoxelChunk* chunk = GetChunk(ChunkOf(x, y, z));
+        if (chunk == nullptr)
+            return AIR_KIND;
+        return chunk->Get(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK);
+    }
+
+    void ChunkedVoxelMap::SetBlock(int x, int y, int z, BlockKind kind)
+    {
+        if (OutOfBounds(x, y, z))
+        {
+            throw std::out_of_range("Voxel coordinate outside map bounds");
+        }
+
+        const Int3 chunkPos = ChunkOf(x, y, z);
+        if (kind == AIR_KIND)
+        {
+            VoxelChunk* chunk = GetChunk(chunkPos);
+            if (chunk != nullptr)
+                chunk->Set(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK, kind);
+            return;
+        }
+
+        GetOrCreateChunk(chunkPos).Set(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK, kind);
+    }
+
+    VoxelChunk* ChunkedVoxelMap::GetChunk(const Int3& chunkPos)
+    {
+        auto it = chunks_.find(chunkPos);
+        return it == chunks_.end() ? nullptr : it->second.get();
+    }
+
+    const VoxelChunk* ChunkedVoxelMap::GetChunk(const Int3& chunkPos) const
+    {
+        auto it = chunks_.find(chunkPos);
+        return it == chunks_.end() ? nullptr : it->second.get();
+    }
+
+    std::shared_ptr<const VoxelChunk> ChunkedVoxelMap::Snapshot(const Int3& chunkPos) const
+    {
+        const VoxelChunk* chunk = GetChunk(chunkPos);
+        return chunk != nullptr ? std::make_shared<const VoxelChunk>(*chunk) : nullptr;
+    }
+
+    VoxelChunk& ChunkedVoxelMap::GetOrCreateChunk(const Int3& chunkPos)
+    {
+        auto& slot = chunks_[chunkPos];
+        if (!slot)
+        {
+            slot          = std::make_unique<VoxelChunk>();
+            tableVersion_ = NewTableVersion();
+        }
+        return *slot;
+    }
+
+    bool ChunkedVoxelMap::RemoveChunk(const Int3& chunkPos)
+    {
+        if (chunks_.erase(chunkPos) == 0)
+            return false;
+        tableVersion_ = NewTableVersion();
+        return true;
+    }
+
+    void ChunkedVoxelMap::Compact()
+    {
+        for (auto it = chunks_.begin(); it != chunks_.end();)
+        {
+            VoxelChunk& chunk = *it->second;
+            chunk.Compact();
+            if (chunk.IsUniform() && chunk.Palette()[0] == AIR_KIND)
+            {
+                it            = chunks_.erase(it);
+                tableVersion_ = NewTableVersion();
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    std::size_t ChunkedVoxelMap::MemoryUsage() const
+    {
+        std::size_t bytes = 0;
+        for (const auto& [pos, chunk] : chunks_)
+        {
+            bytes += sizeof(VoxelChunk) + chunk->MemoryUsage();
+        }
+        return bytes;
+    }
+
+} // namespace Voxium::Core
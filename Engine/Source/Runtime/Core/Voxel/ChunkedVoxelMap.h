@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Voxel/IVoxelMap.h"
+#include "Voxel/VoxelChunk.h"
+
+namespace Voxium::Core
+{
+    struct Int3Hasher
+    {
+        std::size_t operator()(const Int3& v) const noexcept { return v.GetHashCode(); }
+    };
+
+    // Chunk coordinate containing the given world voxel coordinate (floor division by CHUNK_SIZE).
+    constexpr Int3 ChunkOf(int x, int y, int z) { return Int3(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT, z >> CHUNK_SHIFT); }
+
+    //--------------------------------------------------------------------------------
+    // ChunkedVoxelMap: first-party IVoxelMap backed by palette-compressed 32^3 chunks
+    // keyed by chunk coordinate. Chunks are created lazily on the first non-air
+    // write, so untouched space costs nothing.
+    //
+    // The map does not report its edits. Structures derived from it (heightmaps,
+    // walkable surfaces, lighting, meshes) expose On...Changed() or Mark...Dirty()
+    // hooks, and the code that edits the map, including chunk streaming and
+    // generation, calls them right after each edit.
+    //--------------------------------------------------------------------------------
+    class CORE_API ChunkedVoxelMap : public IVoxelMap
+    {
+    public:
+        ChunkedVoxelMap(int maxKind, int sizeX, int sizeY, int sizeZ);
+
+        bool BlockKindExists(int index) const override;
+
+        bool OutOfBounds(int x, int y, int z) const override;
+
+        void AddBlockFromMagicVoxel(int x, int y, int z, int index) override;
+
+        void AddBlocks(std::span<const VoxelWrite> writes) override;
+
+        void AddBlockBox(const Int3& origin, const Int3& size, std::span<const BlockKind> kinds) override;
+
+        void FillBlocks(const Int3& origin, const Int3& size, BlockKind kind) override;
+
+        // Creates every listed in-bounds chunk up front. Until FinishConcurrentChunkWrites(),
+        // AddBlocks() only looks chunks up, so threads never modify the chunk table; other edits
+        // must wait.
+        bool PrepareConcurrentChunkWrites(std::span<const Int3> chunkPositions) override;
+
+        // Drops the prepared chunks that stayed pure air.
+        void FinishConcurrentChunkWrites() override;
+
+        // Returns AIR_KIND for voxels in chunks that were never written.
+        BlockKind GetBlock(int x, int y, int z) const;
+
+        // Throws std::out_of_range for coordinates outside the map bounds.
+        void SetBlock(int x, int y, int z, BlockKind kind);
+
+        VoxelChunk* GetChunk(const Int3& chunkPos);
+
+        const VoxelChunk* GetChunk(const Int3& chunkPos) const;
+
+        // Copy-on-write copy of a chunk, or nullptr if there is none: O(1), and unchanged by later
+        // edits of the map, so it can be handed to jobs on other threads.
+        std::shared_ptr<const VoxelChunk> Snapshot(const Int3& chunkPos) const;
+
+        VoxelChunk& GetOrCreateChunk(const Int3& chunkPos);
+
+        bool RemoveChunk(const Int3& chunkPos);
+
+        // Compacts every chunk palette and drops chunks that became pure air.
+        void Compact();
+
+        template<typename Func>
+        void ForEachChunk(Func&& func) const
+        {
+            for (const auto& [pos, chunk] : chunks_)
+            {
+                func(pos, *chunk);
+            }
+        }
+
+        std::size_t ChunkCount() const { return chunks_.size(); }
+
+        // Changes whenever a chunk is created or removed and is never shared with another map, so
+        // readers may keep chunk pointers for as long as it stays the same.
+        uint64_t ChunkTableVersion() const { return tableVersion_; }
+
+        // Heap bytes held by chunk payloads (palettes and packed indices).
+        std::size_t MemoryUsage() const;
+
+        int SizeX() const { return sizeX_; }
+        int SizeY() const { return sizeY_; }
+        int SizeZ() const { return sizeZ_; }
+
+    private:
+        // Clips the box to the map bounds and calls func(chunkPos, localMin, localMax) for every
+        // chunk it overlaps, where the local range is half-open.
+        template<typename Func>
+        void ForEachChunkInBox(const Int3& origin, const Int3& size, Func&& func);
+
+        std::unordered_map<Int3, std::unique_ptr<VoxelChunk>, Int3Hasher> chunks_;
+        std::vector<Int3>                                                  preparedChunks_; // created by PrepareConcurrentChunkWrites()
+        bool                                                               concurrentWrites_ = false;
+        uint64_t                                                           tableVersion_;
+
+        int sizeX_;
+        int sizeY_;
+        int sizeZ_;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,227 @@
+#include "Voxel/ColumnHeightmap.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr std::size_t ColumnIndex(int x, int z) { return static_cast<std::size_t>((x & CHUNK_MASK) | (z & CHUNK_MASK) << CHUNK_SHIFT); }
+    } // namespace
+
+    ColumnHeightmap::ColumnHeightmap(const ChunkedVoxelMap& map) :
+        map_(map), columnsX_((map.SizeX() + CHUNK_SIZE - 1) >> CHUNK_SHIFT), columnsZ_((map.SizeZ() + CHUNK_SIZE - 1) >> CHUNK_SHIFT),
+        kindTypes_(static_cast<std::size_t>(map.MAX_KIND) + 1, ALL_TYPES), columns_(static_cast<std::size_t>(columnsX_ * columnsZ_))
+    {
+        if (map.SizeY() > std::numeric_limits<int16_t>::max())
+            throw std::invalid_argument("Map too tall for the heightmap");
+        kindTypes_[AIR_KIND] = 0;
+    }
+
+    void ColumnHeightmap::SetKindProperties(BlockKind kind, bool opaque, bool motionBlocking)
+    {
+        if (kind == AIR_KIND)
+            throw std::invalid_argument("Air has no height");
+        if (kind >= kindTypes_.size())
+            throw std::out_of_range("Block kind above the map's MAX_KIND");
+        kindTypes_[kind] = static_cast<uint8_t>(opaque << static_cast<int>(HeightmapType::Opaque) | 1 << static_cast<int>(HeightmapType::NonAir) |
+                                                motionBlocking << static_cast<int>(HeightmapType::MotionBlocking));
+    }
+
+    void ColumnHeightmap::Rebuild()
+    {
+        // Only chunk columns holding a chunk can have a height, and none above their top chunk.
+        std::vector<int> topChunk(columns_.size(), -1);
+        map_.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk&) {
+            int& top = topChunk[static_cast<std::size_t>(chunkPos.Z * columnsX_ + chunkPos.X)];
+            top      = std::max(top, chunkPos.Y);
+        });
+
+        for (std::size_t column = 0; column < columns_.size(); ++column)
+        {
+            if (topChunk[column] < 0)
+            {
+                columns_[column].reset();
+                continue;
+            }
+            const int cx = static_cast<int>(column) % columnsX_;
+            const int cz = static_cast<int>(column) / columnsX_;
+            Heights&  heights = GetOrCreateColumn(cx << CHUNK_SHIFT, cz << CHUNK_SHIFT);
+            const int top     = std::min(map_.SizeY() - 1, (topChunk[column] << CHUNK_SHIFT) + CHUNK_MASK);
+            for (int lz = 0; lz < CHUNK_SIZE; ++lz)
+                for (int lx = 0; lx < CHUNK_SIZE; ++lx)
+                {
+                    const auto found = ScanDown((cx << CHUNK_SHIFT) + lx, (cz << CHUNK_SHIFT) + lz, top, 0, ALL_TYPES);
+                    for (std::size_t type = 0; type < HEIGHTMAP_TYPE_COUNT; ++type)
+                        heights[type][ColumnIndex(lx, lz)] = static_cast<int16_t>(found[type]);
+                }
+        }
+    }
+
+    void ColumnHeightmap::OnBlockChanged(int x, int y, int z)
+    {
+        if (map_.OutOfBounds(x, y, z))
+            throw std::out_of_range("Block position outside the map");
+
+        const uint8_t types   = kindTypes_[map_.GetBlock(x, y, z)];
+        Heights*      heights = FindColumn(x, z);
+        if (heights == nullptr)
+        {
+            if (types == 0)
+                return;
+            heights = &GetOrCreateColumn(x, z);
+        }
+
+        // Raising is a store; lowering only happens when the top voxel itself stops counting.
+        const std::size_t index  = ColumnIndex(x, z);
+        uint8_t           rescan = 0;
+        for (std::size_t type = 0; type < HEIGHTMAP_TYPE_COUNT; ++type)
+        {
+            int16_t& height = (*heights)[type][index];
+            if (types >> type & 1)
+                height = std::max(height, static_cast<int16_t>(y));
+            else if (height == y)
+                rescan |= static_cast<uint8_t>(1 << type);
+        }
+        if (rescan == 0)
+            return;
+
+        ++rescans_;
+        const auto found = ScanDown(x, z, y - 1, 0, rescan);
+        for (std::size_t type = 0; type < HEIGHTMAP_TYPE_COUNT; ++type)
+            if (rescan >> type & 1)
+                (*heights)[type][index] = static_cast<int16_t>(found[type]);
+    }
+
+    void ColumnHeightmap::OnBoxChanged(const Int3& origin, const Int3& size)
+    {
+        const int minX = std::max(origin.X, 0);
+        const int minY = std::max(origin.Y, 0);
+        const int minZ = std::max(origin.Z, 0);
+        const int maxX = std::min(origin.X + size.X, map_.SizeX()) - 1;
+        const int maxY = std::min(origin.Y + size.Y, map_.SizeY()) - 1;
+        const int maxZ = std::min(origin.Z + size.Z, map_.SizeZ()) - 1;
+        if (minX > maxX || minY > maxY || minZ > maxZ)
+            return;
+
+        for (int z = minZ; z <= maxZ; ++z)
+            for (int x = minX; x <= maxX; ++x)
+            {
+                // Heights above the box stay; the others are the highest voxel in the box, or,
+                // when the box has none, the old height below it or a scan further down.
+                Heights*          heights = FindColumn(x, z);
+                const std::size_t index   = ColumnIndex(x, z);
+                uint8_t           types   = 0;
+                for (std::size_t type = 0; type < HEIGHTMAP_TYPE_COUNT; ++type)
+                    if (heights == nullptr || (*heights)[type][index] <= maxY)
+                        types |= static_cast<uint8_t>(1 << type);
+                if (types == 0)
+                    continue;
+
+                const auto inBox   = ScanDown(x, z, maxY, minY, types);
+                uint8_t    rescan  = 0;
+                bool       changed = false;
+                for (std::size_t type = 0; type < HEIGHTMAP_TYPE_COUNT; ++type)
+                {
+                    const int old = heights != nullptr ? (*heights)[type][index] : NO_HEIGHT;
+                    if (!(types >> type & 1))
+                        continue;
+                    if (inBox[type] == NO_HEIGHT && old >= minY)
+                        rescan |= static_cast<uint8_t>(1 << type);
+                    changed |= inBox[type] != NO_HEIGHT && inBox[type] != old;
+                }
+                if (!changed && rescan == 0)
+                    continue;
+
+                Heights&   column = heights != nullptr ? *heights : GetOrCreateColumn(x, z);
+                const auto below  = rescan != 0 ? ScanDown(x, z, minY - 1, 0, rescan) : std::array<int, HEIGHTMAP_TYPE_COUNT> {};
+                rescans_ += rescan != 0;
+                for (std::size_t type = 0; type < HEIGHTMAP_TYPE_COUNT; ++type)
+                {
+                    if (inBox[type] != NO_HEIGHT)
+                        column[type][index] = static_cast<int16_t>(inBox[type]);
+                    else if (rescan >> type & 1)
+                        column[type][index] = static_cast<int16_t>(below[type]);
+                }
+            }
+    }
+
+    void ColumnHeightmap::OnChunkChanged(const Int3& chunkPos)
+    {
+        OnBoxChanged(ChunkBoundsMin(chunkPos), Int3(CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE));
+    }
+
+    int ColumnHeightmap::Height(HeightmapType type, int x, int z) const
+    {
+        if (map_.OutOfBounds(x, 0, z))
+            throw std::out_of_range("Column outside the map");
+        const Heights* heights = FindColumn(x, z);
+        return heights != nullptr ? (*heights)[static_cast<std::size_t>(type)][ColumnIndex(x, z)] : NO_HEIGHT;
+    }
+
+    std::size_t ColumnHeightmap::MemoryUsage() const
+    {
+        std::size_t bytes = columns_.capacity() * sizeof(std::unique_ptr<Heights>) + kindTypes_.capacity();
+        for (const auto& column : columns_)
+            bytes += column != nullptr ? sizeof(Heights) : 0;
+        return bytes;
+    }
+
+    ColumnHeightmap::Heights* ColumnHeightmap::FindColumn(int x, int z) const
+    {
+        return columns_[static_cast<std::size_t>((z >> CHUNK_SHIFT) * columnsX_ + (x >> CHUNK_SHIFT))].get();
+    }
+
+    ColumnHeightmap::Heights& ColumnHeightmap::GetOrCreateColumn(int x, int z)
+    {
+        std::unique_ptr<Heights>& column = columns_[static_cast<std::size_t>((z >> CHUNK_SHIFT) * columnsX_ + (x >> CHUNK_SHIFT))];
+        if (column == nullptr)
+        {
+            column = std::make_unique<Heights>();
+            for (auto& heights : *column)
+                heights.fill(static_cast<int16_t>(NO_HEIGHT));
+        }
+        return *column;
+    }
+
+    std::array<int, HEIGHTMAP_TYPE_COUNT> ColumnHeightmap::ScanDown(int x, int z, int top, int bottom, uint8_t types) const
+    {
+        std::array<int, HEIGHTMAP_TYPE_COUNT> found;
+        found.fill(NO_HEIGHT);
+        const int lx = x & CHUNK_MASK;
+        const int lz = z & CHUNK_MASK;
+        for (int cy = top >> CHUNK_SHIFT; cy >= bottom >> CHUNK_SHIFT && types != 0 && top >= bottom; --cy)
+        {
+            const VoxelChunk* chunk = map_.GetChunk(Int3(x >> CHUNK_SHIFT, cy, z >> CHUNK_SHIFT));
+            const int         first = std::min(top, (cy << CHUNK_SHIFT) + CHUNK_MASK);
+            const int         last  = std::max(bottom, cy << CHUNK_SHIFT);
+            if (chunk == nullptr || chunk->IsEmpty())
+                continue;
+
+            if (chunk->IsUniform())
+            {
+                const uint8_t hit = kindTypes_[chunk->Palette()[0]] & types;
+                for (std::size_t type = 0; type < HEIGHTMAP_TYPE_COUNT; ++type)
+                    if (hit >> type & 1)
+                        found[type] = first;
+                types &= static_cast<uint8_t>(~hit);
+                continue;
+            }
+
+            for (int y = first; y >= last && types != 0; --y)
+            {
+                const uint8_t hit = kindTypes_[chunk->Get(lx, y & CHUNK_MASK, lz)] & types;
+                if (hit == 0)
+                    continue;
+                for (std::size_t type = 0; type < HEIGHTMAP_TYPE_COUNT; ++type)
+                    if (hit >> type & 1)
+                        found[type] = y;
+                types &= static_cast<uint8_t>(~hit);
+            }
+        }
+        return found;
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Core
+{
+    enum class HeightmapType : uint8_t
+    {
+        Opaque,
+        NonAir,
+        MotionBlocking
+    };
+
+    constexpr int HEIGHTMAP_TYPE_COUNT = 3;
+
+    //--------------------------------------------------------------------------------
+    // ColumnHeightmap: the highest opaque, non-air and motion-blocking voxel of every
+    // (x, z) column of a ChunkedVoxelMap, kept per chunk column and updated with the
+    // edits. A block placed above a height raises it and anything placed below leaves
+    // it alone, both O(1); only removing the top block of a column scans down, chunk by
+    // chunk, skipping missing chunks and deciding uniform ones at once.
+    //
+    // Edits are reported with OnBlockChanged(), OnBoxChanged() or OnChunkChanged().
+    // Every non-air kind is opaque and motion-blocking until SetKindProperties() says
+    // otherwise; call Rebuild() after changing kinds that are already in the map.
+    // Everything belongs to the thread that edits the map.
+    //--------------------------------------------------------------------------------
+    class CORE_API ColumnHeightmap
+    {
+    public:
+        static constexpr int NO_HEIGHT = -1;
+
+        // Throws std::invalid_argument for maps taller than int16_t heights can hold.
+        explicit ColumnHeightmap(const ChunkedVoxelMap& map);
+
+        // Throws std::invalid_argument for AIR_KIND and std::out_of_range above the map's MAX_KIND.
+        void SetKindProperties(BlockKind kind, bool opaque, bool motionBlocking);
+
+        bool IsOpaque(BlockKind kind) const { return Counts(kind, HeightmapType::Opaque); }
+
+        bool IsMotionBlocking(BlockKind kind) const { return Counts(kind, HeightmapType::MotionBlocking); }
+
+        // Scans the whole map.
+        void Rebuild();
+
+        // Raises the column's heights to y if the voxel's new kind counts for them, or scans the
+        // column down if it held their top. Throws std::out_of_range outside the map.
+        void OnBlockChanged(int x, int y, int z);
+
+        // Call after changing a box of the map, e.g. FillBlocks(); the box is clipped to the map.
+        void OnBoxChanged(const Int3& origin, const Int3& size);
+
+        // OnBoxChanged() over the chunk's voxels, after the chunk was streamed in, generated or
+        // unloaded.
+        void OnChunkChanged(const Int3& chunkPos);
+
+        // Highest y of the column that holds a voxel of the type, or NO_HEIGHT. Throws
+        // std::out_of_range outside the map.
+        int Height(HeightmapType type, int x, int z) const;
+
+        // Columns whose top block was removed and had to be scanned down, since construction.
+        uint64_t RescanCount() const { return rescans_; }
+
+        std::size_t MemoryUsage() const;
+
+    private:
+        using Heights = std::array<std::array<int16_t, CHUNK_AREA>, HEIGHTMAP_TYPE_COUNT>;
+
+        static constexpr uint8_t ALL_TYPES = (1 << HEIGHTMAP_TYPE_COUNT) - 1;
+
+        bool Counts(BlockKind kind, HeightmapType type) const { return (kindTypes_[kind] >> static_cast<int>(type) & 1) != 0; }
+
+        Heights* FindColumn(int x, int z) const;
+
+        Heights& GetOrCreateColumn(int x, int z);
+
+        // Highest y in [bottom, top] holding each type in the mask; unwanted types and types not
+        // found are left at NO_HEIGHT.
+        std::array<int, HEIGHTMAP_TYPE_COUNT> ScanDown(int x, int z, int top, int bottom, uint8_t types) const;
+
+        const ChunkedVoxelMap&                map_;
+        int                                   columnsX_;
+        int                                   columnsZ_;
+        std::vector<uint8_t>                  kindTypes_; // bit per HeightmapType
+        std::vector<std::unique_ptr<Heights>> columns_;   // per chunk column, cz * columnsX_ + cx
+        uint64_t                              rescans_ = 0;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Hash.h"
+#include "Math/Int3.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // ConcurrentChunkMap: open-addressing Int3 -> T* table with wait-free lookups.
+    // Keys are packed into one 64-bit word and mixed with MixBits; slots are probed
+    // linearly, four to a cache line. Find() never blocks and never retries: it reads
+    // the current table, probes until it meets the key or an empty slot, which the load
+    // limit guarantees, and checks the key again after reading the value. Insert, Assign
+    // and Erase take a mutex, so writers from any number of threads are serialised
+    // against each other but never against readers.
+    //
+    // The map does not own the values. An erased value may still be returned by a Find()
+    // that started before the erase, so freeing it must wait until such readers are done.
+    // Growing retires the old table instead of freeing it, for the same reason; Reclaim()
+    // frees retired tables once no Find() can still be running on them.
+    //--------------------------------------------------------------------------------
+    template<typename T>
+    class ConcurrentChunkMap
+    {
+    public:
+        // Keys must lie within [-COORD_LIMIT, COORD_LIMIT) on every axis.
+        static constexpr int COORD_BITS  = 21;
+        static constexpr int COORD_LIMIT = 1 << (COORD_BITS - 1);
+
+        explicit ConcurrentChunkMap(std::size_t expectedSize = 0) : table_(NewTable(CapacityFor(expectedSize)).release()) {}
+
+        ~ConcurrentChunkMap() { delete table_.load(std::memory_order_relaxed); }
+
+        ConcurrentChunkMap(const ConcurrentChunkMap&)            = delete;
+        ConcurrentChunkMap& operator=(const ConcurrentChunkMap&) = delete;
+
+        // Wait-free; safe from any thread. Returns nullptr for absent keys, including keys out of range.
+        T* Find(const Int3& key) const
+        {
+            if (!InRange(key))
+                return nullptr;
+            const uint64_t packed = Pack(key);
+            const Table*   table  = table_.load(std::memory_order_acquire);
+            for (std::size_t i = MixBits(packed) & table->Mask;; i = (i + 1) & table->Mask)
+            {
+                const uint64_t stored = table->Slots[i].Key.load(std::memory_order_acquire);
+                if (stored == packed)
+                {
+                    // Erase and Store may have reused the slot for another key since the key was read,
+                    // so the value only counts if the key is still there after it; otherwise the key
+                    // was erased during the call, which is a miss.
+                    T* value = table->Slots[i].Value.load(std::memory_order_acquire);
+                    return table->Slots[i].Key.load(std::memory_order_relaxed) == packed ? value : nullptr;
+                }
+                if (stored == EMPTY)
+                    return nullptr;
+            }
+        }
+
+        bool Contains(const Int3& key) const { return Find(key) != nullptr; }
+
+        // Returns false and leaves the map unchanged if the key is present. Throws
+        // std::out_of_range for keys outside the coordinate limit and std::invalid_argument for null values.
+        bool Insert(const Int3& key, T* value) { return Store(key, value, false) == nullptr; }
+
+        // Inserts or replaces, and returns the previous value or nullptr.
+        T* Assign(const Int3& key, T* value) { return Store(key, value, true); }
+
+        // Returns the removed value, or nullptr if the key was absent.
+        T* Erase(const Int3& key)
+        {
+            if (!InRange(key))
+                return nullptr;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            Table*                      table = table_.load(std::memory_order_relaxed);
+            const std::size_t           slot  = Locate(*table, Pack(key));
+            if (slot == NOT_FOUND)
+                return nullptr;
+
+            Slot& erased   = table->Slots[slot];
+            T*    previous = erased.Value.load(std::memory_order_relaxed);
+            erased.Value.store(nullptr, std::memory_order_relaxed);
+            --size_;
+
+            // With linear probing, no probe sequence runs through a slot that is followed by an
+            // empty one, so such a slot (and the tombstones right before it) can become empty
+            // again. That keeps tombstones, and with them rehashes, rare under streaming churn.
+            if (table->Slots[(slot + 1) & table->Mask].Key.load(std::memory_order_relaxed) != EMPTY)
+            {
+                erased.Key.store(TOMBSTONE, std::memory_order_release);
+                ++tombstones_;
+                return previous;
+            }
+            erased.Key.store(EMPTY, std::memory_order_release);
+            for (std::size_t i = (slot - 1) & table->Mask; table->Slots[i].Key.load(std::memory_order_relaxed) == TOMBSTONE; i = (i - 1) & table->Mask)
+            {
+                table->Slots[i].Key.store(EMPTY, std::memory_order_release);
+                --tombstones_;
+            }
+            return previous;
+        }
+
+        // Writer-side visit of every entry as func(key, value); must not modify the map.
+        template<typename Func>
+        void ForEach(Func&& func) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const Table*                table = table_.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i <= table->Mask; ++i)
+            {
+                const uint64_t stored = table->Slots[i].Key.load(std::memory_order_relaxed);
+                if (stored != EMPTY && stored != TOMBSTONE)
+                    func(Unpack(stored), table->Slots[i].Value.load(std::memory_order_relaxed));
+            }
+        }
+
+        std::size_t Size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return size_;
+        }
+
+        std::size_t Capacity() const { return table_.load(std::memory_order_acquire)->Mask + 1; }
+
+        // Frees the tables retired by rehashing. Only call when no Find() that started before the
+        // last rehash can still be running, e.g. between frames with the worker jobs joined.
+        void Reclaim()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            retired_.clear();
+        }
+
+        // Bytes held by retired tables, waiting for Reclaim().
+        std::size_t RetiredBytes() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::size_t                 bytes = 0;
+            for (const std::unique_ptr<Table>& table : retired_)
+                bytes += (table->Mask + 1) * sizeof(Slot);
+            return bytes;
+        }
+
+    private:
+        static constexpr uint64_t    EMPTY        = ~0ull;
+        static constexpr uint64_t    TOMBSTONE    = ~0ull - 1;
+        static constexpr std::size_t NOT_FOUND    = ~std::size_t(0);
+        static constexpr std::size_t MIN_CAPACITY = 16;
+        static constexpr uint64_t    COORD_MASK   = (1ull << COORD_BITS) - 1;
+
+        // Key and value of one entry; four slots share a cache line.
+        struct alignas(16) Slot
+        {
+            std::atomic<uint64_t> Key {EMPTY};
+            std::atomic<T*>       Value {nullptr};
+        };
+
+        struct Table
+        {
+            std::size_t             Mask;
+            std::unique_ptr<Slot[]> Slots;
+        };
+
+        static bool InRange(const Int3& key)
+        {
+            return key.X >= -COORD_LIMIT && key.X < COORD_LIMIT && key.Y >= -COORD_LIMIT && key.Y < COORD_LIMIT && key.Z >= -COORD_LIMIT &&
+                   key.Z < COORD_LIMIT;
+        }
+
+        // 63 bits, so a packed key never collides with EMPTY or TOMBSTONE.
+        static uint64_t Pack(const Int3& key)
+        {
+            return static_cast<uint64_t>(key.X + COORD_LIMIT) | static_cast<uint64_t>(key.Y + COORD_LIMIT) << COORD_BITS |
+                   static_cast<uint64_t>(key.Z + COORD_LIMIT) << (2 * COORD_BITS);
+        }
+
+        static Int3 Unpack(uint64_t packed)
+        {
+            return Int3(static_cast<int>(packed & COORD_MASK) - COORD_LIMIT, static_cast<int>(packed >> COORD_BITS & COORD_MASK) - COORD_LIMIT,
+                        static_cast<int>(packed >> (2 * COORD_BITS) & COORD_MASK) - COORD_LIMIT);
+        }
+
+        // Live entries stay at or below a third of the capacity after a rehash, and a rehash
+        // happens before entries plus tombstones pass two thirds.
+        static std::size_t CapacityFor(std::size_t size) { return std::bit_ceil(std::max(MIN_CAPACITY, size * 3 + 3)); }
+
+        static std::unique_ptr<Table> NewTable(std::size_t capacity)
+        {
+            auto table   = std::make_unique<Table>();
+            table->Mask  = capacity - 1;
+            table->Slots = std::make_unique<Slot[]>(capacity);
+            return table;
+        }
+
+        static std::size_t Locate(const Table& table, uint64_t packed)
+        {
+            for (std::size_t i = MixBits(packed) & table.Mask;; i = (i + 1) & table.Mask)
+            {
+                const uint64_t stored = table.Slots[i].Key.load(std::memory_order_relaxed);
+                if (stored == packed)
+                    return i;
+                if (stored == EMPTY)
+                    return NOT_FOUND;
+            }
+        }
+
+        T* Store(const Int3& key, T* value, bool replace)
+        {
+            if (!InRange(key))
+                throw std::out_of_range("Chunk key outside the ConcurrentChunkMap coordinate range");
+            if (value == nullptr)
+                throw std::invalid_argument("ConcurrentChunkMap values must not be null");
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            const uint64_t              packed = Pack(key);
+            Table*                      table  = table_.load(std::memory_order_relaxed);
+
+            // Probe to the key or the end of its chain, remembering the first tombstone to reuse.
+            std::size_t reuse = NOT_FOUND;
+            std::size_t i     = MixBits(packed) & table->Mask;
+            for (;; i = (i + 1) & table->Mask)
+            {
+                const uint64_t stored = table->Slots[i].Key.load(std::memory_order_relaxed);
+                if (stored == packed)
+                {
+                    T* previous = table->Slots[i].Value.load(std::memory_order_relaxed);
+                    if (replace)
+                        table->Slots[i].Value.store(value, std::memory_order_release);
+                    return previous;
+                }
+                if (stored == TOMBSTONE && reuse == NOT_FOUND)
+                    reuse = i;
+                if (stored == EMPTY)
+                    break;
+            }
+
+            if (reuse == NOT_FOUND && (size_ + tombstones_ + 1) * 3 > (table->Mask + 1) * 2)
+            {
+                table = Rehash(CapacityFor(size_ + 1));
+                for (i = MixBits(packed) & table->Mask; table->Slots[i].Key.load(std::memory_order_relaxed) != EMPTY; i = (i + 1) & table->Mask)
+                {
+                }
+            }
+            else if (reuse != NOT_FOUND)
+            {
+                i = reuse;
+                --tombstones_;
+            }
+
+            // The value is in place before the key is published, so a reader that sees the key sees the value.
+            // Releasing the value too means a reader that sees it also sees the erase of the slot's old key.
+            table->Slots[i].Value.store(value, std::memory_order_release);
+            table->Slots[i].Key.store(packed, std::memory_order_release);
+            ++size_;
+            return nullptr;
+        }
+
+        // Builds a fresh table without tombstones, publishes it and retires the old one.
+        Table* Rehash(std::size_t capacity)
+        {
+            std::unique_ptr<Table> table = NewTable(capacity);
+            Table*                 old   = table_.load(std::memory_order_relaxed);
+            for (std::size_t slot = 0; slot <= old->Mask; ++slot)
+            {
+                const uint64_t stored = old->Slots[slot].Key.load(std::memory_order_relaxed);
+                if (stored == EMPTY || stored == TOMBSTONE)
+                    continue;
+                std::size_t i = MixBits(stored) & table->Mask;
+                while (table->Slots[i].Key.load(std::memory_order_relaxed) != EMPTY)
+                    i = (i + 1) & table->Mask;
+                table->Slots[i].Value.store(old->Slots[slot].Value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                table->Slots[i].Key.store(stored, std::memory_order_relaxed);
+            }
+            tombstones_ = 0;
+
+            retired_.emplace_back(old);
+            table_.store(table.get(), std::memory_order_release);
+            return table.release();
+        }
+
+        std::atomic<Table*>                 table_;
+        mutable std::mutex                  mutex_;
+        std::size_t                         size_       = 0;
+        std::size_t                         tombstones_ = 0;
+        std::vector<std::unique_ptr<Table>> retired_;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,679 @@
+#include "Voxel/GreedyMesher.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(VOXIUM_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        using Platform::Render::NumericType;
+        using Platform::Render::VertexFormatDescriptor;
+        using Platform::Render::VertexFormatDescriptorRate;
+
+        using SliceRows = std::array<uint32_t, CHUNK_SIZE>;
+
+        // Palettes up to this size are decoded in one pass; larger ones are decoded in groups
+        // so the row masks stay bounded (MAX_DECODED_KINDS * 4 KiB).
+        constexpr std::size_t MAX_DECODED_KINDS = 64;
+
+        constexpr uint32_t FULL_ROW = ~0u;
+
+        constexpr std::size_t INITIAL_MESH_BYTES = 64 * 1024;
+
+        constexpr uint32_t NO_ENTRY = ~0u;
+
+        uint32_t FindPaletteEntry(const VoxelChunk& chunk, BlockKind kind)
+        {
+            const std::vector<BlockKind>& palette = chunk.Palette();
+            for (std::size_t p = 0; p < palette.size(); ++p)
+            {
+                if (palette[p] == kind)
+                    return static_cast<uint32_t>(p);
+            }
+            return NO_ENTRY;
+        }
+
+#if defined(VOXIUM_SSE2)
+        // The 32 fields of an x row widened to one byte each: fields 0-15 in Low, 16-31 in High.
+        struct WideRow
+        {
+            __m128i Low;
+            __m128i High;
+        };
+
+        template<int BITS>
+        WideRow WidenRow(const uint64_t* row)
+        {
+            static_assert(BITS == 2 || BITS == 4 || BITS == 8);
+            if constexpr (BITS == 8)
+            {
+                return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(row)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + 2))};
+            }
+            else if constexpr (BITS == 4)
+            {
+                // Byte b holds fields 2b and 2b + 1; interleaving the nibbles restores field order.
+                const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row));
+                const __m128i nibble = _mm_set1_epi8(0x0F);
+                const __m128i even   = _mm_and_si128(packed, nibble);
+                const __m128i odd    = _mm_and_si128(_mm_srli_epi16(packed, 4), nibble);
+                return {_mm_unpacklo_epi8(even, odd), _mm_unpackhi_epi8(even, odd)};
+            }
+            else
+            {
+                // Byte b holds fields 4b to 4b + 3.
+                const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row));
+                const __m128i pair   = _mm_set1_epi8(0x03);
+                const __m128i f0     = _mm_and_si128(packed, pair);
+                const __m128i f1     = _mm_and_si128(_mm_srli_epi16(packed, 2), pair);
+                const __m128i f2     = _mm_and_si128(_mm_srli_epi16(packed, 4), pair);
+                const __m128i f3     = _mm_and_si128(_mm_srli_epi16(packed, 6), pair);
+                const __m128i f01    = _mm_unpacklo_epi8(f0, f1);
+                const __m128i f23    = _mm_unpacklo_epi8(f2, f3);
+                return {_mm_unpacklo_epi16(f01, f23), _mm_unpackhi_epi16(f01, f23)};
+            }
+        }
+
+        uint32_t EqualMask(const WideRow& row, uint32_t entry)
+        {
+            const __m128i value = _mm_set1_epi8(static_cast<char>(entry));
+            const auto    low   = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(row.Low, value)));
+            const auto    high  = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(row.High, value)));
+            return low | high << 16;
+        }
+#endif
+
+        // Bit x set where field x of the row equals entry.
+        template<int BITS>
+        uint32_t RowMatchingOf(const uint64_t* row, uint32_t entry)
+        {
+#if defined(VOXIUM_SSE2)
+            if constexpr (BITS <= 8)
+                return EqualMask(WidenRow<BITS>(row), entry);
+#endif
+            constexpr uint64_t MASK     = (uint64_t {1} << BITS) - 1;
+            constexpr int      PER_WORD = 64 / BITS;
+
+            uint32_t bits = 0;
+            for (int x = 0; x < CHUNK_SIZE; ++x)
+                bits |= static_cast<uint32_t>((row[x / PER_WORD] >> (x % PER_WORD * BITS) & MASK) == entry) << x;
+            return bits;
+        }
+
+        // Rows of palette entries [first, first + count) with BITS wide indices. With SSE2 each
+        // row is widened once and compared against every entry of the group.
+        template<int BITS>
+        void DecodeRowsOf(const uint64_t* data, std::size_t first, std::size_t count, uint32_t* out)
+        {
+            constexpr int WORDS_PER_ROW = CHUNK_SIZE * BITS / 64;
+
+            for (std::size_t row = 0; row < CHUNK_AREA; ++row, data += WORDS_PER_ROW)
+            {
+#if defined(VOXIUM_SSE2)
+                if constexpr (BITS <= 8)
+                {
+                    const WideRow wide = WidenRow<BITS>(data);
+                    for (std::size_t entry = 0; entry < count; ++entry)
+                        out[entry * CHUNK_AREA + row] = EqualMask(wide, static_cast<uint32_t>(first + entry));
+                    continue;
+                }
+#endif
+                for (std::size_t entry = 0; entry < count; ++entry)
+                    out[entry * CHUNK_AREA + row] = RowMatchingOf<BITS>(data, static_cast<uint32_t>(first + entry));
+            }
+        }
+
+        // Bit x set where voxel (x, y, z) of row y * CHUNK_SIZE + z uses palette entry.
+        uint32_t RowMatching(const VoxelChunk& chunk, int row, uint32_t entry)
+        {
+            const uint64_t* words = chunk.PackedIndices().data();
+            const int       bits  = chunk.BitsPerIndex();
+            const uint64_t* data  = words + row * (CHUNK_SIZE * bits / 64);
+            switch (bits)
+            {
+                case 0:
+                    return entry == 0 ? FULL_ROW : 0;
+                case 1:
+                {
+                    const auto ones = static_cast<uint32_t>(words[row >> 1] >> (32 * (row & 1)));
+                    return entry == 0 ? ~ones : entry == 1 ? ones : 0;
+                }
+                case 2:
+                    return RowMatchingOf<2>(data, entry);
+                case 4:
+                    return RowMatchingOf<4>(data, entry);
+                case 8:
+                    return RowMatchingOf<8>(data, entry);
+                default:
+                    return RowMatchingOf<16>(data, entry);
+            }
+        }
+
+        // Decodes palette entries [first, first + count) into per-entry x-row masks:
+        // rows[e * CHUNK_AREA + y * CHUNK_SIZE + z] has bit x set where the voxel uses entry first + e.
+        void DecodeRows(const VoxelChunk& chunk, std::size_t first, std::size_t count, std::vector<uint32_t>& rows)
+        {
+            rows.resize(count * CHUNK_AREA);
+            uint32_t* out = rows.data();
+
+            const uint64_t* words = chunk.PackedIndices().data();
+            switch (chunk.BitsPerIndex())
+            {
+                case 0:
+                    std::fill_n(out, count * CHUNK_AREA, 0u);
+                    if (first == 0)
+                        std::fill_n(out, CHUNK_AREA, FULL_ROW);
+                    break;
+                case 1:
+                    // Two x rows per word; the bits are the mask of entry 1.
+                    for (std::size_t row = 0; row < CHUNK_AREA; ++row)
+                    {
+                        const auto ones = static_cast<uint32_t>(words[row >> 1] >> (32 * (row & 1)));
+                        for (std::size_t entry = 0; entry < count; ++entry)
+                            out[entry * CHUNK_AREA + row] = first + entry == 0 ? ~ones : ones;
+                    }
+                    break;
+                case 2:
+                    DecodeRowsOf<2>(words, first, count, out);
+                    break;
+                case 4:
+                    DecodeRowsOf<4>(words, first, count, out);
+                    break;
+                case 8:
+                    DecodeRowsOf<8>(words, first, count, out);
+                    break;
+                default:
+                    DecodeRowsOf<16>(words, first, count, out);
+                    break;
+            }
+        }
+
+        // Solid mask of a whole chunk: every row not matching the air entry.
+        void DecodeSolid(const VoxelChunk& chunk, std::vector<uint32_t>& scratch, std::array<uint32_t, CHUNK_AREA>& solid)
+        {
+            const uint32_t air = FindPaletteEntry(chunk, AIR_KIND);
+            if (air == NO_ENTRY)
+            {
+                solid.fill(FULL_ROW);
+                return;
+            }
+            DecodeRows(chunk, air, 1, scratch);
+            for (std::size_t row = 0; row < CHUNK_AREA; ++row)
+                solid[row] = ~scratch[row];
+        }
+
+        // Bit planes of 32 packed light bytes: bit x of planes[k] is bit k of bytes[x].
+        void LightPlanes(const uint8_t* bytes, uint32_t* planes)
+        {
+#if defined(VOXIUM_SSE2)
+            const __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + 16));
+            for (int k = 0; k < 8; ++k)
+            {
+                // Shifting 16-bit lanes left by 7 - k moves bit k of every byte to its top bit.
+                const __m128i shift = _mm_cvtsi32_si128(7 - k);
+                const auto    lo    = static_cast<uint32_t>(_mm_movemask_epi8(_mm_sll_epi16(low, shift)));
+                const auto    hi    = static_cast<uint32_t>(_mm_movemask_epi8(_mm_sll_epi16(high, shift)));
+                planes[k]           = lo | hi << 16;
+            }
+#else
+            for (int k = 0; k < 8; ++k)
+            {
+                uint32_t plane = 0;
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    plane |= static_cast<uint32_t>(bytes[x] >> k & 1) << x;
+                planes[k] = plane;
+            }
+#endif
+        }
+
+        // Chunk offset and local coordinate of padded coordinate p in [0, CHUNK_SIZE + 1].
+        constexpr int PaddedOffset(int p) { return p == 0 ? -1 : p == CHUNK_SIZE + 1 ? 1 : 0; }
+        constexpr int PaddedLocal(int p) { return (p - 1) & CHUNK_MASK; }
+    } // namespace
+
+    const VertexFormatDescriptor& GreedyMesher::VertexFormat()
+    {
+        static const VertexFormatDescriptor format {{{0, NumericType::UINT, 0}, {1, NumericType::UINT, 4}}, VERTEX_SIZE, VertexFormatDescriptorRate::VERTEX};
+        return format;
+    }
+
+    void GreedyMesher::DecodeSolidRows(const VoxelChunk& chunk, std::array<uint32_t, CHUNK_AREA>& solid)
+    {
+        thread_local std::vector<uint32_t> scratch;
+        DecodeSolid(chunk, scratch, solid);
+    }
+
+    void GreedyMesher::Mesh(const ChunkNeighbourhood& neighbourhood, ChunkMesh& mesh)
+    {
+        mesh.VertexCount = 0;
+        mesh.QuadCount   = 0;
+
+        // Empty chunks have no faces, and neither have solid ones buried between six solid neighbours.
+        const VoxelChunk* center = neighbourhood.Center();
+        bool              buried = center != nullptr && center->IsFull();
+        for (int face = 0; face < BLOCK_FACE_COUNT && buried; ++face)
+        {
+            const VoxelChunk* neighbour = neighbourhood.Chunks[ChunkNeighbourhood::Slot(static_cast<BlockFace>(face))];
+            buried                      = neighbour != nullptr && neighbour->IsFull();
+        }
+        if (center == nullptr || center->IsEmpty() || buried)
+        {
+            mesh.Vertices.clear();
+            return;
+        }
+
+        // Quads are written straight into the mesh bytes, which only grow while meshing and
+        // are trimmed at the end, so a reused ChunkMesh does not reallocate.
+        output_      = &mesh.Vertices;
+        vertexCount_ = 0;
+
+        const std::vector<BlockKind>& palette    = center->Palette();
+        const bool                    decodeOnce = palette.size() <= MAX_DECODED_KINDS;
+        const std::size_t             groupSize  = decodeOnce ? palette.size() : MAX_DECODED_KINDS;
+
+        DecodeSolid(*center, kindRows_, solid_);
+        BuildPadding(neighbourhood);
+
+        // Visible faces: a solid voxel whose neighbour along the face normal is not solid.
+        std::array<uint32_t, BLOCK_FACE_COUNT> anyVisible {};
+        for (std::size_t y = 0; y < CHUNK_SIZE; ++y)
+        {
+            for (std::size_t z = 0; z < CHUNK_SIZE; ++z)
+            {
+                const std::size_t row    = y * CHUNK_SIZE + z;
+                const std::size_t padded = (y + 1) * PADDED_SIZE + z + 1;
+                const uint32_t    s      = solid_[row];
+
+                const uint32_t faces[BLOCK_FACE_COUNT] = {
+                    s & ~static_cast<uint32_t>(padded_[padded] >> 2),
+                    s & ~static_cast<uint32_t>(padded_[padded]),
+                    s & ~static_cast<uint32_t>(padded_[padded + PADDED_SIZE] >> 1),
+                    s & ~static_cast<uint32_t>(padded_[padded - PADDED_SIZE] >> 1),
+                    s & ~static_cast<uint32_t>(padded_[padded + 1] >> 1),
+                    s & ~static_cast<uint32_t>(padded_[padded - 1] >> 1),
+                };
+                for (std::size_t f = 0; f < BLOCK_FACE_COUNT; ++f)
+                {
+                    visible_[f][row] = faces[f];
+                    anyVisible[f] |= faces[f];
+                }
+            }
+        }
+
+        keys_.resize(CHUNK_AREA);
+        transposedKeys_.resize(CHUNK_SIZE);
+        if (decodeOnce)
+            DecodeRows(*center, 0, palette.size(), kindRows_);
+
+        // Greedy merge per face direction and palette entry.
+        for (std::size_t f = 0; f < BLOCK_FACE_COUNT; ++f)
+        {
+            if (anyVisible[f] == 0)
+                continue;
+
+            const BlockFace face = static_cast<BlockFace>(f);
+            BuildKeys(face);
+
+            for (std::size_t first = 0; first < palette.size(); first += groupSize)
+            {
+                const std::size_t count = std::min(groupSize, palette.size() - first);
+                if (!decodeOnce)
+                    DecodeRows(*center, first, count, kindRows_);
+
+                for (std::size_t entry = 0; entry < count; ++entry)
+                {
+                    const BlockKind kind = palette[first + entry];
+                    if (kind != AIR_KIND)
+                        MergeFace(face, &kindRows_[entry * CHUNK_AREA], kind);
+                }
+            }
+        }
+
+        mesh.Vertices.resize(static_cast<std::size_t>(vertexCount_) * VERTEX_SIZE);
+        mesh.VertexCount = vertexCount_;
+        mesh.QuadCount   = vertexCount_ / 6;
+        output_          = nullptr;
+    }
+
+    void GreedyMesher::BuildPadding(const ChunkNeighbourhood& neighbourhood)
+    {
+        std::array<uint32_t, ChunkNeighbourhood::SLOT_COUNT> air;
+        for (std::size_t slot = 0; slot < ChunkNeighbourhood::SLOT_COUNT; ++slot)
+        {
+            const VoxelChunk* chunk = neighbourhood.Chunks[slot];
+            air[slot]               = chunk != nullptr ? FindPaletteEntry(*chunk, AIR_KIND) : NO_ENTRY;
+        }
+
+        auto solidRow = [&](std::size_t slot, int row) -> uint32_t {
+            const VoxelChunk* chunk = neighbourhood.Chunks[slot];
+            if (chunk == nullptr)
+                return 0;
+            if (air[slot] == NO_ENTRY)
+                return FULL_ROW;
+            return ~RowMatching(*chunk, row, air[slot]);
+        };
+        // Only one voxel of the side chunks is needed per row, so those skip the row decode.
+        auto solidVoxel = [&](std::size_t slot, int index) -> uint32_t {
+            const VoxelChunk* chunk = neighbourhood.Chunks[slot];
+            if (chunk == nullptr)
+                return 0;
+            return air[slot] == NO_ENTRY || chunk->PaletteIndex(index) != air[slot] ? 1u : 0u;
+        };
+
+        for (int py = 0; py < PADDED_SIZE; ++py)
+        {
+            const int dy = PaddedOffset(py);
+            for (int pz = 0; pz < PADDED_SIZE; ++pz)
+            {
+                const int dz  = PaddedOffset(pz);
+                const int row = PaddedLocal(py) * CHUNK_SIZE + PaddedLocal(pz);
+
+                const uint32_t middle = dy == 0 && dz == 0 ? solid_[static_cast<std::size_t>(row)] : solidRow(ChunkNeighbourhood::Slot(0, dy, dz), row);
+                const uint32_t left   = solidVoxel(ChunkNeighbourhood::Slot(-1, dy, dz), row * CHUNK_SIZE + CHUNK_MASK);
+                const uint32_t right  = solidVoxel(ChunkNeighbourhood::Slot(1, dy, dz), row * CHUNK_SIZE);
+
+                padded_[static_cast<std::size_t>(py * PADDED_SIZE + pz)] =
+                    left | static_cast<uint64_t>(middle) << 1 | static_cast<uint64_t>(right) << (CHUNK_SIZE + 1);
+            }
+        }
+
+        hasLight_ = std::any_of(neighbourhood.Lights.begin(), neighbourhood.Lights.end(), [](const ChunkLight* light) { return light != nullptr; });
+        keyBits_  = hasLight_ ? KEY_BITS : 8;
+        if (!hasLight_)
+            return;
+
+        light_.resize(static_cast<std::size_t>(PADDED_SIZE) * PADDED_SIZE * PADDED_SIZE);
+        for (int py = 0; py < PADDED_SIZE; ++py)
+        {
+            const int dy = PaddedOffset(py);
+            for (int pz = 0; pz < PADDED_SIZE; ++pz)
+            {
+                const int         dz    = PaddedOffset(pz);
+                const int         first = ChunkIndex(0, PaddedLocal(py), PaddedLocal(pz));
+                uint8_t*          out   = &light_[static_cast<std::size_t>(py * PADDED_SIZE + pz) * PADDED_SIZE];
+                const ChunkLight* left  = neighbourhood.Lights[ChunkNeighbourhood::Slot(-1, dy, dz)];
+                const ChunkLight* mid   = neighbourhood.Lights[ChunkNeighbourhood::Slot(0, dy, dz)];
+                const ChunkLight* right = neighbourhood.Lights[ChunkNeighbourhood::Slot(1, dy, dz)];
+
+                out[0] = left != nullptr ? left->Packed(first + CHUNK_MASK) : ChunkLight::DEFAULT_PACKED;
+                if (mid != nullptr)
+                    std::memcpy(out + 1, mid->Data() + first, CHUNK_SIZE);
+                else
+                    std::memset(out + 1, ChunkLight::DEFAULT_PACKED, CHUNK_SIZE);
+                out[CHUNK_SIZE + 1] = right != nullptr ? right->Packed(first) : ChunkLight::DEFAULT_PACKED;
+            }
+        }
+    }
+
+    void GreedyMesher::BuildKeys(BlockFace face)
+    {
+        // side(du, dv) is the padded row holding the voxel in front of the face, moved by du
+        // along u and dv along v, shifted so its bit x lines up with the face at x. Along x
+        // (the u axis of Y and Z faces) a step is a bit shift, along y and z a row step.
+        const Int3 normal  = FaceNormal(face);
+        int        uRow    = 0;
+        int        vRow    = 0;
+        int        uBit    = 0;
+        int        shift   = 1;
+        int        frontPx = 1;
+        switch (face)
+        {
+            case BlockFace::PositiveX:
+            case BlockFace::NegativeX:
+                uRow    = PADDED_SIZE;
+                vRow    = 1;
+                shift   = 1 + normal.X;
+                frontPx = 1 + normal.X;
+                break;
+            case BlockFace::PositiveY:
+            case BlockFace::NegativeY:
+                uBit = 1;
+                vRow = 1;
+                break;
+            default:
+                uBit = 1;
+                vRow = PADDED_SIZE;
+                break;
+        }
+
+        // Corners c0..c3 as (u, v) directions, matching the vertex order of EmitQuad.
+        static constexpr int CORNERS[4][2] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+
+        const RowMasks& visible = visible_[static_cast<std::size_t>(face)];
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                const auto row = static_cast<std::size_t>(y * CHUNK_SIZE + z);
+                if (visible[row] == 0)
+                    continue;
+
+                // Rows in front of the face stay inside the padding, so the indices are never negative.
+                const int front = (y + 1 + normal.Y) * PADDED_SIZE + z + 1 + normal.Z;
+                auto      side  = [&](int du, int dv) {
+                    return static_cast<uint32_t>(padded_[static_cast<std::size_t>(front + du * uRow + dv * vRow)] >> (shift + du * uBit));
+                };
+
+                // Occlusion level per corner: 3 between two solid sides, else the solid count.
+                KeyPlanes& planes = keys_[row];
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    const uint32_t s1 = side(CORNERS[c][0], 0);
+                    const uint32_t s2 = side(0, CORNERS[c][1]);
+                    const uint32_t s3 = side(CORNERS[c][0], CORNERS[c][1]);
+                    planes[2 * c]     = (s1 ^ s2 ^ s3) | (s1 & s2);
+                    planes[2 * c + 1] = (s1 & s2) | (s1 & s3) | (s2 & s3);
+                }
+
+                if (hasLight_)
+                {
+                    LightPlanes(&light_[static_cast<std::size_t>(front * PADDED_SIZE + frontPx)], &planes[8]);
+                    for (std::size_t k = 0; k < 8; ++k)
+                    {
+                        if ((ChunkLight::DEFAULT_PACKED >> k & 1) != 0)
+                            planes[8 + k] = ~planes[8 + k];
+                    }
+                }
+
+                uint32_t any = 0;
+                for (std::size_t b = 0; b < keyBits_; ++b)
+                    any |= planes[b];
+                planes[KEY_ANY] = any;
+            }
+        }
+    }
+
+    uint32_t GreedyMesher::MatchKey(const KeyPlanes& planes, uint32_t key) const
+    {
+        if (key == 0)
+            return ~planes[KEY_ANY];
+
+        uint32_t mask = FULL_ROW;
+        for (std::size_t b = 0; b < keyBits_; ++b)
+            mask &= (key >> b & 1u) != 0 ? planes[b] : ~planes[b];
+        return mask;
+    }
+
+    void GreedyMesher::MergeFace(BlockFace face, const uint32_t* kindRows, BlockKind kind)
+    {
+        const RowMasks& visible = visible_[static_cast<std::size_t>(face)];
+        SliceRows       rows;
+
+        switch (face)
+        {
+            case BlockFace::PositiveY:
+            case BlockFace::NegativeY:
+                // Slice y: rows z, bits x.
+                for (int y = 0; y < CHUNK_SIZE; ++y)
+                {
+                    const auto layer = static_cast<std::size_t>(y * CHUNK_SIZE);
+                    uint32_t   any   = 0;
+                    for (std::size_t z = 0; z < CHUNK_SIZE; ++z)
+                    {
+                        rows[z] = visible[layer + z] & kindRows[layer + z];
+                        any |= rows[z];
+                    }
+                    if (any != 0)
+                        MergeSlice(rows, &keys_[layer], 1, face, y, kind);
+                }
+                break;
+
+            case BlockFace::PositiveZ:
+            case BlockFace::NegativeZ:
+                // Slice z: rows y, bits x.
+                for (int z = 0; z < CHUNK_SIZE; ++z)
+                {
+                    const auto column = static_cast<std::size_t>(z);
+                    uint32_t   any    = 0;
+                    for (std::size_t y = 0; y < CHUNK_SIZE; ++y)
+                    {
+                        const std::size_t row = y * CHUNK_SIZE + column;
+                        rows[y]               = visible[row] & kindRows[row];
+                        any |= rows[y];
+                    }
+                    if (any != 0)
+                        MergeSlice(rows, &keys_[column], CHUNK_SIZE, face, z, kind);
+                }
+                break;
+
+            default:
+            {
+                // Slice x: rows z, bits y. X faces are sparse on real terrain, so their bits and
+                // keys are scattered into the slices one by one instead of transposing every plane.
+                uint32_t slices = 0;
+                for (std::size_t row = 0; row < CHUNK_AREA; ++row)
+                {
+                    uint32_t bits = visible[row] & kindRows[row];
+                    if (bits == 0)
+                        continue;
+
+                    const std::size_t y      = row >> CHUNK_SHIFT;
+                    const std::size_t z      = row & CHUNK_MASK;
+                    const KeyPlanes&  planes = keys_[row];
+                    do
+                    {
+                        const auto x = static_cast<std::size_t>(std::countr_zero(bits));
+                        if ((slices >> x & 1u) == 0)
+                        {
+                            slices |= 1u << x;
+                            transposed_[x].fill(0);
+                        }
+                        // Key bits are only read where the slice row is set, so stale bits are
+                        // overwritten here rather than clearing the slice's planes up front.
+                        KeyPlanes& keys = transposedKeys_[x][z];
+                        transposed_[x][z] |= 1u << y;
+                        for (std::size_t b = 0; b < keyBits_; ++b)
+                            keys[b] = (keys[b] & ~(1u << y)) | (planes[b] >> x & 1u) << y;
+                        keys[KEY_ANY] = (keys[KEY_ANY] & ~(1u << y)) | (planes[KEY_ANY] >> x & 1u) << y;
+                        bits &= bits - 1;
+                    } while (bits != 0);
+                }
+
+                for (; slices != 0; slices &= slices - 1)
+                {
+                    const int  x     = std::countr_zero(slices);
+                    const auto slice = static_cast<std::size_t>(x);
+                    MergeSlice(transposed_[slice], transposedKeys_[slice].data(), 1, face, x, kind);
+                }
+                break;
+            }
+        }
+    }
+
+    void GreedyMesher::MergeSlice(SliceRows& rows, const KeyPlanes* keys, int keyStride, BlockFace face, int slice, BlockKind kind)
+    {
+        for (int v = 0; v < CHUNK_SIZE; ++v)
+        {
+            uint32_t row = rows[static_cast<std::size_t>(v)];
+            while (row != 0)
+            {
+                const int u = std::countr_zero(row);
+
+                // The run only covers faces whose AO and light match the first face.
+                const KeyPlanes& planes = keys[v * keyStride];
+                uint32_t         key    = 0;
+                if ((planes[KEY_ANY] >> u & 1u) != 0)
+                {
+                    for (std::size_t b = 0; b < keyBits_; ++b)
+                        key |= (planes[b] >> u & 1u) << b;
+                }
+
+                const uint32_t shifted = (row & MatchKey(planes, key)) >> u;
+                const int      width   = shifted == FULL_ROW ? CHUNK_SIZE : std::countr_zero(~shifted);
+                const uint32_t run     = (width == CHUNK_SIZE ? FULL_ROW : (1u << width) - 1) << u;
+
+                int height = 1;
+                for (; v + height < CHUNK_SIZE; ++height)
+                {
+                    uint32_t& next = rows[static_cast<std::size_t>(v + height)];
+                    if ((next & run) != run || (MatchKey(keys[(v + height) * keyStride], key) & run) != run)
+                        break;
+                    next &= ~run;
+                }
+
+                row &= ~run;
+                EmitQuad(face, slice, u, v, width, height, kind, key);
+            }
+        }
+    }
+
+    void GreedyMesher::EmitQuad(BlockFace face, int slice, int u, int v, int width, int height, BlockKind kind, uint32_t key)
+    {
+        // (u, v) maps to (y, z), (x, z) and (x, y); the slice axis takes the remaining field.
+        struct FaceAxes
+        {
+            int  uShift;
+            int  vShift;
+            int  planeShift;
+            bool flip;
+        };
+        // Corner order c0..c3 is counter-clockwise for +X, -Y and +Z and flipped for the opposite faces.
+        static constexpr FaceAxes AXES[BLOCK_FACE_COUNT] = {
+            {6, 12, 0, false}, {6, 12, 0, true}, {0, 12, 6, true}, {0, 12, 6, false}, {0, 6, 12, false}, {0, 6, 12, true}};
+
+        const FaceAxes& axes     = AXES[static_cast<int>(face)];
+        const uint32_t  plane    = static_cast<uint32_t>(slice + ((static_cast<int>(face) & 1) == 0 ? 1 : 0));
+        const uint32_t  light    = key >> 8 ^ ChunkLight::DEFAULT_PACKED;
+        const uint32_t  position = plane << axes.planeShift | static_cast<uint32_t>(u) << axes.uShift | static_cast<uint32_t>(v) << axes.vShift |
+                                  static_cast<uint32_t>(face) << 18 | light << 23;
+        const uint32_t  du       = static_cast<uint32_t>(width) << axes.uShift;
+        const uint32_t  dv       = static_cast<uint32_t>(height) << axes.vShift;
+        const uint32_t  uvU      = static_cast<uint32_t>(width) << 16;
+        const uint32_t  uvV      = static_cast<uint32_t>(height) << 22;
+
+        uint32_t ao[4];
+        for (int c = 0; c < 4; ++c)
+            ao[c] = 3 - (key >> (2 * c) & 3u);
+
+        const PackedVoxelVertex c0 {position | ao[0] << 21, kind};
+        const PackedVoxelVertex c1 {(position + du) | ao[1] << 21, kind | uvU};
+        const PackedVoxelVertex c2 {(position + du + dv) | ao[2] << 21, kind | uvU | uvV};
+        const PackedVoxelVertex c3 {(position + dv) | ao[3] << 21, kind | uvV};
+
+        // Cut the quad along the diagonal with the darker corner pair, so AO interpolates
+        // the same way regardless of quad orientation.
+        const bool              alternate = ao[0] + ao[2] > ao[1] + ao[3];
+        const PackedVoxelVertex quad[6]   = {
+            c0,
+            axes.flip ? (alternate ? c3 : c2) : c1,
+            axes.flip ? c1 : (alternate ? c3 : c2),
+            alternate ? c1 : c0,
+            axes.flip ? c3 : c2,
+            axes.flip ? c2 : c3,
+        };
+
+        std::vector<uint8_t>& bytes  = *output_;
+        const std::size_t     offset = static_cast<std::size_t>(vertexCount_) * VERTEX_SIZE;
+        if (offset + sizeof(quad) > bytes.size())
+            bytes.resize(std::max<std::size_t>(bytes.size() * 2, INITIAL_MESH_BYTES));
+        std::memcpy(bytes.data() + offset, quad, sizeof(quad));
+        vertexCount_ += 6;
+    }
+
+} // namespace Voxium::Core
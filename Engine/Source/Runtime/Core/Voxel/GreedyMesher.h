@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Platform/Render/IRenderContext.h"
+#include "Voxel/ChunkLight.h"
+#include "Voxel/VoxelChunk.h"
+
+namespace Voxium::Core
+{
+    // A chunk and the 26 chunks around it, with their light. Face neighbours decide which
+    // border faces are visible; edge and corner neighbours only feed ambient occlusion.
+    // Missing chunks are treated as air, missing light as ChunkLight::DEFAULT_PACKED.
+    struct ChunkNeighbourhood
+    {
+        static constexpr std::size_t SLOT_COUNT  = 27;
+        static constexpr std::size_t CENTER_SLOT = 13;
+
+        // Slot of the chunk at offset (dx, dy, dz), each in [-1, 1].
+        static constexpr std::size_t Slot(int dx, int dy, int dz) { return static_cast<std::size_t>((dx + 1) + (dz + 1) * 3 + (dy + 1) * 9); }
+
+        static constexpr std::size_t Slot(BlockFace face)
+        {
+            const Int3 normal = FaceNormal(face);
+            return Slot(normal.X, normal.Y, normal.Z);
+        }
+
+        std::array<const VoxelChunk*, SLOT_COUNT> Chunks {};
+        std::array<const ChunkLight*, SLOT_COUNT> Lights {};
+
+        const VoxelChunk* Center() const { return Chunks[CENTER_SLOT]; }
+    };
+
+    // Vertex layout produced by GreedyMesher (two 32-bit words, 8 bytes), low bits first:
+    //   PositionFace: x:6 | y:6 | z:6 | face:3 | ao:2 | block:4 | sky:4 | 1 spare bit
+    //   KindUV:       kind:16 | u:6 | v:6 | 4 spare bits
+    // Positions are corner coordinates in [0, 32] inside the chunk; u/v count voxels
+    // across the merged quad so textures can repeat per voxel. AO is 3 for an open corner
+    // and 0 for a corner between two solid voxels; light is that of the voxel in front, the
+    // ChunkLight byte as is, so block light sits at bits 23-26 and sky light at 27-30.
+    struct PackedVoxelVertex
+    {
+        uint32_t PositionFace;
+        uint32_t KindUV;
+
+        static constexpr PackedVoxelVertex Make(int       x,
+                                                int       y,
+                                                int       z,
+                                                BlockFace face,
+                                                BlockKind kind,
+                                                int       u,
+                                                int       v,
+                                                int       ao = 3,
+                                                uint8_t   light = ChunkLight::DEFAULT_PACKED)
+        {
+            return {static_cast<uint32_t>(x) | static_cast<uint32_t>(y) << 6 | static_cast<uint32_t>(z) << 12 | static_cast<uint32_t>(face) << 18 |
+                        static_cast<uint32_t>(ao) << 21 | static_cast<uint32_t>(light) << 23,
+                    static_cast<uint32_t>(kind) | static_cast<uint32_t>(u) << 16 | static_cast<uint32_t>(v) << 22};
+        }
+
+        int       X() const { return PositionFace & 63; }
+        int       Y() const { return (PositionFace >> 6) & 63; }
+        int       Z() const { return (PositionFace >> 12) & 63; }
+        BlockFace Face() const { return static_cast<BlockFace>((PositionFace >> 18) & 7); }
+        int       AO() const { return (PositionFace >> 21) & 3; }
+        int       SkyLight() const { return (PositionFace >> 27) & 15; }
+        int       BlockLight() const { return (PositionFace >> 23) & 15; }
+        BlockKind Kind() const { return static_cast<BlockKind>(KindUV & 0xFFFF); }
+        int       U() const { return (KindUV >> 16) & 63; }
+        int       V() const { return (KindUV >> 22) & 63; }
+    };
+
+    static_assert(sizeof(PackedVoxelVertex) == 8);
+
+    // Triangle list of PackedVoxelVertex, six vertices per quad, ready for CreateVertexBuffer.
+    struct ChunkMesh
+    {
+        std::vector<uint8_t> Vertices;
+        uint32_t             VertexCount = 0;
+        uint32_t             QuadCount   = 0;
+    };
+
+    //--------------------------------------------------------------------------------
+    // GreedyMesher: turns a chunk into greedy-merged quads. The chunk is decoded into
+    // one 32-bit x-row mask per (y, z) and palette entry; face culling is a shift and
+    // and-not between neighbouring rows, and merging grows runs of set bits across
+    // rows. Corner AO and light are kept as bit planes next to those rows, so a run
+    // only grows over faces with the same AO and light. The instance keeps its
+    // scratch buffers between calls, so use one mesher per thread.
+    //--------------------------------------------------------------------------------
+    class CORE_API GreedyMesher
+    {
+    public:
+        static constexpr uint32_t VERTEX_SIZE = sizeof(PackedVoxelVertex);
+
+        // Location 0 is PositionFace and location 1 is KindUV, both UINT.
+        static const Platform::Render::VertexFormatDescriptor& VertexFormat();
+
+        // Replaces the contents of mesh. Triangles are counter-clockwise seen from outside.
+        void Mesh(const ChunkNeighbourhood& neighbourhood, ChunkMesh& mesh);
+
+        // The solid voxels of a chunk as the mesher sees them: bit x of solid[y * CHUNK_SIZE + z]
+        // is set where voxel (x, y, z) is not air.
+        static void DecodeSolidRows(const VoxelChunk& chunk, std::array<uint32_t, CHUNK_AREA>& solid);
+
+    private:
+        // Per face key bits: occlusion level (3 - AO) of corners c0..c3 in bits 0-7, the
+        // packed light of the voxel in front xor DEFAULT_PACKED in bits 8-15, so an open,
+        // sky-lit face has key 0. Plane KEY_ANY marks the faces with a non-zero key.
+        static constexpr int KEY_BITS = 16;
+        static constexpr int KEY_ANY  = KEY_BITS;
+
+        // Rows of the padded neighbourhood: 34 x 34 rows of 34 bits, one voxel of border each side.
+        static constexpr int PADDED_SIZE = CHUNK_SIZE + 2;
+
+        using RowMasks  = std::array<uint32_t, CHUNK_AREA>;
+        using SliceRows = std::array<uint32_t, CHUNK_SIZE>;
+        using KeyPlanes = std::array<uint32_t, KEY_BITS + 1>;
+        using SliceKeys = std::array<KeyPlanes, CHUNK_SIZE>;
+
+        void BuildPadding(const ChunkNeighbourhood& neighbourhood);
+
+        void BuildKeys(BlockFace face);
+
+        void MergeFace(BlockFace face, const uint32_t* kindRows, BlockKind kind);
+
+        // keys[v * keyStride] holds the key planes of rows[v].
+        void MergeSlice(SliceRows& rows, const KeyPlanes* keys, int keyStride, BlockFace face, int slice, BlockKind kind);
+
+        void EmitQuad(BlockFace face, int slice, int u, int v, int width, int height, BlockKind kind, uint32_t key);
+
+        uint32_t MatchKey(const KeyPlanes& planes, uint32_t key) const;
+
+        // kindRows_[p * CHUNK_AREA + y * CHUNK_SIZE + z] has bit x set where the voxel uses palette entry p.
+        std::vector<uint32_t>                  kindRows_;
+        RowMasks                               solid_ {};
+        std::array<RowMasks, BLOCK_FACE_COUNT> visible_ {};
+
+        // padded_[py * PADDED_SIZE + pz] has bit px set for solid voxels, p = local + 1.
+        std::array<uint64_t, PADDED_SIZE * PADDED_SIZE> padded_ {};
+
+        // Packed light, (py * PADDED_SIZE + pz) * PADDED_SIZE + px. Only filled when any light is given.
+        std::vector<uint8_t> light_;
+        bool                 hasLight_ = false;
+        std::size_t          keyBits_  = 8;
+
+        // Key planes of the face direction being merged, per row y * CHUNK_SIZE + z.
+        std::vector<KeyPlanes> keys_;
+
+        // X faces are gathered into slices of rows z, bits y.
+        std::array<SliceRows, CHUNK_SIZE> transposed_ {};
+        std::vector<SliceKeys>            transposedKeys_;
+
+        std::vector<uint8_t>* output_      = nullptr;
+        uint32_t              vertexCount_ = 0;
+    };
+
+} // namespace Voxium::Core
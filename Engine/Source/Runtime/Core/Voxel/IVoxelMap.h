@@ -3,9 +3,20 @@
 
 #include <array>
 #include <cstdint>
+#include <span>
+
+#include "Math/Int3.h"
 
 namespace Voxium::Core {
 
+    using BlockKind = uint16_t;
+
+    // One entry of a scattered batch write.
+    struct VoxelWrite {
+        Int3      Position;
+        BlockKind Kind;
+    };
+
     class IVoxelMap {
     public:
         const int MAX_KIND;
@@ -23,6 +34,54 @@ namespace Voxium::Core {
         virtual bool OutOfBounds(int x, int y, int z) const = 0;
 
         virtual void AddBlockFromMagicVoxel(int x, int y, int z, int index) = 0;
+
+        // Batch writes. Voxels outside the map are skipped. The defaults fall back to the
+        // per-voxel calls; implementations override them to check bounds once per chunk.
+
+        // Writes a scattered list of voxels.
+        virtual void AddBlocks(std::span<const VoxelWrite> writes) {
+            for (const VoxelWrite& write : writes) {
+                if (!OutOfBounds(write.Position.X, write.Position.Y, write.Position.Z))
+                    AddBlockFromMagicVoxel(write.Position.X, write.Position.Y, write.Position.Z, write.Kind);
+            }
+        }
+
+        // Writes a box of size.X * size.Y * size.Z kinds laid out x fastest, then z, then y.
+        virtual void AddBlockBox(const Int3& origin, const Int3& size, std::span<const BlockKind> kinds) {
+            std::size_t i = 0;
+            for (int y = 0; y < size.Y; ++y)
+                for (int z = 0; z < size.Z; ++z)
+                    for (int x = 0; x < size.X; ++x, ++i) {
+                        const int wx = origin.X + x, wy = origin.Y + y, wz = origin.Z + z;
+                        if (!OutOfBounds(wx, wy, wz))
+                            AddBlockFromMagicVoxel(wx, wy, wz, kinds[i]);
+                    }
+        }
+
+        // Writes a run of kinds along +x starting at origin.
+        void AddBlockRun(const Int3& origin, std::span<const BlockKind> kinds) {
+            AddBlockBox(origin, Int3(static_cast<int>(kinds.size()), 1, 1), kinds);
+        }
+
+        // Called with the chunks a multithreaded import is about to write. Returns true if the map
+        // then accepts concurrent AddBlocks() calls as long as no two threads touch the same chunk
+        // and every write lands in a listed chunk, until FinishConcurrentChunkWrites().
+        virtual bool PrepareConcurrentChunkWrites(std::span<const Int3> chunkPositions) {
+            (void)chunkPositions;
+            return false;
+        }
+
+        // Ends the concurrent writes a successful PrepareConcurrentChunkWrites() allowed.
+        virtual void FinishConcurrentChunkWrites() {}
+
+        // Sets every voxel of the box to the same kind.
+        virtual void FillBlocks(const Int3& origin, const Int3& size, BlockKind kind) {
+            for (int y = origin.Y; y < origin.Y + size.Y; ++y)
+                for (int z = origin.Z; z < origin.Z + size.Z; ++z)
+                    for (int x = origin.X; x < origin.X + size.X; ++x)
+                        if (!OutOfBounds(x, y, z))
+                            AddBlockFromMagicVoxel(x, y, z, kind);
+        }
     };
 
 } // namespace Voxium::Core
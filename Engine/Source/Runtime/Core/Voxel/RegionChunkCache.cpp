@@ -0,0 +1,147 @@
+#include "Voxel/RegionChunkCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "Allocator/Allocator.h"
+
+namespace Voxium::Core
+{
+    RegionChunkCache::RegionChunkCache(std::filesystem::path directory, std::size_t capacityBytes)
+        : directory_(std::move(directory)), capacity_(capacityBytes)
+    {
+    }
+
+    RegionChunkCache::~RegionChunkCache() { Clear(); }
+
+    std::shared_ptr<const VoxelChunk> RegionChunkCache::GetChunk(const Int3& chunkPos)
+    {
+        std::shared_ptr<const Region> region;
+        RegionLocation                location {0, 0};
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto                        it = entries_.find(chunkPos);
+            if (it != entries_.end())
+            {
+                lru_.splice(lru_.begin(), lru_, it->second);
+                ++stats_.Hits;
+                RecordChunkCacheLookup(true);
+                return it->second->Chunk;
+            }
+
+            region = OpenRegion(RegionOf(chunkPos));
+            if (region == nullptr)
+                return nullptr;
+            location = region->Locations[static_cast<std::size_t>(RegionSlot(chunkPos))];
+            if (location.Count == 0)
+                return nullptr;
+            ++stats_.Misses;
+            RecordChunkCacheLookup(false);
+        }
+
+        // The last record of a file may end before its last sector; DecodeRecord checks lengths.
+        const std::span<const uint8_t> bytes  = region->File.Bytes();
+        const std::size_t              offset = std::min(static_cast<std::size_t>(location.Sector) * RegionFile::SECTOR_SIZE, bytes.size());
+        const std::size_t              length = std::min(static_cast<std::size_t>(location.Count) * RegionFile::SECTOR_SIZE, bytes.size() - offset);
+
+        const auto start   = std::chrono::steady_clock::now();
+        auto       chunk   = std::make_shared<const VoxelChunk>(RegionFile::DecodeRecord(bytes.subspan(offset, length)));
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        RecordChunkCacheDecompress(static_cast<uint64_t>(elapsed));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.DecompressSeconds += static_cast<double>(elapsed) * 1e-9;
+
+        // Another thread may have decompressed the same chunk meanwhile; keep the cached copy.
+        auto [it, inserted] = entries_.try_emplace(chunkPos, lru_.end());
+        if (!inserted)
+            return it->second->Chunk;
+
+        const std::size_t entryBytes = sizeof(VoxelChunk) + chunk->MemoryUsage();
+        lru_.push_front(Entry {chunkPos, chunk, entryBytes});
+        it->second = lru_.begin();
+        stats_.ResidentBytes += entryBytes;
+        ++stats_.ResidentChunks;
+        IncrementChunkCacheMemory(entryBytes);
+
+        EvictTo(capacity_);
+        return chunk;
+    }
+
+    bool RegionChunkCache::HasChunk(const Int3& chunkPos)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.contains(chunkPos))
+            return true;
+        const std::shared_ptr<const Region> region = OpenRegion(RegionOf(chunkPos));
+        return region != nullptr && region->Locations[static_cast<std::size_t>(RegionSlot(chunkPos))].Count != 0;
+    }
+
+    void RegionChunkCache::SetCapacity(std::size_t capacityBytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacityBytes;
+        EvictTo(capacity_);
+    }
+
+    std::size_t RegionChunkCache::Capacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+    void RegionChunkCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        EvictTo(0);
+        regions_.clear();
+    }
+
+    RegionChunkCacheStats RegionChunkCache::Stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    std::shared_ptr<const RegionChunkCache::Region> RegionChunkCache::OpenRegion(const Int3& region)
+    {
+        auto [it, inserted] = regions_.try_emplace(region);
+        if (!inserted)
+            return it->second;
+
+        // A missing file is remembered as nullptr, so later lookups in it skip the file system.
+        const std::filesystem::path path = RegionFile::PathFor(directory_, region);
+        if (!std::filesystem::exists(path))
+            return nullptr;
+
+        try
+        {
+            auto opened  = std::make_shared<Region>();
+            opened->File = MappedFile(path);
+            RegionFile::ParseHeader(opened->File.Bytes(), opened->Locations);
+            it->second = std::move(opened);
+        }
+        catch (...)
+        {
+            regions_.erase(it);
+            throw;
+        }
+        return it->second;
+    }
+
+    void RegionChunkCache::EvictTo(std::size_t bytes)
+    {
+        while (stats_.ResidentBytes > bytes && !lru_.empty())
+        {
+            const Entry& entry = lru_.back();
+            stats_.ResidentBytes -= entry.Bytes;
+            --stats_.ResidentChunks;
+            ++stats_.Evictions;
+            DecrementChunkCacheMemory(entry.Bytes);
+            entries_.erase(entry.ChunkPos);
+            lru_.pop_back();
+        }
+    }
+
+} // namespace Voxium::Core
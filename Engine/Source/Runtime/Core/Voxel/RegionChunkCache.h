@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "IO/MappedFile.h"
+#include "Math/Int3.h"
+#include "Voxel/ChunkedVoxelMap.h"
+#include "Voxel/RegionFile.h"
+#include "Voxel/VoxelChunk.h"
+
+namespace Voxium::Core
+{
+    struct RegionChunkCacheStats
+    {
+        uint64_t    Hits              = 0;
+        uint64_t    Misses            = 0;
+        uint64_t    Evictions         = 0;
+        std::size_t ResidentBytes     = 0;
+        std::size_t ResidentChunks    = 0;
+        double      DecompressSeconds = 0.0;
+
+        double HitRate() const { return Hits + Misses == 0 ? 0.0 : static_cast<double>(Hits) / static_cast<double>(Hits + Misses); }
+    };
+
+    //--------------------------------------------------------------------------------
+    // RegionChunkCache: read-only view of a world directory of region files. Regions
+    // are memory-mapped on first touch and chunk records are decompressed on first
+    // access into a least-recently-used cache bounded by bytes, so opening a world
+    // reads nothing up front. Thread-safe; decompression runs outside the lock.
+    //
+    // The region files must not be written while mapped; call Clear after saving.
+    // Resident bytes, hits, misses and decompression time also feed MemoryString.
+    //--------------------------------------------------------------------------------
+    class CORE_API RegionChunkCache
+    {
+    public:
+        RegionChunkCache(std::filesystem::path directory, std::size_t capacityBytes);
+
+        ~RegionChunkCache();
+
+        RegionChunkCache(const RegionChunkCache&)            = delete;
+        RegionChunkCache& operator=(const RegionChunkCache&) = delete;
+
+        // Returns nullptr if the chunk was never stored; such lookups count as neither hit nor miss.
+        // The chunk stays valid for as long as it is held, even after eviction.
+        // Throws std::runtime_error if the region file or the chunk record is corrupt.
+        std::shared_ptr<const VoxelChunk> GetChunk(const Int3& chunkPos);
+
+        // Reads only the location table of the region.
+        bool HasChunk(const Int3& chunkPos);
+
+        // Evicts down to the new capacity right away.
+        void SetCapacity(std::size_t capacityBytes);
+
+        std::size_t Capacity() const;
+
+        // Drops every cached chunk and unmaps every region.
+        void Clear();
+
+        RegionChunkCacheStats Stats() const;
+
+        const std::filesystem::path& Directory() const { return directory_; }
+
+    private:
+        struct Region
+        {
+            MappedFile                  File;
+            std::vector<RegionLocation> Locations;
+        };
+
+        struct Entry
+        {
+            Int3                              ChunkPos;
+            std::shared_ptr<const VoxelChunk> Chunk;
+            std::size_t                       Bytes;
+        };
+
+        // nullptr if the region has no file. Caller holds mutex_.
+        std::shared_ptr<const Region> OpenRegion(const Int3& region);
+
+        // Caller holds mutex_.
+        void EvictTo(std::size_t bytes);
+
+        const std::filesystem::path directory_;
+
+        mutable std::mutex mutex_;
+        std::size_t        capacity_;
+
+        // Regions are shared with lookups decompressing outside the lock, so Clear cannot unmap under them.
+        std::unordered_map<Int3, std::shared_ptr<const Region>, Int3Hasher> regions_;
+
+        // Most recently used first.
+        std::list<Entry>                                                   lru_;
+        std::unordered_map<Int3, std::list<Entry>::iterator, Int3Hasher> entries_;
+
+        RegionChunkCacheStats stats_;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,294 @@
+#include "Voxel/RegionFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <zlib.h>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr uint8_t  MAGIC[4]         = {'V', 'X', 'R', 'G'};
+        constexpr uint8_t  COMPRESSION_ZLIB = 1;
+        constexpr int      ZLIB_LEVEL       = Z_BEST_SPEED;
+        constexpr uint32_t RECORD_HEADER    = 4 + 1 + 4;
+        constexpr uint32_t PAYLOAD_HEADER   = 4 + 1 + 3;
+
+        // Largest raw payload: a full 16-bit palette with 16-bit indices.
+        constexpr std::size_t MAX_RAW_SIZE = PAYLOAD_HEADER + 65536 * sizeof(BlockKind) + CHUNK_VOLUME * sizeof(uint16_t);
+
+        [[noreturn]] void Corrupt(const char* what) { throw std::runtime_error(std::string("Corrupt region file: ") + what); }
+
+        // Region files are little-endian on every platform.
+        void StoreU32(uint8_t* out, uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+                out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+
+        uint32_t LoadU32(const uint8_t* in) { return in[0] | in[1] << 8 | in[2] << 16 | static_cast<uint32_t>(in[3]) << 24; }
+
+        RegionLocation UnpackLocation(uint32_t packed) { return {packed >> 8, packed & 0xFF}; }
+
+        uint32_t PackLocation(RegionLocation location) { return location.Sector << 8 | location.Count; }
+
+        uint32_t SectorsFor(std::size_t bytes) { return static_cast<uint32_t>((bytes + RegionFile::SECTOR_SIZE - 1) / RegionFile::SECTOR_SIZE); }
+    } // namespace
+
+    RegionFile::RegionFile(const std::filesystem::path& path) : path_(path), locations_(REGION_CHUNKS, RegionLocation {0, 0})
+    {
+        if (!std::filesystem::exists(path))
+        {
+            std::vector<uint8_t> header(HEADER_SECTORS * SECTOR_SIZE, 0);
+            std::memcpy(header.data(), MAGIC, sizeof(MAGIC));
+            StoreU32(&header[4], VERSION);
+            StoreU32(&header[8], REGION_SIZE);
+
+            std::ofstream create(path, std::ios::binary);
+            create.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+            if (!create)
+                throw std::runtime_error("Cannot create region file: " + path.string());
+        }
+
+        file_.open(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (!file_)
+            throw std::runtime_error("Cannot open region file: " + path.string());
+
+        std::vector<uint8_t> header(HEADER_SECTORS * SECTOR_SIZE);
+        file_.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(header.size()));
+        if (!file_)
+            Corrupt("truncated header");
+        ParseHeader(header, locations_);
+
+        // Sectors in use, from the location table. A trailing partial sector counts as a whole one.
+        const auto fileSize = std::filesystem::file_size(path);
+        used_.assign(std::max<std::size_t>(SectorsFor(fileSize), HEADER_SECTORS), false);
+        std::fill_n(used_.begin(), HEADER_SECTORS, true);
+        for (RegionLocation& location : locations_)
+        {
+            if (location.Count == 0)
+                continue;
+            if (location.Sector < HEADER_SECTORS || location.Sector + location.Count > used_.size())
+                Corrupt("chunk record outside the file");
+            std::fill_n(used_.begin() + location.Sector, location.Count, true);
+        }
+    }
+
+    std::filesystem::path RegionFile::PathFor(const std::filesystem::path& directory, const Int3& region)
+    {
+        return directory / ("r." + std::to_string(region.X) + "." + std::to_string(region.Y) + "." + std::to_string(region.Z) + ".vxr");
+    }
+
+    bool RegionFile::ParsePath(const std::filesystem::path& path, Int3& region)
+    {
+        const std::string name = path.filename().string();
+        int               x = 0, y = 0, z = 0, length = 0;
+        if (std::sscanf(name.c_str(), "r.%d.%d.%d.vxr%n", &x, &y, &z, &length) != 3 || length != static_cast<int>(name.size()))
+            return false;
+        region = Int3(x, y, z);
+        return true;
+    }
+
+    bool RegionFile::ReadChunk(int slot, VoxelChunk& chunk)
+    {
+        const RegionLocation location = locations_[static_cast<std::size_t>(slot)];
+        if (location.Count == 0)
+            return false;
+
+        buffer_.resize(static_cast<std::size_t>(location.Count) * SECTOR_SIZE);
+        file_.seekg(static_cast<std::streamoff>(location.Sector) * SECTOR_SIZE);
+        file_.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+        if (file_.gcount() < static_cast<std::streamsize>(RECORD_HEADER))
+            Corrupt("truncated chunk record");
+        // The last sector of the file may be short if it was not padded; DecodeRecord checks lengths.
+        const std::size_t read = static_cast<std::size_t>(file_.gcount());
+        file_.clear();
+
+        chunk = DecodeRecord(std::span<const uint8_t>(buffer_.data(), read));
+        return true;
+    }
+
+    void RegionFile::WriteChunk(int slot, const VoxelChunk& chunk)
+    {
+        buffer_.clear();
+        EncodeRecord(chunk, buffer_);
+        WriteRecord(slot, buffer_);
+    }
+
+    void RegionFile::WriteRecord(int slot, std::span<const uint8_t> record)
+    {
+        const uint32_t sectors = SectorsFor(record.size());
+        if (sectors > MAX_RECORD_SECTORS)
+            throw std::runtime_error("Chunk record too large for a region file");
+
+        // New sectors first, then the location switch, then the old sectors are released.
+        const RegionLocation previous = locations_[static_cast<std::size_t>(slot)];
+        const uint32_t       sector   = AllocateSectors(sectors);
+
+        static const uint8_t padding[SECTOR_SIZE] = {};
+        file_.seekp(static_cast<std::streamoff>(sector) * SECTOR_SIZE);
+        file_.write(reinterpret_cast<const char*>(record.data()), static_cast<std::streamsize>(record.size()));
+        file_.write(reinterpret_cast<const char*>(padding), static_cast<std::streamsize>(sectors * SECTOR_SIZE - record.size()));
+        // The record must reach the OS before the location that points at it; the stream buffer
+        // would otherwise be free to write them out in either order.
+        file_.flush();
+
+        WriteLocation(slot, {sector, sectors});
+        if (previous.Count != 0)
+            std::fill_n(used_.begin() + previous.Sector, previous.Count, false);
+        if (!file_)
+            throw std::runtime_error("Cannot write region file: " + path_.string());
+    }
+
+    void RegionFile::RemoveChunk(int slot)
+    {
+        const RegionLocation previous = locations_[static_cast<std::size_t>(slot)];
+        if (previous.Count == 0)
+            return;
+        WriteLocation(slot, {0, 0});
+        std::fill_n(used_.begin() + previous.Sector, previous.Count, false);
+    }
+
+    void RegionFile::Flush()
+    {
+        file_.flush();
+        if (!file_)
+            throw std::runtime_error("Cannot write region file: " + path_.string());
+    }
+
+    std::size_t RegionFile::ChunkCount() const
+    {
+        return static_cast<std::size_t>(std::count_if(locations_.begin(), locations_.end(), [](const RegionLocation& l) { return l.Count != 0; }));
+    }
+
+    void RegionFile::EncodeRecord(const VoxelChunk& chunk, std::vector<uint8_t>& out)
+    {
+        const std::vector<BlockKind>& palette = chunk.Palette();
+        const std::vector<uint64_t>&  indices = chunk.PackedIndices();
+
+        std::vector<uint8_t> raw(PAYLOAD_HEADER + palette.size() * sizeof(BlockKind) + indices.size() * sizeof(uint64_t));
+        StoreU32(&raw[0], static_cast<uint32_t>(palette.size()));
+        raw[4]        = static_cast<uint8_t>(chunk.BitsPerIndex());
+        uint8_t* out8 = &raw[PAYLOAD_HEADER];
+        for (BlockKind kind : palette)
+        {
+            *out8++ = static_cast<uint8_t>(kind);
+            *out8++ = static_cast<uint8_t>(kind >> 8);
+        }
+        for (uint64_t word : indices)
+        {
+            StoreU32(out8, static_cast<uint32_t>(word));
+            StoreU32(out8 + 4, static_cast<uint32_t>(word >> 32));
+            out8 += 8;
+        }
+
+        // At most MAX_RAW_SIZE, so it fits the record header and zlib's uLong everywhere.
+        const uint32_t    rawSize = static_cast<uint32_t>(raw.size());
+        const std::size_t start   = out.size();
+        uLongf            bound   = compressBound(rawSize);
+        out.resize(start + RECORD_HEADER + bound);
+        if (compress2(&out[start + RECORD_HEADER], &bound, raw.data(), rawSize, ZLIB_LEVEL) != Z_OK)
+            throw std::runtime_error("zlib compression failed");
+        out.resize(start + RECORD_HEADER + bound);
+
+        StoreU32(&out[start], static_cast<uint32_t>(1 + 4 + bound));
+        out[start + 4] = COMPRESSION_ZLIB;
+        StoreU32(&out[start + 5], rawSize);
+    }
+
+    VoxelChunk RegionFile::DecodeRecord(std::span<const uint8_t> bytes)
+    {
+        if (bytes.size() < RECORD_HEADER)
+            Corrupt("truncated chunk record");
+        const uint32_t length  = LoadU32(&bytes[0]);
+        const uint32_t rawSize = LoadU32(&bytes[5]);
+        if (length < 1 + 4 || length > bytes.size() - 4)
+            Corrupt("chunk record length");
+        if (bytes[4] != COMPRESSION_ZLIB)
+            Corrupt("unknown compression");
+        if (rawSize < PAYLOAD_HEADER || rawSize > MAX_RAW_SIZE)
+            Corrupt("chunk payload size");
+
+        std::vector<uint8_t> raw(rawSize);
+        uLongf               rawLength = rawSize;
+        if (uncompress(raw.data(), &rawLength, &bytes[RECORD_HEADER], length - 1 - 4) != Z_OK || rawLength != rawSize)
+            Corrupt("chunk payload does not decompress");
+
+        const uint32_t    paletteSize = LoadU32(&raw[0]);
+        const int         bits        = raw[4];
+        const std::size_t words       = static_cast<std::size_t>(CHUNK_VOLUME) * static_cast<std::size_t>(bits) / 64;
+        if (bits > 16 || PAYLOAD_HEADER + static_cast<std::size_t>(paletteSize) * sizeof(BlockKind) + words * sizeof(uint64_t) != rawSize)
+            Corrupt("chunk payload layout");
+
+        std::vector<BlockKind> palette(paletteSize);
+        const uint8_t*         in = &raw[PAYLOAD_HEADER];
+        for (BlockKind& kind : palette)
+        {
+            kind = static_cast<BlockKind>(in[0] | in[1] << 8);
+            in += 2;
+        }
+        std::vector<uint64_t> indices(words);
+        for (uint64_t& word : indices)
+        {
+            word = LoadU32(in) | static_cast<uint64_t>(LoadU32(in + 4)) << 32;
+            in += 8;
+        }
+
+        try
+        {
+            return VoxelChunk::FromPacked(std::move(palette), bits, std::move(indices));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            Corrupt(e.what());
+        }
+    }
+
+    void RegionFile::ParseHeader(std::span<const uint8_t> header, std::vector<RegionLocation>& locations)
+    {
+        if (header.size() < HEADER_SECTORS * SECTOR_SIZE || std::memcmp(header.data(), MAGIC, sizeof(MAGIC)) != 0)
+            Corrupt("not a region file");
+        if (LoadU32(&header[4]) != VERSION || LoadU32(&header[8]) != REGION_SIZE)
+            Corrupt("unsupported version");
+
+        locations.resize(REGION_CHUNKS);
+        for (std::size_t slot = 0; slot < locations.size(); ++slot)
+            locations[slot] = UnpackLocation(LoadU32(&header[SECTOR_SIZE + slot * 4]));
+    }
+
+    uint32_t RegionFile::AllocateSectors(uint32_t count)
+    {
+        // First fit among free sectors, else grow the file.
+        uint32_t run = 0;
+        for (uint32_t sector = HEADER_SECTORS; sector < used_.size(); ++sector)
+        {
+            run = used_[sector] ? 0 : run + 1;
+            if (run == count)
+            {
+                const uint32_t first = sector + 1 - count;
+                std::fill_n(used_.begin() + first, count, true);
+                return first;
+            }
+        }
+
+        // A free run at the end of the file is extended rather than skipped.
+        const uint32_t first = static_cast<uint32_t>(used_.size()) - run;
+        used_.resize(first + count, true);
+        std::fill_n(used_.begin() + first, count, true);
+        return first;
+    }
+
+    void RegionFile::WriteLocation(int slot, RegionLocation location)
+    {
+        uint8_t packed[4];
+        StoreU32(packed, PackLocation(location));
+        file_.seekp(static_cast<std::streamoff>(SECTOR_SIZE) + slot * 4);
+        file_.write(reinterpret_cast<const char*>(packed), sizeof(packed));
+        locations_[static_cast<std::size_t>(slot)] = location;
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Voxel/VoxelChunk.h"
+
+namespace Voxium::Core
+{
+    // A region holds 32 x 32 chunks in x and z of one chunk layer in y.
+    constexpr int REGION_SHIFT  = 5;
+    constexpr int REGION_SIZE   = 1 << REGION_SHIFT;
+    constexpr int REGION_MASK   = REGION_SIZE - 1;
+    constexpr int REGION_CHUNKS = REGION_SIZE * REGION_SIZE;
+
+    constexpr Int3 RegionOf(const Int3& chunkPos) { return Int3(chunkPos.X >> REGION_SHIFT, chunkPos.Y, chunkPos.Z >> REGION_SHIFT); }
+
+    // Slot of a chunk inside its region file.
+    constexpr int RegionSlot(const Int3& chunkPos) { return (chunkPos.X & REGION_MASK) | (chunkPos.Z & REGION_MASK) << REGION_SHIFT; }
+
+    constexpr Int3 RegionChunk(const Int3& region, int slot)
+    {
+        return Int3((region.X << REGION_SHIFT) | (slot & REGION_MASK), region.Y, (region.Z << REGION_SHIFT) | (slot >> REGION_SHIFT));
+    }
+
+    // Sectors of a chunk record; Count == 0 marks an empty slot.
+    struct RegionLocation
+    {
+        uint32_t Sector;
+        uint32_t Count;
+    };
+
+    //--------------------------------------------------------------------------------
+    // RegionFile: 1024 chunks in one file of 4 KiB sectors. Sector 0 holds the magic,
+    // sector 1 a location table of one little-endian uint32 per slot (first sector
+    // << 8 | sector count), and every chunk record starts on its own sector:
+    //   uint32 length | uint8 compression | uint32 raw length | zlib stream
+    // where the raw payload is the chunk's palette and packed indices:
+    //   uint32 palette size | uint8 bits | 3 pad bytes | uint16 palette[] | uint64 indices[]
+    // A chunk is read by seeking to its record, so neighbours are never touched. A
+    // rewritten chunk goes to free sectors and is flushed before its location is switched
+    // over, so a process that dies mid-write leaves the previous record intact. Nothing
+    // is synced to disk, so after a power loss either entry may be lost.
+    //--------------------------------------------------------------------------------
+    class CORE_API RegionFile
+    {
+    public:
+        static constexpr std::size_t SECTOR_SIZE        = 4096;
+        static constexpr uint32_t    HEADER_SECTORS     = 2;
+        static constexpr uint32_t    MAX_RECORD_SECTORS = 255;
+        static constexpr uint32_t    VERSION            = 1;
+
+        // Opens the region file, creating it if it does not exist. Throws std::runtime_error
+        // if it cannot be opened or is not a region file.
+        explicit RegionFile(const std::filesystem::path& path);
+
+        // File name of a region inside a world directory: r.<x>.<y>.<z>.vxr
+        static std::filesystem::path PathFor(const std::filesystem::path& directory, const Int3& region);
+
+        // Parses a PathFor() file name; returns false for other files.
+        static bool ParsePath(const std::filesystem::path& path, Int3& region);
+
+        bool HasChunk(int slot) const { return locations_[static_cast<std::size_t>(slot)].Count != 0; }
+
+        RegionLocation Location(int slot) const { return locations_[static_cast<std::size_t>(slot)]; }
+
+        // Reads and decompresses one chunk. Returns false if the slot is empty; throws
+        // std::runtime_error for a corrupt record.
+        bool ReadChunk(int slot, VoxelChunk& chunk);
+
+        void WriteChunk(int slot, const VoxelChunk& chunk);
+
+        // Writes a record made by EncodeRecord().
+        void WriteRecord(int slot, std::span<const uint8_t> record);
+
+        void RemoveChunk(int slot);
+
+        void Flush();
+
+        std::size_t ChunkCount() const;
+
+        // Sectors in the file, header included.
+        std::size_t SectorCount() const { return used_.size(); }
+
+        // Appends the record of a chunk (length prefix included) to out.
+        static void EncodeRecord(const VoxelChunk& chunk, std::vector<uint8_t>& out);
+
+        // Decodes a record that starts at the front of bytes; trailing sector padding is ignored.
+        // Throws std::runtime_error if the record is corrupt.
+        static VoxelChunk DecodeRecord(std::span<const uint8_t> bytes);
+
+        // Checks the header sectors and reads the location table from them.
+        static void ParseHeader(std::span<const uint8_t> header, std::vector<RegionLocation>& locations);
+
+    private:
+        uint32_t AllocateSectors(uint32_t count);
+
+        void WriteLocation(int slot, RegionLocation location);
+
+        std::filesystem::path       path_;
+        std::fstream                file_;
+        std::vector<RegionLocation> locations_;
+        std::vector<bool>           used_;
+        std::vector<uint8_t>        buffer_;
+    };
+
+} // namespace Voxium::Core
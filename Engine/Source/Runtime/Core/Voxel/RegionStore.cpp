@@ -0,0 +1,113 @@
+#include "Voxel/RegionStore.h"
+
+#include <utility>
+
+namespace Voxium::Core
+{
+    RegionStore::RegionStore(std::filesystem::path directory) : directory_(std::move(directory)) { std::filesystem::create_directories(directory_); }
+
+    bool RegionStore::LoadChunk(const Int3& chunkPos, VoxelChunk& chunk)
+    {
+        const Int3 region = RegionOf(chunkPos);
+        if (!regions_.contains(region) && !std::filesystem::exists(RegionFile::PathFor(directory_, region)))
+            return false;
+        return Region(region).ReadChunk(RegionSlot(chunkPos), chunk);
+    }
+
+    void RegionStore::SaveChunk(const Int3& chunkPos, const VoxelChunk& chunk) { Region(RegionOf(chunkPos)).WriteChunk(RegionSlot(chunkPos), chunk); }
+
+    void RegionStore::RemoveChunk(const Int3& chunkPos)
+    {
+        const Int3 region = RegionOf(chunkPos);
+        if (regions_.contains(region) || std::filesystem::exists(RegionFile::PathFor(directory_, region)))
+            Region(region).RemoveChunk(RegionSlot(chunkPos));
+    }
+
+    void RegionStore::SaveMap(const ChunkedVoxelMap& map, ThreadPool* pool)
+    {
+        std::vector<std::pair<Int3, const VoxelChunk*>> chunks;
+        chunks.reserve(map.ChunkCount());
+        map.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk& chunk) { chunks.emplace_back(chunkPos, &chunk); });
+
+        // Compression dominates saving, so records are encoded up front (in parallel when
+        // possible) and then written one region file at a time.
+        std::vector<std::vector<uint8_t>> records(chunks.size());
+        auto encode = [&](std::size_t i) { RegionFile::EncodeRecord(*chunks[i].second, records[i]); };
+        if (pool != nullptr)
+        {
+            pool->ParallelFor(chunks.size(), encode);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+                encode(i);
+        }
+
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            Region(RegionOf(chunks[i].first)).WriteRecord(RegionSlot(chunks[i].first), records[i]);
+            std::vector<uint8_t>().swap(records[i]);
+        }
+
+        for (const Int3& region : Regions())
+        {
+            RegionFile& file = Region(region);
+            for (int slot = 0; slot < REGION_CHUNKS; ++slot)
+            {
+                if (file.HasChunk(slot) && map.GetChunk(RegionChunk(region, slot)) == nullptr)
+                    file.RemoveChunk(slot);
+            }
+        }
+        Flush();
+    }
+
+    std::size_t RegionStore::LoadMap(ChunkedVoxelMap& map)
+    {
+        std::size_t loaded = 0;
+        for (const Int3& region : Regions())
+        {
+            RegionFile& file = Region(region);
+            for (int slot = 0; slot < REGION_CHUNKS; ++slot)
+            {
+                if (!file.HasChunk(slot))
+                    continue;
+
+                // A chunk overlaps the map exactly when its first voxel lies inside it.
+                const Int3 chunkPos = RegionChunk(region, slot);
+                if (map.OutOfBounds(chunkPos.X << CHUNK_SHIFT, chunkPos.Y << CHUNK_SHIFT, chunkPos.Z << CHUNK_SHIFT))
+                    continue;
+
+                file.ReadChunk(slot, map.GetOrCreateChunk(chunkPos));
+                ++loaded;
+            }
+        }
+        return loaded;
+    }
+
+    void RegionStore::Flush()
+    {
+        for (auto& [region, file] : regions_)
+            file->Flush();
+    }
+
+    std::vector<Int3> RegionStore::Regions() const
+    {
+        std::vector<Int3> regions;
+        for (const auto& entry : std::filesystem::directory_iterator(directory_))
+        {
+            Int3 region = Int3::Invalid;
+            if (entry.is_regular_file() && RegionFile::ParsePath(entry.path(), region))
+                regions.push_back(region);
+        }
+        return regions;
+    }
+
+    RegionFile& RegionStore::Region(const Int3& region)
+    {
+        std::unique_ptr<RegionFile>& file = regions_[region];
+        if (file == nullptr)
+            file = std::make_unique<RegionFile>(RegionFile::PathFor(directory_, region));
+        return *file;
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkedVoxelMap.h"
+#include "Voxel/RegionFile.h"
+
+namespace Voxium::Core
+{
+    //--------------------------------------------------------------------------------
+    // RegionStore: a world directory of region files, addressed by chunk position.
+    // Region files stay open once touched, so saving or loading many chunks of one
+    // region opens it once. Not thread-safe.
+    //--------------------------------------------------------------------------------
+    class CORE_API RegionStore
+    {
+    public:
+        // Creates the directory if it does not exist.
+        explicit RegionStore(std::filesystem::path directory);
+
+        // Returns false if the chunk was never stored.
+        bool LoadChunk(const Int3& chunkPos, VoxelChunk& chunk);
+
+        void SaveChunk(const Int3& chunkPos, const VoxelChunk& chunk);
+
+        void RemoveChunk(const Int3& chunkPos);
+
+        // Stores every chunk of the map and removes stored chunks the map no longer has.
+        // With a pool, the chunk records are compressed in parallel.
+        void SaveMap(const ChunkedVoxelMap& map, ThreadPool* pool = nullptr);
+
+        // Loads every stored chunk that overlaps the map bounds and returns how many were loaded.
+        std::size_t LoadMap(ChunkedVoxelMap& map);
+
+        void Flush();
+
+        // Regions that have a file in the directory.
+        std::vector<Int3> Regions() const;
+
+        const std::filesystem::path& Directory() const { return directory_; }
+
+    private:
+        RegionFile& Region(const Int3& region);
+
+        std::filesystem::path                                              directory_;
+        std::unordered_map<Int3, std::unique_ptr<RegionFile>, Int3Hasher> regions_;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,486 @@
+#include "Voxel/VoxImporter.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "IO/MappedFile.h"
+#include "Math/MathUtility.h"
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr uint32_t FourCC(const char (&id)[5])
+        {
+            return static_cast<uint32_t>(static_cast<uint8_t>(id[0])) | static_cast<uint32_t>(static_cast<uint8_t>(id[1])) << 8 |
+                   static_cast<uint32_t>(static_cast<uint8_t>(id[2])) << 16 | static_cast<uint32_t>(static_cast<uint8_t>(id[3])) << 24;
+        }
+
+        constexpr int MAX_SCENE_DEPTH = 64;
+
+        [[noreturn]] void Malformed(const char* what) { throw std::runtime_error(std::string("Malformed .vox file: ") + what); }
+
+        using VoxDict = std::vector<std::pair<std::string_view, std::string_view>>;
+
+        std::string_view FindKey(const VoxDict& dict, std::string_view key)
+        {
+            for (const auto& [k, v] : dict)
+            {
+                if (k == key)
+                    return v;
+            }
+            return {};
+        }
+
+        // Little-endian cursor over a byte range that throws instead of reading past the end.
+        class VoxReader
+        {
+        public:
+            explicit VoxReader(std::span<const uint8_t> bytes) : bytes_(bytes) {}
+
+            bool AtEnd() const { return pos_ >= bytes_.size(); }
+
+            std::span<const uint8_t> ReadBytes(std::size_t count)
+            {
+                if (count > bytes_.size() - pos_)
+                    Malformed("unexpected end of data");
+                auto result = bytes_.subspan(pos_, count);
+                pos_ += count;
+                return result;
+            }
+
+            uint32_t ReadUInt()
+            {
+                auto b = ReadBytes(4);
+                return static_cast<uint32_t>(b[0]) | static_cast<uint32_t>(b[1]) << 8 | static_cast<uint32_t>(b[2]) << 16 | static_cast<uint32_t>(b[3]) << 24;
+            }
+
+            int32_t ReadInt() { return static_cast<int32_t>(ReadUInt()); }
+
+            std::size_t ReadCount()
+            {
+                const int32_t count = ReadInt();
+                if (count < 0)
+                    Malformed("negative count");
+                return static_cast<std::size_t>(count);
+            }
+
+            std::string_view ReadString()
+            {
+                auto b = ReadBytes(ReadCount());
+                return {reinterpret_cast<const char*>(b.data()), b.size()};
+            }
+
+            VoxDict ReadDict()
+            {
+                VoxDict           dict;
+                const std::size_t count = ReadCount();
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    std::string_view key   = ReadString();
+                    std::string_view value = ReadString();
+                    dict.emplace_back(key, value);
+                }
+                return dict;
+            }
+
+        private:
+            std::span<const uint8_t> bytes_;
+            std::size_t              pos_ = 0;
+        };
+
+        // Signed permutation matrix plus integer translation, as stored in nTRN frames.
+        struct VoxTransform
+        {
+            std::array<std::size_t, 3> Axis {0, 1, 2};
+            std::array<int, 3>         Sign {1, 1, 1};
+            std::array<int, 3>         Translation {0, 0, 0};
+
+            // Returns this * child (child applied first).
+            VoxTransform Compose(const VoxTransform& child) const
+            {
+                VoxTransform result;
+                for (std::size_t row = 0; row < 3; ++row)
+                {
+                    result.Axis[row]        = child.Axis[Axis[row]];
+                    result.Sign[row]        = Sign[row] * child.Sign[Axis[row]];
+                    result.Translation[row] = Sign[row] * child.Translation[Axis[row]] + Translation[row];
+                }
+                return result;
+            }
+
+            static VoxTransform FromFrame(const VoxDict& frame)
+            {
+                VoxTransform transform;
+                if (std::string_view r = FindKey(frame, "_r"); !r.empty())
+                {
+                    unsigned bits = 0;
+                    if (const auto parsed = std::from_chars(r.data(), r.data() + r.size(), bits); parsed.ec != std::errc() || parsed.ptr != r.data() + r.size())
+                        Malformed("invalid rotation");
+                    const std::size_t c0 = bits & 3;
+                    const std::size_t c1 = (bits >> 2) & 3;
+                    if (c0 > 2 || c1 > 2 || c0 == c1)
+                        Malformed("invalid rotation");
+                    transform.Axis = {c0, c1, 3 - c0 - c1};
+                    transform.Sign = {(bits & 16) ? -1 : 1, (bits & 32) ? -1 : 1, (bits & 64) ? -1 : 1};
+                }
+                if (std::string_view t = FindKey(frame, "_t"); !t.empty())
+                {
+                    std::istringstream stream {std::string(t)};
+                    stream >> transform.Translation[0] >> transform.Translation[1] >> transform.Translation[2];
+                    if (!stream)
+                        Malformed("invalid translation");
+                }
+                return transform;
+            }
+        };
+
+        struct VoxModel
+        {
+            std::array<int, 3>       Size {0, 0, 0};
+            std::span<const uint8_t> Voxels; // 4 bytes per voxel: x, y, z, colour index
+        };
+
+        enum class VoxNodeType
+        {
+            Transform,
+            Group,
+            Shape
+        };
+
+        struct VoxNode
+        {
+            VoxNodeType      Type = VoxNodeType::Group;
+            VoxTransform     Local;
+            std::vector<int> Children; // child node ids, or model ids for shapes
+        };
+
+        struct VoxInstance
+        {
+            std::size_t  Model;
+            VoxTransform Transform;
+            bool         Centered; // scene graph instances are placed around the model centre
+        };
+
+        struct VoxScene
+        {
+            std::vector<VoxModel>            Models;
+            std::unordered_map<int, VoxNode> Nodes;
+            std::array<uint32_t, 256>        Palette {};
+            bool                             HasPalette = false;
+        };
+
+        VoxScene ParseScene(std::span<const uint8_t> bytes)
+        {
+            VoxReader reader(bytes);
+            if (reader.ReadUInt() != FourCC("VOX "))
+                Malformed("missing VOX header");
+            reader.ReadInt(); // version
+
+            if (reader.ReadUInt() != FourCC("MAIN"))
+                Malformed("missing MAIN chunk");
+            const std::size_t mainContent  = reader.ReadCount();
+            const std::size_t mainChildren = reader.ReadCount();
+            reader.ReadBytes(mainContent);
+            VoxReader children(reader.ReadBytes(mainChildren));
+
+            VoxScene           scene;
+            std::array<int, 3> pendingSize {0, 0, 0};
+            bool               hasPendingSize = false;
+            while (!children.AtEnd())
+            {
+                const uint32_t    id          = children.ReadUInt();
+                const std::size_t contentSize = children.ReadCount();
+                const std::size_t childSize   = children.ReadCount();
+                VoxReader         content(children.ReadBytes(contentSize));
+                children.ReadBytes(childSize);
+
+                if (id == FourCC("SIZE"))
+                {
+                    pendingSize    = {content.ReadInt(), content.ReadInt(), content.ReadInt()};
+                    hasPendingSize = true;
+                    if (pendingSize[0] <= 0 || pendingSize[1] <= 0 || pendingSize[2] <= 0)
+                        Malformed("invalid model size");
+                }
+                else if (id == FourCC("XYZI"))
+                {
+                    if (!hasPendingSize)
+                        Malformed("XYZI chunk without SIZE");
+                    const std::size_t              count  = content.ReadCount();
+                    const std::span<const uint8_t> voxels = content.ReadBytes(count * 4);
+                    for (std::size_t i = 0; i < voxels.size(); i += 4)
+                    {
+                        if (voxels[i] >= pendingSize[0] || voxels[i + 1] >= pendingSize[1] || voxels[i + 2] >= pendingSize[2])
+                            Malformed("voxel outside its model");
+                    }
+                    scene.Models.push_back({pendingSize, voxels});
+                    hasPendingSize = false;
+                }
+                else if (id == FourCC("RGBA"))
+                {
+                    // Palette entry i holds the colour of colour index i + 1.
+                    for (std::size_t i = 0; i < 255; ++i)
+                    {
+                        scene.Palette[i + 1] = content.ReadUInt();
+                    }
+                    scene.HasPalette = true;
+                }
+                else if (id == FourCC("nTRN"))
+                {
+                    const int nodeId = content.ReadInt();
+                    content.ReadDict();
+                    VoxNode node;
+                    node.Type = VoxNodeType::Transform;
+                    node.Children.push_back(content.ReadInt());
+                    content.ReadInt(); // reserved
+                    content.ReadInt(); // layer
+                    const std::size_t frames = content.ReadCount();
+                    if (frames > 0)
+                        node.Local = VoxTransform::FromFrame(content.ReadDict());
+                    scene.Nodes[nodeId] = std::move(node);
+                }
+                else if (id == FourCC("nGRP"))
+                {
+                    const int nodeId = content.ReadInt();
+                    content.ReadDict();
+                    VoxNode node;
+                    node.Type               = VoxNodeType::Group;
+                    const std::size_t count = content.ReadCount();
+                    for (std::size_t i = 0; i < count; ++i)
+                        node.Children.push_back(content.ReadInt());
+                    scene.Nodes[nodeId] = std::move(node);
+                }
+                else if (id == FourCC("nSHP"))
+                {
+                    const int nodeId = content.ReadInt();
+                    content.ReadDict();
+                    VoxNode node;
+                    node.Type               = VoxNodeType::Shape;
+                    const std::size_t count = content.ReadCount();
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        node.Children.push_back(content.ReadInt());
+                        content.ReadDict();
+                    }
+                    scene.Nodes[nodeId] = std::move(node);
+                }
+            }
+            return scene;
+        }
+
+        void CollectInstances(const VoxScene& scene, int nodeId, const VoxTransform& parent, int depth, std::vector<VoxInstance>& out)
+        {
+            if (depth > MAX_SCENE_DEPTH)
+                Malformed("scene graph too deep or cyclic");
+            auto it = scene.Nodes.find(nodeId);
+            if (it == scene.Nodes.end())
+                Malformed("dangling scene node");
+
+            const VoxNode& node = it->second;
+            switch (node.Type)
+            {
+                case VoxNodeType::Transform:
+                    CollectInstances(scene, node.Children[0], parent.Compose(node.Local), depth + 1, out);
+                    break;
+                case VoxNodeType::Group:
+                    for (int child : node.Children)
+                        CollectInstances(scene, child, parent, depth + 1, out);
+                    break;
+                case VoxNodeType::Shape:
+                    for (int model : node.Children)
+                    {
+                        if (model < 0 || static_cast<std::size_t>(model) >= scene.Models.size())
+                            Malformed("shape references missing model");
+                        out.push_back({static_cast<std::size_t>(model), parent, true});
+                    }
+                    break;
+            }
+        }
+
+        // Places model voxels in scene space. Centered instances rotate around the model centre
+        // using doubled coordinates, so odd and even sizes both land on whole voxels.
+        class InstancePlacer
+        {
+        public:
+            InstancePlacer(const VoxInstance& instance, const VoxModel& model, bool swapYZ) :
+                transform_(instance.Transform), size_(model.Size), centered_(instance.Centered), swapYZ_(swapYZ)
+            {}
+
+            std::array<int, 3> Place(int x, int y, int z) const
+            {
+                if (!centered_)
+                    return Output({x, y, z});
+
+                const std::array<int, 3> v {x, y, z};
+                std::array<int, 3>       world;
+                for (std::size_t row = 0; row < 3; ++row)
+                {
+                    const std::size_t axis    = transform_.Axis[row];
+                    const int         doubled = transform_.Sign[row] * (2 * v[axis] + 1 - size_[axis]);
+                    world[row]        = transform_.Translation[row] + (doubled >> 1);
+                }
+                return Output(world);
+            }
+
+        private:
+            std::array<int, 3> Output(const std::array<int, 3>& p) const { return swapYZ_ ? std::array<int, 3> {p[0], p[2], p[1]} : p; }
+
+            const VoxTransform&       transform_;
+            const std::array<int, 3>& size_;
+            bool                      centered_;
+            bool                      swapYZ_;
+        };
+    } // namespace
+
+    VoxImportResult VoxImporter::Import(const std::filesystem::path& path, IVoxelMap& map, const VoxImportOptions& options)
+    {
+        MappedFile file(path);
+        file.AdviseSequential();
+        return Import(file.Bytes(), map, options);
+    }
+
+    VoxImportResult VoxImporter::Import(std::span<const uint8_t> bytes, IVoxelMap& map, const VoxImportOptions& options)
+    {
+        VoxScene scene = ParseScene(bytes);
+
+        std::vector<VoxInstance> instances;
+        if (scene.Nodes.count(0) > 0)
+        {
+            CollectInstances(scene, 0, VoxTransform {}, 0, instances);
+        }
+        else
+        {
+            // Files without a scene graph stack every model at the origin.
+            for (std::size_t i = 0; i < scene.Models.size(); ++i)
+                instances.push_back({i, VoxTransform {}, false});
+        }
+
+        if (scene.HasPalette)
+            map.MagicVoxelColours = scene.Palette;
+
+        VoxImportResult result;
+        result.ModelCount    = scene.Models.size();
+        result.InstanceCount = instances.size();
+        if (instances.empty())
+            return result;
+
+        // Scene bounds from the two extreme corners of every instance.
+        std::array<int, 3> sceneMin {VOXIUM_INT_MAX, VOXIUM_INT_MAX, VOXIUM_INT_MAX};
+        std::array<int, 3> sceneMax {-VOXIUM_INT_MAX, -VOXIUM_INT_MAX, -VOXIUM_INT_MAX};
+        for (const VoxInstance& instance : instances)
+        {
+            const VoxModel&      model = scene.Models[instance.Model];
+            const InstancePlacer placer(instance, model, options.SwapYZ);
+            for (const auto& corner : {placer.Place(0, 0, 0), placer.Place(model.Size[0] - 1, model.Size[1] - 1, model.Size[2] - 1)})
+            {
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    sceneMin[axis] = std::min(sceneMin[axis], corner[axis]);
+                    sceneMax[axis] = std::max(sceneMax[axis], corner[axis]);
+                }
+            }
+        }
+        const std::array<int, 3> offset {options.Origin.X - sceneMin[0], options.Origin.Y - sceneMin[1], options.Origin.Z - sceneMin[2]};
+        result.Min = options.Origin;
+        result.Max = Int3(sceneMax[0] + offset[0] + 1, sceneMax[1] + offset[1] + 1, sceneMax[2] + offset[2] + 1);
+
+        std::array<bool, 256> kindExists {};
+        for (std::size_t kind = 1; kind < kindExists.size(); ++kind)
+            kindExists[kind] = map.BlockKindExists(static_cast<int>(kind));
+
+        // Instances are written one at a time, so only one model's worth of voxels is held at
+        // once: its voxels are bucketed by destination chunk and each bucket is written with one
+        // AddBlocks call. Bucket entries pack the local chunk index above the 8-bit colour index.
+        std::unordered_map<Int3, std::vector<uint32_t>, Int3Hasher> buckets;
+        std::unordered_set<Int3, Int3Hasher>                        written;
+        std::vector<Int3>                                           chunkPositions;
+        std::vector<const std::vector<uint32_t>*>                   chunkBuckets;
+
+        auto insertBucket = [&](std::size_t i) {
+            const Int3&             pos = chunkPositions[i];
+            std::vector<VoxelWrite> writes;
+            writes.reserve(chunkBuckets[i]->size());
+            for (uint32_t entry : *chunkBuckets[i])
+            {
+                const int local = static_cast<int>(entry >> 8);
+                writes.push_back({Int3((pos.X << CHUNK_SHIFT) | (local & CHUNK_MASK),
+                                       (pos.Y << CHUNK_SHIFT) | (local >> (2 * CHUNK_SHIFT)),
+                                       (pos.Z << CHUNK_SHIFT) | ((local >> CHUNK_SHIFT) & CHUNK_MASK)),
+                                  static_cast<BlockKind>(entry & 0xFF)});
+            }
+            map.AddBlocks(writes);
+        };
+
+        for (const VoxInstance& instance : instances)
+        {
+            const VoxModel&        model     = scene.Models[instance.Model];
+            const InstancePlacer   placer(instance, model, options.SwapYZ);
+            const uint8_t*         voxel     = model.Voxels.data();
+            const uint8_t*         end       = voxel + model.Voxels.size();
+            Int3                   lastChunk = Int3::Invalid;
+            std::vector<uint32_t>* bucket    = nullptr;
+            for (; voxel != end; voxel += 4)
+            {
+                const uint8_t kind = voxel[3];
+                if (!kindExists[kind])
+                    continue;
+
+                const auto p     = placer.Place(voxel[0], voxel[1], voxel[2]);
+                const int  x     = p[0] + offset[0];
+                const int  y     = p[1] + offset[1];
+                const int  z     = p[2] + offset[2];
+                const Int3 chunk = ChunkOf(x, y, z);
+                if (bucket == nullptr || !(chunk == lastChunk))
+                {
+                    lastChunk = chunk;
+                    bucket    = &buckets[chunk];
+                }
+                bucket->push_back(static_cast<uint32_t>(ChunkIndex(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK)) << 8 | kind);
+                ++result.VoxelCount;
+            }
+
+            chunkPositions.clear();
+            chunkBuckets.clear();
+            for (const auto& [pos, entries] : buckets)
+            {
+                chunkPositions.push_back(pos);
+                chunkBuckets.push_back(&entries);
+                written.insert(pos);
+            }
+
+            if (options.Pool != nullptr && map.PrepareConcurrentChunkWrites(chunkPositions))
+            {
+                try
+                {
+                    options.Pool->ParallelFor(chunkPositions.size(), insertBucket);
+                }
+                catch (...)
+                {
+                    map.FinishConcurrentChunkWrites();
+                    throw;
+                }
+                map.FinishConcurrentChunkWrites();
+            }
+            else
+            {
+                for (std::size_t i = 0; i < chunkPositions.size(); ++i)
+                    insertBucket(i);
+            }
+            buckets.clear();
+        }
+        result.ChunkCount = written.size();
+        return result;
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Voxel/IVoxelMap.h"
+
+namespace Voxium::Core
+{
+    class ThreadPool;
+
+    struct VoxImportOptions
+    {
+        // Map coordinate that receives the minimum corner of the scene.
+        Int3 Origin {0, 0, 0};
+
+        // MagicaVoxel is z-up; swapping y and z lands the scene y-up in the map.
+        bool SwapYZ = true;
+
+        // Workers used for chunk insertion. Nullptr inserts on the calling thread.
+        ThreadPool* Pool = nullptr;
+    };
+
+    struct VoxImportResult
+    {
+        std::size_t ModelCount    = 0;
+        std::size_t InstanceCount = 0;
+        std::size_t VoxelCount    = 0;
+        std::size_t ChunkCount    = 0;
+
+        // Scene bounds in map coordinates, max exclusive.
+        Int3 Min {0, 0, 0};
+        Int3 Max {0, 0, 0};
+    };
+
+    //--------------------------------------------------------------------------------
+    // VoxImporter: reader for MagicaVoxel .vox files. The file is memory mapped and
+    // walked chunk by chunk (SIZE/XYZI/RGBA and the nTRN/nGRP/nSHP scene graph); voxel
+    // data is read in place and never copied as a whole. The scene graph follows the
+    // models it places, so voxels are written once the whole file is parsed, one model
+    // instance at a time: its voxels are bucketed by destination chunk and each bucket
+    // is written with one IVoxelMap::AddBlocks call, on worker threads when the map
+    // allows it.
+    //--------------------------------------------------------------------------------
+    class CORE_API VoxImporter
+    {
+    public:
+        // Throws std::runtime_error on I/O errors or malformed files, e.g. voxels outside the SIZE of
+        // their model; the map is untouched then.
+        static VoxImportResult Import(const std::filesystem::path& path, IVoxelMap& map, const VoxImportOptions& options = {});
+
+        // Same as Import, reading from a buffer that already holds the whole file.
+        static VoxImportResult Import(std::span<const uint8_t> bytes, IVoxelMap& map, const VoxImportOptions& options = {});
+    };
+
+} // namespace Voxium::Core
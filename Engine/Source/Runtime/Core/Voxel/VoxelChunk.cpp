@@ -0,0 +1,374 @@
+#include "Voxel/VoxelChunk.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        // Smallest supported index width able to address the given palette size.
+        int BitsForPaletteSize(std::size_t size)
+        {
+            if (size <= 1)
+                return 0;
+            int bits = 1;
+            while ((std::size_t {1} << bits) < size)
+            {
+                bits *= 2;
+            }
+            return bits;
+        }
+
+        std::size_t WordsForBits(int bits) { return static_cast<std::size_t>(CHUNK_VOLUME * bits) / 64; }
+
+        std::size_t BrickOf(int index)
+        {
+            return static_cast<std::size_t>(VoxelChunk::BrickIndex(index & CHUNK_MASK, index >> (2 * CHUNK_SHIFT), (index >> CHUNK_SHIFT) & CHUNK_MASK));
+        }
+    } // namespace
+
+    VoxelChunk::VoxelChunk(BlockKind fill) : storage_({fill}, {}) { ResetOccupancy(fill != AIR_KIND); }
+
+    VoxelChunk VoxelChunk::FromPacked(std::vector<BlockKind> palette, int bits, std::vector<uint64_t> indices)
+    {
+        const bool validBits = bits == 0 || bits == 1 || bits == 2 || bits == 4 || bits == 8 || bits == 16;
+        if (!validBits || palette.empty() || (bits == 0 && palette.size() != 1) || palette.size() > (std::size_t {1} << bits) ||
+            indices.size() != WordsForBits(bits))
+        {
+            throw std::invalid_argument("Packed chunk data is inconsistent");
+        }
+
+        // Lookups stop at the first entry of a kind, so a second one would never be found again.
+        std::vector<BlockKind> kinds = palette;
+        std::sort(kinds.begin(), kinds.end());
+        if (std::adjacent_find(kinds.begin(), kinds.end()) != kinds.end())
+        {
+            throw std::invalid_argument("Packed chunk palette repeats a kind");
+        }
+
+        VoxelChunk chunk;
+        chunk.storage_->Palette = std::move(palette);
+        chunk.storage_->Data    = std::move(indices);
+        chunk.bits_             = bits;
+        chunk.mask_             = (1u << bits) - 1;
+
+        // Unless the palette fills the index range, an index may point past its end.
+        if (bits > 0 && chunk.storage_->Palette.size() < (std::size_t {1} << bits))
+        {
+            uint32_t highest = 0;
+            for (int i = 0; i < CHUNK_VOLUME; ++i)
+            {
+                highest = std::max(highest, chunk.ReadIndex(i));
+            }
+            if (highest >= chunk.storage_->Palette.size())
+            {
+                throw std::invalid_argument("Packed chunk index outside its palette");
+            }
+        }
+        chunk.RecountOccupancy();
+        return chunk;
+    }
+
+    VoxelChunk VoxelChunk::FromKinds(std::span<const BlockKind, CHUNK_VOLUME> kinds, ChunkLayout layout)
+    {
+        // The palette first, then the indices packed once at their final width; growing the
+        // palette voxel by voxel would repack the indices at every width.
+        std::vector<BlockKind> palette {kinds[0]};
+        std::vector<uint16_t>  paletteIndices(CHUNK_VOLUME);
+        BlockKind              lastKind  = kinds[0];
+        uint16_t               lastIndex = 0;
+        for (std::size_t i = 0; i < CHUNK_VOLUME; ++i)
+        {
+            const BlockKind kind = kinds[i];
+            if (kind != lastKind)
+            {
+                const auto found = std::find(palette.begin(), palette.end(), kind);
+                lastKind         = kind;
+                lastIndex        = static_cast<uint16_t>(found - palette.begin());
+                if (found == palette.end())
+                    palette.push_back(kind);
+            }
+            paletteIndices[i] = lastIndex;
+        }
+
+        const int bits = BitsForPaletteSize(palette.size());
+        if (bits == 0)
+            return VoxelChunk(palette[0]);
+
+        std::vector<uint64_t> data(WordsForBits(bits), 0);
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+        {
+            const int source =
+                layout == ChunkLayout::Linear ? i : ChunkLayoutIndex(layout, i & CHUNK_MASK, i >> (2 * CHUNK_SHIFT), (i >> CHUNK_SHIFT) & CHUNK_MASK);
+            const uint32_t bitPos = static_cast<uint32_t>(i * bits);
+            data[bitPos >> 6] |= static_cast<uint64_t>(paletteIndices[static_cast<std::size_t>(source)]) << (bitPos & 63);
+        }
+
+        VoxelChunk chunk;
+        chunk.storage_ = StorageRef(std::move(palette), std::move(data));
+        chunk.bits_    = bits;
+        chunk.mask_    = (1u << bits) - 1;
+        chunk.RecountOccupancy();
+        return chunk;
+    }
+
+    void VoxelChunk::Set(int index, BlockKind kind)
+    {
+        if (bits_ == 0 && storage_->Palette[0] == kind)
+            return;
+
+        Detach();
+        const bool     wasSolid     = IsEmpty() || IsFull() ? IsFull() : Get(index) != AIR_KIND;
+        const uint32_t paletteIndex = FindOrAddPaletteEntry(kind);
+        WriteIndex(index, paletteIndex);
+        if (wasSolid != (kind != AIR_KIND))
+            CountChange(BrickOf(index), wasSolid ? -1 : 1);
+    }
+
+    void VoxelChunk::SetRun(int index, std::span<const BlockKind> kinds)
+    {
+        // Runs are usually made of long stretches of one kind, so remember the last palette lookup.
+        // The run crosses at most the four bricks of its row; voxels of an empty or full chunk
+        // need not be read to know what they were.
+        if (bits_ != 0 || std::any_of(kinds.begin(), kinds.end(), [&](BlockKind kind) { return kind != storage_->Palette[0]; }))
+            Detach();
+        const std::size_t rowBrick                         = BrickOf(index & ~CHUNK_MASK);
+        const bool        mixed                            = !IsEmpty() && !IsFull();
+        int               flipped[CHUNK_SIZE / BRICK_SIZE] = {};
+        BlockKind         lastKind                         = storage_->Palette[0];
+        uint32_t          lastPaletteIndex                 = 0;
+        for (BlockKind kind : kinds)
+        {
+            if (bits_ == 0 && storage_->Palette[0] == kind)
+            {
+                ++index;
+                continue;
+            }
+            const bool wasSolid = mixed ? Get(index) != AIR_KIND : IsFull();
+            if (kind != lastKind || bits_ == 0)
+            {
+                lastKind         = kind;
+                lastPaletteIndex = FindOrAddPaletteEntry(kind);
+            }
+            WriteIndex(index, lastPaletteIndex);
+            flipped[(index & CHUNK_MASK) >> BRICK_SHIFT] += (kind != AIR_KIND) - wasSolid;
+            ++index;
+        }
+        for (std::size_t brick = 0; brick < CHUNK_SIZE / BRICK_SIZE; ++brick)
+        {
+            if (flipped[brick] != 0)
+                CountChange(rowBrick + brick, flipped[brick]);
+        }
+    }
+
+    void VoxelChunk::FillBox(int minX, int minY, int minZ, int maxX, int maxY, int maxZ, BlockKind kind)
+    {
+        if (minX == 0 && minY == 0 && minZ == 0 && maxX == CHUNK_SIZE && maxY == CHUNK_SIZE && maxZ == CHUNK_SIZE)
+        {
+            Fill(kind);
+            return;
+        }
+        if (bits_ == 0 && storage_->Palette[0] == kind)
+            return;
+
+        Detach();
+
+        // Voxels of an empty or full chunk all flip or all stay, so they need not be read.
+        const bool                   solid        = kind != AIR_KIND;
+        const bool                   mixed        = !IsEmpty() && !IsFull();
+        const bool                   flipsAll     = solid ? IsEmpty() : IsFull();
+        std::array<int, BRICK_COUNT> flipped      = {};
+        const uint32_t               paletteIndex = FindOrAddPaletteEntry(kind);
+        for (int y = minY; y < maxY; ++y)
+        {
+            for (int z = minZ; z < maxZ; ++z)
+            {
+                const int row = ChunkIndex(0, y, z);
+                for (int x = minX; x < maxX; ++x)
+                {
+                    if (mixed ? (storage_->Palette[ReadIndex(row + x)] != AIR_KIND) != solid : flipsAll)
+                        ++flipped[static_cast<std::size_t>(BrickIndex(x, y, z))];
+                    WriteIndex(row + x, paletteIndex);
+                }
+            }
+        }
+        for (std::size_t brick = 0; brick < BRICK_COUNT; ++brick)
+        {
+            if (flipped[brick] != 0)
+                CountChange(brick, solid ? flipped[brick] : -flipped[brick]);
+        }
+    }
+
+    void VoxelChunk::Fill(BlockKind kind)
+    {
+        if (storage_.Unique())
+        {
+            storage_->Palette.assign(1, kind);
+            storage_->Palette.shrink_to_fit();
+            storage_->Data.clear();
+            storage_->Data.shrink_to_fit();
+        }
+        else
+        {
+            storage_ = StorageRef({kind}, {});
+        }
+        bits_ = 0;
+        mask_ = 0;
+        ResetOccupancy(kind != AIR_KIND);
+    }
+
+    void VoxelChunk::Unpack(std::span<BlockKind, CHUNK_VOLUME> kinds, ChunkLayout layout) const
+    {
+        if (bits_ == 0)
+        {
+            std::fill(kinds.begin(), kinds.end(), storage_->Palette[0]);
+            return;
+        }
+        if (layout == ChunkLayout::Linear)
+        {
+            for (int i = 0; i < CHUNK_VOLUME; ++i)
+            {
+                kinds[static_cast<std::size_t>(i)] = storage_->Palette[ReadIndex(i)];
+            }
+            return;
+        }
+
+        // x only fills every third bit of the code, so a row is the row's code ORed with its x codes.
+        int xCodes[CHUNK_SIZE];
+        for (int x = 0; x < CHUNK_SIZE; ++x)
+        {
+            xCodes[x] = ChunkMortonIndex(x, 0, 0);
+        }
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+        {
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+            {
+                const int first   = ChunkIndex(0, y, z);
+                const int rowCode = ChunkMortonIndex(0, y, z);
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                {
+                    kinds[static_cast<std::size_t>(rowCode | xCodes[x])] = storage_->Palette[ReadIndex(first + x)];
+                }
+            }
+        }
+    }
+
+    void VoxelChunk::Compact()
+    {
+        if (bits_ == 0)
+            return;
+
+        std::vector<uint32_t> counts(storage_->Palette.size(), 0);
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+        {
+            ++counts[ReadIndex(i)];
+        }
+
+        std::vector<uint32_t>  remap(storage_->Palette.size(), 0);
+        std::vector<BlockKind> palette;
+        for (std::size_t i = 0; i < storage_->Palette.size(); ++i)
+        {
+            if (counts[i] > 0)
+            {
+                remap[i] = static_cast<uint32_t>(palette.size());
+                palette.push_back(storage_->Palette[i]);
+            }
+        }
+
+        if (palette.size() == 1)
+        {
+            Fill(palette[0]);
+            return;
+        }
+
+        const int             bits = BitsForPaletteSize(palette.size());
+        std::vector<uint64_t> data(WordsForBits(bits), 0);
+        const uint32_t        mask = (1u << bits) - 1;
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+        {
+            const uint32_t bitPos = static_cast<uint32_t>(i * bits);
+            data[bitPos >> 6] |= static_cast<uint64_t>(remap[ReadIndex(i)] & mask) << (bitPos & 63);
+        }
+
+        palette.shrink_to_fit();
+        storage_ = StorageRef(std::move(palette), std::move(data));
+        bits_    = bits;
+        mask_    = mask;
+    }
+
+    std::size_t VoxelChunk::MemoryUsage() const { return storage_->Palette.capacity() * sizeof(BlockKind) + storage_->Data.capacity() * sizeof(uint64_t); }
+
+    void VoxelChunk::Detach()
+    {
+        if (!storage_.Unique())
+        {
+            storage_ = StorageRef(storage_->Palette, storage_->Data);
+        }
+    }
+
+    uint32_t VoxelChunk::FindOrAddPaletteEntry(BlockKind kind)
+    {
+        auto it = std::find(storage_->Palette.begin(), storage_->Palette.end(), kind);
+        if (it != storage_->Palette.end())
+            return static_cast<uint32_t>(it - storage_->Palette.begin());
+
+        storage_->Palette.push_back(kind);
+        if (storage_->Palette.size() > (std::size_t {1} << bits_))
+        {
+            Repack(BitsForPaletteSize(storage_->Palette.size()));
+        }
+        return static_cast<uint32_t>(storage_->Palette.size() - 1);
+    }
+
+    void VoxelChunk::Repack(int bits)
+    {
+        std::vector<uint64_t> data(WordsForBits(bits), 0);
+        if (bits_ > 0)
+        {
+            for (int i = 0; i < CHUNK_VOLUME; ++i)
+            {
+                const uint32_t bitPos = static_cast<uint32_t>(i * bits);
+                data[bitPos >> 6] |= static_cast<uint64_t>(ReadIndex(i)) << (bitPos & 63);
+            }
+        }
+
+        storage_->Data = std::move(data);
+        bits_ = bits;
+        mask_ = (1u << bits) - 1;
+    }
+
+    void VoxelChunk::CountChange(std::size_t brick, int delta)
+    {
+        const uint64_t bit   = uint64_t {1} << brick;
+        uint16_t&      count = brickSolid_[brick];
+        count                = static_cast<uint16_t>(count + delta);
+        solidCount_ += delta;
+        occupiedBricks_ = count != 0 ? occupiedBricks_ | bit : occupiedBricks_ & ~bit;
+        fullBricks_     = count == BRICK_VOLUME ? fullBricks_ | bit : fullBricks_ & ~bit;
+    }
+
+    void VoxelChunk::ResetOccupancy(bool solid)
+    {
+        solidCount_     = solid ? CHUNK_VOLUME : 0;
+        occupiedBricks_ = solid ? ~uint64_t {0} : 0;
+        fullBricks_     = occupiedBricks_;
+        brickSolid_.fill(static_cast<uint16_t>(solid ? BRICK_VOLUME : 0));
+    }
+
+    void VoxelChunk::RecountOccupancy()
+    {
+        std::array<int, BRICK_COUNT> solid = {};
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+        {
+            solid[BrickOf(i)] += Get(i) != AIR_KIND;
+        }
+        ResetOccupancy(false);
+        for (std::size_t brick = 0; brick < BRICK_COUNT; ++brick)
+        {
+            if (solid[brick] != 0)
+                CountChange(brick, solid[brick]);
+        }
+    }
+
+} // namespace Voxium::Core
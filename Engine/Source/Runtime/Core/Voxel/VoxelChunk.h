@@ -0,0 +1,269 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Morton.h"
+#include "Voxel/IVoxelMap.h"
+
+namespace Voxium::Core
+{
+    constexpr int CHUNK_SHIFT  = 5;
+    constexpr int CHUNK_SIZE   = 1 << CHUNK_SHIFT;
+    constexpr int CHUNK_MASK   = CHUNK_SIZE - 1;
+    constexpr int CHUNK_AREA   = CHUNK_SIZE * CHUNK_SIZE;
+    constexpr int CHUNK_VOLUME = CHUNK_AREA * CHUNK_SIZE;
+
+    // First voxel of a chunk, the minimum corner of its bounds; they end CHUNK_SIZE further on every axis.
+    constexpr Int3 ChunkBoundsMin(const Int3& chunkPos) { return Int3(chunkPos.X << CHUNK_SHIFT, chunkPos.Y << CHUNK_SHIFT, chunkPos.Z << CHUNK_SHIFT); }
+
+    constexpr BlockKind AIR_KIND = 0;
+
+    // Faces of a voxel or chunk, also used as the neighbour order around a chunk.
+    enum class BlockFace : uint8_t
+    {
+        PositiveX,
+        NegativeX,
+        PositiveY,
+        NegativeY,
+        PositiveZ,
+        NegativeZ
+    };
+
+    constexpr int BLOCK_FACE_COUNT = 6;
+
+    constexpr Int3 FaceNormal(BlockFace face)
+    {
+        switch (face)
+        {
+            case BlockFace::PositiveX:
+                return Int3(1, 0, 0);
+            case BlockFace::NegativeX:
+                return Int3(-1, 0, 0);
+            case BlockFace::PositiveY:
+                return Int3(0, 1, 0);
+            case BlockFace::NegativeY:
+                return Int3(0, -1, 0);
+            case BlockFace::PositiveZ:
+                return Int3(0, 0, 1);
+            default:
+                return Int3(0, 0, -1);
+        }
+    }
+
+    // Linear voxel index inside a chunk: x runs fastest, then z, then y.
+    constexpr int ChunkIndex(int x, int y, int z) { return x | (z << CHUNK_SHIFT) | (y << (2 * CHUNK_SHIFT)); }
+
+    // Morton voxel index inside a chunk, with z bits below y bits as in ChunkIndex(): the eight
+    // voxels of every aligned 2^3 cube are consecutive, in ChunkIndex() order.
+    constexpr int ChunkMortonIndex(int x, int y, int z) { return static_cast<int>(MortonEncode(x, z, y)); }
+
+    // Order of the voxels in arrays holding a whole chunk.
+    enum class ChunkLayout : uint8_t
+    {
+        Linear, // ChunkIndex()
+        Morton  // ChunkMortonIndex()
+    };
+
+    constexpr int ChunkLayoutIndex(ChunkLayout layout, int x, int y, int z)
+    {
+        return layout == ChunkLayout::Morton ? ChunkMortonIndex(x, y, z) : ChunkIndex(x, y, z);
+    }
+
+    //--------------------------------------------------------------------------------
+    // VoxelChunk: a 32^3 block of voxels stored as a per-chunk palette plus
+    // bit-packed palette indices. The index width starts at 0 bits (uniform chunk)
+    // and is widened to 1/2/4/8/16 bits when the palette outgrows it. Widths are
+    // powers of two, so an index never straddles two 64-bit words.
+    //
+    // Every write also keeps the chunk's occupancy summary: how many voxels are not air,
+    // and which of its 64 bricks of 8^3 voxels hold any or only such voxels, so readers
+    // can skip empty and solid space without decoding indices.
+    //
+    // Copies share the palette and indices until one of them is written, which clones
+    // them (copy-on-write). Copying is O(1), so a copy makes a snapshot that jobs on
+    // other threads can read while the original keeps being edited. Copy a chunk on the
+    // thread that writes it; the copies can then be read and destroyed anywhere.
+    //--------------------------------------------------------------------------------
+    class CORE_API VoxelChunk
+    {
+    public:
+        static constexpr int BRICK_SHIFT  = 3;
+        static constexpr int BRICK_SIZE   = 1 << BRICK_SHIFT;
+        static constexpr int BRICK_VOLUME = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+        static constexpr int BRICK_COUNT  = CHUNK_VOLUME / BRICK_VOLUME;
+
+        // Bit of a voxel's brick in the brick masks: bx | bz << 2 | by << 4, like ChunkIndex().
+        static constexpr int BrickIndex(int x, int y, int z)
+        {
+            constexpr int AXIS_SHIFT = CHUNK_SHIFT - BRICK_SHIFT;
+            return (x >> BRICK_SHIFT) | (z >> BRICK_SHIFT) << AXIS_SHIFT | (y >> BRICK_SHIFT) << (2 * AXIS_SHIFT);
+        }
+
+        explicit VoxelChunk(BlockKind fill = AIR_KIND);
+
+        // Rebuilds a chunk from the Palette(), BitsPerIndex() and PackedIndices() of another.
+        // Throws std::invalid_argument if they do not describe a valid chunk, e.g. a palette that
+        // lists a kind twice.
+        static VoxelChunk FromPacked(std::vector<BlockKind> palette, int bits, std::vector<uint64_t> indices);
+
+        // Builds a chunk from the kind of every voxel, in the given layout.
+        static VoxelChunk FromKinds(std::span<const BlockKind, CHUNK_VOLUME> kinds, ChunkLayout layout = ChunkLayout::Linear);
+
+        BlockKind Get(int x, int y, int z) const { return Get(ChunkIndex(x, y, z)); }
+
+        BlockKind Get(int index) const
+        {
+            if (bits_ == 0)
+            {
+                return storage_->Palette[0];
+            }
+            return storage_->Palette[ReadIndex(index)];
+        }
+
+        // Raw palette index of a voxel; Palette()[PaletteIndex(i)] == Get(i).
+        uint32_t PaletteIndex(int index) const { return bits_ == 0 ? 0 : ReadIndex(index); }
+
+        // Packed index words, CHUNK_VOLUME * BitsPerIndex() / 64 of them (none when uniform).
+        const std::vector<uint64_t>& PackedIndices() const { return storage_->Data; }
+
+        void Set(int x, int y, int z, BlockKind kind) { Set(ChunkIndex(x, y, z), kind); }
+
+        void Set(int index, BlockKind kind);
+
+        // Writes consecutive voxels starting at index; the run must stay inside one x row.
+        void SetRun(int index, std::span<const BlockKind> kinds);
+
+        // Sets the half-open local box [min, max) to a single kind.
+        void FillBox(int minX, int minY, int minZ, int maxX, int maxY, int maxZ, BlockKind kind);
+
+        // Replaces every voxel with the given kind and drops the index array.
+        void Fill(BlockKind kind);
+
+        // Writes the kind of every voxel, in the given layout; kernels that look at neighbours in
+        // all three axes, like downsampling, read Morton arrays with fewer cache misses.
+        void Unpack(std::span<BlockKind, CHUNK_VOLUME> kinds, ChunkLayout layout = ChunkLayout::Linear) const;
+
+        // Rebuilds the palette without unused entries and narrows the index width if possible.
+        void Compact();
+
+        // True when every voxel holds the same kind and no index array is stored.
+        bool IsUniform() const { return bits_ == 0; }
+
+        int BitsPerIndex() const { return bits_; }
+
+        // Voxels that are not air.
+        int SolidCount() const { return solidCount_; }
+
+        // Only air, whether or not the chunk is uniform.
+        bool IsEmpty() const { return solidCount_ == 0; }
+
+        // No air at all.
+        bool IsFull() const { return solidCount_ == CHUNK_VOLUME; }
+
+        // Bricks holding at least one voxel that is not air.
+        uint64_t OccupiedBricks() const { return occupiedBricks_; }
+
+        // Bricks without any air.
+        uint64_t FullBricks() const { return fullBricks_; }
+
+        const std::vector<BlockKind>& Palette() const { return storage_->Palette; }
+
+        // True while the two chunks are copies sharing their palette and indices.
+        bool SharesStorageWith(const VoxelChunk& other) const { return storage_ == other.storage_; }
+
+        // Heap bytes held by the palette and the packed indices, shared ones included.
+        std::size_t MemoryUsage() const;
+
+    private:
+        struct Storage
+        {
+            std::atomic<uint32_t>  References {1};
+            std::vector<BlockKind> Palette;
+            std::vector<uint64_t>  Data;
+        };
+
+        // Counted reference to a Storage. Unlike std::shared_ptr's use_count(), Unique()
+        // synchronizes with copies released on other threads, so their reads of the storage
+        // happen before it is written again.
+        class StorageRef
+        {
+        public:
+            StorageRef(std::vector<BlockKind> palette, std::vector<uint64_t> data) : storage_(new Storage)
+            {
+                storage_->Palette = std::move(palette);
+                storage_->Data    = std::move(data);
+            }
+
+            StorageRef(const StorageRef& other) : storage_(other.storage_) { storage_->References.fetch_add(1, std::memory_order_relaxed); }
+
+            StorageRef(StorageRef&& other) noexcept : storage_(std::exchange(other.storage_, nullptr)) {}
+
+            StorageRef& operator=(StorageRef other) noexcept
+            {
+                std::swap(storage_, other.storage_);
+                return *this;
+            }
+
+            ~StorageRef()
+            {
+                if (storage_ != nullptr && storage_->References.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete storage_;
+            }
+
+            Storage* operator->() const { return storage_; }
+
+            bool Unique() const { return storage_->References.load(std::memory_order_acquire) == 1; }
+
+            bool operator==(const StorageRef& other) const { return storage_ == other.storage_; }
+
+        private:
+            Storage* storage_;
+        };
+
+        uint32_t ReadIndex(int index) const
+        {
+            const uint32_t bitPos = static_cast<uint32_t>(index * bits_);
+            return static_cast<uint32_t>(storage_->Data[bitPos >> 6] >> (bitPos & 63)) & mask_;
+        }
+
+        void WriteIndex(int index, uint32_t value)
+        {
+            const uint32_t bitPos = static_cast<uint32_t>(index * bits_);
+            uint64_t&      word   = storage_->Data[bitPos >> 6];
+            const int      shift  = bitPos & 63;
+            word                  = (word & ~(static_cast<uint64_t>(mask_) << shift)) | (static_cast<uint64_t>(value) << shift);
+        }
+
+        // Clones the storage if a copy shares it; call before writing it.
+        void Detach();
+
+        uint32_t FindOrAddPaletteEntry(BlockKind kind);
+
+        void Repack(int bits);
+
+        // Adds delta voxels that turned solid (or air, when negative) to a brick's occupancy.
+        void CountChange(std::size_t brick, int delta);
+
+        // Occupancy of a chunk made only of air or only of solid voxels.
+        void ResetOccupancy(bool solid);
+
+        void RecountOccupancy();
+
+        StorageRef                        storage_;
+        int                               bits_           = 0;
+        uint32_t                          mask_           = 0;
+        int                               solidCount_     = 0;
+        uint64_t                          occupiedBricks_ = 0;
+        uint64_t                          fullBricks_     = 0;
+        std::array<uint16_t, BRICK_COUNT> brickSolid_ {}; // solid voxels per brick
+    };
+
+} // namespace Voxium::Core
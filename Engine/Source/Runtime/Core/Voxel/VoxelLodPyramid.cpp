@@ -0,0 +1,308 @@
+#include "Voxel/VoxelLodPyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr int HALF_SIZE = CHUNK_SIZE / 2;
+
+        // Cells under a coarser cell are numbered dx | dz << 1 | dy << 2, so the upper half is 4..7.
+        constexpr int UPPER_CELLS = 4;
+
+        // Octants are numbered like the cells, x | z << 1 | y << 2.
+        Int3 ChildOf(const Int3& nodePos, int octant)
+        {
+            return Int3(nodePos.X * 2 + (octant & 1), nodePos.Y * 2 + (octant >> 2), nodePos.Z * 2 + ((octant >> 1) & 1));
+        }
+
+        Int3 ParentOf(const Int3& nodePos) { return Int3(nodePos.X >> 1, nodePos.Y >> 1, nodePos.Z >> 1); }
+
+        int OctantOf(const Int3& nodePos) { return (nodePos.X & 1) | (nodePos.Z & 1) << 1 | (nodePos.Y & 1) << 2; }
+
+        // Distance from a point to the half-open box [min, min + size) along one axis.
+        float AxisDistance(float point, int min, int size)
+        {
+            const float low = static_cast<float>(min);
+            if (point < low)
+                return low - point;
+            return std::max(0.0f, point - static_cast<float>(min + size));
+        }
+    } // namespace
+
+    VoxelLodPyramid::VoxelLodPyramid(const ChunkedVoxelMap& map, int levels, LodFilter filter) : map_(map), filter_(filter)
+    {
+        if (levels < 0 || levels > MAX_LEVEL)
+            throw std::invalid_argument("LOD level count out of range");
+
+        levels_.resize(static_cast<std::size_t>(levels));
+        dirty_.resize(static_cast<std::size_t>(levels));
+        source_.resize(CHUNK_VOLUME);
+    }
+
+    void VoxelLodPyramid::Rebuild()
+    {
+        for (auto& level : levels_)
+            level.clear();
+        map_.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk&) { MarkChunkDirty(chunkPos); });
+        Update();
+    }
+
+    void VoxelLodPyramid::MarkChunkDirty(const Int3& chunkPos)
+    {
+        if (!levels_.empty())
+            dirty_[0].insert(chunkPos);
+    }
+
+    void VoxelLodPyramid::MarkBoxDirty(const Int3& origin, const Int3& size)
+    {
+        if (size.X <= 0 || size.Y <= 0 || size.Z <= 0)
+            return;
+
+        const Int3 first = ChunkOf(origin.X, origin.Y, origin.Z);
+        const Int3 last  = ChunkOf(origin.X + size.X - 1, origin.Y + size.Y - 1, origin.Z + size.Z - 1);
+        for (int cy = first.Y; cy <= last.Y; ++cy)
+            for (int cz = first.Z; cz <= last.Z; ++cz)
+                for (int cx = first.X; cx <= last.X; ++cx)
+                    MarkChunkDirty(Int3(cx, cy, cz));
+    }
+
+    const std::vector<LodNode>& VoxelLodPyramid::Update()
+    {
+        updated_.clear();
+        std::unordered_map<Int3, uint8_t, Int3Hasher> octants;
+        for (int level = 1; level <= Levels(); ++level)
+        {
+            // Only the octants under changed children are reduced again, and a node that comes
+            // out the same stops the update from going further up.
+            auto& children = dirty_[static_cast<std::size_t>(level - 1)];
+            octants.clear();
+            for (const Int3& childPos : children)
+                octants[ParentOf(childPos)] |= static_cast<uint8_t>(1u << OctantOf(childPos));
+            children.clear();
+
+            for (const auto& [nodePos, mask] : octants)
+            {
+                if (!UpdateNode(level, nodePos, mask))
+                    continue;
+                updated_.push_back({nodePos, level});
+                if (level < Levels())
+                    dirty_[static_cast<std::size_t>(level)].insert(nodePos);
+            }
+        }
+        return updated_;
+    }
+
+    const VoxelChunk* VoxelLodPyramid::GetNode(int level, const Int3& nodePos) const
+    {
+        if (level < 0 || level > Levels())
+            throw std::out_of_range("LOD level out of range");
+        if (level == 0)
+            return map_.GetChunk(nodePos);
+
+        const auto& nodes = levels_[static_cast<std::size_t>(level - 1)];
+        auto        it    = nodes.find(nodePos);
+        return it != nodes.end() ? &it->second : nullptr;
+    }
+
+    ChunkNeighbourhood VoxelLodPyramid::Neighbourhood(int level, const Int3& nodePos) const
+    {
+        ChunkNeighbourhood neighbourhood;
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dz = -1; dz <= 1; ++dz)
+                for (int dx = -1; dx <= 1; ++dx)
+                    neighbourhood.Chunks[ChunkNeighbourhood::Slot(dx, dy, dz)] = GetNode(level, nodePos + Int3(dx, dy, dz));
+        return neighbourhood;
+    }
+
+    void VoxelLodPyramid::SelectNodes(const Vector3F& camera, int ringRadius, std::vector<LodNode>& nodes) const
+    {
+        if (ringRadius < 1)
+            throw std::invalid_argument("LOD ring radius must be at least one chunk");
+
+        nodes.clear();
+        const Vector3F cameraChunk(camera.X / CHUNK_SIZE, camera.Y / CHUNK_SIZE, camera.Z / CHUNK_SIZE);
+        const Int3     top = TopNodes();
+        for (int y = 0; y < top.Y; ++y)
+            for (int z = 0; z < top.Z; ++z)
+                for (int x = 0; x < top.X; ++x)
+                    Select(Levels(), Int3(x, y, z), cameraChunk, ringRadius, nodes);
+    }
+
+    std::size_t VoxelLodPyramid::NodeCount() const
+    {
+        std::size_t count = 0;
+        for (const auto& level : levels_)
+            count += level.size();
+        return count;
+    }
+
+    std::size_t VoxelLodPyramid::MemoryUsage() const
+    {
+        std::size_t bytes = 0;
+        for (const auto& level : levels_)
+            for (const auto& [nodePos, node] : level)
+                bytes += sizeof(node) + node.MemoryUsage();
+        return bytes;
+    }
+
+    bool VoxelLodPyramid::UpdateNode(int level, const Int3& nodePos, uint8_t octants)
+    {
+        auto& nodes   = levels_[static_cast<std::size_t>(level - 1)];
+        auto  it      = nodes.find(nodePos);
+        bool  changed = false;
+        for (int octant = 0; octant < 8; ++octant)
+        {
+            if ((octants >> octant & 1) == 0)
+                continue;
+            const VoxelChunk* child = GetNode(level - 1, ChildOf(nodePos, octant));
+            if (it == nodes.end())
+            {
+                if (child == nullptr)
+                    continue;
+                it = nodes.try_emplace(nodePos).first;
+            }
+            changed |= ReduceOctant(it->second, octant, child);
+        }
+        if (it == nodes.end())
+            return false;
+
+        if (changed)
+            it->second.Compact();
+        if (it->second.IsUniform() && it->second.Get(0) == AIR_KIND)
+            nodes.erase(it);
+        return changed;
+    }
+
+    bool VoxelLodPyramid::ReduceOctant(VoxelChunk& node, int octant, const VoxelChunk* child)
+    {
+        // Each child node shrinks into one octant of its parent.
+        const int minX = (octant & 1) * HALF_SIZE;
+        const int minY = (octant >> 2) * HALF_SIZE;
+        const int minZ = ((octant >> 1) & 1) * HALF_SIZE;
+        const int base = ChunkIndex(minX, minY, minZ);
+        if (child == nullptr || child->IsUniform())
+        {
+            // Both filters keep a uniform block of cells as it is.
+            const BlockKind kind = child != nullptr ? child->Get(0) : AIR_KIND;
+            for (int y = 0; y < HALF_SIZE; ++y)
+                for (int z = 0; z < HALF_SIZE; ++z)
+                    for (int x = 0; x < HALF_SIZE; ++x)
+                        if (node.Get(base + ChunkIndex(x, y, z)) != kind)
+                        {
+                            node.FillBox(minX, minY, minZ, minX + HALF_SIZE, minY + HALF_SIZE, minZ + HALF_SIZE, kind);
+                            return true;
+                        }
+            return false;
+        }
+
+        // In Morton order the eight cells under a node voxel are consecutive, already in Reduce() order.
+        child->Unpack(std::span<BlockKind, CHUNK_VOLUME>(source_.data(), CHUNK_VOLUME), ChunkLayout::Morton);
+
+        bool changed = false;
+        for (int y = 0; y < HALF_SIZE; ++y)
+            for (int z = 0; z < HALF_SIZE; ++z)
+                for (int x = 0; x < HALF_SIZE; ++x)
+                {
+                    BlockKind cells[8];
+                    std::copy_n(source_.data() + 8 * ChunkMortonIndex(x, y, z), 8, cells);
+                    const BlockKind kind  = Reduce(cells);
+                    const int       index = base + ChunkIndex(x, y, z);
+                    if (node.Get(index) != kind)
+                    {
+                        node.Set(index, kind);
+                        changed = true;
+                    }
+                }
+        return changed;
+    }
+
+    BlockKind VoxelLodPyramid::Reduce(const BlockKind (&cells)[8]) const
+    {
+        int differ = 0;
+        for (int c = 1; c < 8; ++c)
+            differ |= cells[c] ^ cells[0];
+        if (differ == 0)
+            return cells[0];
+
+        // Scores are compared upper cells first, so the upper kind wins ties.
+        BlockKind best      = AIR_KIND;
+        int       bestScore = -1;
+        if (filter_ == LodFilter::Majority)
+        {
+            for (int c = 7; c >= 0; --c)
+            {
+                const int count = static_cast<int>(std::count(cells, cells + 8, cells[c]));
+                const int score = count * 2 + (cells[c] != AIR_KIND ? 1 : 0);
+                if (score > bestScore)
+                {
+                    best      = cells[c];
+                    bestScore = score;
+                }
+            }
+            return best;
+        }
+
+        if (std::count(cells, cells + 8, AIR_KIND) > 4)
+            return AIR_KIND;
+
+        bool visible[8];
+        for (int c = 0; c < 8; ++c)
+            visible[c] = cells[c] != AIR_KIND && (c >= UPPER_CELLS || cells[c + UPPER_CELLS] == AIR_KIND);
+        for (int c = 7; c >= 0; --c)
+        {
+            if (cells[c] == AIR_KIND)
+                continue;
+            int seen  = 0;
+            int count = 0;
+            for (int other = 0; other < 8; ++other)
+                if (cells[other] == cells[c])
+                {
+                    seen += visible[other];
+                    ++count;
+                }
+            const int score = seen * 8 + count;
+            if (score > bestScore)
+            {
+                best      = cells[c];
+                bestScore = score;
+            }
+        }
+        return best;
+    }
+
+    void VoxelLodPyramid::Select(int level, const Int3& nodePos, const Vector3F& camera, int ringRadius, std::vector<LodNode>& nodes) const
+    {
+        if (GetNode(level, nodePos) == nullptr)
+            return;
+
+        bool split = level > 0;
+        if (split)
+        {
+            // Split while the children's level still reaches the node.
+            const int   size     = 1 << level;
+            const float dx       = AxisDistance(camera.X, nodePos.X * size, size);
+            const float dy       = AxisDistance(camera.Y, nodePos.Y * size, size);
+            const float dz       = AxisDistance(camera.Z, nodePos.Z * size, size);
+            const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+            split                = distance < static_cast<float>(ringRadius << (level - 1));
+        }
+        if (!split)
+        {
+            nodes.push_back({nodePos, level});
+            return;
+        }
+        for (int octant = 0; octant < 8; ++octant)
+            Select(level - 1, ChildOf(nodePos, octant), camera, ringRadius, nodes);
+    }
+
+    Int3 VoxelLodPyramid::TopNodes() const
+    {
+        const int size = CHUNK_SIZE << Levels();
+        return Int3((map_.SizeX() + size - 1) / size, (map_.SizeY() + size - 1) / size, (map_.SizeZ() + size - 1) / size);
+    }
+
+} // namespace Voxium::Core
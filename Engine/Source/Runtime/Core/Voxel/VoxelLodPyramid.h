@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Math/Vector3F.h"
+#include "Voxel/ChunkedVoxelMap.h"
+#include "Voxel/GreedyMesher.h"
+
+namespace Voxium::Core
+{
+    // How the eight cells under a coarser cell are reduced to one kind.
+    enum class LodFilter : uint8_t
+    {
+        // The most frequent kind, air included; ties go to non-air kinds, then to the upper cells.
+        Majority,
+
+        // Solid when at least half the cells are. The kind is the one most often seen from outside
+        // the cell: cells of the upper half and cells with air above them. Keeps grass on dirt hills
+        // and thin surface layers that the majority would bury or erode.
+        MostVisible,
+    };
+
+    // A node of the pyramid: level 0 is a map chunk, a level L node covers the 2^L x 2^L x 2^L
+    // chunks from NodePos << L, at 32^3 cells of 2^L voxels each.
+    struct LodNode
+    {
+        Int3 NodePos;
+        int  Level;
+    };
+
+    //--------------------------------------------------------------------------------
+    // VoxelLodPyramid: mip levels of a ChunkedVoxelMap for distant terrain. Every level
+    // halves the resolution and keeps 32^3 cells per node, so a node at any level is a
+    // VoxelChunk that GreedyMesher meshes at the cost of one full-resolution chunk; the
+    // mesh positions are in cells, scale them by 2^level and offset them by
+    // NodePos * 32 * 2^level. Level L is downsampled from level L - 1, and all-air nodes
+    // are not stored.
+    //
+    // SelectNodes() cuts the pyramid into clipmap rings around the camera: level 0 near
+    // it, then one level coarser each time the distance doubles, so every ring has about
+    // the same number of nodes and costs about the same to mesh and draw.
+    //
+    // The nodes are a copy: mark chunks edited, loaded or removed since with
+    // MarkChunkDirty() and call Update(). Everything belongs to the thread that edits the map.
+    //--------------------------------------------------------------------------------
+    class CORE_API VoxelLodPyramid
+    {
+    public:
+        static constexpr int MAX_LEVEL = 4;
+
+        // Throws std::invalid_argument unless 0 <= levels <= MAX_LEVEL.
+        VoxelLodPyramid(const ChunkedVoxelMap& map, int levels = MAX_LEVEL, LodFilter filter = LodFilter::MostVisible);
+
+        // Downsamples every level from the map again.
+        void Rebuild();
+
+        void MarkChunkDirty(const Int3& chunkPos);
+
+        // Marks every chunk the voxel box overlaps.
+        void MarkBoxDirty(const Int3& origin, const Int3& size);
+
+        // Brings the nodes above the chunks marked since the last call up to date, finest level
+        // first. Returns the nodes that changed, for remeshing; valid until the next call.
+        const std::vector<LodNode>& Update();
+
+        // Level 0 reads the map. nullptr means the node is all air. Throws std::out_of_range for
+        // levels below 0 or above Levels().
+        const VoxelChunk* GetNode(int level, const Int3& nodePos) const;
+
+        // The node and the 26 around it at the same level, for GreedyMesher. LOD meshes carry no light.
+        ChunkNeighbourhood Neighbourhood(int level, const Int3& nodePos) const;
+
+        // Replaces nodes with the non-empty nodes that cover the map around the camera, given in
+        // voxels. Level 0 reaches ringRadius chunks, and each level twice as far as the one below;
+        // beyond that the coarsest level covers the rest. Throws std::invalid_argument if ringRadius < 1.
+        void SelectNodes(const Vector3F& camera, int ringRadius, std::vector<LodNode>& nodes) const;
+
+        int Levels() const { return static_cast<int>(levels_.size()); }
+
+        LodFilter Filter() const { return filter_; }
+
+        // Stored nodes above level 0.
+        std::size_t NodeCount() const;
+
+        std::size_t MemoryUsage() const;
+
+    private:
+        // Reduces the given octants of a node again; returns whether any cell changed.
+        bool UpdateNode(int level, const Int3& nodePos, uint8_t octants);
+
+        bool ReduceOctant(VoxelChunk& node, int octant, const VoxelChunk* child);
+
+        BlockKind Reduce(const BlockKind (&cells)[8]) const;
+
+        void Select(int level, const Int3& nodePos, const Vector3F& camera, int ringRadius, std::vector<LodNode>& nodes) const;
+
+        // Node counts of the top level along each axis.
+        Int3 TopNodes() const;
+
+        const ChunkedVoxelMap&                                        map_;
+        LodFilter                                                     filter_;
+        std::vector<std::unordered_map<Int3, VoxelChunk, Int3Hasher>> levels_; // level L at L - 1
+        std::vector<std::unordered_set<Int3, Int3Hasher>>             dirty_;  // changed nodes of level L - 1 at L - 1
+        std::vector<LodNode>                                          updated_;
+        std::vector<BlockKind>                                        source_;
+    };
+
+} // namespace Voxium::Core
@@ -0,0 +1,512 @@
+#include "Voxel/VoxelRaycaster.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "System/CpuFeatures.h"
+
+#if defined(VOXIUM_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace Voxium::Core
+{
+    namespace
+    {
+        constexpr float INFINITE_DISTANCE = std::numeric_limits<float>::infinity();
+
+        // Rays are traced in groups of this many, one ray per AVX2 lane.
+        constexpr std::size_t GROUP_SIZE = 8;
+
+        // Shift between the brick coordinates packed by VoxelChunk::BrickIndex().
+        constexpr int BRICK_AXIS_SHIFT = CHUNK_SHIFT - VoxelChunk::BRICK_SHIFT;
+
+        int FloorToInt(float value) { return static_cast<int>(std::floor(value)); }
+
+#if defined(VOXIUM_AVX2)
+        // Lanes 0-3 or 4-7 of eight 32-bit lanes, sign-extended to 64 bits.
+        VOXIUM_AVX2_TARGET __m256i Widen(__m256i lanes, int half)
+        {
+            return _mm256_cvtepi32_epi64(half == 0 ? _mm256_castsi256_si128(lanes) : _mm256_extracti128_si256(lanes, 1));
+        }
+
+        // The low 32 bits of lanes 0-3 and 4-7 of 64-bit lanes, as eight 32-bit lanes.
+        VOXIUM_AVX2_TARGET __m256i Narrow(__m256i low, __m256i high)
+        {
+            const __m256 even = _mm256_shuffle_ps(_mm256_castsi256_ps(low), _mm256_castsi256_ps(high), _MM_SHUFFLE(2, 0, 2, 0));
+            return _mm256_permute4x64_epi64(_mm256_castps_si256(even), _MM_SHUFFLE(3, 1, 2, 0));
+        }
+
+        // Whether bit n[i] of words[i] is set, as 0 or -1, for eight lanes.
+        VOXIUM_AVX2_TARGET __m256i TestBits(const uint64_t* words, __m256i n)
+        {
+            __m256i bits[2];
+            for (int half = 0; half < 2; ++half)
+                bits[half] = _mm256_srlv_epi64(_mm256_load_si256(reinterpret_cast<const __m256i*>(words + 4 * half)), Widen(n, half));
+            const __m256i one = _mm256_set1_epi32(1);
+            return _mm256_cmpeq_epi32(_mm256_and_si256(Narrow(bits[0], bits[1]), one), one);
+        }
+#endif
+    } // namespace
+
+    VoxelRaycaster::VoxelRaycaster(const ChunkedVoxelMap& map) :
+        map_(map), size_ {map.SizeX(), map.SizeY(), map.SizeZ()}, gridX_((map.SizeX() + CHUNK_MASK) >> CHUNK_SHIFT),
+        gridY_((map.SizeY() + CHUNK_MASK) >> CHUNK_SHIFT), gridZ_((map.SizeZ() + CHUNK_MASK) >> CHUNK_SHIFT)
+    {
+        Rebuild();
+    }
+
+    void VoxelRaycaster::Rebuild()
+    {
+        grid_.assign(static_cast<std::size_t>(gridX_) * static_cast<std::size_t>(gridY_) * static_cast<std::size_t>(gridZ_), nullptr);
+        map_.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk& chunk) {
+            if (chunkPos.X >= 0 && chunkPos.Y >= 0 && chunkPos.Z >= 0 && chunkPos.X < gridX_ && chunkPos.Y < gridY_ && chunkPos.Z < gridZ_)
+                grid_[static_cast<std::size_t>(chunkPos.X + (chunkPos.Z + chunkPos.Y * gridZ_) * gridX_)] = &chunk;
+        });
+        gridVersion_ = map_.ChunkTableVersion();
+    }
+
+    VoxelRayHit VoxelRaycaster::Raycast(const Vector3F& origin, const Vector3F& direction, float maxDistance) const
+    {
+        Setup setup;
+        if (!Prepare(origin, direction, maxDistance, setup))
+            return VoxelRayHit {};
+        return Trace(setup);
+    }
+
+    bool VoxelRaycaster::LineOfSight(const Vector3F& from, const Vector3F& to) const
+    {
+        const Vector3F    delta = to - from;
+        const VoxelRayHit hit   = Raycast(from, delta, std::sqrt(Vector3F::DotProduct(delta, delta)));
+        return !hit.Hit || hit.Voxel == Int3(FloorToInt(to.X), FloorToInt(to.Y), FloorToInt(to.Z));
+    }
+
+    void VoxelRaycaster::RaycastBatch(std::span<const VoxelRay> rays, std::span<VoxelRayHit> hits) const
+    {
+        if (rays.size() != hits.size())
+            throw std::invalid_argument("RaycastBatch needs one hit per ray");
+
+#if defined(VOXIUM_AVX2)
+        const bool avx2 = CpuHasAvx2();
+#endif
+        for (std::size_t base = 0; base < rays.size(); base += GROUP_SIZE)
+        {
+            const std::size_t lanes = std::min(GROUP_SIZE, rays.size() - base);
+            Setup             setups[GROUP_SIZE];
+            bool              active[GROUP_SIZE] = {};
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+            {
+                const VoxelRay& ray = rays[base + lane];
+                active[lane]        = Prepare(ray.Origin, ray.Direction, ray.MaxDistance, setups[lane]);
+            }
+
+#if defined(VOXIUM_AVX2)
+            if (avx2)
+            {
+                VoxelRayHit group[GROUP_SIZE];
+                TraceGroup(setups, active, group);
+                std::copy_n(group, lanes, hits.begin() + static_cast<std::ptrdiff_t>(base));
+                continue;
+            }
+#endif
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                hits[base + lane] = active[lane] ? Trace(setups[lane]) : VoxelRayHit {};
+        }
+    }
+
+    void VoxelRaycaster::LineOfSightBatch(std::span<const Vector3F> from, std::span<const Vector3F> to, std::span<uint8_t> visible) const
+    {
+        if (from.size() != to.size() || from.size() != visible.size())
+            throw std::invalid_argument("LineOfSightBatch needs the same number of sources, targets and results");
+
+        constexpr std::size_t BLOCK = 64;
+        VoxelRay              rays[BLOCK];
+        VoxelRayHit           hits[BLOCK];
+        for (std::size_t base = 0; base < from.size(); base += BLOCK)
+        {
+            const std::size_t count = std::min(BLOCK, from.size() - base);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const Vector3F delta = to[base + i] - from[base + i];
+                rays[i]              = VoxelRay {from[base + i], delta, std::sqrt(Vector3F::DotProduct(delta, delta))};
+            }
+            RaycastBatch(std::span(rays, count), std::span(hits, count));
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const Vector3F& target = to[base + i];
+                visible[base + i]      = !hits[i].Hit || hits[i].Voxel == Int3(FloorToInt(target.X), FloorToInt(target.Y), FloorToInt(target.Z));
+            }
+        }
+    }
+
+    bool VoxelRaycaster::Prepare(const Vector3F& origin, const Vector3F& direction, float maxDistance, Setup& setup) const
+    {
+        const float length = std::sqrt(Vector3F::DotProduct(direction, direction));
+        if (!(length > 0.0f) || !(maxDistance >= 0.0f))
+            return false;
+
+        const float origins[3]    = {origin.X, origin.Y, origin.Z};
+        const float directions[3] = {direction.X / length, direction.Y / length, direction.Z / length};
+        setup.Enter               = 0.0f;
+        setup.Exit                = maxDistance;
+        setup.Axis                = -1;
+        for (int a = 0; a < 3; ++a)
+        {
+            setup.Origin[a]    = origins[a];
+            setup.Direction[a] = directions[a];
+            setup.Step[a]      = directions[a] < 0.0f ? -1 : 1;
+            if (directions[a] == 0.0f)
+            {
+                // Parallel to the slab: inside it for every t or for none.
+                setup.Inverse[a] = INFINITE_DISTANCE;
+                if (!(origins[a] >= 0.0f && origins[a] < static_cast<float>(size_[a])))
+                    return false;
+                continue;
+            }
+            setup.Inverse[a] = 1.0f / directions[a];
+            float near       = (0.0f - origins[a]) * setup.Inverse[a];
+            float far        = (static_cast<float>(size_[a]) - origins[a]) * setup.Inverse[a];
+            if (near > far)
+                std::swap(near, far);
+            if (near > setup.Enter)
+            {
+                setup.Enter = near;
+                setup.Axis  = a;
+            }
+            setup.Exit = std::min(setup.Exit, far);
+        }
+        if (!(setup.Enter <= setup.Exit))
+            return false;
+
+        for (int a = 0; a < 3; ++a)
+            setup.Cell[a] = std::clamp(FloorToInt(setup.Origin[a] + setup.Direction[a] * setup.Enter), 0, size_[a] - 1);
+        return true;
+    }
+
+    // Each step classifies the current voxel as lying in an empty chunk, in an empty brick of an
+    // occupied chunk, or in a mixed brick, and moves the ray to the far side of that 32^3, 8^3 or
+    // single-voxel box. The cell is recomputed from the exit distance: exactly along the axes
+    // whose boundary the ray crosses there, and by flooring, clamped to the box, along the others.
+    VoxelRayHit VoxelRaycaster::Trace(const Setup& setup) const
+    {
+        const bool current = IsCurrent();
+        ChunkView  view;
+        int        cell[3] = {setup.Cell[0], setup.Cell[1], setup.Cell[2]};
+        int        axis    = setup.Axis;
+        float      t       = setup.Enter;
+        for (;;)
+        {
+            Look(cell, current, view);
+            const int size = EmptySpan(view, cell);
+            if (size == 0)
+                return Finish(cell, axis, setup.Step, t);
+
+            int   low[3];
+            float next[3];
+            for (int a = 0; a < 3; ++a)
+            {
+                low[a]  = cell[a] & -size;
+                next[a] = (static_cast<float>(low[a] + (setup.Step[a] > 0 ? size : 0)) - setup.Origin[a]) * setup.Inverse[a];
+            }
+            const float exit = std::min(std::min(next[0], next[1]), next[2]);
+            if (exit > setup.Exit)
+                return VoxelRayHit {};
+
+            axis = next[0] == exit ? 0 : next[1] == exit ? 1 : 2;
+            for (int a = 0; a < 3; ++a)
+            {
+                if (next[a] == exit)
+                    cell[a] = setup.Step[a] > 0 ? low[a] + size : low[a] - 1;
+                else
+                    cell[a] = std::clamp(FloorToInt(setup.Origin[a] + setup.Direction[a] * exit), low[a], low[a] + size - 1);
+                if (cell[a] < 0 || cell[a] >= size_[a])
+                    return VoxelRayHit {};
+            }
+            t = exit;
+        }
+    }
+
+#if defined(VOXIUM_AVX2)
+    // Trace() with one ray per lane. Each lane keeps the fields of its ChunkView in SIMD-friendly
+    // arrays, refreshed only for lanes that entered another chunk, so every iteration classifies
+    // all live lanes at once, testing brick bits with 64-bit shifts and gathering the packed
+    // index word of lanes in mixed bricks, then advances them together. Lanes drop out as they
+    // hit or leave.
+    VOXIUM_AVX2_TARGET void VoxelRaycaster::TraceGroup(const Setup* setups, const bool* active, VoxelRayHit* hits) const
+    {
+        alignas(32) float   origin[3][GROUP_SIZE]    = {};
+        alignas(32) float   direction[3][GROUP_SIZE] = {};
+        alignas(32) float   inverse[3][GROUP_SIZE]   = {};
+        alignas(32) int32_t forward[3][GROUP_SIZE]   = {};
+        alignas(32) int32_t cells[3][GROUP_SIZE]     = {};
+        alignas(32) float   enter[GROUP_SIZE]        = {};
+        alignas(32) float   limit[GROUP_SIZE]        = {};
+        alignas(32) int32_t axes[GROUP_SIZE]         = {};
+        alignas(32) int32_t live[GROUP_SIZE]         = {};
+        for (std::size_t lane = 0; lane < GROUP_SIZE; ++lane)
+        {
+            if (!active[lane])
+                continue;
+            const Setup& setup = setups[lane];
+            for (int a = 0; a < 3; ++a)
+            {
+                origin[a][lane]    = setup.Origin[a];
+                direction[a][lane] = setup.Direction[a];
+                inverse[a][lane]   = setup.Inverse[a];
+                forward[a][lane]   = setup.Step[a] > 0 ? -1 : 0;
+                cells[a][lane]     = setup.Cell[a];
+            }
+            enter[lane] = setup.Enter;
+            limit[lane] = setup.Exit;
+            axes[lane]  = setup.Axis;
+            live[lane]  = -1;
+        }
+
+        __m256  o[3], d[3], inv[3];
+        __m256i step[3], cell[3], last[3];
+        for (int a = 0; a < 3; ++a)
+        {
+            o[a]    = _mm256_load_ps(origin[a]);
+            d[a]    = _mm256_load_ps(direction[a]);
+            inv[a]  = _mm256_load_ps(inverse[a]);
+            step[a] = _mm256_load_si256(reinterpret_cast<const __m256i*>(forward[a]));
+            cell[a] = _mm256_load_si256(reinterpret_cast<const __m256i*>(cells[a]));
+            last[a] = _mm256_set1_epi32(size_[a] - 1);
+        }
+        __m256       t      = _mm256_load_ps(enter);
+        const __m256 exitT  = _mm256_load_ps(limit);
+        __m256i      axis   = _mm256_load_si256(reinterpret_cast<const __m256i*>(axes));
+        __m256i      alive  = _mm256_load_si256(reinterpret_cast<const __m256i*>(live));
+        __m256i      struck = _mm256_setzero_si256();
+
+        // Per lane: the grid index of its chunk, whether the chunk is empty, its brick summaries,
+        // the address, width and mask of its packed indices, and which palette entries are air.
+        ChunkView            views[GROUP_SIZE];
+        alignas(32) int32_t  viewIndex[GROUP_SIZE];
+        alignas(32) int32_t  viewEmpty[GROUP_SIZE]    = {};
+        alignas(32) int32_t  viewBits[GROUP_SIZE]     = {};
+        alignas(32) int32_t  viewWide[GROUP_SIZE]     = {};
+        alignas(32) uint64_t viewOccupied[GROUP_SIZE] = {};
+        alignas(32) uint64_t viewFull[GROUP_SIZE]     = {};
+        alignas(32) uint64_t viewWords[GROUP_SIZE]    = {};
+        alignas(32) uint64_t viewMask[GROUP_SIZE]     = {};
+        alignas(32) uint64_t viewAir[GROUP_SIZE]      = {};
+        std::fill_n(viewIndex, GROUP_SIZE, -1);
+
+        const __m256i zero      = _mm256_setzero_si256();
+        const __m256i one       = _mm256_set1_epi32(1);
+        const __m256i chunkMask = _mm256_set1_epi32(CHUNK_MASK);
+        const __m256i chunkSize = _mm256_set1_epi32(CHUNK_SIZE);
+        const __m256i brickSize = _mm256_set1_epi32(VoxelChunk::BRICK_SIZE);
+        const __m256i gridX     = _mm256_set1_epi32(gridX_);
+        const __m256i gridZ     = _mm256_set1_epi32(gridZ_);
+        const bool    current   = IsCurrent();
+
+        while (_mm256_movemask_epi8(alive) != 0)
+        {
+            // Refresh the views of the lanes that entered another chunk.
+            const __m256i cx      = _mm256_srai_epi32(cell[0], CHUNK_SHIFT);
+            const __m256i cy      = _mm256_srai_epi32(cell[1], CHUNK_SHIFT);
+            const __m256i cz      = _mm256_srai_epi32(cell[2], CHUNK_SHIFT);
+            const __m256i index   = _mm256_add_epi32(cx, _mm256_mullo_epi32(_mm256_add_epi32(cz, _mm256_mullo_epi32(cy, gridZ)), gridX));
+            const __m256i entered = _mm256_andnot_si256(_mm256_cmpeq_epi32(index, _mm256_load_si256(reinterpret_cast<const __m256i*>(viewIndex))), alive);
+            int           refresh = _mm256_movemask_ps(_mm256_castsi256_ps(entered));
+            if (refresh != 0)
+            {
+                for (int a = 0; a < 3; ++a)
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(cells[a]), cell[a]);
+            }
+            for (; refresh != 0; refresh &= refresh - 1)
+            {
+                const int  lane      = std::countr_zero(static_cast<unsigned>(refresh));
+                const int  cellOf[3] = {cells[0][lane], cells[1][lane], cells[2][lane]};
+                ChunkView& view      = views[lane];
+                Look(cellOf, current, view);
+                viewIndex[lane]    = view.Index;
+                viewEmpty[lane]    = view.Occupied == 0 ? -1 : 0;
+                viewBits[lane]     = view.Bits;
+                viewWide[lane]     = view.Wide ? -1 : 0;
+                viewOccupied[lane] = view.Occupied;
+                viewFull[lane]     = view.Full;
+                viewWords[lane]    = reinterpret_cast<uint64_t>(view.Words);
+                viewMask[lane]     = view.Mask;
+                viewAir[lane]      = view.Air;
+            }
+
+            // Classify: empty chunk, empty brick, full brick, or a voxel of a mixed brick.
+            const __m256i lx       = _mm256_and_si256(cell[0], chunkMask);
+            const __m256i ly       = _mm256_and_si256(cell[1], chunkMask);
+            const __m256i lz       = _mm256_and_si256(cell[2], chunkMask);
+            const __m256i brick    = _mm256_or_si256(_mm256_srli_epi32(lx, VoxelChunk::BRICK_SHIFT),
+                                                     _mm256_or_si256(_mm256_slli_epi32(_mm256_srli_epi32(lz, VoxelChunk::BRICK_SHIFT), BRICK_AXIS_SHIFT),
+                                                                     _mm256_slli_epi32(_mm256_srli_epi32(ly, VoxelChunk::BRICK_SHIFT), 2 * BRICK_AXIS_SHIFT)));
+            const __m256i occupied = TestBits(viewOccupied, brick);
+            const __m256i full     = _mm256_and_si256(TestBits(viewFull, brick), occupied);
+            const __m256i mixed    = _mm256_and_si256(_mm256_andnot_si256(full, occupied), alive);
+            __m256i       solid    = _mm256_and_si256(full, alive);
+            if (_mm256_movemask_epi8(mixed) != 0)
+            {
+                // Gather the index word of each mixed lane, then look its palette index up in the air mask.
+                const __m256i position = _mm256_or_si256(lx, _mm256_or_si256(_mm256_slli_epi32(lz, CHUNK_SHIFT), _mm256_slli_epi32(ly, 2 * CHUNK_SHIFT)));
+                const __m256i bit      = _mm256_mullo_epi32(position, _mm256_load_si256(reinterpret_cast<const __m256i*>(viewBits)));
+                const __m256i offset   = _mm256_slli_epi32(_mm256_srli_epi32(bit, 6), 3);
+                const __m256i shift    = _mm256_and_si256(bit, _mm256_set1_epi32(63));
+                __m256i       air[2];
+                for (int half = 0; half < 2; ++half)
+                {
+                    const __m256i gather  = Widen(mixed, half);
+                    const __m256i address = _mm256_add_epi64(_mm256_load_si256(reinterpret_cast<const __m256i*>(viewWords + 4 * half)), Widen(offset, half));
+                    const __m256i word    = _mm256_mask_i64gather_epi64(_mm256_setzero_si256(), nullptr, address, gather, 1);
+                    const __m256i entry   = _mm256_and_si256(_mm256_srlv_epi64(word, Widen(shift, half)),
+                                                             _mm256_load_si256(reinterpret_cast<const __m256i*>(viewMask + 4 * half)));
+                    air[half]             = _mm256_srlv_epi64(_mm256_load_si256(reinterpret_cast<const __m256i*>(viewAir + 4 * half)), entry);
+                }
+                const __m256i isAir = _mm256_cmpeq_epi32(_mm256_and_si256(Narrow(air[0], air[1]), one), one);
+                solid               = _mm256_or_si256(solid, _mm256_andnot_si256(isAir, mixed));
+
+                // Palettes too long for the air mask are read one lane at a time.
+                const __m256i wide = _mm256_and_si256(mixed, _mm256_load_si256(reinterpret_cast<const __m256i*>(viewWide)));
+                if (int slow = _mm256_movemask_ps(_mm256_castsi256_ps(wide)); slow != 0)
+                {
+                    alignas(32) int32_t flags[GROUP_SIZE];
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(flags), solid);
+                    for (int a = 0; a < 3; ++a)
+                        _mm256_store_si256(reinterpret_cast<__m256i*>(cells[a]), cell[a]);
+                    for (; slow != 0; slow &= slow - 1)
+                    {
+                        const int lane      = std::countr_zero(static_cast<unsigned>(slow));
+                        const int cellOf[3] = {cells[0][lane], cells[1][lane], cells[2][lane]};
+                        flags[lane]         = EmptySpan(views[lane], cellOf) == 0 ? -1 : 0;
+                    }
+                    solid = _mm256_load_si256(reinterpret_cast<const __m256i*>(flags));
+                }
+            }
+
+            struck = _mm256_or_si256(struck, solid);
+            alive  = _mm256_andnot_si256(solid, alive);
+            if (_mm256_movemask_epi8(alive) == 0)
+                break;
+
+            // Advance every live lane to the far side of its box.
+            const __m256i emptyChunk = _mm256_load_si256(reinterpret_cast<const __m256i*>(viewEmpty));
+            const __m256i size       = _mm256_blendv_epi8(_mm256_blendv_epi8(brickSize, chunkSize, emptyChunk), one, occupied);
+            const __m256i mask       = _mm256_sub_epi32(zero, size);
+            __m256i       low[3];
+            __m256        next[3];
+            for (int a = 0; a < 3; ++a)
+            {
+                low[a]                 = _mm256_and_si256(cell[a], mask);
+                const __m256i boundary = _mm256_add_epi32(low[a], _mm256_and_si256(step[a], size));
+                next[a]                = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(boundary), o[a]), inv[a]);
+            }
+            const __m256 exit = _mm256_min_ps(_mm256_min_ps(next[0], next[1]), next[2]);
+            alive             = _mm256_andnot_si256(_mm256_castps_si256(_mm256_cmp_ps(exit, exitT, _CMP_GT_OQ)), alive);
+
+            __m256i moved[3];
+            __m256i crossed[3];
+            for (int a = 0; a < 3; ++a)
+            {
+                crossed[a]           = _mm256_castps_si256(_mm256_cmp_ps(next[a], exit, _CMP_EQ_OQ));
+                const __m256i exact  = _mm256_blendv_epi8(_mm256_sub_epi32(low[a], one), _mm256_add_epi32(low[a], size), step[a]);
+                const __m256i floor  = _mm256_cvttps_epi32(_mm256_floor_ps(_mm256_add_ps(o[a], _mm256_mul_ps(d[a], exit))));
+                const __m256i inside = _mm256_min_epi32(_mm256_max_epi32(floor, low[a]), _mm256_sub_epi32(_mm256_add_epi32(low[a], size), one));
+                moved[a]             = _mm256_blendv_epi8(inside, exact, crossed[a]);
+                const __m256i out    = _mm256_or_si256(_mm256_cmpgt_epi32(zero, moved[a]), _mm256_cmpgt_epi32(moved[a], last[a]));
+                alive                = _mm256_andnot_si256(out, alive);
+            }
+
+            const __m256i crossedAxis =
+                _mm256_blendv_epi8(_mm256_blendv_epi8(_mm256_set1_epi32(2), one, crossed[1]), zero, crossed[0]);
+            for (int a = 0; a < 3; ++a)
+                cell[a] = _mm256_blendv_epi8(cell[a], moved[a], alive);
+            axis = _mm256_blendv_epi8(axis, crossedAxis, alive);
+            t    = _mm256_blendv_ps(t, exit, _mm256_castsi256_ps(alive));
+        }
+
+        alignas(32) int32_t hit[GROUP_SIZE];
+        alignas(32) float   distance[GROUP_SIZE];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(hit), struck);
+        _mm256_store_ps(distance, t);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(axes), axis);
+        for (int a = 0; a < 3; ++a)
+            _mm256_store_si256(reinterpret_cast<__m256i*>(cells[a]), cell[a]);
+        for (std::size_t lane = 0; lane < GROUP_SIZE; ++lane)
+        {
+            if (!hit[lane])
+            {
+                hits[lane] = VoxelRayHit {};
+                continue;
+            }
+            const int cellOf[3] = {cells[0][lane], cells[1][lane], cells[2][lane]};
+            hits[lane]          = Finish(cellOf, axes[lane], setups[lane].Step, distance[lane]);
+        }
+    }
+#endif
+
+    void VoxelRaycaster::Look(const int* cell, bool current, ChunkView& view) const
+    {
+        const int cx    = cell[0] >> CHUNK_SHIFT;
+        const int cy    = cell[1] >> CHUNK_SHIFT;
+        const int cz    = cell[2] >> CHUNK_SHIFT;
+        const int index = cx + (cz + cy * gridZ_) * gridX_;
+        if (index == view.Index)
+            return;
+
+        const VoxelChunk* chunk = current ? grid_[static_cast<std::size_t>(index)] : map_.GetChunk(Int3(cx, cy, cz));
+        view                    = ChunkView {};
+        view.Index              = index;
+        if (chunk == nullptr)
+            return;
+        view.Occupied = chunk->OccupiedBricks();
+        view.Full     = chunk->FullBricks();
+        view.Words    = chunk->PackedIndices().data();
+        view.Palette  = chunk->Palette().data();
+        view.Bits     = chunk->BitsPerIndex();
+        view.Mask     = (uint64_t {1} << view.Bits) - 1;
+
+        const std::vector<BlockKind>& palette = chunk->Palette();
+        view.Wide                             = palette.size() > 64;
+        for (std::size_t i = 0; i < palette.size() && i < 64; ++i)
+            view.Air |= static_cast<uint64_t>(palette[i] == AIR_KIND) << i;
+    }
+
+    int VoxelRaycaster::EmptySpan(const ChunkView& view, const int* cell)
+    {
+        if (view.Occupied == 0)
+            return CHUNK_SIZE;
+
+        const int      lx    = cell[0] & CHUNK_MASK;
+        const int      ly    = cell[1] & CHUNK_MASK;
+        const int      lz    = cell[2] & CHUNK_MASK;
+        const uint64_t brick = uint64_t {1} << VoxelChunk::BrickIndex(lx, ly, lz);
+        if ((view.Occupied & brick) == 0)
+            return VoxelChunk::BRICK_SIZE;
+        if ((view.Full & brick) != 0)
+            return 0;
+
+        // A mixed brick is never in a uniform chunk, so the chunk has packed indices.
+        const int      bit   = ChunkIndex(lx, ly, lz) * view.Bits;
+        const uint64_t entry = view.Words[bit >> 6] >> (bit & 63) & view.Mask;
+        if (!view.Wide)
+            return static_cast<int>(view.Air >> entry & 1);
+        return view.Palette[entry] == AIR_KIND ? 1 : 0;
+    }
+
+    VoxelRayHit VoxelRaycaster::Finish(const int* cell, int axis, const int* step, float distance) const
+    {
+        VoxelRayHit result;
+        int         normal[3] = {0, 0, 0};
+        if (axis >= 0)
+            normal[axis] = -step[axis];
+        result.Hit      = true;
+        result.Voxel    = Int3(cell[0], cell[1], cell[2]);
+        result.Normal   = Int3(normal[0], normal[1], normal[2]);
+        result.Distance = distance;
+        result.Kind     = map_.GetBlock(cell[0], cell[1], cell[2]);
+        return result;
+    }
+
+} // namespace Voxium::Core
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "CoreMacros.h"
+
+#include "Math/Int3.h"
+#include "Math/Vector3F.h"
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Core
+{
+    struct VoxelRay
+    {
+        Vector3F Origin      = Vector3F(0.0f);
+        Vector3F Direction   = Vector3F(0.0f); // need not be normalised
+        float    MaxDistance = 0.0f;           // along the normalised direction
+    };
+
+    struct VoxelRayHit
+    {
+        bool      Hit      = false;
+        Int3      Voxel    = Int3(0, 0, 0);
+        Int3      Normal   = Int3(0, 0, 0); // face the ray entered through; zero when it starts inside the voxel
+        float     Distance = 0.0f;
+        BlockKind Kind     = AIR_KIND;
+    };
+
+    //--------------------------------------------------------------------------------
+    // VoxelRaycaster: Amanatides-Woo voxel traversal over a ChunkedVoxelMap that reads the
+    // chunks themselves. Rays cross empty chunks and the chunks' empty 8^3 bricks in one
+    // step each, stop in full bricks without decoding, and only walk single voxels inside
+    // mixed bricks. RaycastBatch() advances eight rays per AVX2 group on processors with
+    // AVX2 and gives the same hits as Raycast().
+    //
+    // Chunk pointers are kept in a dense grid over the map bounds, filled by Rebuild() and
+    // used while the map's ChunkTableVersion() is the one it was filled at; after chunks
+    // are created or removed rays look chunks up in the map's table until the next
+    // Rebuild(). Edits inside existing chunks are seen at once. Queries are const and may
+    // run on any number of threads, but not while the map changes or during a rebuild.
+    //--------------------------------------------------------------------------------
+    class CORE_API VoxelRaycaster
+    {
+    public:
+        explicit VoxelRaycaster(const ChunkedVoxelMap& map);
+
+        // Refills the chunk grid from the map's current chunk table.
+        void Rebuild();
+
+        // First non-air voxel within maxDistance, ignoring everything outside the map bounds.
+        VoxelRayHit Raycast(const Vector3F& origin, const Vector3F& direction, float maxDistance) const;
+
+        VoxelRayHit Raycast(const VoxelRay& ray) const { return Raycast(ray.Origin, ray.Direction, ray.MaxDistance); }
+
+        // True when no non-air voxel lies on the segment, the voxel containing to excluded.
+        bool LineOfSight(const Vector3F& from, const Vector3F& to) const;
+
+        // hits.size() must equal rays.size().
+        void RaycastBatch(std::span<const VoxelRay> rays, std::span<VoxelRayHit> hits) const;
+
+        // visible[i] = LineOfSight(from[i], to[i]); the spans must have equal sizes.
+        void LineOfSightBatch(std::span<const Vector3F> from, std::span<const Vector3F> to, std::span<uint8_t> visible) const;
+
+        // Whether the chunk grid matches the map's chunk table.
+        bool IsCurrent() const { return gridVersion_ == map_.ChunkTableVersion(); }
+
+        std::size_t MemoryUsage() const { return grid_.capacity() * sizeof(const VoxelChunk*); }
+
+    private:
+        // Per-ray setup shared by the scalar and batched traversals: the normalised ray
+        // clipped to the map bounds. Returns false when the ray misses the map.
+        struct Setup
+        {
+            float Origin[3];
+            float Direction[3];
+            float Inverse[3];
+            int   Step[3];
+            int   Cell[3];
+            int   Axis;
+            float Enter;
+            float Exit;
+        };
+
+        bool Prepare(const Vector3F& origin, const Vector3F& direction, float maxDistance, Setup& setup) const;
+
+        VoxelRayHit Trace(const Setup& setup) const;
+
+#if defined(VOXIUM_AVX2)
+        // Trace() for eight prepared rays at once; lanes whose active flag is false report a miss.
+        VOXIUM_AVX2_TARGET void TraceGroup(const Setup* setups, const bool* active, VoxelRayHit* hits) const;
+#endif
+
+        VoxelRayHit Finish(const int* cell, int axis, const int* step, float distance) const;
+
+        // The fields of the chunk a ray is in, read once on entering it: its brick summaries and,
+        // for mixed bricks, its packed palette indices.
+        struct ChunkView
+        {
+            int              Index    = -1; // grid index of the chunk
+            uint64_t         Occupied = 0;
+            uint64_t         Full     = 0;
+            const uint64_t*  Words    = nullptr;
+            const BlockKind* Palette  = nullptr;
+            int              Bits     = 0;
+            uint64_t         Mask     = 0;
+            uint64_t         Air      = 0;     // bit i set when palette entry i is air, for the first 64
+            bool             Wide     = false; // more than 64 palette entries
+        };
+
+        // Points the view at the chunk containing the voxel, found in the grid when it is current
+        // and in the map's table otherwise.
+        void Look(const int* cell, bool current, ChunkView& view) const;
+
+        // Side of the empty box around the voxel that a ray steps over: CHUNK_SIZE in an empty
+        // chunk, VoxelChunk::BRICK_SIZE in an empty brick, 1 for air in a mixed brick, and 0 when
+        // the voxel is not air.
+        static int EmptySpan(const ChunkView& view, const int* cell);
+
+        const ChunkedVoxelMap& map_;
+        int                    size_[3];
+        int                    gridX_;
+        int                    gridY_;
+        int                    gridZ_;
+
+        std::vector<const VoxelChunk*> grid_; // index = cx + (cz + cy * gridZ_) * gridX_
+        uint64_t                       gridVersion_ = 0;
+    };
+
+} // namespace Voxium::Core
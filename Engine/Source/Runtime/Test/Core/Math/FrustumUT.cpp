@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include "Core.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    // Camera at (0, 0, 10) looking down -Z with a 90 degree field of view, depth 1 to 100.
+    Frustum MakeFrustum()
+    {
+        const Matrix4F view       = Matrix4F::CreateLookAt(Vector3F(0.0f, 0.0f, 10.0f), Vector3F(0.0f, 0.0f, 0.0f), Vector3F(0.0f, 1.0f, 0.0f));
+        const Matrix4F projection = Matrix4F::CreatePerspectiveFieldOfView(VOXIUM_FLOAT_PI / 2.0f, 1.0f, 1.0f, 100.0f);
+        return Frustum(view * projection);
+    }
+} // namespace
+
+TEST(FrustumTest, PlanesFaceInwards)
+{
+    const Frustum frustum = MakeFrustum();
+    for (const Vector4F& plane : frustum.Planes)
+        EXPECT_NEAR(plane.X * plane.X + plane.Y * plane.Y + plane.Z * plane.Z, 1.0f, 1e-5f);
+
+    EXPECT_NEAR(frustum.Distance(Frustum::Near, Vector3F(0.0f, 0.0f, 0.0f)), 9.0f, 1e-3f);
+    EXPECT_NEAR(frustum.Distance(Frustum::Far, Vector3F(0.0f, 0.0f, 0.0f)), 90.0f, 1e-2f);
+    EXPECT_NEAR(frustum.Planes[Frustum::Left].X, std::sqrt(0.5f), 1e-5f);
+    EXPECT_NEAR(frustum.Planes[Frustum::Top].Y, -std::sqrt(0.5f), 1e-5f);
+}
+
+TEST(FrustumTest, ContainsAndIntersects)
+{
+    const Frustum frustum = MakeFrustum();
+    EXPECT_TRUE(frustum.Contains(Vector3F(0.0f, 0.0f, 0.0f)));
+    EXPECT_TRUE(frustum.Contains(Vector3F(8.0f, -8.0f, 0.5f)));
+    EXPECT_FALSE(frustum.Contains(Vector3F(0.0f, 0.0f, 9.5f)));
+    EXPECT_FALSE(frustum.Contains(Vector3F(0.0f, 0.0f, -95.0f)));
+    EXPECT_FALSE(frustum.Contains(Vector3F(11.0f, 0.0f, 0.0f)));
+    EXPECT_FALSE(frustum.Contains(Vector3F(0.0f, 0.0f, 20.0f)));
+
+    EXPECT_TRUE(frustum.Intersects(Vector3F(-1.0f), Vector3F(1.0f)));
+    EXPECT_TRUE(frustum.Intersects(Vector3F(10.5f, -1.0f, -1.0f), Vector3F(30.0f, 1.0f, 1.0f)));
+    EXPECT_FALSE(frustum.Intersects(Vector3F(11.5f, -1.0f, -1.0f), Vector3F(30.0f, 1.0f, 1.0f)));
+    EXPECT_FALSE(frustum.Intersects(Vector3F(-5.0f, -5.0f, 12.0f), Vector3F(5.0f, 5.0f, 20.0f)));
+    EXPECT_FALSE(frustum.Intersects(Vector3F(-5.0f, -5.0f, -200.0f), Vector3F(5.0f, 5.0f, -95.0f)));
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "Math/Morton.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    // Bit by bit reference interleave.
+    uint64_t Interleave(uint32_t x, uint32_t y, uint32_t z)
+    {
+        uint64_t code = 0;
+        for (int bit = 0; bit < MORTON_AXIS_BITS; ++bit)
+        {
+            code |= static_cast<uint64_t>(x >> bit & 1) << (3 * bit);
+            code |= static_cast<uint64_t>(y >> bit & 1) << (3 * bit + 1);
+            code |= static_cast<uint64_t>(z >> bit & 1) << (3 * bit + 2);
+        }
+        return code;
+    }
+} // namespace
+
+static_assert(MortonEncode(1, 0, 0) == 1 && MortonEncode(0, 1, 0) == 2 && MortonEncode(0, 0, 1) == 4);
+static_assert(MortonEncode(3, 3, 3) == 63);
+static_assert(MortonDecode(MortonEncode(Int3(123, 4567, 2097151))) == Int3(123, 4567, 2097151));
+
+TEST(MortonTest, MatchesBitInterleave)
+{
+    std::mt19937 random(19);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const uint32_t x = random() & MORTON_AXIS_MASK;
+        const uint32_t y = random() & MORTON_AXIS_MASK;
+        const uint32_t z = random() & MORTON_AXIS_MASK;
+        const uint64_t code = Interleave(x, y, z);
+        const Int3     position(static_cast<int>(x), static_cast<int>(y), static_cast<int>(z));
+
+        EXPECT_EQ(MortonEncode(position), code);
+        EXPECT_EQ(MortonEncodeFast(position), code);
+        EXPECT_EQ(MortonDecode(code), position);
+        EXPECT_EQ(MortonDecodeFast(code), position);
+    }
+
+    // Coordinates wrap at 2^21.
+    EXPECT_EQ(MortonEncode(-1, 0, 0), MORTON_X_MASK);
+    EXPECT_EQ(MortonEncodeFast(-1, 0, 0), MORTON_X_MASK);
+    EXPECT_EQ(MortonDecode(MortonEncode(-2, 5, 1 << MORTON_AXIS_BITS)), Int3(static_cast<int>(MORTON_AXIS_MASK) - 1, 5, 0));
+}
+
+TEST(MortonTest, AddStepsEachAxis)
+{
+    std::mt19937 random(91);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const Int3 a(static_cast<int>(random() & MORTON_AXIS_MASK), static_cast<int>(random() & MORTON_AXIS_MASK),
+                     static_cast<int>(random() & MORTON_AXIS_MASK));
+        const Int3 b(static_cast<int>(random() % 5) - 2, static_cast<int>(random() % 5) - 2, static_cast<int>(random() % 5) - 2);
+        const Int3 sum = a + b;
+        EXPECT_EQ(MortonAdd(MortonEncode(a), MortonEncode(b)), MortonEncode(sum));
+    }
+
+    EXPECT_EQ(MortonAdd(MortonEncode(7, 0, 3), MortonEncode(1, 0, -1)), MortonEncode(8, 0, 2));
+    EXPECT_EQ(MortonAdd(MortonEncode(0, 0, 0), MortonEncode(0, -1, 0)), MortonEncode(0, -1, 0));
+}
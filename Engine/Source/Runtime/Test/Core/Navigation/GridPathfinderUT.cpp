@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "Navigation/GridPathfinder.h"
+#include "Test/Core/Navigation/NavigationTestCommon.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr BlockKind STONE = 1;
+    constexpr int       SIZE  = 64;
+
+    // Rolling ground with walls, pillars, ledges and pits, so paths climb, drop and go around.
+    void BuildTerrain(ChunkedVoxelMap& map, uint32_t seed)
+    {
+        BuildObstacleCourse(map, RollingGround {8, 3.0, 5.0, 3.0, 6.0}, Obstacles {40, 20, 7, 12, 2, 3, 12}, STONE, seed);
+    }
+} // namespace
+
+TEST(GridPathfinderTest, JumpPointSearchFindsTheCheapestPaths)
+{
+    for (uint32_t seed : {1u, 2u, 3u})
+    {
+        ChunkedVoxelMap map(15, SIZE, SIZE, SIZE);
+        BuildTerrain(map, seed);
+        WalkableSurface surface(map);
+        surface.Rebuild();
+        NavigationGrid grid;
+        grid.Build(surface, Int3(0, 0, 0), Int3(SIZE - 1, SIZE - 1, SIZE - 1));
+
+        const std::vector<Int3> cells = WalkableCells(grid);
+        ASSERT_GT(cells.size(), static_cast<std::size_t>(SIZE * SIZE / 2));
+
+        std::mt19937                       random(seed);
+        std::uniform_int_distribution<int> pick(0, static_cast<int>(cells.size()) - 1);
+        GridPathfinder                     pathfinder;
+        uint64_t                           aStarExpanded = 0;
+        uint64_t                           jumpExpanded  = 0;
+        int                                found         = 0;
+        for (int query = 0; query < 40; ++query)
+        {
+            const Int3 start = cells[pick(random)];
+            const Int3 goal  = cells[pick(random)];
+            GridPath   aStar;
+            GridPath   jump;
+            const bool reached = pathfinder.FindPath(grid, start, goal, GridSearch::AStar, aStar);
+            ASSERT_EQ(pathfinder.FindPath(grid, start, goal, GridSearch::JumpPoint, jump), reached);
+            if (!reached)
+                continue;
+            ++found;
+            EXPECT_NEAR(jump.Cost, aStar.Cost, 1e-3f);
+            EXPECT_EQ(jump.Cells.front(), start);
+            EXPECT_EQ(jump.Cells.back(), goal);
+            ExpectValidPath(grid, aStar, 1e-3f);
+            ExpectValidPath(grid, jump, 1e-3f);
+            aStarExpanded += aStar.Expanded;
+            jumpExpanded += jump.Expanded;
+        }
+        EXPECT_GT(found, 20);
+        EXPECT_LT(jumpExpanded, aStarExpanded);
+    }
+}
+
+TEST(GridPathfinderTest, CostsMatchPathsBothWays)
+{
+    ChunkedVoxelMap map(15, SIZE, SIZE, SIZE);
+    BuildTerrain(map, 9);
+    WalkableSurface surface(map);
+    surface.Rebuild();
+    NavigationGrid grid;
+    grid.Build(surface, Int3(0, 0, 0), Int3(SIZE - 1, SIZE - 1, SIZE - 1));
+
+    const std::vector<Int3> cells = WalkableCells(grid);
+    std::vector<Int3>       targets;
+    for (std::size_t i = 0; i < cells.size(); i += cells.size() / 16)
+        targets.push_back(cells[i]);
+    const Int3 source = cells[cells.size() / 2];
+
+    GridPathfinder     pathfinder;
+    std::vector<float> from(targets.size());
+    std::vector<float> to(targets.size());
+    pathfinder.Costs(grid, source, false, targets, from);
+    pathfinder.Costs(grid, source, true, targets, to);
+    int unreachable = 0;
+    for (std::size_t i = 0; i < targets.size(); ++i)
+    {
+        // Summed in another order, so only close.
+        GridPath path;
+        if (pathfinder.FindPath(grid, source, targets[i], GridSearch::AStar, path))
+        {
+            EXPECT_NEAR(path.Cost, from[i], 1e-3f);
+        }
+        else
+        {
+            EXPECT_EQ(from[i], GridPathfinder::NO_PATH);
+        }
+        if (pathfinder.FindPath(grid, targets[i], source, GridSearch::AStar, path))
+        {
+            EXPECT_NEAR(path.Cost, to[i], 1e-3f);
+        }
+        else
+        {
+            EXPECT_EQ(to[i], GridPathfinder::NO_PATH);
+        }
+        unreachable += to[i] == GridPathfinder::NO_PATH;
+    }
+    EXPECT_LT(unreachable, static_cast<int>(targets.size()));
+}
+
+TEST(GridPathfinderTest, ClimbsOneVoxelAndDropsAFew)
+{
+    // A staircase of single steps up, then a wall too high to climb and a cliff too deep to drop.
+    ChunkedVoxelMap map(15, 32, 32, 8);
+    map.FillBlocks(Int3(0, 0, 0), Int3(32, 10, 8), STONE);
+    for (int step = 0; step < 4; ++step)
+        map.FillBlocks(Int3(4 + step, 10, 0), Int3(1, step + 1, 8), STONE);
+    map.FillBlocks(Int3(8, 10, 0), Int3(4, 4, 8), STONE);
+    map.FillBlocks(Int3(12, 1, 0), Int3(8, 13, 8), AIR_KIND);
+
+    WalkableSurface surface(map);
+    surface.Rebuild();
+    NavigationGrid grid;
+    grid.Build(surface, Int3(0, 0, 0), Int3(31, 31, 7));
+    GridPathfinder pathfinder;
+    GridPath       path;
+
+    EXPECT_TRUE(pathfinder.FindPath(grid, Int3(0, 10, 3), Int3(10, 14, 3), GridSearch::JumpPoint, path));
+    EXPECT_NEAR(path.Cost, 10.0f + 4 * surface.Settings().ClimbCost, 1e-3f);
+
+    // Down the staircase again, but never off the ledge into the 13-voxel pit.
+    EXPECT_TRUE(pathfinder.FindPath(grid, Int3(10, 14, 3), Int3(0, 10, 3), GridSearch::JumpPoint, path));
+    EXPECT_NEAR(path.Cost, 10.0f + 4 * surface.Settings().DropCost, 1e-3f);
+    EXPECT_FALSE(pathfinder.FindPath(grid, Int3(10, 14, 3), Int3(15, 1, 3), GridSearch::JumpPoint, path));
+    EXPECT_FALSE(pathfinder.FindPath(grid, Int3(0, 10, 3), Int3(10, 14, 3), GridSearch::AStar, path, 3));
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Navigation/NavigationGraph.h"
+#include "Test/Core/Navigation/NavigationTestCommon.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr BlockKind STONE = 1;
+    constexpr int       SIZE  = 96;
+
+    // Rolling ground over three by three chunks with walls, pillars and pits, so paths cross
+    // chunk borders on several levels and go around.
+    void BuildTerrain(ChunkedVoxelMap& map, uint32_t seed)
+    {
+        BuildObstacleCourse(map, RollingGround {30, 4.0, 8.0, 4.0, 9.0}, Obstacles {60, 44, 11, 16, 20, 4, 24}, STONE, seed);
+    }
+} // namespace
+
+TEST(NavigationGraphTest, FindsPathsCloseToTheCheapest)
+{
+    ChunkedVoxelMap map(15, SIZE, 64, SIZE);
+    BuildTerrain(map, 1);
+    NavigationGraph graph(map);
+    graph.Rebuild();
+    EXPECT_GT(graph.ClusterCount(), 8u);
+
+    NavigationGrid grid;
+    grid.Build(graph.Surface(), Int3(0, 0, 0), Int3(SIZE - 1, 63, SIZE - 1));
+    const std::vector<Int3> cells = WalkableCells(graph.Surface());
+    ASSERT_GT(cells.size(), static_cast<std::size_t>(SIZE * SIZE / 2));
+
+    std::mt19937                       random(7);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(cells.size()) - 1);
+    GridPathfinder                     pathfinder;
+    int                                reached = 0;
+    int                                agreed  = 0;
+    double                             cost    = 0.0;
+    double                             optimal = 0.0;
+    for (int query = 0; query < 60; ++query)
+    {
+        const Int3     start = cells[pick(random)];
+        const Int3     goal  = cells[pick(random)];
+        GridPath       cheapest;
+        NavigationPath path;
+        const bool     exists = pathfinder.FindPath(grid, start, goal, GridSearch::AStar, cheapest);
+        const bool     found  = graph.FindPath(start, goal, path);
+        agreed += exists == found;
+        if (!found)
+            continue;
+        ASSERT_TRUE(exists);
+        ++reached;
+        EXPECT_EQ(path.Cells.front(), start);
+        EXPECT_EQ(path.Cells.back(), goal);
+        ExpectValidPath(grid, path, 1e-2f);
+        EXPECT_GE(path.Cost, cheapest.Cost - 1e-2f);
+        cost += path.Cost;
+        optimal += cheapest.Cost;
+    }
+    EXPECT_GT(reached, 30);
+    EXPECT_GE(agreed, 57);
+    EXPECT_LT(cost, optimal * 1.15);
+}
+
+TEST(NavigationGraphTest, UpdateMatchesRebuild)
+{
+    ChunkedVoxelMap map(15, SIZE, 64, SIZE);
+    BuildTerrain(map, 2);
+    NavigationGraph graph(map);
+    graph.Rebuild();
+
+    // Walls, holes and bridges across chunk borders.
+    std::mt19937                       random(3);
+    std::uniform_int_distribution<int> coordinate(0, SIZE - 1);
+    std::uniform_int_distribution<int> height(24, 40);
+    for (int i = 0; i < 200; ++i)
+    {
+        const int x = coordinate(random);
+        const int y = height(random);
+        const int z = coordinate(random);
+        map.SetBlock(x, y, z, i % 3 == 0 ? AIR_KIND : STONE);
+        graph.OnBlockChanged(x, y, z);
+    }
+    EXPECT_GT(graph.PendingCount(), 0u);
+    graph.Update();
+    EXPECT_EQ(graph.PendingCount(), 0u);
+
+    NavigationGraph rebuilt(map);
+    rebuilt.Rebuild();
+    EXPECT_EQ(graph.ClusterCount(), rebuilt.ClusterCount());
+    EXPECT_EQ(graph.EntranceCount(), rebuilt.EntranceCount());
+
+    const std::vector<Int3>            cells = WalkableCells(rebuilt.Surface());
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(cells.size()) - 1);
+    for (int query = 0; query < 40; ++query)
+    {
+        const Int3     start = cells[pick(random)];
+        const Int3     goal  = cells[pick(random)];
+        NavigationPath updated;
+        NavigationPath fresh;
+        ASSERT_EQ(graph.FindPath(start, goal, updated), rebuilt.FindPath(start, goal, fresh));
+        EXPECT_EQ(updated.Cost, fresh.Cost);
+    }
+}
+
+TEST(NavigationGraphTest, WallsCloseAndOpenTheWay)
+{
+    // Flat ground split by a wall through the middle chunk, with a single gap.
+    ChunkedVoxelMap map(15, SIZE, 32, 32);
+    map.FillBlocks(Int3(0, 0, 0), Int3(SIZE, 8, 32), STONE);
+    map.FillBlocks(Int3(48, 8, 0), Int3(1, 4, 32), STONE);
+    map.FillBlocks(Int3(48, 8, 20), Int3(1, 4, 1), AIR_KIND);
+
+    NavigationGraph graph(map);
+    graph.Rebuild();
+    const Int3     start(2, 8, 2);
+    const Int3     goal(93, 8, 2);
+    NavigationPath path;
+    ASSERT_TRUE(graph.FindPath(start, goal, path));
+    EXPECT_NE(std::find(path.Cells.begin(), path.Cells.end(), Int3(48, 8, 20)), path.Cells.end());
+
+    for (int y = 8; y < 12; ++y)
+    {
+        map.SetBlock(48, y, 20, STONE);
+        graph.OnBlockChanged(48, y, 20);
+    }
+    graph.Update();
+    EXPECT_FALSE(graph.FindPath(start, goal, path));
+
+    // Open again elsewhere; a one-voxel step is enough to climb over.
+    for (int y = 9; y < 12; ++y)
+    {
+        map.SetBlock(48, y, 5, AIR_KIND);
+        graph.OnBlockChanged(48, y, 5);
+    }
+    graph.Update();
+    ASSERT_TRUE(graph.FindPath(start, goal, path));
+    EXPECT_NE(std::find(path.Cells.begin(), path.Cells.end(), Int3(48, 9, 5)), path.Cells.end());
+    EXPECT_FALSE(graph.FindPath(start, goal, path, 2));
+
+    // The bottom of the map is a floor, also under chunks that were emptied.
+    map.FillBlocks(Int3(0, 0, 0), Int3(32, 12, 32), AIR_KIND);
+    graph.OnChunkChanged(Int3(0, 0, 0));
+    graph.Update();
+    EXPECT_TRUE(graph.FindPath(Int3(2, 0, 2), Int3(30, 0, 30), path));
+    NavigationGraph rebuilt(map);
+    rebuilt.Rebuild();
+    EXPECT_EQ(graph.ClusterCount(), rebuilt.ClusterCount());
+    EXPECT_TRUE(rebuilt.FindPath(Int3(2, 0, 2), Int3(30, 0, 30), path));
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Navigation/NavigationGrid.h"
+#include "Test/TestTerrain.h"
+
+namespace Voxium::Test
+{
+    // Walls along x and ledges along z standing on the ground, and pits dug into it, so paths
+    // climb, drop and go around.
+    struct Obstacles
+    {
+        int Walls     = 0; // every other one a ledge, a few voxels lower than Height
+        int Height    = 0;
+        int Length    = 1;
+        int Pits      = 0;
+        int PitBottom = 0;
+        int PitSide   = 1;
+        int PitDepth  = 1;
+    };
+
+    // Fills the ground with kind and places the obstacles at random over the map.
+    inline void BuildObstacleCourse(Core::ChunkedVoxelMap& map, const RollingGround& ground, const Obstacles& obstacles, Core::BlockKind kind,
+                                    uint32_t seed)
+    {
+        ground.Fill(map, kind);
+        std::mt19937                       random(seed);
+        std::uniform_int_distribution<int> coordinateX(0, map.SizeX() - 1);
+        std::uniform_int_distribution<int> coordinateZ(0, map.SizeZ() - 1);
+        for (int i = 0; i < obstacles.Walls; ++i)
+        {
+            const int x = coordinateX(random);
+            const int z = coordinateZ(random);
+            if (i % 2 == 0)
+                map.FillBlocks(Core::Int3(x, 0, z), Core::Int3(1 + i % obstacles.Length, obstacles.Height, 1), kind);
+            else
+                map.FillBlocks(Core::Int3(x, 0, z), Core::Int3(1, obstacles.Height - 8 + i % 3, 1 + i % (obstacles.Length + 2)), kind);
+        }
+        for (int i = 0; i < obstacles.Pits; ++i)
+        {
+            const int x = coordinateX(random);
+            const int z = coordinateZ(random);
+            map.FillBlocks(Core::Int3(x, obstacles.PitBottom, z), Core::Int3(obstacles.PitSide, obstacles.PitDepth, obstacles.PitSide), Core::AIR_KIND);
+        }
+    }
+
+    // The walkable cells of the grid's box, in cell index order.
+    inline std::vector<Core::Int3> WalkableCells(const Core::NavigationGrid& grid)
+    {
+        std::vector<Core::Int3> cells;
+        for (int index = 0; index < grid.CellCount(); ++index)
+            if (grid.IsWalkable(grid.CellAt(index)))
+                cells.push_back(grid.CellAt(index));
+        return cells;
+    }
+
+    // The walkable cells of the whole map, layer by layer.
+    inline std::vector<Core::Int3> WalkableCells(const Core::WalkableSurface& surface)
+    {
+        std::vector<Core::Int3>      cells;
+        const Core::ChunkedVoxelMap& map = surface.Map();
+        for (int y = 0; y < map.SizeY(); ++y)
+            for (int z = 0; z < map.SizeZ(); ++z)
+                for (int x = 0; x < map.SizeX(); ++x)
+                    if (surface.IsWalkable(Core::Int3(x, y, z)))
+                        cells.push_back(Core::Int3(x, y, z));
+        return cells;
+    }
+
+    // Every step of the path, a GridPath or a NavigationPath, is a move of the grid, and they add
+    // up to its cost.
+    template<typename Path>
+    void ExpectValidPath(const Core::NavigationGrid& grid, const Path& path, float tolerance)
+    {
+        float                       cost = 0.0f;
+        Core::NavigationGrid::Moves moves;
+        for (std::size_t i = 1; i < path.Cells.size(); ++i)
+        {
+            const auto end  = moves.begin() + static_cast<std::ptrdiff_t>(grid.MovesFrom(path.Cells[i - 1], moves));
+            const auto move = std::find_if(moves.begin(), end, [&](const Core::NavigationMove& m) { return m.Cell == path.Cells[i]; });
+            ASSERT_NE(move, end) << "step " << i;
+            cost += move->Cost;
+        }
+        EXPECT_NEAR(cost, path.Cost, tolerance);
+    }
+} // namespace Voxium::Test
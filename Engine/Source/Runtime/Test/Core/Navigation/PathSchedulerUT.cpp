@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "Navigation/PathScheduler.h"
+#include "Test/TestTerrain.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr BlockKind STONE = 1;
+    constexpr int       SIZE  = 64;
+
+    // Rolling ground split by a wall with a gap at its far end.
+    void BuildTerrain(ChunkedVoxelMap& map)
+    {
+        RollingGround {12, 3.0, 5.0, 3.0, 7.0}.Fill(map, STONE);
+        map.FillBlocks(Int3(20, 0, 0), Int3(1, 24, 50), STONE);
+    }
+
+    // The walkable cell on top of every column.
+    std::vector<Int3> GroundCells(const ChunkedVoxelMap& map)
+    {
+        std::vector<Int3> cells;
+        for (int z = 0; z < SIZE; ++z)
+            for (int x = 0; x < SIZE; ++x)
+            {
+                int y = map.SizeY() - 1;
+                while (y > 0 && map.GetBlock(x, y - 1, z) == AIR_KIND)
+                    --y;
+                cells.push_back(Int3(x, y, z));
+            }
+        return cells;
+    }
+} // namespace
+
+TEST(PathSchedulerTest, AnswersLikeTheGraphWithinTheBudget)
+{
+    ChunkedVoxelMap map(15, SIZE, 32, SIZE);
+    BuildTerrain(map);
+    NavigationGraph graph(map);
+    graph.Rebuild();
+    ThreadPool    pool(3);
+    PathScheduler scheduler(graph, pool, PathSchedulerSettings {2000, 50000});
+
+    const std::vector<Int3>            cells = GroundCells(map);
+    std::mt19937                       random(5);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(cells.size()) - 1);
+    std::vector<std::pair<Int3, Int3>> queries;
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        queries.emplace_back(cells[pick(random)], cells[pick(random)]);
+        EXPECT_EQ(scheduler.Request(queries.back().first, queries.back().second), i + 1);
+    }
+
+    // Every tick answers the oldest queries and overshoots its budget by at most a query per lane.
+    std::vector<PathResult> results;
+    int                     ticks = 0;
+    while (scheduler.PendingCount() > 0 && ticks < 1000)
+    {
+        const std::size_t pending = scheduler.PendingCount();
+        scheduler.Tick();
+        ++ticks;
+        EXPECT_EQ(scheduler.PendingCount() + scheduler.Completed().size(), pending);
+        EXPECT_FALSE(scheduler.Completed().empty());
+        EXPECT_LT(scheduler.LastExpanded(), 2000u + 4 * 50000u);
+        results.insert(results.end(), scheduler.Completed().begin(), scheduler.Completed().end());
+    }
+    EXPECT_GT(ticks, 1);
+    ASSERT_EQ(results.size(), queries.size());
+
+    int found = 0;
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        ASSERT_EQ(results[i].Id, i + 1);
+        NavigationPath path;
+        ASSERT_EQ(results[i].Found, graph.FindPath(queries[i].first, queries[i].second, path, 50000));
+        EXPECT_EQ(results[i].Path.Cost, path.Cost);
+        EXPECT_EQ(results[i].Path.Cells, path.Cells);
+        found += results[i].Found;
+    }
+    EXPECT_GT(found, 50);
+}
+
+TEST(PathSchedulerTest, UpdatesTheGraphBeforeSearching)
+{
+    ChunkedVoxelMap map(15, SIZE, 32, SIZE);
+    BuildTerrain(map);
+    NavigationGraph graph(map);
+    graph.Rebuild();
+    ThreadPool    pool(2);
+    PathScheduler scheduler(graph, pool);
+
+    const std::vector<Int3> cells = GroundCells(map);
+    const Int3              start = cells[5 * SIZE + 5];
+    const Int3              goal  = cells[5 * SIZE + 40];
+    scheduler.Request(start, goal);
+    scheduler.Tick();
+    ASSERT_EQ(scheduler.Completed().size(), 1u);
+    EXPECT_TRUE(scheduler.Completed()[0].Found);
+
+    // Wall off the gap beside the wall, and ask again.
+    map.FillBlocks(Int3(20, 0, 50), Int3(1, 24, SIZE - 50), STONE);
+    graph.OnChunkChanged(Int3(0, 0, 1));
+    scheduler.Request(start, goal);
+    scheduler.Tick();
+    EXPECT_EQ(graph.PendingCount(), 0u);
+    ASSERT_EQ(scheduler.Completed().size(), 1u);
+    EXPECT_FALSE(scheduler.Completed()[0].Found);
+
+    EXPECT_THROW(PathScheduler(graph, pool, PathSchedulerSettings {0, 100}), std::invalid_argument);
+}
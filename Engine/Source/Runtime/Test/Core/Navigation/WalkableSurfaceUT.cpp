@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <random>
+#include <stdexcept>
+
+#include "Navigation/WalkableSurface.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    constexpr BlockKind STONE = 1;
+    constexpr BlockKind GRASS = 2;
+
+    // Scattered voxels, dense enough for floors, ceilings and gaps of every height around chunk borders.
+    void Scatter(ChunkedVoxelMap& map, uint32_t seed)
+    {
+        std::mt19937                       random(seed);
+        std::uniform_int_distribution<int> coordinate(0, 63);
+        std::uniform_int_distribution<int> height(0, map.SizeY() - 1);
+        std::uniform_int_distribution<int> kind(0, 2);
+        for (int i = 0; i < 60000; ++i)
+        {
+            const int x = coordinate(random);
+            const int y = height(random);
+            const int z = coordinate(random);
+            map.SetBlock(x, y, z, static_cast<BlockKind>(kind(random)));
+        }
+    }
+
+    // Walkable cells of a chunk by IsWalkable, one cell at a time.
+    int CountWalkable(const WalkableSurface& surface, const Int3& chunkPos, WalkableSurface::ColumnMasks& walkable)
+    {
+        int count = 0;
+        for (int column = 0; column < CHUNK_AREA; ++column)
+        {
+            walkable[column] = 0;
+            for (int y = 0; y < CHUNK_SIZE; ++y)
+            {
+                const Int3 cell((chunkPos.X << CHUNK_SHIFT) + (column & CHUNK_MASK), (chunkPos.Y << CHUNK_SHIFT) + y,
+                                (chunkPos.Z << CHUNK_SHIFT) + (column >> CHUNK_SHIFT));
+                if (surface.IsWalkable(cell))
+                {
+                    walkable[column] |= 1u << y;
+                    ++count;
+                }
+            }
+        }
+        return count;
+    }
+} // namespace
+
+TEST(WalkableSurfaceTest, ExtractWalkableMatchesIsWalkable)
+{
+    // Taller than a whole number of chunks, so the top layer is cut off.
+    ChunkedVoxelMap map(15, 64, 48, 64);
+    Scatter(map, 1);
+    for (const int height : {1, 2, 5})
+    {
+        NavigationSettings settings;
+        settings.AgentHeight = height;
+        WalkableSurface surface(map, settings);
+        surface.Rebuild();
+        int total = 0;
+        for (int cy = 0; cy < 2; ++cy)
+            for (int cz = 0; cz < 2; ++cz)
+                for (int cx = 0; cx < 2; ++cx)
+                {
+                    WalkableSurface::ColumnMasks expected;
+                    WalkableSurface::ColumnMasks walkable;
+                    const int                    count = CountWalkable(surface, Int3(cx, cy, cz), expected);
+                    ASSERT_EQ(surface.ExtractWalkable(Int3(cx, cy, cz), walkable), count);
+                    EXPECT_EQ(walkable, expected);
+                    total += count;
+                }
+        EXPECT_GT(total, 1000);
+    }
+    EXPECT_THROW(WalkableSurface(map, NavigationSettings {9, 3, 0.5f, 0.25f}), std::invalid_argument);
+    EXPECT_THROW(WalkableSurface(map, NavigationSettings {2, 3, -1.0f, 0.25f}), std::invalid_argument);
+}
+
+TEST(WalkableSurfaceTest, EditsMatchRebuild)
+{
+    ChunkedVoxelMap map(15, 64, 64, 64);
+    Scatter(map, 2);
+    WalkableSurface surface(map);
+    surface.Rebuild();
+
+    std::mt19937                       random(3);
+    std::uniform_int_distribution<int> coordinate(0, 63);
+    for (int i = 0; i < 2000; ++i)
+    {
+        const int x = coordinate(random);
+        const int y = coordinate(random);
+        const int z = coordinate(random);
+        map.SetBlock(x, y, z, i % 2 == 0 ? AIR_KIND : STONE);
+        surface.OnBlockChanged(x, y, z);
+    }
+    map.FillBlocks(Int3(32, 32, 0), Int3(32, 32, 32), AIR_KIND);
+    surface.OnChunkChanged(Int3(1, 1, 0));
+
+    WalkableSurface rebuilt(map);
+    rebuilt.Rebuild();
+    EXPECT_EQ(surface.ChunkCount(), rebuilt.ChunkCount());
+    EXPECT_EQ(surface.Masks(Int3(1, 1, 0)), nullptr);
+    for (int cy = 0; cy < 2; ++cy)
+        for (int cz = 0; cz < 2; ++cz)
+            for (int cx = 0; cx < 2; ++cx)
+            {
+                const WalkableSurface::ColumnMasks* edited = surface.Masks(Int3(cx, cy, cz));
+                const WalkableSurface::ColumnMasks* fresh  = rebuilt.Masks(Int3(cx, cy, cz));
+                ASSERT_EQ(edited == nullptr, fresh == nullptr);
+                if (edited != nullptr)
+                {
+                    EXPECT_EQ(*edited, *fresh);
+                }
+            }
+    EXPECT_THROW(surface.OnBlockChanged(64, 0, 0), std::out_of_range);
+}
+
+TEST(WalkableSurfaceTest, KindsThatDoNotBlock)
+{
+    // Grass on stone: agents stand on the stone, in the grass.
+    ChunkedVoxelMap map(15, 32, 32, 32);
+    map.FillBlocks(Int3(0, 0, 0), Int3(32, 4, 32), STONE);
+    map.FillBlocks(Int3(0, 4, 0), Int3(32, 1, 32), GRASS);
+    WalkableSurface surface(map);
+    surface.Rebuild();
+    EXPECT_TRUE(surface.IsWalkable(Int3(3, 5, 3)));
+    EXPECT_FALSE(surface.IsWalkable(Int3(3, 4, 3)));
+
+    surface.SetKindBlocking(GRASS, false);
+    surface.Rebuild();
+    EXPECT_FALSE(surface.IsBlocking(GRASS));
+    EXPECT_TRUE(surface.IsWalkable(Int3(3, 4, 3)));
+    EXPECT_FALSE(surface.IsWalkable(Int3(3, 5, 3)));
+
+    // The bottom of the map is a floor; beside it nothing is walkable.
+    map.FillBlocks(Int3(0, 0, 0), Int3(32, 5, 32), AIR_KIND);
+    surface.OnChunkChanged(Int3(0, 0, 0));
+    EXPECT_TRUE(surface.IsWalkable(Int3(3, 0, 3)));
+    EXPECT_FALSE(surface.IsWalkable(Int3(-1, 0, 3)));
+    WalkableSurface::ColumnMasks walkable;
+    EXPECT_EQ(surface.ExtractWalkable(Int3(0, 0, 0), walkable), CHUNK_AREA);
+
+    EXPECT_THROW(surface.SetKindBlocking(AIR_KIND, true), std::invalid_argument);
+    EXPECT_THROW(surface.SetKindBlocking(16, true), std::out_of_range);
+}
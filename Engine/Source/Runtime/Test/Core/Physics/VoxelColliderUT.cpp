@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Physics/VoxelCollider.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    constexpr BlockKind STONE  = 1;
+    constexpr BlockKind LEAVES = 2;
+
+    // A 64^3 map with ground up to y = 4.
+    void BuildFloor(ChunkedVoxelMap& map) { map.FillBlocks(Int3(0, 0, 0), Int3(64, 4, 64), STONE); }
+
+    EntityMotion MakeMotion(const Vector3F& min, const Vector3F& displacement, bool grounded)
+    {
+        EntityMotion motion;
+        motion.Min          = min;
+        motion.Max          = min + Vector3F(0.6f, 1.8f, 0.6f);
+        motion.Displacement = displacement;
+        motion.Grounded     = grounded;
+        return motion;
+    }
+} // namespace
+
+TEST(VoxelColliderTest, LandsOnTheGroundAndStopsAtWalls)
+{
+    ChunkedVoxelMap map(15, 64, 64, 64);
+    BuildFloor(map);
+    map.FillBlocks(Int3(20, 4, 0), Int3(1, 4, 64), STONE);
+    map.FillBlocks(Int3(0, 4, 40), Int3(64, 4, 1), STONE);
+    VoxelCollider collider(map);
+
+    const MoveResult fall = collider.Move(MakeMotion(Vector3F(10.2f, 6.0f, 10.2f), Vector3F(0.0f, -5.0f, 0.0f), false));
+    EXPECT_FLOAT_EQ(fall.Min.Y, 4.0f);
+    EXPECT_FLOAT_EQ(fall.Moved.Y, -2.0f);
+    EXPECT_EQ(fall.Blocked, 2);
+    EXPECT_TRUE(fall.Grounded);
+    EXPECT_FALSE(fall.Stepped);
+    EXPECT_TRUE(collider.IsGrounded(fall.Min, fall.Max));
+    EXPECT_FALSE(collider.IsGrounded(Vector3F(10.0f, 4.5f, 10.0f), Vector3F(10.6f, 6.3f, 10.6f)));
+
+    // Sliding along the floor into the wall at x = 20 and the one at z = 40.
+    const MoveResult wall = collider.Move(MakeMotion(Vector3F(18.5f, 4.0f, 10.0f), Vector3F(3.0f, 0.0f, 1.0f), true));
+    EXPECT_FLOAT_EQ(wall.Max.X, 20.0f);
+    EXPECT_FLOAT_EQ(wall.Min.Z, 11.0f);
+    EXPECT_FLOAT_EQ(wall.Min.Y, 4.0f);
+    EXPECT_EQ(wall.Blocked, 1);
+    EXPECT_TRUE(wall.Grounded);
+    const MoveResult corner = collider.Move(MakeMotion(Vector3F(18.0f, 4.0f, 38.0f), Vector3F(4.0f, -0.1f, 4.0f), true));
+    EXPECT_FLOAT_EQ(corner.Max.X, 20.0f);
+    EXPECT_FLOAT_EQ(corner.Max.Z, 40.0f);
+    EXPECT_EQ(corner.Blocked, 7);
+
+    EXPECT_TRUE(collider.Overlaps(Vector3F(19.5f, 5.0f, 5.0f), Vector3F(20.5f, 6.0f, 6.0f)));
+    EXPECT_FALSE(collider.Overlaps(wall.Min, wall.Max));
+    // Outside the map is empty.
+    EXPECT_FALSE(collider.Move(MakeMotion(Vector3F(-5.0f, 2.0f, 5.0f), Vector3F(0.0f, -3.0f, 0.0f), false)).Grounded);
+}
+
+TEST(VoxelColliderTest, StepsUpLowLedgesOnly)
+{
+    ChunkedVoxelMap map(15, 64, 64, 64);
+    BuildFloor(map);
+    map.FillBlocks(Int3(20, 4, 0), Int3(10, 1, 64), STONE);
+    VoxelCollider low(map);
+    VoxelCollider high(map, CollisionSettings {1.1f, 0.01f});
+
+    const EntityMotion walk = MakeMotion(Vector3F(18.8f, 4.0f, 10.0f), Vector3F(1.0f, -0.1f, 0.0f), true);
+    const MoveResult   stop = low.Move(walk);
+    EXPECT_FLOAT_EQ(stop.Max.X, 20.0f);
+    EXPECT_FALSE(stop.Stepped);
+
+    const MoveResult climb = high.Move(walk);
+    EXPECT_FLOAT_EQ(climb.Min.X, 19.8f);
+    EXPECT_FLOAT_EQ(climb.Min.Y, 5.0f);
+    EXPECT_TRUE(climb.Stepped);
+    EXPECT_TRUE(climb.Grounded);
+    EXPECT_EQ(climb.Blocked & 1, 0);
+
+    // Airborne boxes do not step.
+    EXPECT_FALSE(high.Move(MakeMotion(Vector3F(18.8f, 4.5f, 10.0f), Vector3F(1.0f, 0.0f, 0.0f), false)).Stepped);
+    // Nor under a ceiling that leaves no room.
+    map.FillBlocks(Int3(18, 6, 0), Int3(4, 1, 64), STONE);
+    EXPECT_FALSE(high.Move(walk).Stepped);
+}
+
+TEST(VoxelColliderTest, SeesChunksCreatedAndRemovedBetweenMoves)
+{
+    ChunkedVoxelMap    map(15, 64, 64, 64);
+    VoxelCollider      collider(map);
+    const EntityMotion fall = MakeMotion(Vector3F(10.2f, 40.0f, 10.2f), Vector3F(0.0f, -10.0f, 0.0f), false);
+    EXPECT_FLOAT_EQ(collider.Move(fall).Min.Y, 30.0f);
+
+    // A platform in a new chunk, then the chunk removed again.
+    map.FillBlocks(Int3(0, 32, 0), Int3(32, 2, 32), STONE);
+    EXPECT_FLOAT_EQ(collider.Move(fall).Min.Y, 34.0f);
+    map.FillBlocks(Int3(0, 32, 0), Int3(32, 32, 32), AIR_KIND);
+    EXPECT_FLOAT_EQ(collider.Move(fall).Min.Y, 30.0f);
+
+    // Another map with the same chunk positions.
+    ChunkedVoxelMap other(15, 64, 64, 64);
+    other.FillBlocks(Int3(0, 32, 0), Int3(32, 4, 32), STONE);
+    EXPECT_FLOAT_EQ(VoxelCollider(other).Move(fall).Min.Y, 36.0f);
+    EXPECT_FLOAT_EQ(collider.Move(fall).Min.Y, 30.0f);
+}
+
+TEST(VoxelColliderTest, IgnoresKindsThatAreNotSolid)
+{
+    ChunkedVoxelMap map(15, 64, 64, 64);
+    BuildFloor(map);
+    map.FillBlocks(Int3(0, 4, 0), Int3(64, 4, 64), LEAVES);
+    VoxelCollider collider(map);
+    EXPECT_FLOAT_EQ(collider.Move(MakeMotion(Vector3F(10.2f, 10.0f, 10.2f), Vector3F(0.0f, -8.0f, 0.0f), false)).Min.Y, 8.0f);
+
+    collider.SetKindSolid(LEAVES, false);
+    EXPECT_FALSE(collider.IsSolid(LEAVES));
+    EXPECT_TRUE(collider.IsSolid(STONE));
+    EXPECT_FALSE(collider.IsSolid(AIR_KIND));
+    const MoveResult fall = collider.Move(MakeMotion(Vector3F(10.2f, 10.0f, 10.2f), Vector3F(0.0f, -8.0f, 0.0f), false));
+    EXPECT_FLOAT_EQ(fall.Min.Y, 4.0f);
+    EXPECT_TRUE(fall.Grounded);
+
+    EXPECT_THROW(collider.SetKindSolid(AIR_KIND, true), std::invalid_argument);
+    EXPECT_THROW(collider.SetKindSolid(16, true), std::out_of_range);
+    EXPECT_FALSE(collider.IsSolid(16));
+    EXPECT_THROW(VoxelCollider(map, CollisionSettings {-1.0f, 0.01f}), std::invalid_argument);
+}
+
+TEST(VoxelColliderTest, MoveBatchMatchesMove)
+{
+    ChunkedVoxelMap map(15, 96, 64, 96);
+    map.FillBlocks(Int3(0, 0, 0), Int3(96, 8, 96), STONE);
+    std::mt19937                       random(1);
+    std::uniform_int_distribution<int> coordinate(0, 95);
+    std::uniform_int_distribution<int> height(8, 12);
+    for (int i = 0; i < 3000; ++i)
+        map.SetBlock(coordinate(random), height(random), coordinate(random), i % 3 == 0 ? LEAVES : STONE);
+    VoxelCollider collider(map);
+    collider.SetKindSolid(LEAVES, false);
+
+    std::uniform_real_distribution<float> position(-2.0f, 96.0f);
+    std::uniform_real_distribution<float> up(8.0f, 14.0f);
+    std::uniform_real_distribution<float> step(-1.5f, 1.5f);
+    std::vector<EntityMotion>             motions(5000);
+    for (std::size_t i = 0; i < motions.size(); ++i)
+        motions[i] = MakeMotion(Vector3F(position(random), up(random), position(random)), Vector3F(step(random), step(random), step(random)), i % 2 == 0);
+
+    ThreadPool              pool(3);
+    std::vector<MoveResult> results(motions.size());
+    collider.MoveBatch(motions, results, pool);
+    int stepped = 0;
+    for (std::size_t i = 0; i < motions.size(); ++i)
+    {
+        const MoveResult single = collider.Move(motions[i]);
+        ASSERT_EQ(results[i].Min.X, single.Min.X) << i;
+        ASSERT_EQ(results[i].Min.Y, single.Min.Y) << i;
+        ASSERT_EQ(results[i].Min.Z, single.Min.Z) << i;
+        ASSERT_EQ(results[i].Grounded, single.Grounded) << i;
+        ASSERT_EQ(results[i].Blocked, single.Blocked) << i;
+        // Boxes that start clear end clear.
+        if (!collider.Overlaps(motions[i].Min, motions[i].Max))
+        {
+            ASSERT_FALSE(collider.Overlaps(results[i].Min + Vector3F(1e-3f), results[i].Max - Vector3F(1e-3f))) << i;
+        }
+        stepped += results[i].Stepped;
+    }
+    EXPECT_GT(stepped, 0);
+
+    std::vector<MoveResult> tooFew(10);
+    EXPECT_THROW(collider.MoveBatch(motions, tooFew, pool), std::invalid_argument);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "Terrain/ColumnFieldCache.h"
+#include "Thread/ThreadPool.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    // Marks the fields with their column and counts the calls.
+    class CountingFields
+    {
+    public:
+        ColumnFieldCache::ComputeFunc Func()
+        {
+            return [this](int columnX, int columnZ, ColumnFields& fields) {
+                ++calls_;
+                fields.Height.fill(static_cast<float>(columnX * 1000 + columnZ));
+            };
+        }
+
+        int Calls() const { return calls_; }
+
+    private:
+        std::atomic<int> calls_ {0};
+    };
+} // namespace
+
+TEST(ColumnFieldCacheTest, EvictsTheLeastRecentlyUsedColumn)
+{
+    CountingFields   counting;
+    ColumnFieldCache cache(counting.Func(), 2);
+
+    EXPECT_EQ(cache.Get(0, 0)->Height[0], 0.0f);
+    EXPECT_EQ(cache.Get(0, 0)->Height[5], 0.0f);
+    EXPECT_EQ(cache.Get(1, -2)->Height[0], 998.0f);
+    cache.Get(0, 0);
+    cache.Get(2, 0); // evicts (1, -2)
+    EXPECT_EQ(counting.Calls(), 3);
+    cache.Get(0, 0);
+    cache.Get(1, -2); // evicts (2, 0)
+    EXPECT_EQ(counting.Calls(), 4);
+
+    ColumnFieldCacheStats stats = cache.Stats();
+    EXPECT_EQ(stats.Hits, 3u);
+    EXPECT_EQ(stats.Misses, 4u);
+    EXPECT_EQ(stats.Evictions, 2u);
+    EXPECT_EQ(stats.ResidentColumns, 2u);
+    EXPECT_DOUBLE_EQ(stats.HitRate(), 3.0 / 7.0);
+
+    // Fields stay valid after eviction.
+    const std::shared_ptr<const ColumnFields> held = cache.Get(0, 0);
+    cache.SetCapacity(0);
+    EXPECT_EQ(cache.Stats().ResidentColumns, 0u);
+    EXPECT_EQ(held->Height[0], 0.0f);
+
+    // Without capacity every lookup computes.
+    cache.Get(0, 0);
+    cache.Get(0, 0);
+    EXPECT_EQ(counting.Calls(), 6);
+
+    cache.SetCapacity(8);
+    cache.Get(3, 3);
+    cache.Clear();
+    EXPECT_EQ(cache.Stats().ResidentColumns, 0u);
+    EXPECT_EQ(cache.Capacity(), 8u);
+}
+
+TEST(ColumnFieldCacheTest, ComputesAColumnOnceForConcurrentLookups)
+{
+    constexpr int COLUMNS = 6;
+    constexpr int LOOKUPS = 600;
+
+    std::atomic<int> calls {0};
+    ColumnFieldCache cache(
+        [&](int columnX, int, ColumnFields& fields) {
+            ++calls;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            fields.Height.fill(static_cast<float>(columnX));
+        },
+        COLUMNS);
+
+    ThreadPool pool(8);
+    pool.ParallelFor(LOOKUPS, [&](std::size_t i) {
+        const int column = static_cast<int>(i % COLUMNS);
+        EXPECT_EQ(cache.Get(column, 7)->Height[CHUNK_AREA - 1], static_cast<float>(column));
+    });
+
+    EXPECT_EQ(calls.load(), COLUMNS);
+    EXPECT_EQ(cache.Stats().Misses, static_cast<uint64_t>(COLUMNS));
+    EXPECT_EQ(cache.Stats().Hits, static_cast<uint64_t>(LOOKUPS - COLUMNS));
+}
+
+TEST(ColumnFieldCacheTest, FailedComputationsAreNotCached)
+{
+    int              calls = 0;
+    ColumnFieldCache cache(
+        [&](int, int, ColumnFields& fields) {
+            if (++calls == 1)
+                throw std::runtime_error("noise failed");
+            fields.Height.fill(1.0f);
+        },
+        4);
+
+    EXPECT_THROW(cache.Get(0, 0), std::runtime_error);
+    EXPECT_EQ(cache.Stats().ResidentColumns, 0u);
+    EXPECT_EQ(cache.Get(0, 0)->Height[0], 1.0f);
+    EXPECT_EQ(calls, 2);
+
+    EXPECT_THROW(ColumnFieldCache({}, 4), std::invalid_argument);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Terrain/GradientNoise.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    // Not a multiple of the batch, so the padded tail is covered too.
+    constexpr std::size_t SAMPLES = 1003;
+
+    // Batches and single samples may differ where the compiler fuses multiplies and adds.
+    constexpr float TOLERANCE = 1e-5f;
+
+    struct Points
+    {
+        std::vector<float> X, Y, Z;
+    };
+
+    Points RandomPoints(uint32_t seed, float range)
+    {
+        std::mt19937                          random(seed);
+        std::uniform_real_distribution<float> coordinate(-range, range);
+        Points                                points;
+        for (std::size_t i = 0; i < SAMPLES; ++i)
+        {
+            points.X.push_back(coordinate(random));
+            points.Y.push_back(coordinate(random));
+            points.Z.push_back(coordinate(random));
+        }
+        return points;
+    }
+} // namespace
+
+TEST(GradientNoiseTest, BatchesMatchSingleSamples)
+{
+    const GradientNoise noise(42);
+    const Points        points = RandomPoints(7, 300.0f);
+    std::vector<float>  out(SAMPLES);
+
+    noise.Sample(points.X, points.Y, out);
+    for (std::size_t i = 0; i < SAMPLES; ++i)
+        EXPECT_NEAR(out[i], noise.Sample(points.X[i], points.Y[i]), TOLERANCE);
+
+    noise.Sample(points.X, points.Y, points.Z, out);
+    for (std::size_t i = 0; i < SAMPLES; ++i)
+        EXPECT_NEAR(out[i], noise.Sample(points.X[i], points.Y[i], points.Z[i]), TOLERANCE);
+
+    for (const FractalType type : {FractalType::Fbm, FractalType::Ridged})
+    {
+        const FractalSettings settings {type, 5, 1.0f / 64.0f, 2.0f, 0.5f};
+        noise.Fractal(settings, points.X, points.Y, out);
+        for (std::size_t i = 0; i < SAMPLES; ++i)
+            EXPECT_NEAR(out[i], noise.Fractal(settings, points.X[i], points.Y[i]), TOLERANCE);
+
+        noise.Fractal(settings, points.X, points.Y, points.Z, out);
+        for (std::size_t i = 0; i < SAMPLES; ++i)
+            EXPECT_NEAR(out[i], noise.Fractal(settings, points.X[i], points.Y[i], points.Z[i]), TOLERANCE);
+    }
+
+    // A sample is the same wherever it sits in the batch.
+    std::vector<float> single(1);
+    noise.Sample(std::span(points.X).subspan(SAMPLES - 1), std::span(points.Y).subspan(SAMPLES - 1), single);
+    noise.Sample(points.X, points.Y, out);
+    EXPECT_EQ(single[0], out[SAMPLES - 1]);
+}
+
+TEST(GradientNoiseTest, StaysInRangeAndDependsOnSeed)
+{
+    const GradientNoise noise(1);
+    const GradientNoise same(1);
+    const GradientNoise other(2);
+    const Points        points = RandomPoints(3, 1000.0f);
+
+    int   differing = 0;
+    float largest   = 0.0f;
+    for (std::size_t i = 0; i < SAMPLES; ++i)
+    {
+        const float value2 = noise.Sample(points.X[i], points.Y[i]);
+        const float value3 = noise.Sample(points.X[i], points.Y[i], points.Z[i]);
+        EXPECT_LE(std::fabs(value2), 1.0f);
+        EXPECT_LE(std::fabs(value3), 1.0f);
+        EXPECT_EQ(value3, same.Sample(points.X[i], points.Y[i], points.Z[i]));
+        differing += value3 != other.Sample(points.X[i], points.Y[i], points.Z[i]);
+        largest = std::max(largest, std::max(std::fabs(value2), std::fabs(value3)));
+
+        const FractalSettings ridged {FractalType::Ridged, 4, 1.0f / 32.0f, 2.0f, 0.5f};
+        const float           ridge = noise.Fractal(ridged, points.X[i], points.Y[i]);
+        EXPECT_GE(ridge, 0.0f);
+        EXPECT_LE(ridge, 1.0f);
+    }
+    EXPECT_GT(differing, static_cast<int>(SAMPLES) * 9 / 10);
+    EXPECT_GT(largest, 0.5f);
+
+    // Gradient noise is zero on the lattice.
+    for (int x = -3; x <= 3; ++x)
+        for (int y = -3; y <= 3; ++y)
+        {
+            EXPECT_EQ(noise.Sample(static_cast<float>(x), static_cast<float>(y)), 0.0f);
+            EXPECT_EQ(noise.Sample(static_cast<float>(x), static_cast<float>(y), 5.0f), 0.0f);
+        }
+}
+
+TEST(GradientNoiseTest, RejectsBadArguments)
+{
+    const GradientNoise noise(0);
+    std::vector<float>  coordinates(16);
+    std::vector<float>  out(15);
+    EXPECT_THROW(noise.Sample(coordinates, coordinates, out), std::invalid_argument);
+    EXPECT_THROW(noise.Sample(coordinates, coordinates, std::span(coordinates).first(8), std::span(coordinates).first(8)), std::invalid_argument);
+
+    FractalSettings settings;
+    settings.Octaves = 0;
+    EXPECT_THROW(noise.Fractal(settings, 1.0f, 2.0f), std::invalid_argument);
+    EXPECT_THROW(noise.Fractal(settings, coordinates, coordinates, coordinates), std::invalid_argument);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "Terrain/TerrainGenerator.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    constexpr int WORLD_CHUNKS = 4;
+    constexpr int WORLD_LAYERS = 6;
+
+    ChunkedVoxelMap MakeMap() { return ChunkedVoxelMap(255, WORLD_CHUNKS * CHUNK_SIZE, WORLD_LAYERS * CHUNK_SIZE, WORLD_CHUNKS * CHUNK_SIZE); }
+
+    bool SameChunk(const VoxelChunk& a, const VoxelChunk& b)
+    {
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+            if (a.Get(i) != b.Get(i))
+                return false;
+        return true;
+    }
+} // namespace
+
+TEST(TerrainGeneratorTest, SameWorldOnAnyThreadInAnyOrder)
+{
+    TerrainSettings settings;
+    settings.Seed = 1234;
+    const TerrainGenerator generator(settings);
+
+    ChunkedVoxelMap   parallel = MakeMap();
+    ThreadPool        pool(4);
+    const Int3        last(WORLD_CHUNKS - 1, WORLD_LAYERS - 1, WORLD_CHUNKS - 1);
+    const std::size_t stored = generator.GenerateRegion(parallel, Int3(-2, 0, 0), Int3(99, 99, 99), pool);
+    EXPECT_EQ(stored, parallel.ChunkCount());
+    EXPECT_GT(stored, 0u);
+    EXPECT_LT(stored, static_cast<std::size_t>(WORLD_CHUNKS * WORLD_LAYERS * WORLD_CHUNKS));
+
+    // Serially, top layer first, and through a streamer loader.
+    const ChunkLoader loader = generator.Loader();
+    for (int y = last.Y; y >= 0; --y)
+        for (int z = last.Z; z >= 0; --z)
+            for (int x = last.X; x >= 0; --x)
+            {
+                VoxelChunk        chunk;
+                const bool        found    = loader(Int3(x, y, z), chunk);
+                const VoxelChunk* expected = parallel.GetChunk(Int3(x, y, z));
+                ASSERT_EQ(found, expected != nullptr);
+                if (found)
+                {
+                    EXPECT_TRUE(SameChunk(chunk, *expected));
+                }
+            }
+
+    TerrainSettings reseeded = settings;
+    reseeded.Seed            = 1235;
+    const TerrainGenerator other(reseeded);
+
+    int differing = 0;
+    for (int z = 0; z < CHUNK_SIZE * WORLD_CHUNKS; z += 7)
+        for (int x = 0; x < CHUNK_SIZE * WORLD_CHUNKS; x += 7)
+            differing += generator.SurfaceHeight(x, z) != other.SurfaceHeight(x, z);
+    EXPECT_GT(differing, 0);
+}
+
+TEST(TerrainGeneratorTest, SurfaceFollowsTheHeightmap)
+{
+    // Without overhangs and caves every column is solid exactly below its surface height.
+    TerrainSettings settings;
+    settings.Seed          = 5;
+    settings.OverhangDepth = 0.0f;
+    settings.CaveWidth     = 0.0f;
+    const TerrainGenerator generator(settings);
+
+    ChunkedVoxelMap map = MakeMap();
+    ThreadPool      pool(2);
+    generator.GenerateRegion(map, Int3(0, 0, 0), Int3(1, WORLD_LAYERS - 1, 1), pool);
+
+    for (int z = 0; z < 2 * CHUNK_SIZE; z += 3)
+        for (int x = 0; x < 2 * CHUNK_SIZE; x += 3)
+        {
+            const float height = generator.SurfaceHeight(x, z);
+            const int   top    = static_cast<int>(std::ceil(height)) - 1;
+            ASSERT_GT(top, settings.SoilDepth);
+            ASSERT_LT(top + 1, map.SizeY());
+
+            const Biome     biome    = generator.Fields(x >> CHUNK_SHIFT, z >> CHUNK_SHIFT)->Biomes[(x & CHUNK_MASK) | (z & CHUNK_MASK) << CHUNK_SHIFT];
+            const BlockKind expected = biome == Biome::Plains ? settings.Grass : biome == Biome::Snow ? settings.Snow : settings.Sand;
+            EXPECT_EQ(map.GetBlock(x, top, z), expected);
+            EXPECT_EQ(biome == Biome::Ocean, height <= settings.SeaLevel);
+            EXPECT_EQ(map.GetBlock(x, top + 1, z), top + 1 <= settings.SeaLevel ? settings.Water : AIR_KIND);
+            EXPECT_EQ(map.GetBlock(x, top - settings.SoilDepth, z), settings.Stone);
+            EXPECT_EQ(map.GetBlock(x, 0, z), settings.Stone);
+        }
+}
+
+TEST(TerrainGeneratorTest, CavesAndOverhangsCarveBelowTheSurface)
+{
+    TerrainSettings settings;
+    settings.Seed      = 77;
+    settings.CaveWidth = 0.1f;
+    const TerrainGenerator generator(settings);
+
+    ChunkedVoxelMap map = MakeMap();
+    ThreadPool      pool(2);
+    generator.GenerateRegion(map, Int3(0, 0, 0), Int3(WORLD_CHUNKS - 1, WORLD_LAYERS - 1, WORLD_CHUNKS - 1), pool);
+
+    int caveAir = 0;
+    for (int z = 0; z < map.SizeZ(); z += 2)
+        for (int x = 0; x < map.SizeX(); x += 2)
+        {
+            const int roof = static_cast<int>(generator.SurfaceHeight(x, z) - settings.OverhangDepth - settings.CaveRoof);
+            for (int y = 0; y < roof; ++y)
+                caveAir += map.GetBlock(x, y, z) == AIR_KIND;
+        }
+    EXPECT_GT(caveAir, 0);
+}
+
+TEST(TerrainGeneratorTest, ChunksOfAColumnShareItsFields)
+{
+    TerrainSettings settings;
+    settings.ColumnCacheCapacity = 2;
+    const TerrainGenerator generator(settings);
+
+    VoxelChunk chunk;
+    for (int y = 0; y < WORLD_LAYERS; ++y)
+        generator.Generate(Int3(3, y, 1), chunk);
+    EXPECT_EQ(generator.CacheStats().Misses, 1u);
+    EXPECT_EQ(generator.CacheStats().Hits, static_cast<uint64_t>(WORLD_LAYERS - 1));
+
+    // Only two columns stay; the first one is computed again after two others.
+    generator.SurfaceHeight(0, 0);
+    generator.SurfaceHeight(CHUNK_SIZE, 0);
+    generator.Generate(Int3(3, 0, 1), chunk);
+    EXPECT_EQ(generator.CacheStats().Misses, 4u);
+    EXPECT_EQ(generator.CacheStats().ResidentColumns, 2u);
+}
+
+TEST(TerrainGeneratorTest, LoaderPrefersStoredChunks)
+{
+    TerrainSettings settings;
+    settings.CaveWidth = 0.0f;
+    const TerrainGenerator generator(settings);
+    const ChunkLoader      loader = generator.Loader([](const Int3& chunkPos, VoxelChunk& chunk) {
+        if (chunkPos.X != 0)
+            return false;
+        chunk = VoxelChunk(9);
+        return true;
+    });
+
+    VoxelChunk chunk;
+    EXPECT_TRUE(loader(Int3(0, 0, 0), chunk));
+    EXPECT_EQ(chunk.Get(0), 9);
+    EXPECT_TRUE(loader(Int3(1, 0, 0), chunk));
+    EXPECT_EQ(chunk.Get(0), generator.Settings().Stone);
+
+    // Chunks high above the land are air and count as never stored.
+    EXPECT_FALSE(loader(Int3(1, 20, 0), chunk));
+
+    TerrainSettings negative;
+    negative.OverhangDepth = -1.0f;
+    EXPECT_THROW(TerrainGenerator {negative}, std::invalid_argument);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Thread/MpscQueue.h"
+
+using namespace Voxium::Core;
+
+TEST(MpscQueueTest, PopsInPushOrder)
+{
+    MpscQueue<int> queue;
+    EXPECT_TRUE(queue.Empty());
+    EXPECT_FALSE(queue.TryPop().has_value());
+
+    for (int i = 0; i < 5; ++i)
+        queue.Push(i);
+    EXPECT_FALSE(queue.Empty());
+    for (int i = 0; i < 5; ++i)
+        EXPECT_EQ(queue.TryPop(), i);
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(MpscQueueTest, HoldsMoveOnlyItemsAndFreesLeftovers)
+{
+    auto tracked = std::make_shared<int>(7);
+    {
+        MpscQueue<std::unique_ptr<std::shared_ptr<int>>> queue;
+        queue.Push(std::make_unique<std::shared_ptr<int>>(tracked));
+        queue.Push(std::make_unique<std::shared_ptr<int>>(tracked));
+        EXPECT_EQ(tracked.use_count(), 3);
+
+        auto first = queue.TryPop();
+        ASSERT_TRUE(first.has_value());
+        EXPECT_EQ(**first->get(), 7);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(MpscQueueTest, ConcurrentProducersKeepPerProducerOrder)
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int ITEMS     = 20000;
+
+    MpscQueue<int>           queue;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < ITEMS; ++i)
+                queue.Push(p * ITEMS + i);
+        });
+    }
+
+    std::vector<int> next(PRODUCERS, 0);
+    int              received = 0;
+    while (received < PRODUCERS * ITEMS)
+    {
+        if (std::optional<int> item = queue.TryPop())
+        {
+            const int producer = *item / ITEMS;
+            EXPECT_EQ(*item % ITEMS, next[producer]);
+            ++next[producer];
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& producer : producers)
+        producer.join();
+    EXPECT_TRUE(queue.Empty());
+}
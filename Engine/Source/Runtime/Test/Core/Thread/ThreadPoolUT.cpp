@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "Thread/ThreadPool.h"
+
+using namespace Voxium::Core;
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce)
+{
+    ThreadPool             pool(4);
+    std::vector<int>       hits(10000, 0);
+    std::atomic<long long> sum {0};
+
+    pool.ParallelFor(hits.size(), [&](std::size_t i) {
+        ++hits[i];
+        sum += static_cast<long long>(i);
+    });
+
+    for (int h : hits)
+        EXPECT_EQ(h, 1);
+    EXPECT_EQ(sum.load(), 9999LL * 10000LL / 2);
+}
+
+TEST(ThreadPoolTest, ParallelForForwardsExceptions)
+{
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.ParallelFor(100,
+                                  [](std::size_t i) {
+                                      if (i == 42)
+                                          throw std::runtime_error("boom");
+                                  }),
+                 std::runtime_error);
+}
+
+TEST(ThreadPoolTest, NestedParallelForDoesNotDeadlock)
+{
+    ThreadPool       pool(2);
+    std::atomic<int> count {0};
+    pool.ParallelFor(8, [&](std::size_t) { pool.ParallelFor(8, [&](std::size_t) { ++count; }); });
+    EXPECT_EQ(count.load(), 64);
+}
+
+TEST(ThreadPoolTest, WaitIdleDrainsSubmittedTasks)
+{
+    ThreadPool       pool(3);
+    std::atomic<int> count {0};
+    for (int i = 0; i < 100; ++i)
+        pool.Submit([&] { ++count; });
+    pool.WaitIdle();
+    EXPECT_EQ(count.load(), 100);
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Voxel/ChunkDistanceField.h"
+#include "Voxel/VoxelRaycaster.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    constexpr BlockKind STONE = 1;
+    constexpr BlockKind DIRT  = 2;
+
+    // Sparse boxes and single voxels over three chunks a side, with open space between them.
+    void BuildScene(ChunkedVoxelMap& map, uint32_t seed)
+    {
+        std::mt19937                       random(seed);
+        std::uniform_int_distribution<int> coordinate(0, 95);
+        std::uniform_int_distribution<int> extent(1, 6);
+        for (int i = 0; i < 40; ++i)
+            map.FillBlocks(Int3(coordinate(random), coordinate(random), coordinate(random)), Int3(extent(random), extent(random), extent(random)),
+                           i % 2 == 0 ? STONE : DIRT);
+        for (int i = 0; i < 200; ++i)
+            map.SetBlock(coordinate(random), coordinate(random), coordinate(random), STONE);
+        map.FillBlocks(Int3(32, 0, 32), Int3(32, 32, 32), STONE);
+    }
+
+    // Distance to the nearest solid centre by scanning the cube around the voxel.
+    float ScanDistance(const ChunkedVoxelMap& map, int x, int y, int z)
+    {
+        constexpr int reach   = ChunkDistanceField::MAX_DISTANCE;
+        int           nearest = reach * reach;
+        for (int dy = -reach; dy <= reach; ++dy)
+            for (int dz = -reach; dz <= reach; ++dz)
+                for (int dx = -reach; dx <= reach; ++dx)
+                {
+                    const int squared = dx * dx + dy * dy + dz * dz;
+                    if (squared < nearest && !map.OutOfBounds(x + dx, y + dy, z + dz) && map.GetBlock(x + dx, y + dy, z + dz) != AIR_KIND)
+                        nearest = squared;
+                }
+        return std::floor(std::sqrt(static_cast<float>(nearest)) * ChunkDistanceField::STEPS_PER_VOXEL) / ChunkDistanceField::STEPS_PER_VOXEL;
+    }
+
+    void ExpectMatchesScan(const ChunkDistanceField& field, const ChunkedVoxelMap& map, uint32_t seed)
+    {
+        std::mt19937                       random(seed);
+        std::uniform_int_distribution<int> coordinate(0, 95);
+        int                                mismatches = 0;
+        for (int i = 0; i < 3000; ++i)
+        {
+            const int x = coordinate(random);
+            const int y = coordinate(random);
+            const int z = coordinate(random);
+            if (field.Distance(x, y, z) != ScanDistance(map, x, y, z) && mismatches++ < 5)
+                ADD_FAILURE() << "distance differs at " << x << ", " << y << ", " << z << ": " << field.Distance(x, y, z) << " vs "
+                              << ScanDistance(map, x, y, z);
+        }
+        EXPECT_EQ(mismatches, 0);
+    }
+} // namespace
+
+TEST(ChunkDistanceFieldTest, MatchesANeighbourhoodScan)
+{
+    ChunkedVoxelMap map(15, 96, 96, 96);
+    BuildScene(map, 1);
+    ChunkDistanceField field(map);
+    field.Rebuild();
+    ExpectMatchesScan(field, map, 2);
+
+    // Every voxel beside a chunk border, where the margins count.
+    for (int y = 0; y < 96; y += 5)
+        for (int z = 0; z < 96; z += 3)
+            for (const int x : {31, 32, 63, 64})
+                ASSERT_EQ(field.Distance(x, y, z), ScanDistance(map, x, y, z)) << x << ", " << y << ", " << z;
+
+    EXPECT_EQ(field.Distance(40, 10, 40), 0.0f);
+    EXPECT_EQ(field.Distance(-1, 10, 40), static_cast<float>(ChunkDistanceField::MAX_DISTANCE));
+    EXPECT_EQ(field.Get(Int3(1, 0, 1)), field.Get(Int3(1, 0, 1)));
+    EXPECT_NE(field.Get(Int3(1, 0, 1)), nullptr);
+    EXPECT_LE(field.ChunkCount(), 27u);
+}
+
+TEST(ChunkDistanceFieldTest, UpdateMatchesRebuild)
+{
+    ChunkedVoxelMap map(15, 96, 96, 96);
+    BuildScene(map, 3);
+    ThreadPool         pool(3);
+    ChunkDistanceField field(map);
+    field.Rebuild(pool);
+
+    std::mt19937                       random(4);
+    std::uniform_int_distribution<int> coordinate(0, 95);
+    for (int i = 0; i < 100; ++i)
+    {
+        const int x = coordinate(random);
+        const int y = coordinate(random);
+        const int z = coordinate(random);
+        map.SetBlock(x, y, z, i % 2 == 0 ? AIR_KIND : STONE);
+        field.OnBlockChanged(x, y, z);
+    }
+    map.FillBlocks(Int3(32, 0, 32), Int3(32, 32, 32), AIR_KIND);
+    field.OnChunkChanged(Int3(1, 0, 1));
+    EXPECT_GT(field.PendingCount(), 0u);
+    field.Update(pool);
+    EXPECT_EQ(field.PendingCount(), 0u);
+    ExpectMatchesScan(field, map, 5);
+
+    ChunkDistanceField rebuilt(map);
+    rebuilt.Rebuild();
+    EXPECT_EQ(field.ChunkCount(), rebuilt.ChunkCount());
+    for (int cy = 0; cy < 3; ++cy)
+        for (int cz = 0; cz < 3; ++cz)
+            for (int cx = 0; cx < 3; ++cx)
+            {
+                const ChunkDistanceField::Distances* updated = field.Get(Int3(cx, cy, cz));
+                const ChunkDistanceField::Distances* fresh   = rebuilt.Get(Int3(cx, cy, cz));
+                ASSERT_EQ(updated == nullptr, fresh == nullptr);
+                if (updated != nullptr)
+                {
+                    EXPECT_EQ(*updated, *fresh);
+                }
+            }
+    EXPECT_THROW(field.OnBlockChanged(0, 96, 0), std::out_of_range);
+}
+
+TEST(ChunkDistanceFieldTest, DispatchedJobsMatchAScan)
+{
+    ChunkedVoxelMap map(15, 96, 96, 96);
+    BuildScene(map, 8);
+    ThreadPool         pool(3);
+    ChunkDistanceField field(map);
+    field.Rebuild(pool);
+
+    map.FillBlocks(Int3(20, 20, 20), Int3(30, 4, 30), STONE);
+    field.OnBoxChanged(Int3(20, 20, 20), Int3(30, 4, 30));
+    const std::size_t marked = field.PendingCount();
+    EXPECT_EQ(field.Dispatch(pool), marked);
+    EXPECT_EQ(field.PendingCount(), 0u);
+
+    // Clearing the slab again while the first jobs may still run: their fields are dropped in
+    // favour of the jobs started after it.
+    map.FillBlocks(Int3(20, 20, 20), Int3(30, 4, 30), AIR_KIND);
+    map.SetBlock(70, 70, 70, STONE);
+    field.OnBoxChanged(Int3(20, 20, 20), Int3(30, 4, 30));
+    field.OnBlockChanged(70, 70, 70);
+    const std::size_t restarted = field.Dispatch(pool);
+    EXPECT_GT(restarted, marked);
+    pool.WaitIdle();
+    EXPECT_EQ(field.JobsInFlight(), 0u);
+    EXPECT_EQ(field.Publish(), restarted);
+    EXPECT_EQ(field.Publish(), 0u);
+    ExpectMatchesScan(field, map, 9);
+
+    ChunkDistanceField rebuilt(map);
+    rebuilt.Rebuild();
+    EXPECT_EQ(field.ChunkCount(), rebuilt.ChunkCount());
+}
+
+TEST(ChunkDistanceFieldTest, SphereTracingStopsShortOfTheFirstHit)
+{
+    ChunkedVoxelMap map(15, 96, 96, 96);
+    BuildScene(map, 6);
+    ChunkDistanceField field(map);
+    field.Rebuild();
+    VoxelRaycaster raycaster(map);
+    raycaster.Rebuild();
+
+    std::mt19937                          random(7);
+    std::uniform_real_distribution<float> position(-20.0f, 116.0f);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+    int                                   skipped = 0;
+    int                                   missed  = 0;
+    for (int i = 0; i < 2000; ++i)
+    {
+        const Vector3F    origin(position(random), position(random), position(random));
+        const Vector3F    ray(direction(random), direction(random), direction(random));
+        const float       traced = field.SphereTrace(origin, ray, 200.0f);
+        const float       free   = field.Clearance(origin);
+        const VoxelRayHit hit    = raycaster.Raycast(origin, ray, 200.0f);
+        // Rays that pass close by a surface stop there too, hit or not.
+        if (hit.Hit)
+        {
+            EXPECT_LE(traced, hit.Distance + 1e-3f) << i;
+            EXPECT_LE(free, hit.Distance + 1e-3f) << i;
+        }
+        skipped += traced > 4.0f;
+        missed += !hit.Hit && traced == 200.0f;
+    }
+    EXPECT_GT(skipped, 1000);
+    EXPECT_GT(missed, 500);
+    EXPECT_EQ(field.Clearance(Vector3F(40.5f, 10.5f, 40.5f)), 0.0f);
+}
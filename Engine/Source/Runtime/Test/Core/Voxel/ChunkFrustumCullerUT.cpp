@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Math/MathUtility.h"
+#include "Voxel/ChunkFrustumCuller.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    Matrix4F ViewProjection(const Vector3F& eye, const Vector3F& target)
+    {
+        const Matrix4F view       = Matrix4F::CreateLookAt(eye, target, Vector3F(0.0f, 1.0f, 0.0f));
+        const Matrix4F projection = Matrix4F::CreatePerspectiveFieldOfView(VOXIUM_FLOAT_PI / 3.0f, 16.0f / 9.0f, 0.1f, 2000.0f);
+        return view * projection;
+    }
+} // namespace
+
+TEST(ChunkFrustumCullerTest, MatchesPerBoxTest)
+{
+    ChunkFrustumCuller                         culler;
+    std::vector<std::pair<Vector3F, Vector3F>> boxes;
+    std::mt19937                               rng(3);
+    std::uniform_real_distribution<float>      position(-1500.0f, 1500.0f), extent(0.5f, 40.0f);
+    for (uint32_t id = 0; id < 10003; ++id)
+    {
+        const Vector3F min(position(rng), position(rng) * 0.1f, position(rng));
+        boxes.emplace_back(min, min + Vector3F(extent(rng), extent(rng), extent(rng)));
+        culler.Set(id, boxes.back().first, boxes.back().second);
+    }
+    EXPECT_EQ(culler.Size(), boxes.size());
+
+    std::vector<uint32_t> visible;
+    for (int view = 0; view < 8; ++view)
+    {
+        const float    angle = view * VOXIUM_FLOAT_PI / 4.0f;
+        const Vector3F eye(position(rng) * 0.2f, 60.0f, position(rng) * 0.2f);
+        const Frustum  frustum(ViewProjection(eye, eye + Vector3F(std::cos(angle), -0.3f, std::sin(angle))));
+        culler.Cull(frustum, visible);
+
+        std::vector<uint32_t> expected;
+        for (uint32_t id = 0; id < boxes.size(); ++id)
+            if (frustum.Intersects(boxes[id].first, boxes[id].second))
+                expected.push_back(id);
+        std::sort(visible.begin(), visible.end());
+        EXPECT_EQ(visible, expected) << "view " << view;
+        EXPECT_GT(expected.size(), 100u);
+        EXPECT_LT(expected.size(), boxes.size() / 2);
+    }
+}
+
+TEST(ChunkFrustumCullerTest, SetAndRemoveKeepSlotsCompact)
+{
+    ChunkFrustumCuller culler;
+    const Matrix4F     viewProjection = ViewProjection(Vector3F(16.0f, 16.0f, 200.0f), Vector3F(16.0f, 16.0f, 0.0f));
+
+    // A row of chunks along the view direction, and one behind the camera.
+    for (uint32_t id = 0; id < 9; ++id)
+        culler.SetChunk(id, Int3(0, 0, -static_cast<int>(id)));
+    culler.SetChunk(20, Int3(0, 0, 10));
+    EXPECT_TRUE(culler.Contains(20));
+    EXPECT_FALSE(culler.Contains(15));
+
+    std::vector<uint32_t> visible;
+    culler.Cull(viewProjection, visible);
+    EXPECT_EQ(visible, std::vector<uint32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+    // Removing moves the last box into the hole; moving a box behind the camera hides it.
+    EXPECT_TRUE(culler.Remove(3));
+    EXPECT_FALSE(culler.Remove(3));
+    culler.SetChunk(5, Int3(0, 0, 12));
+    culler.SetChunk(20, Int3(0, 0, 2));
+    culler.Cull(viewProjection, visible);
+    std::sort(visible.begin(), visible.end());
+    EXPECT_EQ(visible, std::vector<uint32_t>({0, 1, 2, 4, 6, 7, 8, 20}));
+    EXPECT_EQ(culler.Size(), 9u);
+
+    for (uint32_t id : {0u, 1u, 2u, 4u, 5u, 6u, 7u, 8u, 20u})
+        EXPECT_TRUE(culler.Remove(id));
+    culler.Cull(viewProjection, visible);
+    EXPECT_TRUE(visible.empty());
+
+    culler.SetChunk(4, Int3(0, 0, 0));
+    culler.Clear();
+    EXPECT_EQ(culler.Size(), 0u);
+    EXPECT_FALSE(culler.Contains(4));
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Test/TestTerrain.h"
+#include "Voxel/ChunkLightEngine.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr BlockKind STONE = 1;
+    constexpr BlockKind TORCH = 5;
+    constexpr BlockKind LAMP  = 6;
+
+    void AddAllChunks(ChunkLightEngine& engine, const ChunkedVoxelMap& map)
+    {
+        for (int cy = 0; cy * CHUNK_SIZE < map.SizeY(); ++cy)
+            for (int cz = 0; cz * CHUNK_SIZE < map.SizeZ(); ++cz)
+                for (int cx = 0; cx * CHUNK_SIZE < map.SizeX(); ++cx)
+                    engine.AddChunk(Int3(cx, cy, cz));
+    }
+
+    // Hills with an overhanging slab, so there are shadows, caves and sky light coming in sideways.
+    void BuildTerrain(ChunkedVoxelMap& map)
+    {
+        RollingGround {20, 8.0, 9.0, 6.0, 7.0}.Fill(map, STONE);
+        map.FillBlocks(Int3(20, 40, 20), Int3(40, 2, 40), STONE);
+    }
+
+    // Compares every voxel of the engine with a relight of the whole map from scratch.
+    void ExpectMatchesFullRelight(const ChunkLightEngine& engine, const ChunkedVoxelMap& map, ThreadPool& pool)
+    {
+        ChunkLightEngine reference(map, pool);
+        reference.SetEmission(TORCH, engine.Emission(TORCH));
+        reference.SetEmission(LAMP, engine.Emission(LAMP));
+        AddAllChunks(reference, map);
+        reference.Propagate();
+
+        int mismatches = 0;
+        for (int y = 0; y < map.SizeY(); ++y)
+            for (int z = 0; z < map.SizeZ(); ++z)
+                for (int x = 0; x < map.SizeX(); ++x)
+                {
+                    const bool same = engine.SkyLight(x, y, z) == reference.SkyLight(x, y, z) && engine.BlockLight(x, y, z) == reference.BlockLight(x, y, z);
+                    if (!same && mismatches++ < 5)
+                        ADD_FAILURE() << "light differs at " << x << ", " << y << ", " << z << ": sky " << int(engine.SkyLight(x, y, z)) << " vs "
+                                      << int(reference.SkyLight(x, y, z)) << ", block " << int(engine.BlockLight(x, y, z)) << " vs "
+                                      << int(reference.BlockLight(x, y, z));
+                }
+        EXPECT_EQ(mismatches, 0);
+    }
+} // namespace
+
+TEST(ChunkLightEngineTest, SkyLightFillsOpenAirAndShadows)
+{
+    ChunkedVoxelMap map(255, 64, 64, 64);
+    map.FillBlocks(Int3(0, 0, 0), Int3(64, 10, 64), STONE);
+    map.FillBlocks(Int3(10, 40, 10), Int3(11, 1, 11), STONE);
+    ThreadPool       pool(2);
+    ChunkLightEngine engine(map, pool);
+    AddAllChunks(engine, map);
+    EXPECT_GT(engine.Propagate(), 1u);
+    EXPECT_FALSE(engine.HasPendingWork());
+
+    EXPECT_EQ(engine.SkyLight(30, 30, 30), 15);
+    EXPECT_EQ(engine.SkyLight(5, 10, 5), 15);
+    EXPECT_EQ(engine.SkyLight(5, 9, 5), 0);
+
+    // Under the middle of the roof the light comes in sideways from the open column six steps away.
+    EXPECT_EQ(engine.SkyLight(15, 39, 15), 9);
+    EXPECT_EQ(engine.SkyLight(15, 10, 15), 9);
+    EXPECT_EQ(engine.SkyLight(10, 39, 15), 14);
+    EXPECT_EQ(engine.BlockLight(30, 30, 30), 0);
+
+    // Untracked voxels read as open sky.
+    EXPECT_EQ(engine.SkyLight(100, 10, 10), 15);
+    EXPECT_EQ(engine.GetLight(Int3(5, 0, 0)), nullptr);
+    EXPECT_NE(engine.GetLight(Int3(1, 1, 1)), nullptr);
+}
+
+TEST(ChunkLightEngineTest, BlockLightFallsOffAcrossChunkBorders)
+{
+    ChunkedVoxelMap  map(255, 64, 64, 64);
+    ThreadPool       pool(2);
+    ChunkLightEngine engine(map, pool);
+    engine.SetEmission(TORCH, 14);
+    EXPECT_THROW(engine.SetEmission(TORCH, 16), std::out_of_range);
+    EXPECT_THROW(engine.SetEmission(256, 3), std::out_of_range);
+    AddAllChunks(engine, map);
+    engine.Propagate();
+    engine.TakeChangedChunks();
+
+    // At a corner shared by eight chunks.
+    const BlockKind old = map.GetBlock(32, 32, 32);
+    map.SetBlock(32, 32, 32, TORCH);
+    engine.OnBlockChanged(32, 32, 32, old);
+    engine.Propagate();
+
+    EXPECT_EQ(engine.BlockLight(32, 32, 32), 14);
+    EXPECT_EQ(engine.BlockLight(31, 32, 32), 13);
+    EXPECT_EQ(engine.BlockLight(37, 32, 32), 9);
+    EXPECT_EQ(engine.BlockLight(29, 29, 32), 8);
+    EXPECT_EQ(engine.BlockLight(32, 32, 50), 0);
+    EXPECT_EQ(engine.SkyLight(32, 32, 32), 0);
+    EXPECT_EQ(engine.TakeChangedChunks().size(), 8u);
+
+    map.SetBlock(32, 32, 32, AIR_KIND);
+    engine.OnBlockChanged(32, 32, 32, TORCH);
+    engine.Propagate();
+    EXPECT_EQ(engine.BlockLight(31, 32, 32), 0);
+    EXPECT_EQ(engine.BlockLight(37, 32, 32), 0);
+    EXPECT_EQ(engine.SkyLight(32, 32, 32), 15);
+}
+
+TEST(ChunkLightEngineTest, IncrementalEditsMatchFullRelight)
+{
+    ChunkedVoxelMap map(255, 96, 64, 96);
+    BuildTerrain(map);
+    ThreadPool       pool(3);
+    ChunkLightEngine engine(map, pool);
+    engine.SetEmission(TORCH, 14);
+    engine.SetEmission(LAMP, 9);
+    AddAllChunks(engine, map);
+    engine.Propagate();
+
+    std::mt19937                       rng(21);
+    std::uniform_int_distribution<int> px(0, 95), py(0, 63), pz(0, 95), pick(0, 9);
+    const BlockKind                    kinds[] = {AIR_KIND, AIR_KIND, AIR_KIND, STONE, STONE, STONE, STONE, TORCH, LAMP, AIR_KIND};
+    for (int round = 0; round < 6; ++round)
+    {
+        // Digging tunnels, building walls and dropping lights, several edits between relights.
+        for (int edit = 0; edit < 60; ++edit)
+        {
+            const int       x    = px(rng);
+            const int       y    = py(rng);
+            const int       z    = pz(rng);
+            const BlockKind kind = kinds[pick(rng)];
+            for (int i = 0; i < 4; ++i)
+            {
+                const int       wx  = std::min(x + i, 95);
+                const BlockKind old = map.GetBlock(wx, y, z);
+                map.SetBlock(wx, y, z, kind);
+                engine.OnBlockChanged(wx, y, z, old);
+            }
+            if (edit % 7 == 0)
+                engine.Propagate();
+        }
+        engine.Propagate();
+        ExpectMatchesFullRelight(engine, map, pool);
+        if (HasFailure())
+            return;
+    }
+
+    // Clearing the roof lets the sky back in.
+    const BlockKind old = map.GetBlock(30, 40, 30);
+    map.FillBlocks(Int3(20, 40, 20), Int3(40, 2, 40), AIR_KIND);
+    for (int z = 20; z < 60; ++z)
+        for (int x = 20; x < 60; ++x)
+            for (int y = 40; y < 42; ++y)
+                engine.OnBlockChanged(x, y, z, old);
+    engine.Propagate();
+    ExpectMatchesFullRelight(engine, map, pool);
+}
+
+TEST(ChunkLightEngineTest, ChunksCanBeAddedAndRemovedInAnyOrder)
+{
+    ChunkedVoxelMap map(255, 96, 64, 96);
+    BuildTerrain(map);
+    map.SetBlock(33, 30, 33, TORCH);
+    ThreadPool       pool(2);
+    ChunkLightEngine engine(map, pool);
+    engine.SetEmission(TORCH, 14);
+
+    // Bottom chunks first, so the sky arrives late and has to push the open-sky guesses out.
+    for (int cy = 0; cy < 2; ++cy)
+        for (int cz = 0; cz < 3; ++cz)
+            for (int cx = 0; cx < 3; ++cx)
+            {
+                engine.AddChunk(Int3(cx, cy, cz));
+                if ((cx + cz) % 2 == 0)
+                    engine.Propagate();
+            }
+    engine.Propagate();
+    EXPECT_EQ(engine.ChunkCount(), 18u);
+    ExpectMatchesFullRelight(engine, map, pool);
+
+    engine.RemoveChunk(Int3(1, 0, 1));
+    engine.Propagate();
+    EXPECT_FALSE(engine.HasChunk(Int3(1, 0, 1)));
+    EXPECT_EQ(engine.BlockLight(33, 30, 33), 0);
+    EXPECT_EQ(engine.BlockLight(31, 30, 33), 0);
+
+    engine.AddChunk(Int3(1, 0, 1));
+    engine.Propagate();
+    ExpectMatchesFullRelight(engine, map, pool);
+}
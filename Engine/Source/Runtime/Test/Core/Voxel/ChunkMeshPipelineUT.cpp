@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Voxel/ChunkMeshPipeline.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    std::vector<ChunkMeshResult> Drain(ChunkMeshPipeline& pipeline, ThreadPool& pool)
+    {
+        pool.WaitIdle();
+        std::vector<ChunkMeshResult> results;
+        while (std::optional<ChunkMeshResult> result = pipeline.PopResult())
+            results.push_back(std::move(*result));
+        return results;
+    }
+
+    bool Contains(const std::vector<ChunkMeshResult>& results, const Int3& chunkPos)
+    {
+        return std::any_of(results.begin(), results.end(), [&](const ChunkMeshResult& r) { return r.ChunkPos == chunkPos; });
+    }
+} // namespace
+
+TEST(ChunkMeshPipelineTest, InteriorEditDirtiesOnlyItsChunk)
+{
+    ChunkedVoxelMap   map(255, 128, 128, 128);
+    ThreadPool        pool(2);
+    ChunkMeshPipeline pipeline(map, pool);
+
+    pipeline.SetBlock(40, 40, 40, 1);
+    EXPECT_EQ(pipeline.DirtyCount(), 1u);
+    EXPECT_EQ(pipeline.Generation(Int3(1, 1, 1)), 1u);
+    EXPECT_EQ(pipeline.Dispatch(), 1u);
+    EXPECT_EQ(pipeline.DirtyCount(), 0u);
+
+    const auto results = Drain(pipeline, pool);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_TRUE(results[0].ChunkPos == Int3(1, 1, 1));
+    EXPECT_EQ(results[0].Generation, 1u);
+    EXPECT_EQ(results[0].Mesh.QuadCount, 6u);
+    EXPECT_EQ(pipeline.JobsInFlight(), 0u);
+}
+
+TEST(ChunkMeshPipelineTest, BorderEditDirtiesNeighboursInsideTheMap)
+{
+    ChunkedVoxelMap   map(255, 128, 128, 128);
+    ThreadPool        pool(2);
+    ChunkMeshPipeline pipeline(map, pool);
+
+    // On the +X face of chunk (1,1,1): the +X neighbour's faces and AO read this voxel.
+    pipeline.SetBlock(63, 40, 40, 1);
+    EXPECT_EQ(pipeline.DirtyCount(), 2u);
+    EXPECT_EQ(pipeline.Generation(Int3(2, 1, 1)), 1u);
+
+    // On a corner: all eight chunks sharing it.
+    pipeline.SetBlock(95, 95, 95, 1);
+    EXPECT_EQ(pipeline.DirtyCount(), 2u + 8u);
+
+    // At the map origin the chunks on the negative side do not exist.
+    pipeline.SetBlock(0, 0, 0, 1);
+    EXPECT_EQ(pipeline.DirtyCount(), 2u + 8u + 1u);
+
+    pipeline.Dispatch();
+    const auto results = Drain(pipeline, pool);
+    EXPECT_EQ(results.size(), 11u);
+    EXPECT_TRUE(Contains(results, Int3(2, 1, 1)));
+    EXPECT_TRUE(Contains(results, Int3(3, 3, 3)));
+}
+
+TEST(ChunkMeshPipelineTest, ResultsOfStaleGenerationsAreDropped)
+{
+    ChunkedVoxelMap   map(255, 64, 64, 64);
+    ThreadPool        pool(1);
+    ChunkMeshPipeline pipeline(map, pool);
+
+    pipeline.SetBlock(5, 5, 5, 1);
+    pipeline.Dispatch();
+    pool.WaitIdle();
+
+    // Edited again after the first mesh finished: only the newer mesh may reach the renderer.
+    pipeline.SetBlock(6, 5, 5, 1);
+    pipeline.Dispatch();
+    const auto results = Drain(pipeline, pool);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].Generation, 2u);
+    EXPECT_EQ(results[0].Mesh.QuadCount, 6u);
+    EXPECT_EQ(pipeline.DiscardedCount(), 1u);
+}
+
+TEST(ChunkMeshPipelineTest, EditsBeforeDispatchShareOneGeneration)
+{
+    ChunkedVoxelMap   map(255, 64, 64, 64);
+    ThreadPool        pool(1);
+    ChunkMeshPipeline pipeline(map, pool);
+
+    pipeline.FillBlocks(Int3(2, 2, 2), Int3(4, 4, 4), 3);
+    pipeline.SetBlock(10, 10, 10, 3);
+    EXPECT_EQ(pipeline.DirtyCount(), 1u);
+    EXPECT_EQ(pipeline.Generation(Int3(0, 0, 0)), 1u);
+
+    EXPECT_EQ(pipeline.Dispatch(), 1u);
+    const auto results = Drain(pipeline, pool);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].Mesh.QuadCount, 12u);
+}
+
+TEST(ChunkMeshPipelineTest, ClearedChunkYieldsEmptyMesh)
+{
+    ChunkedVoxelMap   map(255, 64, 64, 64);
+    ThreadPool        pool(1);
+    ChunkMeshPipeline pipeline(map, pool);
+
+    pipeline.FillBlocks(Int3(0, 0, 0), Int3(32, 32, 32), 1);
+    pipeline.Dispatch();
+    for (const ChunkMeshResult& result : Drain(pipeline, pool))
+        EXPECT_EQ(result.Connectivity, result.ChunkPos == Int3(0, 0, 0) ? 0 : ALL_FACES_CONNECTED);
+
+    pipeline.FillBlocks(Int3(0, 0, 0), Int3(32, 32, 32), AIR_KIND);
+    EXPECT_EQ(map.GetChunk(Int3(0, 0, 0)), nullptr);
+    pipeline.Dispatch();
+
+    const auto results = Drain(pipeline, pool);
+    auto       it      = std::find_if(results.begin(), results.end(), [](const ChunkMeshResult& r) { return r.ChunkPos == Int3(0, 0, 0); });
+    ASSERT_NE(it, results.end());
+    EXPECT_EQ(it->Mesh.VertexCount, 0u);
+    EXPECT_EQ(it->Connectivity, ALL_FACES_CONNECTED);
+
+    // The cleared chunk and its empty neighbours are no longer tracked; a new edit starts over.
+    EXPECT_EQ(pipeline.Generation(Int3(0, 0, 0)), 0u);
+    EXPECT_EQ(pipeline.Generation(Int3(1, 0, 0)), 0u);
+    pipeline.SetBlock(5, 5, 5, 1);
+    EXPECT_EQ(pipeline.Generation(Int3(0, 0, 0)), 1u);
+    pipeline.Dispatch();
+    const auto refilled = Drain(pipeline, pool);
+    ASSERT_EQ(refilled.size(), 1u);
+    EXPECT_EQ(refilled[0].Mesh.QuadCount, 6u);
+}
+
+TEST(ChunkMeshPipelineTest, MapEditsAfterDispatchDoNotReachRunningJobs)
+{
+    ChunkedVoxelMap   map(255, 256, 64, 256);
+    ThreadPool        pool(4);
+    ChunkMeshPipeline pipeline(map, pool);
+
+    // Jobs mesh snapshots: the map is rewritten while they run, and every mesh that comes out
+    // matches the state at its dispatch.
+    pipeline.FillBlocks(Int3(0, 0, 0), Int3(256, 16, 256), 2);
+    const std::size_t started = pipeline.Dispatch();
+    map.FillBlocks(Int3(0, 0, 0), Int3(256, 16, 256), 5);
+
+    const auto results = Drain(pipeline, pool);
+    EXPECT_EQ(results.size(), started);
+    for (const ChunkMeshResult& result : results)
+    {
+        std::vector<PackedVoxelVertex> vertices(result.Mesh.VertexCount);
+        std::memcpy(vertices.data(), result.Mesh.Vertices.data(), result.Mesh.Vertices.size());
+        for (const PackedVoxelVertex& vertex : vertices)
+            EXPECT_EQ(vertex.Kind(), 2);
+    }
+}
+
+TEST(ChunkMeshPipelineTest, MeshesCarryTheLightOfTheEngine)
+{
+    ChunkedVoxelMap   map(255, 64, 64, 64);
+    ThreadPool        pool(2);
+    ChunkLightEngine  light(map, pool);
+    ChunkMeshPipeline pipeline(map, pool, &light);
+    for (int cy = 0; cy < 2; ++cy)
+        for (int cz = 0; cz < 2; ++cz)
+            for (int cx = 0; cx < 2; ++cx)
+                light.AddChunk(Int3(cx, cy, cz));
+
+    auto topFaceSkyLight = [&]() {
+        light.Propagate();
+        for (const Int3& chunkPos : light.TakeChangedChunks())
+            pipeline.MarkLightDirty(chunkPos);
+        pipeline.Dispatch();
+        int sky = -1;
+        for (const ChunkMeshResult& result : Drain(pipeline, pool))
+        {
+            if (!(result.ChunkPos == Int3(1, 0, 1)))
+                continue;
+            std::vector<PackedVoxelVertex> vertices(result.Mesh.VertexCount);
+            std::memcpy(vertices.data(), result.Mesh.Vertices.data(), result.Mesh.Vertices.size());
+            for (const PackedVoxelVertex& vertex : vertices)
+            {
+                if (vertex.Face() == BlockFace::PositiveY && vertex.Y() == 11)
+                    sky = vertex.SkyLight();
+            }
+        }
+        return sky;
+    };
+
+    pipeline.SetBlock(40, 10, 40, 1);
+    light.OnBlockChanged(40, 10, 40, AIR_KIND);
+    EXPECT_EQ(topFaceSkyLight(), 15);
+
+    // A roof over the chunk: the voxel above the block is now nine steps from open sky.
+    pipeline.FillBlocks(Int3(32, 20, 32), Int3(32, 1, 32), 1);
+    for (int z = 32; z < 64; ++z)
+        for (int x = 32; x < 64; ++x)
+            light.OnBlockChanged(x, 20, z, AIR_KIND);
+    EXPECT_EQ(topFaceSkyLight(), 6);
+}
+
+TEST(ChunkMeshPipelineTest, DispatchUpdatesTheDistanceFieldWithoutWaiting)
+{
+    ChunkedVoxelMap    map(255, 64, 64, 64);
+    ThreadPool         pool(2);
+    ChunkDistanceField field(map);
+    ChunkMeshPipeline  pipeline(map, pool, nullptr, &field);
+    field.Rebuild();
+    EXPECT_EQ(field.Distance(40, 10, 40), ChunkDistanceField::MAX_DISTANCE);
+
+    // The edit lies in chunk (1, 0, 1), but the field of chunk (0, 0, 1) feels it too. The
+    // fields are computed on the pool and only show up at the next Dispatch().
+    pipeline.SetBlock(33, 10, 40, 1);
+    EXPECT_GT(field.PendingCount(), 1u);
+    pipeline.Dispatch();
+    EXPECT_EQ(field.PendingCount(), 0u);
+    Drain(pipeline, pool);
+    EXPECT_EQ(field.JobsInFlight(), 0u);
+    EXPECT_EQ(field.Distance(33, 10, 40), ChunkDistanceField::MAX_DISTANCE);
+    pipeline.Dispatch();
+    EXPECT_FLOAT_EQ(field.Distance(33, 10, 40), 0.0f);
+    EXPECT_FLOAT_EQ(field.Distance(30, 10, 40), 3.0f);
+
+    pipeline.FillBlocks(Int3(32, 0, 32), Int3(32, 32, 32), AIR_KIND);
+    map.SetBlock(5, 5, 5, 1);
+    pipeline.MarkChunkDirty(Int3(0, 0, 0));
+    pipeline.Dispatch();
+    Drain(pipeline, pool);
+    pipeline.Dispatch();
+    EXPECT_EQ(field.Distance(30, 10, 40), ChunkDistanceField::MAX_DISTANCE);
+    EXPECT_FLOAT_EQ(field.Distance(5, 5, 8), 3.0f);
+    Drain(pipeline, pool);
+}
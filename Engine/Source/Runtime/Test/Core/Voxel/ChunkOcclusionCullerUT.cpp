@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Math/MathUtility.h"
+#include "Math/Vector4F.h"
+#include "Voxel/ChunkOcclusionCuller.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    Matrix4F ViewProjection(const Vector3F& eye, const Vector3F& target, float fovy = VOXIUM_FLOAT_PI / 2.0f)
+    {
+        const Matrix4F view       = Matrix4F::CreateLookAt(eye, target, Vector3F(0.0f, 1.0f, 0.0f));
+        const Matrix4F projection = Matrix4F::CreatePerspectiveFieldOfView(fovy, 2.0f, 0.1f, 1000.0f);
+        return view * projection;
+    }
+
+    // The same test straight on the full-resolution buffer: occluded when every pixel the
+    // screen rectangle touches holds a nearer occluder than the nearest corner.
+    bool OccludedPerPixel(const ChunkOcclusionCuller& culler, const Matrix4F& viewProjection, const Vector3F& min, const Vector3F& max)
+    {
+        float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY, nearest = 0.0f;
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const Vector4F v = Vector4F(corner & 1 ? max.X : min.X, corner & 2 ? max.Y : min.Y, corner & 4 ? max.Z : min.Z, 1.0f) * viewProjection;
+            if (v.Z + v.W < 0.0f)
+                return false;
+            const float x = (v.X / v.W * 0.5f + 0.5f) * culler.Width();
+            const float y = (0.5f - v.Y / v.W * 0.5f) * culler.Height();
+            minX          = std::min(minX, x);
+            maxX          = std::max(maxX, x);
+            minY          = std::min(minY, y);
+            maxY          = std::max(maxY, y);
+            nearest       = std::max(nearest, 1.0f / v.W);
+        }
+        const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+        const int x1 = std::min(culler.Width() - 1, static_cast<int>(std::floor(maxX)));
+        const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+        const int y1 = std::min(culler.Height() - 1, static_cast<int>(std::floor(maxY)));
+        if (x0 > x1 || y0 > y1)
+            return false;
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                if (nearest >= culler.InverseDepth(x, y))
+                    return false;
+        return true;
+    }
+} // namespace
+
+TEST(ChunkOcclusionCullerTest, WallHidesWhatIsBehindIt)
+{
+    const Vector3F       eye(0.0f, 16.0f, 100.0f);
+    ChunkOcclusionCuller culler;
+    culler.Begin(ViewProjection(eye, Vector3F(0.0f, 16.0f, 0.0f)), eye);
+    culler.AddOccluder(Vector3F(-20.0f, -20.0f, 40.0f), Vector3F(20.0f, 40.0f, 48.0f));
+    culler.Finish();
+    EXPECT_EQ(culler.OccludersDrawn(), 1u);
+
+    // Only the face towards the eye is drawn, 52 units away.
+    EXPECT_NEAR(culler.InverseDepth(culler.Width() / 2, culler.Height() / 2), 1.0f / 52.0f, 1e-5f);
+    EXPECT_EQ(culler.InverseDepth(0, 0), 0.0f);
+
+    EXPECT_FALSE(culler.IsVisible(Vector3F(-8.0f, 0.0f, -16.0f), Vector3F(8.0f, 16.0f, 0.0f)));
+    EXPECT_FALSE(culler.IsVisible(Vector3F(25.0f, 0.0f, -10.0f), Vector3F(30.0f, 16.0f, 0.0f)));
+    EXPECT_TRUE(culler.IsVisible(Vector3F(40.0f, 0.0f, -16.0f), Vector3F(48.0f, 16.0f, 0.0f)));
+    EXPECT_TRUE(culler.IsVisible(Vector3F(-8.0f, 0.0f, 60.0f), Vector3F(8.0f, 16.0f, 70.0f)));
+
+    // Boxes around or behind the eye are never hidden.
+    EXPECT_TRUE(culler.IsVisible(Vector3F(-1.0f, 15.0f, 99.0f), Vector3F(1.0f, 17.0f, 101.0f)));
+    EXPECT_TRUE(culler.IsVisible(Vector3F(-1.0f, 15.0f, 120.0f), Vector3F(1.0f, 17.0f, 130.0f)));
+
+    EXPECT_THROW(ChunkOcclusionCuller(100, 64), std::invalid_argument);
+    EXPECT_THROW(ChunkOcclusionCuller(64, 64, 0), std::invalid_argument);
+}
+
+TEST(ChunkOcclusionCullerTest, GroundCrossingTheNearPlaneStillOccludes)
+{
+    // Standing on a wide floor and looking along it: its top face reaches behind the eye.
+    const Vector3F       eye(0.0f, 2.0f, 0.0f);
+    ChunkOcclusionCuller culler;
+    culler.Begin(ViewProjection(eye, Vector3F(0.0f, 1.0f, -100.0f)), eye);
+    culler.AddOccluder(Vector3F(-500.0f, -64.0f, -500.0f), Vector3F(500.0f, 0.0f, 500.0f));
+    culler.Finish();
+
+    EXPECT_FALSE(culler.IsVisible(Vector3F(-16.0f, -40.0f, -80.0f), Vector3F(16.0f, -24.0f, -48.0f)));
+    EXPECT_FALSE(culler.IsChunkVisible(Int3(2, -2, -4)));
+    EXPECT_TRUE(culler.IsVisible(Vector3F(-16.0f, -4.0f, -80.0f), Vector3F(16.0f, 4.0f, -48.0f)));
+    EXPECT_TRUE(culler.IsChunkVisible(Int3(0, 0, -3)));
+}
+
+TEST(ChunkOcclusionCullerTest, PyramidAgreesWithFullResolutionTest)
+{
+    std::mt19937                          rng(8);
+    std::uniform_real_distribution<float> position(-200.0f, 200.0f), size(2.0f, 60.0f);
+    const Vector3F                        eye(0.0f, 0.0f, 250.0f);
+    const Matrix4F                        viewProjection = ViewProjection(eye, Vector3F(0.0f, 0.0f, 0.0f), VOXIUM_FLOAT_PI / 3.0f);
+
+    ChunkOcclusionCuller culler(128, 64, 64);
+    culler.Begin(viewProjection, eye);
+    for (int i = 0; i < 100; ++i)
+    {
+        const Vector3F min(position(rng), position(rng) * 0.5f, position(rng) * 0.3f + 60.0f);
+        culler.AddOccluder(min, min + Vector3F(size(rng) * 2.0f, size(rng), size(rng)));
+    }
+    culler.Finish();
+    EXPECT_EQ(culler.OccludersDrawn(), 64u);
+
+    // The pyramid may keep a box the pixels would hide, never the other way round.
+    int hidden = 0, kept = 0;
+    for (int i = 0; i < 4000; ++i)
+    {
+        const Vector3F min(position(rng), position(rng) * 0.5f, position(rng) * 0.5f - 150.0f);
+        const Vector3F max = min + Vector3F(size(rng) * 0.3f);
+        const bool     perPixel = OccludedPerPixel(culler, viewProjection, min, max);
+        if (!culler.IsVisible(min, max))
+        {
+            EXPECT_TRUE(perPixel) << i;
+            ++hidden;
+        }
+        else if (perPixel)
+            ++kept;
+    }
+    EXPECT_GT(hidden, 400);
+    EXPECT_LT(kept, hidden / 2);
+}
+
+TEST(ChunkOcclusionCullerTest, FiltersFrustumCullerOutput)
+{
+    // A cave: the eye inside an empty chunk, every chunk around it solid rock.
+    const Vector3F       eye(48.0f, 48.0f, 48.0f);
+    const Matrix4F       viewProjection = ViewProjection(eye, Vector3F(48.0f, 48.0f, 0.0f));
+    ChunkFrustumCuller   boxes;
+    ChunkOcclusionCuller culler(128, 64, 26);
+    culler.Begin(viewProjection, eye);
+    uint32_t id = 0;
+    for (int cy = 0; cy < 3; ++cy)
+        for (int cz = -4; cz < 3; ++cz)
+            for (int cx = 0; cx < 3; ++cx)
+            {
+                boxes.SetChunk(id++, Int3(cx, cy, cz));
+                if (!(cx == 1 && cy == 1 && cz == 1))
+                    culler.AddChunkOccluder(Int3(cx, cy, cz));
+            }
+    culler.Finish();
+
+    std::vector<uint32_t> visible;
+    boxes.Cull(viewProjection, visible);
+    const std::size_t inFrustum = visible.size();
+    culler.Filter(visible, boxes);
+    // Left: the 3x3 layer the eye is in and the 3x3 wall ahead of it.
+    EXPECT_GT(inFrustum, 40u);
+    EXPECT_EQ(visible.size(), 18u);
+    EXPECT_TRUE(std::is_sorted(visible.begin(), visible.end()));
+
+    // The chunk straight ahead beyond the wall is gone, the wall itself is not.
+    Vector3F min(0.0f), max(0.0f);
+    for (uint32_t kept : visible)
+    {
+        boxes.Bounds(kept, min, max);
+        EXPECT_GE(min.Z, 0.0f);
+    }
+    EXPECT_FALSE(culler.IsChunkVisible(Int3(1, 1, -1)));
+    EXPECT_TRUE(culler.IsChunkVisible(Int3(1, 1, 0)));
+
+    VoxelChunk rock(1);
+    EXPECT_TRUE(ChunkOcclusionCuller::IsOpaque(rock));
+    rock.Set(3, 4, 5, AIR_KIND);
+    EXPECT_FALSE(ChunkOcclusionCuller::IsOpaque(rock));
+}
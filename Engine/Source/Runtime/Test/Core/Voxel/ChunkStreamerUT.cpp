@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Voxel/ChunkStreamer.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    constexpr int WORLD_CHUNKS = 24;
+    constexpr int WORLD_SIZE   = WORLD_CHUNKS * CHUNK_SIZE;
+    constexpr int WORLD_HEIGHT = 2 * CHUNK_SIZE;
+
+    // Only the bottom layer is stored; each chunk is marked with its column.
+    class StoredWorld
+    {
+    public:
+        bool Load(const Int3& chunkPos, VoxelChunk& chunk) const
+        {
+            if (chunkPos.Y != 0)
+                return false;
+            chunk = VoxelChunk(Marker(chunkPos));
+            return true;
+        }
+
+        static BlockKind Marker(const Int3& chunkPos) { return static_cast<BlockKind>(1 + chunkPos.X + chunkPos.Z * WORLD_CHUNKS); }
+    };
+
+    Vector3F ColumnCentre(int x, int z) { return Vector3F((x + 0.5f) * CHUNK_SIZE, 10.0f, (z + 0.5f) * CHUNK_SIZE); }
+
+    int ColumnsWithin(int radius)
+    {
+        int columns = 0;
+        for (int dz = -radius; dz <= radius; ++dz)
+            for (int dx = -radius; dx <= radius; ++dx)
+                columns += dx * dx + dz * dz <= radius * radius;
+        return columns;
+    }
+
+    // Updates with the pool drained in between, so every load started by one Update is ready for the next.
+    void Settle(ChunkStreamer& streamer, ThreadPool& pool, const Vector3F& position, const Vector3F& forward, std::vector<Int3>* published = nullptr)
+    {
+        do
+        {
+            pool.WaitIdle();
+            streamer.Update(position, forward);
+            if (published != nullptr)
+                published->insert(published->end(), streamer.Published().begin(), streamer.Published().end());
+        } while (streamer.LoadsInFlight() > 0 || streamer.PendingCount() > 0);
+    }
+} // namespace
+
+TEST(ChunkStreamerTest, LoadsNearestChunksInFrontFirst)
+{
+    ChunkedVoxelMap       map(65535, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    ThreadPool            pool(2);
+    StoredWorld           world;
+    ChunkStreamerSettings settings;
+    settings.ViewRadius       = 3;
+    settings.MaxLoadsInFlight = 1;
+    ChunkStreamer streamer(map, pool, [&](const Int3& chunkPos, VoxelChunk& chunk) { return world.Load(chunkPos, chunk); }, settings);
+
+    std::vector<Int3> order;
+    Settle(streamer, pool, ColumnCentre(10, 10), Vector3F(1.0f, 0.0f, 0.0f), &order);
+
+    // Both layers are resident, but only the stored one was published.
+    EXPECT_EQ(streamer.ResidentCount(), 2u * ColumnsWithin(3));
+    ASSERT_EQ(order.size(), static_cast<std::size_t>(ColumnsWithin(3)));
+    EXPECT_TRUE(order.front() == Int3(10, 0, 10));
+    EXPECT_EQ(map.GetBlock(13 * CHUNK_SIZE, 0, 10 * CHUNK_SIZE), StoredWorld::Marker(Int3(13, 0, 10)));
+
+    auto rank = [&](int x, int z) { return std::find_if(order.begin(), order.end(), [&](const Int3& p) { return p == Int3(x, 0, z); }) - order.begin(); };
+    EXPECT_LT(rank(13, 10), rank(7, 10));
+    EXPECT_LT(rank(12, 11), rank(8, 11));
+    EXPECT_LT(rank(11, 10), rank(13, 10));
+    EXPECT_TRUE(streamer.IsResident(Int3(7, 1, 10)));
+    EXPECT_FALSE(streamer.IsResident(Int3(14, 0, 10)));
+}
+
+TEST(ChunkStreamerTest, PublishesWithinTheFrameBudget)
+{
+    ChunkedVoxelMap       map(65535, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    ThreadPool            pool(2);
+    StoredWorld           world;
+    ChunkStreamerSettings settings;
+    settings.ViewRadius       = 4;
+    settings.MaxLoadsInFlight = 100;
+    settings.PublishBudget    = 5;
+    ChunkStreamer streamer(map, pool, [&](const Int3& chunkPos, VoxelChunk& chunk) { return world.Load(chunkPos, chunk); }, settings);
+
+    // Loads that finished but were not published hold their slot, so at most the budget plus the
+    // slot count are ever outstanding.
+    std::size_t updates = 0;
+    do
+    {
+        pool.WaitIdle();
+        streamer.Update(ColumnCentre(12, 12), Vector3F(0.0f));
+        EXPECT_LE(streamer.Published().size(), 5u);
+        EXPECT_LE(streamer.LoadsInFlight(), 100u);
+        ++updates;
+    } while (streamer.LoadsInFlight() > 0 || streamer.PendingCount() > 0);
+
+    EXPECT_EQ(map.ChunkCount(), static_cast<std::size_t>(ColumnsWithin(4)));
+    EXPECT_GE(updates, map.ChunkCount() / 5);
+}
+
+TEST(ChunkStreamerTest, UnloadsChunksPastTheMarginFarthestFirst)
+{
+    ChunkedVoxelMap       map(65535, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    ThreadPool            pool(2);
+    StoredWorld           world;
+    ChunkStreamerSettings settings;
+    settings.ViewRadius   = 3;
+    settings.UnloadMargin = 1;
+    settings.UnloadBudget = 4;
+    ChunkStreamer streamer(map, pool, [&](const Int3& chunkPos, VoxelChunk& chunk) { return world.Load(chunkPos, chunk); }, settings);
+
+    Settle(streamer, pool, ColumnCentre(5, 5), Vector3F(0.0f));
+
+    // One column over: nothing leaves the margin yet.
+    Settle(streamer, pool, ColumnCentre(6, 5), Vector3F(0.0f));
+    EXPECT_TRUE(streamer.IsResident(Int3(2, 0, 5)));
+    EXPECT_NE(map.GetChunk(Int3(2, 0, 5)), nullptr);
+    const std::size_t loaded = map.ChunkCount();
+
+    // Far away: the old area goes, at most four chunks per update and farthest first.
+    std::vector<int> distances;
+    for (int update = 0; update < 40; ++update)
+    {
+        pool.WaitIdle();
+        streamer.Update(ColumnCentre(18, 18), Vector3F(0.0f));
+        EXPECT_LE(streamer.Unloaded().size(), 4u);
+        for (const Int3& chunkPos : streamer.Unloaded())
+            distances.push_back((chunkPos.X - 18) * (chunkPos.X - 18) + (chunkPos.Z - 18) * (chunkPos.Z - 18));
+    }
+    EXPECT_EQ(distances.size(), loaded);
+    EXPECT_TRUE(std::is_sorted(distances.rbegin(), distances.rend()));
+    EXPECT_EQ(map.GetChunk(Int3(5, 0, 5)), nullptr);
+    EXPECT_FALSE(streamer.IsResident(Int3(5, 0, 5)));
+    EXPECT_EQ(map.ChunkCount(), static_cast<std::size_t>(ColumnsWithin(3)));
+    EXPECT_EQ(streamer.ResidentCount(), 2u * ColumnsWithin(3));
+}
+
+TEST(ChunkStreamerTest, DropsLoadsThatLeftRangeAndCountsFailures)
+{
+    ChunkedVoxelMap         map(65535, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    ThreadPool              pool(2);
+    StoredWorld             world;
+    std::mutex              mutex;
+    std::condition_variable released;
+    bool                    open = false;
+    ChunkStreamerSettings   settings;
+    settings.ViewRadius = 1;
+    ChunkStreamer streamer(map, pool,
+                           [&](const Int3& chunkPos, VoxelChunk& chunk) {
+                               std::unique_lock<std::mutex> lock(mutex);
+                               released.wait(lock, [&] { return open; });
+                               if (chunkPos == Int3(20, 0, 20))
+                                   throw std::runtime_error("Corrupt region file: test");
+                               return world.Load(chunkPos, chunk);
+                           },
+                           settings);
+
+    // Loads start, then the camera leaves before any of them finishes.
+    streamer.Update(ColumnCentre(2, 2), Vector3F(0.0f));
+    EXPECT_GT(streamer.LoadsInFlight(), 0u);
+    streamer.Update(ColumnCentre(20, 20), Vector3F(0.0f));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        open = true;
+    }
+    released.notify_all();
+
+    Settle(streamer, pool, ColumnCentre(20, 20), Vector3F(0.0f));
+    EXPECT_EQ(map.GetChunk(Int3(2, 0, 2)), nullptr);
+    EXPECT_EQ(map.ChunkCount(), static_cast<std::size_t>(ColumnsWithin(1) - 1));
+    EXPECT_EQ(streamer.FailedCount(), 1u);
+    EXPECT_TRUE(streamer.IsResident(Int3(20, 0, 20)));
+    EXPECT_EQ(streamer.LoadsInFlight(), 0u);
+}
+
+TEST(ChunkStreamerTest, SavesModifiedChunksSoEditsSurviveUnloading)
+{
+    ChunkedVoxelMap       map(65535, WORLD_SIZE, WORLD_HEIGHT, WORLD_SIZE);
+    ThreadPool            pool(2);
+    StoredWorld           world;
+    std::mutex            mutex;
+    ChunkStreamerSettings settings;
+    settings.ViewRadius   = 2;
+    settings.UnloadMargin = 1;
+
+    // Saved chunks shadow the stored world; a saved nullptr stands for a chunk of air.
+    std::unordered_map<Int3, std::shared_ptr<const VoxelChunk>, Int3Hasher> saved;
+    auto load = [&](const Int3& chunkPos, VoxelChunk& chunk) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto                        it = saved.find(chunkPos);
+        if (it == saved.end())
+            return world.Load(chunkPos, chunk);
+        if (it->second == nullptr)
+            return false;
+        chunk = *it->second;
+        return true;
+    };
+
+    ChunkStreamer streamer(map, pool, load, settings);
+    streamer.SetSaver([&](const Int3& chunkPos, std::shared_ptr<const VoxelChunk> chunk) {
+        std::lock_guard<std::mutex> lock(mutex);
+        saved[chunkPos] = std::move(chunk);
+    });
+
+    Settle(streamer, pool, ColumnCentre(4, 4), Vector3F(0.0f));
+    map.SetBlock(4 * CHUNK_SIZE + 3, 40, 4 * CHUNK_SIZE + 5, 7);
+    streamer.MarkModified(Int3(4, 1, 4));
+    map.SetBlock(5 * CHUNK_SIZE, 0, 4 * CHUNK_SIZE, 9);
+    streamer.MarkModified(Int3(5, 0, 4));
+
+    // Far away and back: only the edited chunks were saved, and the reloads bring the edits back.
+    Settle(streamer, pool, ColumnCentre(18, 18), Vector3F(0.0f));
+    EXPECT_EQ(map.GetChunk(Int3(4, 1, 4)), nullptr);
+    EXPECT_EQ(streamer.SavedCount(), 2u);
+    EXPECT_EQ(saved.size(), 2u);
+
+    Settle(streamer, pool, ColumnCentre(4, 4), Vector3F(0.0f));
+    EXPECT_EQ(map.GetBlock(4 * CHUNK_SIZE + 3, 40, 4 * CHUNK_SIZE + 5), 7);
+    EXPECT_EQ(map.GetBlock(5 * CHUNK_SIZE, 0, 4 * CHUNK_SIZE), 9);
+    EXPECT_EQ(map.GetBlock(5 * CHUNK_SIZE + 1, 0, 4 * CHUNK_SIZE), StoredWorld::Marker(Int3(5, 0, 4)));
+
+    // The reloaded chunks are unmodified until edited again; SaveModified() saves the rest.
+    map.SetBlock(4 * CHUNK_SIZE, 0, 4 * CHUNK_SIZE, AIR_KIND);
+    streamer.MarkModified(Int3(4, 0, 4));
+    streamer.MarkModified(Int3(30, 0, 30));
+    EXPECT_EQ(streamer.SaveModified(), 1u);
+    EXPECT_EQ(streamer.SaveModified(), 0u);
+    EXPECT_EQ(streamer.SavedCount(), 3u);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Math/MathUtility.h"
+#include "Math/Matrix4F.h"
+#include "Voxel/ChunkVisibilityGraph.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    constexpr BlockKind STONE = 1;
+
+    // Voxel by voxel flood fill from every face cell, for comparison.
+    ChunkConnectivity ConnectivityByVoxels(const VoxelChunk& chunk)
+    {
+        std::vector<int>  region(CHUNK_VOLUME, -1);
+        std::vector<int>  stack;
+        ChunkConnectivity connectivity = 0;
+        for (int start = 0; start < CHUNK_VOLUME; ++start)
+        {
+            if (chunk.Get(start) != AIR_KIND || region[start] >= 0)
+                continue;
+            int faces     = 0;
+            region[start] = start;
+            stack.assign(1, start);
+            while (!stack.empty())
+            {
+                const int index = stack.back();
+                stack.pop_back();
+                const int x = index & CHUNK_MASK, z = (index >> CHUNK_SHIFT) & CHUNK_MASK, y = index >> (2 * CHUNK_SHIFT);
+                for (int face = 0; face < BLOCK_FACE_COUNT; ++face)
+                {
+                    const Int3 n = Int3(x, y, z) + FaceNormal(static_cast<BlockFace>(face));
+                    if (n.X < 0 || n.Y < 0 || n.Z < 0 || n.X >= CHUNK_SIZE || n.Y >= CHUNK_SIZE || n.Z >= CHUNK_SIZE)
+                    {
+                        faces |= 1 << face;
+                        continue;
+                    }
+                    const int next = ChunkIndex(n.X, n.Y, n.Z);
+                    if (chunk.Get(next) == AIR_KIND && region[next] < 0)
+                    {
+                        region[next] = start;
+                        stack.push_back(next);
+                    }
+                }
+            }
+            for (int a = 0; a < BLOCK_FACE_COUNT; ++a)
+                for (int b = a + 1; b < BLOCK_FACE_COUNT; ++b)
+                    if ((faces >> a & 1) && (faces >> b & 1))
+                        connectivity |= static_cast<ChunkConnectivity>(1u << FacePairBit(static_cast<BlockFace>(a), static_cast<BlockFace>(b)));
+        }
+        return connectivity;
+    }
+
+    bool Contains(const std::vector<Int3>& chunks, const Int3& chunkPos)
+    {
+        return std::any_of(chunks.begin(), chunks.end(), [&](const Int3& c) { return c == chunkPos; });
+    }
+} // namespace
+
+TEST(ChunkVisibilityGraphTest, ConnectivityFollowsTheAir)
+{
+    int used = 0;
+    for (int a = 0; a < BLOCK_FACE_COUNT; ++a)
+        for (int b = 0; b < BLOCK_FACE_COUNT; ++b)
+            if (a != b)
+            {
+                const int bit = FacePairBit(static_cast<BlockFace>(a), static_cast<BlockFace>(b));
+                EXPECT_EQ(bit, FacePairBit(static_cast<BlockFace>(b), static_cast<BlockFace>(a)));
+                used |= 1 << bit;
+            }
+    EXPECT_EQ(used, ALL_FACES_CONNECTED);
+
+    EXPECT_EQ(ChunkVisibilityGraph::ComputeConnectivity(VoxelChunk()), ALL_FACES_CONNECTED);
+    EXPECT_EQ(ChunkVisibilityGraph::ComputeConnectivity(VoxelChunk(STONE)), 0);
+
+    // A straight tunnel along X, and one that bends up.
+    VoxelChunk tunnel(STONE);
+    tunnel.FillBox(0, 5, 5, 32, 7, 7, AIR_KIND);
+    const ChunkConnectivity straight = ChunkVisibilityGraph::ComputeConnectivity(tunnel);
+    EXPECT_EQ(straight, 1 << FacePairBit(BlockFace::PositiveX, BlockFace::NegativeX));
+    tunnel.FillBox(0, 20, 20, 10, 21, 21, AIR_KIND);
+    tunnel.FillBox(9, 20, 20, 10, 32, 21, AIR_KIND);
+    const ChunkConnectivity bent = ChunkVisibilityGraph::ComputeConnectivity(tunnel);
+    EXPECT_TRUE(FacesConnected(bent, BlockFace::NegativeX, BlockFace::PositiveY));
+    EXPECT_FALSE(FacesConnected(bent, BlockFace::PositiveX, BlockFace::PositiveY));
+    EXPECT_TRUE(FacesConnected(bent, BlockFace::PositiveZ, BlockFace::PositiveZ));
+
+    // A wall across the chunk: each side connects its five faces, never the other side's.
+    VoxelChunk wall;
+    wall.FillBox(16, 0, 0, 17, 32, 32, STONE);
+    const ChunkConnectivity split = ChunkVisibilityGraph::ComputeConnectivity(wall);
+    EXPECT_FALSE(FacesConnected(split, BlockFace::PositiveX, BlockFace::NegativeX));
+    EXPECT_TRUE(FacesConnected(split, BlockFace::PositiveY, BlockFace::NegativeY));
+    EXPECT_TRUE(FacesConnected(split, BlockFace::NegativeX, BlockFace::PositiveZ));
+    EXPECT_EQ(std::popcount(static_cast<unsigned>(split)), 14);
+
+    // Random caves, some open and some closed off.
+    std::mt19937 rng(16);
+    for (int round = 0; round < 40; ++round)
+    {
+        VoxelChunk                         cave(STONE);
+        std::uniform_int_distribution<int> position(0, 31), length(1, 12);
+        const int                          holes = round * 4;
+        for (int i = 0; i < holes; ++i)
+        {
+            const int x = position(rng), y = position(rng), z = position(rng);
+            cave.FillBox(x, y, z, std::min(32, x + length(rng)), std::min(32, y + 1 + length(rng) / 3), std::min(32, z + 1 + length(rng) / 3), AIR_KIND);
+        }
+        EXPECT_EQ(ChunkVisibilityGraph::ComputeConnectivity(cave), ConnectivityByVoxels(cave)) << "round " << round;
+    }
+}
+
+TEST(ChunkVisibilityGraphTest, TraversalStaysInTheCave)
+{
+    // Rock, a tunnel along X through chunk row y = 2, z = 4, and a shaft up at x = 6.
+    ChunkedVoxelMap map(255, 512, 256, 256);
+    map.FillBlocks(Int3(0, 0, 0), Int3(512, 192, 256), STONE);
+    map.FillBlocks(Int3(0, 80, 140), Int3(512, 8, 8), AIR_KIND);
+    map.FillBlocks(Int3(200, 80, 140), Int3(8, 112, 8), AIR_KIND);
+
+    ChunkVisibilityGraph graph;
+    map.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk&) { graph.Update(map, chunkPos); });
+    EXPECT_EQ(graph.Size(), map.ChunkCount());
+
+    const Vector3F eye(40.0f, 84.0f, 144.0f);
+    const Matrix4F view       = Matrix4F::CreateLookAt(eye, eye + Vector3F(1.0f, 0.0f, 0.0f), Vector3F(0.0f, 1.0f, 0.0f));
+    const Frustum  frustum(view * Matrix4F::CreatePerspectiveFieldOfView(VOXIUM_FLOAT_PI / 2.0f, 16.0f / 9.0f, 0.1f, 2048.0f));
+
+    std::vector<Int3> visible;
+    graph.Traverse(eye, frustum, 32, visible);
+    ASSERT_FALSE(visible.empty());
+    EXPECT_TRUE(visible[0] == Int3(1, 2, 4));
+
+    // Down the tunnel and up the shaft, but not into the rock around them: the tunnel walls are
+    // faces of the tunnel chunks.
+    EXPECT_TRUE(Contains(visible, Int3(15, 2, 4)));
+    EXPECT_TRUE(Contains(visible, Int3(6, 4, 4)));
+    EXPECT_TRUE(Contains(visible, Int3(6, 5, 4)));
+    EXPECT_FALSE(Contains(visible, Int3(8, 3, 4)));
+    EXPECT_FALSE(Contains(visible, Int3(8, 2, 6)));
+    EXPECT_FALSE(Contains(visible, Int3(0, 2, 4)));
+    std::size_t inFrustum = 0;
+    map.ForEachChunk([&](const Int3& chunkPos, const VoxelChunk&) {
+        const Vector3F min(ChunkBoundsMin(chunkPos));
+        inFrustum += frustum.Intersects(min, min + Vector3F(static_cast<float>(CHUNK_SIZE)));
+    });
+    EXPECT_LT(visible.size() * 4, inFrustum);
+    for (const Int3& chunkPos : visible)
+        EXPECT_LE(std::abs(chunkPos.X - 1), 32);
+
+    // Removing the entries opens everything up to the distance limit.
+    graph.Clear();
+    graph.Set(Int3(3, 2, 4), 0);
+    graph.Traverse(eye, frustum, 4, visible);
+    ASSERT_EQ(visible.size(), 1u);
+    EXPECT_TRUE(visible[0] == Int3(3, 2, 4));
+    EXPECT_THROW(graph.Traverse(eye, frustum, -1, visible), std::invalid_argument);
+}
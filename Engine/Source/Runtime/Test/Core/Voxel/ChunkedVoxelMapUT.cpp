@@ -0,0 +1,342 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Voxel/ChunkedVoxelMap.h"
+
+using namespace Voxium::Core;
+
+TEST(VoxelChunkTest, StartsUniform)
+{
+    VoxelChunk chunk;
+    EXPECT_TRUE(chunk.IsUniform());
+    EXPECT_EQ(chunk.BitsPerIndex(), 0);
+    EXPECT_EQ(chunk.Get(5, 6, 7), AIR_KIND);
+}
+
+TEST(VoxelChunkTest, WidensIndicesAsPaletteGrows)
+{
+    VoxelChunk chunk;
+    chunk.Set(0, 0, 0, 1);
+    EXPECT_EQ(chunk.BitsPerIndex(), 1);
+
+    chunk.Set(1, 0, 0, 2);
+    EXPECT_EQ(chunk.BitsPerIndex(), 2);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        chunk.Set(i, 1, 0, static_cast<BlockKind>(100 + i));
+    }
+    EXPECT_EQ(chunk.BitsPerIndex(), 8);
+
+    for (int i = 0; i < 300; ++i)
+    {
+        chunk.Set(i % CHUNK_SIZE, 2 + i / CHUNK_SIZE, 0, static_cast<BlockKind>(1000 + i));
+    }
+    EXPECT_EQ(chunk.BitsPerIndex(), 16);
+
+    EXPECT_EQ(chunk.Get(0, 0, 0), 1);
+    EXPECT_EQ(chunk.Get(1, 0, 0), 2);
+    for (int i = 0; i < 20; ++i)
+    {
+        EXPECT_EQ(chunk.Get(i, 1, 0), 100 + i);
+    }
+    for (int i = 0; i < 300; ++i)
+    {
+        EXPECT_EQ(chunk.Get(i % CHUNK_SIZE, 2 + i / CHUNK_SIZE, 0), 1000 + i);
+    }
+    EXPECT_EQ(chunk.Get(31, 31, 31), AIR_KIND);
+}
+
+TEST(VoxelChunkTest, CompactDropsUnusedEntries)
+{
+    VoxelChunk chunk;
+    for (int i = 0; i < 10; ++i)
+    {
+        chunk.Set(i, 0, 0, static_cast<BlockKind>(i + 1));
+    }
+    EXPECT_EQ(chunk.BitsPerIndex(), 4);
+
+    for (int i = 2; i < 10; ++i)
+    {
+        chunk.Set(i, 0, 0, AIR_KIND);
+    }
+    chunk.Compact();
+    EXPECT_EQ(chunk.Palette().size(), 3u);
+    EXPECT_EQ(chunk.BitsPerIndex(), 2);
+    EXPECT_EQ(chunk.Get(0, 0, 0), 1);
+    EXPECT_EQ(chunk.Get(1, 0, 0), 2);
+    EXPECT_EQ(chunk.Get(2, 0, 0), AIR_KIND);
+
+    chunk.Set(0, 0, 0, AIR_KIND);
+    chunk.Set(1, 0, 0, AIR_KIND);
+    chunk.Compact();
+    EXPECT_TRUE(chunk.IsUniform());
+    EXPECT_EQ(chunk.MemoryUsage(), sizeof(BlockKind));
+}
+
+TEST(VoxelChunkTest, OccupancyFollowsWrites)
+{
+    auto expectOccupancy = [](const VoxelChunk& chunk) {
+        int      solid    = 0;
+        uint64_t occupied = 0;
+        uint64_t full     = ~uint64_t {0};
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                {
+                    const uint64_t bit = uint64_t {1} << VoxelChunk::BrickIndex(x, y, z);
+                    if (chunk.Get(x, y, z) != AIR_KIND)
+                    {
+                        ++solid;
+                        occupied |= bit;
+                    }
+                    else
+                    {
+                        full &= ~bit;
+                    }
+                }
+        EXPECT_EQ(chunk.SolidCount(), solid);
+        EXPECT_EQ(chunk.IsEmpty(), solid == 0);
+        EXPECT_EQ(chunk.IsFull(), solid == CHUNK_VOLUME);
+        EXPECT_EQ(chunk.OccupiedBricks(), occupied);
+        EXPECT_EQ(chunk.FullBricks(), full);
+    };
+
+    VoxelChunk chunk;
+    expectOccupancy(chunk);
+    EXPECT_TRUE(chunk.IsEmpty());
+    expectOccupancy(VoxelChunk(3));
+    EXPECT_TRUE(VoxelChunk(3).IsFull());
+
+    std::mt19937 random(18);
+    for (int round = 0; round < 40; ++round)
+    {
+        const int       x    = static_cast<int>(random() % CHUNK_SIZE);
+        const int       y    = static_cast<int>(random() % CHUNK_SIZE);
+        const int       z    = static_cast<int>(random() % CHUNK_SIZE);
+        const BlockKind kind = static_cast<BlockKind>(random() % 3);
+        switch (round % 4)
+        {
+            case 0:
+                chunk.Set(x, y, z, kind);
+                break;
+            case 1:
+            {
+                const std::vector<BlockKind> run = {kind, AIR_KIND, 2, kind};
+                chunk.SetRun(ChunkIndex(std::min(x, CHUNK_SIZE - 4), y, z), run);
+                break;
+            }
+            default:
+                chunk.FillBox(x / 2, y / 2, z / 2, x, y, z, kind);
+                break;
+        }
+        expectOccupancy(chunk);
+    }
+
+    // An emptied chunk is empty before being compacted, and a rebuilt one keeps the summary.
+    chunk.FillBox(0, 0, 0, CHUNK_SIZE, CHUNK_SIZE, 8, 1);
+    chunk.FillBox(0, 0, 8, CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE, AIR_KIND);
+    expectOccupancy(chunk);
+    expectOccupancy(VoxelChunk::FromPacked(chunk.Palette(), chunk.BitsPerIndex(), chunk.PackedIndices()));
+    chunk.FillBox(0, 0, 0, CHUNK_SIZE, CHUNK_SIZE, 8, AIR_KIND);
+    EXPECT_FALSE(chunk.IsUniform());
+    EXPECT_TRUE(chunk.IsEmpty());
+    EXPECT_EQ(chunk.OccupiedBricks(), 0u);
+    chunk.Fill(2);
+    expectOccupancy(chunk);
+}
+
+TEST(VoxelChunkTest, UnpacksAndRebuildsInBothLayouts)
+{
+    static_assert(ChunkMortonIndex(1, 0, 0) == 1 && ChunkMortonIndex(0, 0, 1) == 2 && ChunkMortonIndex(0, 1, 0) == 4);
+    static_assert(ChunkMortonIndex(CHUNK_MASK, CHUNK_MASK, CHUNK_MASK) == CHUNK_VOLUME - 1);
+
+    VoxelChunk   chunk;
+    std::mt19937 random(19);
+    for (int i = 0; i < 3000; ++i)
+        chunk.Set(static_cast<int>(random() % CHUNK_VOLUME), static_cast<BlockKind>(random() % 5));
+
+    std::vector<BlockKind> linear(CHUNK_VOLUME);
+    std::vector<BlockKind> morton(CHUNK_VOLUME);
+    chunk.Unpack(std::span<BlockKind, CHUNK_VOLUME>(linear));
+    chunk.Unpack(std::span<BlockKind, CHUNK_VOLUME>(morton), ChunkLayout::Morton);
+    for (int y = 0; y < CHUNK_SIZE; ++y)
+        for (int z = 0; z < CHUNK_SIZE; ++z)
+            for (int x = 0; x < CHUNK_SIZE; ++x)
+            {
+                ASSERT_EQ(linear[ChunkIndex(x, y, z)], chunk.Get(x, y, z));
+                ASSERT_EQ(morton[ChunkLayoutIndex(ChunkLayout::Morton, x, y, z)], chunk.Get(x, y, z));
+            }
+
+    for (ChunkLayout layout : {ChunkLayout::Linear, ChunkLayout::Morton})
+    {
+        const VoxelChunk rebuilt =
+            VoxelChunk::FromKinds(std::span<const BlockKind, CHUNK_VOLUME>(layout == ChunkLayout::Linear ? linear : morton), layout);
+        EXPECT_EQ(rebuilt.SolidCount(), chunk.SolidCount());
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+            ASSERT_EQ(rebuilt.Get(i), chunk.Get(i));
+    }
+
+    VoxelChunk(7).Unpack(std::span<BlockKind, CHUNK_VOLUME>(morton), ChunkLayout::Morton);
+    EXPECT_EQ(std::count(morton.begin(), morton.end(), 7), CHUNK_VOLUME);
+    EXPECT_TRUE(VoxelChunk::FromKinds(std::span<const BlockKind, CHUNK_VOLUME>(morton), ChunkLayout::Morton).IsUniform());
+}
+
+TEST(VoxelChunkTest, CopiesShareStorageUntilWritten)
+{
+    VoxelChunk chunk;
+    chunk.FillBox(0, 0, 0, CHUNK_SIZE, 4, CHUNK_SIZE, 1);
+    chunk.Set(3, 10, 3, 2);
+
+    // Every kind of write leaves an earlier copy as it was.
+    const VoxelChunk before = chunk;
+    auto             expectUnchanged = [&](const VoxelChunk& copy) {
+        EXPECT_EQ(copy.Get(0, 0, 0), 1);
+        EXPECT_EQ(copy.Get(3, 10, 3), 2);
+        EXPECT_EQ(copy.Get(5, 20, 5), AIR_KIND);
+        EXPECT_EQ(copy.SolidCount(), CHUNK_AREA * 4 + 1);
+    };
+    const std::vector<BlockKind> run(CHUNK_SIZE, 3);
+    const std::function<void(VoxelChunk&)> writes[] = {
+        [](VoxelChunk& c) { c.Set(5, 20, 5, 3); },
+        [&](VoxelChunk& c) { c.SetRun(ChunkIndex(0, 20, 5), run); },
+        [](VoxelChunk& c) { c.FillBox(0, 0, 0, 8, 8, 8, AIR_KIND); },
+        [](VoxelChunk& c) { c.Fill(4); },
+        [](VoxelChunk& c) {
+            c.Set(3, 10, 3, AIR_KIND);
+            c.Compact();
+        },
+    };
+    for (const auto& write : writes)
+    {
+        VoxelChunk copy = before;
+        EXPECT_TRUE(copy.SharesStorageWith(before));
+        write(copy);
+        EXPECT_FALSE(copy.SharesStorageWith(before));
+        expectUnchanged(before);
+    }
+
+    // Writes that change nothing do not clone.
+    VoxelChunk                   uniform(5);
+    const VoxelChunk             copy = uniform;
+    const std::vector<BlockKind> same(4, 5);
+    uniform.Set(1, 1, 1, 5);
+    uniform.SetRun(0, same);
+    uniform.FillBox(0, 0, 0, 4, 4, 4, 5);
+    EXPECT_TRUE(uniform.SharesStorageWith(copy));
+
+    ChunkedVoxelMap map(255, 64, 64, 64);
+    EXPECT_EQ(map.Snapshot(Int3(0, 0, 0)), nullptr);
+    map.SetBlock(1, 2, 3, 9);
+    const std::shared_ptr<const VoxelChunk> snapshot = map.Snapshot(Int3(0, 0, 0));
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_TRUE(snapshot->SharesStorageWith(*map.GetChunk(Int3(0, 0, 0))));
+    map.SetBlock(1, 2, 3, 8);
+    EXPECT_EQ(snapshot->Get(1, 2, 3), 9);
+    EXPECT_EQ(map.GetBlock(1, 2, 3), 8);
+}
+
+TEST(ChunkedVoxelMapTest, BoundsAndKinds)
+{
+    ChunkedVoxelMap map(255, 64, 48, 80);
+    EXPECT_TRUE(map.BlockKindExists(0));
+    EXPECT_TRUE(map.BlockKindExists(255));
+    EXPECT_FALSE(map.BlockKindExists(256));
+    EXPECT_FALSE(map.BlockKindExists(-1));
+
+    EXPECT_FALSE(map.OutOfBounds(0, 0, 0));
+    EXPECT_FALSE(map.OutOfBounds(63, 47, 79));
+    EXPECT_TRUE(map.OutOfBounds(64, 0, 0));
+    EXPECT_TRUE(map.OutOfBounds(0, -1, 0));
+    EXPECT_THROW(map.SetBlock(0, 48, 0, 1), std::out_of_range);
+}
+
+TEST(ChunkedVoxelMapTest, SetGetAcrossChunks)
+{
+    ChunkedVoxelMap map(255, 128, 128, 128);
+    map.AddBlockFromMagicVoxel(1, 2, 3, 7);
+    map.SetBlock(33, 64, 127, 9);
+    map.SetBlock(100, 5, 5, AIR_KIND);
+
+    EXPECT_EQ(map.GetBlock(1, 2, 3), 7);
+    EXPECT_EQ(map.GetBlock(33, 64, 127), 9);
+    EXPECT_EQ(map.GetBlock(100, 5, 5), AIR_KIND);
+    EXPECT_EQ(map.ChunkCount(), 2u);
+    EXPECT_NE(map.GetChunk(Int3(1, 2, 3)), nullptr);
+    EXPECT_EQ(map.GetChunk(Int3(3, 0, 0)), nullptr);
+
+    // Only creating or removing chunks changes the table version, and no other map has it.
+    const uint64_t version = map.ChunkTableVersion();
+    map.SetBlock(2, 2, 3, 8);
+    EXPECT_EQ(map.ChunkTableVersion(), version);
+    EXPECT_NE(ChunkedVoxelMap(255, 128, 128, 128).ChunkTableVersion(), version);
+
+    map.SetBlock(33, 64, 127, AIR_KIND);
+    map.Compact();
+    EXPECT_EQ(map.ChunkCount(), 1u);
+    EXPECT_NE(map.ChunkTableVersion(), version);
+}
+
+TEST(ChunkedVoxelMapTest, FillBlocksClipsAndSpansChunks)
+{
+    ChunkedVoxelMap map(255, 100, 100, 100);
+    map.FillBlocks(Int3(-10, 20, 90), Int3(50, 20, 50), 5);
+
+    EXPECT_EQ(map.GetBlock(0, 20, 90), 5);
+    EXPECT_EQ(map.GetBlock(39, 39, 99), 5);
+    EXPECT_EQ(map.GetBlock(40, 20, 90), AIR_KIND);
+    EXPECT_EQ(map.GetBlock(0, 19, 90), AIR_KIND);
+    EXPECT_EQ(map.GetBlock(0, 40, 90), AIR_KIND);
+
+    map.FillBlocks(Int3(0, 0, 0), Int3(100, 100, 100), AIR_KIND);
+    map.Compact();
+    EXPECT_EQ(map.ChunkCount(), 0u);
+}
+
+TEST(ChunkedVoxelMapTest, AddBlockBoxMatchesPerVoxelWrites)
+{
+    const Int3             origin(20, 25, 30);
+    const Int3             size(40, 12, 9);
+    std::vector<BlockKind> kinds(static_cast<std::size_t>(size.X) * size.Y * size.Z);
+    for (std::size_t i = 0; i < kinds.size(); ++i)
+    {
+        kinds[i] = static_cast<BlockKind>((i * 7) % 5);
+    }
+
+    ChunkedVoxelMap batched(255, 64, 64, 64);
+    ChunkedVoxelMap single(255, 64, 64, 64);
+    batched.AddBlockBox(origin, size, kinds);
+    single.IVoxelMap::AddBlockBox(origin, size, kinds);
+
+    for (int y = 0; y < 64; ++y)
+        for (int z = 0; z < 64; ++z)
+            for (int x = 0; x < 64; ++x)
+                ASSERT_EQ(batched.GetBlock(x, y, z), single.GetBlock(x, y, z));
+
+    // Kinds run x fastest, then z, then y, as AddBlockBox() reads them.
+    const auto kindAt = [&](int x, int y, int z) {
+        return kinds[static_cast<std::size_t>((x - origin.X) + (z - origin.Z) * size.X + (y - origin.Y) * size.X * size.Z)];
+    };
+    EXPECT_EQ(batched.GetBlock(20, 25, 30), kindAt(20, 25, 30));
+    EXPECT_EQ(batched.GetBlock(59, 36, 38), kindAt(59, 36, 38));
+    EXPECT_NE(batched.GetBlock(59, 36, 38), AIR_KIND);
+    EXPECT_EQ(batched.GetBlock(60, 36, 38), AIR_KIND);
+}
+
+TEST(ChunkedVoxelMapTest, AddBlocksSkipsOutOfBounds)
+{
+    ChunkedVoxelMap         map(255, 64, 64, 64);
+    std::vector<VoxelWrite> writes {{Int3(1, 1, 1), 3}, {Int3(-1, 0, 0), 4}, {Int3(2, 1, 1), 3}, {Int3(40, 50, 60), 9}, {Int3(64, 0, 0), 4}};
+    map.AddBlocks(writes);
+
+    EXPECT_EQ(map.GetBlock(1, 1, 1), 3);
+    EXPECT_EQ(map.GetBlock(2, 1, 1), 3);
+    EXPECT_EQ(map.GetBlock(40, 50, 60), 9);
+    EXPECT_EQ(map.ChunkCount(), 2u);
+}
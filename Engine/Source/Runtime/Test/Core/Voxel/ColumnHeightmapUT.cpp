@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "Voxel/ColumnHeightmap.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    constexpr BlockKind STONE  = 1;
+    constexpr BlockKind GLASS  = 2;
+    constexpr BlockKind FLOWER = 3;
+
+    int HeightByScan(const ChunkedVoxelMap& map, const ColumnHeightmap& heightmap, HeightmapType type, int x, int z)
+    {
+        for (int y = map.SizeY() - 1; y >= 0; --y)
+        {
+            const BlockKind kind = map.GetBlock(x, y, z);
+            const bool      counts = type == HeightmapType::Opaque           ? heightmap.IsOpaque(kind)
+                                     : type == HeightmapType::MotionBlocking ? heightmap.IsMotionBlocking(kind)
+                                                                             : kind != AIR_KIND;
+            if (counts)
+                return y;
+        }
+        return ColumnHeightmap::NO_HEIGHT;
+    }
+
+    void ExpectMatchesScan(const ChunkedVoxelMap& map, const ColumnHeightmap& heightmap)
+    {
+        for (int z = 0; z < map.SizeZ(); ++z)
+            for (int x = 0; x < map.SizeX(); ++x)
+                for (HeightmapType type : {HeightmapType::Opaque, HeightmapType::NonAir, HeightmapType::MotionBlocking})
+                    ASSERT_EQ(heightmap.Height(type, x, z), HeightByScan(map, heightmap, type, x, z))
+                        << "column " << x << ", " << z << " type " << static_cast<int>(type);
+    }
+} // namespace
+
+TEST(ColumnHeightmapTest, KindsCountForTheirTypes)
+{
+    ChunkedVoxelMap map(15, 64, 96, 64);
+    ColumnHeightmap heightmap(map);
+    heightmap.SetKindProperties(GLASS, false, true);
+    heightmap.SetKindProperties(FLOWER, false, false);
+    EXPECT_THROW(heightmap.SetKindProperties(AIR_KIND, true, true), std::invalid_argument);
+    EXPECT_THROW(heightmap.SetKindProperties(16, true, true), std::out_of_range);
+
+    map.FillBlocks(Int3(0, 0, 0), Int3(64, 40, 64), STONE);
+    map.SetBlock(5, 40, 5, GLASS);
+    map.SetBlock(5, 41, 5, FLOWER);
+    heightmap.Rebuild();
+    EXPECT_EQ(heightmap.Height(HeightmapType::Opaque, 5, 5), 39);
+    EXPECT_EQ(heightmap.Height(HeightmapType::MotionBlocking, 5, 5), 40);
+    EXPECT_EQ(heightmap.Height(HeightmapType::NonAir, 5, 5), 41);
+    EXPECT_EQ(heightmap.Height(HeightmapType::NonAir, 6, 5), 39);
+
+    // Placing above raises in place; removing the top scans down once.
+    map.SetBlock(6, 70, 5, STONE);
+    heightmap.OnBlockChanged(6, 70, 5);
+    EXPECT_EQ(heightmap.Height(HeightmapType::Opaque, 6, 5), 70);
+    map.SetBlock(6, 20, 5, AIR_KIND);
+    heightmap.OnBlockChanged(6, 20, 5);
+    EXPECT_EQ(heightmap.RescanCount(), 0u);
+    map.SetBlock(6, 70, 5, AIR_KIND);
+    heightmap.OnBlockChanged(6, 70, 5);
+    EXPECT_EQ(heightmap.Height(HeightmapType::Opaque, 6, 5), 39);
+    EXPECT_EQ(heightmap.RescanCount(), 1u);
+
+    // Digging a column out completely leaves no height.
+    map.FillBlocks(Int3(9, 0, 9), Int3(1, 40, 1), AIR_KIND);
+    heightmap.OnBoxChanged(Int3(9, 0, 9), Int3(1, 40, 1));
+    EXPECT_EQ(heightmap.Height(HeightmapType::NonAir, 9, 9), ColumnHeightmap::NO_HEIGHT);
+
+    EXPECT_THROW(heightmap.Height(HeightmapType::Opaque, 64, 0), std::out_of_range);
+    EXPECT_THROW(heightmap.OnBlockChanged(0, 96, 0), std::out_of_range);
+}
+
+TEST(ColumnHeightmapTest, EditsMatchAFullScan)
+{
+    ChunkedVoxelMap map(15, 96, 128, 80);
+    ColumnHeightmap heightmap(map);
+    heightmap.SetKindProperties(GLASS, false, true);
+    heightmap.SetKindProperties(FLOWER, false, false);
+    for (int z = 0; z < map.SizeZ(); ++z)
+        for (int x = 0; x < map.SizeX(); ++x)
+            map.FillBlocks(Int3(x, 0, z), Int3(1, 30 + (x * 7 + z * 3) % 50, 1), STONE);
+    map.FillBlocks(Int3(0, 0, 0), Int3(32, 64, 32), STONE);
+    heightmap.Rebuild();
+    ExpectMatchesScan(map, heightmap);
+
+    std::mt19937                       rng(17);
+    std::uniform_int_distribution<int> px(0, 95), py(0, 127), pz(0, 79), kind(0, 3), extent(1, 40);
+    for (int edit = 0; edit < 3000; ++edit)
+    {
+        const int x = px(rng), y = py(rng), z = pz(rng);
+        if (edit % 20 == 0)
+        {
+            const Int3 origin(x - 8, y - 20, z - 8), size(extent(rng), extent(rng), extent(rng));
+            map.FillBlocks(origin, size, static_cast<BlockKind>(kind(rng)));
+            heightmap.OnBoxChanged(origin, size);
+            continue;
+        }
+        // Mostly near the surface, where edits happen.
+        const int surface = heightmap.Height(HeightmapType::NonAir, x, z);
+        const int height  = edit % 3 == 0 ? y : std::clamp(surface + kind(rng) - 2, 0, 127);
+        map.SetBlock(x, height, z, static_cast<BlockKind>(kind(rng)));
+        heightmap.OnBlockChanged(x, height, z);
+    }
+    ExpectMatchesScan(map, heightmap);
+
+    // Chunks removed as a whole.
+    map.RemoveChunk(Int3(0, 1, 0));
+    heightmap.OnChunkChanged(Int3(0, 1, 0));
+    map.RemoveChunk(Int3(2, 0, 1));
+    heightmap.OnChunkChanged(Int3(2, 0, 1));
+    ExpectMatchesScan(map, heightmap);
+}
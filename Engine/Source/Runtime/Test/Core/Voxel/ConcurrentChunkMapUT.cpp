@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Math/Hash.h"
+#include "Voxel/ConcurrentChunkMap.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    using Map = ConcurrentChunkMap<int>;
+
+    // Keys of a 32 x 4 x 32 block around the origin, with one value object per key.
+    struct Keys
+    {
+        Keys()
+        {
+            for (int z = -16; z < 16; ++z)
+                for (int y = -2; y < 2; ++y)
+                    for (int x = -16; x < 16; ++x)
+                        Positions.emplace_back(x, y, z);
+            Values.resize(Positions.size());
+            for (std::size_t i = 0; i < Values.size(); ++i)
+                Values[i] = static_cast<int>(i);
+        }
+
+        std::vector<Int3> Positions;
+        std::vector<int>  Values;
+    };
+
+    // Keys whose probe chains start at the same slot of a table with the given capacity,
+    // using the map's own key packing.
+    std::vector<Int3> CollidingKeys(std::size_t count, std::size_t capacity)
+    {
+        const auto home = [&](const Int3& key) {
+            const uint64_t packed = static_cast<uint64_t>(key.X + Map::COORD_LIMIT) | static_cast<uint64_t>(key.Y + Map::COORD_LIMIT) << Map::COORD_BITS |
+                                    static_cast<uint64_t>(key.Z + Map::COORD_LIMIT) << (2 * Map::COORD_BITS);
+            return MixBits(packed) & (capacity - 1);
+        };
+        std::vector<Int3> keys;
+        for (int x = 0; keys.size() < count; ++x)
+            if (home(Int3(x, 0, 0)) == home(Int3(0, 0, 0)))
+                keys.emplace_back(x, 0, 0);
+        return keys;
+    }
+} // namespace
+
+TEST(ConcurrentChunkMapTest, InsertsFindsAndErases)
+{
+    Map map;
+    int a = 1, b = 2, c = 3;
+    EXPECT_TRUE(map.Insert(Int3(0, 0, 0), &a));
+    EXPECT_TRUE(map.Insert(Int3(-1, -5, 7), &b));
+    EXPECT_FALSE(map.Insert(Int3(0, 0, 0), &b));
+    EXPECT_EQ(map.Find(Int3(0, 0, 0)), &a);
+    EXPECT_EQ(map.Find(Int3(-1, -5, 7)), &b);
+    EXPECT_EQ(map.Find(Int3(1, 0, 0)), nullptr);
+    EXPECT_EQ(map.Size(), 2u);
+
+    EXPECT_EQ(map.Assign(Int3(0, 0, 0), &c), &a);
+    EXPECT_EQ(map.Find(Int3(0, 0, 0)), &c);
+    EXPECT_EQ(map.Erase(Int3(0, 0, 0)), &c);
+    EXPECT_EQ(map.Erase(Int3(0, 0, 0)), nullptr);
+    EXPECT_FALSE(map.Contains(Int3(0, 0, 0)));
+    EXPECT_EQ(map.Size(), 1u);
+
+    // The corners of the key range pack without colliding.
+    const Int3 low(-Map::COORD_LIMIT, -Map::COORD_LIMIT, -Map::COORD_LIMIT);
+    const Int3 high(Map::COORD_LIMIT - 1, Map::COORD_LIMIT - 1, Map::COORD_LIMIT - 1);
+    EXPECT_TRUE(map.Insert(low, &a));
+    EXPECT_TRUE(map.Insert(high, &c));
+    EXPECT_EQ(map.Find(low), &a);
+    EXPECT_EQ(map.Find(high), &c);
+
+    int visited = 0;
+    map.ForEach([&](const Int3& key, int* value) {
+        EXPECT_EQ(map.Find(key), value);
+        ++visited;
+    });
+    EXPECT_EQ(visited, 3);
+
+    EXPECT_EQ(map.Find(Int3(Map::COORD_LIMIT, 0, 0)), nullptr);
+    EXPECT_THROW(map.Insert(Int3(0, Map::COORD_LIMIT, 0), &a), std::out_of_range);
+    EXPECT_THROW(map.Insert(Int3(5, 5, 5), nullptr), std::invalid_argument);
+}
+
+TEST(ConcurrentChunkMapTest, GrowsAndRetiresOldTables)
+{
+    Keys keys;
+    Map  map;
+    for (std::size_t i = 0; i < keys.Positions.size(); ++i)
+        ASSERT_TRUE(map.Insert(keys.Positions[i], &keys.Values[i]));
+
+    EXPECT_EQ(map.Size(), keys.Positions.size());
+    EXPECT_GE(map.Capacity(), keys.Positions.size() * 3 / 2);
+    for (std::size_t i = 0; i < keys.Positions.size(); ++i)
+        ASSERT_EQ(map.Find(keys.Positions[i]), &keys.Values[i]);
+
+    EXPECT_GT(map.RetiredBytes(), 0u);
+    map.Reclaim();
+    EXPECT_EQ(map.RetiredBytes(), 0u);
+}
+
+TEST(ConcurrentChunkMapTest, ChurnDoesNotGrowTheTable)
+{
+    // A sliding window of 500 live keys, as streaming produces when the camera moves.
+    // Erased slots turn back into empty ones wherever the probe chains allow, so after the
+    // first round tombstones never pile up enough to force another rehash.
+    Keys keys;
+    Map  map;
+    for (std::size_t i = 0; i < 500; ++i)
+        map.Insert(keys.Positions[i], &keys.Values[i]);
+
+    std::size_t capacity = 0;
+    std::size_t retired  = 0;
+    for (int round = 0; round < 20; ++round)
+    {
+        for (std::size_t i = 0; i < keys.Positions.size(); ++i)
+        {
+            const std::size_t added   = (i + 500) % keys.Positions.size();
+            const std::size_t removed = i;
+            ASSERT_EQ(map.Erase(keys.Positions[removed]), &keys.Values[removed]);
+            ASSERT_TRUE(map.Insert(keys.Positions[added], &keys.Values[added]));
+        }
+        if (round == 0)
+        {
+            capacity = map.Capacity();
+            retired  = map.RetiredBytes();
+        }
+    }
+
+    EXPECT_EQ(map.Size(), 500u);
+    EXPECT_EQ(map.Capacity(), capacity);
+    EXPECT_EQ(map.RetiredBytes(), retired);
+    for (std::size_t i = 0; i < keys.Positions.size(); ++i)
+    {
+        const bool live = i < 500;
+        ASSERT_EQ(map.Find(keys.Positions[i]), live ? &keys.Values[i] : nullptr);
+    }
+}
+
+TEST(ConcurrentChunkMapTest, ReadersNeverSeeWrongValues)
+{
+    // Even keys stay put; odd keys are erased and inserted again while readers look everything up.
+    Keys keys;
+    Map  map(16);
+    for (std::size_t i = 0; i < keys.Positions.size(); i += 2)
+        map.Insert(keys.Positions[i], &keys.Values[i]);
+
+    std::atomic<bool>        stop {false};
+    std::atomic<int>         wrong {0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&, t] {
+            std::size_t i = static_cast<std::size_t>(t) * 97;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                i                   = (i + 31) % keys.Positions.size();
+                const int* value    = map.Find(keys.Positions[i]);
+                const bool stable   = i % 2 == 0;
+                const bool expected = value == &keys.Values[i] || (!stable && value == nullptr);
+                wrong.fetch_add(expected ? 0 : 1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (int round = 0; round < 20; ++round)
+    {
+        for (std::size_t i = 1; i < keys.Positions.size(); i += 2)
+            map.Insert(keys.Positions[i], &keys.Values[i]);
+        for (std::size_t i = 1; i < keys.Positions.size(); i += 2)
+            map.Erase(keys.Positions[i]);
+    }
+    stop = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(wrong.load(), 0);
+    EXPECT_EQ(map.Size(), keys.Positions.size() / 2);
+}
+
+TEST(ConcurrentChunkMapTest, ReadersNeverSeeValuesOfRecycledSlots)
+{
+    // Colliding keys take turns in the same slot, so a reader that finds one key keeps racing the
+    // erase of that key and the insert of the next one into the slot it just matched.
+    Map                     map;
+    const std::vector<Int3> keys = CollidingKeys(4, map.Capacity());
+    std::vector<int>        values {0, 1, 2, 3};
+
+    std::atomic<bool>        stop {false};
+    std::atomic<int>         wrong {0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&, t] {
+            std::size_t i = static_cast<std::size_t>(t);
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                i                = (i + 1) % keys.size();
+                const int* value = map.Find(keys[i]);
+                wrong.fetch_add(value == nullptr || value == &values[i] ? 0 : 1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (int round = 0; round < 200000; ++round)
+    {
+        const std::size_t i = static_cast<std::size_t>(round) % keys.size();
+        map.Insert(keys[i], &values[i]);
+        map.Erase(keys[i]);
+    }
+    stop = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(wrong.load(), 0);
+    EXPECT_EQ(map.Size(), 0u);
+}
@@ -0,0 +1,372 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Voxel/GreedyMesher.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    ChunkNeighbourhood Around(const VoxelChunk* center)
+    {
+        ChunkNeighbourhood neighbourhood;
+        neighbourhood.Chunks[ChunkNeighbourhood::CENTER_SLOT] = center;
+        return neighbourhood;
+    }
+
+    std::vector<PackedVoxelVertex> Vertices(const ChunkMesh& mesh)
+    {
+        std::vector<PackedVoxelVertex> vertices(mesh.VertexCount);
+        std::memcpy(vertices.data(), mesh.Vertices.data(), mesh.Vertices.size());
+        return vertices;
+    }
+
+    // Cross product of the first triangle's edges must point along the face normal.
+    void ExpectOutwardWinding(const std::vector<PackedVoxelVertex>& vertices)
+    {
+        for (std::size_t i = 0; i < vertices.size(); i += 3)
+        {
+            const PackedVoxelVertex& a = vertices[i];
+            const PackedVoxelVertex& b = vertices[i + 1];
+            const PackedVoxelVertex& c = vertices[i + 2];
+
+            const Int3 e1(b.X() - a.X(), b.Y() - a.Y(), b.Z() - a.Z());
+            const Int3 e2(c.X() - a.X(), c.Y() - a.Y(), c.Z() - a.Z());
+            const Int3 cross(e1.Y * e2.Z - e1.Z * e2.Y, e1.Z * e2.X - e1.X * e2.Z, e1.X * e2.Y - e1.Y * e2.X);
+            const Int3 normal = FaceNormal(a.Face());
+
+            EXPECT_GT(cross.X * normal.X + cross.Y * normal.Y + cross.Z * normal.Z, 0);
+            EXPECT_EQ(cross.X * normal.Y - cross.Y * normal.X, 0);
+            EXPECT_EQ(cross.Y * normal.Z - cross.Z * normal.Y, 0);
+        }
+    }
+
+    // Axes (normal, u, v) of a face as indices into (x, y, z).
+    void FaceAxes(BlockFace face, int& n, int& u, int& v)
+    {
+        switch (face)
+        {
+            case BlockFace::PositiveX:
+            case BlockFace::NegativeX:
+                n = 0, u = 1, v = 2;
+                break;
+            case BlockFace::PositiveY:
+            case BlockFace::NegativeY:
+                n = 1, u = 0, v = 2;
+                break;
+            default:
+                n = 2, u = 0, v = 1;
+                break;
+        }
+    }
+
+    // Random chunk and neighbours; every visible voxel face must be covered by exactly one quad,
+    // and each quad corner must carry the AO that every unit face under it has at that corner.
+    void ExpectQuadsCoverVisibleFaces(int kinds)
+    {
+        std::mt19937                       rng(1234);
+        std::bernoulli_distribution        solid(0.5);
+        std::uniform_int_distribution<int> kind(1, kinds);
+
+        VoxelChunk chunk;
+        VoxelChunk neighbour;
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+        {
+            chunk.Set(i, static_cast<BlockKind>(solid(rng) ? kind(rng) : AIR_KIND));
+            neighbour.Set(i, static_cast<BlockKind>(solid(rng) ? 1 : AIR_KIND));
+        }
+
+        ChunkNeighbourhood neighbourhood;
+        neighbourhood.Chunks.fill(&neighbour);
+        neighbourhood.Chunks[ChunkNeighbourhood::CENTER_SLOT]                = &chunk;
+        neighbourhood.Chunks[ChunkNeighbourhood::Slot(BlockFace::NegativeZ)] = nullptr;
+        neighbourhood.Chunks[ChunkNeighbourhood::Slot(1, 1, 0)]              = nullptr;
+
+        // Kind at a position that may lie one voxel outside the chunk.
+        auto kindAt = [&](int x, int y, int z) -> BlockKind {
+            auto              offset = [](int c) { return c < 0 ? -1 : c >= CHUNK_SIZE ? 1 : 0; };
+            const VoxelChunk* source = neighbourhood.Chunks[ChunkNeighbourhood::Slot(offset(x), offset(y), offset(z))];
+            return source == nullptr ? AIR_KIND : source->Get(x & CHUNK_MASK, y & CHUNK_MASK, z & CHUNK_MASK);
+        };
+        auto solidAt = [&](const int p[3]) { return kindAt(p[0], p[1], p[2]) != AIR_KIND ? 1 : 0; };
+
+        GreedyMesher mesher;
+        ChunkMesh    mesh;
+        mesher.Mesh(neighbourhood, mesh);
+        const auto vertices = Vertices(mesh);
+        ExpectOutwardWinding(vertices);
+
+        // Count how often each voxel face is covered by an emitted quad.
+        std::vector<int> covered(CHUNK_VOLUME * BLOCK_FACE_COUNT, 0);
+        for (std::size_t q = 0; q < vertices.size(); q += 6)
+        {
+            const BlockFace face = vertices[q].Face();
+            const Int3      n    = FaceNormal(face);
+            int             lo[3] = {CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE}, hi[3] = {0, 0, 0};
+            for (int i = 0; i < 6; ++i)
+            {
+                const int c[3] = {vertices[q + i].X(), vertices[q + i].Y(), vertices[q + i].Z()};
+                for (int a = 0; a < 3; ++a)
+                {
+                    lo[a] = std::min(lo[a], c[a]);
+                    hi[a] = std::max(hi[a], c[a]);
+                }
+                EXPECT_EQ(vertices[q + i].Kind(), vertices[q].Kind());
+            }
+
+            // AO stored at the quad corner on the low or high side of u and v.
+            int na, ua, va;
+            FaceAxes(face, na, ua, va);
+            auto quadAO = [&](int su, int sv) {
+                for (int i = 0; i < 6; ++i)
+                {
+                    const int c[3] = {vertices[q + i].X(), vertices[q + i].Y(), vertices[q + i].Z()};
+                    if (c[ua] == (su < 0 ? lo[ua] : hi[ua]) && c[va] == (sv < 0 ? lo[va] : hi[va]))
+                        return vertices[q + i].AO();
+                }
+                return -1;
+            };
+
+            // The quad is flat along its normal; step back into the solid voxels.
+            const int nn[3] = {n.X, n.Y, n.Z};
+            lo[na] -= nn[na] > 0 ? 1 : 0;
+            hi[na] = lo[na] + 1;
+
+            for (int y = lo[1]; y < hi[1]; ++y)
+                for (int z = lo[2]; z < hi[2]; ++z)
+                    for (int x = lo[0]; x < hi[0]; ++x)
+                    {
+                        EXPECT_EQ(chunk.Get(x, y, z), vertices[q].Kind());
+                        ++covered[ChunkIndex(x, y, z) * BLOCK_FACE_COUNT + static_cast<int>(face)];
+
+                        for (int su : {-1, 1})
+                            for (int sv : {-1, 1})
+                            {
+                                int side1[3]  = {x + n.X, y + n.Y, z + n.Z};
+                                int side2[3]  = {x + n.X, y + n.Y, z + n.Z};
+                                int corner[3] = {x + n.X, y + n.Y, z + n.Z};
+                                side1[ua] += su;
+                                side2[va] += sv;
+                                corner[ua] += su;
+                                corner[va] += sv;
+
+                                const int s1 = solidAt(side1), s2 = solidAt(side2), c = solidAt(corner);
+                                const int ao = s1 && s2 ? 0 : 3 - (s1 + s2 + c);
+                                EXPECT_EQ(quadAO(su, sv), ao) << x << "," << y << "," << z << " face " << static_cast<int>(face);
+                            }
+                    }
+        }
+
+        for (int y = 0; y < CHUNK_SIZE; ++y)
+            for (int z = 0; z < CHUNK_SIZE; ++z)
+                for (int x = 0; x < CHUNK_SIZE; ++x)
+                    for (int f = 0; f < BLOCK_FACE_COUNT; ++f)
+                    {
+                        const Int3 n       = FaceNormal(static_cast<BlockFace>(f));
+                        const bool visible = chunk.Get(x, y, z) != AIR_KIND && kindAt(x + n.X, y + n.Y, z + n.Z) == AIR_KIND;
+                        EXPECT_EQ(covered[ChunkIndex(x, y, z) * BLOCK_FACE_COUNT + f], visible ? 1 : 0) << x << "," << y << "," << z << " face " << f;
+                    }
+    }
+} // namespace
+
+TEST(GreedyMesherTest, VertexFormatMatchesPackedVertex)
+{
+    const auto& format = GreedyMesher::VertexFormat();
+    EXPECT_EQ(format.size, sizeof(PackedVoxelVertex));
+    ASSERT_EQ(format.elements.size(), 2u);
+    EXPECT_EQ(format.elements[1].offset, 4u);
+
+    const PackedVoxelVertex vertex = PackedVoxelVertex::Make(32, 1, 2, BlockFace::NegativeZ, 0xBEEF, 31, 7, 2, ChunkLight::Pack(9, 4));
+    EXPECT_EQ(vertex.X(), 32);
+    EXPECT_EQ(vertex.Y(), 1);
+    EXPECT_EQ(vertex.Z(), 2);
+    EXPECT_EQ(vertex.Face(), BlockFace::NegativeZ);
+    EXPECT_EQ(vertex.AO(), 2);
+    EXPECT_EQ(vertex.SkyLight(), 9);
+    EXPECT_EQ(vertex.BlockLight(), 4);
+    EXPECT_EQ(vertex.Kind(), 0xBEEF);
+    EXPECT_EQ(vertex.U(), 31);
+    EXPECT_EQ(vertex.V(), 7);
+}
+
+TEST(GreedyMesherTest, EmptyChunkProducesNoVertices)
+{
+    VoxelChunk   chunk;
+    GreedyMesher mesher;
+    ChunkMesh    mesh;
+    mesher.Mesh(Around(&chunk), mesh);
+    EXPECT_EQ(mesh.VertexCount, 0u);
+    EXPECT_TRUE(mesh.Vertices.empty());
+}
+
+TEST(GreedyMesherTest, BuriedChunkProducesNoVertices)
+{
+    VoxelChunk stone(1);
+    VoxelChunk dirt(2);
+    dirt.Set(0, 0, 0, 1);
+
+    ChunkNeighbourhood neighbourhood = Around(&stone);
+    for (int face = 0; face < BLOCK_FACE_COUNT; ++face)
+        neighbourhood.Chunks[ChunkNeighbourhood::Slot(static_cast<BlockFace>(face))] = &dirt;
+
+    GreedyMesher mesher;
+    ChunkMesh    mesh;
+    mesher.Mesh(neighbourhood, mesh);
+    EXPECT_EQ(mesh.VertexCount, 0u);
+
+    // One open neighbour uncovers the face towards it.
+    VoxelChunk cave(2);
+    cave.Set(5, 0, 7, AIR_KIND);
+    neighbourhood.Chunks[ChunkNeighbourhood::Slot(BlockFace::PositiveY)] = &cave;
+    mesher.Mesh(neighbourhood, mesh);
+    EXPECT_EQ(mesh.QuadCount, 1u);
+}
+
+TEST(GreedyMesherTest, SingleVoxelHasSixOutwardQuads)
+{
+    VoxelChunk chunk;
+    chunk.Set(3, 4, 5, 7);
+
+    GreedyMesher mesher;
+    ChunkMesh    mesh;
+    mesher.Mesh(Around(&chunk), mesh);
+    ASSERT_EQ(mesh.QuadCount, 6u);
+    ASSERT_EQ(mesh.Vertices.size(), 36 * sizeof(PackedVoxelVertex));
+
+    const auto vertices = Vertices(mesh);
+    ExpectOutwardWinding(vertices);
+    for (const PackedVoxelVertex& vertex : vertices)
+    {
+        EXPECT_EQ(vertex.Kind(), 7);
+        EXPECT_EQ(vertex.AO(), 3);
+        EXPECT_EQ(vertex.SkyLight(), ChunkLight::MAX_LEVEL);
+        EXPECT_EQ(vertex.BlockLight(), 0);
+        EXPECT_TRUE(vertex.X() == 3 || vertex.X() == 4);
+        EXPECT_TRUE(vertex.Y() == 4 || vertex.Y() == 5);
+        EXPECT_TRUE(vertex.Z() == 5 || vertex.Z() == 6);
+    }
+}
+
+TEST(GreedyMesherTest, MergesFacesOfSameKindOnly)
+{
+    VoxelChunk chunk;
+    chunk.FillBox(0, 0, 0, 8, 1, 4, 1);
+    GreedyMesher mesher;
+    ChunkMesh    mesh;
+    mesher.Mesh(Around(&chunk), mesh);
+    EXPECT_EQ(mesh.QuadCount, 6u);
+
+    chunk.Set(7, 0, 3, 2);
+    mesher.Mesh(Around(&chunk), mesh);
+    EXPECT_GT(mesh.QuadCount, 6u);
+    ExpectOutwardWinding(Vertices(mesh));
+}
+
+TEST(GreedyMesherTest, SolidNeighboursCullBorderFaces)
+{
+    VoxelChunk full(1);
+    VoxelChunk stone(2);
+
+    GreedyMesher mesher;
+    ChunkMesh    mesh;
+    mesher.Mesh(Around(&full), mesh);
+    EXPECT_EQ(mesh.QuadCount, 6u);
+
+    ChunkNeighbourhood neighbourhood = Around(&full);
+    for (int f = 0; f < BLOCK_FACE_COUNT; ++f)
+        neighbourhood.Chunks[ChunkNeighbourhood::Slot(static_cast<BlockFace>(f))] = &stone;
+    mesher.Mesh(neighbourhood, mesh);
+    EXPECT_EQ(mesh.QuadCount, 0u);
+
+    // The +X border minus one voxel; the faces around the hole are darkened by the
+    // neighbour's voxel and split off from the rest.
+    VoxelChunk partial;
+    partial.Set(0, 0, 0, 3);
+    neighbourhood.Chunks[ChunkNeighbourhood::Slot(BlockFace::PositiveX)] = &partial;
+    mesher.Mesh(neighbourhood, mesh);
+    EXPECT_GE(mesh.QuadCount, 2u);
+    for (const PackedVoxelVertex& vertex : Vertices(mesh))
+        EXPECT_EQ(vertex.Face(), BlockFace::PositiveX);
+}
+
+TEST(GreedyMesherTest, SplitsQuadsWhereAmbientOcclusionDiffers)
+{
+    VoxelChunk chunk;
+    chunk.FillBox(0, 0, 0, 8, 1, 8, 1);
+    GreedyMesher mesher;
+    ChunkMesh    mesh;
+    mesher.Mesh(Around(&chunk), mesh);
+    EXPECT_EQ(mesh.QuadCount, 6u);
+
+    // A block on the floor darkens exactly the floor corners touching it.
+    chunk.Set(4, 1, 4, 1);
+    mesher.Mesh(Around(&chunk), mesh);
+
+    int floorVertices = 0;
+    for (const PackedVoxelVertex& vertex : Vertices(mesh))
+    {
+        if (vertex.Face() != BlockFace::PositiveY || vertex.Y() != 1)
+            continue;
+        ++floorVertices;
+        const bool touching = vertex.X() >= 4 && vertex.X() <= 5 && vertex.Z() >= 4 && vertex.Z() <= 5;
+        EXPECT_EQ(vertex.AO() < 3, touching) << vertex.X() << "," << vertex.Z();
+    }
+    EXPECT_GT(floorVertices, 6 * 4);
+}
+
+TEST(GreedyMesherTest, CarriesLightOfTheVoxelInFront)
+{
+    VoxelChunk chunk;
+    chunk.FillBox(0, 0, 0, 4, 1, 4, 1);
+
+    ChunkLight light(0, 0);
+    for (int z = 0; z < 4; ++z)
+        for (int x = 0; x < 4; ++x)
+            light.Set(ChunkIndex(x, 1, z), x < 2 ? 15 : 6, 3);
+
+    ChunkNeighbourhood neighbourhood                      = Around(&chunk);
+    neighbourhood.Lights[ChunkNeighbourhood::CENTER_SLOT] = &light;
+
+    GreedyMesher mesher;
+    ChunkMesh    mesh;
+    mesher.Mesh(neighbourhood, mesh);
+
+    int topVertices = 0;
+    for (const PackedVoxelVertex& vertex : Vertices(mesh))
+    {
+        if (vertex.Face() == BlockFace::PositiveY)
+        {
+            ++topVertices;
+            EXPECT_EQ(vertex.BlockLight(), 3);
+            if (vertex.X() != 2)
+            {
+                EXPECT_EQ(vertex.SkyLight(), vertex.X() < 2 ? 15 : 6);
+            }
+        }
+        else if (vertex.Face() == BlockFace::PositiveX || vertex.Face() == BlockFace::PositiveZ)
+        {
+            EXPECT_EQ(vertex.SkyLight(), 0);
+        }
+        else
+        {
+            // Outside the chunk there is no light data, which reads as open sky.
+            EXPECT_EQ(vertex.SkyLight(), ChunkLight::MAX_LEVEL);
+            EXPECT_EQ(vertex.BlockLight(), 0);
+        }
+    }
+    EXPECT_EQ(topVertices, 2 * 6); // The light change splits the top face in two.
+}
+
+TEST(GreedyMesherTest, QuadsCoverExactlyTheVisibleFaces)
+{
+    // Large palettes take the grouped decode path.
+    for (int kinds : {1, 3, 12, 300})
+    {
+        SCOPED_TRACE(kinds);
+        ExpectQuadsCoverVisibleFaces(kinds);
+    }
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Allocator/Allocator.h"
+#include "Voxel/RegionChunkCache.h"
+#include "Voxel/RegionStore.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    class RegionChunkCacheTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::filesystem::remove_all(directory_);
+
+            // Eight chunks along x with a distinct marker each, plus one chunk in a second region.
+            ChunkedVoxelMap map(255, 1100, 32, 32);
+            for (int x = 0; x < 8; ++x)
+                map.SetBlock(x * CHUNK_SIZE + 1, 2, 3, static_cast<BlockKind>(10 + x));
+            map.SetBlock(1090, 5, 5, 99);
+
+            RegionStore store(directory_);
+            store.SaveMap(map);
+        }
+
+        void TearDown() override { std::filesystem::remove_all(directory_); }
+
+        const std::filesystem::path directory_ = std::filesystem::temp_directory_path() / "RegionChunkCacheUT";
+    };
+} // namespace
+
+TEST_F(RegionChunkCacheTest, DecompressesChunksOnFirstAccess)
+{
+    RegionChunkCache cache(directory_, 1 << 20);
+    EXPECT_EQ(cache.Stats().ResidentChunks, 0u);
+
+    const auto first = cache.GetChunk(Int3(3, 0, 0));
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->Get(1, 2, 3), 13);
+    EXPECT_EQ(cache.GetChunk(Int3(3, 0, 0)), first);
+
+    const auto far = cache.GetChunk(Int3(1090 >> CHUNK_SHIFT, 0, 0));
+    ASSERT_NE(far, nullptr);
+    EXPECT_EQ(far->Get(1090 & CHUNK_MASK, 5, 5), 99);
+
+    // Never stored: in an existing region, and in a region without a file.
+    EXPECT_EQ(cache.GetChunk(Int3(3, 0, 1)), nullptr);
+    EXPECT_EQ(cache.GetChunk(Int3(3, 0, 100)), nullptr);
+    EXPECT_TRUE(cache.HasChunk(Int3(5, 0, 0)));
+    EXPECT_FALSE(cache.HasChunk(Int3(5, 1, 0)));
+
+    const RegionChunkCacheStats stats = cache.Stats();
+    EXPECT_EQ(stats.Hits, 1u);
+    EXPECT_EQ(stats.Misses, 2u);
+    EXPECT_EQ(stats.ResidentChunks, 2u);
+    EXPECT_GT(stats.DecompressSeconds, 0.0);
+    EXPECT_DOUBLE_EQ(stats.HitRate(), 1.0 / 3.0);
+}
+
+TEST_F(RegionChunkCacheTest, EvictsLeastRecentlyUsedChunksBeyondCapacity)
+{
+    RegionChunkCache cache(directory_, 1 << 20);
+    cache.GetChunk(Int3(0, 0, 0));
+    const std::size_t chunkBytes = cache.Stats().ResidentBytes;
+
+    // Every test chunk has the same layout, so this holds exactly three of them.
+    cache.SetCapacity(3 * chunkBytes);
+    const auto held = cache.GetChunk(Int3(1, 0, 0));
+    cache.GetChunk(Int3(2, 0, 0));
+    cache.GetChunk(Int3(0, 0, 0));
+    cache.GetChunk(Int3(3, 0, 0));
+
+    RegionChunkCacheStats stats = cache.Stats();
+    EXPECT_EQ(stats.ResidentChunks, 3u);
+    EXPECT_EQ(stats.ResidentBytes, 3 * chunkBytes);
+    EXPECT_EQ(stats.Evictions, 1u);
+
+    // Chunk 1 was least recently used; the copy held outside the cache survives eviction.
+    EXPECT_EQ(held->Get(1, 2, 3), 11);
+    cache.GetChunk(Int3(0, 0, 0));
+    EXPECT_EQ(cache.Stats().Misses, stats.Misses);
+    cache.GetChunk(Int3(1, 0, 0));
+    EXPECT_EQ(cache.Stats().Misses, stats.Misses + 1);
+
+    cache.SetCapacity(chunkBytes);
+    EXPECT_EQ(cache.Stats().ResidentChunks, 1u);
+}
+
+TEST_F(RegionChunkCacheTest, ReportsThroughAllocatorStats)
+{
+    const std::size_t before = gChunkCacheMemory;
+    const uint64_t    misses = gChunkCacheMisses;
+    {
+        RegionChunkCache cache(directory_, 1 << 20);
+        cache.GetChunk(Int3(0, 0, 0));
+        cache.GetChunk(Int3(0, 0, 0));
+        EXPECT_EQ(gChunkCacheMemory, before + cache.Stats().ResidentBytes);
+        EXPECT_EQ(gChunkCacheMisses, misses + 1);
+        EXPECT_NE(MemoryString().find("ChunkCache: "), std::string::npos);
+    }
+    EXPECT_EQ(gChunkCacheMemory, before);
+}
+
+TEST_F(RegionChunkCacheTest, ConcurrentReadersShareOneCache)
+{
+    RegionChunkCache cache(directory_, 1 << 20);
+
+    std::vector<std::thread> readers;
+    std::vector<int>         wrong(4, 0);
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&, t] {
+            for (int i = 0; i < 200; ++i)
+            {
+                const int  x     = (i + t) % 8;
+                const auto chunk = cache.GetChunk(Int3(x, 0, 0));
+                if (chunk == nullptr || chunk->Get(1, 2, 3) != 10 + x)
+                    ++wrong[t];
+                if (i % 50 == 0)
+                    cache.SetCapacity(static_cast<std::size_t>(i) * 64);
+            }
+        });
+    }
+    for (std::thread& reader : readers)
+        reader.join();
+
+    for (int t = 0; t < 4; ++t)
+        EXPECT_EQ(wrong[t], 0);
+    const RegionChunkCacheStats stats = cache.Stats();
+    EXPECT_EQ(stats.Hits + stats.Misses, 800u);
+}
+
+TEST_F(RegionChunkCacheTest, RejectsCorruptRegions)
+{
+    const std::filesystem::path path = RegionFile::PathFor(directory_, Int3(0, 0, 0));
+    const uint32_t              sector = RegionFile(path).Location(RegionSlot(Int3(2, 0, 0))).Sector;
+    {
+        // Flip a byte inside the compressed stream of one record.
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp(sector * RegionFile::SECTOR_SIZE + 40);
+        out.put('\x5A');
+    }
+    {
+        std::ofstream out(RegionFile::PathFor(directory_, Int3(1, 0, 0)), std::ios::binary);
+        out << "definitely not a region file";
+    }
+
+    RegionChunkCache cache(directory_, 1 << 20);
+    EXPECT_THROW(cache.GetChunk(Int3(2, 0, 0)), std::runtime_error);
+    EXPECT_NE(cache.GetChunk(Int3(3, 0, 0)), nullptr);
+    EXPECT_THROW(cache.GetChunk(Int3(1090 >> CHUNK_SHIFT, 0, 0)), std::runtime_error);
+    EXPECT_EQ(cache.Stats().ResidentChunks, 1u);
+}
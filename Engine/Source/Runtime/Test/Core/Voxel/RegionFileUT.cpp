@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Voxel/RegionFile.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    // Random chunk with the given number of kinds, so every index width gets exercised.
+    VoxelChunk RandomChunk(int kinds, unsigned seed)
+    {
+        std::mt19937                       rng(seed);
+        std::uniform_int_distribution<int> kind(0, kinds - 1);
+        VoxelChunk                         chunk;
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+            chunk.Set(i, static_cast<BlockKind>(kind(rng) * 7));
+        return chunk;
+    }
+
+    void ExpectSameVoxels(const VoxelChunk& a, const VoxelChunk& b)
+    {
+        EXPECT_EQ(a.BitsPerIndex(), b.BitsPerIndex());
+        for (int i = 0; i < CHUNK_VOLUME; ++i)
+        {
+            if (a.Get(i) != b.Get(i))
+            {
+                ADD_FAILURE() << "voxel " << i << " differs";
+                return;
+            }
+        }
+    }
+
+    void AppendU32(std::vector<uint8_t>& out, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    // Record of a packed chunk as EncodeRecord() lays it out, but with the payload in one stored
+    // deflate block, so tests can write payloads that no chunk would produce.
+    std::vector<uint8_t> StoredRecord(const std::vector<BlockKind>& palette, int bits, const std::vector<uint64_t>& indices)
+    {
+        std::vector<uint8_t> payload;
+        AppendU32(payload, static_cast<uint32_t>(palette.size()));
+        payload.insert(payload.end(), {static_cast<uint8_t>(bits), 0, 0, 0});
+        for (BlockKind kind : palette)
+            payload.insert(payload.end(), {static_cast<uint8_t>(kind), static_cast<uint8_t>(kind >> 8)});
+        for (uint64_t word : indices)
+        {
+            AppendU32(payload, static_cast<uint32_t>(word));
+            AppendU32(payload, static_cast<uint32_t>(word >> 32));
+        }
+
+        const auto           size = static_cast<uint16_t>(payload.size());
+        std::vector<uint8_t> zlib {0x78, 0x01, 0x01, static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8)};
+        zlib.insert(zlib.end(), {static_cast<uint8_t>(~size), static_cast<uint8_t>(~size >> 8)});
+        zlib.insert(zlib.end(), payload.begin(), payload.end());
+        uint32_t a = 1;
+        uint32_t b = 0;
+        for (uint8_t byte : payload)
+        {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        for (int shift = 24; shift >= 0; shift -= 8)
+            zlib.push_back(static_cast<uint8_t>((b << 16 | a) >> shift));
+
+        std::vector<uint8_t> record;
+        AppendU32(record, static_cast<uint32_t>(1 + 4 + zlib.size()));
+        record.push_back(1);
+        AppendU32(record, static_cast<uint32_t>(payload.size()));
+        record.insert(record.end(), zlib.begin(), zlib.end());
+        return record;
+    }
+
+    class RegionFileTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override { std::filesystem::remove(path_); }
+
+        void TearDown() override { std::filesystem::remove(path_); }
+
+        const std::filesystem::path path_ = std::filesystem::temp_directory_path() / "RegionFileUT.vxr";
+    };
+} // namespace
+
+TEST(RegionFileMathTest, SlotsCoverTheRegion)
+{
+    const Int3 chunkPos(-33, 4, 65);
+    const Int3 region = RegionOf(chunkPos);
+    EXPECT_TRUE(region == Int3(-2, 4, 2));
+    EXPECT_TRUE(RegionChunk(region, RegionSlot(chunkPos)) == chunkPos);
+
+    Int3 parsed = Int3::Invalid;
+    EXPECT_TRUE(RegionFile::ParsePath(RegionFile::PathFor("world", region), parsed));
+    EXPECT_TRUE(parsed == region);
+    EXPECT_FALSE(RegionFile::ParsePath("r.1.2.vxr", parsed));
+    EXPECT_FALSE(RegionFile::ParsePath("r.1.2.3.vxr.tmp", parsed));
+}
+
+TEST_F(RegionFileTest, RecordsRoundTripEveryIndexWidth)
+{
+    std::vector<VoxelChunk> chunks;
+    chunks.emplace_back(AIR_KIND);
+    chunks.emplace_back(0xBEEF);
+    for (int kinds : {2, 3, 16, 200, 3000})
+        chunks.push_back(RandomChunk(kinds, static_cast<unsigned>(kinds)));
+
+    {
+        RegionFile file(path_);
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+            file.WriteChunk(static_cast<int>(i * 37), chunks[i]);
+        EXPECT_EQ(file.ChunkCount(), chunks.size());
+    }
+
+    // Reopened, and read in reverse to show records do not depend on each other.
+    RegionFile file(path_);
+    EXPECT_EQ(file.ChunkCount(), chunks.size());
+    for (std::size_t i = chunks.size(); i-- > 0;)
+    {
+        VoxelChunk loaded;
+        ASSERT_TRUE(file.ReadChunk(static_cast<int>(i * 37), loaded));
+        ExpectSameVoxels(loaded, chunks[i]);
+    }
+
+    VoxelChunk missing;
+    EXPECT_FALSE(file.ReadChunk(1, missing));
+}
+
+TEST_F(RegionFileTest, RecordsAreSectorAligned)
+{
+    RegionFile file(path_);
+    file.WriteChunk(0, RandomChunk(200, 1));
+    file.WriteChunk(1, VoxelChunk(3));
+    file.Flush();
+
+    EXPECT_EQ(file.Location(0).Sector, RegionFile::HEADER_SECTORS);
+    EXPECT_EQ(file.Location(1).Sector, RegionFile::HEADER_SECTORS + file.Location(0).Count);
+    EXPECT_EQ(file.Location(1).Count, 1u);
+    EXPECT_EQ(std::filesystem::file_size(path_), file.SectorCount() * RegionFile::SECTOR_SIZE);
+}
+
+TEST_F(RegionFileTest, RewritesReuseFreedSectors)
+{
+    RegionFile file(path_);
+    for (int slot = 0; slot < 8; ++slot)
+        file.WriteChunk(slot, RandomChunk(16, static_cast<unsigned>(slot)));
+    const std::size_t sectors = file.SectorCount();
+
+    // A rewrite never overwrites the live record, but space freed by earlier rewrites is reused,
+    // so repeated saves do not grow the file.
+    for (int round = 0; round < 20; ++round)
+        file.WriteChunk(round % 8, RandomChunk(16, static_cast<unsigned>(100 + round)));
+    EXPECT_LE(file.SectorCount(), sectors + file.Location(0).Count);
+
+    file.RemoveChunk(3);
+    EXPECT_FALSE(file.HasChunk(3));
+    file.WriteChunk(9, RandomChunk(16, 7));
+    EXPECT_LE(file.SectorCount(), sectors + file.Location(0).Count);
+
+    VoxelChunk loaded;
+    ASSERT_TRUE(file.ReadChunk(9, loaded));
+    ExpectSameVoxels(loaded, RandomChunk(16, 7));
+}
+
+TEST_F(RegionFileTest, RejectsForeignAndCorruptFiles)
+{
+    {
+        std::ofstream out(path_, std::ios::binary);
+        out << "definitely not a region file";
+    }
+    EXPECT_THROW(RegionFile file(path_), std::runtime_error);
+    std::filesystem::remove(path_);
+
+    {
+        RegionFile file(path_);
+        file.WriteChunk(5, RandomChunk(3, 5));
+        file.Flush();
+    }
+    {
+        // Flip a byte inside the compressed stream of the record.
+        std::fstream out(path_, std::ios::binary | std::ios::in | std::ios::out);
+        out.seekp(RegionFile::HEADER_SECTORS * RegionFile::SECTOR_SIZE + 40);
+        out.put('\x5A');
+    }
+    RegionFile file(path_);
+    VoxelChunk loaded;
+    EXPECT_THROW(file.ReadChunk(5, loaded), std::runtime_error);
+}
+
+TEST_F(RegionFileTest, RejectsRecordsThatRepeatAPaletteKind)
+{
+    // Every other voxel uses the second entry, which repeats AIR_KIND in the corrupt record.
+    const std::vector<uint64_t> indices(CHUNK_VOLUME / 64, 0xAAAAAAAAAAAAAAAAull);
+    const VoxelChunk            valid = RegionFile::DecodeRecord(StoredRecord({AIR_KIND, 5}, 1, indices));
+    EXPECT_EQ(valid.Get(0), AIR_KIND);
+    EXPECT_EQ(valid.Get(1), 5);
+
+    {
+        RegionFile file(path_);
+        file.WriteRecord(3, StoredRecord({AIR_KIND, AIR_KIND}, 1, indices));
+        file.Flush();
+    }
+    RegionFile file(path_);
+    VoxelChunk loaded;
+    try
+    {
+        file.ReadChunk(3, loaded);
+        ADD_FAILURE() << "the record was accepted";
+    }
+    catch (const std::runtime_error& e)
+    {
+        EXPECT_NE(std::string(e.what()).find("Corrupt region file"), std::string::npos);
+    }
+}
+
+TEST(VoxelChunkFromPackedTest, RejectsInconsistentData)
+{
+    const VoxelChunk source = RandomChunk(3, 9);
+    const VoxelChunk copy   = VoxelChunk::FromPacked(source.Palette(), source.BitsPerIndex(), source.PackedIndices());
+    ExpectSameVoxels(copy, source);
+
+    EXPECT_THROW(VoxelChunk::FromPacked({1, 2}, 3, std::vector<uint64_t>(CHUNK_VOLUME * 3 / 64)), std::invalid_argument);
+    EXPECT_THROW(VoxelChunk::FromPacked({1, 2}, 2, std::vector<uint64_t>(1)), std::invalid_argument);
+    EXPECT_THROW(VoxelChunk::FromPacked({1, 2}, 0, {}), std::invalid_argument);
+    EXPECT_THROW(VoxelChunk::FromPacked({1, 2, 1}, 2, std::vector<uint64_t>(CHUNK_VOLUME * 2 / 64)), std::invalid_argument);
+
+    // Index 3 with only three palette entries.
+    EXPECT_THROW(VoxelChunk::FromPacked({1, 2, 3}, 2, std::vector<uint64_t>(CHUNK_VOLUME * 2 / 64, ~0ull)), std::invalid_argument);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "Voxel/RegionStore.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    class RegionStoreTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override { std::filesystem::remove_all(directory_); }
+
+        void TearDown() override { std::filesystem::remove_all(directory_); }
+
+        const std::filesystem::path directory_ = std::filesystem::temp_directory_path() / "RegionStoreUT";
+    };
+} // namespace
+
+TEST_F(RegionStoreTest, MapRoundTripsThroughRegions)
+{
+    // Spans two regions along x and two chunk layers.
+    ChunkedVoxelMap map(255, 1100, 64, 64);
+    map.FillBlocks(Int3(0, 0, 0), Int3(1100, 20, 64), 1);
+    map.SetBlock(1099, 63, 63, 9);
+    map.SetBlock(5, 40, 7, 4);
+
+    ThreadPool pool(2);
+    {
+        RegionStore store(directory_);
+        store.SaveMap(map, &pool);
+        EXPECT_EQ(store.Regions().size(), 4u);
+    }
+
+    ChunkedVoxelMap loaded(255, 1100, 64, 64);
+    RegionStore     store(directory_);
+    EXPECT_EQ(store.LoadMap(loaded), map.ChunkCount());
+    EXPECT_EQ(loaded.GetBlock(1099, 63, 63), 9);
+    EXPECT_EQ(loaded.GetBlock(5, 40, 7), 4);
+    EXPECT_EQ(loaded.GetBlock(600, 19, 30), 1);
+    EXPECT_EQ(loaded.GetBlock(600, 20, 30), AIR_KIND);
+}
+
+TEST_F(RegionStoreTest, SavingDropsChunksTheMapNoLongerHas)
+{
+    ChunkedVoxelMap map(255, 128, 32, 128);
+    map.SetBlock(1, 1, 1, 2);
+    map.SetBlock(100, 1, 100, 3);
+
+    RegionStore store(directory_);
+    store.SaveMap(map);
+
+    map.RemoveChunk(Int3(3, 0, 3));
+    store.SaveMap(map);
+
+    VoxelChunk chunk;
+    EXPECT_TRUE(store.LoadChunk(Int3(0, 0, 0), chunk));
+    EXPECT_EQ(chunk.Get(1, 1, 1), 2);
+    EXPECT_FALSE(store.LoadChunk(Int3(3, 0, 3), chunk));
+    EXPECT_FALSE(store.LoadChunk(Int3(500, 0, 0), chunk));
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Thread/ThreadPool.h"
+#include "Voxel/ChunkedVoxelMap.h"
+#include "Voxel/VoxImporter.h"
+
+using namespace Voxium::Core;
+
+namespace
+{
+    struct VoxWriter
+    {
+        std::vector<uint8_t> Bytes;
+
+        void Int(int32_t v)
+        {
+            for (int i = 0; i < 4; ++i)
+                Bytes.push_back(static_cast<uint8_t>(static_cast<uint32_t>(v) >> (8 * i)));
+        }
+
+        void Id(const char* id) { Bytes.insert(Bytes.end(), id, id + 4); }
+
+        void String(const std::string& s)
+        {
+            Int(static_cast<int32_t>(s.size()));
+            Bytes.insert(Bytes.end(), s.begin(), s.end());
+        }
+
+        void Dict(const std::vector<std::pair<std::string, std::string>>& pairs)
+        {
+            Int(static_cast<int32_t>(pairs.size()));
+            for (const auto& [k, v] : pairs)
+            {
+                String(k);
+                String(v);
+            }
+        }
+
+        void Chunk(const char* id, const VoxWriter& content)
+        {
+            Id(id);
+            Int(static_cast<int32_t>(content.Bytes.size()));
+            Int(0);
+            Bytes.insert(Bytes.end(), content.Bytes.begin(), content.Bytes.end());
+        }
+    };
+
+    std::vector<uint8_t> BuildFile(const VoxWriter& children)
+    {
+        VoxWriter file;
+        file.Id("VOX ");
+        file.Int(150);
+        file.Id("MAIN");
+        file.Int(0);
+        file.Int(static_cast<int32_t>(children.Bytes.size()));
+        file.Bytes.insert(file.Bytes.end(), children.Bytes.begin(), children.Bytes.end());
+        return file.Bytes;
+    }
+
+    void AddModel(VoxWriter& children, int sx, int sy, int sz, const std::vector<std::array<uint8_t, 4>>& voxels)
+    {
+        VoxWriter size;
+        size.Int(sx);
+        size.Int(sy);
+        size.Int(sz);
+        children.Chunk("SIZE", size);
+
+        VoxWriter xyzi;
+        xyzi.Int(static_cast<int32_t>(voxels.size()));
+        for (const auto& v : voxels)
+            xyzi.Bytes.insert(xyzi.Bytes.end(), v.begin(), v.end());
+        children.Chunk("XYZI", xyzi);
+    }
+
+    void AddTransform(VoxWriter& children, int id, int child, const std::vector<std::pair<std::string, std::string>>& frame)
+    {
+        VoxWriter node;
+        node.Int(id);
+        node.Dict({});
+        node.Int(child);
+        node.Int(-1);
+        node.Int(0);
+        node.Int(1);
+        node.Dict(frame);
+        children.Chunk("nTRN", node);
+    }
+} // namespace
+
+TEST(VoxImporterTest, ImportsModelWithoutSceneGraph)
+{
+    VoxWriter children;
+    AddModel(children, 4, 4, 4, {{{0, 0, 0, 1}}, {{3, 1, 2, 7}}, {{2, 2, 2, 0}}});
+
+    VoxWriter rgba;
+    for (int i = 0; i < 256; ++i)
+        rgba.Int(0xFF000000 | i);
+    children.Chunk("RGBA", rgba);
+
+    ChunkedVoxelMap  map(255, 64, 64, 64);
+    VoxImportOptions options;
+    options.SwapYZ = false;
+    options.Origin = Int3(10, 20, 30);
+
+    VoxImportResult result = VoxImporter::Import(BuildFile(children), map, options);
+    EXPECT_EQ(result.ModelCount, 1u);
+    EXPECT_EQ(result.VoxelCount, 2u);
+    EXPECT_EQ(map.GetBlock(10, 20, 30), 1);
+    EXPECT_EQ(map.GetBlock(13, 21, 32), 7);
+    EXPECT_EQ(map.MagicVoxelColours[1], 0xFF000000u);
+    EXPECT_EQ(map.MagicVoxelColours[7], 0xFF000006u);
+    EXPECT_EQ(map.MagicVoxelColours[0], 0u);
+}
+
+TEST(VoxImporterTest, AppliesSceneGraphTransformsInParallel)
+{
+    VoxWriter children;
+    AddModel(children, 2, 1, 1, {{{0, 0, 0, 1}}, {{1, 0, 0, 2}}});
+
+    AddTransform(children, 0, 1, {});
+    VoxWriter group;
+    group.Int(1);
+    group.Dict({});
+    group.Int(2);
+    group.Int(2);
+    group.Int(4);
+    children.Chunk("nGRP", group);
+
+    AddTransform(children, 2, 3, {{"_t", "40 0 0"}});
+    // _r = 17: x' = -y, y' = x, z' = z (90 degree turn around z).
+    AddTransform(children, 4, 3, {{"_t", "0 0 0"}, {"_r", "17"}});
+
+    VoxWriter shape;
+    shape.Int(3);
+    shape.Dict({});
+    shape.Int(1);
+    shape.Int(0);
+    shape.Dict({});
+    children.Chunk("nSHP", shape);
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "VoxImporterUT.vox";
+    {
+        std::vector<uint8_t> bytes = BuildFile(children);
+        std::ofstream        out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    ChunkedVoxelMap  map(255, 64, 64, 64);
+    ThreadPool       pool(4);
+    VoxImportOptions options;
+    options.Pool = &pool;
+
+    VoxImportResult result = VoxImporter::Import(path, map, options);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(result.InstanceCount, 2u);
+    EXPECT_EQ(result.VoxelCount, 4u);
+    EXPECT_EQ(result.ChunkCount, 2u);
+
+    // Translated instance pivots around x = 1, so its voxels land at x = 39 and 40.
+    // The rotated instance turns the model onto the scene y axis at y = -1 and 0, which
+    // SwapYZ maps to z; the scene minimum z of -1 is then shifted to the origin.
+    EXPECT_EQ(result.Max.X - result.Min.X, 41);
+    EXPECT_EQ(map.GetBlock(39, 0, 1), 1);
+    EXPECT_EQ(map.GetBlock(40, 0, 1), 2);
+    EXPECT_EQ(map.GetBlock(0, 0, 0), 1);
+    EXPECT_EQ(map.GetBlock(0, 0, 1), 2);
+    // Chunks prepared for the parallel writes but left empty are dropped again.
+    EXPECT_EQ(map.ChunkCount(), 2u);
+}
+
+TEST(VoxImporterTest, RejectsMalformedFiles)
+{
+    ChunkedVoxelMap      map(255, 16, 16, 16);
+    std::vector<uint8_t> garbage {'N', 'O', 'P', 'E', 0, 0, 0, 0};
+    EXPECT_THROW(VoxImporter::Import(garbage, map), std::runtime_error);
+
+    VoxWriter children;
+    VoxWriter xyzi;
+    xyzi.Int(1000);
+    children.Chunk("SIZE", xyzi);
+    EXPECT_THROW(VoxImporter::Import(BuildFile(children), map), std::runtime_error);
+
+    VoxWriter rotated;
+    AddModel(rotated, 1, 1, 1, {{{0, 0, 0, 1}}});
+    AddTransform(rotated, 0, 1, {{"_r", "9x"}});
+    VoxWriter shape;
+    shape.Int(1);
+    shape.Dict({});
+    shape.Int(1);
+    shape.Int(0);
+    shape.Dict({});
+    rotated.Chunk("nSHP", shape);
+    EXPECT_THROW(VoxImporter::Import(BuildFile(rotated), map), std::runtime_error);
+
+    // The second model has a voxel past its SIZE; nothing is written, not even the first model.
+    VoxWriter outside;
+    AddModel(outside, 2, 2, 2, {{{1, 1, 1, 1}}});
+    AddModel(outside, 2, 2, 2, {{{0, 0, 0, 1}}, {{0, 2, 0, 1}}});
+    EXPECT_THROW(VoxImporter::Import(BuildFile(outside), map), std::runtime_error);
+    EXPECT_EQ(map.ChunkCount(), 0u);
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Test/TestTerrain.h"
+#include "Voxel/VoxelLodPyramid.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Test;
+
+namespace
+{
+    constexpr BlockKind STONE = 1;
+    constexpr BlockKind DIRT  = 2;
+    constexpr BlockKind GRASS = 3;
+
+    void ExpectSameNodes(const VoxelLodPyramid& pyramid, const VoxelLodPyramid& reference, const ChunkedVoxelMap& map)
+    {
+        ASSERT_EQ(pyramid.NodeCount(), reference.NodeCount());
+        for (int level = 1; level <= reference.Levels(); ++level)
+        {
+            const int size = CHUNK_SIZE << level;
+            for (int y = 0; y * size < map.SizeY(); ++y)
+                for (int z = 0; z * size < map.SizeZ(); ++z)
+                    for (int x = 0; x * size < map.SizeX(); ++x)
+                    {
+                        const VoxelChunk* node     = pyramid.GetNode(level, Int3(x, y, z));
+                        const VoxelChunk* expected = reference.GetNode(level, Int3(x, y, z));
+                        ASSERT_EQ(node == nullptr, expected == nullptr) << "level " << level << " node " << x << ", " << y << ", " << z;
+                        if (node == nullptr)
+                            continue;
+                        int mismatches = 0;
+                        for (int i = 0; i < CHUNK_VOLUME; ++i)
+                            mismatches += node->Get(i) != expected->Get(i);
+                        EXPECT_EQ(mismatches, 0) << "level " << level << " node " << x << ", " << y << ", " << z;
+                    }
+        }
+    }
+} // namespace
+
+TEST(VoxelLodPyramidTest, FiltersReduceCellsDifferently)
+{
+    ChunkedVoxelMap map(255, 64, 64, 64);
+
+    // Grass on dirt: the majority is dirt, but from above the cell looks like grass.
+    map.FillBlocks(Int3(0, 0, 0), Int3(2, 2, 2), GRASS);
+    map.FillBlocks(Int3(0, 0, 0), Int3(2, 1, 2), DIRT);
+    map.SetBlock(0, 1, 0, DIRT);
+
+    // A one voxel thick floor: half the cells, kept by both.
+    map.FillBlocks(Int3(2, 0, 0), Int3(2, 1, 2), STONE);
+
+    // Three scattered voxels: dropped by both.
+    map.SetBlock(4, 0, 0, STONE);
+    map.SetBlock(5, 1, 0, STONE);
+    map.SetBlock(4, 1, 1, STONE);
+
+    VoxelLodPyramid majority(map, 2, LodFilter::Majority);
+    VoxelLodPyramid visible(map, 2, LodFilter::MostVisible);
+    majority.Rebuild();
+    visible.Rebuild();
+
+    const VoxelChunk* byMajority = majority.GetNode(1, Int3(0, 0, 0));
+    const VoxelChunk* byVisible  = visible.GetNode(1, Int3(0, 0, 0));
+    ASSERT_NE(byMajority, nullptr);
+    ASSERT_NE(byVisible, nullptr);
+    EXPECT_EQ(byMajority->Get(0, 0, 0), DIRT);
+    EXPECT_EQ(byVisible->Get(0, 0, 0), GRASS);
+    EXPECT_EQ(byMajority->Get(1, 0, 0), STONE);
+    EXPECT_EQ(byVisible->Get(1, 0, 0), STONE);
+    EXPECT_EQ(byMajority->Get(2, 0, 0), AIR_KIND);
+    EXPECT_EQ(byVisible->Get(2, 0, 0), AIR_KIND);
+
+    // At level 2 the grass and stone cells are a quarter of their cell and disappear.
+    EXPECT_EQ(visible.GetNode(2, Int3(0, 0, 0)), nullptr);
+    EXPECT_EQ(visible.GetNode(0, Int3(0, 0, 0)), map.GetChunk(Int3(0, 0, 0)));
+    EXPECT_EQ(visible.NodeCount(), 1u);
+    EXPECT_EQ(visible.Filter(), LodFilter::MostVisible);
+
+    EXPECT_THROW(visible.GetNode(3, Int3(0, 0, 0)), std::out_of_range);
+    EXPECT_THROW(VoxelLodPyramid(map, VoxelLodPyramid::MAX_LEVEL + 1), std::invalid_argument);
+}
+
+TEST(VoxelLodPyramidTest, UpdateMatchesRebuild)
+{
+    ChunkedVoxelMap     map(255, 128, 64, 128);
+    const RollingGround ground {24, 10.0, 11.0, 7.0, 9.0};
+    for (int z = 0; z < map.SizeZ(); ++z)
+        for (int x = 0; x < map.SizeX(); ++x)
+        {
+            const int height = ground.Height(x, z);
+            map.FillBlocks(Int3(x, 0, z), Int3(1, height - 1, 1), DIRT);
+            map.SetBlock(x, height - 1, z, GRASS);
+        }
+
+    VoxelLodPyramid pyramid(map, 2);
+    pyramid.Rebuild();
+
+    // One edit rebuilds the node above it on every level.
+    map.FillBlocks(Int3(40, 30, 40), Int3(6, 6, 6), STONE);
+    pyramid.MarkChunkDirty(ChunkOf(40, 30, 40));
+    const std::vector<LodNode>& updated = pyramid.Update();
+    ASSERT_EQ(updated.size(), 2u);
+    EXPECT_EQ(updated[0].Level, 1);
+    EXPECT_TRUE(updated[0].NodePos == Int3(0, 0, 0));
+    EXPECT_EQ(updated[1].Level, 2);
+    EXPECT_TRUE(pyramid.Update().empty());
+
+    std::mt19937                       rng(13);
+    std::uniform_int_distribution<int> px(0, 120), py(0, 56), pz(0, 120), pick(0, 3);
+    for (int edit = 0; edit < 200; ++edit)
+    {
+        const Int3 origin(px(rng), py(rng), pz(rng));
+        map.FillBlocks(origin, Int3(1 + pick(rng) * 2, 1 + pick(rng), 1 + pick(rng) * 2), static_cast<BlockKind>(pick(rng)));
+        pyramid.MarkBoxDirty(origin, Int3(7, 4, 7));
+    }
+
+    // Emptying a whole chunk drops it from the coarser levels.
+    map.RemoveChunk(Int3(3, 1, 3));
+    pyramid.MarkChunkDirty(Int3(3, 1, 3));
+    pyramid.Update();
+
+    VoxelLodPyramid reference(map, 2);
+    reference.Rebuild();
+    ExpectSameNodes(pyramid, reference, map);
+}
+
+TEST(VoxelLodPyramidTest, SelectedNodesCoverTheMapOnce)
+{
+    ChunkedVoxelMap map(255, 512, 64, 512);
+    map.FillBlocks(Int3(0, 0, 0), Int3(512, 20, 512), STONE);
+    VoxelLodPyramid pyramid(map);
+    pyramid.Rebuild();
+
+    std::vector<LodNode> nodes;
+    EXPECT_THROW(pyramid.SelectNodes(Vector3F(0.0f), 0, nodes), std::invalid_argument);
+    pyramid.SelectNodes(Vector3F(100.0f, 30.0f, 260.0f), 2, nodes);
+
+    // Every ground chunk under exactly one node; the air above is in none.
+    std::map<std::pair<int, int>, int> covered;
+    std::vector<int>                   perLevel(VoxelLodPyramid::MAX_LEVEL + 1);
+    for (const LodNode& node : nodes)
+    {
+        EXPECT_EQ(node.NodePos.Y, 0);
+        ++perLevel[node.Level];
+        const int size = 1 << node.Level;
+        for (int z = node.NodePos.Z * size; z < (node.NodePos.Z + 1) * size; ++z)
+            for (int x = node.NodePos.X * size; x < (node.NodePos.X + 1) * size; ++x)
+                ++covered[{x, z}];
+    }
+    EXPECT_EQ(covered.size(), 16u * 16u);
+    for (const auto& [column, count] : covered)
+        EXPECT_EQ(count, 1) << column.first << ", " << column.second;
+
+    // Fine near the camera, coarse far away, and no ring much larger than another.
+    for (const LodNode& node : nodes)
+    {
+        const int size = 1 << node.Level;
+        if (node.NodePos.X * size <= 3 && 3 < (node.NodePos.X + 1) * size && node.NodePos.Z * size <= 8 && 8 < (node.NodePos.Z + 1) * size)
+            EXPECT_EQ(node.Level, 0);
+        if (node.NodePos.X * size <= 15 && node.NodePos.Z * size <= 0 && 0 < (node.NodePos.Z + 1) * size && 15 < (node.NodePos.X + 1) * size)
+            EXPECT_GE(node.Level, 2);
+    }
+    for (int level = 0; level < VoxelLodPyramid::MAX_LEVEL; ++level)
+        EXPECT_LE(perLevel[level], 64) << "level " << level;
+    EXPECT_LT(nodes.size(), covered.size() / 2);
+}
+
+TEST(VoxelLodPyramidTest, CoarseNodesMeshLikeChunks)
+{
+    ChunkedVoxelMap map(255, 768, 128, 768);
+    map.FillBlocks(Int3(0, 0, 0), Int3(768, 40, 768), STONE);
+    VoxelLodPyramid pyramid(map, 3);
+    pyramid.Rebuild();
+
+    // Flat ground five cells of eight voxels high: one merged quad on top and one below,
+    // where the map ends, and nothing along the sides, which face solid nodes of the same level.
+    GreedyMesher mesher;
+    ChunkMesh    mesh;
+    mesher.Mesh(pyramid.Neighbourhood(3, Int3(1, 0, 1)), mesh);
+    ASSERT_EQ(mesh.QuadCount, 2u);
+    const auto* vertices = reinterpret_cast<const PackedVoxelVertex*>(mesh.Vertices.data());
+    for (uint32_t i = 0; i < mesh.VertexCount; ++i)
+    {
+        if (vertices[i].Face() == BlockFace::PositiveY)
+            EXPECT_EQ(vertices[i].Y(), 5);
+        else
+            EXPECT_EQ(vertices[i].Face(), BlockFace::NegativeY);
+    }
+}
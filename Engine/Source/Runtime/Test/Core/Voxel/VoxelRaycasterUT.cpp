@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Test/TestTerrain.h"
+#include "Voxel/VoxelRaycaster.h"
+
+using namespace Voxium::Core;
+using namespace Voxium::Test;
+
+namespace
+{
+    // Textbook Amanatides-Woo over GetBlock, one voxel at a time, for comparison.
+    VoxelRayHit PlainTrace(const ChunkedVoxelMap& map, Vector3F origin, Vector3F direction, float maxDistance)
+    {
+        const float length = std::sqrt(Vector3F::DotProduct(direction, direction));
+        direction          = direction / length;
+        const float o[3]   = {origin.X, origin.Y, origin.Z};
+        const float d[3]   = {direction.X, direction.Y, direction.Z};
+        const int   size[3] = {map.SizeX(), map.SizeY(), map.SizeZ()};
+
+        int   cell[3], step[3];
+        float next[3], delta[3];
+        for (int a = 0; a < 3; ++a)
+        {
+            cell[a]  = static_cast<int>(std::floor(o[a]));
+            step[a]  = d[a] < 0.0f ? -1 : 1;
+            delta[a] = d[a] == 0.0f ? INFINITY : std::abs(1.0f / d[a]);
+            next[a]  = d[a] == 0.0f ? INFINITY : ((d[a] > 0.0f ? cell[a] + 1 : cell[a]) - o[a]) / d[a];
+        }
+
+        float t    = 0.0f;
+        int   axis = -1;
+        while (t <= maxDistance)
+        {
+            const bool inside = cell[0] >= 0 && cell[0] < size[0] && cell[1] >= 0 && cell[1] < size[1] && cell[2] >= 0 && cell[2] < size[2];
+            if (inside && map.GetBlock(cell[0], cell[1], cell[2]) != AIR_KIND)
+            {
+                VoxelRayHit hit;
+                hit.Hit      = true;
+                hit.Voxel    = Int3(cell[0], cell[1], cell[2]);
+                hit.Distance = t;
+                hit.Kind     = map.GetBlock(cell[0], cell[1], cell[2]);
+                int normal[3] = {0, 0, 0};
+                if (axis >= 0)
+                    normal[axis] = -step[axis];
+                hit.Normal = Int3(normal[0], normal[1], normal[2]);
+                return hit;
+            }
+            axis = next[0] < next[1] ? (next[0] < next[2] ? 0 : 2) : (next[1] < next[2] ? 1 : 2);
+            t    = next[axis];
+            cell[axis] += step[axis];
+            next[axis] += delta[axis];
+        }
+        return VoxelRayHit {};
+    }
+
+    // Rolling terrain with scattered floating blocks and one tall pillar, over 3 x 2 x 3 chunks.
+    void BuildWorld(ChunkedVoxelMap& map)
+    {
+        std::mt19937                       rng(3);
+        std::uniform_int_distribution<int> px(0, map.SizeX() - 1), py(20, map.SizeY() - 1), pz(0, map.SizeZ() - 1);
+        RollingGround {10, 6.0, 7.0, 4.0, 5.0}.Fill(map, 1);
+        for (int i = 0; i < 300; ++i)
+            map.SetBlock(px(rng), py(rng), pz(rng), 2);
+        map.FillBlocks(Int3(40, 0, 40), Int3(3, 60, 3), 3);
+    }
+
+    bool SameHit(const VoxelRayHit& a, const VoxelRayHit& b)
+    {
+        if (a.Hit != b.Hit)
+            return false;
+        return !a.Hit || (a.Voxel == b.Voxel && a.Normal == b.Normal && a.Kind == b.Kind && std::abs(a.Distance - b.Distance) < 1e-3f);
+    }
+} // namespace
+
+TEST(VoxelRaycasterTest, ReportsVoxelFaceAndDistance)
+{
+    ChunkedVoxelMap map(255, 64, 64, 64);
+    map.SetBlock(10, 5, 5, 7);
+    const VoxelRaycaster raycaster(map);
+    EXPECT_TRUE(raycaster.IsCurrent());
+
+    VoxelRayHit hit = raycaster.Raycast(Vector3F(0.5f, 5.5f, 5.5f), Vector3F(2.0f, 0.0f, 0.0f), 100.0f);
+    ASSERT_TRUE(hit.Hit);
+    EXPECT_EQ(hit.Voxel, Int3(10, 5, 5));
+    EXPECT_EQ(hit.Normal, Int3(-1, 0, 0));
+    EXPECT_FLOAT_EQ(hit.Distance, 9.5f);
+    EXPECT_EQ(hit.Kind, 7);
+
+    // Too short, pointing away, and from outside the map, entering through its face.
+    EXPECT_FALSE(raycaster.Raycast(Vector3F(0.5f, 5.5f, 5.5f), Vector3F(1.0f, 0.0f, 0.0f), 9.0f).Hit);
+    EXPECT_FALSE(raycaster.Raycast(Vector3F(0.5f, 5.5f, 5.5f), Vector3F(-1.0f, 0.0f, 0.0f), 100.0f).Hit);
+    hit = raycaster.Raycast(Vector3F(10.5f, 90.0f, 5.5f), Vector3F(0.0f, -1.0f, 0.0f), 100.0f);
+    ASSERT_TRUE(hit.Hit);
+    EXPECT_EQ(hit.Normal, Int3(0, 1, 0));
+    EXPECT_FLOAT_EQ(hit.Distance, 84.0f);
+
+    // Starting inside a solid voxel hits it at once, without a face.
+    hit = raycaster.Raycast(Vector3F(10.2f, 5.7f, 5.1f), Vector3F(0.0f, 0.0f, 1.0f), 100.0f);
+    ASSERT_TRUE(hit.Hit);
+    EXPECT_EQ(hit.Normal, Int3(0, 0, 0));
+    EXPECT_EQ(hit.Distance, 0.0f);
+
+    EXPECT_FALSE(raycaster.Raycast(Vector3F(0.5f, 5.5f, 5.5f), Vector3F(0.0f, 0.0f, 0.0f), 100.0f).Hit);
+}
+
+TEST(VoxelRaycasterTest, MatchesPlainTraversal)
+{
+    ChunkedVoxelMap map(255, 96, 64, 96);
+    BuildWorld(map);
+
+    // Sparse blocks of 100 kinds give one chunk more palette entries than the batch's air mask covers.
+    std::mt19937                       rng(17);
+    std::uniform_int_distribution<int> local(0, CHUNK_SIZE - 1);
+    for (int i = 0; i < 2000; ++i)
+        map.SetBlock(64 + local(rng), 32 + local(rng), local(rng), static_cast<BlockKind>(4 + i % 100));
+    ASSERT_GT(map.GetChunk(Int3(2, 1, 0))->Palette().size(), 64u);
+    const VoxelRaycaster raycaster(map);
+
+    std::uniform_real_distribution<float> position(-8.0f, 104.0f), height(-4.0f, 70.0f), direction(-1.0f, 1.0f), distance(0.0f, 160.0f);
+    std::vector<VoxelRay>                 rays;
+    for (int i = 0; i < 4000; ++i)
+        rays.push_back(VoxelRay {Vector3F(position(rng), height(rng), position(rng)), Vector3F(direction(rng), direction(rng), direction(rng)), distance(rng)});
+
+    // Axis-aligned rays exercise the parallel-slab paths.
+    rays.push_back(VoxelRay {Vector3F(0.5f, 30.5f, 41.5f), Vector3F(1.0f, 0.0f, 0.0f), 200.0f});
+    rays.push_back(VoxelRay {Vector3F(41.5f, 63.5f, 41.5f), Vector3F(0.0f, -1.0f, 0.0f), 200.0f});
+    rays.push_back(VoxelRay {Vector3F(20.5f, 40.5f, 95.5f), Vector3F(0.0f, 0.0f, -1.0f), 200.0f});
+
+    std::vector<VoxelRayHit> batch(rays.size());
+    raycaster.RaycastBatch(rays, batch);
+
+    int hits = 0;
+    for (std::size_t i = 0; i < rays.size(); ++i)
+    {
+        const VoxelRay&   ray      = rays[i];
+        const VoxelRayHit expected = PlainTrace(map, ray.Origin, ray.Direction, ray.MaxDistance);
+        const VoxelRayHit actual   = raycaster.Raycast(ray);
+        ASSERT_TRUE(SameHit(actual, expected)) << "ray " << i;
+        ASSERT_TRUE(SameHit(batch[i], actual)) << "ray " << i;
+        hits += actual.Hit;
+    }
+    EXPECT_GT(hits, 1000);
+    EXPECT_LT(hits, 3500);
+}
+
+TEST(VoxelRaycasterTest, SeesEditsWithoutRebuilding)
+{
+    ChunkedVoxelMap map(255, 64, 64, 64);
+    map.FillBlocks(Int3(0, 0, 0), Int3(64, 8, 64), 1);
+    VoxelRaycaster raycaster(map);
+    const Vector3F origin(0.5f, 40.5f, 40.5f);
+    const Vector3F along(1.0f, 0.0f, 0.0f);
+    EXPECT_TRUE(raycaster.IsCurrent());
+    EXPECT_EQ(raycaster.MemoryUsage(), 8 * sizeof(const VoxelChunk*));
+
+    // A new chunk is looked up in the map until the next rebuild.
+    map.SetBlock(50, 40, 40, 4);
+    EXPECT_FALSE(raycaster.IsCurrent());
+    EXPECT_EQ(raycaster.Raycast(origin, along, 100.0f).Voxel, Int3(50, 40, 40));
+    raycaster.Rebuild();
+    EXPECT_TRUE(raycaster.IsCurrent());
+    const VoxelRay ray {origin, along, 100.0f};
+    VoxelRayHit    hit;
+    raycaster.RaycastBatch(std::span(&ray, 1), std::span(&hit, 1));
+    EXPECT_EQ(hit.Voxel, Int3(50, 40, 40));
+
+    // Edits inside existing chunks need no rebuild.
+    map.SetBlock(40, 40, 40, 5);
+    map.SetBlock(50, 40, 40, AIR_KIND);
+    EXPECT_TRUE(raycaster.IsCurrent());
+    EXPECT_EQ(raycaster.Raycast(origin, along, 100.0f).Kind, 5);
+    map.SetBlock(40, 40, 40, AIR_KIND);
+    EXPECT_FALSE(raycaster.Raycast(origin, along, 100.0f).Hit);
+    EXPECT_EQ(raycaster.Raycast(Vector3F(20.5f, 40.5f, 20.5f), Vector3F(0.0f, -1.0f, 0.0f), 100.0f).Voxel, Int3(20, 7, 20));
+    map.FillBlocks(Int3(16, 0, 16), Int3(8, 8, 8), AIR_KIND);
+    EXPECT_FALSE(raycaster.Raycast(Vector3F(20.5f, 40.5f, 20.5f), Vector3F(0.0f, -1.0f, 0.0f), 100.0f).Hit);
+
+    // Removed chunks are never read through the grid.
+    map.FillBlocks(Int3(0, 0, 0), Int3(32, 32, 32), AIR_KIND);
+    EXPECT_FALSE(raycaster.IsCurrent());
+    EXPECT_FALSE(raycaster.Raycast(Vector3F(10.5f, 20.5f, 10.5f), Vector3F(0.0f, -1.0f, 0.0f), 100.0f).Hit);
+}
+
+TEST(VoxelRaycasterTest, LineOfSightStopsAtWalls)
+{
+    ChunkedVoxelMap map(255, 64, 32, 64);
+    map.FillBlocks(Int3(30, 0, 0), Int3(1, 20, 64), 1);
+    map.SetBlock(50, 5, 5, 2);
+    const VoxelRaycaster raycaster(map);
+
+    const std::vector<Vector3F> from = {Vector3F(10.5f, 5.5f, 5.5f), Vector3F(10.5f, 25.5f, 5.5f), Vector3F(40.5f, 5.5f, 5.5f), Vector3F(10.5f, 5.5f, 5.5f)};
+    const std::vector<Vector3F> to   = {Vector3F(50.5f, 5.5f, 5.5f), Vector3F(50.5f, 25.5f, 60.5f), Vector3F(50.5f, 5.5f, 5.5f), Vector3F(10.5f, 5.5f, 5.5f)};
+    const std::vector<uint8_t>  seen = {0, 1, 1, 1};
+
+    std::vector<uint8_t> visible(from.size());
+    raycaster.LineOfSightBatch(from, to, visible);
+    for (std::size_t i = 0; i < from.size(); ++i)
+    {
+        EXPECT_EQ(raycaster.LineOfSight(from[i], to[i]), seen[i] != 0) << i;
+        EXPECT_EQ(visible[i], seen[i]) << i;
+    }
+}
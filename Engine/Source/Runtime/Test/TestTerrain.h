@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cmath>
+
+#include "Voxel/ChunkedVoxelMap.h"
+
+namespace Voxium::Test
+{
+    // Rolling ground shared by tests and benchmarks: every column filled from y = 0 up to
+    // Base + AmplitudeX sin(x / PeriodX) + AmplitudeZ cos(z / PeriodZ), truncated.
+    struct RollingGround
+    {
+        int    Base       = 0;
+        double AmplitudeX = 0.0;
+        double PeriodX    = 1.0;
+        double AmplitudeZ = 0.0;
+        double PeriodZ    = 1.0;
+
+        int Height(int x, int z) const { return Base + static_cast<int>(AmplitudeX * std::sin(x / PeriodX) + AmplitudeZ * std::cos(z / PeriodZ)); }
+
+        // Fills every column of the map up to the ground with kind.
+        void Fill(Core::ChunkedVoxelMap& map, Core::BlockKind kind) const
+        {
+            for (int z = 0; z < map.SizeZ(); ++z)
+                for (int x = 0; x < map.SizeX(); ++x)
+                    map.FillBlocks(Core::Int3(x, 0, z), Core::Int3(1, Height(x, z), 1), kind);
+        }
+    };
+} // namespace Voxium::Test